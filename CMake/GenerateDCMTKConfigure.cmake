@@ -619,6 +619,7 @@ endif()
   CHECK_FUNCTION_EXISTS(flock HAVE_FLOCK)
   CHECK_FUNCTION_EXISTS(fork HAVE_FORK)
   CHECK_FUNCTION_EXISTS(fseeko HAVE_FSEEKO)
+  CHECK_FUNCTION_EXISTS(fsync HAVE_FSYNC)
   CHECK_FUNCTION_EXISTS(ftime HAVE_FTIME)
   CHECK_FUNCTION_EXISTS(getaddrinfo HAVE_GETADDRINFO)
   CHECK_FUNCTION_EXISTS(getenv HAVE_GETENV)
@@ -769,6 +770,9 @@ endif()
   # popen and pclose are nonstandard and may not be available in the C++ headers
   CHECK_FUNCTIONWITHHEADER_EXISTS("popen" "${HEADERS}" HAVE_POPEN)
   CHECK_FUNCTIONWITHHEADER_EXISTS("pclose" "${HEADERS}" HAVE_PCLOSE)
+  # fdatasync and posix_fallocate are not declared on all systems that provide them
+  CHECK_FUNCTIONWITHHEADER_EXISTS("fdatasync(0)" "${HEADERS}" HAVE_FDATASYNC)
+  CHECK_FUNCTIONWITHHEADER_EXISTS("posix_fallocate(0, 0, 0)" "${HEADERS}" HAVE_POSIX_FALLOCATE)
 
   # Signal handling functions
   CHECK_FUNCTIONWITHHEADER_EXISTS("sigjmp_buf definition" "setjmp.h" HAVE_SIGJMP_BUF)
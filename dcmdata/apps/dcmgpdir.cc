@@ -114,6 +114,7 @@ DCMTK_MAIN_FUNCTION
     const char *opt_charset = DEFAULT_DESCRIPTOR_CHARSET;
     OFFilename opt_directory;
     OFFilename opt_pattern;
+    OFCmdUnsignedInt opt_threads = 1;
     DicomDirInterface::E_ApplicationProfile opt_profile = DicomDirInterface::AP_GeneralPurpose;
 
 #ifdef BUILD_DCMGPDIR_AS_DCMMKDIR
@@ -161,6 +162,10 @@ DCMTK_MAIN_FUNCTION
 #ifdef PATTERN_MATCHING_AVAILABLE
         cmd.addOption("--pattern",               "+p",  1, "[p]attern: string (only with --recurse)",
                                                            "pattern for filename matching (wildcards)");
+#endif
+#ifdef WITH_THREADS
+        cmd.addOption("--threads",                      1, "[n]umber: integer (1..128, default: 1)",
+                                                           "number of threads used for loading and\nchecking the input files");
 #endif
     cmd.addGroup("processing options:");
       cmd.addSubGroup("consistency check:");
@@ -309,6 +314,10 @@ DCMTK_MAIN_FUNCTION
             app.checkValue(cmd.getValue(opt_pattern));
         }
 #endif
+#ifdef WITH_THREADS
+        if (cmd.findOption("--threads"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_threads, 1, 128));
+#endif
 
         /* processing options */
         cmd.beginOptionBlock();
@@ -583,28 +592,10 @@ DCMTK_MAIN_FUNCTION
         {
             /* collect 'bad' files */
             OFList<OFFilename> badFiles;
-            unsigned int goodFiles = 0;
-            OFListIterator(OFFilename) iter = fileNames.begin();
-            OFListIterator(OFFilename) last = fileNames.end();
-            /* iterate over all input filenames */
-            while ((iter != last) && result.good())
-            {
-                /* add files to the DICOMDIR */
-                result = ddir.addDicomFile((*iter), opt_directory);
-                if (result.bad())
-                {
-                    badFiles.push_back(*iter);
-                    if (!ddir.abortMode())
-                    {
-                        /* ignore inconsistent file, just warn (already done inside "ddir") */
-                        result = EC_Normal;
-                    }
-                } else
-                    ++goodFiles;
-                ++iter;
-            }
+            /* add files to the DICOMDIR (inconsistent files are ignored unless in abort mode) */
+            result = ddir.addDicomFiles(fileNames, opt_directory, badFiles, OFstatic_cast(unsigned int, opt_threads));
             /* evaluate result of file checking/adding procedure */
-            if (goodFiles == 0)
+            if (result.good() && (badFiles.size() == fileNames.size()))
             {
                 OFLOG_ERROR(dcmgpdirLogger, "no good files: DICOMDIR not created");
                 result = EC_IllegalCall;
@@ -613,8 +604,8 @@ DCMTK_MAIN_FUNCTION
             {
                 OFOStringStream oss;
                 oss << badFiles.size() << " file(s) cannot be added to DICOMDIR: ";
-                iter = badFiles.begin();
-                last = badFiles.end();
+                OFListIterator(OFFilename) iter = badFiles.begin();
+                OFListIterator(OFFilename) last = badFiles.end();
                 while (iter != last)
                 {
                     oss << OFendl << "  " << (*iter);
@@ -0,0 +1,341 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Extract attribute values from DICOM files into a table
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcextrac.h"   /* for class DcmAttributeExtractor */
+#include "dcmtk/dcmdata/cmdlnarg.h"
+#include "dcmtk/ofstd/ofstd.h"        /* for class OFStandard */
+#include "dcmtk/ofstd/ofconapp.h"     /* for class OFConsoleApplication */
+#include "dcmtk/ofstd/ofstream.h"
+#include "dcmtk/ofstd/oftimer.h"      /* for class OFTimer */
+#include "dcmtk/ofstd/ofexit.h"
+
+#ifdef WITH_ZLIB
+#include <zlib.h>         /* for zlibVersion() */
+#endif
+
+#define OFFIS_CONSOLE_APPLICATION "dcmxtract"
+#define OFFIS_CONSOLE_DESCRIPTION "Extract attribute values from DICOM files"
+
+#if defined (HAVE_WINDOWS_H) || defined(HAVE_FNMATCH_H)
+#define PATTERN_MATCHING_AVAILABLE
+#endif
+
+
+static char rcsid[] = "$dcmtk: " OFFIS_CONSOLE_APPLICATION " v"
+  OFFIS_DCMTK_VERSION " " OFFIS_DCMTK_RELEASEDATE " $";
+
+static OFLogger dcmxtractLogger = OFLog::getLogger("dcmtk.dcmdata." OFFIS_CONSOLE_APPLICATION);
+
+#define SHORTCOL 3
+#define LONGCOL 20
+
+
+// writer that discards the extracted values and only counts the rows
+class DcmExtractionNullWriter
+  : public DcmExtractionWriter
+{
+
+  public:
+
+    DcmExtractionNullWriter()
+      : DcmExtractionWriter(),
+        NumberOfRows(0)
+    {
+    }
+
+    virtual OFCondition begin(const DcmAttributeExtractor & /* extractor */)
+    {
+        return EC_Normal;
+    }
+
+    virtual OFCondition writeBatch(const DcmExtractionBatch &batch)
+    {
+        NumberOfRows += batch.getNumberOfRows();
+        return EC_Normal;
+    }
+
+    virtual OFCondition end()
+    {
+        return EC_Normal;
+    }
+
+    /// number of rows received so far
+    size_t NumberOfRows;
+};
+
+
+// ********************************************
+
+// this macro either expands to main() or wmain()
+DCMTK_MAIN_FUNCTION
+{
+    OFBool opt_scanDir = OFFalse;
+    OFBool opt_recurse = OFFalse;
+    OFBool opt_binary = OFFalse;
+    OFBool opt_discard = OFFalse;
+    OFBool opt_projection = OFTrue;
+    E_FileReadMode opt_readMode = ERM_autoDetect;
+    OFCmdUnsignedInt opt_threads = 1;
+    OFCmdUnsignedInt opt_batchSize = 1000;
+    const char *opt_scanPattern = "";
+    const char *opt_outputFile = NULL;
+    OFList<OFString> opt_keys;
+
+    /* set-up command line parameters and options */
+    OFConsoleApplication app(OFFIS_CONSOLE_APPLICATION, OFFIS_CONSOLE_DESCRIPTION, rcsid);
+    OFCommandLine cmd;
+    cmd.setOptionColumns(LONGCOL, SHORTCOL);
+    cmd.setParamColumn(LONGCOL + SHORTCOL + 4);
+
+    cmd.addParam("dcmfile-in", "DICOM input file or directory to be processed", OFCmdParam::PM_MultiMandatory);
+
+    cmd.addGroup("general options:", LONGCOL, SHORTCOL + 2);
+      cmd.addOption("--help",                "-h",     "print this help text and exit", OFCommandLine::AF_Exclusive);
+      cmd.addOption("--version",                       "print version information and exit", OFCommandLine::AF_Exclusive);
+      OFLog::addOptions(cmd);
+
+    cmd.addGroup("input options:");
+      cmd.addSubGroup("input file format:");
+        cmd.addOption("--read-file",           "+f",     "read file format or data set (default)");
+        cmd.addOption("--read-file-only",      "+fo",    "read file format only");
+      cmd.addSubGroup("input files:");
+        cmd.addOption("--scan-directories",    "+sd",    "scan directories for input files (dcmfile-in)");
+#ifdef PATTERN_MATCHING_AVAILABLE
+        cmd.addOption("--scan-pattern",        "+sp", 1, "[p]attern: string (only with --scan-directories)",
+                                                         "pattern for filename matching (wildcards)");
+#endif
+        cmd.addOption("--no-recurse",          "-r",     "do not recurse within directories (default)");
+        cmd.addOption("--recurse",             "+r",     "recurse within specified directories");
+
+    cmd.addGroup("processing options:");
+      cmd.addSubGroup("attributes:");
+        cmd.addOption("--key",                 "-k",  1, "[p]ath: \"[name=]path\", e.g. \"PatientName\"",
+                                                         "extract attribute given by path as a column\n(see DcmPath syntax, may be repeated)");
+      cmd.addSubGroup("loading:");
+        cmd.addOption("--load-projection",     "+lp",    "load only the attributes needed (default)");
+        cmd.addOption("--load-complete",       "+lc",    "load complete files (for comparison)");
+#ifdef WITH_THREADS
+        cmd.addOption("--threads",                    1, "[n]umber: integer (1..128, default: 1)",
+                                                         "number of threads used for loading files");
+#endif
+        cmd.addOption("--batch-size",          "+bs", 1, "[r]ows: integer (1..1000000, default: 1000)",
+                                                         "number of files processed per batch");
+
+    cmd.addGroup("output options:");
+      cmd.addSubGroup("output format:");
+        cmd.addOption("--write-csv",           "+wc",    "write comma-separated values (default)");
+        cmd.addOption("--write-binary",        "+wb",    "write binary columnar format");
+        cmd.addOption("--discard",             "-w",     "do not write any values (for benchmarks)");
+      cmd.addSubGroup("output file:");
+        cmd.addOption("--output-file",         "+of", 1, "[f]ilename: string",
+                                                         "write output to file f (default: stdout)");
+
+    /* evaluate command line */
+    prepareCmdLineArgs(argc, argv, OFFIS_CONSOLE_APPLICATION);
+    if (app.parseCommandLine(cmd, argc, argv))
+    {
+        /* check exclusive options first */
+        if (cmd.hasExclusiveOption())
+        {
+            if (cmd.findOption("--version"))
+            {
+                app.printHeader(OFTrue /*print host identifier*/);
+                COUT << OFendl << "External libraries used:";
+#ifdef WITH_ZLIB
+                COUT << OFendl << "- ZLIB, Version " << zlibVersion() << OFendl;
+#else
+                COUT << " none" << OFendl;
+#endif
+                return EXITCODE_NO_ERROR;
+            }
+        }
+
+        /* general options */
+        OFLog::configureFromCommandLine(cmd, app);
+
+        /* input options */
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--read-file")) opt_readMode = ERM_autoDetect;
+        if (cmd.findOption("--read-file-only")) opt_readMode = ERM_fileOnly;
+        cmd.endOptionBlock();
+
+        if (cmd.findOption("--scan-directories")) opt_scanDir = OFTrue;
+#ifdef PATTERN_MATCHING_AVAILABLE
+        if (cmd.findOption("--scan-pattern"))
+        {
+            app.checkDependence("--scan-pattern", "--scan-directories", opt_scanDir);
+            app.checkValue(cmd.getValue(opt_scanPattern));
+        }
+#endif
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--no-recurse")) opt_recurse = OFFalse;
+        if (cmd.findOption("--recurse"))
+        {
+            app.checkDependence("--recurse", "--scan-directories", opt_scanDir);
+            opt_recurse = OFTrue;
+        }
+        cmd.endOptionBlock();
+
+        /* processing options */
+        if (cmd.findOption("--key", 0, OFCommandLine::FOM_FirstFromLeft))
+        {
+            const char *key = NULL;
+            do {
+                app.checkValue(cmd.getValue(key));
+                opt_keys.push_back(key);
+            } while (cmd.findOption("--key", 0, OFCommandLine::FOM_NextFromLeft));
+        }
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--load-projection")) opt_projection = OFTrue;
+        if (cmd.findOption("--load-complete")) opt_projection = OFFalse;
+        cmd.endOptionBlock();
+#ifdef WITH_THREADS
+        if (cmd.findOption("--threads"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_threads, 1, 128));
+#endif
+        if (cmd.findOption("--batch-size"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_batchSize, 1, 1000000));
+
+        /* output options */
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--write-csv")) opt_binary = OFFalse;
+        if (cmd.findOption("--write-binary")) opt_binary = OFTrue;
+        if (cmd.findOption("--discard")) opt_discard = OFTrue;
+        cmd.endOptionBlock();
+        if (cmd.findOption("--output-file"))
+        {
+            app.checkConflict("--output-file", "--discard", opt_discard);
+            app.checkValue(cmd.getValue(opt_outputFile));
+        }
+    }
+
+    /* print resource identifier */
+    OFLOG_DEBUG(dcmxtractLogger, rcsid << OFendl);
+
+    /* make sure data dictionary is loaded */
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        OFLOG_WARN(dcmxtractLogger, "no data dictionary loaded, check environment variable: "
+            << DCM_DICT_ENVIRONMENT_VARIABLE);
+    }
+
+    /* set up the columns */
+    DcmAttributeExtractor extractor;
+    if (opt_keys.empty())
+    {
+        OFLOG_FATAL(dcmxtractLogger, "no attributes to be extracted, use option --key");
+        return EXITCODE_COMMANDLINE_SYNTAX_ERROR;
+    }
+    OFListIterator(OFString) key = opt_keys.begin();
+    while (key != opt_keys.end())
+    {
+        OFString name;
+        OFString path = *key;
+        const size_t pos = path.find('=');
+        if (pos != OFString_npos)
+        {
+            name = path.substr(0, pos);
+            path.erase(0, pos + 1);
+        }
+        OFCondition status = extractor.addColumn(path, name);
+        if (status.bad())
+        {
+            OFLOG_FATAL(dcmxtractLogger, "invalid attribute path '" << *key << "': " << status.text());
+            return EXITCODE_COMMANDLINE_SYNTAX_ERROR;
+        }
+        ++key;
+    }
+    extractor.setNumberOfThreads(OFstatic_cast(unsigned int, opt_threads));
+    extractor.setBatchSize(OFstatic_cast(size_t, opt_batchSize));
+    extractor.setProjectionMode(opt_projection);
+    extractor.setReadMode(opt_readMode);
+
+    /* create list of input files */
+    OFFilename paramValue;
+    OFList<OFFilename> inputFiles;
+    const int paramCount = cmd.getParamCount();
+    for (int i = 1; i <= paramCount; i++)
+    {
+        cmd.getParam(i, paramValue);
+        /* search directory recursively (if required) */
+        if (OFStandard::dirExists(paramValue))
+        {
+            if (opt_scanDir)
+                OFStandard::searchDirectoryRecursively(paramValue, inputFiles, opt_scanPattern, "" /*dirPrefix*/, opt_recurse);
+            else
+                OFLOG_WARN(dcmxtractLogger, "ignoring directory because option --scan-directories is not set: " << paramValue);
+        } else
+            inputFiles.push_back(paramValue);
+    }
+    if (inputFiles.empty())
+    {
+        OFLOG_FATAL(dcmxtractLogger, "no input files to be processed");
+        return EXITCODE_NO_INPUT_FILES;
+    }
+
+    /* open the output file (if any) */
+    STD_NAMESPACE ofstream outputFile;
+    if (opt_outputFile != NULL)
+    {
+        outputFile.open(opt_outputFile, STD_NAMESPACE ios::out | STD_NAMESPACE ios::binary);
+        if (!outputFile.good())
+        {
+            OFLOG_FATAL(dcmxtractLogger, "cannot create output file: " << opt_outputFile);
+            return EXITCODE_CANNOT_WRITE_OUTPUT_FILE;
+        }
+    }
+    STD_NAMESPACE ostream &output = (opt_outputFile != NULL) ? outputFile : COUT;
+
+    /* extract the attribute values */
+    DcmExtractionNullWriter nullWriter;
+    DcmExtractionCSVWriter csvWriter(output);
+    DcmExtractionBinaryWriter binaryWriter(output);
+    DcmExtractionWriter *writer = &csvWriter;
+    if (opt_discard)
+        writer = &nullWriter;
+    else if (opt_binary)
+        writer = &binaryWriter;
+    OFLOG_INFO(dcmxtractLogger, "extracting " << extractor.getNumberOfColumns() << " attribute(s) from "
+        << inputFiles.size() << " file(s)");
+    OFList<OFFilename> badFiles;
+    OFTimer timer;
+    OFCondition status = extractor.extract(inputFiles, *writer, badFiles);
+    const double seconds = timer.getDiff();
+    if (status.bad())
+    {
+        OFLOG_FATAL(dcmxtractLogger, "cannot write output: " << status.text());
+        return EXITCODE_CANNOT_WRITE_OUTPUT_FILE;
+    }
+    const size_t numberOfFiles = inputFiles.size() - badFiles.size();
+    OFLOG_INFO(dcmxtractLogger, "extracted attribute values from " << numberOfFiles << " file(s) in "
+        << seconds << " s (" << ((seconds > 0) ? OFstatic_cast(double, numberOfFiles) / seconds : 0)
+        << " files/s)");
+    if (!badFiles.empty())
+    {
+        OFLOG_WARN(dcmxtractLogger, badFiles.size() << " file(s) could not be loaded");
+        return (numberOfFiles > 0) ? EXITCODE_INVALID_INPUT_FILE : EXITCODE_NO_VALID_INPUT_FILES;
+    }
+    return EXITCODE_NO_ERROR;
+}
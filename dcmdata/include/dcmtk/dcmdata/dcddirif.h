@@ -26,6 +26,7 @@
 #include "dcmtk/config/osconfig.h"
 
 #include "dcmtk/dcmdata/dcdicdir.h"
+#include "dcmtk/ofstd/oflist.h"
 
 
 /*------------------------------------*
@@ -42,6 +43,9 @@
  *  class declarations  *
  *----------------------*/
 
+// forward declaration (class is only used internally)
+class DicomDirRecordIndex;
+
 /** Abstract interface to pluggable image support for the DICOMDIR class.
  *  This is an abstract base class used as an interface to access DICOM
  *  images from the DicomDirInterface.  The implementation can be found
@@ -301,6 +305,28 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     OFCondition addDicomFile(const OFFilename &filename,
                              const OFFilename &directory = OFFilename());
 
+    /** add specified DICOM files to the current DICOMDIR.
+     *  This method has the same effect as calling addDicomFile() for each file of the
+     *  given list, but the files can be loaded and checked by a number of worker threads
+     *  (if compiled with thread support) while the records are still added one after the
+     *  other and in the order of the list.  Only a limited number of files is loaded in
+     *  advance, so the memory usage does not depend on the number of files.
+     *  @param filenames list of names of the DICOM files to be added
+     *  @param directory directory where the DICOM files are stored (optional), see
+     *    addDicomFile() for details
+     *  @param badFiles list to which the names of all files are added that could not be
+     *    added to the DICOMDIR
+     *  @param numberOfThreads number of threads used for loading and checking the files.
+     *    A value of 0 or 1 means that the files are loaded by the calling thread.
+     *  @return EC_Normal if all files have been processed (some of them might have been
+     *    added to 'badFiles'), an error code otherwise, i.e. if processing was aborted
+     *    because of an inconsistent file (see enableAbortMode())
+     */
+    OFCondition addDicomFiles(const OFList<OFFilename> &filenames,
+                              const OFFilename &directory,
+                              OFList<OFFilename> &badFiles,
+                              const unsigned int numberOfThreads = 1);
+
     /** set the file-set descriptor file ID and character set.
      *  Prior to any internal modification both 'filename' and 'charset' are checked
      *  using the above checking routines.  Existence of 'filename' is not checked.
@@ -614,6 +640,24 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
                                       DcmFileFormat &fileformat,
                                       const OFBool checkFilename = OFTrue);
 
+    /** add a DICOM file that has already been loaded and checked to the current DICOMDIR
+     *  @param filename name of the DICOM file to be added
+     *  @param directory directory where the DICOM file is stored (optional)
+     *  @param fileformat object in which the loaded data is stored, see
+     *    loadAndCheckDicomFile()
+     *  @return EC_Normal upon success, an error code otherwise
+     */
+    OFCondition addCheckedDicomFile(const OFFilename &filename,
+                                    const OFFilename &directory,
+                                    DcmFileFormat &fileformat);
+
+    /** check whether the pixel data of the DICOM files is needed, i.e.\ whether icon
+     *  images might be created for the current application profile.  If not, the
+     *  DICOM files are only loaded up to the pixel data element.
+     *  @return OFTrue if the pixel data is needed, OFFalse otherwise
+     */
+    OFBool isPixelDataRequired() const;
+
     /** check SOP class and transfer syntax for compliance with current profile
      *  @param metainfo object where the DICOM file meta information is stored
      *  @param dataset object where the DICOM dataset is stored
@@ -702,6 +746,21 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
                                            const E_DirRecType recordType,
                                            DcmItem* dataset);
 
+    /** add all child records of the given record to the index used by
+     *  findExistingRecord(), unless this has already been done before
+     *  @param parent higher-level structure where the records are stored
+     */
+    void indexChildRecords(DcmDirectoryRecord *parent);
+
+    /** add the given record to the index used by findExistingRecord().  Should be
+     *  called whenever a record has been inserted or the value of its unique key
+     *  might have changed.
+     *  @param parent higher-level structure where the record is stored
+     *  @param record directory record to be added
+     */
+    void indexRecord(DcmDirectoryRecord *parent,
+                     DcmDirectoryRecord *record);
+
     /** create or update patient record and copy required values from dataset
      *  @param record record to be updated, use NULL to create a new one
      *  @param fileformat DICOM dataset of the current file
@@ -1645,6 +1704,12 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     /// current curve number used to invent missing attribute values
     unsigned long AutoCurveNumber;
 
+    /// index of the directory records (by unique key) used for finding existing records
+    DicomDirRecordIndex *RecordIndex;
+
+    /// worker threads of addDicomFiles() call loadAndCheckDicomFile()
+    friend class DicomDirLoadThread;
+
     /// private undefined copy constructor
     DicomDirInterface(const DicomDirInterface &obj);
 
@@ -34,6 +34,7 @@ class DcmInputStreamFactory;
 class DcmJsonFormat;
 class DcmFileCache;
 class DcmItem;
+class DcmLazyLoadBudget;
 
 /** abstract base class for all DICOM elements
  */
@@ -50,6 +51,9 @@ class DCMTK_DCMDATA_EXPORT DcmElement
     friend OFBool operator<=(const DcmElement& lhs, const DcmElement& rhs);
     friend OFBool operator>=(const DcmElement& lhs, const DcmElement& rhs);
 
+    // the memory budget may release values loaded on demand
+    friend class DcmLazyLoadBudget;
+
     /** constructor.
      *  Create new element from given tag and length.
      *  @param tag DICOM tag for the new element
@@ -712,6 +716,16 @@ class DCMTK_DCMDATA_EXPORT DcmElement
      */
     virtual void compact();
 
+    /** declare that the caller no longer uses the attribute value, i.e. that
+     *  pointers to the value obtained earlier (e.g. with getValue() or
+     *  getUint8Array()) are not used anymore. If the value has been loaded on
+     *  demand and the file format containing this element has a memory budget
+     *  (see DcmFileFormat::setMemoryBudget()), the value may be removed from
+     *  memory when the budget is exceeded and will be loaded again from file
+     *  upon next access. Otherwise, this method does nothing.
+     */
+    void releaseValue();
+
     /** compute uncompressed frame size of a single frame of this image.
      *  Note that the value returned by this method does not include the pad byte
      *  to even size needed for a buffer into which a frame is to be loaded.
@@ -1008,6 +1022,19 @@ class DCMTK_DCMDATA_EXPORT DcmElement
 
     /// value of the element
     Uint8 *fValue;
+
+    /// memory budget the value is accounted for in, NULL if none
+    DcmLazyLoadBudget *fValueBudget;
+
+    /** remove the value from its memory budget, if any.
+     *  Called whenever the value is modified or deleted.
+     */
+    void untrackValue();
+
+    /** determine the memory budget of the file format containing this element
+     *  @return pointer to memory budget, NULL if none
+     */
+    DcmLazyLoadBudget *findMemoryBudget();
 };
 
 /** Checks whether left hand side element is smaller than right hand side
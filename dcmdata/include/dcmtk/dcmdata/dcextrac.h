@@ -0,0 +1,516 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Classes for extracting attribute values from many DICOM files
+ *           into columnar batches
+ *
+ */
+
+
+#ifndef DCEXTRAC_H
+#define DCEXTRAC_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofstring.h"
+#include "dcmtk/ofstd/offile.h"
+#include "dcmtk/ofstd/ofstream.h"
+#include "dcmtk/ofstd/ofcond.h"
+#include "dcmtk/dcmdata/dctagkey.h"
+#include "dcmtk/dcmdata/dctypes.h"
+#include "dcmtk/dcmdata/dcproj.h"
+
+// forward declarations
+class DcmItem;
+class DcmElement;
+class DcmAttributeExtractor;
+
+
+/** type of the values stored in a column of an extraction batch
+ */
+enum E_ColumnType
+{
+    /// determine the type from the value representation of the attribute
+    ECL_auto = 0,
+    /// character string (all values, separated by backslash)
+    ECL_string = 1,
+    /// signed 64-bit integer (first value)
+    ECL_integer = 2,
+    /// 64-bit floating point number (first value)
+    ECL_float = 3
+};
+
+
+/** batch of rows extracted from DICOM files by class DcmAttributeExtractor.
+ *  The values are stored column by column, i.e. there is one array of typed
+ *  values per column. Each row refers to one DICOM file. A value is "null" if
+ *  the attribute is absent or empty in the file, or if it cannot be converted
+ *  to the type of the column.
+ */
+class DCMTK_DCMDATA_EXPORT DcmExtractionBatch
+{
+
+public:
+
+    /// default constructor, creates an empty batch
+    DcmExtractionBatch();
+
+    /// destructor
+    ~DcmExtractionBatch();
+
+    /// remove all rows and columns
+    void clear();
+
+    /** get the number of rows in this batch
+     *  @return number of rows
+     */
+    size_t getNumberOfRows() const;
+
+    /** get the number of columns in this batch (not counting the filename)
+     *  @return number of columns
+     */
+    size_t getNumberOfColumns() const;
+
+    /** get the type of the given column
+     *  @param column index of the column (0..n-1)
+     *  @return type of the column, ECL_auto if the index is invalid
+     */
+    E_ColumnType getColumnType(const size_t column) const;
+
+    /** get the name of the DICOM file from which the given row was extracted
+     *  @param row index of the row (0..n-1)
+     *  @return name of the DICOM file, empty if the index is invalid
+     */
+    const OFFilename &getFilename(const size_t row) const;
+
+    /** check whether the given value is null, i.e.\ absent
+     *  @param row index of the row (0..n-1)
+     *  @param column index of the column (0..n-1)
+     *  @return OFTrue if the value is null or the indices are invalid, OFFalse otherwise
+     */
+    OFBool isNull(const size_t row,
+                  const size_t column) const;
+
+    /** get the given value from an integer column
+     *  @param row index of the row (0..n-1)
+     *  @param column index of the column (0..n-1)
+     *  @return value, 0 if null or not an integer column
+     */
+    Sint64 getInteger(const size_t row,
+                      const size_t column) const;
+
+    /** get the given value from a floating point column
+     *  @param row index of the row (0..n-1)
+     *  @param column index of the column (0..n-1)
+     *  @return value, 0 if null or not a floating point column
+     */
+    Float64 getFloat(const size_t row,
+                     const size_t column) const;
+
+    /** get the given value from a string column
+     *  @param row index of the row (0..n-1)
+     *  @param column index of the column (0..n-1)
+     *  @return value, empty if null or not a string column
+     */
+    const OFString &getString(const size_t row,
+                              const size_t column) const;
+
+private:
+
+    friend class DcmAttributeExtractor;
+
+    /// values of one column
+    struct Column
+    {
+        /// type of the values (never ECL_auto)
+        E_ColumnType type;
+        /// values of an integer column
+        OFVector<Sint64> integers;
+        /// values of a floating point column
+        OFVector<Float64> floats;
+        /// values of a string column
+        OFVector<OFString> strings;
+        /// null flag for each row (0 = value present, 1 = null)
+        OFVector<Uint8> nulls;
+    };
+
+    /** set up the columns and resize all arrays to the given number of rows.
+     *  All values of the new rows are null.
+     *  @param extractor extractor that determines the columns
+     *  @param numberOfRows new number of rows
+     */
+    void resize(const DcmAttributeExtractor &extractor,
+                const size_t numberOfRows);
+
+    /** remove all rows that have not been extracted successfully
+     */
+    void compact();
+
+    /// private undefined copy constructor
+    DcmExtractionBatch(const DcmExtractionBatch &);
+
+    /// private undefined assignment operator
+    DcmExtractionBatch &operator=(const DcmExtractionBatch &);
+
+    /// name of the DICOM file for each row
+    OFVector<OFFilename> filenames;
+
+    /// status for each row (1 = extracted successfully, 0 = file could not be loaded)
+    OFVector<Uint8> rowStatus;
+
+    /// values of the columns
+    OFVector<Column> columns;
+};
+
+
+/** abstract base class for writing the batches created by class
+ *  DcmAttributeExtractor to some output, e.g.\ a file
+ */
+class DCMTK_DCMDATA_EXPORT DcmExtractionWriter
+{
+
+public:
+
+    /// destructor
+    virtual ~DcmExtractionWriter();
+
+    /** start the output, e.g.\ write a header with the column names
+     *  @param extractor extractor that determines the columns
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition begin(const DcmAttributeExtractor &extractor) = 0;
+
+    /** write the given batch of rows
+     *  @param batch batch to be written
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition writeBatch(const DcmExtractionBatch &batch) = 0;
+
+    /** finish the output
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition end() = 0;
+};
+
+
+/** writer for comma-separated values (CSV) according to RFC 4180.
+ *  The first line contains the column names, the first column contains the
+ *  filename. Null values are written as empty fields.
+ */
+class DCMTK_DCMDATA_EXPORT DcmExtractionCSVWriter
+  : public DcmExtractionWriter
+{
+
+public:
+
+    /** constructor
+     *  @param stream output stream to which the data is written
+     */
+    DcmExtractionCSVWriter(STD_NAMESPACE ostream &stream);
+
+    /// destructor
+    virtual ~DcmExtractionCSVWriter();
+
+    /** write the header line with the column names
+     *  @param extractor extractor that determines the columns
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition begin(const DcmAttributeExtractor &extractor);
+
+    /** write one line per row of the given batch
+     *  @param batch batch to be written
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition writeBatch(const DcmExtractionBatch &batch);
+
+    /** flush the output stream
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition end();
+
+private:
+
+    /** write a string field, quoted if needed
+     *  @param value value to be written
+     */
+    void writeField(const char *value);
+
+    /// output stream
+    STD_NAMESPACE ostream &output;
+};
+
+
+/** writer for a simple binary columnar format. All numbers are stored in
+ *  little endian byte order. The output starts with the 8 bytes "DCMCOL1\0",
+ *  followed by the number of columns (Uint32) and, for each column, its type
+ *  (Uint8, see E_ColumnType), the length of its name (Uint32) and the name.
+ *  Then the batches follow. Each batch starts with the number of rows n
+ *  (Uint32), followed by the filenames and the values of each column:
+ *  - string column (including the filenames): n+1 offsets (Uint32) into the
+ *    character data, followed by the character data of all values
+ *  - integer column: n values (Sint64)
+ *  - floating point column: n values (Float64, IEEE 754)
+ *  Each column (except for the filenames) is preceded by a null bitmap of
+ *  (n+7)/8 bytes, the least significant bit of the first byte refers to the
+ *  first row. A set bit means that the value is null. A batch with 0 rows
+ *  marks the end of the data.
+ */
+class DCMTK_DCMDATA_EXPORT DcmExtractionBinaryWriter
+  : public DcmExtractionWriter
+{
+
+public:
+
+    /** constructor
+     *  @param stream output stream to which the data is written (should be
+     *    opened in binary mode)
+     */
+    DcmExtractionBinaryWriter(STD_NAMESPACE ostream &stream);
+
+    /// destructor
+    virtual ~DcmExtractionBinaryWriter();
+
+    /** write the file header and the column descriptions
+     *  @param extractor extractor that determines the columns
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition begin(const DcmAttributeExtractor &extractor);
+
+    /** write the given batch of rows (batches without rows are ignored)
+     *  @param batch batch to be written
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition writeBatch(const DcmExtractionBatch &batch);
+
+    /** write the end marker and flush the output stream
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition end();
+
+private:
+
+    /** write an unsigned 32-bit integer in little endian byte order
+     *  @param value value to be written
+     */
+    void writeUint32(const Uint32 value);
+
+    /** write an unsigned 64-bit integer in little endian byte order
+     *  @param value value to be written
+     */
+    void writeUint64(const Uint64 value);
+
+    /** write an array of strings (offsets followed by the character data)
+     *  @param values values to be written
+     */
+    void writeStrings(const OFVector<OFString> &values);
+
+    /// output stream
+    STD_NAMESPACE ostream &output;
+};
+
+
+/** class for extracting the values of a list of attributes from many DICOM
+ *  files, e.g.\ for building an index or a metadata catalogue. The attributes
+ *  are specified in path syntax (see class DcmPath), e.g. "PatientName",
+ *  "(0020,000D)" or "ReferencedSeriesSequence[0].SeriesInstanceUID". A
+ *  wildcard item number ("[*]") selects the first item that contains the
+ *  attribute. Attributes of the file meta information (group 0002) can be
+ *  specified on the main level.
+ *  Only the attributes needed are read from the files (see class
+ *  DcmAttributeProjection), and the files can be loaded by multiple threads.
+ *  The extracted values are collected in batches of a configurable number of
+ *  rows (one row per file), which are passed to a DcmExtractionWriter in the
+ *  order of the input files. Files that cannot be loaded are not part of the
+ *  output but reported to the caller.
+ */
+class DCMTK_DCMDATA_EXPORT DcmAttributeExtractor
+{
+
+public:
+
+    /// default constructor
+    DcmAttributeExtractor();
+
+    /// destructor
+    ~DcmAttributeExtractor();
+
+    /** add a column for the given attribute
+     *  @param path path of the attribute to be extracted (see class DcmPath)
+     *  @param name name of the column. If empty, the path is used.
+     *  @param type type of the column values. ECL_auto determines the type from
+     *    the value representation of the attribute in the data dictionary.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition addColumn(const OFString &path,
+                          const OFString &name = "",
+                          const E_ColumnType type = ECL_auto);
+
+    /// remove all columns
+    void clear();
+
+    /** get the number of columns
+     *  @return number of columns
+     */
+    size_t getNumberOfColumns() const;
+
+    /** get the name of the given column
+     *  @param column index of the column (0..n-1)
+     *  @return name of the column, empty if the index is invalid
+     */
+    const OFString &getColumnName(const size_t column) const;
+
+    /** get the type of the given column
+     *  @param column index of the column (0..n-1)
+     *  @return type of the column (never ECL_auto), ECL_auto if the index is invalid
+     */
+    E_ColumnType getColumnType(const size_t column) const;
+
+    /** set the number of threads used for loading the DICOM files
+     *  @param numberOfThreads number of threads (0 or 1 = no additional threads)
+     */
+    void setNumberOfThreads(const unsigned int numberOfThreads);
+
+    /** set the maximum number of rows per batch passed to the writer
+     *  @param batchSize number of rows (default: 1000, 0 is mapped to 1)
+     */
+    void setBatchSize(const size_t batchSize);
+
+    /** enable or disable loading only the attributes needed (projection).
+     *  Disabling this mode is mainly useful for performance comparisons.
+     *  @param enabled load only the attributes needed if OFTrue (default),
+     *    load the complete files otherwise
+     */
+    void setProjectionMode(const OFBool enabled);
+
+    /** set the mode used for reading the DICOM files
+     *  @param readMode read files with or without meta header (default:
+     *    ERM_autoDetect). Use ERM_fileOnly in order to skip files that are not
+     *    in DICOM part 10 format.
+     */
+    void setReadMode(const E_FileReadMode readMode);
+
+    /** extract the attribute values from the given DICOM file and append a
+     *  row to the given batch
+     *  @param filename name of the DICOM file
+     *  @param batch batch to which the row is appended. If the batch does not
+     *    have the columns of this extractor yet, it is cleared first.
+     *  @return status, EC_Normal if successful, an error code otherwise (in
+     *    this case, no row is appended)
+     */
+    OFCondition extractFile(const OFFilename &filename,
+                            DcmExtractionBatch &batch) const;
+
+    /** extract the attribute values from the given DICOM files and pass them
+     *  to the given writer. The files are processed in batches, each batch
+     *  is loaded by the configured number of threads. Files that cannot be
+     *  loaded are skipped.
+     *  @param filenames names of the DICOM files
+     *  @param writer writer that receives the extracted batches
+     *  @param badFiles list to which the names of the files that cannot be
+     *    loaded are added
+     *  @return status, EC_Normal if successful, an error code otherwise (i.e.
+     *    if there are no columns or the writer failed)
+     */
+    OFCondition extract(const OFList<OFFilename> &filenames,
+                        DcmExtractionWriter &writer,
+                        OFList<OFFilename> &badFiles) const;
+
+    /** extract the attribute values from the DICOM file of the given row of
+     *  the given batch. This method is called by the worker threads and
+     *  should not be used otherwise.
+     *  @param batch batch with the name of the file, resized to the columns of
+     *    this extractor
+     *  @param row index of the row to be extracted
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition extractRow(DcmExtractionBatch &batch,
+                           const size_t row) const;
+
+private:
+
+    /// one step of the path of an attribute
+    struct Step
+    {
+        /// tag of the attribute
+        DcmTagKey tag;
+        /// number of the item (for sequences that are not the last step)
+        Uint32 itemNo;
+        /// OFTrue if any item is to be searched
+        OFBool wildcard;
+    };
+
+    /// description of a column
+    struct ColumnInfo
+    {
+        /// name of the column
+        OFString name;
+        /// type of the column (never ECL_auto)
+        E_ColumnType type;
+        /// steps of the path of the attribute
+        OFVector<Step> steps;
+    };
+
+    /** find the element for the given column, starting from the given item
+     *  @param item item where the search starts
+     *  @param steps steps of the path of the attribute
+     *  @param pos index of the current step
+     *  @return element found, NULL if absent
+     */
+    static DcmElement *findElement(DcmItem *item,
+                                   const OFVector<Step> &steps,
+                                   const size_t pos);
+
+    /** store the value of the given element in the given batch
+     *  @param element element to be stored (may be NULL)
+     *  @param batch batch in which the value is stored
+     *  @param row index of the row
+     *  @param column index of the column
+     */
+    static void storeValue(DcmElement *element,
+                           DcmExtractionBatch &batch,
+                           const size_t row,
+                           const size_t column);
+
+    /// private undefined copy constructor
+    DcmAttributeExtractor(const DcmAttributeExtractor &);
+
+    /// private undefined assignment operator
+    DcmAttributeExtractor &operator=(const DcmAttributeExtractor &);
+
+    /// descriptions of the columns
+    OFVector<ColumnInfo> columns;
+
+    /// attributes to be read from the dataset
+    DcmAttributeProjection projection;
+
+    /// number of threads used for loading the DICOM files
+    unsigned int numThreads;
+
+    /// maximum number of rows per batch
+    size_t maxBatchSize;
+
+    /// load only the attributes needed if OFTrue
+    OFBool useProjection;
+
+    /// mode used for reading the DICOM files
+    E_FileReadMode fileReadMode;
+};
+
+
+#endif
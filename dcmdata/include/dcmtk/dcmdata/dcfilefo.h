@@ -30,6 +30,8 @@
 
 
 // forward declarations
+class DcmAttributeProjection;
+class DcmLazyLoadBudget;
 class DcmMetaInfo;
 class DcmJsonFormat;
 class DcmInputStream;
@@ -302,6 +304,35 @@ class DCMTK_DCMDATA_EXPORT DcmFileFormat
                                  const E_FileReadMode readMode = ERM_autoDetect,
                                  const DcmTagKey &stopParsingAtElement = DCM_UndefinedTagKey);
 
+    /** load only the given set of attributes from a DICOM file ("projection").
+     *  The meta header (if present) is always read completely. In the dataset,
+     *  only the attributes selected by the projection are created. All other
+     *  element values are skipped without reading them, and parsing stops as soon
+     *  as all selected attributes of the main dataset have been read. This is
+     *  much faster than loading the complete file if only a few attributes are
+     *  needed, e.g. for indexing. See class DcmAttributeProjection for details.
+     *  Please note that the resulting dataset is incomplete and should, therefore,
+     *  not be written back to a file.
+     *  @param fileName name of the file to load (may contain wide chars if support enabled).
+     *    Since there are various constructors for the OFFilename class, a "char *", "OFString"
+     *    or "wchar_t *" can also be passed directly to this parameter.
+     *  @param projection set of attributes to be loaded from the dataset
+     *  @param readXfer transfer syntax used to read the data (auto detection if EXS_Unknown)
+     *  @param groupLength flag, specifying how to handle the group length tags
+     *  @param maxReadLength maximum number of bytes to be read for an element value.
+     *    Element values with a larger size are not loaded until their value is retrieved
+     *    (with getXXX()) or loadAllDataIntoMemory() is called.
+     *  @param readMode read file with or without meta header, i.e. as a fileformat or a
+     *    dataset.  Use ERM_fileOnly in order to force the presence of a meta header.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition loadFileProjection(const OFFilename &fileName,
+                                           const DcmAttributeProjection &projection,
+                                           const E_TransferSyntax readXfer = EXS_Unknown,
+                                           const E_GrpLenEncoding groupLength = EGL_noChange,
+                                           const Uint32 maxReadLength = DCM_MaxReadLength,
+                                           const E_FileReadMode readMode = ERM_autoDetect);
+
     /** save object to a DICOM file.
      *  @param fileName name of the file to save (may contain wide chars if support enabled).
      *    Since there are various constructors for the OFFilename class, a "char *", "OFString"
@@ -390,6 +421,30 @@ class DCMTK_DCMDATA_EXPORT DcmFileFormat
         FileReadMode = readMode;
     }
 
+    /** set the memory budget for element values of this file format that are
+     *  loaded on demand, i.e. values that have not been loaded during the read
+     *  process (see parameter maxReadLength of loadFile()). Values that have
+     *  been released by the caller (see DcmElement::releaseValue()) are removed
+     *  from memory again in the order of their release when the total size of
+     *  the values loaded on demand exceeds the budget. They will be loaded
+     *  again from file upon next access. Values that are still in use are never
+     *  removed. Reducing the budget removes released values immediately if
+     *  needed. A value of 0 (the default) disables the memory budget.
+     *  @param bytes memory budget in bytes
+     */
+    void setMemoryBudget(const size_t bytes);
+
+    /** get the memory budget for element values loaded on demand
+     *  @return memory budget in bytes, 0 if disabled
+     */
+    size_t getMemoryBudget() const;
+
+    /** get the total size of the element values of this file format that are
+     *  loaded on demand and currently accounted for in the memory budget
+     *  @return number of bytes, 0 if the memory budget is disabled
+     */
+    size_t getLoadedBytes() const;
+
     /** method inherited from base class that shall not be used for instances of this class.
      *  Method immediately returns with error code.
      *  @param item item
@@ -469,6 +524,9 @@ class DCMTK_DCMDATA_EXPORT DcmFileFormat
 
   private:
 
+    // elements account for values loaded on demand in the memory budget
+    friend class DcmElement;
+
     /** This function checks if a particular data element of the file meta information header is
      *  existent.  If the element is not existent, it will be inserted.  Additionally, this function
      *  makes sure that the corresponding data element will contain a correct value.
@@ -496,6 +554,9 @@ class DCMTK_DCMDATA_EXPORT DcmFileFormat
 
     /// file read mode, specifies whether to read the meta header or not
     E_FileReadMode FileReadMode;
+
+    /// memory budget for values loaded on demand, NULL if disabled
+    DcmLazyLoadBudget *MemoryBudget;
 };
 
 
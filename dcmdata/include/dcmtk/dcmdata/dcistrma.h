@@ -119,7 +119,10 @@ enum DcmInputStreamFactoryType
   DFT_DcmInputFileStreamFactory,
 
   /// class DcmInputTempFileStreamFactory
-  DFT_DcmInputTempFileStreamFactory
+  DFT_DcmInputTempFileStreamFactory,
+
+  /// class DcmInputBufferStreamFactory
+  DFT_DcmInputBufferStreamFactory
 };
 
 /** pure virtual abstract base class for input stream factories,
@@ -198,4 +198,62 @@ private:
 };
 
 
+/** input stream factory that creates input streams reading from a block
+ *  of memory provided by the caller. This can be used to create element
+ *  values that are not loaded into memory but read block by block while
+ *  writing, see DcmElement::createValueFromTempFile(). The memory is not
+ *  copied and must remain valid and unchanged as long as the factory
+ *  (or any copy created by clone()) exists.
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputBufferStreamFactory: public DcmInputStreamFactory
+{
+public:
+
+  /** constructor
+   *  @param buf buffer from which data is read, not copied
+   *  @param buflen buffer length, must be even number > 0
+   */
+  DcmInputBufferStreamFactory(const void *buf, offile_off_t buflen);
+
+  /** copy constructor
+   *  @param arg the factory to copy
+   */
+  DcmInputBufferStreamFactory(const DcmInputBufferStreamFactory &arg);
+
+  /// destructor
+  virtual ~DcmInputBufferStreamFactory();
+
+  /** create a new input stream object
+   *  @return pointer to new input stream object
+   */
+  virtual DcmInputStream *create() const;
+
+  /** returns a pointer to a copy of this object
+   */
+  virtual DcmInputStreamFactory *clone() const
+  {
+    return new DcmInputBufferStreamFactory(*this);
+  }
+
+  /** returns an enum describing the class to which this instance belongs
+   *  @return class to which this instance belongs
+   */
+  virtual DcmInputStreamFactoryType ident() const
+  {
+    return DFT_DcmInputBufferStreamFactory;
+  }
+
+private:
+
+  /// private unimplemented copy assignment operator
+  DcmInputBufferStreamFactory& operator=(const DcmInputBufferStreamFactory&);
+
+  /// buffer from which data is read
+  const void *buffer_;
+
+  /// buffer length
+  offile_off_t buflen_;
+};
+
+
 #endif
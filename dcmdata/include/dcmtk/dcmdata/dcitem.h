@@ -33,6 +33,7 @@
 
 
 // forward declarations
+class DcmAttributeProjection;
 class DcmElement;
 class DcmJsonFormat;
 class DcmSequenceOfItems;
@@ -259,6 +260,16 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                      const Uint32 maxReadLength = DCM_MaxReadLength,
                                      const DcmTagKey &stopParsingAtElement = DCM_UndefinedTagKey);
 
+    /** set the projection, i.e.\ the set of attributes, that is applied when
+     *  reading this item from a stream. Elements that are not selected are
+     *  skipped without reading their value. The items of selected sequences
+     *  automatically use the corresponding part of the projection.
+     *  See class DcmAttributeProjection for details.
+     *  @param projection projection to be applied, or NULL to read all elements.
+     *    The object is not copied, so it must exist until reading is completed.
+     */
+    void setReadProjection(const DcmAttributeProjection *projection);
+
     /** write object to a stream
      *  @param outStream DICOM output stream
      *  @param oxfer output transfer syntax
@@ -1420,6 +1431,26 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                const E_GrpLenEncoding glenc,     // in
                                const Uint32 maxReadLength = DCM_MaxReadLength);
 
+    /** This function skips the value of an element that is not selected by the
+     *  read projection. Values with explicit length are skipped in the stream
+     *  without reading them. Elements with undefined length are read and then
+     *  discarded, since their end can only be determined by parsing them.
+     *  @param inStream      The stream which contains the information.
+     *  @param newTag        The tag of the element to be skipped.
+     *  @param newLength     The length of the element's value.
+     *  @param xfer          The transfer syntax which was used to encode the
+     *                       information in inStream.
+     *  @param glenc         Encoding type for group length.
+     *  @param maxReadLength Maximum read length for reading the attribute value.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition skipSubElement(DcmInputStream &inStream,         // inout
+                               DcmTag &newTag,                   // inout
+                               const Uint32 newLength,           // in
+                               const E_TransferSyntax xfer,      // in
+                               const E_GrpLenEncoding glenc,     // in
+                               const Uint32 maxReadLength);      // in
+
     /** This function reads the first 6 bytes from the input stream and determines
      *  the transfer syntax which was used to code the information in the stream.
      *  The decision is based on two questions: a) Did we encounter a valid tag?
@@ -1502,6 +1533,9 @@ class DCMTK_DCMDATA_EXPORT DcmItem
 
     /// cache for private creator tags and identifiers
     DcmPrivateTagCache privateCreatorCache;
+
+    /// projection applied while reading this item, NULL if all elements are read
+    const DcmAttributeProjection *readProjection;
 };
 
 /** Checks whether left hand side item is smaller than right hand side
@@ -213,6 +213,15 @@ public:
     static void printNumberDecimal(STD_NAMESPACE ostream &out,
                                    OFString &value);
 
+    /** Print either null if empty or a Number as created by OFStandard::ftoa()
+     *  with %g conversion format. Such a number has no leading zeros, so only
+     *  the plus signs have to be removed, which is done without copying the value.
+     *  @param out output stream to which the Value prefix is written
+     *  @param value zero-terminated string that should be printed
+     */
+    static void printNumberDecimal(STD_NAMESPACE ostream &out,
+                                   const char *value);
+
     /** Constructor
      *  @param printMetaInfo parameter that defines if meta information should be written
      */
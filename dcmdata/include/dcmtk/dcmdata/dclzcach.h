@@ -0,0 +1,373 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: file handle cache and memory budget for values loaded on demand
+ *
+ */
+
+#ifndef DCLZCACH_H
+#define DCLZCACH_H
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/ofstd/offile.h"      /* for offile_off_t, OFFilename */
+#include "dcmtk/dcmdata/dcistrma.h"  /* for class DcmInputStream */
+#include "dcmtk/ofstd/oflist.h"      /* for class OFList */
+#include "dcmtk/ofstd/ofmap.h"       /* for class OFMap */
+
+class DcmElement;
+class DcmCachedFileHandle;
+
+/** This class manages the file handles used when element values that have
+ *  not been loaded during the read process (see parameter maxReadLength of
+ *  DcmFileFormat::loadFile()) are loaded later on demand.
+ *  All methods are static and thread-safe, the cache is shared by all
+ *  datasets of the process. The cache keeps a bounded LRU list of open file
+ *  handles, each with a small read-ahead buffer. When enabled, loading a
+ *  value re-uses an idle handle for the same file instead of opening and
+ *  closing the file each time. Handles are never shared between concurrent
+ *  readers: a handle in use by one stream is not available to others, which
+ *  open a separate handle. The cache is disabled by default.
+ *  The memory used by values loaded on demand can be limited separately for
+ *  each file format, see DcmFileFormat::setMemoryBudget().
+ */
+class DCMTK_DCMDATA_EXPORT DcmLazyLoadCache
+{
+public:
+
+  /** set the maximum number of idle file handles kept open.
+   *  A value of 0 (the default) disables the file handle cache. Reducing the
+   *  number closes the least recently used idle handles immediately.
+   *  @param maxFiles maximum number of idle file handles
+   */
+  static void setMaxOpenFiles(size_t maxFiles);
+
+  /** get the maximum number of idle file handles kept open
+   *  @return maximum number of idle file handles, 0 if cache disabled
+   */
+  static size_t getMaxOpenFiles();
+
+  /** get the number of file handles currently kept open by the cache
+   *  (excluding handles currently used by an input stream)
+   *  @return number of idle file handles
+   */
+  static size_t getNumberOfOpenFiles();
+
+  /** set the size of the read-ahead buffer of each cached file handle.
+   *  Reads smaller than this size are served from the buffer, larger reads
+   *  are passed directly to the file. A value of 0 disables read-ahead.
+   *  @param bytes buffer size in bytes, default is 65536
+   */
+  static void setReadAheadSize(size_t bytes);
+
+  /** get the size of the read-ahead buffer of each cached file handle
+   *  @return buffer size in bytes
+   */
+  static size_t getReadAheadSize();
+
+  /** close all idle file handles for the given file. Handles for this file
+   *  that are currently in use are closed when they are released. This should
+   *  be called if a file is modified while the cache is enabled. Files written
+   *  by dcmdata itself are handled automatically.
+   *  @param filename name of the file
+   */
+  static void closeFile(const OFFilename &filename);
+
+  /** close all idle file handles
+   */
+  static void closeAll();
+
+  /** check whether values from the given file can be read through the cache
+   *  @param filename name of the file
+   *  @return OFTrue if the file handle cache is enabled and supports the
+   *    given filename, OFFalse otherwise
+   */
+  static OFBool isCachable(const OFFilename &filename);
+
+  /** get a file handle for exclusive use, either from the cache or by
+   *  opening the file. Used by DcmCachedFileProducer.
+   *  @param filename name of the file
+   *  @param status error status returned in this parameter
+   *  @return pointer to file handle, NULL in case of error
+   */
+  static DcmCachedFileHandle *acquireFile(const OFFilename &filename, OFCondition &status);
+
+  /** return a file handle obtained with acquireFile() to the cache. The
+   *  handle is kept open if the cache has room for it and closed otherwise.
+   *  @param handle file handle, may be NULL
+   */
+  static void releaseFile(DcmCachedFileHandle *handle);
+
+  /** read from a file handle obtained with acquireFile(), using the
+   *  read-ahead buffer where appropriate
+   *  @param handle file handle, must not be NULL
+   *  @param pos position in file where to start reading
+   *  @param buf buffer to read into, must not be NULL
+   *  @param buflen number of bytes to read
+   *  @return number of bytes actually read
+   */
+  static offile_off_t read(DcmCachedFileHandle *handle, offile_off_t pos, void *buf, offile_off_t buflen);
+
+  /** get the size of the file associated with a file handle
+   *  @param handle file handle, must not be NULL
+   *  @return file size in bytes
+   */
+  static offile_off_t fileSize(const DcmCachedFileHandle *handle);
+
+private:
+
+  /** close idle file handles until the given number is met. Must be called
+   *  while holding the lock.
+   *  @param maxFiles maximum number of idle file handles
+   */
+  static void trimFiles(size_t maxFiles);
+};
+
+
+/// an element value loaded on demand and accounted for in a memory budget
+struct DCMTK_DCMDATA_EXPORT DcmLazyLoadValue
+{
+  /// the element
+  DcmElement *element;
+
+  /// length of the value in bytes
+  Uint32 length;
+
+  /// byte order of the value as read from file
+  E_ByteOrder byteOrder;
+
+  /// true if the value has been released by its owner
+  OFBool released;
+};
+
+
+/** This class limits the memory used by element values of a single file
+ *  format that are loaded on demand (see DcmFileFormat::setMemoryBudget()).
+ *  Each value loaded on demand is accounted for in the budget. Values are
+ *  only removed from memory again if the owner of the dataset has declared
+ *  that it no longer uses them (see DcmElement::releaseValue()), in the order
+ *  in which they have been released, and only if the budget is exceeded.
+ *  A value that is accessed again is no longer considered released. Values
+ *  that are modified through the DcmElement API or that have been converted
+ *  to another byte order leave the budget or are never removed, respectively.
+ *  Since the budget only refers to elements of its file format, it is subject
+ *  to the same restrictions regarding multi-threading as the dataset itself.
+ *  This class is used internally by DcmFileFormat and DcmElement.
+ */
+class DCMTK_DCMDATA_EXPORT DcmLazyLoadBudget
+{
+public:
+
+  /** constructor
+   *  @param bytes memory budget in bytes, 0 for unlimited
+   */
+  DcmLazyLoadBudget(size_t bytes);
+
+  /// destructor, detaches all elements that are still accounted for
+  ~DcmLazyLoadBudget();
+
+  /** set the memory budget. Reducing the budget removes released values
+   *  from memory immediately if needed.
+   *  @param bytes memory budget in bytes, 0 for unlimited
+   */
+  void setLimit(size_t bytes);
+
+  /** get the memory budget
+   *  @return memory budget in bytes, 0 if unlimited
+   */
+  size_t getLimit() const;
+
+  /** get the total size of the element values loaded on demand that are
+   *  currently held in memory
+   *  @return number of bytes
+   */
+  size_t getLoadedBytes() const;
+
+  /** add an element value that has just been loaded on demand to the
+   *  budget, and remove released values from memory if the budget is
+   *  exceeded. Called by DcmElement::loadValue().
+   *  @param element element whose value has been loaded
+   *  @param length length of the value in bytes
+   */
+  void registerValue(DcmElement *element, Uint32 length);
+
+  /** remove an element value from the budget, e.g. because the value has
+   *  been modified or deleted. Called by DcmElement.
+   *  @param element element whose value is no longer accounted for
+   */
+  void unregisterValue(DcmElement *element);
+
+  /** mark an element value as released by its owner, i.e. the value may be
+   *  removed from memory if the budget is exceeded. Called by
+   *  DcmElement::releaseValue().
+   *  @param element element whose value is released
+   */
+  void releaseValue(DcmElement *element);
+
+  /** mark an element value as used again, i.e. the value is not removed from
+   *  memory until it is released again. Called by DcmElement::getValue().
+   *  @param element element whose value is used
+   */
+  void claimValue(DcmElement *element);
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmLazyLoadBudget(const DcmLazyLoadBudget&);
+
+  /// private unimplemented copy assignment operator
+  DcmLazyLoadBudget& operator=(const DcmLazyLoadBudget&);
+
+  /// remove released values from memory until the budget is met
+  void enforce();
+
+  /// memory budget in bytes, 0 if unlimited
+  size_t limit_;
+
+  /// total size of all values accounted for
+  size_t loadedBytes_;
+
+  /// values accounted for that are in use by the owner
+  OFList<DcmLazyLoadValue> usedValues_;
+
+  /// values accounted for that have been released, least recently released first
+  OFList<DcmLazyLoadValue> releasedValues_;
+
+  /// index into the lists of values
+  OFMap<const DcmElement *, OFListIterator(DcmLazyLoadValue)> index_;
+};
+
+
+/** producer class that reads data from a plain file using a file handle
+ *  managed by DcmLazyLoadCache.
+ */
+class DCMTK_DCMDATA_EXPORT DcmCachedFileProducer: public DcmProducer
+{
+public:
+  /** constructor
+   *  @param filename name of file to be opened
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmCachedFileProducer(const OFFilename &filename, offile_off_t offset = 0);
+
+  /// destructor, returns the file handle to the cache
+  virtual ~DcmCachedFileProducer();
+
+  /** returns the status of the producer. Unless the status is good,
+   *  the producer will not permit any operation.
+   *  @return status, true if good
+   */
+  virtual OFBool good() const;
+
+  /** returns the status of the producer as an OFCondition object.
+   *  Unless the status is good, the producer will not permit any operation.
+   *  @return status, EC_Normal if good
+   */
+  virtual OFCondition status() const;
+
+  /** returns true if the producer is at the end of stream.
+   *  @return true if end of stream, false otherwise
+   */
+  virtual OFBool eos();
+
+  /** returns the minimum number of bytes that can be read with the
+   *  next call to read().
+   *  @return minimum of data available in producer
+   */
+  virtual offile_off_t avail();
+
+  /** reads as many bytes as possible into the given block.
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen length of memory block
+   *  @return number of bytes actually read.
+   */
+  virtual offile_off_t read(void *buf, offile_off_t buflen);
+
+  /** skips over the given number of bytes (or less)
+   *  @param skiplen number of bytes to skip
+   *  @return number of bytes actually skipped.
+   */
+  virtual offile_off_t skip(offile_off_t skiplen);
+
+  /** resets the stream to the position by the given number of bytes.
+   *  @param num number of bytes to putback. If the putback operation
+   *    fails, the producer status becomes bad.
+   */
+  virtual void putback(offile_off_t num);
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmCachedFileProducer(const DcmCachedFileProducer&);
+
+  /// private unimplemented copy assignment operator
+  DcmCachedFileProducer& operator=(const DcmCachedFileProducer&);
+
+  /// the file handle we're reading from, NULL if the file could not be opened
+  DcmCachedFileHandle *handle_;
+
+  /// status
+  OFCondition status_;
+
+  /// number of bytes in file
+  offile_off_t size_;
+
+  /// current read position
+  offile_off_t pos_;
+};
+
+
+/** input stream that reads from a plain file using a file handle managed
+ *  by DcmLazyLoadCache. Created by DcmInputFileStreamFactory::create()
+ *  if the file handle cache is enabled.
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputCachedFileStream: public DcmInputStream
+{
+public:
+  /** constructor
+   *  @param filename name of file to be opened
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputCachedFileStream(const OFFilename &filename, offile_off_t offset = 0);
+
+  /// destructor
+  virtual ~DcmInputCachedFileStream();
+
+  /** creates a new factory object for the current stream
+   *  and stream position.
+   *  @return pointer to new factory object if successful, NULL otherwise.
+   */
+  virtual DcmInputStreamFactory *newFactory() const;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmInputCachedFileStream(const DcmInputCachedFileStream&);
+
+  /// private unimplemented copy assignment operator
+  DcmInputCachedFileStream& operator=(const DcmInputCachedFileStream&);
+
+  /// the final producer of the filter chain
+  DcmCachedFileProducer producer_;
+
+  /// filename
+  OFFilename filename_;
+
+  /// initial offset in file
+  offile_off_t offset_;
+};
+
+#endif
@@ -25,9 +25,32 @@
 
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/dcmdata/dcostrma.h"
+#include "dcmtk/ofstd/ofglobal.h"
 
 class OFFile;
 
+/** global flag defining the size of the output buffer (in bytes) that is used
+ *  by DcmFileConsumer for the files it creates. A larger buffer reduces the
+ *  number of system calls when writing many small elements, while large values
+ *  are still passed to the operating system directly from the memory of the
+ *  element. The value also determines the buffer size used by saveFile() for
+ *  values that are still read from file (see DcmWriteCache), if it is larger
+ *  than the default. 0 (default) uses the default buffer size of the C library.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmFileWriteBufferSize; /* default 0 */
+
+/** global flag defining whether DcmFileConsumer creates files in a crash-safe
+ *  ("durable") way. If enabled, the data is first written to a temporary file
+ *  in the same directory, which is flushed to disk (fdatasync/fsync) and then
+ *  renamed to the final filename when the consumer is closed. Hence, the file
+ *  either exists with its complete content or not at all, even if the system
+ *  crashes while or directly after writing. The space for the file is
+ *  preallocated if the expected size is known (see DcmOutputFileStream::preallocate()).
+ *  Only applies to regular files, not to special files such as /dev/null, and
+ *  not to files that have been opened by the caller. Default is OFFalse.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmDurableFileWrite; /* default OFFalse */
+
 /** consumer class that stores data in a plain file.
  */
 class DCMTK_DCMDATA_EXPORT DcmFileConsumer: public DcmConsumer
@@ -96,6 +119,29 @@ public:
    */
   virtual void flush();
 
+  /** reserves disk space for the given number of bytes, so that writing the
+   *  file does not fail due to a full disk later on and the file is less
+   *  fragmented. The file is truncated to the number of bytes actually written
+   *  when it is closed. Only done in durable mode (see dcmDurableFileWrite)
+   *  and if supported by the operating system, otherwise the call is ignored.
+   *  @param size expected size of the file in bytes
+   *  @return status, EC_Normal if successful (or ignored), an error code otherwise
+   */
+  OFCondition preallocate(offile_off_t size);
+
+  /** closes the file. In durable mode (see dcmDurableFileWrite), the data is
+   *  flushed to disk and the temporary file is renamed to the final filename,
+   *  unless the status of the consumer is bad or the data is to be discarded,
+   *  in which case the temporary file is deleted. This method is called by the
+   *  destructor if needed, but only an explicit call allows for checking
+   *  whether the data has been written successfully.
+   *  @param discard if OFTrue, the data written is discarded in durable mode,
+   *    i.e.\ an existing file with the final filename remains unchanged, e.g.\
+   *    because an error occurred while creating the data. Ignored otherwise.
+   *  @return status, EC_Normal if successful, an error code otherwise
+   */
+  OFCondition close(const OFBool discard = OFFalse);
+
 private:
 
   /// private unimplemented copy constructor
@@ -113,6 +159,24 @@ private:
 
   /// status
   OFCondition status_;
+
+  /// name of the file to be created, empty if opened by the caller
+  OFFilename filename_;
+
+  /// name of the temporary file written in durable mode, empty otherwise
+  OFFilename tempFilename_;
+
+  /// output buffer passed to setvbuf(), NULL if not used
+  char *buffer_;
+
+  /// number of bytes written so far
+  offile_off_t written_;
+
+  /// number of bytes preallocated, 0 if none
+  offile_off_t preallocated_;
+
+  /// true if the file has been closed by close()
+  OFBool closed_;
 };
 
 
@@ -142,6 +206,20 @@ public:
   /// destructor
   virtual ~DcmOutputFileStream();
 
+  /** reserves disk space for the given number of bytes, see
+   *  DcmFileConsumer::preallocate() for details.
+   *  @param size expected size of the file in bytes
+   *  @return status, EC_Normal if successful (or ignored), an error code otherwise
+   */
+  OFCondition preallocate(offile_off_t size);
+
+  /** flushes the stream and closes the file, see DcmFileConsumer::close()
+   *  for details. After this call, no more data may be written to the stream.
+   *  @param discard if OFTrue, the data written is discarded in durable mode
+   *  @return status, EC_Normal if successful, an error code otherwise
+   */
+  OFCondition close(const OFBool discard = OFFalse);
+
 private:
 
   /// private unimplemented copy constructor
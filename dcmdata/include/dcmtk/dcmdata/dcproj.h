@@ -0,0 +1,147 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Class for selecting the attributes to be read from a DICOM stream
+ *
+ */
+
+
+#ifndef DCPROJ_H
+#define DCPROJ_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofstring.h"
+#include "dcmtk/ofstd/ofcond.h"
+#include "dcmtk/dcmdata/dctagkey.h"
+
+
+/** Set of attributes to be read from a DICOM stream ("projection").
+ *  When a projection is passed to DcmFileFormat::loadFileProjection() (or set
+ *  with DcmItem::setReadProjection()), the parser only creates the selected
+ *  elements. All other elements are skipped using their value length, i.e.
+ *  their value is never read from the stream. Elements with undefined length
+ *  (e.g. sequences or encapsulated pixel data) cannot be skipped this way and
+ *  are parsed without being kept. Reading of the main dataset stops as soon as
+ *  the tag of the current element is larger than the largest selected tag.
+ *  Within sequence items, the rest of an item with explicit length is skipped
+ *  after the last selected element.
+ *  Attributes in sequence items are selected using the path syntax of class
+ *  DcmPath, e.g. "ReferencedSeriesSequence[*].SeriesInstanceUID". Item numbers
+ *  are not evaluated, i.e. the attributes are read from all items of the
+ *  sequence. Specific Character Set (0008,0005) and private reservation
+ *  elements (gggg,0010-00FF) are always read, since they are needed to
+ *  interpret the values of the selected elements.
+ *  Please note that the resulting dataset is incomplete and should, therefore,
+ *  not be written back to a file.
+ */
+class DCMTK_DCMDATA_EXPORT DcmAttributeProjection
+{
+
+public:
+
+    /// default constructor, creates an empty projection
+    DcmAttributeProjection();
+
+    /// destructor
+    ~DcmAttributeProjection();
+
+    /** select an attribute on the main dataset level, including all of its
+     *  nested content (if it is a sequence)
+     *  @param tagKey tag of the attribute to be selected
+     */
+    void addTag(const DcmTagKey &tagKey);
+
+    /** select an attribute given in path syntax (see class DcmPath), e.g.
+     *  "PatientName", "(0010,0010)" or "(0008,1115)[*].(0020,000E)". If the
+     *  path ends with a sequence or an item, the sequence is selected
+     *  including all of its nested content.
+     *  @param path path of the attribute to be selected
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition addPath(const OFString &path);
+
+    /// remove all selected attributes
+    void clear();
+
+    /** check whether no attribute is selected at all
+     *  @return OFTrue if the projection is empty, OFFalse otherwise
+     */
+    OFBool empty() const;
+
+    /** check whether the element with the given tag is to be read on the
+     *  level of this projection. This includes elements that are only read
+     *  partially, i.e. sequences with selected attributes in their items.
+     *  @param tagKey tag of the element to be checked
+     *  @return OFTrue if the element is to be read, OFFalse if it can be skipped
+     */
+    OFBool isSelected(const DcmTagKey &tagKey) const;
+
+    /** get the projection for the items of the given sequence
+     *  @param tagKey tag of the sequence
+     *  @return projection to be applied to the items of the sequence, or NULL
+     *    if the items are to be read completely (or the sequence is not selected)
+     */
+    const DcmAttributeProjection *getItemProjection(const DcmTagKey &tagKey) const;
+
+    /** get the largest tag that is selected on the level of this projection.
+     *  Elements with a larger tag do not need to be read.
+     *  @return largest selected tag, (0000,0000) if the projection is empty
+     */
+    const DcmTagKey &getLastTag() const;
+
+private:
+
+    /// selected attribute on one level of the projection
+    struct Entry
+    {
+        /// tag of the selected attribute
+        DcmTagKey tag;
+        /// projection for the items of a sequence, NULL if read completely
+        DcmAttributeProjection *items;
+    };
+
+    /** find the entry for the given tag
+     *  @param tagKey tag to search for
+     *  @return index of the entry or of the position where it would be inserted
+     */
+    size_t find(const DcmTagKey &tagKey) const;
+
+    /** get the entry for the given tag, create it if needed
+     *  @param tagKey tag of the selected attribute
+     *  @param complete if OFTrue, select the attribute including all of its content
+     *  @return projection for the items of the sequence (if not complete), NULL otherwise
+     */
+    DcmAttributeProjection *select(const DcmTagKey &tagKey,
+                                   const OFBool complete);
+
+    /// private undefined copy constructor
+    DcmAttributeProjection(const DcmAttributeProjection &);
+
+    /// private undefined assignment operator
+    DcmAttributeProjection &operator=(const DcmAttributeProjection &);
+
+    /// selected attributes on this level, sorted by tag
+    OFVector<Entry> entries;
+
+    /// largest selected tag on this level
+    DcmTagKey lastTag;
+};
+
+
+#endif
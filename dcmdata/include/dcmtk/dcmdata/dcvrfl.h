@@ -218,7 +218,17 @@ class DCMTK_DCMDATA_EXPORT DcmFloatingPointSingle
     virtual OFBool matches(const DcmElement& candidate,
                            const OFBool enableWildCardMatching = OFTrue) const;
 
-    /** write object in JSON format
+    /** write object in XML format. The values are written with the minimum
+     *  number of digits that are needed to read the same values back.
+     *  @param out output stream to which the XML document is written
+     *  @param flags optional flag used to customize the output (see DCMTypes::XF_xxx)
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition writeXML(STD_NAMESPACE ostream &out,
+                                 const size_t flags = 0);
+
+    /** write object in JSON format. The values are written with the minimum
+     *  number of digits that are needed to read the same values back.
      *  @param out output stream to which the JSON document is written
      *  @param format used to format and customize the output
      *  @return status, EC_Normal if successful, an error code otherwise
@@ -24,6 +24,7 @@
 
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
+#include "dcmtk/ofstd/ofvector.h"
 #include "dcmtk/dcmdata/dcbytstr.h"
 
 
@@ -106,6 +107,17 @@ class DCMTK_DCMDATA_EXPORT DcmIntegerString
     virtual OFCondition getSint32(Sint32 &sintVal,
                                   const unsigned long pos = 0);
 
+    /** get stored integer values as a vector.
+     *  The string value is only parsed once and the individual values are converted
+     *  in place, i.e.\ this is much faster than calling getSint32() for each value.
+     *  Please note that only an element value consisting of zero or more spaces is considered
+     *  as being empty and, therefore, results in an empty vector with status ".good()".
+     *  @param sintVals reference to result variable
+     *    (cleared automatically before entries are added)
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition getSint32Vector(OFVector<Sint32> &sintVals);
+
     /** get a particular value as a character string
      *  @param stringVal variable in which the result value is stored
      *  @param pos index of the value in case of multi-valued elements (0..vm-1)
@@ -31,7 +31,7 @@
 class DcmElement;
 class DcmOutputStream;
 
-#define DcmWriteCacheBufsize 65536    /* buffer size, in bytes */
+#define DcmWriteCacheBufsize 65536    /* default buffer size, in bytes */
 
 /** This class implements a buffering mechanism that is used when writing large
  *  elements that reside in file into an output stream. DcmElement::getPartialValue
@@ -44,14 +44,19 @@ class DCMTK_DCMDATA_EXPORT DcmWriteCache
 {
 public:
 
-  /// default constructor. Construction is cheap (no allocation of memory block).
-  DcmWriteCache()
+  /** default constructor. Construction is cheap (no allocation of memory block).
+   *  @param bufsize size of the buffer to be allocated upon first use, in bytes.
+   *    Larger buffers reduce the number of read operations for elements whose
+   *    value resides in file. The size is rounded down to a multiple of 8 bytes
+   *    so that a value never needs to be byte-swapped across a buffer boundary.
+   */
+  explicit DcmWriteCache(Uint32 bufsize = DcmWriteCacheBufsize)
   : fcache_()
   , buf_(NULL)
   , owner_(NULL)
   , offset_(0)
   , numBytes_(0)
-  , capacity_(0)
+  , capacity_((bufsize & ~7U) ? (bufsize & ~7U) : DcmWriteCacheBufsize)
   , fieldLength_(0)
   , fieldOffset_(0)
   , byteOrder_(EBO_unknown)
@@ -706,8 +706,11 @@ OFCondition DcmDataset::saveFile(const OFFilename &fileName,
     /* check parameters first */
     if (!fileName.isEmpty())
     {
-        DcmWriteCache wcache;
+        /* use a larger buffer for values read from file if requested */
+        const Uint32 bufferSize = dcmFileWriteBufferSize.get();
+        DcmWriteCache wcache((bufferSize > DcmWriteCacheBufsize) ? bufferSize : DcmWriteCacheBufsize);
         DcmOutputStream *fileStream;
+        DcmOutputFileStream *outputFileStream = NULL;
 
         if (fileName.isStandardStream())
         {
@@ -715,18 +718,36 @@ OFCondition DcmDataset::saveFile(const OFFilename &fileName,
             fileStream = new DcmStdoutStream(fileName);
         } else {
             /* open file for output */
-            fileStream = new DcmOutputFileStream(fileName);
+            outputFileStream = new DcmOutputFileStream(fileName);
+            fileStream = outputFileStream;
         }
 
         /* check stream status */
         l_error = fileStream->status();
         if (l_error.good())
+        {
+            /* reserve disk space for the file (only in durable mode) */
+            if (dcmDurableFileWrite.get() && (outputFileStream != NULL) && (DcmXfer(writeXfer).getStreamCompression() == ESC_none))
+            {
+                const Uint32 fileLength = calcElementLength(writeXfer, encodingType);
+                if (fileLength != DCM_UndefinedLength)
+                    l_error = outputFileStream->preallocate(fileLength);
+            }
+        }
+        if (l_error.good())
         {
             /* write data to file */
             transferInit();
             l_error = write(*fileStream, writeXfer, encodingType, &wcache, groupLength, padEncoding, padLength, subPadLength);
             transferEnd();
         }
+        if (outputFileStream != NULL)
+        {
+            /* close file and check whether all data has been written (discard it in case of error) */
+            const OFCondition closeStatus = outputFileStream->close(l_error.bad());
+            if (l_error.good())
+                l_error = closeStatus;
+        }
         delete fileStream;
     }
     return l_error;
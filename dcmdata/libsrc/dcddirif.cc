@@ -38,6 +38,8 @@
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/ofstd/ofbmanip.h"     /* for class OFBitmanipTemplate */
 #include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofthread.h"
 
 
 /*-------------------------*
@@ -1144,6 +1146,330 @@ static OFBool isMultiframeStorageSOPClass(const OFString &sopClassUID)
 }
 
 
+/*------------------------*
+ *  local helper classes  *
+ *------------------------*/
+
+/* Index of the directory records by their unique key (e.g. SOPInstanceUID for
+ * IMAGE records) that is used by DicomDirInterface::findExistingRecord() in order
+ * to avoid iterating over all child records of a parent record.  The entries are
+ * stored in a hash table where each entry consists of the parent record, the
+ * record type, the kind of entry and the key value.  Since entries are never
+ * removed, an entry might be outdated (e.g. if the PatientName of an existing
+ * record has been updated), so each record found has still to be checked with
+ * DicomDirInterface::recordMatchesDataset().
+ */
+class DicomDirRecordIndex
+{
+
+  public:
+
+    /// kind of index entry
+    enum E_EntryKind
+    {
+        /// all child records of the parent record have been indexed
+        EK_Indexed,
+        /// there is at least one child record of the given type without unique key
+        EK_Unkeyed,
+        /// unique key of the record, e.g. StudyInstanceUID or PatientID
+        EK_Key,
+        /// PatientName of a PATIENT record (used if the PatientID is absent)
+        EK_Name
+    };
+
+    // constructor
+    DicomDirRecordIndex()
+      : Entries(),
+        Table()
+    {
+    }
+
+    // remove all entries
+    void clear()
+    {
+        Entries.clear();
+        Table.clear();
+    }
+
+    // add an entry (if not already present)
+    void add(const DcmDirectoryRecord *parent,
+             const E_DirRecType recordType,
+             const E_EntryKind kind,
+             const OFString &key,
+             DcmDirectoryRecord *record)
+    {
+        size_t count = 0;
+        if (find(parent, recordType, kind, key, count, record) == NULL)
+        {
+            /* keep the load factor of the hash table below 1 */
+            if (Entries.size() >= Table.size())
+                rehash((Table.empty()) ? 1024 : Table.size() * 2);
+            Entry entry;
+            entry.Parent = parent;
+            entry.RecordType = recordType;
+            entry.Kind = kind;
+            entry.Key = key;
+            entry.Record = record;
+            Entries.push_back(entry);
+            insert(Entries.size() - 1);
+        }
+    }
+
+    // find entries for the given key, returns the first record found (or the given
+    // one if it is among the entries) and the number of entries
+    DcmDirectoryRecord *find(const DcmDirectoryRecord *parent,
+                             const E_DirRecType recordType,
+                             const E_EntryKind kind,
+                             const OFString &key,
+                             size_t &count,
+                             const DcmDirectoryRecord *record = NULL) const
+    {
+        DcmDirectoryRecord *result = NULL;
+        count = 0;
+        if (!Table.empty())
+        {
+            size_t pos = Table[hash(parent, recordType, kind, key) & (Table.size() - 1)];
+            while (pos > 0)
+            {
+                const Entry &entry = Entries[pos - 1];
+                if ((entry.Parent == parent) && (entry.RecordType == recordType) &&
+                    (entry.Kind == kind) && (entry.Key == key))
+                {
+                    if (record == NULL)
+                    {
+                        /* return first record and count all of them */
+                        if (count == 0)
+                            result = entry.Record;
+                        ++count;
+                    }
+                    else if (entry.Record == record)
+                    {
+                        /* only check whether the given record is already indexed */
+                        count = 1;
+                        return entry.Record;
+                    }
+                }
+                pos = entry.Next;
+            }
+        }
+        return result;
+    }
+
+    // check whether there is an entry of the given kind (without key)
+    OFBool contains(const DcmDirectoryRecord *parent,
+                    const E_DirRecType recordType,
+                    const E_EntryKind kind) const
+    {
+        size_t count = 0;
+        find(parent, recordType, kind, "", count);
+        return (count > 0);
+    }
+
+
+  private:
+
+    /// entry of the index
+    struct Entry
+    {
+        /// parent record of the indexed record
+        const DcmDirectoryRecord *Parent;
+        /// type of the indexed record
+        E_DirRecType RecordType;
+        /// kind of entry
+        E_EntryKind Kind;
+        /// key value (empty for EK_Indexed and EK_Unkeyed)
+        OFString Key;
+        /// indexed record (NULL for EK_Indexed and EK_Unkeyed)
+        DcmDirectoryRecord *Record;
+        /// next entry in the same slot of the hash table (index plus 1, 0 if none)
+        size_t Next;
+    };
+
+    // compute hash value of the given key (FNV-1a)
+    static size_t hash(const DcmDirectoryRecord *parent,
+                       const E_DirRecType recordType,
+                       const E_EntryKind kind,
+                       const OFString &key)
+    {
+        size_t value = OFstatic_cast(size_t, 2166136261UL);
+        const size_t length = key.length();
+        for (size_t i = 0; i < length; ++i)
+            value = (value ^ OFstatic_cast(unsigned char, key[i])) * 16777619UL;
+        value = (value ^ OFreinterpret_cast(size_t, parent)) * 16777619UL;
+        value = (value ^ OFstatic_cast(size_t, recordType)) * 16777619UL;
+        value = (value ^ OFstatic_cast(size_t, kind)) * 16777619UL;
+        /* also use the upper bits in the lower part of the value */
+        return value ^ (value >> 16);
+    }
+
+    // add entry with the given index to the hash table
+    void insert(const size_t index)
+    {
+        Entry &entry = Entries[index];
+        size_t &slot = Table[hash(entry.Parent, entry.RecordType, entry.Kind, entry.Key) & (Table.size() - 1)];
+        entry.Next = slot;
+        slot = index + 1;
+    }
+
+    // resize the hash table (number of slots has to be a power of 2)
+    void rehash(const size_t tableSize)
+    {
+        Table.clear();
+        Table.resize(tableSize, 0);
+        for (size_t i = 0; i < Entries.size(); ++i)
+            insert(i);
+    }
+
+    /// all entries of the index
+    OFVector<Entry> Entries;
+    /// hash table (index of the first entry of each slot plus 1, 0 if empty)
+    OFVector<size_t> Table;
+};
+
+
+#ifdef WITH_THREADS
+
+/* DICOM file to be loaded and checked by a worker thread of
+ * DicomDirInterface::addDicomFiles()
+ */
+struct DicomDirLoadJob
+{
+    // constructor
+    DicomDirLoadJob()
+      : Filename(),
+        FileFormat(NULL),
+        Result(EC_Normal),
+        Done(0)
+    {
+    }
+
+    /// name of the DICOM file
+    OFFilename Filename;
+    /// loaded DICOM file (NULL if not yet loaded or already added)
+    DcmFileFormat *FileFormat;
+    /// result of loading and checking the DICOM file
+    OFCondition Result;
+    /// posted when the DICOM file has been loaded and checked
+    OFSemaphore Done;
+};
+
+
+/* queue of DICOM files shared by the worker threads of
+ * DicomDirInterface::addDicomFiles().  The files are assigned to a fixed
+ * number of slots in the order of the list, so the number of files loaded in
+ * advance is limited by the number of slots.
+ */
+struct DicomDirLoadQueue
+{
+    // constructor
+    DicomDirLoadQueue(const OFList<OFFilename> &filenames,
+                      const OFFilename &directory,
+                      const size_t numberOfSlots)
+      : Directory(directory),
+        Next(filenames.begin()),
+        End(filenames.end()),
+        NextIndex(0),
+        Slots(new DicomDirLoadJob[numberOfSlots]),
+        NumberOfSlots(numberOfSlots),
+        FreeSlots(OFstatic_cast(unsigned int, numberOfSlots)),
+        Mutex(),
+        Stop(OFFalse)
+    {
+    }
+
+    // destructor
+    ~DicomDirLoadQueue()
+    {
+        for (size_t i = 0; i < NumberOfSlots; ++i)
+            delete Slots[i].FileFormat;
+        delete[] Slots;
+    }
+
+    /// directory where the DICOM files are stored
+    const OFFilename &Directory;
+    /// next file to be loaded (protected by 'Mutex')
+    OFListConstIterator(OFFilename) Next;
+    /// end of the list of files
+    OFListConstIterator(OFFilename) End;
+    /// index of the next file to be loaded (protected by 'Mutex')
+    size_t NextIndex;
+    /// slots for the files being loaded (index modulo number of slots)
+    DicomDirLoadJob *Slots;
+    /// number of slots
+    size_t NumberOfSlots;
+    /// number of slots that can be used for loading another file
+    OFSemaphore FreeSlots;
+    /// mutex protecting the access to the list of files
+    OFMutex Mutex;
+    /// stop loading files (protected by 'Mutex')
+    OFBool Stop;
+
+  private:
+
+    // --- declarations to avoid compiler warnings
+
+    DicomDirLoadQueue(const DicomDirLoadQueue &);
+    DicomDirLoadQueue &operator=(const DicomDirLoadQueue &);
+};
+
+
+/* worker thread of DicomDirInterface::addDicomFiles() that loads and checks
+ * the DICOM files from the queue
+ */
+class DicomDirLoadThread
+  : public OFThread
+{
+
+  public:
+
+    // constructor
+    DicomDirLoadThread(DicomDirInterface &dicomdir,
+                       DicomDirLoadQueue &queue)
+      : OFThread(),
+        DicomDir(dicomdir),
+        Queue(queue)
+    {
+    }
+
+  protected:
+
+    // load and check files until there are no more files or loading is stopped
+    virtual void run()
+    {
+        while (Queue.FreeSlots.wait() == 0)
+        {
+            Queue.Mutex.lock();
+            if (Queue.Stop || (Queue.Next == Queue.End))
+            {
+                Queue.Mutex.unlock();
+                break;
+            }
+            DicomDirLoadJob &job = Queue.Slots[Queue.NextIndex++ % Queue.NumberOfSlots];
+            job.Filename = *Queue.Next;
+            ++Queue.Next;
+            Queue.Mutex.unlock();
+            job.FileFormat = new DcmFileFormat();
+            job.Result = DicomDir.loadAndCheckDicomFile(job.Filename, Queue.Directory, *job.FileFormat, OFTrue /*checkFilename*/);
+            job.Done.post();
+        }
+    }
+
+  private:
+
+    /// DICOMDIR interface used for loading and checking the files
+    DicomDirInterface &DicomDir;
+    /// queue of files to be loaded
+    DicomDirLoadQueue &Queue;
+
+    // --- declarations to avoid compiler warnings
+
+    DicomDirLoadThread(const DicomDirLoadThread &);
+    DicomDirLoadThread &operator=(const DicomDirLoadThread &);
+};
+
+#endif
+
+
 /*------------------*
  *  implementation  *
  *------------------*/
@@ -1180,7 +1506,8 @@ DicomDirInterface::DicomDirInterface()
     AutoInstanceNumber(1),
     AutoOverlayNumber(1),
     AutoLutNumber(1),
-    AutoCurveNumber(1)
+    AutoCurveNumber(1),
+    RecordIndex(new DicomDirRecordIndex())
 {
     /* check whether (possibly required) RLE/JPEG/JP2K decoders are registered */
     RLESupport  = DcmCodecList::canChangeCoding(EXS_RLELossless, EXS_LittleEndianExplicit);
@@ -1196,6 +1523,7 @@ DicomDirInterface::~DicomDirInterface()
 {
     /* reset object to its initial state (free memory) */
     cleanup();
+    delete RecordIndex;
 }
 
 
@@ -1206,6 +1534,8 @@ void DicomDirInterface::cleanup()
     delete DicomDir;
     /* invalidate references */
     DicomDir = NULL;
+    /* the index refers to records of the deleted DICOMDIR */
+    RecordIndex->clear();
 }
 
 
@@ -2800,8 +3130,11 @@ OFCondition DicomDirInterface::loadAndCheckDicomFile(const OFFilename &filename,
     /* check filename (if not disabled) */
     if (!checkFilename || isFilenameValid(filename))
     {
-        /* load DICOM file */
-        result = fileformat.loadFile(pathname);
+        /* load DICOM file (the pixel data is only needed for creating icon images) */
+        if (isPixelDataRequired())
+            result = fileformat.loadFile(pathname);
+        else
+            result = fileformat.loadFileUntilTag(pathname, EXS_Unknown, EGL_noChange, DCM_MaxReadLength, ERM_autoDetect, DCM_PixelData);
         if (result.good())
         {
             /* check for correct part 10 file format */
@@ -2854,6 +3187,26 @@ OFCondition DicomDirInterface::loadAndCheckDicomFile(const OFFilename &filename,
 }
 
 
+// check whether the pixel data of the DICOM files is needed (for creating icon images)
+OFBool DicomDirInterface::isPixelDataRequired() const
+{
+    OFBool result = IconImageMode;
+    /* icon images are always created for some application profiles (see buildImageRecord()) */
+    switch (ApplicationProfile)
+    {
+        case AP_XrayAngiographic:
+        case AP_XrayAngiographicDVD:
+        case AP_BasicCardiac:
+        case AP_CTandMR:
+            result = OFTrue;
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+
 // check whether given record matches dataset
 OFBool DicomDirInterface::recordMatchesDataset(DcmDirectoryRecord *record,
                                                DcmItem *dataset)
@@ -2973,7 +3326,57 @@ DcmDirectoryRecord *DicomDirInterface::findExistingRecord(DcmDirectoryRecord *pa
     DcmDirectoryRecord *record = NULL;
     if (parent != NULL)
     {
-        /* iterate over all records */
+        OFBool useIndex = (dataset != NULL);
+        if (useIndex)
+        {
+            indexChildRecords(parent);
+            /* study records without StudyInstanceUID have to be checked one by one */
+            if (recordType == ERT_Study)
+                useIndex = !RecordIndex->contains(parent, recordType, DicomDirRecordIndex::EK_Unkeyed);
+        }
+        if (useIndex)
+        {
+            OFString key;
+            DicomDirRecordIndex::E_EntryKind kind = DicomDirRecordIndex::EK_Key;
+            /* determine the unique key in the same way as recordMatchesDataset() */
+            switch (recordType)
+            {
+                case ERT_Patient:
+                    if (dataset->tagExistsWithValue(DCM_PatientID))
+                        dataset->findAndGetOFStringArray(DCM_PatientID, key);
+                    else {
+                        dataset->findAndGetOFStringArray(DCM_PatientName, key);
+                        kind = DicomDirRecordIndex::EK_Name;
+                    }
+                    break;
+                case ERT_Study:
+                    dataset->findAndGetOFStringArray(DCM_StudyInstanceUID, key);
+                    break;
+                case ERT_Series:
+                    dataset->findAndGetOFStringArray(DCM_SeriesInstanceUID, key);
+                    break;
+                default:
+                    dataset->findAndGetOFStringArray(DCM_SOPInstanceUID, key);
+                    break;
+            }
+            size_t count = 0;
+            /* an empty value never matches */
+            if (!key.empty())
+                record = RecordIndex->find(parent, recordType, kind, key, count);
+            if (count == 0)
+                return NULL;
+            if (count == 1)
+            {
+                if (recordMatchesDataset(record, dataset))
+                    return record;
+                /* the index entry is outdated or the PatientID has been removed from the
+                 * dataset (see recordMatchesDataset()), so continue with the next record */
+            } else {
+                /* check all records in the order of the list */
+                record = NULL;
+            }
+        }
+        /* iterate over all (remaining) records */
         while (!found && ((record = parent->nextSub(record)) != NULL))
         {
             if (record->getRecordType() == recordType)
@@ -2984,6 +3387,59 @@ DcmDirectoryRecord *DicomDirInterface::findExistingRecord(DcmDirectoryRecord *pa
 }
 
 
+// add all child records to the record index (if not already done)
+void DicomDirInterface::indexChildRecords(DcmDirectoryRecord *parent)
+{
+    if ((parent != NULL) && !RecordIndex->contains(parent, ERT_root, DicomDirRecordIndex::EK_Indexed))
+    {
+        DcmDirectoryRecord *record = NULL;
+        /* iterate over all child records, e.g. of an existing DICOMDIR */
+        while ((record = parent->nextSub(record)) != NULL)
+            indexRecord(parent, record);
+        RecordIndex->add(parent, ERT_root, DicomDirRecordIndex::EK_Indexed, "", NULL);
+    }
+}
+
+
+// add given record to the record index
+void DicomDirInterface::indexRecord(DcmDirectoryRecord *parent,
+                                    DcmDirectoryRecord *record)
+{
+    if ((parent != NULL) && (record != NULL))
+    {
+        OFString key;
+        const E_DirRecType recordType = record->getRecordType();
+        /* use the same unique keys as recordMatchesDataset() */
+        switch (recordType)
+        {
+            case ERT_Patient:
+                /* both PatientID and PatientName might be used for matching */
+                if (record->findAndGetOFStringArray(DCM_PatientID, key).good() && !key.empty())
+                    RecordIndex->add(parent, recordType, DicomDirRecordIndex::EK_Key, key, record);
+                if (record->findAndGetOFStringArray(DCM_PatientName, key).good() && !key.empty())
+                    RecordIndex->add(parent, recordType, DicomDirRecordIndex::EK_Name, key, record);
+                break;
+            case ERT_Study:
+                if (record->findAndGetOFStringArray(DCM_StudyInstanceUID, key).good() && !key.empty())
+                    RecordIndex->add(parent, recordType, DicomDirRecordIndex::EK_Key, key, record);
+                else {
+                    /* the StudyInstanceUID can be in the referenced file instead */
+                    RecordIndex->add(parent, recordType, DicomDirRecordIndex::EK_Unkeyed, "", NULL);
+                }
+                break;
+            case ERT_Series:
+                if (record->findAndGetOFStringArray(DCM_SeriesInstanceUID, key).good() && !key.empty())
+                    RecordIndex->add(parent, recordType, DicomDirRecordIndex::EK_Key, key, record);
+                break;
+            default:
+                if (record->findAndGetOFStringArray(DCM_ReferencedSOPInstanceUIDInFile, key).good() && !key.empty())
+                    RecordIndex->add(parent, recordType, DicomDirRecordIndex::EK_Key, key, record);
+                break;
+        }
+    }
+}
+
+
 // create or update patient record and copy required values from dataset
 DcmDirectoryRecord *DicomDirInterface::buildPatientRecord(DcmDirectoryRecord *record,
                                                           DcmFileFormat *fileformat,
@@ -4736,6 +5192,8 @@ DcmDirectoryRecord *DicomDirInterface::addRecord(DcmDirectoryRecord *parent,
                         record = NULL;
                     }
                 }
+                /* add new record to the index (or update the entries of an existing one) */
+                indexRecord(parent, record);
             }
         } else {
             /* instance record is already referenced by the DICOMDIR */
@@ -4804,7 +5262,11 @@ void DicomDirInterface::inventMissingAttributes(DcmDirectoryRecord *parent,
             if (record->getRecordType() == ERT_Patient)
             {
                 if (!record->tagExistsWithValue(DCM_PatientID))
+                {
                     setDefaultValue(record, DCM_PatientID, AutoPatientNumber++, AUTO_PATIENTID_PREFIX);
+                    /* the record can now be found by its PatientID */
+                    indexRecord(parent, record);
+                }
                 if (recurse)
                     inventMissingStudyLevelAttributes(record);
             }
@@ -4918,95 +5380,190 @@ OFCondition DicomDirInterface::addDicomFile(const OFFilename &filename,
     /* first, make sure that a DICOMDIR object exists */
     if (DicomDir != NULL)
     {
-        /* create fully qualified pathname of the DICOM file to be added */
-        OFFilename pathname;
-        OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
         /* then check the file name, load the file and check the content */
         DcmFileFormat fileformat;
         result = loadAndCheckDicomFile(filename, directory, fileformat, OFTrue /*checkFilename*/);
+        /* finally, add the file to the DICOMDIR */
         if (result.good())
+            result = addCheckedDicomFile(filename, directory, fileformat);
+    }
+    return result;
+}
+
+
+// add DICOM files to the current DICOMDIR object (possibly loaded by multiple threads)
+OFCondition DicomDirInterface::addDicomFiles(const OFList<OFFilename> &filenames,
+                                             const OFFilename &directory,
+                                             OFList<OFFilename> &badFiles,
+                                             const unsigned int numberOfThreads)
+{
+    /* first, make sure that a DICOMDIR object exists */
+    if (DicomDir == NULL)
+        return EC_IllegalParameter;
+    OFCondition result = EC_Normal;
+    OFListConstIterator(OFFilename) iter = filenames.begin();
+    OFListConstIterator(OFFilename) last = filenames.end();
+#ifdef WITH_THREADS
+    if ((numberOfThreads > 1) && (filenames.size() > 1))
+    {
+        DCMDATA_DEBUG("using " << numberOfThreads << " threads for loading and checking DICOM files");
+        /* files are loaded in advance by the worker threads (at most two per thread) */
+        DicomDirLoadQueue queue(filenames, directory, 2 * OFstatic_cast(size_t, numberOfThreads));
+        OFVector<DicomDirLoadThread *> threads;
+        for (unsigned int i = 0; i < numberOfThreads; ++i)
         {
-            DCMDATA_INFO("adding file: " << pathname);
-            /* start creating the DICOMDIR directory structure */
-            DcmDirectoryRecord *rootRecord = &(DicomDir->getRootRecord());
-            DcmMetaInfo *metainfo = fileformat.getMetaInfo();
-            /* massage filename into DICOM format (DOS conventions for path separators, uppercase) */
-            OFString fileID;
-            hostToDicomFilename(OFSTRING_GUARD(filename.getCharPointer()), fileID);
-            /* what kind of object (SOP Class) is stored in the file */
-            OFString sopClass;
-            metainfo->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
-            /* if hanging protocol, palette or implant file then attach it to the root record and stop */
-            if (compare(sopClass, UID_HangingProtocolStorage))
-            {
-                /* add a hanging protocol record below the root */
-                if (addRecord(rootRecord, ERT_HangingProtocol, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_ColorPaletteStorage))
-            {
-                /* add a palette record below the root */
-                if (addRecord(rootRecord, ERT_Palette, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_GenericImplantTemplateStorage))
-            {
-                /* add an implant record below the root */
-                if (addRecord(rootRecord, ERT_Implant, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_ImplantAssemblyTemplateStorage))
+            threads.push_back(new DicomDirLoadThread(*this, queue));
+            threads.back()->start();
+        }
+        /* add the files in the order of the list */
+        size_t index = 0;
+        while ((iter != last) && result.good())
+        {
+            DicomDirLoadJob &job = queue.Slots[index++ % queue.NumberOfSlots];
+            job.Done.wait();
+            OFCondition status = job.Result;
+            if (status.good())
+                status = addCheckedDicomFile(job.Filename, directory, *job.FileFormat);
+            delete job.FileFormat;
+            job.FileFormat = NULL;
+            if (status.bad())
             {
-                /* add an implant group record below the root */
-                if (addRecord(rootRecord, ERT_ImplantGroup, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                badFiles.push_back(job.Filename);
+                /* ignore inconsistent file, just warn (already done above) */
+                if (AbortMode)
+                    result = status;
             }
-            else if (compare(sopClass, UID_ImplantTemplateGroupStorage))
+            /* the slot can be used for the next file */
+            queue.FreeSlots.post();
+            ++iter;
+        }
+        /* stop the worker threads (in case of an error) and wait for them */
+        queue.Mutex.lock();
+        queue.Stop = OFTrue;
+        queue.Mutex.unlock();
+        for (unsigned int j = 0; j < numberOfThreads; ++j)
+            queue.FreeSlots.post();
+        for (OFVector<DicomDirLoadThread *>::iterator it = threads.begin(); it != threads.end(); ++it)
+        {
+            (*it)->join();
+            delete *it;
+        }
+    } else
+#else
+    (void)numberOfThreads;
+#endif
+    {
+        /* iterate over all input filenames */
+        while ((iter != last) && result.good())
+        {
+            OFCondition status = addDicomFile(*iter, directory);
+            if (status.bad())
             {
-                /* add an implant assy record below the root */
-                if (addRecord(rootRecord, ERT_ImplantAssy, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                badFiles.push_back(*iter);
+                /* ignore inconsistent file, just warn (already done above) */
+                if (AbortMode)
+                    result = status;
             }
-            else if (compare(sopClass, UID_InventoryStorage))
+            ++iter;
+        }
+    }
+    return result;
+}
+
+
+// add DICOM file that has already been loaded and checked to the current DICOMDIR object
+OFCondition DicomDirInterface::addCheckedDicomFile(const OFFilename &filename,
+                                                   const OFFilename &directory,
+                                                   DcmFileFormat &fileformat)
+{
+    OFCondition result = EC_IllegalParameter;
+    /* first, make sure that a DICOMDIR object exists */
+    if (DicomDir != NULL)
+    {
+        /* create fully qualified pathname of the DICOM file to be added */
+        OFFilename pathname;
+        OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
+        result = EC_Normal;
+        DCMDATA_INFO("adding file: " << pathname);
+        /* start creating the DICOMDIR directory structure */
+        DcmDirectoryRecord *rootRecord = &(DicomDir->getRootRecord());
+        DcmMetaInfo *metainfo = fileformat.getMetaInfo();
+        /* massage filename into DICOM format (DOS conventions for path separators, uppercase) */
+        OFString fileID;
+        hostToDicomFilename(OFSTRING_GUARD(filename.getCharPointer()), fileID);
+        /* what kind of object (SOP Class) is stored in the file */
+        OFString sopClass;
+        metainfo->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
+        /* if hanging protocol, palette or implant file then attach it to the root record and stop */
+        if (compare(sopClass, UID_HangingProtocolStorage))
+        {
+            /* add a hanging protocol record below the root */
+            if (addRecord(rootRecord, ERT_HangingProtocol, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ColorPaletteStorage))
+        {
+            /* add a palette record below the root */
+            if (addRecord(rootRecord, ERT_Palette, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_GenericImplantTemplateStorage))
+        {
+            /* add an implant record below the root */
+            if (addRecord(rootRecord, ERT_Implant, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ImplantAssemblyTemplateStorage))
+        {
+            /* add an implant group record below the root */
+            if (addRecord(rootRecord, ERT_ImplantGroup, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ImplantTemplateGroupStorage))
+        {
+            /* add an implant assy record below the root */
+            if (addRecord(rootRecord, ERT_ImplantAssy, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_InventoryStorage))
+        {
+            /* add an inventory record below the root */
+            if (addRecord(rootRecord, ERT_Inventory, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        } else {
+            /* add a patient record below the root */
+            DcmDirectoryRecord *patientRecord = addRecord(rootRecord, ERT_Patient, &fileformat, fileID, pathname);
+            if (patientRecord != NULL)
             {
-                /* add an inventory record below the root */
-                if (addRecord(rootRecord, ERT_Inventory, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            } else {
-                /* add a patient record below the root */
-                DcmDirectoryRecord *patientRecord = addRecord(rootRecord, ERT_Patient, &fileformat, fileID, pathname);
-                if (patientRecord != NULL)
+                /* if patient management file then attach it to patient record and stop */
+                if (compare(sopClass, UID_RETIRED_DetachedPatientManagementMetaSOPClass))
                 {
-                    /* if patient management file then attach it to patient record and stop */
-                    if (compare(sopClass, UID_RETIRED_DetachedPatientManagementMetaSOPClass))
+                    result = patientRecord->assignToSOPFile(fileID.c_str(), pathname);
+                    DCMDATA_ERROR(result.text() << ": cannot assign patient record to file: " << pathname);
+                } else {
+                    /* add a study record below the current patient record */
+                    DcmDirectoryRecord *studyRecord = addRecord(patientRecord, ERT_Study, &fileformat, fileID, pathname);;
+                    if (studyRecord != NULL)
                     {
-                        result = patientRecord->assignToSOPFile(fileID.c_str(), pathname);
-                        DCMDATA_ERROR(result.text() << ": cannot assign patient record to file: " << pathname);
-                    } else {
-                        /* add a study record below the current patient record */
-                        DcmDirectoryRecord *studyRecord = addRecord(patientRecord, ERT_Study, &fileformat, fileID, pathname);;
-                        if (studyRecord != NULL)
+                        /* add a series record below the current study record */
+                        DcmDirectoryRecord *seriesRecord = addRecord(studyRecord, ERT_Series, &fileformat, fileID, pathname);;
+                        if (seriesRecord != NULL)
                         {
-                            /* add a series record below the current study record */
-                            DcmDirectoryRecord *seriesRecord = addRecord(studyRecord, ERT_Series, &fileformat, fileID, pathname);;
-                            if (seriesRecord != NULL)
-                            {
-                                /* add one of the instance record below the current series record */
-                                if (addRecord(seriesRecord, sopClassToRecordType(sopClass), &fileformat, fileID, pathname) == NULL)
-                                    result = EC_CorruptedData;
-                            } else
+                            /* add one of the instance record below the current series record */
+                            if (addRecord(seriesRecord, sopClassToRecordType(sopClass), &fileformat, fileID, pathname) == NULL)
                                 result = EC_CorruptedData;
                         } else
                             result = EC_CorruptedData;
-                    }
-                } else
-                    result = EC_CorruptedData;
-                /* invent missing attributes on all levels or PatientID only */
-                if (InventMode)
-                    inventMissingAttributes(rootRecord);
-                else if (InventPatientIDMode)
-                    inventMissingAttributes(rootRecord, OFFalse /*recurse*/);
-            }
+                    } else
+                        result = EC_CorruptedData;
+                }
+            } else
+                result = EC_CorruptedData;
+            /* invent missing attributes on all levels or PatientID only */
+            if (InventMode)
+                inventMissingAttributes(rootRecord);
+            else if (InventPatientIDMode)
+                inventMissingAttributes(rootRecord, OFFalse /*recurse*/);
         }
     }
     return result;
@@ -38,6 +38,8 @@
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/vrscan.h"
 #include "dcmtk/dcmdata/dcpath.h"
+#include "dcmtk/dcmdata/dclzcach.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
 
 #include <cstring>                      /* for memset() */
 
@@ -52,7 +54,8 @@ DcmElement::DcmElement(const DcmTag &tag,
   : DcmObject(tag, len),
     fByteOrder(gLocalByteOrder),
     fLoadValue(NULL),
-    fValue(NULL)
+    fValue(NULL),
+    fValueBudget(NULL)
 {
 }
 
@@ -61,7 +64,8 @@ DcmElement::DcmElement(const DcmElement &elem)
   : DcmObject(elem),
     fByteOrder(elem.fByteOrder),
     fLoadValue(NULL),
-    fValue(NULL)
+    fValue(NULL),
+    fValueBudget(NULL)
 {
     if (elem.fValue)
     {
@@ -133,6 +137,7 @@ DcmElement &DcmElement::operator=(const DcmElement &obj)
 {
   if (this != &obj)
   {
+    untrackValue();
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
     // if created with the nothrow version it must also be deleted with
     // the nothrow version else memory error.
@@ -256,6 +261,7 @@ OFCondition DcmElement::copyFrom(const DcmObject& rhs)
 
 DcmElement::~DcmElement()
 {
+    untrackValue();
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
     // if created with the nothrow version it must also be deleted with
     // the nothrow version else memory error.
@@ -273,6 +279,7 @@ DcmElement::~DcmElement()
 OFCondition DcmElement::clear()
 {
     errorFlag = EC_Normal;
+    untrackValue();
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
     // if created with the nothrow version it must also be deleted with
     // the nothrow version else memory error.
@@ -349,6 +356,7 @@ OFBool DcmElement::canWriteXfer(const E_TransferSyntax newXfer,
 OFCondition DcmElement::detachValueField(OFBool copy)
 {
     OFCondition l_error = EC_Normal;
+    untrackValue();
     if (getLengthField() != 0)
     {
         if (copy)
@@ -607,6 +615,9 @@ void *DcmElement::getValue(const E_ByteOrder newByteOrder)
             /* if the value has not yet been loaded, do so now */
             if (!fValue)
                 errorFlag = loadValue();
+            /* a value released earlier is used again */
+            else if (fValueBudget)
+                fValueBudget->claimValue(this);
             /* if everything is ok */
             if (errorFlag.good())
             {
@@ -699,6 +710,13 @@ OFCondition DcmElement::loadValue(DcmInputStream *inStream)
                         /* call a function which performs certain operations on the information which was read */
                         postLoadValue();
                         errorFlag = EC_Normal;
+                        /* account for values loaded on demand in the memory budget */
+                        if (isStreamNew)
+                        {
+                            DcmLazyLoadBudget *budget = findMemoryBudget();
+                            if (budget)
+                                budget->registerValue(this, getLengthField());
+                        }
                     }
                     /* else set the return value correspondingly */
                     else if (readStream->eos())
@@ -821,6 +839,7 @@ OFCondition DcmElement::changeValue(const void *value,
                                     const Uint32 num)
 {
     errorFlag = EC_Normal;
+    untrackValue();
     // check for invalid parameter values
     if (position % num != 0 || getLengthField() % num != 0 || position > getLengthField())
         errorFlag = EC_IllegalCall;
@@ -1038,6 +1057,7 @@ OFCondition DcmElement::putValue(const void * newValue,
                                  const Uint32 length)
 {
     errorFlag = EC_Normal;
+    untrackValue();
 
     if (fValue)
     {
@@ -1102,6 +1122,7 @@ OFCondition DcmElement::createUint16Array(const Uint32 /*numWords*/,
 OFCondition DcmElement::createEmptyValue(const Uint32 length)
 {
     errorFlag = EC_Normal;
+    untrackValue();
     if (fValue)
     {
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
@@ -1222,6 +1243,7 @@ OFCondition DcmElement::read(DcmInputStream &inStream,
                     }
                 }
                 /* if there is already a value for this element, delete this value */
+                untrackValue();
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
                 // if created with the nothrow version it must also be deleted with
                 // the nothrow version else memory error.
@@ -1960,6 +1982,7 @@ void DcmElement::compact()
 {
   if (fLoadValue && fValue)
   {
+    untrackValue();
     DCMDATA_DEBUG("DcmElement::compact() removed element value of " << getTag()
         << " with " << getTransferredBytes() << " bytes");
     delete[] fValue;
@@ -1969,12 +1992,39 @@ void DcmElement::compact()
 }
 
 
+void DcmElement::releaseValue()
+{
+  if (fValueBudget)
+    fValueBudget->releaseValue(this);
+}
+
+
+void DcmElement::untrackValue()
+{
+  if (fValueBudget)
+    fValueBudget->unregisterValue(this);
+}
+
+
+DcmLazyLoadBudget *DcmElement::findMemoryBudget()
+{
+  // the memory budget belongs to the file format containing this element
+  DcmObject *parent = getParent();
+  while ((parent != NULL) && (parent->ident() != EVR_fileFormat))
+    parent = parent->getParent();
+  if (parent != NULL)
+    return OFstatic_cast(DcmFileFormat *, parent)->MemoryBudget;
+  return NULL;
+}
+
+
 OFCondition DcmElement::createValueFromTempFile(DcmInputStreamFactory *factory,
                                                 const Uint32 length,
                                                 const E_ByteOrder byteOrder)
 {
     if (factory && !(length & 1))
     {
+        untrackValue();
 #if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
         // if created with the nothrow version it must also be deleted with
         // the nothrow version else memory error.
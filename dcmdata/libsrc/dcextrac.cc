@@ -0,0 +1,898 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Classes for extracting attribute values from many DICOM files
+ *           into columnar batches
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcextrac.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/dcmdata/dcmetinf.h"
+#include "dcmtk/dcmdata/dcsequen.h"
+#include "dcmtk/dcmdata/dcpath.h"
+#include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"
+#endif
+
+#include <cstring>
+
+
+/* ------------------------------------------------------------------------- */
+
+static const OFFilename emptyFilename;
+static const OFString emptyString;
+
+
+DcmExtractionBatch::DcmExtractionBatch()
+  : filenames(),
+    rowStatus(),
+    columns()
+{
+}
+
+
+DcmExtractionBatch::~DcmExtractionBatch()
+{
+}
+
+
+void DcmExtractionBatch::clear()
+{
+    filenames.clear();
+    rowStatus.clear();
+    columns.clear();
+}
+
+
+size_t DcmExtractionBatch::getNumberOfRows() const
+{
+    return filenames.size();
+}
+
+
+size_t DcmExtractionBatch::getNumberOfColumns() const
+{
+    return columns.size();
+}
+
+
+E_ColumnType DcmExtractionBatch::getColumnType(const size_t column) const
+{
+    if (column < columns.size())
+        return columns[column].type;
+    return ECL_auto;
+}
+
+
+const OFFilename &DcmExtractionBatch::getFilename(const size_t row) const
+{
+    if (row < filenames.size())
+        return filenames[row];
+    return emptyFilename;
+}
+
+
+OFBool DcmExtractionBatch::isNull(const size_t row,
+                                  const size_t column) const
+{
+    if ((column < columns.size()) && (row < filenames.size()))
+        return columns[column].nulls[row] != 0;
+    return OFTrue;
+}
+
+
+Sint64 DcmExtractionBatch::getInteger(const size_t row,
+                                      const size_t column) const
+{
+    if (!isNull(row, column) && (columns[column].type == ECL_integer))
+        return columns[column].integers[row];
+    return 0;
+}
+
+
+Float64 DcmExtractionBatch::getFloat(const size_t row,
+                                     const size_t column) const
+{
+    if (!isNull(row, column) && (columns[column].type == ECL_float))
+        return columns[column].floats[row];
+    return 0;
+}
+
+
+const OFString &DcmExtractionBatch::getString(const size_t row,
+                                              const size_t column) const
+{
+    if (!isNull(row, column) && (columns[column].type == ECL_string))
+        return columns[column].strings[row];
+    return emptyString;
+}
+
+
+void DcmExtractionBatch::resize(const DcmAttributeExtractor &extractor,
+                                const size_t numberOfRows)
+{
+    const size_t numberOfColumns = extractor.getNumberOfColumns();
+    if (columns.size() != numberOfColumns)
+        columns.resize(numberOfColumns);
+    for (size_t i = 0; i < numberOfColumns; ++i)
+    {
+        Column &column = columns[i];
+        column.type = extractor.getColumnType(i);
+        /* only the array for the type of the column is used */
+        column.integers.resize((column.type == ECL_integer) ? numberOfRows : 0, 0);
+        column.floats.resize((column.type == ECL_float) ? numberOfRows : 0, 0);
+        column.strings.resize((column.type == ECL_string) ? numberOfRows : 0);
+        column.nulls.resize(numberOfRows, 1);
+    }
+    filenames.resize(numberOfRows);
+    rowStatus.resize(numberOfRows, 0);
+}
+
+
+void DcmExtractionBatch::compact()
+{
+    const size_t numberOfRows = filenames.size();
+    size_t target = 0;
+    for (size_t row = 0; row < numberOfRows; ++row)
+    {
+        if (rowStatus[row] == 0)
+            continue;
+        if (target != row)
+        {
+            filenames[target] = filenames[row];
+            rowStatus[target] = rowStatus[row];
+            for (size_t i = 0; i < columns.size(); ++i)
+            {
+                Column &column = columns[i];
+                column.nulls[target] = column.nulls[row];
+                if (column.type == ECL_integer)
+                    column.integers[target] = column.integers[row];
+                else if (column.type == ECL_float)
+                    column.floats[target] = column.floats[row];
+                else
+                    column.strings[target].swap(column.strings[row]);
+            }
+        }
+        ++target;
+    }
+    if (target != numberOfRows)
+    {
+        filenames.resize(target);
+        rowStatus.resize(target);
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            Column &column = columns[i];
+            column.nulls.resize(target);
+            if (column.type == ECL_integer)
+                column.integers.resize(target);
+            else if (column.type == ECL_float)
+                column.floats.resize(target);
+            else
+                column.strings.resize(target);
+        }
+    }
+}
+
+
+/* ------------------------------------------------------------------------- */
+
+DcmExtractionWriter::~DcmExtractionWriter()
+{
+}
+
+
+/* ------------------------------------------------------------------------- */
+
+DcmExtractionCSVWriter::DcmExtractionCSVWriter(STD_NAMESPACE ostream &stream)
+  : DcmExtractionWriter(),
+    output(stream)
+{
+}
+
+
+DcmExtractionCSVWriter::~DcmExtractionCSVWriter()
+{
+}
+
+
+OFCondition DcmExtractionCSVWriter::begin(const DcmAttributeExtractor &extractor)
+{
+    output << "Filename";
+    for (size_t i = 0; i < extractor.getNumberOfColumns(); ++i)
+    {
+        output << ',';
+        writeField(extractor.getColumnName(i).c_str());
+    }
+    output << "\r\n";
+    return output.good() ? EC_Normal : EC_StreamNotifyClient;
+}
+
+
+OFCondition DcmExtractionCSVWriter::writeBatch(const DcmExtractionBatch &batch)
+{
+    char buf[64];
+    const size_t numberOfColumns = batch.getNumberOfColumns();
+    for (size_t row = 0; row < batch.getNumberOfRows(); ++row)
+    {
+        const char *filename = batch.getFilename(row).getCharPointer();
+        writeField((filename != NULL) ? filename : "");
+        for (size_t i = 0; i < numberOfColumns; ++i)
+        {
+            output << ',';
+            if (batch.isNull(row, i))
+                continue;
+            switch (batch.getColumnType(i))
+            {
+                case ECL_integer:
+                    output << batch.getInteger(row, i);
+                    break;
+                case ECL_float:
+                    OFStandard::ftoa(buf, sizeof(buf), batch.getFloat(row, i), 0, 0, 17 /* DBL_DECIMAL_DIG */);
+                    output << buf;
+                    break;
+                default:
+                    writeField(batch.getString(row, i).c_str());
+                    break;
+            }
+        }
+        output << "\r\n";
+    }
+    return output.good() ? EC_Normal : EC_StreamNotifyClient;
+}
+
+
+OFCondition DcmExtractionCSVWriter::end()
+{
+    output.flush();
+    return output.good() ? EC_Normal : EC_StreamNotifyClient;
+}
+
+
+void DcmExtractionCSVWriter::writeField(const char *value)
+{
+    /* fields with special characters are enclosed in double quotes */
+    if (strpbrk(value, ",\"\r\n") == NULL)
+        output << value;
+    else
+    {
+        output << '"';
+        while (*value != '\0')
+        {
+            /* double quotes are escaped by another double quote */
+            if (*value == '"')
+                output << '"';
+            output << *value++;
+        }
+        output << '"';
+    }
+}
+
+
+/* ------------------------------------------------------------------------- */
+
+DcmExtractionBinaryWriter::DcmExtractionBinaryWriter(STD_NAMESPACE ostream &stream)
+  : DcmExtractionWriter(),
+    output(stream)
+{
+}
+
+
+DcmExtractionBinaryWriter::~DcmExtractionBinaryWriter()
+{
+}
+
+
+OFCondition DcmExtractionBinaryWriter::begin(const DcmAttributeExtractor &extractor)
+{
+    output.write("DCMCOL1\0", 8);
+    const size_t numberOfColumns = extractor.getNumberOfColumns();
+    writeUint32(OFstatic_cast(Uint32, numberOfColumns));
+    for (size_t i = 0; i < numberOfColumns; ++i)
+    {
+        const OFString &name = extractor.getColumnName(i);
+        output.put(OFstatic_cast(char, extractor.getColumnType(i)));
+        writeUint32(OFstatic_cast(Uint32, name.length()));
+        output.write(name.data(), name.length());
+    }
+    return output.good() ? EC_Normal : EC_StreamNotifyClient;
+}
+
+
+OFCondition DcmExtractionBinaryWriter::writeBatch(const DcmExtractionBatch &batch)
+{
+    const size_t numberOfRows = batch.getNumberOfRows();
+    /* a batch without rows would be interpreted as the end marker */
+    if (numberOfRows == 0)
+        return EC_Normal;
+    writeUint32(OFstatic_cast(Uint32, numberOfRows));
+    OFVector<OFString> strings(numberOfRows);
+    for (size_t row = 0; row < numberOfRows; ++row)
+    {
+        const char *filename = batch.getFilename(row).getCharPointer();
+        if (filename != NULL)
+            strings[row] = filename;
+    }
+    writeStrings(strings);
+    OFVector<char> nulls;
+    for (size_t i = 0; i < batch.getNumberOfColumns(); ++i)
+    {
+        /* null bitmap */
+        nulls.clear();
+        nulls.resize((numberOfRows + 7) / 8, 0);
+        for (size_t row = 0; row < numberOfRows; ++row)
+        {
+            if (batch.isNull(row, i))
+                nulls[row / 8] = OFstatic_cast(char, nulls[row / 8] | (1 << (row % 8)));
+        }
+        output.write(&nulls[0], nulls.size());
+        /* values */
+        switch (batch.getColumnType(i))
+        {
+            case ECL_integer:
+                for (size_t row = 0; row < numberOfRows; ++row)
+                    writeUint64(OFstatic_cast(Uint64, batch.getInteger(row, i)));
+                break;
+            case ECL_float:
+                for (size_t row = 0; row < numberOfRows; ++row)
+                {
+                    const Float64 value = batch.getFloat(row, i);
+                    Uint64 bits;
+                    memcpy(&bits, &value, sizeof(bits));
+                    writeUint64(bits);
+                }
+                break;
+            default:
+                for (size_t row = 0; row < numberOfRows; ++row)
+                    strings[row] = batch.getString(row, i);
+                writeStrings(strings);
+                break;
+        }
+    }
+    return output.good() ? EC_Normal : EC_StreamNotifyClient;
+}
+
+
+OFCondition DcmExtractionBinaryWriter::end()
+{
+    writeUint32(0);
+    output.flush();
+    return output.good() ? EC_Normal : EC_StreamNotifyClient;
+}
+
+
+void DcmExtractionBinaryWriter::writeUint32(const Uint32 value)
+{
+    char buf[4];
+    for (int i = 0; i < 4; ++i)
+        buf[i] = OFstatic_cast(char, (value >> (8 * i)) & 0xff);
+    output.write(buf, 4);
+}
+
+
+void DcmExtractionBinaryWriter::writeUint64(const Uint64 value)
+{
+    char buf[8];
+    for (int i = 0; i < 8; ++i)
+        buf[i] = OFstatic_cast(char, (value >> (8 * i)) & 0xff);
+    output.write(buf, 8);
+}
+
+
+void DcmExtractionBinaryWriter::writeStrings(const OFVector<OFString> &values)
+{
+    Uint32 offset = 0;
+    writeUint32(offset);
+    OFVector<OFString>::const_iterator iter = values.begin();
+    while (iter != values.end())
+    {
+        offset += OFstatic_cast(Uint32, iter->length());
+        writeUint32(offset);
+        ++iter;
+    }
+    for (iter = values.begin(); iter != values.end(); ++iter)
+        output.write(iter->data(), iter->length());
+}
+
+
+/* ------------------------------------------------------------------------- */
+
+#ifdef WITH_THREADS
+
+/* rows of a batch shared by the worker threads of
+ * DcmAttributeExtractor::extract()
+ */
+struct DcmExtractionQueue
+{
+    // constructor
+    DcmExtractionQueue(const DcmAttributeExtractor &extractor,
+                       DcmExtractionBatch &batch)
+      : Extractor(extractor),
+        Batch(batch),
+        NextRow(0),
+        Mutex()
+    {
+    }
+
+    /// extractor that determines the columns
+    const DcmAttributeExtractor &Extractor;
+    /// batch to be filled (each row is only accessed by one thread)
+    DcmExtractionBatch &Batch;
+    /// index of the next row to be extracted (protected by 'Mutex')
+    size_t NextRow;
+    /// mutex protecting the access to the next row
+    OFMutex Mutex;
+
+  private:
+
+    // --- declarations to avoid compiler warnings
+
+    DcmExtractionQueue(const DcmExtractionQueue &);
+    DcmExtractionQueue &operator=(const DcmExtractionQueue &);
+};
+
+
+/* worker thread of DcmAttributeExtractor::extract() that loads the DICOM
+ * files of a batch and extracts the attribute values
+ */
+class DcmExtractionThread
+  : public OFThread
+{
+
+  public:
+
+    // constructor
+    DcmExtractionThread(DcmExtractionQueue &queue)
+      : OFThread(),
+        Queue(queue)
+    {
+    }
+
+  protected:
+
+    // extract rows until all rows of the batch have been processed
+    virtual void run()
+    {
+        const size_t numberOfRows = Queue.Batch.getNumberOfRows();
+        while (OFTrue)
+        {
+            Queue.Mutex.lock();
+            const size_t row = Queue.NextRow++;
+            Queue.Mutex.unlock();
+            if (row >= numberOfRows)
+                break;
+            Queue.Extractor.extractRow(Queue.Batch, row);
+        }
+    }
+
+  private:
+
+    /// queue with the rows to be extracted
+    DcmExtractionQueue &Queue;
+
+    // --- declarations to avoid compiler warnings
+
+    DcmExtractionThread(const DcmExtractionThread &);
+    DcmExtractionThread &operator=(const DcmExtractionThread &);
+};
+
+#endif
+
+
+/* ------------------------------------------------------------------------- */
+
+DcmAttributeExtractor::DcmAttributeExtractor()
+  : columns(),
+    projection(),
+    numThreads(1),
+    maxBatchSize(1000),
+    useProjection(OFTrue),
+    fileReadMode(ERM_autoDetect)
+{
+}
+
+
+DcmAttributeExtractor::~DcmAttributeExtractor()
+{
+}
+
+
+OFCondition DcmAttributeExtractor::addColumn(const OFString &path,
+                                             const OFString &name,
+                                             const E_ColumnType type)
+{
+    if (path.empty())
+        return EC_IllegalParameter;
+    ColumnInfo column;
+    OFString restPath(path);
+    DcmTag tag;
+    OFCondition status;
+    while (!restPath.empty())
+    {
+        Step step;
+        step.itemNo = 0;
+        step.wildcard = OFFalse;
+        status = DcmPath::parseTagFromPath(restPath, tag);
+        if (status.bad())
+            return status;
+        step.tag = tag;
+        if (!restPath.empty())
+        {
+            status = DcmPath::parseItemNoFromPath(restPath, step.itemNo, step.wildcard);
+            if (status.bad())
+                return status;
+            /* the path has to end with an attribute, not with an item */
+            if (restPath.empty())
+                return EC_IllegalParameter;
+        }
+        column.steps.push_back(step);
+    }
+    column.name = name.empty() ? path : name;
+    column.type = type;
+    if (column.type == ECL_auto)
+    {
+        /* the value representation of the last attribute determines the type */
+        switch (tag.getEVR())
+        {
+            case EVR_US:
+            case EVR_SS:
+            case EVR_UL:
+            case EVR_SL:
+            case EVR_UV:
+            case EVR_SV:
+            case EVR_IS:
+                column.type = ECL_integer;
+                break;
+            case EVR_FL:
+            case EVR_FD:
+            case EVR_DS:
+                column.type = ECL_float;
+                break;
+            default:
+                column.type = ECL_string;
+                break;
+        }
+    }
+    /* the file meta information is always read completely */
+    if ((column.steps.size() > 1) || (column.steps[0].tag.getGroup() != 0x0002))
+    {
+        status = projection.addPath(path);
+        if (status.bad())
+            return status;
+    }
+    columns.push_back(column);
+    return EC_Normal;
+}
+
+
+void DcmAttributeExtractor::clear()
+{
+    columns.clear();
+    projection.clear();
+}
+
+
+size_t DcmAttributeExtractor::getNumberOfColumns() const
+{
+    return columns.size();
+}
+
+
+const OFString &DcmAttributeExtractor::getColumnName(const size_t column) const
+{
+    if (column < columns.size())
+        return columns[column].name;
+    return emptyString;
+}
+
+
+E_ColumnType DcmAttributeExtractor::getColumnType(const size_t column) const
+{
+    if (column < columns.size())
+        return columns[column].type;
+    return ECL_auto;
+}
+
+
+void DcmAttributeExtractor::setNumberOfThreads(const unsigned int numberOfThreads)
+{
+    numThreads = numberOfThreads;
+}
+
+
+void DcmAttributeExtractor::setBatchSize(const size_t batchSize)
+{
+    maxBatchSize = (batchSize > 0) ? batchSize : 1;
+}
+
+
+void DcmAttributeExtractor::setProjectionMode(const OFBool enabled)
+{
+    useProjection = enabled;
+}
+
+
+void DcmAttributeExtractor::setReadMode(const E_FileReadMode readMode)
+{
+    fileReadMode = readMode;
+}
+
+
+OFCondition DcmAttributeExtractor::extractFile(const OFFilename &filename,
+                                               DcmExtractionBatch &batch) const
+{
+    /* make sure that the batch has the columns of this extractor */
+    OFBool sameColumns = (batch.getNumberOfColumns() == columns.size());
+    for (size_t i = 0; sameColumns && (i < columns.size()); ++i)
+        sameColumns = (batch.getColumnType(i) == columns[i].type);
+    if (!sameColumns)
+        batch.clear();
+    const size_t row = batch.getNumberOfRows();
+    batch.resize(*this, row + 1);
+    batch.filenames[row] = filename;
+    OFCondition status = extractRow(batch, row);
+    /* remove the row again if the file could not be loaded */
+    if (status.bad())
+        batch.resize(*this, row);
+    return status;
+}
+
+
+OFCondition DcmAttributeExtractor::extract(const OFList<OFFilename> &filenames,
+                                           DcmExtractionWriter &writer,
+                                           OFList<OFFilename> &badFiles) const
+{
+    if (columns.empty())
+        return EC_IllegalCall;
+    OFCondition result = writer.begin(*this);
+    DcmExtractionBatch batch;
+    OFListConstIterator(OFFilename) iter = filenames.begin();
+    OFListConstIterator(OFFilename) last = filenames.end();
+    while ((iter != last) && result.good())
+    {
+        /* set up the next batch */
+        batch.resize(*this, 0);
+        size_t numberOfRows = 0;
+        while ((iter != last) && (numberOfRows < maxBatchSize))
+        {
+            batch.filenames.push_back(*iter++);
+            ++numberOfRows;
+        }
+        batch.resize(*this, numberOfRows);
+#ifdef WITH_THREADS
+        if ((numThreads > 1) && (numberOfRows > 1))
+        {
+            const size_t numberOfThreads = (numThreads < numberOfRows) ? numThreads : numberOfRows;
+            DCMDATA_DEBUG("using " << numberOfThreads << " threads for extracting " << numberOfRows << " DICOM files");
+            DcmExtractionQueue queue(*this, batch);
+            OFVector<DcmExtractionThread *> threads;
+            for (size_t i = 0; i < numberOfThreads; ++i)
+            {
+                threads.push_back(new DcmExtractionThread(queue));
+                threads.back()->start();
+            }
+            for (OFVector<DcmExtractionThread *>::iterator it = threads.begin(); it != threads.end(); ++it)
+            {
+                (*it)->join();
+                delete *it;
+            }
+        } else
+#endif
+        {
+            for (size_t row = 0; row < numberOfRows; ++row)
+                extractRow(batch, row);
+        }
+        /* report the files that could not be loaded and remove them from the batch */
+        for (size_t row = 0; row < numberOfRows; ++row)
+        {
+            if (batch.rowStatus[row] == 0)
+                badFiles.push_back(batch.filenames[row]);
+        }
+        batch.compact();
+        result = writer.writeBatch(batch);
+    }
+    if (result.good())
+        result = writer.end();
+    return result;
+}
+
+
+OFCondition DcmAttributeExtractor::extractRow(DcmExtractionBatch &batch,
+                                              const size_t row) const
+{
+    if (row >= batch.getNumberOfRows())
+        return EC_IllegalParameter;
+    const OFFilename &filename = batch.filenames[row];
+    DcmFileFormat fileformat;
+    OFCondition status;
+    if (useProjection)
+        status = fileformat.loadFileProjection(filename, projection, EXS_Unknown, EGL_noChange, DCM_MaxReadLength, fileReadMode);
+    else
+        status = fileformat.loadFile(filename, EXS_Unknown, EGL_noChange, DCM_MaxReadLength, fileReadMode);
+    if (status.bad())
+    {
+        DCMDATA_WARN("DcmAttributeExtractor: cannot load DICOM file " << filename << ": " << status.text());
+        batch.rowStatus[row] = 0;
+        return status;
+    }
+    DcmItem *dataset = fileformat.getDataset();
+    DcmItem *metainfo = fileformat.getMetaInfo();
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        const ColumnInfo &column = columns[i];
+        DcmItem *item = dataset;
+        if ((column.steps.size() == 1) && (column.steps[0].tag.getGroup() == 0x0002))
+            item = metainfo;
+        storeValue((item != NULL) ? findElement(item, column.steps, 0) : NULL, batch, row, i);
+    }
+    batch.rowStatus[row] = 1;
+    return EC_Normal;
+}
+
+
+DcmElement *DcmAttributeExtractor::findElement(DcmItem *item,
+                                               const OFVector<Step> &steps,
+                                               const size_t pos)
+{
+    const Step &step = steps[pos];
+    DcmElement *element = NULL;
+    if (pos + 1 == steps.size())
+    {
+        if (item->findAndGetElement(step.tag, element, OFFalse /*searchIntoSub*/).bad())
+            element = NULL;
+        return element;
+    }
+    DcmSequenceOfItems *sequence = NULL;
+    if (item->findAndGetSequence(step.tag, sequence).bad() || (sequence == NULL))
+        return NULL;
+    if (step.wildcard)
+    {
+        /* use the first item that contains the attribute */
+        const unsigned long count = sequence->card();
+        for (unsigned long i = 0; (i < count) && (element == NULL); ++i)
+            element = findElement(sequence->getItem(i), steps, pos + 1);
+    }
+    else if (step.itemNo < sequence->card())
+        element = findElement(sequence->getItem(step.itemNo), steps, pos + 1);
+    return element;
+}
+
+
+void DcmAttributeExtractor::storeValue(DcmElement *element,
+                                       DcmExtractionBatch &batch,
+                                       const size_t row,
+                                       const size_t column)
+{
+    DcmExtractionBatch::Column &target = batch.columns[column];
+    target.nulls[row] = 1;
+    if ((element == NULL) || element->isEmpty())
+        return;
+    OFCondition status;
+    switch (target.type)
+    {
+        case ECL_integer:
+        case ECL_float:
+        {
+            /* use the binary value if possible, convert the string value otherwise */
+            Sint64 intValue = 0;
+            Float64 floatValue = 0;
+            OFBool isFloat = OFFalse;
+            switch (element->ident())
+            {
+                case EVR_US:
+                {
+                    Uint16 value = 0;
+                    status = element->getUint16(value);
+                    intValue = value;
+                    break;
+                }
+                case EVR_SS:
+                {
+                    Sint16 value = 0;
+                    status = element->getSint16(value);
+                    intValue = value;
+                    break;
+                }
+                case EVR_UL:
+                {
+                    Uint32 value = 0;
+                    status = element->getUint32(value);
+                    intValue = value;
+                    break;
+                }
+                case EVR_SL:
+                {
+                    Sint32 value = 0;
+                    status = element->getSint32(value);
+                    intValue = value;
+                    break;
+                }
+                case EVR_UV:
+                {
+                    Uint64 value = 0;
+                    status = element->getUint64(value);
+                    intValue = OFstatic_cast(Sint64, value);
+                    break;
+                }
+                case EVR_SV:
+                    status = element->getSint64(intValue);
+                    break;
+                case EVR_FL:
+                {
+                    Float32 value = 0;
+                    status = element->getFloat32(value);
+                    floatValue = value;
+                    isFloat = OFTrue;
+                    break;
+                }
+                case EVR_IS:
+                {
+                    Sint32 value = 0;
+                    status = element->getSint32(value);
+                    intValue = value;
+                    break;
+                }
+                case EVR_FD:
+                case EVR_DS:
+                    status = element->getFloat64(floatValue);
+                    isFloat = OFTrue;
+                    break;
+                default:
+                {
+                    OFString value;
+                    status = element->getOFString(value, 0);
+                    if (status.good())
+                    {
+                        OFBool success = OFFalse;
+                        floatValue = OFStandard::atof(value.c_str(), &success);
+                        isFloat = OFTrue;
+                        if (!success)
+                            status = EC_InvalidValue;
+                    }
+                    break;
+                }
+            }
+            /* floating point values that do not fit into an integer are treated as null */
+            if (status.good() && isFloat && (target.type == ECL_integer) &&
+                !((floatValue > -9223372036854775808.0) && (floatValue < 9223372036854775808.0)))
+            {
+                status = EC_InvalidValue;
+            }
+            if (status.good())
+            {
+                if (target.type == ECL_integer)
+                    target.integers[row] = isFloat ? OFstatic_cast(Sint64, floatValue) : intValue;
+                else
+                    target.floats[row] = isFloat ? floatValue : OFstatic_cast(Float64, intValue);
+                target.nulls[row] = 0;
+            }
+            break;
+        }
+        default:
+            status = element->getOFStringArray(target.strings[row]);
+            if (status.good())
+                target.nulls[row] = 0;
+            break;
+    }
+}
@@ -45,6 +45,7 @@
 #include "dcmtk/dcmdata/dcostrms.h"    /* for class DcmStdoutStream */
 #include "dcmtk/dcmdata/dcwcache.h"    /* for class DcmWriteCache */
 #include "dcmtk/dcmdata/dcjson.h"
+#include "dcmtk/dcmdata/dclzcach.h"   /* for class DcmLazyLoadBudget */
 
 
 // ********************************
@@ -52,7 +53,8 @@
 
 DcmFileFormat::DcmFileFormat()
   : DcmSequenceOfItems(DCM_InternalUseTag),
-    FileReadMode(ERM_autoDetect)
+    FileReadMode(ERM_autoDetect),
+    MemoryBudget(NULL)
 {
     DcmMetaInfo *MetaInfo = new DcmMetaInfo();
     DcmSequenceOfItems::itemList->insert(MetaInfo);
@@ -67,7 +69,8 @@ DcmFileFormat::DcmFileFormat()
 DcmFileFormat::DcmFileFormat(DcmDataset *dataset,
                              OFBool deepCopy)
   : DcmSequenceOfItems(DCM_InternalUseTag),
-    FileReadMode(ERM_autoDetect)
+    FileReadMode(ERM_autoDetect),
+    MemoryBudget(NULL)
 {
     DcmMetaInfo *MetaInfo = new DcmMetaInfo();
     DcmSequenceOfItems::itemList->insert(MetaInfo);
@@ -93,8 +96,11 @@ DcmFileFormat::DcmFileFormat(DcmDataset *dataset,
 
 DcmFileFormat::DcmFileFormat(const DcmFileFormat &old)
   : DcmSequenceOfItems(old),
-    FileReadMode(old.FileReadMode)
+    FileReadMode(old.FileReadMode),
+    MemoryBudget(NULL)
 {
+    if (old.MemoryBudget)
+        MemoryBudget = new DcmLazyLoadBudget(old.MemoryBudget->getLimit());
 }
 
 
@@ -111,6 +117,8 @@ OFCondition DcmFileFormat::copyFrom(const DcmObject& rhs)
 
 DcmFileFormat::~DcmFileFormat()
 {
+    // detach all elements before they are deleted by the base class
+    delete MemoryBudget;
 }
 
 
@@ -120,12 +128,40 @@ DcmFileFormat &DcmFileFormat::operator=(const DcmFileFormat &obj)
   {
     DcmSequenceOfItems::operator=(obj);
     FileReadMode = obj.FileReadMode;
+    setMemoryBudget(obj.getMemoryBudget());
   }
 
   return *this;
 }
 
 
+void DcmFileFormat::setMemoryBudget(const size_t bytes)
+{
+  if (bytes == 0)
+  {
+    // stop accounting for all values
+    delete MemoryBudget;
+    MemoryBudget = NULL;
+  }
+  else if (MemoryBudget)
+    MemoryBudget->setLimit(bytes);
+  else
+    MemoryBudget = new DcmLazyLoadBudget(bytes);
+}
+
+
+size_t DcmFileFormat::getMemoryBudget() const
+{
+  return MemoryBudget ? MemoryBudget->getLimit() : 0;
+}
+
+
+size_t DcmFileFormat::getLoadedBytes() const
+{
+  return MemoryBudget ? MemoryBudget->getLoadedBytes() : 0;
+}
+
+
 // ********************************
 
 
@@ -966,6 +1002,24 @@ OFCondition DcmFileFormat::loadFileUntilTag(
 }
 
 
+OFCondition DcmFileFormat::loadFileProjection(const OFFilename &fileName,
+                                              const DcmAttributeProjection &projection,
+                                              const E_TransferSyntax readXfer,
+                                              const E_GrpLenEncoding groupLength,
+                                              const Uint32 maxReadLength,
+                                              const E_FileReadMode readMode)
+{
+    DcmDataset *dataset = getDataset();
+    if (dataset == NULL)
+        return EC_IllegalCall;
+    /* the projection only applies to the dataset, not to the meta header */
+    dataset->setReadProjection(&projection);
+    OFCondition l_error = loadFileUntilTag(fileName, readXfer, groupLength, maxReadLength, readMode, DCM_UndefinedTagKey);
+    dataset->setReadProjection(NULL);
+    return l_error;
+}
+
+
 OFCondition DcmFileFormat::saveFile(const OFFilename &fileName,
                                     const E_TransferSyntax writeXfer,
                                     const E_EncodingType encodingType,
@@ -984,8 +1038,11 @@ OFCondition DcmFileFormat::saveFile(const OFFilename &fileName,
     /* check parameters first */
     if (!fileName.isEmpty())
     {
-        DcmWriteCache wcache;
+        /* use a larger buffer for values read from file if requested */
+        const Uint32 bufferSize = dcmFileWriteBufferSize.get();
+        DcmWriteCache wcache((bufferSize > DcmWriteCacheBufsize) ? bufferSize : DcmWriteCacheBufsize);
         DcmOutputStream *fileStream;
+        DcmOutputFileStream *outputFileStream = NULL;
 
         if (fileName.isStandardStream())
         {
@@ -993,12 +1050,25 @@ OFCondition DcmFileFormat::saveFile(const OFFilename &fileName,
             fileStream = new DcmStdoutStream(fileName);
         } else {
             /* open file for output */
-            fileStream = new DcmOutputFileStream(fileName);
+            outputFileStream = new DcmOutputFileStream(fileName);
+            fileStream = outputFileStream;
         }
 
         /* check stream status */
         l_error = fileStream->status();
         if (l_error.good())
+        {
+            /* reserve disk space for the file (only in durable mode) */
+            if (dcmDurableFileWrite.get() && (outputFileStream != NULL) && (DcmXfer(writeXfer).getStreamCompression() == ESC_none))
+            {
+                /* the length is only an estimate since the meta header is updated when writing */
+                const Uint32 metaLength = getMetaInfo()->calcElementLength(writeXfer, encodingType);
+                const Uint32 dataLength = getDataset()->calcElementLength(writeXfer, encodingType);
+                if ((metaLength != DCM_UndefinedLength) && (dataLength != DCM_UndefinedLength))
+                    l_error = outputFileStream->preallocate(OFstatic_cast(offile_off_t, metaLength) + dataLength);
+            }
+        }
+        if (l_error.good())
         {
             /* write data to file */
             transferInit();
@@ -1006,6 +1076,13 @@ OFCondition DcmFileFormat::saveFile(const OFFilename &fileName,
                 padEncoding, padLength, subPadLength, 0 /*instanceLength*/, writeMode);
             transferEnd();
         }
+        if (outputFileStream != NULL)
+        {
+            /* close file and check whether all data has been written (discard it in case of error) */
+            const OFCondition closeStatus = outputFileStream->close(l_error.bad());
+            if (l_error.good())
+                l_error = closeStatus;
+        }
         delete fileStream;
     }
     return l_error;
@@ -324,3 +324,31 @@ void DcmInputBufferStream::setEos()
 {
   producer_.setEos();
 }
+
+/* ======================================================================= */
+
+DcmInputBufferStreamFactory::DcmInputBufferStreamFactory(const void *buf, offile_off_t buflen)
+: DcmInputStreamFactory()
+, buffer_(buf)
+, buflen_(buflen)
+{
+}
+
+DcmInputBufferStreamFactory::DcmInputBufferStreamFactory(const DcmInputBufferStreamFactory& arg)
+: DcmInputStreamFactory(arg)
+, buffer_(arg.buffer_)
+, buflen_(arg.buflen_)
+{
+}
+
+DcmInputBufferStreamFactory::~DcmInputBufferStreamFactory()
+{
+}
+
+DcmInputStream *DcmInputBufferStreamFactory::create() const
+{
+  DcmInputBufferStream *stream = new DcmInputBufferStream();
+  stream->setBuffer(buffer_, buflen_);
+  stream->setEos();
+  return stream;
+}
@@ -24,6 +24,7 @@
 #include "dcmtk/dcmdata/dcistrmf.h"
 #include "dcmtk/dcmdata/dcistrmb.h"
 #include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/dcmdata/dclzcach.h"
 
 BEGIN_EXTERN_C
 #ifdef HAVE_FCNTL_H
@@ -156,6 +157,9 @@ DcmInputFileStreamFactory::~DcmInputFileStreamFactory()
 
 DcmInputStream *DcmInputFileStreamFactory::create() const
 {
+  // re-use an open file handle if the file handle cache is enabled
+  if (DcmLazyLoadCache::isCachable(filename_))
+    return new DcmInputCachedFileStream(filename_, offset_);
   return new DcmInputFileStream(filename_, offset_);
 }
 
@@ -29,6 +29,7 @@
 #include "dcmtk/dcmdata/dcostrma.h"   /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcovlay.h"
 #include "dcmtk/dcmdata/dcpixel.h"
+#include "dcmtk/dcmdata/dcproj.h"     /* for class DcmAttributeProjection */
 #include "dcmtk/dcmdata/dcsequen.h"
 #include "dcmtk/dcmdata/dcswap.h"
 #include "dcmtk/dcmdata/dcvr.h"
@@ -83,7 +84,8 @@ DcmItem::DcmItem()
     elementList(NULL),
     lastElementComplete(OFTrue),
     fStartPosition(0),
-    privateCreatorCache()
+    privateCreatorCache(),
+    readProjection(NULL)
 {
     elementList = new DcmList;
 }
@@ -95,7 +97,8 @@ DcmItem::DcmItem(const DcmTag &tag,
     elementList(NULL),
     lastElementComplete(OFTrue),
     fStartPosition(0),
-    privateCreatorCache()
+    privateCreatorCache(),
+    readProjection(NULL)
 {
     elementList = new DcmList;
 }
@@ -106,7 +109,8 @@ DcmItem::DcmItem(const DcmItem &old)
     elementList(new DcmList),
     lastElementComplete(old.lastElementComplete),
     fStartPosition(old.fStartPosition),
-    privateCreatorCache()
+    privateCreatorCache(),
+    readProjection(NULL)
 {
     if (!old.elementList->empty())
     {
@@ -1262,9 +1266,15 @@ OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
         /* insert the new element into the (sorted) element list and */
         /* assign information which was read from the inStream to it */
         subElem->transferInit();
+        /* the items of a sequence need to know their surrounding item */
+        /* while reading in order to determine their read projection */
+        if (readProjection != NULL)
+            subElem->setParent(this);
         /* we need to read the content of the attribute, no matter if */
         /* inserting the attribute succeeds or fails */
         l_error = subElem->read(inStream, (readAsUN ? EXS_LittleEndianImplicit : xfer), glenc, maxReadLength);
+        if (readProjection != NULL)
+            subElem->setParent(NULL);
         // try to insert element into item. Note that
         // "elementList->insert(subElem, ELP_next)" would be faster,
         // but this is better since this insert-function creates a
@@ -1338,6 +1348,57 @@ OFCondition DcmItem::readSubElement(DcmInputStream &inStream,
 // ********************************
 
 
+OFCondition DcmItem::skipSubElement(DcmInputStream &inStream,
+                                    DcmTag &newTag,
+                                    const Uint32 newLength,
+                                    const E_TransferSyntax xfer,
+                                    const E_GrpLenEncoding glenc,
+                                    const Uint32 maxReadLength)
+{
+    OFCondition l_error = EC_Normal;
+    if (newLength != DCM_UndefinedLength)
+    {
+        /* skip the value without reading it (seek in case of a file) */
+        const offile_off_t skipped = inStream.skip(newLength);
+        if (skipped < OFstatic_cast(offile_off_t, newLength))
+        {
+            DCMDATA_ERROR("DcmItem: " << newTag.getTagName() << " " << newTag
+                << " larger (" << newLength << ") than remaining bytes in file");
+            /* if desired, specific parser errors will be ignored */
+            if (!dcmIgnoreParsingErrors.get())
+                l_error = EC_StreamNotifyClient;
+        }
+    } else {
+        /* the end of the value can only be determined by parsing it */
+        DcmElement *subElem = NULL;
+        OFBool readAsUN = OFFalse;
+        l_error = DcmItem::newDicomElement(subElem, newTag, newLength, &privateCreatorCache, readAsUN);
+        if (l_error.good() && (subElem != NULL))
+        {
+            DCMDATA_TRACE("DcmItem::skipSubElement() parsing element " << newTag << " with undefined length");
+            subElem->transferInit();
+            l_error = subElem->read(inStream, (readAsUN ? EXS_LittleEndianImplicit : xfer), glenc, maxReadLength);
+            subElem->transferEnd();
+            delete subElem;
+        } else {
+            delete subElem;
+            /* let the regular code handle (and report) unusual encodings */
+            l_error = readSubElement(inStream, newTag, newLength, xfer, glenc, maxReadLength);
+        }
+    }
+    return l_error;
+}
+
+
+void DcmItem::setReadProjection(const DcmAttributeProjection *projection)
+{
+    readProjection = projection;
+}
+
+
+// ********************************
+
+
 OFCondition DcmItem::read(DcmInputStream & inStream,
                           const E_TransferSyntax xfer,
                           const E_GrpLenEncoding glenc,
@@ -1373,6 +1434,15 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
         {
             fStartPosition = inStream.tell();  // start position of this item
             setTransferState(ERW_inWork);
+            /* the items of a sequence use the projection of the surrounding item (if any) */
+            if (isNested())
+            {
+                const DcmItem *parentItem = getParentItem();
+                if ((parentItem != NULL) && (parentItem->readProjection != NULL))
+                    readProjection = parentItem->readProjection->getItemProjection(getParent()->getTag());
+                else
+                    readProjection = NULL;
+            }
         }
         DcmTag newTag;
         OFBool readStopElem = OFFalse;
@@ -1382,6 +1452,7 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
             /* initialize variables */
             Uint32 newValueLength = 0;
             Uint32 bytes_tagAndLen = 0;
+            OFBool skippedElem = OFFalse;
             /* if the reading of the last element was complete, go ahead and read the next element */
             if (lastElementComplete)
             {
@@ -1437,6 +1508,42 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
                       DCMDATA_INFO("DcmItem: Element " << newTag.getTagName() << " " << newTag
                         << " encountered, skipping rest of dataset");
                     }
+                    /* check whether the element is needed at all if a read projection is used */
+                    /* (delimitation items are always handled by the regular code) */
+                    else if ((readProjection != NULL) && (newTag.getGroup() != 0xfffe) &&
+                             ((readProjection->getLastTag() < newTag) || !readProjection->isSelected(newTag)))
+                    {
+                      skippedElem = OFTrue;
+                      if ((readProjection->getLastTag() < newTag) && (ident() == EVR_dataset))
+                      {
+                        /* all selected elements of the main dataset have been read */
+                        lastElementComplete = OFTrue;
+                        readStopElem = OFTrue;
+                        DCMDATA_DEBUG("DcmItem: Element " << newTag.getTagName() << " " << newTag
+                          << " encountered, skipping rest of dataset (not selected by read projection)");
+                      }
+                      else if ((readProjection->getLastTag() < newTag) && (getLengthField() != DCM_UndefinedLength))
+                      {
+                        /* all selected elements of this item have been read, skip the rest of the item */
+                        const offile_off_t remaining = OFstatic_cast(offile_off_t, getLengthField()) - (inStream.tell() - fStartPosition);
+                        if ((remaining > 0) && (inStream.skip(remaining) < remaining))
+                        {
+                          DCMDATA_ERROR("DcmItem: " << getTag() << " larger (" << getLengthField()
+                            << ") than remaining bytes in file");
+                          if (!dcmIgnoreParsingErrors.get())
+                            errorFlag = EC_StreamNotifyClient;
+                        }
+                        if (errorFlag.good())
+                          lastElementComplete = OFTrue;
+                      }
+                      else
+                      {
+                        /* skip the value of this element */
+                        errorFlag = skipSubElement(inStream, newTag, newValueLength, xfer, glenc, maxReadLength);
+                        if (errorFlag.good())
+                          lastElementComplete = OFTrue;
+                      }
+                    }
                     else
                     {
                       /* read the actual data value which belongs to this element */
@@ -1473,7 +1580,7 @@ OFCondition DcmItem::readUntilTag(DcmInputStream & inStream,
             if (errorFlag.good())
             {
                 // If we completed one element, update the private tag cache.
-                if (lastElementComplete)
+                if (lastElementComplete && !skippedElem)
                 {
                     privateCreatorCache.updateCache(elementList->get());
                     // evaluate option for skipping rest of dataset
@@ -212,6 +212,24 @@ void DcmJsonFormat::printNumberDecimal(STD_NAMESPACE ostream &out,
     }
 }
 
+// Print a number created by OFStandard::ftoa() without the plus signs
+void DcmJsonFormat::printNumberDecimal(STD_NAMESPACE ostream &out,
+                                       const char *value)
+{
+    if ((value != NULL) && (*value != '\0'))
+    {
+        for (const char *c = value; *c != '\0'; ++c)
+        {
+            if (*c != '+')
+                out << *c;
+        }
+    }
+    else
+    {
+        out << "null";
+    }
+}
+
 // Print the prefix for Value
 void DcmJsonFormat::printValuePrefix(STD_NAMESPACE ostream &out)
 {
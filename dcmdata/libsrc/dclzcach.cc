@@ -0,0 +1,573 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: file handle cache and memory budget for values loaded on demand
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmdata/dclzcach.h"
+#include "dcmtk/dcmdata/dcistrmf.h"
+#include "dcmtk/dcmdata/dcelem.h"
+#include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofmap.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"
+#endif
+
+// default size of the read-ahead buffer of each cached file handle
+#define DcmLazyLoadCache_ReadAheadSize 65536
+
+/** an open file, either idle in the cache or in use by a producer
+ */
+class DcmCachedFileHandle
+{
+public:
+
+  /// constructor
+  DcmCachedFileHandle(const OFString &name)
+  : name_(name)
+  , file_()
+  , size_(0)
+  , buffer_(NULL)
+  , bufferSize_(0)
+  , bufferStart_(0)
+  , bufferLength_(0)
+  , stale_(OFFalse)
+  {
+  }
+
+  /// destructor
+  ~DcmCachedFileHandle()
+  {
+    delete[] buffer_;
+  }
+
+  /// name of the file (cache key)
+  OFString name_;
+
+  /// the open file
+  OFFile file_;
+
+  /// number of bytes in file
+  offile_off_t size_;
+
+  /// read-ahead buffer, may be NULL
+  Uint8 *buffer_;
+
+  /// allocated size of the read-ahead buffer
+  size_t bufferSize_;
+
+  /// file position of the first byte in the read-ahead buffer
+  offile_off_t bufferStart_;
+
+  /// number of valid bytes in the read-ahead buffer
+  size_t bufferLength_;
+
+  /// true if the file has been modified while the handle was in use
+  OFBool stale_;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmCachedFileHandle(const DcmCachedFileHandle&);
+
+  /// private unimplemented copy assignment operator
+  DcmCachedFileHandle& operator=(const DcmCachedFileHandle&);
+};
+
+/** the shared state of the cache. A single static instance exists,
+ *  all access is protected by its mutex.
+ */
+struct DcmLazyLoadCacheState
+{
+  DcmLazyLoadCacheState()
+#ifdef WITH_THREADS
+  : mutex()
+  , maxOpenFiles(0)
+#else
+  : maxOpenFiles(0)
+#endif
+  , readAheadSize(DcmLazyLoadCache_ReadAheadSize)
+  , files()
+  , busyFiles()
+  {
+  }
+
+  ~DcmLazyLoadCacheState()
+  {
+    OFListIterator(DcmCachedFileHandle *) it = files.begin();
+    while (it != files.end()) delete *it++;
+  }
+
+#ifdef WITH_THREADS
+  /// mutex protecting all members
+  OFMutex mutex;
+#endif
+
+  /// maximum number of idle file handles
+  size_t maxOpenFiles;
+
+  /// size of the read-ahead buffers
+  size_t readAheadSize;
+
+  /// idle file handles, most recently used first
+  OFList<DcmCachedFileHandle *> files;
+
+  /// file handles currently in use by a producer
+  OFList<DcmCachedFileHandle *> busyFiles;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmLazyLoadCacheState(const DcmLazyLoadCacheState&);
+
+  /// private unimplemented copy assignment operator
+  DcmLazyLoadCacheState& operator=(const DcmLazyLoadCacheState&);
+};
+
+static DcmLazyLoadCacheState theLazyLoadCache;
+
+#ifdef WITH_THREADS
+#define DCMLAZYLOADCACHE_LOCK theLazyLoadCache.mutex.lock()
+#define DCMLAZYLOADCACHE_UNLOCK theLazyLoadCache.mutex.unlock()
+#else
+#define DCMLAZYLOADCACHE_LOCK
+#define DCMLAZYLOADCACHE_UNLOCK
+#endif
+
+/* ======================================================================= */
+
+void DcmLazyLoadCache::setMaxOpenFiles(size_t maxFiles)
+{
+  DCMLAZYLOADCACHE_LOCK;
+  theLazyLoadCache.maxOpenFiles = maxFiles;
+  trimFiles(maxFiles);
+  DCMLAZYLOADCACHE_UNLOCK;
+}
+
+size_t DcmLazyLoadCache::getMaxOpenFiles()
+{
+  DCMLAZYLOADCACHE_LOCK;
+  size_t result = theLazyLoadCache.maxOpenFiles;
+  DCMLAZYLOADCACHE_UNLOCK;
+  return result;
+}
+
+size_t DcmLazyLoadCache::getNumberOfOpenFiles()
+{
+  DCMLAZYLOADCACHE_LOCK;
+  size_t result = theLazyLoadCache.files.size();
+  DCMLAZYLOADCACHE_UNLOCK;
+  return result;
+}
+
+void DcmLazyLoadCache::setReadAheadSize(size_t bytes)
+{
+  DCMLAZYLOADCACHE_LOCK;
+  theLazyLoadCache.readAheadSize = bytes;
+  DCMLAZYLOADCACHE_UNLOCK;
+}
+
+size_t DcmLazyLoadCache::getReadAheadSize()
+{
+  DCMLAZYLOADCACHE_LOCK;
+  size_t result = theLazyLoadCache.readAheadSize;
+  DCMLAZYLOADCACHE_UNLOCK;
+  return result;
+}
+
+void DcmLazyLoadCache::closeFile(const OFFilename &filename)
+{
+  if (filename.usesWideChars() || (filename.getCharPointer() == NULL)) return;
+  const OFString name(filename.getCharPointer());
+  DCMLAZYLOADCACHE_LOCK;
+  OFListIterator(DcmCachedFileHandle *) it = theLazyLoadCache.files.begin();
+  while (it != theLazyLoadCache.files.end())
+  {
+    if ((*it)->name_ == name)
+    {
+      delete *it;
+      it = theLazyLoadCache.files.erase(it);
+    }
+    else ++it;
+  }
+  // handles in use are closed when they are returned to the cache
+  it = theLazyLoadCache.busyFiles.begin();
+  while (it != theLazyLoadCache.busyFiles.end())
+  {
+    if ((*it)->name_ == name) (*it)->stale_ = OFTrue;
+    ++it;
+  }
+  DCMLAZYLOADCACHE_UNLOCK;
+}
+
+void DcmLazyLoadCache::closeAll()
+{
+  DCMLAZYLOADCACHE_LOCK;
+  trimFiles(0);
+  DCMLAZYLOADCACHE_UNLOCK;
+}
+
+OFBool DcmLazyLoadCache::isCachable(const OFFilename &filename)
+{
+  // wide character filenames are not supported as cache keys
+  if (filename.usesWideChars() || (filename.getCharPointer() == NULL)) return OFFalse;
+  DCMLAZYLOADCACHE_LOCK;
+  OFBool result = (theLazyLoadCache.maxOpenFiles > 0);
+  DCMLAZYLOADCACHE_UNLOCK;
+  return result;
+}
+
+DcmCachedFileHandle *DcmLazyLoadCache::acquireFile(const OFFilename &filename, OFCondition &status)
+{
+  status = EC_Normal;
+  if (filename.usesWideChars() || (filename.getCharPointer() == NULL))
+  {
+    status = EC_IllegalParameter;
+    return NULL;
+  }
+  const OFString name(filename.getCharPointer());
+  DcmCachedFileHandle *handle = NULL;
+  size_t readAheadSize;
+
+  // look for an idle handle for this file
+  DCMLAZYLOADCACHE_LOCK;
+  readAheadSize = theLazyLoadCache.readAheadSize;
+  OFListIterator(DcmCachedFileHandle *) it = theLazyLoadCache.files.begin();
+  while (it != theLazyLoadCache.files.end())
+  {
+    if ((*it)->name_ == name)
+    {
+      handle = *it;
+      theLazyLoadCache.files.erase(it);
+      break;
+    }
+    ++it;
+  }
+  if (handle) theLazyLoadCache.busyFiles.push_back(handle);
+  DCMLAZYLOADCACHE_UNLOCK;
+
+  if (handle == NULL)
+  {
+    // no idle handle available, open the file
+    handle = new DcmCachedFileHandle(name);
+    if (handle->file_.fopen(filename, "rb"))
+    {
+      handle->file_.fseek(0L, SEEK_END);
+      handle->size_ = handle->file_.ftell();
+    }
+    else
+    {
+      OFString s("(unknown error code)");
+      handle->file_.getLastErrorString(s);
+      status = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
+      delete handle;
+      return NULL;
+    }
+    DCMLAZYLOADCACHE_LOCK;
+    theLazyLoadCache.busyFiles.push_back(handle);
+    DCMLAZYLOADCACHE_UNLOCK;
+  }
+
+  // (re-)allocate the read-ahead buffer if its size has been changed
+  if (handle->bufferSize_ != readAheadSize)
+  {
+    delete[] handle->buffer_;
+    handle->buffer_ = (readAheadSize > 0) ? new Uint8[readAheadSize] : NULL;
+    handle->bufferSize_ = readAheadSize;
+    handle->bufferStart_ = 0;
+    handle->bufferLength_ = 0;
+  }
+  return handle;
+}
+
+void DcmLazyLoadCache::releaseFile(DcmCachedFileHandle *handle)
+{
+  if (handle == NULL) return;
+  DCMLAZYLOADCACHE_LOCK;
+  theLazyLoadCache.busyFiles.remove(handle);
+  if ((theLazyLoadCache.maxOpenFiles > 0) && !handle->stale_)
+  {
+    theLazyLoadCache.files.push_front(handle);
+    trimFiles(theLazyLoadCache.maxOpenFiles);
+    handle = NULL;
+  }
+  DCMLAZYLOADCACHE_UNLOCK;
+  // cache disabled or file modified in the meantime, close the file
+  delete handle;
+}
+
+offile_off_t DcmLazyLoadCache::read(DcmCachedFileHandle *handle, offile_off_t pos, void *buf, offile_off_t buflen)
+{
+  Uint8 *dest = OFstatic_cast(Uint8 *, buf);
+  offile_off_t result = 0;
+  if (pos >= handle->size_) return 0;
+  if (buflen > handle->size_ - pos) buflen = handle->size_ - pos;
+
+  while (buflen > 0)
+  {
+    // serve as much as possible from the read-ahead buffer
+    if ((pos >= handle->bufferStart_) && (pos < handle->bufferStart_ + OFstatic_cast(offile_off_t, handle->bufferLength_)))
+    {
+      offile_off_t count = handle->bufferStart_ + OFstatic_cast(offile_off_t, handle->bufferLength_) - pos;
+      if (count > buflen) count = buflen;
+      memcpy(dest, handle->buffer_ + (pos - handle->bufferStart_), OFstatic_cast(size_t, count));
+      dest += count;
+      pos += count;
+      buflen -= count;
+      result += count;
+      continue;
+    }
+
+    if (handle->file_.fseek(pos, SEEK_SET) != 0) break;
+    if (buflen >= OFstatic_cast(offile_off_t, handle->bufferSize_))
+    {
+      // large read, bypass the buffer
+      result += OFstatic_cast(offile_off_t, handle->file_.fread(dest, 1, OFstatic_cast(size_t, buflen)));
+      break;
+    }
+
+    // small read, refill the buffer
+    handle->bufferStart_ = pos;
+    handle->bufferLength_ = handle->file_.fread(handle->buffer_, 1, handle->bufferSize_);
+    if (handle->bufferLength_ == 0) break;
+  }
+  return result;
+}
+
+offile_off_t DcmLazyLoadCache::fileSize(const DcmCachedFileHandle *handle)
+{
+  return handle->size_;
+}
+
+void DcmLazyLoadCache::trimFiles(size_t maxFiles)
+{
+  while (theLazyLoadCache.files.size() > maxFiles)
+  {
+    delete theLazyLoadCache.files.back();
+    theLazyLoadCache.files.pop_back();
+  }
+}
+
+/* ======================================================================= */
+
+DcmLazyLoadBudget::DcmLazyLoadBudget(size_t bytes)
+: limit_(bytes)
+, loadedBytes_(0)
+, usedValues_()
+, releasedValues_()
+, index_()
+{
+}
+
+DcmLazyLoadBudget::~DcmLazyLoadBudget()
+{
+  OFListIterator(DcmLazyLoadValue) it = usedValues_.begin();
+  while (it != usedValues_.end()) (*it++).element->fValueBudget = NULL;
+  it = releasedValues_.begin();
+  while (it != releasedValues_.end()) (*it++).element->fValueBudget = NULL;
+}
+
+void DcmLazyLoadBudget::setLimit(size_t bytes)
+{
+  limit_ = bytes;
+  enforce();
+}
+
+size_t DcmLazyLoadBudget::getLimit() const
+{
+  return limit_;
+}
+
+size_t DcmLazyLoadBudget::getLoadedBytes() const
+{
+  return loadedBytes_;
+}
+
+void DcmLazyLoadBudget::registerValue(DcmElement *element, Uint32 length)
+{
+  if (element->fValueBudget != NULL) element->fValueBudget->unregisterValue(element);
+  DcmLazyLoadValue value;
+  value.element = element;
+  value.length = length;
+  value.byteOrder = element->getByteOrder();
+  value.released = OFFalse;
+  index_[element] = usedValues_.insert(usedValues_.end(), value);
+  loadedBytes_ += length;
+  element->fValueBudget = this;
+  enforce();
+}
+
+void DcmLazyLoadBudget::unregisterValue(DcmElement *element)
+{
+  OFMap<const DcmElement *, OFListIterator(DcmLazyLoadValue)>::iterator it = index_.find(element);
+  if (it != index_.end())
+  {
+    loadedBytes_ -= (*(it->second)).length;
+    if ((*(it->second)).released)
+      releasedValues_.erase(it->second);
+    else
+      usedValues_.erase(it->second);
+    index_.erase(it);
+  }
+  element->fValueBudget = NULL;
+}
+
+void DcmLazyLoadBudget::releaseValue(DcmElement *element)
+{
+  OFMap<const DcmElement *, OFListIterator(DcmLazyLoadValue)>::iterator it = index_.find(element);
+  if ((it != index_.end()) && !(*(it->second)).released)
+  {
+    DcmLazyLoadValue value = *(it->second);
+    value.released = OFTrue;
+    usedValues_.erase(it->second);
+    it->second = releasedValues_.insert(releasedValues_.end(), value);
+    enforce();
+  }
+}
+
+void DcmLazyLoadBudget::claimValue(DcmElement *element)
+{
+  OFMap<const DcmElement *, OFListIterator(DcmLazyLoadValue)>::iterator it = index_.find(element);
+  if ((it != index_.end()) && (*(it->second)).released)
+  {
+    DcmLazyLoadValue value = *(it->second);
+    value.released = OFFalse;
+    releasedValues_.erase(it->second);
+    it->second = usedValues_.insert(usedValues_.end(), value);
+  }
+}
+
+void DcmLazyLoadBudget::enforce()
+{
+  if (limit_ == 0) return;
+  OFListIterator(DcmLazyLoadValue) it = releasedValues_.begin();
+  while ((loadedBytes_ > limit_) && (it != releasedValues_.end()))
+  {
+    DcmElement *element = (*it).element;
+    const OFBool unchanged = (element->getByteOrder() == (*it).byteOrder);
+    loadedBytes_ -= (*it).length;
+    index_.erase(index_.find(element));
+    it = releasedValues_.erase(it);
+    // compact() does not call back into the budget once it is detached.
+    // A value that has been byte-swapped in memory no longer matches the
+    // file and is only removed from the budget.
+    element->fValueBudget = NULL;
+    if (unchanged) element->compact();
+  }
+}
+
+/* ======================================================================= */
+
+DcmCachedFileProducer::DcmCachedFileProducer(const OFFilename &filename, offile_off_t offset)
+: DcmProducer()
+, handle_(NULL)
+, status_(EC_Normal)
+, size_(0)
+, pos_(offset)
+{
+  handle_ = DcmLazyLoadCache::acquireFile(filename, status_);
+  if (handle_)
+  {
+    size_ = DcmLazyLoadCache::fileSize(handle_);
+    if ((offset < 0) || (offset > size_)) status_ = EC_InvalidStream;
+  }
+}
+
+DcmCachedFileProducer::~DcmCachedFileProducer()
+{
+  DcmLazyLoadCache::releaseFile(handle_);
+}
+
+OFBool DcmCachedFileProducer::good() const
+{
+  return status_.good();
+}
+
+OFCondition DcmCachedFileProducer::status() const
+{
+  return status_;
+}
+
+OFBool DcmCachedFileProducer::eos()
+{
+  return (handle_ == NULL) || (pos_ >= size_);
+}
+
+offile_off_t DcmCachedFileProducer::avail()
+{
+  return (handle_ && pos_ < size_) ? size_ - pos_ : 0;
+}
+
+offile_off_t DcmCachedFileProducer::read(void *buf, offile_off_t buflen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && handle_ && buf && buflen)
+  {
+    result = DcmLazyLoadCache::read(handle_, pos_, buf, buflen);
+    pos_ += result;
+  }
+  return result;
+}
+
+offile_off_t DcmCachedFileProducer::skip(offile_off_t skiplen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && handle_ && skiplen)
+  {
+    result = (size_ - pos_ < skiplen) ? (size_ - pos_) : skiplen;
+    pos_ += result;
+  }
+  return result;
+}
+
+void DcmCachedFileProducer::putback(offile_off_t num)
+{
+  if (status_.good() && handle_ && num)
+  {
+    if (num <= pos_) pos_ -= num;
+    else status_ = EC_PutbackFailed; // tried to putback before start of file
+  }
+}
+
+/* ======================================================================= */
+
+DcmInputCachedFileStream::DcmInputCachedFileStream(const OFFilename &filename, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(filename, offset)
+, filename_(filename)
+, offset_(offset)
+{
+}
+
+DcmInputCachedFileStream::~DcmInputCachedFileStream()
+{
+}
+
+DcmInputStreamFactory *DcmInputCachedFileStream::newFactory() const
+{
+  DcmInputStreamFactory *result = NULL;
+  if (currentProducer() == &producer_)
+  {
+    // no filter installed, can create factory object
+    result = new DcmInputFileStreamFactory(filename_, offset_ + tell());
+  }
+  return result;
+}
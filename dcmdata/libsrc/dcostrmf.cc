@@ -23,7 +23,11 @@
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/dcmdata/dcostrmf.h"
 #include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/dcmdata/dclzcach.h"
 #include "dcmtk/ofstd/ofconsol.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+#include <cerrno>
 
 BEGIN_EXTERN_C
 #ifdef HAVE_FCNTL_H
@@ -32,19 +36,146 @@ BEGIN_EXTERN_C
 #ifdef HAVE_IO_H
 #include <io.h>
 #endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
 END_EXTERN_C
 
+#ifdef HAVE_WINDOWS_H
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>     /* for MoveFileEx() */
+#endif
+
+
+/* global flags */
+OFGlobal<Uint32> dcmFileWriteBufferSize(0);
+OFGlobal<OFBool> dcmDurableFileWrite(OFFalse);
+
+
+/* create error condition from the last system error */
+static OFCondition makeSystemErrorCondition()
+{
+  OFString buffer = OFStandard::getLastSystemErrorCode().message();
+  return makeOFCondition(OFM_dcmdata, 19, OF_error, buffer.c_str());
+}
+
+/* check whether the given file exists and is not a regular file (e.g. /dev/null) */
+static OFBool isSpecialFile(const OFFilename &filename)
+{
+#ifdef HAVE_SYS_STAT_H
+  const char *name = filename.getCharPointer();
+  struct stat st;
+  if ((name != NULL) && (stat(name, &st) == 0))
+    return (st.st_mode & S_IFMT) != S_IFREG;
+#else
+  (void) filename;
+#endif
+  return OFFalse;
+}
+
+/* flush the data of the given file descriptor to disk */
+static int syncFileDescriptor(int fd)
+{
+#ifdef F_FULLFSYNC
+  /* on macOS, fsync() does not flush the disk cache */
+  if (fcntl(fd, F_FULLFSYNC) == 0) return 0;
+#endif
+#if defined(HAVE_FDATASYNC) && !defined(__APPLE__)
+  return fdatasync(fd);
+#elif defined(HAVE_FSYNC)
+  return fsync(fd);
+#elif defined(_WIN32)
+  return _commit(fd);
+#else
+  (void) fd;
+  return 0;
+#endif
+}
+
+/* rename the given file, replacing an existing file with the new name */
+static OFBool replaceFile(const OFFilename &oldName, const OFFilename &newName)
+{
+#ifdef HAVE_WINDOWS_H
+  /* rename() does not replace an existing file on Windows. MoveFileEx()
+   * replaces it in a single step and only returns after the move has been
+   * flushed to disk.
+   */
+  const DWORD flags = MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH;
+#ifdef WIDE_CHAR_FILE_IO_FUNCTIONS
+  if (oldName.usesWideChars() && newName.usesWideChars())
+    return MoveFileExW(oldName.getWideCharPointer(), newName.getWideCharPointer(), flags) != 0;
+#endif
+  return MoveFileExA(oldName.getCharPointer(), newName.getCharPointer(), flags) != 0;
+#else
+  return OFStandard::renameFile(oldName, newName);
+#endif
+}
+
+/* flush the directory entry of the given file to disk */
+static void syncDirectory(const OFFilename &filename)
+{
+#if defined(HAVE_FSYNC) && !defined(_WIN32)
+  OFFilename dirName;
+  OFStandard::getDirNameFromPath(dirName, filename, OFFalse /*assumeDirName*/);
+  const char *name = dirName.getCharPointer();
+  if ((name == NULL) || (*name == '\0'))
+    name = (filename.getCharPointer() && (*filename.getCharPointer() == PATH_SEPARATOR)) ? "/" : ".";
+  int fd = open(name, O_RDONLY);
+  if (fd >= 0)
+  {
+    /* errors are ignored since not all file systems support this */
+    fsync(fd);
+    ::close(fd);
+  }
+#else
+  (void) filename;
+#endif
+}
+
 
 DcmFileConsumer::DcmFileConsumer(const OFFilename &filename)
 : DcmConsumer()
 , file_container_()
 , file_(file_container_)
 , status_(EC_Normal)
+, filename_()
+, tempFilename_()
+, buffer_(NULL)
+, written_(0)
+, preallocated_(0)
+, closed_(OFFalse)
 {
-  if (!file_.fopen(filename, "wb"))
+  if (dcmDurableFileWrite.get() && !isSpecialFile(filename))
   {
-    OFString buffer = OFStandard::getLastSystemErrorCode().message();
-    status_ = makeOFCondition(OFM_dcmdata, 19, OF_error, buffer.c_str());
+    // write to a temporary file in the same directory, which is renamed on close()
+    char suffix[64];
+    OFStandard::snprintf(suffix, sizeof(suffix), ".%lx.%lx.tmp", OFstatic_cast(unsigned long, OFStandard::getProcessID()),
+      OFstatic_cast(unsigned long, OFreinterpret_cast(size_t, this)));
+    OFStandard::appendFilenameExtension(tempFilename_, filename, suffix);
+  }
+  // the file is truncated in place, cached file handles would read outdated data
+  if (tempFilename_.isEmpty())
+    DcmLazyLoadCache::closeFile(filename);
+  if (!file_.fopen(tempFilename_.isEmpty() ? filename : tempFilename_, "wb"))
+  {
+    status_ = makeSystemErrorCondition();
+    tempFilename_.clear();
+  } else {
+    filename_ = filename;
+    const Uint32 bufferSize = dcmFileWriteBufferSize.get();
+    if (bufferSize > 0)
+    {
+      buffer_ = new char[bufferSize];
+      if (file_.setvbuf(buffer_, _IOFBF, bufferSize) != 0)
+      {
+        // keep the default buffer of the C library
+        delete[] buffer_;
+        buffer_ = NULL;
+      }
+    }
   }
 }
 
@@ -53,6 +184,12 @@ DcmFileConsumer::DcmFileConsumer(FILE *file)
 , file_container_(file)
 , file_(file_container_)
 , status_(EC_Normal)
+, filename_()
+, tempFilename_()
+, buffer_(NULL)
+, written_(0)
+, preallocated_(0)
+, closed_(OFFalse)
 {
 }
 
@@ -61,12 +198,25 @@ DcmFileConsumer::DcmFileConsumer(OFFile &file)
 , file_container_()
 , file_(file)
 , status_(EC_Normal)
+, filename_()
+, tempFilename_()
+, buffer_(NULL)
+, written_(0)
+, preallocated_(0)
+, closed_(OFFalse)
 {
 }
 
 DcmFileConsumer::~DcmFileConsumer()
 {
-  file_.fclose();
+  if (!closed_)
+  {
+    OFCondition result = close();
+    if (result.bad() && !filename_.isEmpty())
+      DCMDATA_ERROR("cannot close file " << filename_ << ": " << result.text());
+  }
+  // the buffer must not be deleted before the file is closed
+  delete[] buffer_;
 }
 
 OFBool DcmFileConsumer::good() const
@@ -125,6 +275,7 @@ offile_off_t DcmFileConsumer::write(const void *buf, offile_off_t buflen)
       result += written;
     }
 #endif
+    written_ += result;
   }
   return result;
 }
@@ -134,6 +285,74 @@ void DcmFileConsumer::flush()
   // nothing to flush
 }
 
+OFCondition DcmFileConsumer::preallocate(offile_off_t size)
+{
+  if (status_.bad()) return status_;
+#ifdef HAVE_POSIX_FALLOCATE
+  // only in durable mode, since the file is truncated to its final size on close()
+  if (!tempFilename_.isEmpty() && file_.open() && (size > written_))
+  {
+    const int err = posix_fallocate(file_.fileNo(), 0, size);
+    if (err == 0)
+      preallocated_ = size;
+    else if (err == ENOSPC)
+    {
+      char buf[256];
+      return makeOFCondition(OFM_dcmdata, 19, OF_error, OFStandard::strerror(err, buf, sizeof(buf)));
+    }
+    // other errors (e.g. not supported by the file system) are ignored
+  }
+#else
+  (void) size;
+#endif
+  return EC_Normal;
+}
+
+OFCondition DcmFileConsumer::close(const OFBool discard)
+{
+  if (closed_) return status_;
+  closed_ = OFTrue;
+  if (!file_.open()) return status_;
+  if (tempFilename_.isEmpty())
+  {
+    if ((file_.fclose() != 0) && status_.good())
+      status_ = makeSystemErrorCondition();
+    // read-ahead buffers filled while the file was written are outdated
+    DcmLazyLoadCache::closeFile(filename_);
+    return status_;
+  }
+  /* durable mode: flush data to disk before the file becomes visible under its final name */
+  OFBool keep = status_.good() && !discard;
+  if (keep)
+  {
+    if (file_.fflush() != 0)
+      status_ = makeSystemErrorCondition();
+#ifdef HAVE_POSIX_FALLOCATE
+    else if ((preallocated_ > written_) && (ftruncate(file_.fileNo(), written_) != 0))
+      status_ = makeSystemErrorCondition();
+#endif
+    else if (syncFileDescriptor(file_.fileNo()) != 0)
+      status_ = makeSystemErrorCondition();
+  }
+  if ((file_.fclose() != 0) && status_.good())
+    status_ = makeSystemErrorCondition();
+  keep = status_.good() && !discard;
+  if (keep)
+  {
+    if (!replaceFile(tempFilename_, filename_))
+      status_ = makeSystemErrorCondition();
+    else
+    {
+      syncDirectory(filename_);
+      // file handles cached while the file was written refer to the replaced file
+      DcmLazyLoadCache::closeFile(filename_);
+    }
+  }
+  if (status_.bad() || discard)
+    OFStandard::deleteFile(tempFilename_);
+  return status_;
+}
+
 /* ======================================================================= */
 
 DcmOutputFileStream::DcmOutputFileStream(const OFFilename &filename)
@@ -154,6 +373,18 @@ DcmOutputFileStream::DcmOutputFileStream(OFFile& file)
 {
 }
 
+OFCondition DcmOutputFileStream::preallocate(offile_off_t size)
+{
+  return consumer_.preallocate(size);
+}
+
+OFCondition DcmOutputFileStream::close(const OFBool discard)
+{
+  // flush filters (if any) before the file is closed
+  flush();
+  return consumer_.close(discard);
+}
+
 DcmOutputFileStream::~DcmOutputFileStream()
 {
   // last attempt to flush stream before file is closed
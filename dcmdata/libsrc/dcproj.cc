@@ -0,0 +1,179 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Class for selecting the attributes to be read from a DICOM stream
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcproj.h"
+#include "dcmtk/dcmdata/dcpath.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcerror.h"
+
+
+DcmAttributeProjection::DcmAttributeProjection()
+  : entries(),
+    lastTag(0x0000, 0x0000)
+{
+}
+
+
+DcmAttributeProjection::~DcmAttributeProjection()
+{
+    clear();
+}
+
+
+void DcmAttributeProjection::addTag(const DcmTagKey &tagKey)
+{
+    select(tagKey, OFTrue /*complete*/);
+}
+
+
+OFCondition DcmAttributeProjection::addPath(const OFString &path)
+{
+    if (path.empty())
+        return EC_IllegalParameter;
+    OFString restPath(path);
+    DcmAttributeProjection *level = this;
+    DcmTag tag;
+    OFCondition status;
+    while (!restPath.empty())
+    {
+        /* parse the attribute tag */
+        status = DcmPath::parseTagFromPath(restPath, tag);
+        if (status.bad())
+            return status;
+        if (restPath.empty())
+        {
+            /* last node of the path: select the complete element */
+            level->select(tag, OFTrue /*complete*/);
+            break;
+        }
+        /* the attribute is a sequence, parse the item number (which is not evaluated) */
+        Uint32 itemNo = 0;
+        OFBool wasWildcard = OFFalse;
+        status = DcmPath::parseItemNoFromPath(restPath, itemNo, wasWildcard);
+        if (status.bad())
+            return status;
+        if (restPath.empty())
+        {
+            /* path ends with an item: select the complete sequence */
+            level->select(tag, OFTrue /*complete*/);
+            break;
+        }
+        level = level->select(tag, OFFalse /*complete*/);
+        /* the sequence has already been selected completely */
+        if (level == NULL)
+            break;
+    }
+    return EC_Normal;
+}
+
+
+void DcmAttributeProjection::clear()
+{
+    OFVector<Entry>::iterator iter = entries.begin();
+    while (iter != entries.end())
+    {
+        delete iter->items;
+        ++iter;
+    }
+    entries.clear();
+    lastTag.set(0x0000, 0x0000);
+}
+
+
+OFBool DcmAttributeProjection::empty() const
+{
+    return entries.empty();
+}
+
+
+OFBool DcmAttributeProjection::isSelected(const DcmTagKey &tagKey) const
+{
+    const size_t pos = find(tagKey);
+    if ((pos < entries.size()) && (entries[pos].tag == tagKey))
+        return OFTrue;
+    /* these are needed to interpret the values of the selected elements */
+    return (tagKey == DCM_SpecificCharacterSet) || tagKey.isPrivateReservation();
+}
+
+
+const DcmAttributeProjection *DcmAttributeProjection::getItemProjection(const DcmTagKey &tagKey) const
+{
+    const size_t pos = find(tagKey);
+    if ((pos < entries.size()) && (entries[pos].tag == tagKey))
+        return entries[pos].items;
+    return NULL;
+}
+
+
+const DcmTagKey &DcmAttributeProjection::getLastTag() const
+{
+    return lastTag;
+}
+
+
+size_t DcmAttributeProjection::find(const DcmTagKey &tagKey) const
+{
+    /* binary search for the first entry that is not less than the given tag */
+    size_t first = 0;
+    size_t count = entries.size();
+    while (count > 0)
+    {
+        const size_t step = count / 2;
+        if (entries[first + step].tag < tagKey)
+        {
+            first += step + 1;
+            count -= step + 1;
+        } else
+            count = step;
+    }
+    return first;
+}
+
+
+DcmAttributeProjection *DcmAttributeProjection::select(const DcmTagKey &tagKey,
+                                                       const OFBool complete)
+{
+    const size_t pos = find(tagKey);
+    if ((pos < entries.size()) && (entries[pos].tag == tagKey))
+    {
+        Entry &entry = entries[pos];
+        /* an element that is read completely cannot be restricted again */
+        if (entry.items == NULL)
+            return NULL;
+        if (complete)
+        {
+            delete entry.items;
+            entry.items = NULL;
+            return NULL;
+        }
+        return entry.items;
+    }
+    Entry entry;
+    entry.tag = tagKey;
+    entry.items = complete ? NULL : new DcmAttributeProjection();
+    entries.insert(entries.begin() + pos, entry);
+    if (lastTag < tagKey)
+        lastTag = tagKey;
+    return entry.items;
+}
@@ -132,7 +132,6 @@ OFCondition DcmDecimalString::getFloat64Vector(OFVector<Float64> &doubleVals)
         if (vm > 0)
         {
             Float64 doubleVal;
-            OFString doubleStr;
             char *p = strVal;
             OFBool success = OFFalse;
             /* avoid memory re-allocations by specifying the expected size */
@@ -142,9 +141,8 @@ OFCondition DcmDecimalString::getFloat64Vector(OFVector<Float64> &doubleVals)
             {
                 if ((i == strLen) || (*p == '\\'))
                 {
-                    /* extract single value and convert it to floating point */
-                    doubleStr.assign(strVal, p - strVal);
-                    doubleVal = OFStandard::atof(doubleStr.c_str(), &success);
+                    /* convert single value to floating point (in place, i.e. without copying) */
+                    doubleVal = OFStandard::atofn(strVal, p - strVal, &success);
                     if (success)
                     {
                         /* store floating point value in result variable */
@@ -204,33 +202,27 @@ OFCondition DcmDecimalString::putFloat64Prec(const Float64 val,
     // might be cut off later, i.e. 16 for integer part, 1 for dot, 14 max precision, 1 for NUL, i.e.
     char buf[16 + 1 + 14 +1];
     int written = OFStandard::snprintf(buf, 32, "%.*f", prec, val);
-    if (written > 31 /* NUL not counting in */)
+    if ((written < 0) || (written > 31 /* NUL not counting in */))
     {
         return EC_IllegalParameter;
     }
 
-    OFString str(buf);
-    if (cutTrailZeroes)
+    /* remove trailing zeroes (and the dot) without creating temporary strings */
+    size_t length = OFstatic_cast(size_t, written);
+    if (cutTrailZeroes && (strchr(buf, '.') != NULL))
     {
-        size_t dot = str.find_last_of('.');
-        if (dot != OFString_npos)
-        {
-            size_t last_valid = str.find_last_not_of('0');
-            if (last_valid != str.length() -1)
-            {
-                if (str[last_valid] == '.')
-                    str = str.substr(0, last_valid);
-                else
-                    str = str.substr(0, last_valid+1);
-            }
-        }
+        while ((length > 0) && (buf[length - 1] == '0'))
+            --length;
+        if ((length > 0) && (buf[length - 1] == '.'))
+            --length;
+        buf[length] = '\0';
     }
-    if (str.length() > 16)
+    if (length > 16)
     {
         return EC_IllegalParameter;
     }
 
-    return putOFStringAtPos(str.c_str(), pos);
+    return putOFStringAtPos(buf, pos);
 }
 
 
@@ -300,33 +292,33 @@ OFCondition DcmDecimalString::writeJson(STD_NAMESPACE ostream &out,
             {
                 OFString value;
                 OFString vmstring = "1";
-                OFCondition status = getOFString(value, 0L);
+                /* get string data once and iterate over all values (instead of
+                 * searching each value from the start of the string again)
+                 */
+                char *str = NULL;
+                Uint32 len = 0;
+                OFCondition status = getString(str, len);
                 if (status.bad())
                     return status;
-                format.printValuePrefix(out);
-
-                isValid = checkStringValue(value, vmstring).good();
-                switch (format.getJsonNumStringPolicy())
+                const char *valueStart = str;
+                const char *strEnd = (str != NULL) ? str + len : NULL;
+                for (unsigned long valNo = 0; valNo < vm; ++valNo)
                 {
-                  case DcmJsonFormat::NSP_auto:
-                    if (isValid) DcmJsonFormat::printNumberDecimal(out, value);
-                    else DcmJsonFormat::printValueString(out, value);
-                    break;
-                  case DcmJsonFormat::NSP_always_number:
-                    if (isValid) DcmJsonFormat::printNumberDecimal(out, value);
-                    else return EC_CannotWriteStringAsJsonNumber;
-                    break;
-                  case DcmJsonFormat::NSP_always_string:
-                    DcmJsonFormat::printValueString(out, value);
-                    break;
-                }
-
-                for (unsigned long valNo = 1; valNo < vm; ++valNo)
-                {
-                    status = getOFString(value, valNo);
-                    if (status.bad())
-                        return status;
-                    format.printNextArrayElementPrefix(out);
+                    /* extract and normalize single value (same as getOFString) */
+                    const char *valueEnd = valueStart;
+                    while ((valueEnd < strEnd) && (*valueEnd != '\\'))
+                        ++valueEnd;
+                    if (valueEnd > valueStart)
+                    {
+                        value.assign(valueStart, valueEnd - valueStart);
+                        normalizeString(value, !MULTIPART, DELETE_LEADING, DELETE_TRAILING);
+                    } else
+                        value.clear();
+                    valueStart = (valueEnd < strEnd) ? valueEnd + 1 : strEnd;
+                    if (valNo == 0)
+                        format.printValuePrefix(out);
+                    else
+                        format.printNextArrayElementPrefix(out);
 
                     isValid = checkStringValue(value, vmstring).good();
                     switch (format.getJsonNumStringPolicy())
@@ -395,6 +395,45 @@ OFBool DcmFloatingPointDouble::matches(const DcmElement& candidate,
 
 // ********************************
 
+OFCondition DcmFloatingPointDouble::writeXML(STD_NAMESPACE ostream &out,
+                                             const size_t flags)
+{
+    /* always write XML start tag */
+    writeXMLStartTag(out, flags);
+    const OFBool nativeModel = (flags & DCMTypes::XF_useNativeModel) > 0;
+    /* write element value (if non-empty or, if not in Native DICOM Model, if loaded) */
+    if (nativeModel ? !isEmpty() : valueLoaded())
+    {
+        Float64 *values = NULL;
+        if (getFloat64Array(values).good() && (values != NULL))
+        {
+            /* format each value into a buffer on the stack */
+            char buffer[64];
+            const unsigned long vm = getVM();
+            for (unsigned long valNo = 0; valNo < vm; ++valNo)
+            {
+                OFStandard::ftoaShortest(buffer, sizeof(buffer), values[valNo]);
+                if (nativeModel)
+                    out << "<Value number=\"" << (valNo + 1) << "\">" << buffer << "</Value>" << OFendl;
+                else
+                {
+                    if (valNo > 0)
+                        out << '\\';
+                    out << buffer;
+                }
+            }
+        }
+    }
+    /* always write XML end tag */
+    writeXMLEndTag(out, flags);
+    /* always report success */
+    return EC_Normal;
+}
+
+
+// ********************************
+
+
 OFCondition DcmFloatingPointDouble::writeJson(STD_NAMESPACE ostream &out,
                                               DcmJsonFormat &format)
 {
@@ -427,16 +466,18 @@ OFCondition DcmFloatingPointDouble::writeJson(STD_NAMESPACE ostream &out,
         }
         else
         {
-            status = getOFString(value, 0L);
+            Float64 *values = NULL;
+            status = getFloat64Array(values);
             if (status.bad()) return status;
+            /* format each value into a buffer on the stack */
+            char buffer[64];
             format.printValuePrefix(out);
-            DcmJsonFormat::printNumberDecimal(out, value);
-            for (unsigned long valNo = 1; valNo < vm; ++valNo)
+            for (unsigned long valNo = 0; valNo < vm; ++valNo)
             {
-                status = getOFString(value, valNo);
-                if (status.bad()) return status;
-                format.printNextArrayElementPrefix(out);
-                DcmJsonFormat::printNumberDecimal(out, value);
+                if (valNo > 0)
+                    format.printNextArrayElementPrefix(out);
+                OFStandard::ftoaShortest(buffer, sizeof(buffer), values[valNo]);
+                DcmJsonFormat::printNumberDecimal(out, buffer);
             }
             format.printValueSuffix(out);
         }
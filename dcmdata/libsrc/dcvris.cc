@@ -31,6 +31,54 @@
 // ********************************
 
 
+/* convert a single integer value to a 32-bit signed integer. Values consisting of
+ * an optional sign and decimal digits (surrounded by spaces or NUL characters) are
+ * converted in place, i.e. without creating any temporary objects. For all other
+ * values, sscanf() is used on a copy of the value (as in previous versions).
+ */
+static OFBool convertToSint32(const char *str,
+                              const size_t len,
+                              Sint32 &sintVal)
+{
+    const char *p = str;
+    const char *end = str + len;
+    /* skip leading spaces */
+    while ((p < end) && (*p == ' '))
+        ++p;
+    OFBool negative = OFFalse;
+    if ((p < end) && ((*p == '+') || (*p == '-')))
+        negative = (*p++ == '-');
+    const char *digits = p;
+    Sint64 value = 0;
+    /* more than 10 digits do not fit into 32 bits (except for leading zeros) */
+    while ((p < end) && (*p >= '0') && (*p <= '9') && (value <= 0xffffffff))
+        value = value * 10 + (*p++ - '0');
+    const char *digitsEnd = p;
+    /* skip trailing spaces and NUL characters */
+    while ((p < end) && ((*p == ' ') || (*p == '\0')))
+        ++p;
+    if (negative)
+        value = -value;
+    if ((p == end) && (digitsEnd > digits) && (value >= -2147483647 - 1) && (value <= 2147483647))
+    {
+        sintVal = OFstatic_cast(Sint32, value);
+        return OFTrue;
+    }
+    /* use the general implementation for all other values */
+    OFString strVal(str, len);
+#ifdef SCNd32
+    return (sscanf(strVal.c_str(), "%" SCNd32, &sintVal) == 1);
+#elif SIZEOF_LONG == 8
+    return (sscanf(strVal.c_str(), "%d", &sintVal) == 1);
+#else
+    return (sscanf(strVal.c_str(), "%ld", &sintVal) == 1);
+#endif
+}
+
+
+// ********************************
+
+
 DcmIntegerString::DcmIntegerString(const DcmTag &tag,
                                    const Uint32 len)
   : DcmByteString(tag, len)
@@ -102,13 +150,7 @@ OFCondition DcmIntegerString::getSint32(Sint32 &sintVal,
     if (l_error.good())
     {
         /* convert string to integer value */
-#ifdef SCNd32
-        if (sscanf(str.c_str(), "%" SCNd32, &sintVal) != 1)
-#elif SIZEOF_LONG == 8
-        if (sscanf(str.c_str(), "%d", &sintVal) != 1)
-#else
-        if (sscanf(str.c_str(), "%ld", &sintVal) != 1)
-#endif
+        if (!convertToSint32(str.c_str(), str.length(), sintVal))
             l_error = EC_CorruptedData;
     }
     return l_error;
@@ -118,6 +160,53 @@ OFCondition DcmIntegerString::getSint32(Sint32 &sintVal,
 // ********************************
 
 
+OFCondition DcmIntegerString::getSint32Vector(OFVector<Sint32> &sintVals)
+{
+    /* get stored value */
+    char *strVal = NULL;
+    Uint32 strLen = 0;
+    OFCondition l_error = getString(strVal, strLen);
+    /* clear result variable */
+    sintVals.clear();
+    if (l_error.good() && (strVal != NULL))
+    {
+        /* determine number of stored values */
+        const unsigned long vm = getVM();
+        if (vm > 0)
+        {
+            Sint32 sintVal;
+            char *p = strVal;
+            /* avoid memory re-allocations by specifying the expected size */
+            sintVals.reserve(vm);
+            /* iterate over the string value and search for delimiters */
+            for (Uint32 i = 0; i <= strLen; i++)
+            {
+                if ((i == strLen) || (*p == '\\'))
+                {
+                    /* convert single value to integer (in place, i.e. without copying) */
+                    if (convertToSint32(strVal, p - strVal, sintVal))
+                    {
+                        /* store integer value in result variable */
+                        sintVals.push_back(sintVal);
+                        strVal = p + 1;
+                    }
+                    else
+                    {
+                        l_error = EC_CorruptedData;
+                        break;
+                    }
+                }
+                ++p;
+            }
+        }
+    }
+    return l_error;
+}
+
+
+// ********************************
+
+
 OFCondition DcmIntegerString::getOFString(OFString &stringVal,
                                           const unsigned long pos,
                                           OFBool normalize)
@@ -167,33 +256,33 @@ OFCondition DcmIntegerString::writeJson(STD_NAMESPACE ostream &out,
             {
                 OFString value;
                 OFString vmstring = "1";
-                OFCondition status = getOFString(value, 0L);
+                /* get string data once and iterate over all values (instead of
+                 * searching each value from the start of the string again)
+                 */
+                char *str = NULL;
+                Uint32 len = 0;
+                OFCondition status = getString(str, len);
                 if (status.bad())
                     return status;
-                format.printValuePrefix(out);
-
-                isValid = checkStringValue(value, vmstring).good();
-                switch (format.getJsonNumStringPolicy())
+                const char *valueStart = str;
+                const char *strEnd = (str != NULL) ? str + len : NULL;
+                for (unsigned long valNo = 0; valNo < vm; ++valNo)
                 {
-                  case DcmJsonFormat::NSP_auto:
-                    if (isValid) DcmJsonFormat::printNumberInteger(out, value);
-                    else DcmJsonFormat::printValueString(out, value);
-                    break;
-                  case DcmJsonFormat::NSP_always_number:
-                    if (isValid) DcmJsonFormat::printNumberInteger(out, value);
-                    else return EC_CannotWriteStringAsJsonNumber;
-                    break;
-                  case DcmJsonFormat::NSP_always_string:
-                    DcmJsonFormat::printValueString(out, value);
-                    break;
-                }
-
-                for (unsigned long valNo = 1; valNo < vm; ++valNo)
-                {
-                    status = getOFString(value, valNo);
-                    if (status.bad())
-                        return status;
-                    format.printNextArrayElementPrefix(out);
+                    /* extract and normalize single value (same as getOFString) */
+                    const char *valueEnd = valueStart;
+                    while ((valueEnd < strEnd) && (*valueEnd != '\\'))
+                        ++valueEnd;
+                    if (valueEnd > valueStart)
+                    {
+                        value.assign(valueStart, valueEnd - valueStart);
+                        normalizeString(value, !MULTIPART, DELETE_LEADING, DELETE_TRAILING);
+                    } else
+                        value.clear();
+                    valueStart = (valueEnd < strEnd) ? valueEnd + 1 : strEnd;
+                    if (valNo == 0)
+                        format.printValuePrefix(out);
+                    else
+                        format.printNextArrayElementPrefix(out);
 
                     isValid = checkStringValue(value, vmstring).good();
                     switch (format.getJsonNumStringPolicy())
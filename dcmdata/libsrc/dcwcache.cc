@@ -32,11 +32,7 @@ void DcmWriteCache::init(void *owner,
                          Uint32 bytesTransferred,
                          E_ByteOrder byteOrder)
 {
-  if (! buf_)
-  {
-    capacity_ = DcmWriteCacheBufsize;
-    buf_ = new Uint8[capacity_];
-  }
+  if (! buf_) buf_ = new Uint8[capacity_];
 
   if (owner != owner_)
   {
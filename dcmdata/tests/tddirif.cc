@@ -0,0 +1,227 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DicomDirInterface
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcddirif.h"
+
+
+// number of patients, studies per patient, series per study and images per series
+#define NUM_PATIENTS 2
+#define NUM_STUDIES 2
+#define NUM_SERIES 2
+#define NUM_IMAGES 3
+
+
+// create a DICOM filename (in DICOM format) that is unique for this process
+static OFString makeFilename(const unsigned int number)
+{
+    char buf[16];
+    OFStandard::snprintf(buf, sizeof(buf), "D%04lX%03u", OFstatic_cast(unsigned long, OFStandard::getProcessID() & 0xffff), number);
+    return buf;
+}
+
+
+// create a small secondary capture image
+static OFCondition createImage(const OFFilename &pathname,
+                               const unsigned int patient,
+                               const unsigned int study,
+                               const unsigned int series,
+                               const unsigned int image)
+{
+    char uid[100];
+    char buf[64];
+    DcmFileFormat fileformat;
+    DcmDataset *dataset = fileformat.getDataset();
+    const Uint8 pixelData[4] = { 0, 64, 128, 255 };
+    OFStandard::snprintf(buf, sizeof(buf), "PAT%u", patient);
+    dataset->putAndInsertString(DCM_PatientID, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "Doe^Patient%u", patient);
+    dataset->putAndInsertString(DCM_PatientName, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "%s.%u.%u", SITE_STUDY_UID_ROOT ".99", patient, study);
+    dataset->putAndInsertString(DCM_StudyInstanceUID, buf);
+    dataset->putAndInsertString(DCM_StudyDate, "20260101");
+    dataset->putAndInsertString(DCM_StudyTime, "120000");
+    OFStandard::snprintf(buf, sizeof(buf), "%u", study);
+    dataset->putAndInsertString(DCM_StudyID, buf);
+    dataset->putAndInsertString(DCM_AccessionNumber, "");
+    dataset->putAndInsertString(DCM_StudyDescription, "DICOMDIR test");
+    OFStandard::snprintf(buf, sizeof(buf), "%s.%u.%u.%u", SITE_SERIES_UID_ROOT ".99", patient, study, series);
+    dataset->putAndInsertString(DCM_SeriesInstanceUID, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "%u", series + 1);
+    dataset->putAndInsertString(DCM_SeriesNumber, buf);
+    dataset->putAndInsertString(DCM_Modality, "OT");
+    dataset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dataset->putAndInsertString(DCM_SOPInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+    /* images are added in reverse order of their instance number */
+    OFStandard::snprintf(buf, sizeof(buf), "%u", NUM_IMAGES - image);
+    dataset->putAndInsertString(DCM_InstanceNumber, buf);
+    dataset->putAndInsertUint16(DCM_SamplesPerPixel, 1);
+    dataset->putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2");
+    dataset->putAndInsertUint16(DCM_Rows, 2);
+    dataset->putAndInsertUint16(DCM_Columns, 2);
+    dataset->putAndInsertUint16(DCM_BitsAllocated, 8);
+    dataset->putAndInsertUint16(DCM_BitsStored, 8);
+    dataset->putAndInsertUint16(DCM_HighBit, 7);
+    dataset->putAndInsertUint16(DCM_PixelRepresentation, 0);
+    dataset->putAndInsertUint8Array(DCM_PixelData, pixelData, 4);
+    return fileformat.saveFile(pathname, EXS_LittleEndianExplicit);
+}
+
+
+// get textual representation of the directory records of the given DICOMDIR file
+static OFString printRecords(const OFFilename &filename)
+{
+    OFOStringStream oss;
+    DcmDicomDir dicomdir(filename);
+    dicomdir.getRootRecord().print(oss);
+    oss << OFStringStream_ends;
+    OFSTRINGSTREAM_GETOFSTRING(oss, result)
+    return result;
+}
+
+
+// count records of the given type (recursively)
+static size_t countRecords(DcmDirectoryRecord *parent,
+                           const E_DirRecType recordType)
+{
+    size_t count = 0;
+    DcmDirectoryRecord *record = NULL;
+    while ((record = parent->nextSub(record)) != NULL)
+    {
+        if (record->getRecordType() == recordType)
+            ++count;
+        count += countRecords(record, recordType);
+    }
+    return count;
+}
+
+
+// check the number of records on each level of the given DICOMDIR file
+static void checkRecords(const OFFilename &filename,
+                         const size_t numFiles)
+{
+    DcmDicomDir dicomdir(filename);
+    DcmDirectoryRecord *root = &dicomdir.getRootRecord();
+    OFCHECK_EQUAL(countRecords(root, ERT_Patient), NUM_PATIENTS);
+    OFCHECK_EQUAL(countRecords(root, ERT_Study), NUM_PATIENTS * NUM_STUDIES);
+    OFCHECK_EQUAL(countRecords(root, ERT_Series), NUM_PATIENTS * NUM_STUDIES * NUM_SERIES);
+    OFCHECK_EQUAL(countRecords(root, ERT_Image), numFiles);
+}
+
+
+OFTEST(dcmdata_dicomdirInterface_addDicomFiles)
+{
+    /* the record type is only recognized if padding is removed when reading */
+    const OFBool dataCorrection = dcmEnableAutomaticInputDataCorrection.get();
+    dcmEnableAutomaticInputDataCorrection.set(OFTrue);
+    OFString tempPath;
+    OFTempFile::getTempPath(tempPath);
+    const OFFilename directory(tempPath);
+    OFList<OFFilename> filenames;
+    OFList<OFFilename> pathnames;
+    unsigned int number = 0;
+    /* create the DICOM files */
+    for (unsigned int patient = 0; patient < NUM_PATIENTS; ++patient)
+    {
+        for (unsigned int study = 0; study < NUM_STUDIES; ++study)
+        {
+            for (unsigned int series = 0; series < NUM_SERIES; ++series)
+            {
+                for (unsigned int image = 0; image < NUM_IMAGES; ++image)
+                {
+                    const OFFilename filename(makeFilename(number++));
+                    OFFilename pathname;
+                    OFStandard::combineDirAndFilename(pathname, directory, filename);
+                    OFCHECK(createImage(pathname, patient, study, series, image).good());
+                    filenames.push_back(filename);
+                    pathnames.push_back(pathname);
+                }
+            }
+        }
+    }
+    const size_t numFiles = filenames.size();
+    OFFilename dicomdir1, dicomdir2, dicomdir3;
+    OFStandard::combineDirAndFilename(dicomdir1, directory, makeFilename(900));
+    OFStandard::combineDirAndFilename(dicomdir2, directory, makeFilename(901));
+    OFStandard::combineDirAndFilename(dicomdir3, directory, makeFilename(902));
+
+    /* add the files one after the other */
+    DicomDirInterface ddir1;
+    ddir1.disableBackupMode();
+    OFCHECK(ddir1.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir1, "TEST").good());
+    OFListIterator(OFFilename) iter = filenames.begin();
+    while (iter != filenames.end())
+        OFCHECK(ddir1.addDicomFile(*iter++, directory).good());
+    /* adding the same file again should not create another record */
+    OFCHECK(ddir1.addDicomFile(filenames.front(), directory).good());
+    OFCHECK(ddir1.writeDicomDir().good());
+    const OFString expected = printRecords(dicomdir1);
+    checkRecords(dicomdir1, numFiles);
+
+    /* add the files by multiple threads, the result should be the same */
+    DicomDirInterface ddir2;
+    ddir2.disableBackupMode();
+    OFList<OFFilename> badFiles;
+    OFCHECK(ddir2.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir2, "TEST").good());
+    OFCHECK(ddir2.addDicomFiles(filenames, directory, badFiles, 4).good());
+    OFCHECK(badFiles.empty());
+    OFCHECK(ddir2.writeDicomDir().good());
+    OFCHECK_EQUAL(printRecords(dicomdir2), expected);
+
+    /* create a DICOMDIR with the first half of the files and append the second half */
+    OFList<OFFilename> firstHalf, secondHalf;
+    iter = filenames.begin();
+    for (size_t i = 0; i < numFiles; ++i)
+    {
+        if (i < numFiles / 2)
+            firstHalf.push_back(*iter++);
+        else
+            secondHalf.push_back(*iter++);
+    }
+    /* a file that does not exist is reported as bad */
+    secondHalf.push_back(makeFilename(999));
+    DicomDirInterface ddir3;
+    ddir3.disableBackupMode();
+    OFCHECK(ddir3.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir3, "TEST").good());
+    OFCHECK(ddir3.addDicomFiles(firstHalf, directory, badFiles).good());
+    OFCHECK(badFiles.empty());
+    OFCHECK(ddir3.writeDicomDir().good());
+    OFCHECK(ddir3.appendToDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir3).good());
+    OFCHECK(ddir3.addDicomFiles(secondHalf, directory, badFiles, 2).good());
+    OFCHECK_EQUAL(badFiles.size(), 1);
+    OFCHECK(ddir3.writeDicomDir().good());
+    checkRecords(dicomdir3, numFiles);
+
+    /* clean up */
+    iter = pathnames.begin();
+    while (iter != pathnames.end())
+        OFStandard::deleteFile(*iter++);
+    OFStandard::deleteFile(dicomdir1);
+    OFStandard::deleteFile(dicomdir2);
+    OFStandard::deleteFile(dicomdir3);
+    dcmEnableAutomaticInputDataCorrection.set(dataCorrection);
+}
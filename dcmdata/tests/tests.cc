@@ -24,6 +24,8 @@
 #include "dcmtk/ofstd/oftest.h"
 
 OFTEST_REGISTER(dcmdata_partialElementAccess);
+OFTEST_REGISTER(dcmdata_lazyLoadFileCache);
+OFTEST_REGISTER(dcmdata_lazyLoadMemoryBudget);
 OFTEST_REGISTER(dcmdata_i2d_bmp);
 OFTEST_REGISTER(dcmdata_checkStringValue);
 OFTEST_REGISTER(dcmdata_determineVM);
@@ -34,8 +36,11 @@ OFTEST_REGISTER(dcmdata_decimalString_1);
 OFTEST_REGISTER(dcmdata_decimalString_2);
 OFTEST_REGISTER(dcmdata_decimalString_3);
 OFTEST_REGISTER(dcmdata_decimalString_4);
+OFTEST_REGISTER(dcmdata_decimalString_5);
 OFTEST_REGISTER(dcmdata_decimalString_putFloat64);
+OFTEST_REGISTER(dcmdata_integerString);
 OFTEST_REGISTER(dcmdata_floatingPointDouble);
+OFTEST_REGISTER(dcmdata_floatingPointDouble_writeShortest);
 OFTEST_REGISTER(dcmdata_personName);
 OFTEST_REGISTER(dcmdata_uniqueIdentifier_1);
 OFTEST_REGISTER(dcmdata_uniqueIdentifier_2);
@@ -120,4 +125,14 @@ OFTEST_REGISTER(dcmdata_attribute_filter);
 OFTEST_REGISTER(dcmdata_attribute_matching);
 OFTEST_REGISTER(dcmdata_newDicomElementPrivate);
 OFTEST_REGISTER(dcmdata_generateUniqueIdentifier);
+OFTEST_REGISTER(dcmdata_dicomdirInterface_addDicomFiles);
+OFTEST_REGISTER(dcmdata_outputFileStream_bufferSize);
+OFTEST_REGISTER(dcmdata_outputFileStream_durable);
+OFTEST_REGISTER(dcmdata_outputFileStream_durableLazyLoad);
+OFTEST_REGISTER(dcmdata_attributeProjection_addPath);
+OFTEST_REGISTER(dcmdata_attributeProjection_loadFile);
+OFTEST_REGISTER(dcmdata_attributeExtractor_addColumn);
+OFTEST_REGISTER(dcmdata_attributeExtractor_extract);
+OFTEST_REGISTER(dcmdata_inputBufferStreamFactory_roundTrip);
+OFTEST_REGISTER(dcmdata_inputBufferStreamFactory_partialValue);
 OFTEST_MAIN("dcmdata")
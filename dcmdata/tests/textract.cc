@@ -0,0 +1,296 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DcmAttributeExtractor
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcextrac.h"
+
+// number of DICOM files created for the test
+#define NUM_FILES 5
+
+
+// create a filename in the temporary directory that is unique for this process
+static OFFilename makeFilename(const unsigned int number)
+{
+    OFString tempPath;
+    OFTempFile::getTempPath(tempPath);
+    char buf[64];
+    OFStandard::snprintf(buf, sizeof(buf), "extract_%lu_%u.dcm", OFstatic_cast(unsigned long, OFStandard::getProcessID()), number);
+    OFFilename filename;
+    OFStandard::combineDirAndFilename(filename, tempPath, buf);
+    return filename;
+}
+
+
+// create a DICOM file with some attributes depending on the given number
+static OFCondition createFile(const OFFilename &filename,
+                              const unsigned int number)
+{
+    char buf[64];
+    DcmFileFormat fileformat;
+    DcmDataset *dataset = fileformat.getDataset();
+    dataset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.4.0.%u", number);
+    dataset->putAndInsertString(DCM_SOPInstanceUID, buf);
+    /* the first file has no patient name, the second one a name with a comma */
+    if (number == 1)
+        dataset->putAndInsertString(DCM_PatientName, "Doe, John");
+    else if (number > 1)
+        dataset->putAndInsertString(DCM_PatientName, "Doe^John");
+    /* the last file has a patient ID that is not a number */
+    dataset->putAndInsertString(DCM_PatientID, (number == NUM_FILES - 1) ? "ABC" : "12345");
+    dataset->putAndInsertString(DCM_SliceThickness, "2.5");
+    OFStandard::snprintf(buf, sizeof(buf), "%u", number + 1);
+    dataset->putAndInsertString(DCM_InstanceNumber, buf);
+    dataset->putAndInsertString(DCM_ImageType, "ORIGINAL\\PRIMARY");
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        DcmItem *item = NULL;
+        if (dataset->findOrCreateSequenceItem(DCM_ReferencedSeriesSequence, item, -2 /*append*/).good())
+        {
+            OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.3.%u.%u", number, i);
+            item->putAndInsertString(DCM_SeriesInstanceUID, buf);
+            /* only the second item has a retrieve AE title */
+            if (i == 1)
+                item->putAndInsertString(DCM_RetrieveAETitle, "ARCHIVE");
+        }
+    }
+    dataset->putAndInsertUint16(DCM_Rows, 16);
+    dataset->putAndInsertUint16(DCM_Columns, 16);
+    Uint8 pixelData[256];
+    memset(pixelData, OFstatic_cast(int, number), sizeof(pixelData));
+    dataset->putAndInsertUint8Array(DCM_PixelData, pixelData, sizeof(pixelData));
+    return fileformat.saveFile(filename, EXS_LittleEndianExplicit);
+}
+
+
+// add the columns used for the test to the given extractor
+static void addColumns(DcmAttributeExtractor &extractor)
+{
+    OFCHECK(extractor.addColumn("PatientName").good());
+    OFCHECK(extractor.addColumn("(0020,0013)", "InstanceNumber").good());
+    OFCHECK(extractor.addColumn("SliceThickness").good());
+    OFCHECK(extractor.addColumn("Rows").good());
+    OFCHECK(extractor.addColumn("ImageType").good());
+    OFCHECK(extractor.addColumn("PatientID", "PatientID", ECL_integer).good());
+    OFCHECK(extractor.addColumn("ReferencedSeriesSequence[*].RetrieveAETitle", "AETitle").good());
+    OFCHECK(extractor.addColumn("ReferencedSeriesSequence[1].SeriesInstanceUID", "SeriesUID").good());
+    OFCHECK(extractor.addColumn("MediaStorageSOPClassUID").good());
+}
+
+
+// extract the columns from the given files and return the output as a string
+static OFString extractToString(DcmAttributeExtractor &extractor,
+                                const OFList<OFFilename> &filenames,
+                                const OFBool binary,
+                                size_t &numberOfBadFiles)
+{
+    OFOStringStream oss;
+    OFList<OFFilename> badFiles;
+    if (binary)
+    {
+        DcmExtractionBinaryWriter writer(oss);
+        OFCHECK(extractor.extract(filenames, writer, badFiles).good());
+    } else {
+        DcmExtractionCSVWriter writer(oss);
+        OFCHECK(extractor.extract(filenames, writer, badFiles).good());
+    }
+    numberOfBadFiles = badFiles.size();
+    OFSTRINGSTREAM_GETOFSTRING(oss, result)
+    return result;
+}
+
+
+// read an unsigned 32-bit integer in little endian byte order from the given position
+static Uint32 readUint32(const OFString &data,
+                         size_t &pos)
+{
+    Uint32 value = 0;
+    if (pos + 4 <= data.length())
+    {
+        for (int i = 3; i >= 0; --i)
+            value = (value << 8) | OFstatic_cast(unsigned char, data[pos + i]);
+    }
+    pos += 4;
+    return value;
+}
+
+
+// skip an array of strings and return the first string
+static OFString skipStrings(const OFString &data,
+                            size_t &pos,
+                            const size_t numberOfRows)
+{
+    const size_t start = pos;
+    const Uint32 first = readUint32(data, pos);
+    const Uint32 second = readUint32(data, pos);
+    pos = start + 4 * numberOfRows;
+    const Uint32 total = readUint32(data, pos);
+    OFString value = (pos + second <= data.length()) ? data.substr(pos + first, second - first) : "";
+    pos += total;
+    return value;
+}
+
+
+OFTEST(dcmdata_attributeExtractor_addColumn)
+{
+    DcmAttributeExtractor extractor;
+    OFCHECK(extractor.addColumn("").bad());
+    OFCHECK(extractor.addColumn("UnknownAttributeName").bad());
+    OFCHECK(extractor.addColumn("ReferencedSeriesSequence[0]").bad());
+    OFCHECK(extractor.addColumn("ReferencedSeriesSequence[x].SeriesInstanceUID").bad());
+    OFCHECK_EQUAL(extractor.getNumberOfColumns(), 0);
+    addColumns(extractor);
+    OFCHECK_EQUAL(extractor.getNumberOfColumns(), 9);
+    /* the type is derived from the value representation */
+    OFCHECK_EQUAL(extractor.getColumnType(0), ECL_string);
+    OFCHECK_EQUAL(extractor.getColumnType(1), ECL_integer);
+    OFCHECK_EQUAL(extractor.getColumnType(2), ECL_float);
+    OFCHECK_EQUAL(extractor.getColumnType(3), ECL_integer);
+    OFCHECK_EQUAL(extractor.getColumnType(4), ECL_string);
+    OFCHECK_EQUAL(extractor.getColumnType(5), ECL_integer);
+    OFCHECK_EQUAL(extractor.getColumnType(9), ECL_auto);
+    /* the path is used if no name is given */
+    OFCHECK_EQUAL(extractor.getColumnName(0), "PatientName");
+    OFCHECK_EQUAL(extractor.getColumnName(1), "InstanceNumber");
+    OFCHECK_EQUAL(extractor.getColumnName(9), "");
+    extractor.clear();
+    OFCHECK_EQUAL(extractor.getNumberOfColumns(), 0);
+}
+
+
+OFTEST(dcmdata_attributeExtractor_extract)
+{
+    OFList<OFFilename> filenames;
+    for (unsigned int i = 0; i < NUM_FILES; ++i)
+    {
+        const OFFilename filename = makeFilename(i);
+        OFCHECK(createFile(filename, i).good());
+        filenames.push_back(filename);
+    }
+
+    /* extract the values from a single file */
+    DcmAttributeExtractor extractor;
+    addColumns(extractor);
+    DcmExtractionBatch batch;
+    OFCHECK(extractor.extractFile(makeFilename(1), batch).good());
+    OFCHECK(extractor.extractFile(makeFilename(NUM_FILES - 1), batch).good());
+    OFCHECK(extractor.extractFile(makeFilename(NUM_FILES), batch).bad());
+    OFCHECK_EQUAL(batch.getNumberOfRows(), 2);
+    OFCHECK_EQUAL(batch.getNumberOfColumns(), 9);
+    OFCHECK_EQUAL(OFString(batch.getFilename(0).getCharPointer()), makeFilename(1).getCharPointer());
+    OFCHECK_EQUAL(batch.getString(0, 0), "Doe, John");
+    OFCHECK_EQUAL(batch.getInteger(0, 1), 2);
+    OFCHECK_EQUAL(batch.getFloat(0, 2), 2.5);
+    OFCHECK_EQUAL(batch.getInteger(0, 3), 16);
+    OFCHECK_EQUAL(batch.getString(0, 4), "ORIGINAL\\PRIMARY");
+    OFCHECK_EQUAL(batch.getInteger(0, 5), 12345);
+    OFCHECK_EQUAL(batch.getString(0, 6), "ARCHIVE");
+    OFCHECK_EQUAL(batch.getString(0, 7), "1.2.276.0.7230010.3.1.3.1.1");
+    OFCHECK_EQUAL(batch.getString(0, 8), UID_SecondaryCaptureImageStorage);
+    /* a value that cannot be converted is null */
+    OFCHECK(!batch.isNull(0, 5));
+    OFCHECK(batch.isNull(1, 5));
+    OFCHECK(batch.isNull(5, 0));
+    OFCHECK(batch.isNull(0, 9));
+
+    /* loading the complete files gives the same result as the projection */
+    filenames.push_back(makeFilename(NUM_FILES));
+    size_t numberOfBadFiles = 0;
+    const OFString expected = extractToString(extractor, filenames, OFFalse /*binary*/, numberOfBadFiles);
+    OFCHECK_EQUAL(numberOfBadFiles, 1);
+    extractor.setProjectionMode(OFFalse);
+    OFCHECK_EQUAL(extractToString(extractor, filenames, OFFalse /*binary*/, numberOfBadFiles), expected);
+    extractor.setProjectionMode(OFTrue);
+    /* multiple threads and small batches give the same result */
+    extractor.setNumberOfThreads(3);
+    extractor.setBatchSize(2);
+    OFCHECK_EQUAL(extractToString(extractor, filenames, OFFalse /*binary*/, numberOfBadFiles), expected);
+    OFCHECK_EQUAL(numberOfBadFiles, 1);
+
+    /* check the CSV output (header and one line per file) */
+    const size_t eol = expected.find("\r\n");
+    OFCHECK_EQUAL(expected.substr(0, eol), "Filename,PatientName,InstanceNumber,SliceThickness,Rows,ImageType,PatientID,AETitle,SeriesUID,MediaStorageSOPClassUID");
+    size_t lines = 0;
+    size_t pos = 0;
+    while ((pos = expected.find("\r\n", pos)) != OFString_npos)
+    {
+        ++lines;
+        pos += 2;
+    }
+    OFCHECK_EQUAL(lines, NUM_FILES + 1);
+    OFString line = OFString(makeFilename(1).getCharPointer()) + ",\"Doe, John\",2,2.5,16,ORIGINAL\\PRIMARY,12345,ARCHIVE,1.2.276.0.7230010.3.1.3.1.1," UID_SecondaryCaptureImageStorage "\r\n";
+    OFCHECK(expected.find(line) != OFString_npos);
+    line = OFString(makeFilename(0).getCharPointer()) + ",,1,";
+    OFCHECK(expected.find(line) != OFString_npos);
+    line = OFString(makeFilename(NUM_FILES - 1).getCharPointer()) + ",Doe^John,5,2.5,16,ORIGINAL\\PRIMARY,,ARCHIVE,";
+    OFCHECK(expected.find(line) != OFString_npos);
+
+    /* check the structure of the binary output */
+    const OFString binary = extractToString(extractor, filenames, OFTrue /*binary*/, numberOfBadFiles);
+    OFCHECK_EQUAL(numberOfBadFiles, 1);
+    OFCHECK(binary.compare(0, 8, OFString("DCMCOL1\0", 8)) == 0);
+    pos = 8;
+    const Uint32 numberOfColumns = readUint32(binary, pos);
+    OFCHECK_EQUAL(numberOfColumns, 9);
+    OFVector<E_ColumnType> types;
+    for (Uint32 i = 0; (i < numberOfColumns) && (pos < binary.length()); ++i)
+    {
+        types.push_back(OFstatic_cast(E_ColumnType, binary[pos++]));
+        const Uint32 length = readUint32(binary, pos);
+        OFCHECK_EQUAL(binary.substr(pos, length), extractor.getColumnName(i));
+        pos += length;
+    }
+    size_t totalRows = 0;
+    OFString firstFilename;
+    while (pos < binary.length())
+    {
+        const Uint32 numberOfRows = readUint32(binary, pos);
+        if (numberOfRows == 0)
+            break;
+        OFCHECK(numberOfRows <= 2);
+        if (totalRows == 0)
+            firstFilename = skipStrings(binary, pos, numberOfRows);
+        else
+            skipStrings(binary, pos, numberOfRows);
+        for (size_t i = 0; i < types.size(); ++i)
+        {
+            pos += (numberOfRows + 7) / 8;
+            if (types[i] == ECL_string)
+                skipStrings(binary, pos, numberOfRows);
+            else
+                pos += 8 * numberOfRows;
+        }
+        totalRows += numberOfRows;
+    }
+    OFCHECK_EQUAL(totalRows, NUM_FILES);
+    OFCHECK_EQUAL(pos, binary.length());
+    OFCHECK_EQUAL(firstFilename, makeFilename(0).getCharPointer());
+
+    /* clean up */
+    for (unsigned int j = 0; j < NUM_FILES; ++j)
+        OFStandard::deleteFile(makeFilename(j));
+}
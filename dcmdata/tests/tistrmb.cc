@@ -0,0 +1,129 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DcmInputBufferStreamFactory
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcistrmb.h"
+
+/* large enough to be written in more than one block by the write cache */
+#define NUM_VALUES 100000
+
+
+// create an element that references the given buffer instead of copying it
+static DcmOtherFloat *createElement(const Float32 *values, const size_t bufferCount, const size_t valueCount)
+{
+    DcmOtherFloat *elem = new DcmOtherFloat(DCM_PointCoordinatesData);
+    const Uint32 numBytes = OFstatic_cast(Uint32, valueCount * sizeof(Float32));
+    OFCHECK(elem->createValueFromTempFile(new DcmInputBufferStreamFactory(values, bufferCount * sizeof(Float32)), numBytes, gLocalByteOrder).good());
+    return elem;
+}
+
+
+// check that the element has the given values
+static void checkValues(DcmElement &elem, const Float32 *values, const size_t count)
+{
+    Float32 *data = NULL;
+    OFCHECK(elem.getFloat32Array(data).good());
+    OFCHECK_EQUAL(elem.getLength(), count * sizeof(Float32));
+    OFCHECK(data != NULL);
+    if (data != NULL)
+    {
+        size_t i = 0;
+        while ((i < count) && (data[i] == values[i]))
+            ++i;
+        OFCHECK_EQUAL(i, count);
+    }
+}
+
+
+OFTEST(dcmdata_inputBufferStreamFactory_roundTrip)
+{
+    Float32 *values = new Float32[NUM_VALUES];
+    for (size_t i = 0; i < NUM_VALUES; i++)
+        values[i] = OFstatic_cast(Float32, i) * 0.5f;
+
+    // write the referenced value block by block, the value is not loaded into the dataset
+    DcmFileFormat fileformat;
+    DcmOtherFloat *elem = createElement(values, NUM_VALUES, NUM_VALUES);
+    OFCHECK(fileformat.getDataset()->insert(elem).good());
+    OFCHECK(!elem->valueLoaded());
+    OFTempFile tempFile(O_RDWR, "", "tistrmb", ".dcm");
+    OFCHECK(tempFile.getStatus().good());
+    OFCHECK(fileformat.saveFile(tempFile.getFilename(), EXS_LittleEndianExplicit).good());
+    OFCHECK(!elem->valueLoaded());
+
+    // read the file and compare the values
+    DcmFileFormat loaded;
+    OFCHECK(loaded.loadFile(tempFile.getFilename()).good());
+    DcmElement *loadedElem = NULL;
+    OFCHECK(loaded.getDataset()->findAndGetElement(DCM_PointCoordinatesData, loadedElem).good());
+    if (loadedElem != NULL)
+        checkValues(*loadedElem, values, NUM_VALUES);
+
+    // a copy of the element reads from the same buffer
+    DcmOtherFloat copy(*elem);
+    checkValues(copy, values, NUM_VALUES);
+    checkValues(*elem, values, NUM_VALUES);
+    delete[] values;
+}
+
+
+OFTEST(dcmdata_inputBufferStreamFactory_partialValue)
+{
+    Float32 values[NUM_VALUES / 100];
+    const size_t count = NUM_VALUES / 100;
+    for (size_t i = 0; i < count; i++)
+        values[i] = OFstatic_cast(Float32, i) + 0.25f;
+    const Uint32 length = OFstatic_cast(Uint32, count * sizeof(Float32));
+    Float32 value = 0;
+
+    // partial access at the start and at the very end of the value
+    DcmOtherFloat *elem = createElement(values, count, count);
+    OFCHECK(elem->getPartialValue(&value, 0, sizeof(Float32)).good());
+    OFCHECK_EQUAL(value, values[0]);
+    OFCHECK(elem->getPartialValue(&value, length - sizeof(Float32), sizeof(Float32)).good());
+    OFCHECK_EQUAL(value, values[count - 1]);
+    OFCHECK(!elem->valueLoaded());
+
+    // offset and length beyond the end of the value
+    OFCHECK(elem->getPartialValue(&value, length, sizeof(Float32)) == EC_InvalidOffset);
+    OFCHECK(elem->getPartialValue(&value, length - 2, sizeof(Float32)) == EC_TooManyBytesRequested);
+    delete elem;
+
+    // value shorter than the buffer, only the beginning of the buffer is used
+    elem = createElement(values, count, count / 2);
+    OFCHECK_EQUAL(elem->getLength(), length / 2);
+    OFCHECK(elem->getPartialValue(&value, length / 2 - sizeof(Float32), sizeof(Float32)).good());
+    OFCHECK_EQUAL(value, values[count / 2 - 1]);
+    OFCHECK(elem->getPartialValue(&value, length / 2, sizeof(Float32)) == EC_InvalidOffset);
+    checkValues(*elem, values, count / 2);
+    delete elem;
+
+    // odd length is rejected
+    DcmOtherFloat odd(DCM_PointCoordinatesData);
+    DcmInputStreamFactory *factory = new DcmInputBufferStreamFactory(values, length);
+    OFCHECK(odd.createValueFromTempFile(factory, 3, gLocalByteOrder) == EC_IllegalCall);
+    delete factory;
+}
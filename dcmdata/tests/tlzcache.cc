@@ -0,0 +1,193 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for DcmLazyLoadCache
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dclzcach.h"
+#include "dcmtk/dcmdata/dcfcache.h"
+
+#define VALUESIZE 16384
+
+static const DcmTagKey testTags[3] = { DCM_EncapsulatedDocument, DCM_OverlayData, DCM_ICCProfile };
+
+static Uint8 testValue(size_t tag, size_t i)
+{
+  return OFstatic_cast(Uint8, (tag * 31 + i * 7) & 0xFF);
+}
+
+/* create a file with three large attribute values and load it again
+ * without loading these values
+ */
+static OFBool createAndLoadTestFile(const char *filename, DcmFileFormat &dfile)
+{
+  DcmFileFormat outfile;
+  DcmDataset *dset = outfile.getDataset();
+  Uint8 *buffer = new Uint8[VALUESIZE];
+  for (size_t t = 0; t < 3; ++t)
+  {
+    for (size_t i = 0; i < VALUESIZE; ++i) buffer[i] = testValue(t, i);
+    DcmOtherByteOtherWord *elem = new DcmOtherByteOtherWord(DcmTag(testTags[t], EVR_OB));
+    elem->putUint8Array(buffer, VALUESIZE);
+    dset->insert(elem);
+  }
+  delete[] buffer;
+  OFCondition cond = outfile.saveFile(filename, EXS_LittleEndianExplicit);
+  if (cond.good()) cond = dfile.loadFile(filename, EXS_Unknown, EGL_noChange, 1024);
+  OFCHECK(cond.good());
+  return cond.good();
+}
+
+static OFBool checkValue(DcmDataset *dset, size_t t)
+{
+  const Uint8 *value = NULL;
+  unsigned long count = 0;
+  OFCondition cond = dset->findAndGetUint8Array(testTags[t], value, &count);
+  if (cond.bad() || value == NULL || count != VALUESIZE) return OFFalse;
+  for (size_t i = 0; i < VALUESIZE; ++i)
+  {
+    if (value[i] != testValue(t, i)) return OFFalse;
+  }
+  return OFTrue;
+}
+
+static OFBool isLoaded(DcmDataset *dset, size_t t)
+{
+  DcmElement *elem = NULL;
+  return dset->findAndGetElement(testTags[t], elem).good() && elem->valueLoaded();
+}
+
+OFTEST(dcmdata_lazyLoadFileCache)
+{
+  DcmFileFormat dfile;
+  if (!createAndLoadTestFile("tlzcache_1.dcm", dfile)) return;
+  DcmDataset *dset = dfile.getDataset();
+  OFCHECK(!isLoaded(dset, 0));
+
+  DcmLazyLoadCache::setMaxOpenFiles(4);
+  DcmLazyLoadCache::setReadAheadSize(4096);
+  OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 0);
+
+  // all values are read through a single cached file handle
+  for (size_t t = 0; t < 3; ++t)
+  {
+    OFCHECK(checkValue(dset, t));
+    OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 1);
+  }
+
+  // partial reads are served from the read-ahead buffer
+  DcmElement *elem = NULL;
+  DcmFileCache fcache;
+  Uint8 partial[100];
+  OFCHECK(dset->findAndGetElement(DCM_OverlayData, elem).good());
+  elem->compact();
+  OFCHECK(!elem->valueLoaded());
+  for (Uint32 offset = 0; offset + sizeof(partial) <= VALUESIZE; offset += 1000)
+  {
+    OFCHECK(elem->getPartialValue(partial, offset, sizeof(partial), &fcache).good());
+    OFCHECK(partial[0] == testValue(1, offset) && partial[sizeof(partial) - 1] == testValue(1, offset + sizeof(partial) - 1));
+  }
+  fcache.clear();
+  OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 1);
+
+  // writing the file closes the cached handle
+  dfile.loadAllDataIntoMemory();
+  OFCHECK(dfile.saveFile("tlzcache_1.dcm", EXS_LittleEndianExplicit).good());
+  OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 0);
+
+  // disabling the cache closes all handles
+  DcmFileFormat dfile2;
+  OFCHECK(dfile2.loadFile("tlzcache_1.dcm", EXS_Unknown, EGL_noChange, 1024).good());
+  OFCHECK(checkValue(dfile2.getDataset(), 2));
+  OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 1);
+  DcmLazyLoadCache::setMaxOpenFiles(0);
+  OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 0);
+  OFCHECK(checkValue(dfile2.getDataset(), 2));
+
+  OFStandard::deleteFile("tlzcache_1.dcm");
+}
+
+OFTEST(dcmdata_lazyLoadMemoryBudget)
+{
+  DcmFileFormat dfile;
+  if (!createAndLoadTestFile("tlzcache_2.dcm", dfile)) return;
+  DcmDataset *dset = dfile.getDataset();
+  DcmElement *elem[3];
+  for (size_t t = 0; t < 3; ++t)
+    OFCHECK(dset->findAndGetElement(testTags[t], elem[t]).good());
+
+  // budget allows for one value only
+  dfile.setMemoryBudget(VALUESIZE + VALUESIZE / 2);
+  OFCHECK(checkValue(dset, 0));
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), VALUESIZE);
+
+  // values in use are never removed from memory
+  OFCHECK(checkValue(dset, 1));
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), 2 * VALUESIZE);
+  OFCHECK(isLoaded(dset, 0));
+  OFCHECK(isLoaded(dset, 1));
+
+  // released values are removed if the budget is exceeded
+  elem[0]->releaseValue();
+  OFCHECK(!isLoaded(dset, 0));
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), VALUESIZE);
+  elem[1]->releaseValue();
+  OFCHECK(isLoaded(dset, 1));
+
+  // released values are loaded again from file
+  OFCHECK(checkValue(dset, 0));
+  OFCHECK(isLoaded(dset, 0));
+  OFCHECK(!isLoaded(dset, 1));
+
+  // values accessed again after release are in use
+  elem[0]->releaseValue();
+  OFCHECK(checkValue(dset, 0));
+  OFCHECK(checkValue(dset, 1));
+  OFCHECK(isLoaded(dset, 0));
+  OFCHECK(isLoaded(dset, 1));
+  elem[0]->releaseValue();
+  elem[1]->releaseValue();
+  OFCHECK(!isLoaded(dset, 0));
+  OFCHECK(isLoaded(dset, 1));
+
+  // modified values are no longer subject to the budget
+  Uint8 newValue[4] = { 1, 2, 3, 4 };
+  OFCHECK(elem[1]->putUint8Array(newValue, 4).good());
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), 0);
+  OFCHECK(checkValue(dset, 2));
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), VALUESIZE);
+
+  // the budget is restricted to its own file format
+  DcmFileFormat dfile2;
+  OFCHECK(dfile2.loadFile("tlzcache_2.dcm", EXS_Unknown, EGL_noChange, 1024).good());
+  OFCHECK(checkValue(dfile2.getDataset(), 0));
+  OFCHECK_EQUAL(dfile2.getLoadedBytes(), 0);
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), VALUESIZE);
+
+  // deleting a dataset removes its values from the budget
+  dset->clear();
+  OFCHECK_EQUAL(dfile.getLoadedBytes(), 0);
+
+  dfile.setMemoryBudget(0);
+  OFStandard::deleteFile("tlzcache_2.dcm");
+}
@@ -0,0 +1,218 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DcmOutputFileStream
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcostrmf.h"
+#include "dcmtk/dcmdata/dclzcach.h"
+
+#define VALUESIZE 100000
+
+
+// create a filename in the temporary directory that is unique for this process
+static OFFilename makeFilename(const char *name)
+{
+    OFString tempPath;
+    OFTempFile::getTempPath(tempPath);
+    char buf[64];
+    OFStandard::snprintf(buf, sizeof(buf), "%s_%lu.dcm", name, OFstatic_cast(unsigned long, OFStandard::getProcessID()));
+    OFFilename filename;
+    OFStandard::combineDirAndFilename(filename, tempPath, buf);
+    return filename;
+}
+
+
+// count the temporary files that have been left behind for the given file
+static size_t countTemporaryFiles(const OFFilename &filename)
+{
+    OFFilename dirName, baseName, pattern;
+    OFStandard::getDirNameFromPath(dirName, filename);
+    OFStandard::getFilenameFromPath(baseName, filename);
+    OFStandard::appendFilenameExtension(pattern, baseName, ".*.tmp");
+    OFList<OFFilename> fileList;
+    return OFStandard::searchDirectoryRecursively(dirName, fileList, pattern, OFFilename(), OFFalse /*recurse*/);
+}
+
+
+// create a data set with a large value and save it to the given file
+static OFCondition createFile(const OFFilename &filename,
+                              const char *patientName)
+{
+    DcmFileFormat fileformat;
+    DcmDataset *dataset = fileformat.getDataset();
+    Uint8 *buffer = new Uint8[VALUESIZE];
+    for (size_t i = 0; i < VALUESIZE; ++i)
+        buffer[i] = OFstatic_cast(Uint8, i & 0xff);
+    dataset->putAndInsertString(DCM_SOPClassUID, UID_EncapsulatedPDFStorage);
+    dataset->putAndInsertString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.0.1");
+    dataset->putAndInsertString(DCM_PatientName, patientName);
+    dataset->putAndInsertUint8Array(DCM_EncapsulatedDocument, buffer, VALUESIZE);
+    delete[] buffer;
+    return fileformat.saveFile(filename, EXS_LittleEndianExplicit);
+}
+
+
+// load the given file and check its content
+static void checkFile(const OFFilename &filename,
+                      const char *patientName,
+                      const Uint32 maxReadLength = DCM_MaxReadLength)
+{
+    DcmFileFormat fileformat;
+    OFCHECK(fileformat.loadFile(filename, EXS_Unknown, EGL_noChange, maxReadLength).good());
+    DcmDataset *dataset = fileformat.getDataset();
+    OFString value;
+    OFCHECK(dataset->findAndGetOFString(DCM_PatientName, value).good());
+    OFCHECK_EQUAL(value, patientName);
+    const Uint8 *data = NULL;
+    unsigned long count = 0;
+    OFCHECK(dataset->findAndGetUint8Array(DCM_EncapsulatedDocument, data, &count).good());
+    OFCHECK_EQUAL(count, VALUESIZE);
+    if ((data != NULL) && (count == VALUESIZE))
+    {
+        size_t mismatch = 0;
+        for (size_t i = 0; i < VALUESIZE; ++i)
+        {
+            if (data[i] != OFstatic_cast(Uint8, i & 0xff))
+                ++mismatch;
+        }
+        OFCHECK_EQUAL(mismatch, 0);
+    }
+}
+
+
+OFTEST(dcmdata_outputFileStream_bufferSize)
+{
+    const Uint32 bufferSize = dcmFileWriteBufferSize.get();
+    dcmFileWriteBufferSize.set(1024 * 1024);
+    const OFFilename filename = makeFilename("ostrmf_buffer");
+    OFCHECK(createFile(filename, "Doe^John").good());
+    checkFile(filename, "Doe^John");
+
+    /* the file is complete as soon as the stream has been closed */
+    const char data[] = "0123456789";
+    DcmOutputFileStream stream(filename);
+    OFCHECK(stream.good());
+    OFCHECK_EQUAL(stream.write(data, 10), 10);
+    OFCHECK(stream.close().good());
+    OFCHECK_EQUAL(OFStandard::getFileSize(filename), 10);
+    /* closing again does no harm */
+    OFCHECK(stream.close().good());
+
+    OFStandard::deleteFile(filename);
+    dcmFileWriteBufferSize.set(bufferSize);
+}
+
+
+OFTEST(dcmdata_outputFileStream_durable)
+{
+    const OFBool durable = dcmDurableFileWrite.get();
+    dcmDurableFileWrite.set(OFTrue);
+    const OFFilename filename = makeFilename("ostrmf_durable");
+    OFStandard::deleteFile(filename);
+
+    /* the file is renamed to its final name when closed */
+    OFCHECK(createFile(filename, "Doe^John").good());
+    OFCHECK(OFStandard::fileExists(filename));
+    OFCHECK_EQUAL(countTemporaryFiles(filename), 0);
+    checkFile(filename, "Doe^John");
+
+    /* an existing file is replaced */
+    OFCHECK(createFile(filename, "Doe^Jane").good());
+    OFCHECK_EQUAL(countTemporaryFiles(filename), 0);
+    checkFile(filename, "Doe^Jane");
+    const size_t fileSize = OFStandard::getFileSize(filename);
+
+    /* the data is not visible under the final name before the stream is closed */
+    const char data[] = "0123456789";
+    {
+        DcmOutputFileStream stream(filename);
+        OFCHECK(stream.good());
+        /* preallocated space is released when the file is closed */
+        OFCHECK(stream.preallocate(VALUESIZE).good());
+        OFCHECK_EQUAL(stream.write(data, 10), 10);
+        stream.flush();
+        OFCHECK_EQUAL(OFStandard::getFileSize(filename), fileSize);
+        OFCHECK_EQUAL(countTemporaryFiles(filename), 1);
+        OFCHECK(stream.close().good());
+    }
+    OFCHECK_EQUAL(OFStandard::getFileSize(filename), 10);
+    OFCHECK_EQUAL(countTemporaryFiles(filename), 0);
+
+    /* discarded data leaves an existing file unchanged */
+    OFCHECK(createFile(filename, "Doe^Jane").good());
+    {
+        DcmOutputFileStream stream(filename);
+        OFCHECK(stream.good());
+        OFCHECK_EQUAL(stream.write(data, 10), 10);
+        OFCHECK(stream.close(OFTrue /*discard*/).good());
+    }
+    OFCHECK_EQUAL(countTemporaryFiles(filename), 0);
+    checkFile(filename, "Doe^Jane");
+
+    OFStandard::deleteFile(filename);
+    dcmDurableFileWrite.set(durable);
+}
+
+
+OFTEST(dcmdata_outputFileStream_durableLazyLoad)
+{
+    const OFBool durable = dcmDurableFileWrite.get();
+    const size_t maxOpenFiles = DcmLazyLoadCache::getMaxOpenFiles();
+    dcmDurableFileWrite.set(OFTrue);
+    DcmLazyLoadCache::setMaxOpenFiles(4);
+    const OFFilename filename = makeFilename("ostrmf_lazy");
+    OFCHECK(createFile(filename, "Doe^John").good());
+
+    /* load the large value on demand, which keeps a cached file handle */
+    DcmFileFormat fileformat;
+    OFCHECK(fileformat.loadFile(filename, EXS_Unknown, EGL_noChange, 1024).good());
+    DcmDataset *dataset = fileformat.getDataset();
+    DcmElement *element = NULL;
+    Uint8 *data = NULL;
+    OFCHECK(dataset->findAndGetElement(DCM_EncapsulatedDocument, element).good());
+    if (element != NULL)
+    {
+        OFCHECK(element->getUint8Array(data).good());
+        OFCHECK(DcmLazyLoadCache::getNumberOfOpenFiles() > 0);
+        element->compact();
+    }
+
+    /* save the modified data set to the same file. The large value is read from
+     * the original file while the new file is written, so the cache holds a
+     * handle to the original file until it is replaced.
+     */
+    OFCHECK(dataset->putAndInsertString(DCM_PatientName, "Doe^Jane Marie").good());
+    OFCHECK(fileformat.saveFile(filename, EXS_BigEndianExplicit).good());
+    OFCHECK_EQUAL(DcmLazyLoadCache::getNumberOfOpenFiles(), 0);
+    OFCHECK_EQUAL(countTemporaryFiles(filename), 0);
+
+    /* reloading the file reads the new content */
+    checkFile(filename, "Doe^Jane Marie", 1024);
+
+    OFStandard::deleteFile(filename);
+    DcmLazyLoadCache::setMaxOpenFiles(maxOpenFiles);
+    dcmDurableFileWrite.set(durable);
+}
@@ -0,0 +1,203 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DcmAttributeProjection
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcproj.h"
+
+#define PIXELSIZE 65536
+
+
+// create a test dataset with nested sequences, private data and pixel data
+static void createDataset(DcmDataset &dataset)
+{
+    dataset.putAndInsertString(DCM_SpecificCharacterSet, "ISO_IR 100");
+    dataset.putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dataset.putAndInsertString(DCM_SOPInstanceUID, "1.2.276.0.7230010.3.1.4.0.2");
+    dataset.putAndInsertString(DCM_PatientName, "Doe^John");
+    dataset.putAndInsertString(DCM_PatientID, "12345");
+    dataset.putAndInsertString(DCM_StudyInstanceUID, "1.2.276.0.7230010.3.1.2.0.2");
+    for (int i = 0; i < 2; ++i)
+    {
+        DcmItem *item = NULL;
+        char buf[64];
+        OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.3.0.%i", i);
+        if (dataset.findOrCreateSequenceItem(DCM_ReferencedSeriesSequence, item, -2 /*append*/).good())
+        {
+            item->putAndInsertString(DCM_SeriesInstanceUID, buf);
+            item->putAndInsertString(DCM_RetrieveAETitle, "ARCHIVE");
+            DcmItem *subItem = NULL;
+            if (item->findOrCreateSequenceItem(DCM_ReferencedInstanceSequence, subItem).good())
+            {
+                subItem->putAndInsertString(DCM_ReferencedSOPClassUID, UID_SecondaryCaptureImageStorage);
+                subItem->putAndInsertString(DCM_ReferencedSOPInstanceUID, "1.2.276.0.7230010.3.1.4.0.3");
+                subItem->putAndInsertString(DCM_ReferencedFrameNumber, "1");
+            }
+        }
+    }
+    /* private sequence that is never selected */
+    dataset.putAndInsertString(DcmTag(0x0029, 0x0010, EVR_LO), "OFFIS TEST");
+    DcmItem *privItem = NULL;
+    if (dataset.findOrCreateSequenceItem(DcmTag(DcmTagKey(0x0029, 0x1010), EVR_SQ), privItem).good())
+        privItem->putAndInsertString(DCM_ImageComments, "private");
+    dataset.putAndInsertUint16(DCM_Rows, 256);
+    dataset.putAndInsertUint16(DCM_Columns, 256);
+    Uint8 *pixelData = new Uint8[PIXELSIZE];
+    memset(pixelData, 0x55, PIXELSIZE);
+    dataset.putAndInsertUint8Array(DCM_PixelData, pixelData, PIXELSIZE);
+    delete[] pixelData;
+}
+
+
+// load the given file with a projection and check the result
+static void checkProjection(const OFFilename &filename,
+                            const OFBool selectTrailer)
+{
+    DcmAttributeProjection projection;
+    projection.addTag(DCM_PatientName);
+    OFCHECK(projection.addPath("(0020,000D)").good());
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[*].SeriesInstanceUID").good());
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[0].ReferencedInstanceSequence[0].ReferencedSOPInstanceUID").good());
+    OFCHECK_EQUAL(projection.getLastTag(), DCM_StudyInstanceUID);
+    /* if an attribute at the end of the dataset is selected, all elements have to be skipped */
+    if (selectTrailer)
+        projection.addTag(DCM_DataSetTrailingPadding);
+
+    DcmFileFormat fileformat;
+    OFCHECK(fileformat.loadFileProjection(filename, projection).good());
+    DcmDataset *dataset = fileformat.getDataset();
+    /* meta header is always read completely */
+    OFCHECK(fileformat.getMetaInfo()->tagExists(DCM_MediaStorageSOPInstanceUID));
+    /* selected attributes and those that are always needed */
+    OFCHECK(dataset->tagExists(DCM_SpecificCharacterSet));
+    OFCHECK(dataset->tagExists(DCM_PatientName));
+    OFCHECK(dataset->tagExists(DCM_StudyInstanceUID));
+    /* attributes that have not been selected */
+    OFCHECK(!dataset->tagExists(DCM_SOPInstanceUID));
+    OFCHECK(!dataset->tagExists(DCM_PatientID));
+    OFCHECK(!dataset->tagExists(DCM_Rows));
+    OFCHECK(!dataset->tagExists(DCM_PixelData));
+    OFCHECK(!dataset->tagExists(DcmTagKey(0x0029, 0x1010)));
+    /* only the selected attributes are read from the sequence items */
+    DcmSequenceOfItems *sequence = NULL;
+    OFCHECK(dataset->findAndGetSequence(DCM_ReferencedSeriesSequence, sequence).good());
+    if (sequence != NULL)
+    {
+        OFCHECK_EQUAL(sequence->card(), 2);
+        for (unsigned long i = 0; i < sequence->card(); ++i)
+        {
+            DcmItem *item = sequence->getItem(i);
+            char buf[64];
+            OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.3.0.%lu", i);
+            OFString value;
+            OFCHECK(item->findAndGetOFString(DCM_SeriesInstanceUID, value).good());
+            OFCHECK_EQUAL(value, buf);
+            OFCHECK(!item->tagExists(DCM_RetrieveAETitle));
+            /* item numbers are not evaluated */
+            DcmItem *subItem = NULL;
+            OFCHECK(item->findAndGetSequenceItem(DCM_ReferencedInstanceSequence, subItem).good());
+            if (subItem != NULL)
+            {
+                OFCHECK(subItem->tagExists(DCM_ReferencedSOPInstanceUID));
+                OFCHECK(!subItem->tagExists(DCM_ReferencedSOPClassUID));
+                OFCHECK(!subItem->tagExists(DCM_ReferencedFrameNumber));
+            }
+        }
+    }
+    /* the values are still the same */
+    OFString value;
+    OFCHECK(dataset->findAndGetOFString(DCM_PatientName, value).good());
+    OFCHECK_EQUAL(value, "Doe^John");
+}
+
+
+OFTEST(dcmdata_attributeProjection_addPath)
+{
+    DcmAttributeProjection projection;
+    OFCHECK(projection.empty());
+    OFCHECK(projection.addPath("").bad());
+    OFCHECK(projection.addPath("UnknownAttributeName").bad());
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[x].SeriesInstanceUID").bad());
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[0]SeriesInstanceUID").bad());
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[*].SeriesInstanceUID").good());
+    OFCHECK(!projection.empty());
+    OFCHECK(projection.isSelected(DCM_ReferencedSeriesSequence));
+    OFCHECK(projection.isSelected(DCM_SpecificCharacterSet));
+    OFCHECK(projection.isSelected(DcmTagKey(0x0029, 0x0010)));
+    OFCHECK(!projection.isSelected(DCM_PatientName));
+    const DcmAttributeProjection *items = projection.getItemProjection(DCM_ReferencedSeriesSequence);
+    OFCHECK(items != NULL);
+    if (items != NULL)
+    {
+        OFCHECK(items->isSelected(DCM_SeriesInstanceUID));
+        OFCHECK(!items->isSelected(DCM_RetrieveAETitle));
+    }
+    /* selecting the complete sequence overrides the partial selection */
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[*]").good());
+    OFCHECK(projection.getItemProjection(DCM_ReferencedSeriesSequence) == NULL);
+    OFCHECK(projection.addPath("ReferencedSeriesSequence[0].RetrieveAETitle").good());
+    OFCHECK(projection.getItemProjection(DCM_ReferencedSeriesSequence) == NULL);
+    OFCHECK_EQUAL(projection.getLastTag(), DCM_ReferencedSeriesSequence);
+    projection.addTag(DCM_PatientName);
+    OFCHECK_EQUAL(projection.getLastTag(), DCM_PatientName);
+    projection.clear();
+    OFCHECK(projection.empty());
+}
+
+
+OFTEST(dcmdata_attributeProjection_loadFile)
+{
+    OFString tempPath;
+    OFTempFile::getTempPath(tempPath);
+    char buf[64];
+    OFStandard::snprintf(buf, sizeof(buf), "proj_%lu.dcm", OFstatic_cast(unsigned long, OFStandard::getProcessID()));
+    OFFilename filename;
+    OFStandard::combineDirAndFilename(filename, tempPath, buf);
+
+    DcmFileFormat fileformat;
+    createDataset(*fileformat.getDataset());
+    /* sequences and items with explicit length (can be skipped completely) */
+    OFCHECK(fileformat.saveFile(filename, EXS_LittleEndianExplicit, EET_ExplicitLength).good());
+    checkProjection(filename, OFFalse);
+    checkProjection(filename, OFTrue);
+    /* sequences and items with undefined length (need to be parsed) */
+    OFCHECK(fileformat.saveFile(filename, EXS_LittleEndianExplicit, EET_UndefinedLength).good());
+    checkProjection(filename, OFFalse);
+    checkProjection(filename, OFTrue);
+    OFCHECK(fileformat.saveFile(filename, EXS_LittleEndianImplicit, EET_UndefinedLength).good());
+    checkProjection(filename, OFFalse);
+    checkProjection(filename, OFTrue);
+    OFCHECK(fileformat.saveFile(filename, EXS_BigEndianExplicit, EET_ExplicitLength).good());
+    checkProjection(filename, OFFalse);
+    checkProjection(filename, OFTrue);
+
+    /* loading the complete file afterwards is not affected */
+    DcmFileFormat complete;
+    OFCHECK(complete.loadFile(filename).good());
+    OFCHECK(complete.getDataset()->tagExists(DCM_PixelData));
+    OFCHECK(complete.getDataset()->tagExists(DCM_PatientID));
+    OFStandard::deleteFile(filename);
+}
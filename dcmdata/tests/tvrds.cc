@@ -92,6 +92,33 @@ OFTEST(dcmdata_decimalString_4)
 }
 
 
+OFTEST(dcmdata_decimalString_5)
+{
+    DcmDecimalString decStr(DCM_ContourData, EVR_DS);
+    OFVector<Float64> doubleVals;
+    /* values with leading/trailing spaces, many digits and large exponents */
+    OFCHECK(decStr.putString(" 0.1\\-12.5 \\1234567890123456\\1e-300\\-0\\.5").good());
+    OFCHECK(decStr.getFloat64Vector(doubleVals).good());
+    OFCHECK_EQUAL(doubleVals.size(), 6);
+    if (doubleVals.size() == 6)
+    {
+        OFCHECK_EQUAL(doubleVals[0], 0.1);
+        OFCHECK_EQUAL(doubleVals[1], -12.5);
+        OFCHECK_EQUAL(doubleVals[2], 1234567890123456.0);
+        OFCHECK_EQUAL(doubleVals[3], 1e-300);
+        OFCHECK_EQUAL(doubleVals[4], 0);
+        OFCHECK_EQUAL(doubleVals[5], 0.5);
+    }
+    /* same values as retrieved one by one */
+    Float64 doubleVal = 0;
+    for (unsigned long i = 0; i < doubleVals.size(); ++i)
+    {
+        OFCHECK(decStr.getFloat64(doubleVal, i).good());
+        OFCHECK_EQUAL(doubleVal, doubleVals[i]);
+    }
+}
+
+
 OFTEST(dcmdata_decimalString_putFloat64)
 {
     // Test insertion in the beginning
@@ -25,6 +25,9 @@
 #include "dcmtk/ofstd/oftest.h"
 #include "dcmtk/dcmdata/dcvrfd.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcjson.h"
+#include "dcmtk/dcmdata/dcvrfl.h"
+#include "dcmtk/ofstd/ofstream.h"
 
 
 OFTEST(dcmdata_floatingPointDouble)
@@ -61,3 +64,26 @@ OFTEST(dcmdata_floatingPointDouble)
     OFCHECK(floatDouble.getFloat64(value, 3).good());
     OFCHECK_EQUAL(value, 4.4);
 }
+
+
+OFTEST(dcmdata_floatingPointDouble_writeShortest)
+{
+    DcmFloatingPointDouble floatDouble(DCM_InversionTimes);
+    OFCHECK(floatDouble.putFloat64(0.1, 0).good());
+    OFCHECK(floatDouble.putFloat64(1e+20, 1).good());
+    OFCHECK(floatDouble.putFloat64(0.1 + 0.2, 2).good());
+    /* values are written with the minimum number of digits */
+    OFStringStream xml;
+    OFCHECK(floatDouble.writeXML(xml).good());
+    OFCHECK(xml.str().find(">0.1\\1e+20\\0.30000000000000004<") != OFString_npos);
+    OFStringStream json;
+    DcmJsonFormatCompact format;
+    OFCHECK(floatDouble.writeJson(json, format).good());
+    OFCHECK(json.str().find("[0.1,1e20,0.30000000000000004]") != OFString_npos);
+    /* single precision values are converted back to the same float value */
+    DcmFloatingPointSingle floatSingle(DCM_RecommendedDisplayFrameRateInFloat);
+    OFCHECK(floatSingle.putFloat32(0.1f, 0).good());
+    OFStringStream jsonSingle;
+    OFCHECK(floatSingle.writeJson(jsonSingle, format).good());
+    OFCHECK(jsonSingle.str().find("[0.1]") != OFString_npos);
+}
@@ -0,0 +1,64 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DcmIntegerString
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dcvris.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+
+
+OFTEST(dcmdata_integerString)
+{
+    DcmIntegerString intStr(DCM_ReferencedFrameNumber, EVR_IS);
+    OFVector<Sint32> sintVals;
+    Sint32 sintVal = 0;
+    OFCHECK(intStr.putString("1\\ -2\\+30 \\2147483647\\-2147483648\\007").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).good());
+    OFCHECK_EQUAL(sintVals.size(), 6);
+    if (sintVals.size() == 6)
+    {
+        OFCHECK_EQUAL(sintVals[0], 1);
+        OFCHECK_EQUAL(sintVals[1], -2);
+        OFCHECK_EQUAL(sintVals[2], 30);
+        OFCHECK_EQUAL(sintVals[3], 2147483647);
+        OFCHECK_EQUAL(sintVals[4], -2147483647 - 1);
+        OFCHECK_EQUAL(sintVals[5], 7);
+    }
+    /* same values as retrieved one by one */
+    for (unsigned long i = 0; i < sintVals.size(); ++i)
+    {
+        OFCHECK(intStr.getSint32(sintVal, i).good());
+        OFCHECK_EQUAL(sintVal, sintVals[i]);
+    }
+    OFCHECK(intStr.getSint32(sintVal, 6).bad());
+
+    /* invalid values result in an error */
+    OFCHECK(intStr.putString("1\\abc\\3").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).bad());
+    OFCHECK(intStr.getSint32(sintVal, 1).bad());
+
+    /* empty value results in an empty vector */
+    OFCHECK(intStr.putString("").good());
+    OFCHECK(intStr.getSint32Vector(sintVals).good());
+    OFCHECK(sintVals.empty());
+}
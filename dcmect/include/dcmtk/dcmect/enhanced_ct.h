@@ -27,6 +27,7 @@
 #include "dcmtk/dcmect/def.h"
 #include "dcmtk/dcmect/types.h" // for Enhanced CT data types
 #include "dcmtk/dcmfg/fginterface.h"
+#include "dcmtk/dcmiod/iodframes.h"
 #include "dcmtk/dcmiod/iodimage.h"
 #include "dcmtk/dcmiod/modacquisitioncontext.h"
 #include "dcmtk/dcmiod/modenhequipment.h"
@@ -96,6 +97,28 @@ public:
          */
         OFCondition addFrame(PixelType* data, const size_t numPixels, const OFVector<FGBase*>& perFrameInformation);
 
+        /** Method that adds a (zero-initialized) frame to the Enhanced CT and
+         *  returns a view on it, so that the caller can write the pixel data
+         *  in place instead of handing in a buffer that is copied. The view
+         *  stays valid as long as no further frames are added, or, if the
+         *  number of frames has been reserved using reserve(), until the object
+         *  is written or destroyed.
+         *  @param  perFrameInformation The per-frame functional groups applying for
+         *  @param  frame Returns the view on the frame's pixel data (rows * columns
+         *          pixels), empty view in case of error
+         *  @return EC_Normal if adding was successful, error otherwise
+         */
+        OFCondition addFrame(const OFVector<FGBase*>& perFrameInformation, DcmIODTypes::FrameView<PixelType>& frame);
+
+        /** Reserve memory for the given total number of frames, so that frames
+         *  are added without reallocation, i.e.\ views returned by addFrame()
+         *  stay valid and no memory besides the final pixel data is needed.
+         *  Rows and Columns must be set before.
+         *  @param  numFrames The total number of frames to reserve memory for
+         *  @return EC_Normal if successful, error otherwise
+         */
+        OFCondition reserve(const size_t numFrames);
+
         /** Type-specific getFrame() method that returns Sint16 or Uint16 (whatever
          *  is used in this Enhanced CT)
          *  @param  frameNumber The frame number to get, starting from 0
@@ -103,6 +126,12 @@ public:
          */
         PixelType* getFrame(const size_t frameNumber);
 
+        /** Get view on the pixel data of a frame. No pixel data is copied.
+         *  @param  frameNumber The frame number to get, starting from 0
+         *  @return View on the frame's pixel data, empty view if frame does not exist
+         */
+        DcmIODTypes::FrameView<PixelType> getFrameView(const size_t frameNumber);
+
     private:
         /// Make sure the Enhanced CT object (and no one else) can use the constructor below.
         friend class EctEnhancedCT;
@@ -112,6 +141,12 @@ public:
          */
         Frames(EctEnhancedCT& ct);
 
+        /** Initialize frame store of the Enhanced CT object (if not done yet)
+         *  based on Rows, Columns and the pixel type
+         *  @return EC_Normal if successful, error otherwise
+         */
+        OFCondition initFrames();
+
         /// Reference to Enhanced CT object in order to access its pixel data
         EctEnhancedCT& m_CT;
     };
@@ -135,9 +170,12 @@ public:
      *  @param  filename The file to read from
      *  @param  ct The resulting Enhanced CT object. NULL if dataset
      *          could not be read successfully.
+     *  @param  readFGOnDemand If OFTrue, per-frame functional groups are read
+     *          on demand (see FGInterface::setReadOnDemand()), which is
+     *          recommended for read-only access to objects with many frames
      *  @return EC_Normal if reading was successful, error otherwise
      */
-    static OFCondition loadFile(const OFString& filename, EctEnhancedCT*& ct);
+    static OFCondition loadFile(const OFString& filename, EctEnhancedCT*& ct, const OFBool readFGOnDemand = OFFalse);
 
     /** Static method to load a Enhanced CT object from a dataset object.
      *  The memory of the resulting Enhanced CT object has to be freed by the
@@ -145,9 +183,11 @@ public:
      *  @param  dataset The dataset to read from
      *  @param  ct The resulting Enhanced CT object. NULL if dataset
      *          could not be read successfully.
+     *  @param  readFGOnDemand If OFTrue, per-frame functional groups are read
+     *          on demand (see FGInterface::setReadOnDemand())
      *  @return EC_Normal if reading was successful, error otherwise
      */
-    static OFCondition loadDataset(DcmDataset& dataset, EctEnhancedCT*& ct);
+    static OFCondition loadDataset(DcmDataset& dataset, EctEnhancedCT*& ct, const OFBool readFGOnDemand = OFFalse);
 
     /** Static method to load a concatenation of a DICOM Enhanced CT instance
      *  into a EctEnhancedCT object.
@@ -707,10 +747,24 @@ private:
     // Forward declarations (pixel type related Visitors)
     struct SetImagePixelModuleVisitor;
     struct ReadVisitor;
-    struct WriteVisitor;
-    struct WriteVisitorConcatenation;
     struct GetFramesVisitor;
 
+    /** Load Enhanced CT object from dataset, see loadDataset()
+     *  @param  dataset The dataset to read from
+     *  @param  ct The resulting Enhanced CT object. NULL if dataset
+     *          could not be read successfully.
+     *  @param  readFGOnDemand If OFTrue, per-frame functional groups are read
+     *          on demand
+     *  @param  takeOverPixelData If OFTrue, the Pixel Data element is removed
+     *          from the dataset and used by the Enhanced CT object directly
+     *          instead of being copied
+     *  @return EC_Normal if reading was successful, error otherwise
+     */
+    static OFCondition loadDataset(DcmDataset& dataset,
+                                   EctEnhancedCT*& ct,
+                                   const OFBool readFGOnDemand,
+                                   const OFBool takeOverPixelData);
+
     /// Synchronization Module
     IODSynchronizationModule m_SynchronisationModule;
 
@@ -733,8 +787,8 @@ private:
     /// Common Instance Reference Module
     IODCommonInstanceReferenceModule m_CommonInstanceReferenceModule;
 
-    /// Binary frame data
-    OFVector<DcmIODTypes::Frame*> m_Frames;
+    /// Binary frame data, stored contiguously in a single Pixel Data element
+    IODFrameStore m_Frames;
 
     /// Multi-frame Functional Groups high level interface
     FGInterface m_FGInterface;
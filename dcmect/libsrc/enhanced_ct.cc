@@ -61,145 +61,6 @@ struct EctEnhancedCT::SetImagePixelModuleVisitor
     const Uint16 cols;
 };
 
-// ----------------------------------------------------------------------------
-// Class WriteVisitor:
-// Class for adding DICOM pixel data bulk element based on type pixel data type
-// ----------------------------------------------------------------------------
-
-// Generic implementation, template specialization is done in inner
-// DcmElementOf class
-struct EctEnhancedCT::WriteVisitor
-{
-    // Inner class that implements the specializations for different
-    // pixel data types
-    // template <typename T> class DcmElementOf;
-
-    // Constructor, sets parameters the visitor works on in operator()
-    WriteVisitor(DcmItem& i, EctEnhancedCT& m)
-        : m_Item(i)
-        , m_CT(m)
-    {
-        // Nothing else to do
-    }
-
-    //
-    OFCondition operator()(OFmonostate)
-    {
-        DCMECT_ERROR("Could not write pixel data: Invalid pixel data type, only 16 bit integer is handled");
-        return ECT_NoPixelData;
-    }
-
-    template <typename ImagePixel>
-    OFCondition operator()(ImagePixel& pixel)
-    {
-        // Avoid compiler warning about unused parameter "pixel"
-        (void)pixel;
-        // Input data is checked before
-        Uint16 rows = 0;
-        Uint16 cols = 0;
-        m_CT.getRows(rows);
-        m_CT.getColumns(cols);
-        const size_t numFrames      = m_CT.m_Frames.size();
-        const size_t numBytesFrame  = m_CT.m_Frames[0]->length;
-        const size_t numPixelsFrame = rows * cols;
-        // Creates the correct pixel data element, based on the image pixel module used.
-        DcmPixelData* pixData = new DcmPixelData(DCM_PixelData);
-        OFCondition result;
-        if (pixData)
-        {
-            pixData->setVR(EVR_OW);
-            Uint16* ptr          = NULL;
-            size_t numBytesTotal = numBytesFrame * numFrames / 2;
-            if (numBytesTotal <= 4294967294UL)
-            {
-                result = pixData->createUint16Array(OFstatic_cast(Uint32, numBytesTotal), ptr);
-                // copy all frames into CT's frame structure
-                if (ptr)
-                {
-                    for (size_t f = 0; f < numFrames; ++f)
-                    {
-                        memcpy(ptr, m_CT.m_Frames[f]->pixData, numBytesFrame);
-                        ptr += numPixelsFrame;
-                    }
-                    return m_Item.insert(pixData);
-                }
-            }
-            else
-            {
-                result = FG_EC_PixelDataTooLarge;
-                delete pixData;
-            }
-        }
-        return result;
-    }
-
-    // Members, i.e. parameters to operator()
-    DcmItem& m_Item;
-    EctEnhancedCT& m_CT;
-};
-
-// Generic implementation, template specialization is done in inner
-// DcmElementOf class
-struct EctEnhancedCT::WriteVisitorConcatenation
-{
-    // Inner class that implements the writing to Concatentions via ConcatenationCreator class
-
-    // Constructor, sets parameters the visitor works on in operator()
-    WriteVisitorConcatenation(EctEnhancedCT& m, Uint8*& pixData, size_t& pixDataLength)
-        : m_CT(m)
-        , m_pixData(pixData)
-        , m_pixDataLength(pixDataLength)
-    {
-        // Nothing else to do
-    }
-
-    //
-    OFCondition operator()(OFmonostate)
-    {
-        DCMECT_ERROR("Could not write pixel data: Invalid pixel data type, only 16 bit integer is handled");
-        return ECT_NoPixelData;
-    }
-
-    template <typename ImagePixel>
-    OFCondition operator()(ImagePixel& pixel)
-    {
-        // Avoid compiler warning about unused parameter "pixel"
-        (void)pixel;
-        // Input data is checked before
-        Uint16 rows = 0;
-        Uint16 cols = 0;
-        m_CT.getRows(rows);
-        m_CT.getColumns(cols);
-        const size_t numFrames     = m_CT.m_Frames.size();
-        const size_t numBytesFrame = m_CT.m_Frames[0]->length;
-        // Creates the correct pixel data element, based on the image pixel module used.
-        m_pixDataLength = numBytesFrame * numFrames;
-        m_pixData       = new Uint8[m_pixDataLength];
-        if (m_pixData)
-        {
-            Uint8* ptr = m_pixData;
-            // copy all frames into CT's frame structure
-            if (ptr)
-            {
-                for (size_t f = 0; f < numFrames; ++f)
-                {
-                    memcpy(ptr, m_CT.m_Frames[f]->pixData, numBytesFrame);
-                    ptr += numBytesFrame;
-                }
-                return EC_Normal;
-            }
-        }
-        m_pixData       = OFnullptr;
-        m_pixDataLength = 0;
-        return EC_MemoryExhausted;
-    }
-
-    // Members, i.e. parameters to operator()
-    EctEnhancedCT& m_CT;
-    Uint8*& m_pixData;
-    size_t& m_pixDataLength;
-};
-
 struct EctEnhancedCT::ReadVisitor
 {
     // Inner class that implements the specializations for different
@@ -207,10 +68,14 @@ struct EctEnhancedCT::ReadVisitor
     template <typename T>
     class DcmElementOf;
 
-    ReadVisitor(DcmItem& srcItem, EctEnhancedCT& m, const OFBool readPixelData = OFTrue)
+    ReadVisitor(DcmItem& srcItem,
+                EctEnhancedCT& m,
+                const OFBool readPixelData     = OFTrue,
+                const OFBool takeOverPixelData = OFFalse)
         : m_Item(srcItem)
         , m_CT(m)
         , m_readPixelData(readPixelData)
+        , m_takeOverPixelData(takeOverPixelData)
     {
         // Nothing to do
     }
@@ -253,41 +118,16 @@ struct EctEnhancedCT::ReadVisitor
     {
         // Avoid compiler warning about unused parameter
         (void)p;
-        unsigned long numTotalWords = 0;
-        const Uint16* pixData       = NULL;
-        if (m_Item.findAndGetUint16Array(DCM_PixelData, pixData, &numTotalWords).good())
-        {
-            if (numTotalWords == numBytesFrame * numFrames / 2 /* we compare to num words not num bytes */)
-            {
-                for (Uint32 n = 0; n < numFrames; n++)
-                {
-                    DcmIODTypes::Frame* f = new DcmIODTypes::Frame;
-                    if (f)
-                    {
-                        f->length  = numBytesFrame;
-                        f->pixData = new Uint8[f->length];
-                        memcpy(f->pixData, pixData + n * numBytesFrame / 2, numBytesFrame);
-                        m_CT.m_Frames.push_back(f);
-                    }
-                    else
-                    {
-                        return EC_MemoryExhausted;
-                    }
-                }
-            }
-            else
-            {
-                DCMECT_ERROR("Invalid number of pixels: Expected " << numBytesFrame * numFrames / 2
-                                                                   << " pixels but Pixel Data has " << numTotalWords
-                                                                   << " pixels");
-                return ECT_InvalidPixelInfo;
-            }
-        }
-        else
+        if (!m_Item.tagExists(DCM_PixelData))
         {
             DCMECT_ERROR("No Pixel Data element found");
             return ECT_NoPixelData;
         }
+        // Frames are not copied but refer to the Pixel Data element directly
+        if (m_CT.m_Frames.read(m_Item, DCM_PixelData, numBytesFrame, numFrames, m_takeOverPixelData).bad())
+        {
+            return ECT_InvalidPixelInfo;
+        }
         return EC_Normal;
     }
 
@@ -295,6 +135,7 @@ struct EctEnhancedCT::ReadVisitor
     DcmItem& m_Item;
     EctEnhancedCT& m_CT;
     OFBool m_readPixelData;
+    OFBool m_takeOverPixelData;
 };
 
 template <typename PixelType>
@@ -303,6 +144,23 @@ EctEnhancedCT::Frames<PixelType>::Frames(EctEnhancedCT& ct)
 {
 }
 
+template <typename PixelType>
+OFCondition EctEnhancedCT::Frames<PixelType>::initFrames()
+{
+    if (m_CT.m_Frames.isInitialized())
+        return EC_Normal;
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    m_CT.getRows(rows);
+    m_CT.getColumns(cols);
+    if (!rows || !cols)
+    {
+        DCMECT_ERROR("Rows (" << rows << ") and Columns (" << cols << ") must not be 0");
+        return ECT_InvalidPixelInfo;
+    }
+    return m_CT.m_Frames.init(DCM_PixelData, OFstatic_cast(size_t, rows) * cols * sizeof(PixelType));
+}
+
 template <typename PixelType>
 OFCondition EctEnhancedCT::Frames<PixelType>::addFrame(PixelType* data,
                                                        const size_t numPixels,
@@ -313,42 +171,87 @@ OFCondition EctEnhancedCT::Frames<PixelType>::addFrame(PixelType* data,
     {
         if (!perFrameInformation.empty())
         {
-            OFunique_ptr<DcmIODTypes::Frame> f(new DcmIODTypes::Frame);
-            if (f)
+            result = initFrames();
+            if (result.good() && (numPixels * sizeof(PixelType) != m_CT.m_Frames.getBytesPerFrame()))
             {
-                f->length  = numPixels * sizeof(PixelType);
-                f->pixData = new Uint8[f->length];
-                memcpy(f->pixData, data, f->length);
-                m_CT.m_Frames.push_back(f.release());
-                OFVector<FGBase*>::const_iterator fg = perFrameInformation.begin();
-                while (result.good() && (fg != perFrameInformation.end()))
-                {
-                    result = m_CT.m_FGInterface.addPerFrame(OFstatic_cast(Uint32, m_CT.m_Frames.size()), **fg);
-                    if (result.bad())
-                    {
-                        DCMECT_ERROR(
-                            "Could not add functional group: " << DcmFGTypes::FGType2OFString((*fg)->getType()));
-                        break;
-                    }
-                    ++fg;
-                }
+                DCMECT_ERROR("Cannot add frame: Expected " << m_CT.m_Frames.getBytesPerFrame() / sizeof(PixelType)
+                                                           << " pixels but got " << numPixels);
+                result = ECT_InvalidPixelInfo;
             }
+            DcmIODTypes::FrameView<PixelType> frame;
+            if (result.good())
+                result = addFrame(perFrameInformation, frame);
+            if (result.good())
+                memcpy(frame.data(), data, numPixels * sizeof(PixelType));
         }
     }
-    // Clean up if necessary
-    if (result.bad())
-        m_CT.m_FGInterface.deleteFrame(OFstatic_cast(Uint32, m_CT.m_Frames.size()));
     return result;
 }
 
 template <typename PixelType>
-PixelType* EctEnhancedCT::Frames<PixelType>::getFrame(const size_t frameNumber)
+OFCondition EctEnhancedCT::Frames<PixelType>::addFrame(const OFVector<FGBase*>& perFrameInformation,
+                                                       DcmIODTypes::FrameView<PixelType>& frame)
 {
-    if (frameNumber < m_CT.m_Frames.size())
+    frame = DcmIODTypes::FrameView<PixelType>();
+    if (perFrameInformation.empty())
     {
-        return (PixelType*)(m_CT.m_Frames[frameNumber]->pixData);
+        DCMECT_ERROR("Cannot add frame: No per-frame functional groups given");
+        return EC_IllegalParameter;
     }
-    return NULL;
+    OFCondition result = initFrames();
+    Uint8* pixData     = NULL;
+    if (result.good())
+        result = m_CT.m_Frames.addEmptyFrame(pixData);
+    if (result.good())
+    {
+        OFVector<FGBase*>::const_iterator fg = perFrameInformation.begin();
+        while (result.good() && (fg != perFrameInformation.end()))
+        {
+            result = m_CT.m_FGInterface.addPerFrame(OFstatic_cast(Uint32, m_CT.m_Frames.getNumberOfFrames()), **fg);
+            if (result.bad())
+            {
+                DCMECT_ERROR("Could not add functional group: " << DcmFGTypes::FGType2OFString((*fg)->getType()));
+                break;
+            }
+            ++fg;
+        }
+        // Clean up if necessary
+        if (result.bad())
+        {
+            m_CT.m_FGInterface.deleteFrame(OFstatic_cast(Uint32, m_CT.m_Frames.getNumberOfFrames()));
+            m_CT.m_Frames.removeLastFrame();
+        }
+        else
+        {
+            frame = DcmIODTypes::FrameView<PixelType>(OFreinterpret_cast(PixelType*, pixData),
+                                                      m_CT.m_Frames.getBytesPerFrame() / sizeof(PixelType));
+        }
+    }
+    return result;
+}
+
+template <typename PixelType>
+OFCondition EctEnhancedCT::Frames<PixelType>::reserve(const size_t numFrames)
+{
+    OFCondition result = initFrames();
+    if (result.good())
+        result = m_CT.m_Frames.reserve(numFrames);
+    return result;
+}
+
+template <typename PixelType>
+PixelType* EctEnhancedCT::Frames<PixelType>::getFrame(const size_t frameNumber)
+{
+    return OFreinterpret_cast(PixelType*, m_CT.m_Frames.getFrame(frameNumber));
+}
+
+template <typename PixelType>
+DcmIODTypes::FrameView<PixelType> EctEnhancedCT::Frames<PixelType>::getFrameView(const size_t frameNumber)
+{
+    PixelType* pixData = getFrame(frameNumber);
+    if (pixData)
+        return DcmIODTypes::FrameView<PixelType>(pixData, m_CT.m_Frames.getBytesPerFrame() / sizeof(PixelType));
+    return DcmIODTypes::FrameView<PixelType>();
 }
 
 // Helper "class" that returns Frames offering API to the pixel's frame bulk
@@ -415,21 +318,29 @@ EctEnhancedCT::EctEnhancedCT(OFin_place_type_t(ImagePixel))
 
 EctEnhancedCT::~EctEnhancedCT()
 {
-    DcmIODUtil::freeContainer(m_Frames);
 }
 
-OFCondition EctEnhancedCT::loadFile(const OFString& filename, EctEnhancedCT*& ct)
+OFCondition EctEnhancedCT::loadFile(const OFString& filename, EctEnhancedCT*& ct, const OFBool readFGOnDemand)
 {
     DcmFileFormat dcmff;
     OFCondition cond = dcmff.loadFile(filename.c_str());
     if (cond.good())
     {
-        cond = loadDataset(*(dcmff.getDataset()), ct);
+        // The file format is not used afterwards, so take over its pixel data
+        cond = loadDataset(*(dcmff.getDataset()), ct, readFGOnDemand, OFTrue /* take over pixel data */);
     }
     return cond;
 }
 
-OFCondition EctEnhancedCT::loadDataset(DcmDataset& dataset, EctEnhancedCT*& ct)
+OFCondition EctEnhancedCT::loadDataset(DcmDataset& dataset, EctEnhancedCT*& ct, const OFBool readFGOnDemand)
+{
+    return loadDataset(dataset, ct, readFGOnDemand, OFFalse /* copy pixel data */);
+}
+
+OFCondition EctEnhancedCT::loadDataset(DcmDataset& dataset,
+                                       EctEnhancedCT*& ct,
+                                       const OFBool readFGOnDemand,
+                                       const OFBool takeOverPixelData)
 {
     OFCondition result;
     OFString sopClass;
@@ -484,7 +395,8 @@ OFCondition EctEnhancedCT::loadDataset(DcmDataset& dataset, EctEnhancedCT*& ct)
             return ECT_InvalidSOPClass;
         }
     }
-    result = OFvisit<OFCondition>(ReadVisitor(dataset, *ct), ct->getImagePixel());
+    ct->m_FGInterface.setReadOnDemand(readFGOnDemand);
+    result = OFvisit<OFCondition>(ReadVisitor(dataset, *ct, OFTrue, takeOverPixelData), ct->getImagePixel());
     if (result.bad())
     {
         delete ct;
@@ -523,9 +435,27 @@ EctEnhancedCT::loadConcatenation(ConcatenationLoader& cl, const OFString& concat
         }
         result
             = OFvisit<OFCondition>(ReadVisitor(dset, *ct, OFFalse /* do not read pixel data */), ct->getImagePixel());
-        if (result.good())
+        if (result.good() && !frames.empty())
         {
-            ct->m_Frames = frames;
+            // Move frames into frame store one by one, so that only a single
+            // frame is held twice in memory
+            result = ct->m_Frames.init(DCM_PixelData, frames[0]->length);
+            if (result.good())
+                result = ct->m_Frames.reserve(frames.size());
+            for (size_t f = 0; result.good() && (f < frames.size()); f++)
+            {
+                if (frames[f]->length != ct->m_Frames.getBytesPerFrame())
+                {
+                    DCMECT_ERROR("Frame " << f + 1 << " of Concatenation has invalid size");
+                    result = ECT_InvalidPixelInfo;
+                }
+                else
+                {
+                    result = ct->m_Frames.addFrame(frames[f]->pixData);
+                }
+                delete frames[f];
+                frames[f] = NULL;
+            }
         }
         if (result.bad())
         {
@@ -533,15 +463,26 @@ EctEnhancedCT::loadConcatenation(ConcatenationLoader& cl, const OFString& concat
             ct = NULL;
         }
     }
+    DcmIODUtil::freeContainer(frames);
     return result;
 }
 
 OFCondition EctEnhancedCT::saveFile(const OFString& filename, const E_TransferSyntax writeXfer)
 {
+    if (!check())
+    {
+        return IOD_EC_InvalidObject;
+    }
+
+    // Lend pixel data element to the dataset while saving instead of copying it
     DcmFileFormat dcmff;
-    OFCondition result;
-    if ((result = write(*dcmff.getDataset())).good())
+    DcmDataset* dset   = dcmff.getDataset();
+    OFCondition result = writeGeneric(*dset);
+    if (result.good())
+        result = m_Frames.insertInto(*dset);
+    if (result.good())
         result = dcmff.saveFile(filename.c_str(), writeXfer);
+    m_Frames.removeFrom(*dset);
     if (result.bad())
         DCMECT_ERROR("Cannot save Enhanced CT object to file " << filename << ": " << result.text());
     return result;
@@ -642,7 +583,7 @@ OFCondition EctEnhancedCT::create(EctEnhancedCT*& ct,
 
 OFBool EctEnhancedCT::check(const OFBool checkFGStructure)
 {
-    if (m_Frames.size() == 0)
+    if (m_Frames.getNumberOfFrames() == 0)
     {
         DCMECT_ERROR("No frame data available");
         return OFFalse;
@@ -1051,7 +992,7 @@ OFCondition EctEnhancedCT::write(DcmItem& dataset)
         return IOD_EC_InvalidObject;
     }
 
-    OFCondition result = OFvisit<OFCondition>(WriteVisitor(dataset, *this), getImagePixel());
+    OFCondition result = m_Frames.write(dataset);
     if (result.good())
         result = writeGeneric(dataset);
     return result;
@@ -1068,18 +1009,21 @@ OFCondition EctEnhancedCT::writeConcatenation(ConcatenationCreator& cc)
     if (!item)
         return EC_MemoryExhausted;
 
-    Uint8* pixData       = NULL;
-    size_t pixDataLength = 0;
-
-    OFCondition result
-        = OFvisit<OFCondition>(WriteVisitorConcatenation(*this, pixData, pixDataLength), getImagePixel());
+    // Frames are stored contiguously, so a single copy is sufficient
+    const size_t pixDataLength = m_Frames.getNumberOfFrames() * m_Frames.getBytesPerFrame();
+    Uint8* pixData             = new Uint8[pixDataLength];
+    memcpy(pixData, m_Frames.getFrame(0), pixDataLength);
 
-    if (result.good())
-        result = writeGeneric(*item);
+    OFCondition result = writeGeneric(*item);
     if (result.good())
     {
         result = cc.setCfgInput(item, pixData, pixDataLength, OFTrue /* cc should take ownership */);
     }
+    else
+    {
+        delete[] pixData;
+        delete item;
+    }
     return result;
 }
 
@@ -1090,7 +1034,7 @@ OFCondition EctEnhancedCT::writeGeneric(DcmItem& dataset)
         result = m_SynchronisationModule.write(dataset);
     if (result.good())
         result = m_FG.setNumberOfFrames(
-            DcmIODUtil::limitMaxFrames(m_Frames.size(), "Maximum number of frames exceeded, will write 2147483647"));
+            DcmIODUtil::limitMaxFrames(m_Frames.getNumberOfFrames(), "Maximum number of frames exceeded, will write 2147483647"));
     if (result.good())
         result = m_FG.write(dataset);
     if (result.good())
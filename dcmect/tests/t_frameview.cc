@@ -0,0 +1,236 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmect
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Tests for typed frame views on Enhanced CT pixel data
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/oftest.h"
+
+#include "dcmtk/dcmect/enhanced_ct.h"
+
+#include "dcmtk/dcmfg/fgfracon.h"
+#include "dcmtk/dcmfg/fgpixmsr.h"
+#include "dcmtk/dcmfg/fgplanor.h"
+#include "dcmtk/dcmfg/fgplanpo.h"
+
+static const Uint16 NUM_ROWS             = 4;
+static const Uint16 NUM_COLS             = 3;
+static const size_t NUM_FRAMES           = 5;
+static const size_t NUM_PIXELS_PER_FRAME = NUM_ROWS * NUM_COLS;
+
+// Expected value of a pixel
+static Uint16 pixel(const size_t frameNo, const size_t pixelNo)
+{
+    return OFstatic_cast(Uint16, frameNo * 1000 + pixelNo);
+}
+
+// Create Enhanced CT without frames
+static EctEnhancedCT* create()
+{
+    IODEnhGeneralEquipmentModule::EquipmentInfo eq("OFFIS", "OFFIS CT", "4711", "0.1");
+    EctEnhancedCT* ct = NULL;
+    OFCHECK(EctEnhancedCT::create(ct,
+                                  NUM_ROWS,
+                                  NUM_COLS,
+                                  OFFalse,
+                                  EctTypes::E_ImageType1_Original,
+                                  EctTypes::DT_ImageType3_Volume,
+                                  EctTypes::DT_ImageType4_Maximum,
+                                  "1" /* instance number */,
+                                  EctTypes::E_ContQuali_Research,
+                                  EctTypes::E_PixelPres_Monochrome,
+                                  EctTypes::E_VolProps_Volume,
+                                  EctTypes::DT_VolBasedCalcTechnique_VolumeRender,
+                                  eq,
+                                  "20260101120000" /* acquisition date */,
+                                  2.0 /* acquisition duration */)
+                .good());
+    OFCHECK(ct != NULL);
+    if (ct)
+    {
+        ct->setCheckFGOnWrite(OFFalse);
+        OFCHECK(ct->getFrameOfReference().setFrameOfReferenceUID("2.25.2").good());
+        FGPixelMeasures meas;
+        OFCHECK(meas.setPixelSpacing("0.1\\0.1").good());
+        OFCHECK(meas.setSliceThickness("1.0").good());
+        OFCHECK(ct->addForAllFrames(meas).good());
+        FGPlanePosPatient planpo;
+        OFCHECK(planpo.setImagePositionPatient("0.0", "0.0", "0.0").good());
+        OFCHECK(ct->addForAllFrames(planpo).good());
+        FGPlaneOrientationPatient planor;
+        OFCHECK(planor.setImageOrientationPatient("1.0", "0.0", "0.0", "0.0", "1.0", "0.0").good());
+        OFCHECK(ct->addForAllFrames(planor).good());
+        IODMultiframeDimensionModule& dims = ct->getDimensions();
+        OFCHECK(dims.addDimensionIndex(DCM_InStackPositionNumber, "2.25.1", DCM_FrameContentSequence, "STACK_DIM")
+                    .good());
+        IODMultiframeDimensionModule::DimensionOrganizationItem* org
+            = new IODMultiframeDimensionModule::DimensionOrganizationItem;
+        OFCHECK(org->setDimensionOrganizationUID("2.25.1").good());
+        dims.getDimensionOrganizationSequence().push_back(org);
+    }
+    return ct;
+}
+
+// Per-frame functional group for given frame
+static void setFrameContent(FGFrameContent& fracon, const size_t frameNo)
+{
+    OFCHECK(fracon.setStackID("1").good());
+    OFCHECK(fracon.setInStackPositionNumber(OFstatic_cast(Uint32, frameNo + 1)).good());
+    OFCHECK(fracon.setDimensionIndexValues(OFstatic_cast(Uint32, frameNo + 1), 0).good());
+}
+
+// Check that all frames contain the expected values
+static void checkFrames(EctEnhancedCT::Frames<Uint16>& frames)
+{
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+    {
+        DcmIODTypes::FrameView<Uint16> view = frames.getFrameView(f);
+        OFCHECK_EQUAL(view.size(), NUM_PIXELS_PER_FRAME);
+        OFCHECK(view.data() == frames.getFrame(f));
+        size_t p = 0;
+        for (Uint16* it = view.begin(); it != view.end(); ++it, ++p)
+        {
+            OFCHECK_EQUAL(*it, pixel(f, p));
+        }
+        OFCHECK_EQUAL(p, NUM_PIXELS_PER_FRAME);
+    }
+    OFCHECK(frames.getFrameView(NUM_FRAMES).empty());
+    OFCHECK(frames.getFrame(NUM_FRAMES) == NULL);
+}
+
+OFTEST(dcmect_frame_views)
+{
+    /* make sure data dictionary is loaded */
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        OFCHECK(dcmDataDict.isDictionaryLoaded());
+        return;
+    }
+
+    // Write frames in place into reserved memory
+    EctEnhancedCT* ct = create();
+    if (ct == NULL)
+        return;
+    EctEnhancedCT::FramesType framesType = ct->getFrames();
+    EctEnhancedCT::Frames<Uint16>* frames = OFget<EctEnhancedCT::Frames<Uint16> >(&framesType);
+    OFCHECK(frames != NULL);
+    if (frames == NULL)
+    {
+        delete ct;
+        return;
+    }
+    OFCHECK(frames->reserve(NUM_FRAMES).good());
+    OFVector<DcmIODTypes::FrameView<Uint16> > views;
+    FGFrameContent fracon;
+    OFVector<FGBase*> groups;
+    groups.push_back(&fracon);
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+    {
+        setFrameContent(fracon, f);
+        DcmIODTypes::FrameView<Uint16> view;
+        OFCHECK(frames->addFrame(groups, view).good());
+        OFCHECK_EQUAL(view.size(), NUM_PIXELS_PER_FRAME);
+        for (size_t p = 0; p < view.size(); p++)
+        {
+            // New frames are zero-initialized
+            OFCHECK_EQUAL(view[p], 0);
+            view[p] = pixel(f, p);
+        }
+        views.push_back(view);
+    }
+    OFCHECK_EQUAL(ct->getNumberOfFrames(), NUM_FRAMES);
+    // Views stay valid since no reallocation took place
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+    {
+        OFCHECK(views[f].data() == frames->getFrame(f));
+    }
+    checkFrames(*frames);
+
+    // Frames with invalid size are rejected
+    Uint16 tooSmall[NUM_PIXELS_PER_FRAME - 1];
+    OFCHECK(frames->addFrame(tooSmall, NUM_PIXELS_PER_FRAME - 1, groups).bad());
+    OFCHECK_EQUAL(ct->getNumberOfFrames(), NUM_FRAMES);
+
+    // Same result when copying frames without reserving memory before
+    EctEnhancedCT* copied = create();
+    if (copied)
+    {
+        EctEnhancedCT::FramesType copiedType = copied->getFrames();
+        EctEnhancedCT::Frames<Uint16>* copiedFrames = OFget<EctEnhancedCT::Frames<Uint16> >(&copiedType);
+        OFCHECK(copiedFrames != NULL);
+        if (copiedFrames)
+        {
+            Uint16 buffer[NUM_PIXELS_PER_FRAME];
+            for (size_t f = 0; f < NUM_FRAMES; f++)
+            {
+                setFrameContent(fracon, f);
+                for (size_t p = 0; p < NUM_PIXELS_PER_FRAME; p++)
+                    buffer[p] = pixel(f, p);
+                OFCHECK(copiedFrames->addFrame(buffer, NUM_PIXELS_PER_FRAME, groups).good());
+            }
+            checkFrames(*copiedFrames);
+        }
+        DcmDataset expected;
+        DcmDataset result;
+        OFCHECK(copied->writeDataset(expected).good());
+        OFCHECK(ct->writeDataset(result).good());
+        DcmElement* expectedPixels = NULL;
+        DcmElement* resultPixels   = NULL;
+        OFCHECK(expected.findAndGetElement(DCM_PixelData, expectedPixels).good());
+        OFCHECK(result.findAndGetElement(DCM_PixelData, resultPixels).good());
+        if (expectedPixels && resultPixels)
+        {
+            OFCHECK_EQUAL(resultPixels->getLength(), NUM_FRAMES * NUM_PIXELS_PER_FRAME * sizeof(Uint16));
+            OFCHECK(resultPixels->compare(*expectedPixels) == 0);
+        }
+        delete copied;
+    }
+
+    // Save (without copying the pixel data) and load again, frames are still
+    // available afterwards
+    OFTempFile tf;
+    OFString filename = tf.getFilename();
+    OFCHECK(ct->saveFile(filename).good());
+    checkFrames(*frames);
+    delete ct;
+    ct = NULL;
+    OFCHECK(EctEnhancedCT::loadFile(filename, ct).good());
+    OFCHECK(ct != NULL);
+    if (ct)
+    {
+        EctEnhancedCT::FramesType loadedType = ct->getFrames();
+        EctEnhancedCT::Frames<Uint16>* loaded = OFget<EctEnhancedCT::Frames<Uint16> >(&loadedType);
+        OFCHECK(loaded != NULL);
+        if (loaded)
+        {
+            checkFrames(*loaded);
+            // Modifications through views are written
+            loaded->getFrameView(1)[0] = 4711;
+            DcmDataset dset;
+            OFCHECK(ct->writeDataset(dset).good());
+            const Uint16* words = NULL;
+            OFCHECK(dset.findAndGetUint16Array(DCM_PixelData, words).good());
+            if (words)
+                OFCHECK_EQUAL(words[NUM_PIXELS_PER_FRAME], 4711);
+        }
+        delete ct;
+    }
+}
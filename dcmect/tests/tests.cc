@@ -22,6 +22,7 @@
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/ofstd/oftest.h"
 
+OFTEST_REGISTER(dcmect_frame_views);
 OFTEST_REGISTER(dcmect_huge_concat);
 OFTEST_REGISTER(dcmect_roundtrip);
 OFTEST_MAIN("dcmect")
@@ -27,6 +27,8 @@
 #include "dcmtk/dcmdata/dctk.h"
 #include "dcmtk/dcmfg/fgdefine.h"
 
+class DcmFileCache;
+
 /** Class for creating Concatenations from existing SOP Instances.
  *  As input, a user can either provide a full SOP Instance with Pixel Data
  *  attribute, or a SOP Instance plus separate pixel data as a vector of frame data.
@@ -34,7 +36,10 @@
  *  concatenation instances will also contain uncompressed pixel data.
  *  During conversion, the original source pixel data is held into memory and
  *  additionally one of the concatenation instances the moment it is being produced
- *  when calling writeNextInstance() (see below).
+ *  when calling writeNextInstance() (see below). If the source instance is provided
+ *  as a file instead, its pixel data is not loaded into memory but read from file
+ *  for each concatenation instance produced, i.e.\ only the pixel data of the
+ *  concatenation instance currently being produced is held in memory.
  *  The following workflow must be used to create a Concatenation:
  *  <ul>
  *  <li>Call to one of the setCfgInput() methods in order to set the concatenation
@@ -85,6 +90,16 @@ public:
     virtual OFCondition
     setCfgInput(DcmItem* srcDataset, Uint8* pixelData, size_t pixelDataLength, OFBool transferOwnership);
 
+    /** Set input file that should be split into a number of concatenation
+     *  instances. The file is loaded without its pixel data, which is read
+     *  from file on demand whenever the next concatenation instance is written.
+     *  Thus, the file must not be modified or deleted while the
+     *  ConcatenationCreator class is in use.
+     *  @param  srcFile The file to read from. The pixel data must be uncompressed.
+     *  @return EC_Normal if input is considered valid (up to now), error otherwise
+     */
+    virtual OFCondition setCfgInput(const OFFilename& srcFile);
+
     /** Set number of frames that should go into a single concatenation instance produced.
      *  The last concatenation instance might have less frames. This setting also
      *  directly determines the number of instances produced for a specific input.
@@ -176,6 +191,11 @@ protected:
      */
     virtual OFCondition configureCommon();
 
+    /** Release input provided by a previous call to setCfgInput(), i.e.\ free
+     *  all memory owned by this class and reset all pointers to the input
+     */
+    void releaseInput();
+
 private:
 
     /// Maximum number of instances that make up a Concatenation (=2^16-1=65535),
@@ -218,6 +238,19 @@ private:
     /// it is set to NULL. If m_cfgTransferOwnership is OFTrue, memory is freed by this class, too.
     Uint8* m_srcPixelData;
 
+    /// Source file loaded by setCfgInput(const OFFilename&), owned by this class.
+    /// NULL if the input was provided as a dataset.
+    DcmFileFormat* m_srcFileFormat;
+
+    /// Pixel Data element of m_srcFileFormat whose value is read from file
+    /// on demand, or of m_srcDataset if the input was provided as a dataset
+    /// without separate pixel data. NULL if the pixel data was provided separately.
+    DcmElement* m_srcPixelDataElem;
+
+    /// File cache used for reading the value of m_srcPixelDataElem, avoids
+    /// re-opening the file for each concatenation instance
+    DcmFileCache* m_srcFileCache;
+
     /// VR of pixel data extracted/derived from source dataset. EVR_OB and EVR_OW are supported.
     /// Initially set to EVR_Unknown.
     DcmEVR m_VRPixelData;
@@ -24,6 +24,7 @@
 
 #include "dcmtk/config/osconfig.h"
 
+#include "dcmtk/dcmdata/dcxfer.h"
 #include "dcmtk/dcmfg/fgdefine.h"
 #include "dcmtk/dcmiod/iodtypes.h"
 #include "dcmtk/dcmiod/iodutil.h"
@@ -31,6 +32,7 @@
 #include "dcmtk/ofstd/ofmap.h"
 
 class DcmDataset;
+class DcmOutputStream;
 
 /** Class for scanning files for concatenations and if desired, load
  *  one of them. If successful, loading produces the merged SOP Instance
@@ -44,7 +46,11 @@ class DcmDataset;
  *  <li>Call to the load() method in order to load of the the Concatenations found
  *  during scan(). Selection is done via the Concatenations Concatenation UID.
  *  The result is made available as a single, merged dataset without Pixel Data attribute
- *  and a vector containing all frames of the merged instance.</li>
+ *  and a vector containing all frames of the merged instance.
+ *  Alternatively, call loadToFile() or loadToStream() in order to write the merged
+ *  instance directly to a file or stream. In that case, the Pixel Data of the
+ *  Concatenation instances is read from file and written to the output one chunk
+ *  at a time, i.e. the frames are never held in memory all at once.</li>
  * </ul>
  */
 class DCMTK_DCMFG_EXPORT ConcatenationLoader
@@ -240,6 +246,40 @@ public:
     virtual OFCondition
     load(const OFString& concatenationUID, DcmDataset* dataset, OFVector<DcmIODTypes::Frame*>& frames);
 
+    /** Load Concatenation and write the merged instance (including Pixel Data)
+     *  to the given file. The Concatenation to be loaded is selected by its
+     *  Concatenation UID. In contrast to load(), the Pixel Data of the Concatenation
+     *  instances is never loaded into memory completely. Instead, the instances are
+     *  read twice: First, the merged dataset is created without any Pixel Data.
+     *  After writing it, the Pixel Data of each instance is read from file and
+     *  appended to the output in chunks. Thus, the memory required is mainly
+     *  determined by the (non-pixel) attributes of the merged instance.
+     *  Since the merged instance is written as a single dataset, its uncompressed
+     *  Pixel Data must not exceed 4 GB.
+     *  @param  concatenationUID The Concatenation UID of the Concatenation
+     *          to be loaded
+     *  @param  outputFile The file to write the merged instance to
+     *  @param  writeXfer The transfer syntax to be used for the merged instance.
+     *          Only uncompressed (and not deflated) transfer syntaxes are supported.
+     *  @return EC_Normal if loading and writing the Concatenation worked, error otherwise.
+     */
+    virtual OFCondition loadToFile(const OFString& concatenationUID,
+                                   const OFFilename& outputFile,
+                                   const E_TransferSyntax writeXfer = EXS_LittleEndianExplicit);
+
+    /** Load Concatenation and write the merged instance (including Pixel Data)
+     *  to the given stream in DICOM file format. See loadToFile() for details.
+     *  @param  concatenationUID The Concatenation UID of the Concatenation
+     *          to be loaded
+     *  @param  outStream The stream to write the merged instance to
+     *  @param  writeXfer The transfer syntax to be used for the merged instance.
+     *          Only uncompressed (and not deflated) transfer syntaxes are supported.
+     *  @return EC_Normal if loading and writing the Concatenation worked, error otherwise.
+     */
+    virtual OFCondition loadToStream(const OFString& concatenationUID,
+                                     DcmOutputStream& outStream,
+                                     const E_TransferSyntax writeXfer = EXS_LittleEndianExplicit);
+
 protected:
     /** Handles single file of a Concatenation and extracts structure for later
      *  access by the user.
@@ -340,6 +380,57 @@ protected:
     virtual OFCondition
     computeBytesPerFrame(const Uint16 rows, const Uint16 cols, const Uint16 bitsAlloc, size_t& bytes_per_frame);
 
+    /** Write those top-level elements of the result instance to the given
+     *  stream that are located before (or after) the Pixel Data attribute.
+     *  @param  outStream The stream to write to
+     *  @param  writeXfer The transfer syntax to be used
+     *  @param  beforePixelData If OFTrue, elements with a tag lower than the
+     *          one of Pixel Data are written, otherwise those with a higher tag
+     *  @return EC_Normal if successful, error otherwise
+     */
+    virtual OFCondition
+    writeElements(DcmOutputStream& outStream, const E_TransferSyntax writeXfer, const OFBool beforePixelData);
+
+    /** Write tag, VR (if explicit) and length of the Pixel Data attribute
+     *  to the given stream.
+     *  @param  outStream The stream to write to
+     *  @param  writeXfer The transfer syntax to be used
+     *  @param  bitsAlloc Bits Allocated of the pixel data, used to select the VR
+     *  @param  length The length of the Pixel Data value (must be even)
+     *  @return EC_Normal if successful, error otherwise
+     */
+    virtual OFCondition writePixelDataHeader(DcmOutputStream& outStream,
+                                             const E_TransferSyntax writeXfer,
+                                             const Uint16 bitsAlloc,
+                                             const Uint32 length);
+
+    /** Append the pixel data of a single Concatenation instance to the
+     *  given stream. The Pixel Data is read from file in chunks.
+     *  For Bits Allocated = 1, the frames of an instance might end within
+     *  a byte. In that case, the remaining bits are returned in the carry
+     *  parameters and are prepended to the pixel data of the next instance.
+     *  @param  inst The instance to read the Pixel Data from
+     *  @param  info Concatenation information providing pixel meta data
+     *          like Rows and Columns
+     *  @param  outStream The stream to write to
+     *  @param  byteOrder The byte order of the output
+     *  @param  buffer Buffer used for copying, must provide at least
+     *          bufferSize bytes
+     *  @param  bufferSize Size of the buffer in bytes
+     *  @param  carry Bits (Bits Allocated = 1) not yet written, in the lower
+     *          bits of the value
+     *  @param  carryBits Number of bits in carry, i.e. 0 to 7
+     *  @return EC_Normal if successful, error otherwise
+     */
+    virtual OFCondition streamFrames(const Info::Instance& inst,
+                                     const Info& info,
+                                     DcmOutputStream& outStream,
+                                     const E_ByteOrder byteOrder,
+                                     Uint8* buffer,
+                                     const Uint32 bufferSize,
+                                     Uint8& carry,
+                                     Uint8& carryBits);
+
 private:
     /// Map with entries consisting each of ConcatenationUID and related
     /// Concatenation information.
@@ -31,6 +31,7 @@
 #include "dcmtk/dcmfg/fgdefine.h"
 #include "dcmtk/dcmfg/fgtypes.h"
 #include "dcmtk/dcmiod/iodrules.h"
+#include "dcmtk/ofstd/oflist.h"
 #include "dcmtk/ofstd/ofmap.h"
 #include "dcmtk/ofstd/ofvector.h"
 
@@ -40,6 +41,12 @@ class IODMultiframeDimensionModule;
 /** Main interface class to access functional groups from DICOM Enhanced
  *  objects. Allows reading, modifying and writing functional groups back
  *  and forth from DICOM datasets.
+ *  Optionally, per-frame functional groups can be read on demand (see
+ *  setReadOnDemand()): Reading then only keeps a copy of each distinct
+ *  functional group sequence, which is shared by all frames containing an
+ *  identical sequence, and parses it on first access. Frames are converted
+ *  to regular (modifiable) per-frame groups when they are accessed through
+ *  any non-const method.
  */
 class DCMTK_DCMFG_EXPORT FGInterface
 {
@@ -123,10 +130,22 @@ public:
      */
     virtual FGBase* get(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType, OFBool& isPerFrame);
 
-    /** Return all per-frame functional groups, e.g.\ to iterate over them
+    /** Return all per-frame functional groups, e.g.\ to iterate over them.
+     *  If the frame has been read on demand (see setReadOnDemand()), it is
+     *  converted to regular per-frame groups first.
      *  @param  frameNo The frame number of the groups of interest (starts from 0)
      *  @return The per-frame functional groups for the given frame
      */
+    const FunctionalGroups* getPerFrame(const Uint32 frameNo);
+
+    /** Return all per-frame functional groups, e.g.\ to iterate over them.
+     *  This method does not modify the object, i.e.\ frames read on demand
+     *  (see setReadOnDemand()) that have not been converted to regular per-frame
+     *  groups yet are not found. Use the non-const version or get() instead.
+     *  @param  frameNo The frame number of the groups of interest (starts from 0)
+     *  @return The per-frame functional groups for the given frame, NULL if
+     *          not found
+     */
     const FunctionalGroups* getPerFrame(const Uint32 frameNo) const;
 
     /** Return all shared functional groups, e.g.\ to iterate over them
@@ -206,6 +225,49 @@ public:
      */
     virtual OFBool getCheckOnWrite();
 
+    /** Get specific functional group for a frame, no matter whether it is stored
+     *  per frame or shared. If per-frame functional groups have been read on
+     *  demand, the group returned may be shared with all other frames that
+     *  contain an identical group and the frame is not converted to regular
+     *  per-frame groups, i.e.\ this is the preferred method for read-only
+     *  access to large multi-frame objects.
+     *  @param  frameNo The frame number the functional group should apply to
+     *          (starts with 0)
+     *  @param  fgType The type of functional group to look for. Unknown
+     *          functional groups (EFG_UNKNOWN) cannot be retrieved with this
+     *          method since a frame may contain several of them.
+     *  Please note that this method updates the internal cache of parsed
+     *  functional groups read on demand, so it must not be called from
+     *  multiple threads at the same time.
+     *  @return The functional group if found, NULL otherwise. The pointer is
+     *          only valid until the next call to a method of this class if a
+     *          cache size is set (see setReadOnDemand()).
+     */
+    virtual const FGBase* get(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType) const;
+
+    /** If enabled, the per-frame functional groups are not parsed by read()
+     *  but on first access, and identical functional group sequences of
+     *  different frames are kept in memory only once. This considerably
+     *  reduces the number of objects created for objects with many frames.
+     *  Per default, all per-frame functional groups are parsed by read().
+     *  The setting must be changed before calling read() in order to have
+     *  any effect.
+     *  @param  onDemand If OFTrue, per-frame functional groups are read on
+     *          demand, otherwise they are completely parsed by read()
+     *  @param  maxCacheSize Maximum size (in bytes, as encoded in the dataset)
+     *          of the functional groups read on demand that are kept parsed
+     *          in memory for read-only access through the const get() method.
+     *          If exceeded, the least recently used groups are discarded and
+     *          parsed again when needed. 0 means unlimited.
+     */
+    virtual void setReadOnDemand(const OFBool onDemand, const size_t maxCacheSize = 0);
+
+    /** Returns whether per-frame functional groups are read on demand
+     *  @return OFTrue if per-frame functional groups are read on demand,
+     *          OFFalse otherwise
+     */
+    virtual OFBool getReadOnDemand() const;
+
 protected:
     /** Get shared functional group based on its type
      *  @param  fgType The type of functional group
@@ -289,7 +351,49 @@ protected:
      */
     virtual OFCondition convertSharedToPerFrame(const DcmFGTypes::E_FGType fgType);
 
+    /** Read Per-Frame Functional Group Sequence from given item on demand, i.e.\
+     *  store a single copy of each distinct functional group sequence for all
+     *  frames containing it, without parsing it
+     *  @param  perFrame The Per-Frame Functional Group Sequence to read from
+     *  @return EC_Normal if reading was successful, error otherwise
+     */
+    virtual OFCondition readPerFrameFGOnDemand(DcmSequenceOfItems& perFrame);
+
+    /** Convert the functional groups of a frame read on demand to regular
+     *  per-frame functional groups. Does nothing if the frame has already been
+     *  converted or has not been read on demand.
+     *  @param  frameNo The frame number (starts from 0)
+     */
+    virtual void convertOnDemandFrame(const Uint32 frameNo);
+
+    /** Convert the functional groups of all frames read on demand to regular
+     *  per-frame functional groups
+     */
+    virtual void convertOnDemandFrames();
+
 private:
+    /** Functional group sequence read on demand, shared by all frames
+     *  containing an identical sequence (reference counted)
+     */
+    struct OnDemandGroup;
+
+    /// List of functional group sequences read on demand
+    typedef OFList<OnDemandGroup*> OnDemandGroupList;
+
+    /** Get the parsed functional group of a sequence read on demand, parse
+     *  it if required and discard other parsed groups if the cache size is
+     *  exceeded
+     *  @param  group The functional group sequence
+     *  @return The functional group, NULL if it could not be parsed
+     */
+    FGBase* parseOnDemandGroup(OnDemandGroup* group) const;
+
+    /** Remove a frame's reference to a functional group sequence read on
+     *  demand and delete it if it is not referenced anymore
+     *  @param  group The functional group sequence
+     */
+    void releaseOnDemandGroup(OnDemandGroup* group);
+
     /// Shared functional groups
     FunctionalGroups m_shared;
 
@@ -300,6 +404,26 @@ private:
     /// If enabled, functional group structure is checked on write(). Otherwise,
     /// checks are skipped.
     OFBool m_checkOnWrite;
+
+    /// If enabled, per-frame functional groups are read on demand
+    OFBool m_readOnDemand;
+
+    /// Maximum size of parsed functional groups read on demand (0 = unlimited)
+    size_t m_maxCacheSize;
+
+    /// Functional group sequences read on demand for each frame. The list of a
+    /// frame is empty once it has been converted to regular per-frame groups
+    /// (m_perFrame). Empty if no frames have been read on demand.
+    OFVector<OFVector<OnDemandGroup*> > m_onDemandFrames;
+
+    /// Distinct functional group sequences read on demand, by sequence tag
+    OFMap<DcmTagKey, OnDemandGroupList> m_onDemandGroups;
+
+    /// Parsed functional groups read on demand, least recently used first
+    mutable OnDemandGroupList m_parsedGroups;
+
+    /// Total size of the parsed functional groups read on demand
+    mutable size_t m_parsedSize;
 };
 
 #endif // MODMULTIFRAMEFGH_H
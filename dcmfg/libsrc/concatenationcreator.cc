@@ -23,6 +23,7 @@
 
 #include "dcmtk/ofstd/ofstd.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfcache.h"
 #include "dcmtk/dcmdata/dcitem.h"
 #include "dcmtk/dcmdata/dcpixel.h"
 #include "dcmtk/dcmdata/dcuid.h"
@@ -49,6 +50,9 @@ ConcatenationCreator::ConcatenationCreator()
     , m_srcDataset(OFnullptr)
     , m_srcSOPInstanceUID()
     , m_srcPixelData(OFnullptr)
+    , m_srcFileFormat(OFnullptr)
+    , m_srcPixelDataElem(OFnullptr)
+    , m_srcFileCache(OFnullptr)
     , m_VRPixelData(EVR_UN)
     , m_srcPerFrameFG(OFnullptr)
     , m_srcNumFrames(0)
@@ -65,11 +69,7 @@ ConcatenationCreator::ConcatenationCreator()
 
 ConcatenationCreator::~ConcatenationCreator()
 {
-    if (m_cfgTransferOwnership)
-    {
-        delete m_srcDataset;
-        delete[] m_srcPixelData;
-    }
+    releaseInput();
 }
 
 OFCondition ConcatenationCreator::setCfgInput(DcmItem* srcDataset, OFBool transferOwnership)
@@ -84,11 +84,15 @@ OFCondition ConcatenationCreator::setCfgInput(DcmItem* srcDataset, OFBool transf
         return FG_EC_PixelDataMissing;
     if (!pixDataElem->canWriteXfer(EXS_LittleEndianExplicit, EXS_LittleEndianExplicit /* ignored */))
         return EC_UnsupportedEncoding;
-    OFCondition result = pixDataElem->getUint8Array(m_srcPixelData);
-    if (!m_srcPixelData || result.bad())
+    Uint8* pixelData   = NULL;
+    OFCondition result = pixDataElem->getUint8Array(pixelData);
+    if (!pixelData || result.bad())
         return FG_EC_PixelDataMissing;
 
-    m_srcDataset = srcDataset;
+    releaseInput();
+    m_srcDataset       = srcDataset;
+    m_srcPixelData     = pixelData;
+    m_srcPixelDataElem = pixDataElem;
 
     m_cfgTransferOwnership = transferOwnership;
 
@@ -105,6 +109,7 @@ OFCondition ConcatenationCreator::setCfgInput(DcmItem* srcDataset,
     if (!pixelData)
         return FG_EC_PixelDataMissing;
 
+    releaseInput();
     m_srcDataset           = srcDataset;
     m_srcPixelData         = pixelData;
     m_cfgTransferOwnership = transferOwnership;
@@ -113,6 +118,55 @@ OFCondition ConcatenationCreator::setCfgInput(DcmItem* srcDataset,
     return EC_Normal;
 }
 
+OFCondition ConcatenationCreator::setCfgInput(const OFFilename& srcFile)
+{
+    // Values larger than the maximum read length (in particular Pixel Data)
+    // are not loaded but read from file when needed
+    OFunique_ptr<DcmFileFormat> dcmff(new DcmFileFormat());
+    if (!dcmff)
+        return EC_MemoryExhausted;
+    OFCondition result = dcmff->loadFile(srcFile);
+    if (result.bad())
+        return result;
+
+    // Check pixel data exists and is in native format (i.e. uncompressed)
+    DcmDataset* dset = dcmff->getDataset();
+    if (DcmXfer(dset->getOriginalXfer()).isEncapsulated())
+        return EC_UnsupportedEncoding;
+    DcmElement* elem = NULL;
+    dset->findAndGetElement(DCM_PixelData, elem);
+    if (!elem)
+        return FG_EC_PixelDataMissing;
+
+    releaseInput();
+    m_srcFileFormat        = dcmff.release();
+    m_srcDataset           = dset;
+    m_srcPixelDataElem     = elem;
+    m_cfgTransferOwnership = OFFalse;
+
+    // All fine
+    return EC_Normal;
+}
+
+void ConcatenationCreator::releaseInput()
+{
+    if (m_cfgTransferOwnership)
+    {
+        // The value of a Pixel Data element is freed together with the dataset
+        if (!m_srcPixelDataElem)
+            delete[] m_srcPixelData;
+        delete m_srcDataset;
+    }
+    delete m_srcFileCache;
+    delete m_srcFileFormat;
+    m_srcDataset           = OFnullptr;
+    m_srcPixelData         = OFnullptr;
+    m_srcFileFormat        = OFnullptr;
+    m_srcPixelDataElem     = OFnullptr;
+    m_srcFileCache         = OFnullptr;
+    m_cfgTransferOwnership = OFFalse;
+}
+
 OFCondition ConcatenationCreator::setCfgFramesPerInstance(Uint32 numFramesPerInstance)
 {
     m_cfgNumFramesPerInstance = numFramesPerInstance;
@@ -165,7 +219,8 @@ OFCondition ConcatenationCreator::writeNextInstance(DcmItem& dstDataset)
     }
 
     Uint8* dstData = NULL;
-    size_t numTotalBytesInstance = (m_numBitsFrame * numFramesThisInstance) / 8;
+    // The last byte may only be partially occupied (Bits Allocated = 1, last instance)
+    size_t numTotalBytesInstance = (m_numBitsFrame * numFramesThisInstance + 7) / 8;
     // Cast is safe, checked in configureCommon()
     dstPixelData->createUint8Array(OFstatic_cast(Uint32, numTotalBytesInstance), dstData);
     if (!dstData)
@@ -174,7 +229,26 @@ OFCondition ConcatenationCreator::writeNextInstance(DcmItem& dstDataset)
     }
     dstPixelData->setVR(m_VRPixelData);
     size_t srcPos = (m_numBitsFrame * m_currentSrcFrame) / 8;
-    memcpy(dstData, &m_srcPixelData[srcPos], numTotalBytesInstance);
+    if (m_srcPixelData)
+    {
+        memcpy(dstData, &m_srcPixelData[srcPos], numTotalBytesInstance);
+    }
+    else
+    {
+        // Read pixel data of this instance from source file
+        if (!m_srcFileCache)
+            m_srcFileCache = new DcmFileCache();
+        // Casts are safe, pixel data length of source has been checked in configureCommon()
+        result = m_srcPixelDataElem->getPartialValue(dstData,
+                                                     OFstatic_cast(Uint32, srcPos),
+                                                     OFstatic_cast(Uint32, numTotalBytesInstance),
+                                                     m_srcFileCache);
+        if (result.bad())
+        {
+            DCMFG_ERROR("Cannot read pixel data from source file: " << result.text());
+            return result;
+        }
+    }
     result = dstDataset.insert(dstPixelData.release());
     if (result.good())
     {
@@ -373,7 +447,7 @@ Uint32 ConcatenationCreator::numFramesCurrentDstInstance()
 
 OFCondition ConcatenationCreator::configureCommon()
 {
-    if (!m_srcDataset || !m_srcPixelData)
+    if (!m_srcDataset || (!m_srcPixelData && !m_srcPixelDataElem))
         return EC_IllegalCall;
 
     // Check for Shared/Per-Frame Functional Group Sequence
@@ -416,6 +490,14 @@ OFCondition ConcatenationCreator::configureCommon()
     // Compute number of bits per frame
     m_numBitsFrame = rows * cols * bitsAlloc;
 
+    // If pixel data is read from file, its length is known in advance
+    if (m_srcPixelDataElem
+        && (m_srcPixelDataElem->getLength() < (OFstatic_cast(Uint64, m_numBitsFrame) * m_srcNumFrames + 7) / 8))
+    {
+        DCMFG_ERROR("Pixel Data of source file is too short for " << m_srcNumFrames << " frames");
+        return FG_EC_NotEnoughFrames;
+    }
+
     // If Bits Allocated is 1 (i.e. not 8 or 16), the last byte of the frame can only be
     // partly occupied with bits. Since we work with bytewise memcpy later, make sure that
     // number of bytes per instance (number of frames per instance multiplied by the number
@@ -22,13 +22,42 @@
 #include "dcmtk/config/osconfig.h"
 
 #include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfcache.h"
 #include "dcmtk/dcmdata/dcitem.h"
+#include "dcmtk/dcmdata/dcostrmf.h"
 #include "dcmtk/dcmdata/dcpixel.h"
+#include "dcmtk/dcmdata/dcswap.h"
 #include "dcmtk/dcmdata/dcuid.h"
+#include "dcmtk/dcmdata/dcwcache.h"
 #include "dcmtk/dcmfg/concatenationloader.h"
 #include "dcmtk/dcmfg/fg.h"
 #include "dcmtk/dcmfg/fgtypes.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofvector.h"
+
+// Number of bytes of Pixel Data copied at once when writing a merged instance to a stream
+static const Uint32 STREAMING_CHUNK_SIZE = 1048576;
+
+// Maximum length of uncompressed Pixel Data in a single dataset (=2^32-2)
+static const Uint32 MAX_PIXEL_DATA_LENGTH = 4294967294UL;
+
+// Write given buffer completely to stream
+static OFCondition writeToStream(DcmOutputStream& outStream, const Uint8* buffer, offile_off_t length)
+{
+    while ((length > 0) && outStream.good())
+    {
+        const offile_off_t written = outStream.write(buffer, length);
+        if (written == 0)
+        {
+            outStream.flush();
+            if (outStream.avail() == 0)
+                return EC_StreamNotifyClient;
+        }
+        buffer += written;
+        length -= written;
+    }
+    return outStream.status();
+}
 
 //  --------------------------------- Public API ------------------------------
 
@@ -285,6 +314,150 @@ ConcatenationLoader::load(const OFString& concatenationUID, DcmDataset* dataset,
     return result;
 }
 
+OFCondition ConcatenationLoader::loadToFile(const OFString& concatenationUID,
+                                            const OFFilename& outputFile,
+                                            const E_TransferSyntax writeXfer)
+{
+    DcmOutputFileStream outStream(outputFile);
+    OFCondition result = outStream.status();
+    if (result.good())
+    {
+        result = loadToStream(concatenationUID, outStream, writeXfer);
+    }
+    return result;
+}
+
+OFCondition ConcatenationLoader::loadToStream(const OFString& concatenationUID,
+                                              DcmOutputStream& outStream,
+                                              const E_TransferSyntax writeXfer)
+{
+    // Pixel Data is written as a plain byte stream, so only uncompressed transfer syntaxes are supported
+    DcmXfer xfer(writeXfer);
+    if ((writeXfer == EXS_Unknown) || (writeXfer == EXS_BigEndianImplicit) || xfer.isEncapsulated()
+        || (xfer.getStreamCompression() != ESC_none))
+    {
+        DCMFG_ERROR("Cannot write merged Concatenation in transfer syntax " << xfer.getXferName());
+        return EC_UnsupportedEncoding;
+    }
+
+    ScanResultIt concat = m_Concats.find(concatenationUID);
+    if ((concat == m_Concats.end()) || (concat->second == NULL) || concat->second->m_Files.empty())
+    {
+        DCMFG_ERROR("Cannot load Concatenation " << concatenationUID << ": Not found in scan results");
+        return EC_IllegalParameter;
+    }
+    Info& info = *concat->second;
+
+    // Compute length of resulting pixel data. For Bits Allocated = 1, the frames
+    // of all instances are packed without any gaps in between.
+    size_t bytesPerFrame = 0;
+    OFCondition result   = computeBytesPerFrame(info.m_Rows, info.m_Cols, info.m_BitsAlloc, bytesPerFrame);
+    if (result.bad())
+        return result;
+    Uint64 numTotalBytes = 0;
+    if (info.m_BitsAlloc == 1)
+        numTotalBytes = (OFstatic_cast(Uint64, info.m_NumTotalFrames) * info.m_Rows * info.m_Cols + 7) / 8;
+    else
+        numTotalBytes = OFstatic_cast(Uint64, info.m_NumTotalFrames) * bytesPerFrame;
+    if (numTotalBytes > MAX_PIXEL_DATA_LENGTH)
+    {
+        DCMFG_ERROR("Uncompressed pixel data of merged Concatenation must not exceed " << MAX_PIXEL_DATA_LENGTH
+                                                                                       << " bytes");
+        return FG_EC_PixelDataTooLarge;
+    }
+
+    // First pass: Create merged dataset without Pixel Data. The Pixel Data of the
+    // instances is not loaded since it is larger than the maximum read length.
+    DCMFG_DEBUG("Loading Concatenation " << concatenationUID << " from " << info.m_Files.size() << " instances");
+    DcmFileFormat dcmff;
+    m_Result = dcmff.getDataset();
+    result   = prepareTemplate(info);
+    OFListIterator(ConcatenationLoader::Info::Instance) inst = info.m_Files.begin();
+    while (result.good() && (inst != info.m_Files.end()))
+    {
+        DcmFileFormat instff;
+        result = instff.loadFile(inst->m_Filename);
+        if (result.good())
+        {
+            DcmDataset* dset     = instff.getDataset();
+            DcmElement* pixData  = NULL;
+            const Uint64 numBits
+                = OFstatic_cast(Uint64, inst->m_NumberOfFrames) * info.m_Rows * info.m_Cols * info.m_BitsAlloc;
+            if (DcmXfer(dset->getOriginalXfer()).isEncapsulated())
+            {
+                DCMFG_ERROR("Cannot merge compressed Concatenation instance " << inst->m_Filename);
+                result = EC_UnsupportedEncoding;
+            }
+            else if (dset->findAndGetElement(DCM_PixelData, pixData).bad())
+            {
+                result = FG_EC_PixelDataMissing;
+            }
+            else if (pixData->getLength() < (numBits + 7) / 8)
+            {
+                DCMFG_ERROR("Not enough pixel data for " << inst->m_NumberOfFrames
+                                                         << " frames in Concatenation instance " << inst->m_Filename);
+                result = FG_EC_NotEnoughFrames;
+            }
+        }
+        if (result.good())
+            result = movePerFrameItems(*instff.getDataset());
+        inst++;
+    }
+    if (result.good())
+        result = insertDestinationAttributes();
+
+    // Write meta header and all attributes before Pixel Data
+    if (result.good())
+        result = dcmff.validateMetaInfo(writeXfer);
+    if (result.good())
+    {
+        DcmMetaInfo* metaInfo = dcmff.getMetaInfo();
+        metaInfo->transferInit();
+        result = metaInfo->write(outStream, writeXfer, EET_ExplicitLength, NULL);
+        metaInfo->transferEnd();
+    }
+    if (result.good())
+        result = m_Result->computeGroupLengthAndPadding(EGL_withoutGL, EPD_noChange, writeXfer, EET_ExplicitLength);
+    if (result.good())
+        result = writeElements(outStream, writeXfer, OFTrue /* before Pixel Data */);
+
+    // Second pass: Append pixel data of the instances, one chunk at a time
+    const Uint32 pixelDataLength = OFstatic_cast(Uint32, numTotalBytes + (numTotalBytes & 1));
+    if (result.good())
+        result = writePixelDataHeader(outStream, writeXfer, info.m_BitsAlloc, pixelDataLength);
+    if (result.good())
+    {
+        // Freed automatically when leaving the scope
+        OFVector<Uint8> chunk(STREAMING_CHUNK_SIZE);
+        Uint8* buffer   = &chunk[0];
+        Uint8 carry     = 0;
+        Uint8 carryBits = 0;
+        inst            = info.m_Files.begin();
+        while (result.good() && (inst != info.m_Files.end()))
+        {
+            result = streamFrames(
+                *inst, info, outStream, xfer.getByteOrder(), buffer, STREAMING_CHUNK_SIZE, carry, carryBits);
+            inst++;
+        }
+        // Write remaining bits of last (binary) frame, and pad to even length
+        size_t remaining = 0;
+        if (carryBits > 0)
+            buffer[remaining++] = carry;
+        if (numTotalBytes & 1)
+            buffer[remaining++] = 0;
+        if (result.good() && (remaining > 0))
+            result = writeToStream(outStream, buffer, remaining);
+    }
+
+    // Write attributes after Pixel Data (if any)
+    if (result.good())
+        result = writeElements(outStream, writeXfer, OFFalse /* after Pixel Data */);
+    if (result.good())
+        outStream.flush();
+    m_Result = NULL;
+    return result;
+}
+
 OFCondition ConcatenationLoader::prepareTemplate(ConcatenationLoader::Info& firstInstance)
 {
     DcmFileFormat dcmff;
@@ -480,6 +653,122 @@ OFCondition ConcatenationLoader::insertDestinationAttributes()
     return result;
 }
 
+OFCondition ConcatenationLoader::writeElements(DcmOutputStream& outStream,
+                                              const E_TransferSyntax writeXfer,
+                                              const OFBool beforePixelData)
+{
+    OFCondition result;
+    DcmWriteCache wcache;
+    DcmObject* obj = NULL;
+    while (result.good() && ((obj = m_Result->nextInContainer(obj)) != NULL))
+    {
+        if ((obj->getTag() < DCM_PixelData) == beforePixelData)
+        {
+            obj->transferInit();
+            result = obj->write(outStream, writeXfer, EET_ExplicitLength, &wcache);
+            obj->transferEnd();
+        }
+    }
+    return result;
+}
+
+OFCondition ConcatenationLoader::writePixelDataHeader(DcmOutputStream& outStream,
+                                                     const E_TransferSyntax writeXfer,
+                                                     const Uint16 bitsAlloc,
+                                                     const Uint32 length)
+{
+    DcmXfer xfer(writeXfer);
+    const E_ByteOrder byteOrder = xfer.getByteOrder();
+    Uint8 header[12];
+    size_t headerLength = 0;
+    Uint16 tag[2];
+    tag[0] = DCM_PixelData.getGroup();
+    tag[1] = DCM_PixelData.getElement();
+    swapIfNecessary(byteOrder, gLocalByteOrder, tag, 4, sizeof(Uint16));
+    memcpy(header, tag, 4);
+    headerLength += 4;
+    if (xfer.isExplicitVR())
+    {
+        // VR, followed by two reserved bytes and a 32 bit length field
+        DcmVR vr((bitsAlloc <= 8) ? EVR_OB : EVR_OW);
+        memcpy(header + headerLength, vr.getVRName(), 2);
+        header[headerLength + 2] = 0;
+        header[headerLength + 3] = 0;
+        headerLength += 4;
+    }
+    Uint32 len = length;
+    swapIfNecessary(byteOrder, gLocalByteOrder, &len, 4, sizeof(Uint32));
+    memcpy(header + headerLength, &len, 4);
+    headerLength += 4;
+    return writeToStream(outStream, header, headerLength);
+}
+
+OFCondition ConcatenationLoader::streamFrames(const Info::Instance& inst,
+                                             const Info& info,
+                                             DcmOutputStream& outStream,
+                                             const E_ByteOrder byteOrder,
+                                             Uint8* buffer,
+                                             const Uint32 bufferSize,
+                                             Uint8& carry,
+                                             Uint8& carryBits)
+{
+    DcmFileFormat dcmff;
+    OFCondition result = dcmff.loadFile(inst.m_Filename);
+    DcmElement* pixData = NULL;
+    if (result.good())
+        result = dcmff.getDataset()->findAndGetElement(DCM_PixelData, pixData);
+    if (result.bad())
+        return FG_EC_PixelDataMissing;
+
+    // Number of bits of this instance's frames (checked before to fit into the Pixel Data element)
+    const Uint64 numBits  = OFstatic_cast(Uint64, inst.m_NumberOfFrames) * info.m_Rows * info.m_Cols * info.m_BitsAlloc;
+    const Uint32 numBytes = OFstatic_cast(Uint32, (numBits + 7) / 8);
+    const Uint8 lastBits  = OFstatic_cast(Uint8, numBits % 8);
+    DCMFG_DEBUG("Writing " << numBytes << " bytes of pixel data from " << inst.m_Filename);
+
+    // Use file cache so that the file is only opened once for all chunks
+    DcmFileCache cache;
+    Uint32 offset = 0;
+    while (result.good() && (offset < numBytes))
+    {
+        Uint32 chunk = (numBytes - offset < bufferSize) ? numBytes - offset : bufferSize;
+        result       = pixData->getPartialValue(buffer, offset, chunk, &cache, byteOrder);
+        offset += chunk;
+        if (result.good() && (info.m_BitsAlloc == 1) && ((carryBits > 0) || ((offset == numBytes) && (lastBits > 0))))
+        {
+            // Shift bits so that they directly follow those of the previous instance;
+            // only the last byte of the instance may be partially occupied
+            Uint32 out = 0;
+            for (Uint32 i = 0; i < chunk; i++)
+            {
+                Uint8 bits = 8;
+                Uint8 value = buffer[i];
+                if ((offset == numBytes) && (i == chunk - 1) && (lastBits > 0))
+                {
+                    bits  = lastBits;
+                    value = OFstatic_cast(Uint8, value & ((1 << bits) - 1));
+                }
+                const Uint16 acc = OFstatic_cast(Uint16, carry | (value << carryBits));
+                if (carryBits + bits >= 8)
+                {
+                    buffer[out++] = OFstatic_cast(Uint8, acc & 0xff);
+                    carry         = OFstatic_cast(Uint8, acc >> 8);
+                    carryBits     = OFstatic_cast(Uint8, carryBits + bits - 8);
+                }
+                else
+                {
+                    carry     = OFstatic_cast(Uint8, acc);
+                    carryBits = OFstatic_cast(Uint8, carryBits + bits);
+                }
+            }
+            chunk = out;
+        }
+        if (result.good())
+            result = writeToStream(outStream, buffer, chunk);
+    }
+    return result;
+}
+
 OFBool ConcatenationLoader::zeroOrEqual(const size_t num1, const size_t num2)
 {
     if (num1 == num2)
@@ -28,10 +28,63 @@
 #include "dcmtk/ofstd/ofmap.h"
 #include "dcmtk/ofstd/ofmem.h"
 
+// Number of distinct functional group sequences (of the same type) that a
+// sequence read on demand is compared with in order to find an identical one.
+// Only the most recently read sequences are considered, which catches groups
+// that are identical for all frames or for a run of consecutive frames.
+#define FG_ONDEMAND_COMPARE_CANDIDATES 8
+
+struct FGInterface::OnDemandGroup
+{
+    OnDemandGroup(DcmItem* item, DcmElement* sequence)
+        : m_item(item)
+        , m_sequence(sequence)
+        , m_group(NULL)
+        , m_size(sequence->getLength())
+        , m_refCount(0)
+        , m_pos()
+        , m_parsedPos()
+    {
+    }
+
+    ~OnDemandGroup()
+    {
+        delete m_group;
+        delete m_item;
+    }
+
+    /// Item holding a copy of the functional group sequence
+    DcmItem* m_item;
+
+    /// The functional group sequence (owned by m_item)
+    DcmElement* m_sequence;
+
+    /// The parsed functional group, NULL if not parsed (yet)
+    FGBase* m_group;
+
+    /// Size of the functional group sequence in bytes
+    size_t m_size;
+
+    /// Number of frames referencing the sequence
+    size_t m_refCount;
+
+    /// Position in list of distinct functional group sequences
+    OFListIterator(FGInterface::OnDemandGroup*) m_pos;
+
+    /// Position in list of parsed groups (only valid if m_group is not NULL)
+    OFListIterator(FGInterface::OnDemandGroup*) m_parsedPos;
+};
+
 FGInterface::FGInterface()
     : m_shared()
     , m_perFrame()
     , m_checkOnWrite(OFTrue)
+    , m_readOnDemand(OFFalse)
+    , m_maxCacheSize(0)
+    , m_onDemandFrames()
+    , m_onDemandGroups()
+    , m_parsedGroups()
+    , m_parsedSize(0)
 {
 }
 
@@ -51,12 +104,31 @@ void FGInterface::clear()
         delete fg;
     }
 
+    // Clear per-frame functional groups read on demand
+    m_onDemandFrames.clear();
+    OFMap<DcmTagKey, OnDemandGroupList>::iterator groups = m_onDemandGroups.begin();
+    while (groups != m_onDemandGroups.end())
+    {
+        OFListIterator(OnDemandGroup*) group = (*groups).second.begin();
+        while (group != (*groups).second.end())
+        {
+            delete *group;
+            group++;
+        }
+        groups++;
+    }
+    m_onDemandGroups.clear();
+    m_parsedGroups.clear();
+    m_parsedSize = 0;
+
     // Clear shared functional groups
     m_shared.clear();
 }
 
 size_t FGInterface::getNumberOfFrames()
 {
+    if (m_onDemandFrames.size() > m_perFrame.size())
+        return m_onDemandFrames.size();
     return m_perFrame.size();
 }
 
@@ -70,6 +142,8 @@ OFCondition FGInterface::addShared(const FGBase& group)
         return FG_EC_CouldNotAddFG;
     }
 
+    convertOnDemandFrames();
+
     // Delete all per frame groups of this type
     for (size_t count = 0; count < m_perFrame.size(); count++)
     {
@@ -105,6 +179,8 @@ OFCondition FGInterface::addPerFrame(const Uint32 frameNo, const FGBase& group)
         return FG_EC_CouldNotAddFG;
     }
 
+    convertOnDemandFrames();
+
     // Check whether there is already a shared group of this type.
     // If the content is equal to the given group, we re-use the shared one
     FGBase* shared = getShared(group.getType());
@@ -153,15 +229,24 @@ FGBase* FGInterface::get(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType
     return get(frameNo, fgType, helpShared);
 }
 
+const FunctionalGroups* FGInterface::getPerFrame(const Uint32 frameNo)
+{
+    // The caller may modify the groups, so frames read on demand are converted
+    convertOnDemandFrame(frameNo);
+    // Now, the const version finds the groups
+    return OFstatic_cast(const FGInterface*, this)->getPerFrame(frameNo);
+}
+
 const FunctionalGroups* FGInterface::getPerFrame(const Uint32 frameNo) const
 {
-    if (frameNo > m_perFrame.size())
+    OFMap<Uint32, FunctionalGroups*>::const_iterator it = m_perFrame.find(frameNo);
+    if (it == m_perFrame.end())
     {
         return NULL;
     }
     else
     {
-        return (*(m_perFrame.find(frameNo))).second;
+        return (*it).second;
     }
 }
 
@@ -241,6 +326,11 @@ OFCondition FGInterface::readPerFrameFG(DcmItem& dataset)
         return FG_EC_NoPerFrameFG;
     }
 
+    if (m_readOnDemand)
+    {
+        return readPerFrameFGOnDemand(*perFrame);
+    }
+
     /* Read functional groups for each item (one per frame) */
     DcmItem* oneFrameItem = OFstatic_cast(DcmItem*, perFrame->nextInContainer(NULL));
     Uint32 count          = 0;
@@ -276,6 +366,180 @@ OFCondition FGInterface::readPerFrameFG(DcmItem& dataset)
     return EC_Normal; // for now we always return EC_Normal...
 }
 
+OFCondition FGInterface::readPerFrameFGOnDemand(DcmSequenceOfItems& perFrame)
+{
+    DCMFG_DEBUG("Reading per-frame functional groups on demand");
+    m_onDemandFrames.resize(perFrame.card());
+    DcmItem* oneFrameItem = OFstatic_cast(DcmItem*, perFrame.nextInContainer(NULL));
+    size_t numDistinct    = 0;
+    Uint32 count          = 0;
+    while (oneFrameItem != NULL)
+    {
+        OFVector<OnDemandGroup*>& frameGroups = m_onDemandFrames[count];
+        DcmElement* elem                      = OFstatic_cast(DcmElement*, oneFrameItem->nextInContainer(NULL));
+        while (elem != NULL)
+        {
+            if (elem->getVR() != EVR_SQ)
+            {
+                DCMFG_WARN("Found non-sequence element in functional group sequence item (ignored): " << elem->getTag());
+            }
+            else
+            {
+                // Look for an identical sequence read for one of the previous frames
+                OnDemandGroupList& candidates         = m_onDemandGroups[elem->getTag()];
+                OnDemandGroup* group                  = NULL;
+                OFListIterator(OnDemandGroup*) candidate = candidates.end();
+                for (size_t i = 0; (i < FG_ONDEMAND_COMPARE_CANDIDATES) && (candidate != candidates.begin()); i++)
+                {
+                    candidate--;
+                    if ((*candidate)->m_sequence->compare(*elem) == 0)
+                    {
+                        group = *candidate;
+                        break;
+                    }
+                }
+                if (group == NULL)
+                {
+                    DcmItem* item     = new DcmItem();
+                    DcmElement* clone = OFstatic_cast(DcmElement*, elem->clone());
+                    if (item->insert(clone).bad())
+                    {
+                        DCMFG_ERROR("Could not store functional group " << elem->getTag() << " for frame #" << count
+                                                                        << " (internal error)");
+                        delete clone;
+                        delete item;
+                    }
+                    else
+                    {
+                        group        = new OnDemandGroup(item, clone);
+                        group->m_pos = candidates.insert(candidates.end(), group);
+                        numDistinct++;
+                    }
+                }
+                if (group != NULL)
+                {
+                    group->m_refCount++;
+                    frameGroups.push_back(group);
+                }
+            }
+            elem = OFstatic_cast(DcmElement*, oneFrameItem->nextInContainer(elem));
+        }
+        oneFrameItem = OFstatic_cast(DcmItem*, perFrame.nextInContainer(oneFrameItem));
+        count++;
+    }
+    DCMFG_DEBUG("Read " << numDistinct << " distinct per-frame functional groups for " << count << " frames");
+    return EC_Normal;
+}
+
+FGBase* FGInterface::parseOnDemandGroup(OnDemandGroup* group) const
+{
+    if (group->m_group != NULL)
+    {
+        // Mark as most recently used
+        m_parsedGroups.erase(group->m_parsedPos);
+        group->m_parsedPos = m_parsedGroups.insert(m_parsedGroups.end(), group);
+        return group->m_group;
+    }
+
+    const DcmTagKey tag = group->m_sequence->getTag();
+    FGBase* fg          = FGFactory::instance().create(tag);
+    if (fg == NULL)
+    {
+        DCMFG_WARN("Cannot understand functional group for sequence tag: " << tag);
+        return NULL;
+    }
+    if (fg->read(*group->m_item).bad())
+    {
+        // we also accept groups which could be instantiated but not be read
+        DCMFG_WARN("Cannot read functional group: " << DcmFGTypes::tagKey2FGString(tag) << " " << tag
+                                                    << " (ignored)");
+    }
+    group->m_group     = fg;
+    group->m_parsedPos = m_parsedGroups.insert(m_parsedGroups.end(), group);
+    m_parsedSize += group->m_size;
+
+    // Discard least recently used groups if the cache is full
+    while ((m_maxCacheSize > 0) && (m_parsedSize > m_maxCacheSize) && (m_parsedGroups.front() != group))
+    {
+        OnDemandGroup* discard = m_parsedGroups.front();
+        m_parsedGroups.pop_front();
+        m_parsedSize -= discard->m_size;
+        delete discard->m_group;
+        discard->m_group = NULL;
+    }
+    return fg;
+}
+
+void FGInterface::releaseOnDemandGroup(OnDemandGroup* group)
+{
+    if (--group->m_refCount > 0)
+        return;
+
+    if (group->m_group != NULL)
+    {
+        m_parsedGroups.erase(group->m_parsedPos);
+        m_parsedSize -= group->m_size;
+    }
+    m_onDemandGroups[group->m_sequence->getTag()].erase(group->m_pos);
+    delete group;
+}
+
+void FGInterface::convertOnDemandFrame(const Uint32 frameNo)
+{
+    if ((frameNo >= m_onDemandFrames.size()) || (m_perFrame.find(frameNo) != m_perFrame.end()))
+        return;
+
+    DCMFG_TRACE("Converting functional groups read on demand for frame #" << frameNo);
+    OFVector<OnDemandGroup*>& frameGroups = m_onDemandFrames[frameNo];
+    FunctionalGroups* perFrameGroups      = new FunctionalGroups();
+    if (!m_perFrame.insert(OFMake_pair(frameNo, perFrameGroups)).second)
+    {
+        DCMFG_ERROR("Could not store functional groups for frame #" << frameNo << " (internal error)");
+        delete perFrameGroups;
+        perFrameGroups = NULL;
+    }
+    for (size_t count = 0; count < frameGroups.size(); count++)
+    {
+        OnDemandGroup* group = frameGroups[count];
+        FGBase* fg           = (perFrameGroups != NULL) ? parseOnDemandGroup(group) : NULL;
+        if (fg != NULL)
+        {
+            if (group->m_refCount == 1)
+            {
+                // Not used by any other frame, take over the parsed group
+                m_parsedGroups.erase(group->m_parsedPos);
+                m_parsedSize -= group->m_size;
+                group->m_group = NULL;
+            }
+            else
+            {
+                fg = fg->clone();
+            }
+            if (fg == NULL)
+            {
+                DCMFG_ERROR("Could not create functional group for frame #" << frameNo << ": Memory exhausted?");
+            }
+            else if (perFrameGroups->insert(fg, OFTrue).bad())
+            {
+                DCMFG_ERROR("Could not insert functional group for frame #" << frameNo << " (internal error)");
+                delete fg;
+            }
+        }
+        releaseOnDemandGroup(group);
+    }
+    frameGroups.clear();
+}
+
+void FGInterface::convertOnDemandFrames()
+{
+    const size_t numFrames = m_onDemandFrames.size();
+    for (size_t frameNo = 0; frameNo < numFrames; frameNo++)
+    {
+        convertOnDemandFrame(OFstatic_cast(Uint32, frameNo));
+    }
+    m_onDemandFrames.clear();
+}
+
 OFCondition FGInterface::readSingleFG(DcmItem& fgItem, FunctionalGroups& groups)
 {
     OFCondition result;
@@ -328,6 +592,8 @@ OFCondition FGInterface::readSingleFG(DcmItem& fgItem, FunctionalGroups& groups)
 // Write enhanced multi-frame information to DICOM item, usually DcmDataset
 OFCondition FGInterface::write(DcmItem& dataset)
 {
+    convertOnDemandFrames();
+
     // Check data integrity of functional group macros */
     if (m_checkOnWrite)
     {
@@ -357,6 +623,7 @@ OFCondition FGInterface::insertShared(FGBase* group, const OFBool replaceExistin
 
 FGBase* FGInterface::getPerFrame(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType)
 {
+    convertOnDemandFrame(frameNo);
     FGBase* group                                 = NULL;
     OFMap<Uint32, FunctionalGroups*>::iterator it = m_perFrame.find(frameNo);
     if (it != m_perFrame.end())
@@ -381,6 +648,7 @@ OFBool FGInterface::deleteShared(const DcmFGTypes::E_FGType fgType)
 
 OFBool FGInterface::deletePerFrame(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType)
 {
+    convertOnDemandFrame(frameNo);
     OFMap<Uint32, FunctionalGroups*>::iterator it = m_perFrame.find(frameNo);
     if (it != m_perFrame.end())
     {
@@ -401,6 +669,7 @@ OFBool FGInterface::deletePerFrame(const Uint32 frameNo, const DcmFGTypes::E_FGT
 
 size_t FGInterface::deletePerFrame(const DcmFGTypes::E_FGType fgType)
 {
+    convertOnDemandFrames();
     size_t numDeleted      = 0;
     const size_t numFrames = m_perFrame.size();
     for (size_t frameNo = 0; frameNo < numFrames; frameNo++)
@@ -415,6 +684,7 @@ size_t FGInterface::deletePerFrame(const DcmFGTypes::E_FGType fgType)
 
 size_t FGInterface::deleteFrame(const Uint32 frameNo)
 {
+    convertOnDemandFrames();
     OFMap<Uint32, FunctionalGroups*>::iterator it = m_perFrame.find(frameNo);
     if (it != m_perFrame.end())
     {
@@ -442,8 +712,57 @@ OFBool FGInterface::getCheckOnWrite()
     return m_checkOnWrite;
 }
 
+void FGInterface::setReadOnDemand(const OFBool onDemand, const size_t maxCacheSize)
+{
+    m_readOnDemand = onDemand;
+    m_maxCacheSize = maxCacheSize;
+}
+
+OFBool FGInterface::getReadOnDemand() const
+{
+    return m_readOnDemand;
+}
+
+const FGBase* FGInterface::get(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType) const
+{
+    // A frame may contain several unknown functional groups, so there is no
+    // single one to return
+    if ((fgType == DcmFGTypes::EFG_UNKNOWN) || (fgType == DcmFGTypes::EFG_UNDEFINED))
+        return NULL;
+
+    FGBase* group = OFconst_cast(FunctionalGroups&, m_shared).find(fgType);
+    if (group != NULL)
+        return group;
+
+    if ((frameNo < m_onDemandFrames.size()) && (m_perFrame.find(frameNo) == m_perFrame.end()))
+    {
+        // Use shared instance of functional group read on demand, last one wins like in readSingleFG()
+        const OFVector<OnDemandGroup*>& frameGroups = m_onDemandFrames[frameNo];
+        for (size_t count = 0; count < frameGroups.size(); count++)
+        {
+            const DcmFGTypes::E_FGType tagType = DcmFGTypes::tagKey2FGType(frameGroups[count]->m_sequence->getTag());
+            if (tagType == fgType)
+            {
+                // Groups without specific implementation are parsed as unknown group
+                FGBase* fg = parseOnDemandGroup(frameGroups[count]);
+                if ((fg != NULL) && (fg->getType() == fgType))
+                    group = fg;
+            }
+        }
+        return group;
+    }
+
+    OFMap<Uint32, FunctionalGroups*>::const_iterator it = m_perFrame.find(frameNo);
+    if (it != m_perFrame.end())
+    {
+        group = (*it).second->find(fgType);
+    }
+    return group;
+}
+
 FunctionalGroups* FGInterface::getOrCreatePerFrameGroups(const Uint32 frameNo)
 {
+    convertOnDemandFrame(frameNo);
     OFMap<Uint32, FunctionalGroups*>::iterator it = m_perFrame.find(frameNo);
     if (it != m_perFrame.end())
         return (*it).second;
@@ -574,6 +893,7 @@ OFCondition FGInterface::insertPerFrame(const Uint32 frameNo, FGBase* group, con
 
 OFCondition FGInterface::convertSharedToPerFrame(const DcmFGTypes::E_FGType fgType)
 {
+    convertOnDemandFrames();
     FGBase* shared = m_shared.remove(fgType);
     if (!shared)
     {
@@ -621,6 +941,7 @@ FGBase* FGInterface::get(const Uint32 frameNo, const DcmFGTypes::E_FGType fgType
 
 OFBool FGInterface::check()
 {
+    convertOnDemandFrames();
     size_t numFrames = m_perFrame.size();
     DCMFG_DEBUG("Checking functional group structure for " << numFrames << " frames");
     size_t numErrors = 0;
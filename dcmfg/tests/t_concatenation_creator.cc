@@ -22,6 +22,7 @@
 #include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
 
 #include "dcmtk/dcmfg/concatenationcreator.h"
+#include "dcmtk/dcmfg/concatenationloader.h"
 #include "dcmtk/dcmfg/fgtypes.h"
 #include "dcmtk/ofstd/ofstd.h"
 #include "dcmtk/ofstd/ofstream.h"
@@ -76,3 +77,150 @@ OFTEST(dcmfg_concatenation_creator_fail)
     result = cc.writeNextInstance(tf.getFilename());
     OFCHECK(result == FG_EC_NotEnoughFrames);
 }
+
+// Create multi-frame source instance with per-frame functional groups and
+// pixel data where each frame can be identified by its values
+static void
+create_source(DcmDataset& dset, const Uint16 bitsAlloc, const Uint16 rows, const Uint16 cols, const Uint32 numFrames)
+{
+    char uid[100];
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_SOPClassUID, UID_EnhancedCTImageStorage).good());
+    dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT);
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_SOPInstanceUID, uid).good());
+    dcmGenerateUniqueIdentifier(uid, SITE_STUDY_UID_ROOT);
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_StudyInstanceUID, uid).good());
+    dcmGenerateUniqueIdentifier(uid, SITE_SERIES_UID_ROOT);
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_SeriesInstanceUID, uid).good());
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_PatientID, "4711").good());
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_PhotometricInterpretation, "MONOCHROME2").good());
+    OFCHECK(dset.putAndInsertUint16(DCM_SamplesPerPixel, 1).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Rows, rows).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Columns, cols).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsAllocated, bitsAlloc).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsStored, bitsAlloc).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_HighBit, bitsAlloc - 1).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+    OFOStringStream frames;
+    frames << numFrames << OFStringStream_ends;
+    OFSTRINGSTREAM_GETOFSTRING(frames, numFramesStr)
+    OFCHECK(dset.putAndInsertOFStringArray(DCM_NumberOfFrames, numFramesStr).good());
+    DcmItem* item = NULL;
+    OFCHECK(dset.findOrCreateSequenceItem(DCM_SharedFunctionalGroupsSequence, item, 0).good());
+    for (Uint32 f = 0; f < numFrames; f++)
+    {
+        OFCHECK(dset.findOrCreateSequenceItem(DCM_PerFrameFunctionalGroupsSequence, item, f).good());
+        if (item)
+        {
+            DcmItem* fracon = NULL;
+            OFCHECK(item->findOrCreateSequenceItem(DCM_FrameContentSequence, fracon, 0).good());
+            if (fracon)
+                OFCHECK(fracon->putAndInsertUint32(DCM_InStackPositionNumber, f + 1).good());
+        }
+    }
+    const size_t numBytes = (OFstatic_cast(size_t, bitsAlloc) * rows * cols * numFrames + 7) / 8;
+    Uint8* pixData = NULL;
+    DcmPixelData* pixDataElem = new DcmPixelData(DCM_PixelData);
+    OFCHECK(pixDataElem->createUint8Array(OFstatic_cast(Uint32, numBytes + (numBytes & 1)), pixData).good());
+    for (size_t i = 0; i < numBytes; i++)
+        pixData[i] = OFstatic_cast(Uint8, i * 7 + i / 251);
+    // Unused bits of last byte (Bits Allocated = 1) are zero
+    const size_t numBits = OFstatic_cast(size_t, bitsAlloc) * rows * cols * numFrames;
+    if (numBits % 8 != 0)
+        pixData[numBytes - 1] &= OFstatic_cast(Uint8, (1 << (numBits % 8)) - 1);
+    pixDataElem->setVR((bitsAlloc == 16) ? EVR_OW : EVR_OB);
+    OFCHECK(dset.insert(pixDataElem).good());
+}
+
+// Split source file into concatenation, merge it again and compare result with source
+static void check_streaming(const Uint16 bitsAlloc,
+                            const Uint16 rows,
+                            const Uint16 cols,
+                            const Uint32 numFrames,
+                            const E_TransferSyntax writeXfer = EXS_LittleEndianExplicit)
+{
+    DcmFileFormat srcff;
+    create_source(*srcff.getDataset(), bitsAlloc, rows, cols, numFrames);
+    OFTempFile srcFile(O_RDWR, "", "", ".dcm");
+    OFCHECK(srcff.saveFile(srcFile.getFilename(), EXS_LittleEndianExplicit).good());
+
+    // Split source file, reading one instance's pixel data at a time
+    ConcatenationCreator cc;
+    OFCHECK(cc.setCfgFramesPerInstance(8).good());
+    // Input set before is released and not used any longer
+    const size_t numBytes = (OFstatic_cast(size_t, bitsAlloc) * rows * cols * numFrames + 7) / 8;
+    Uint8* otherPixData = new Uint8[numBytes];
+    memset(otherPixData, 0xff, numBytes);
+    OFCHECK(cc.setCfgInput(OFstatic_cast(DcmItem*, srcff.getDataset()->clone()), otherPixData, numBytes, OFTrue /* take ownership */).good());
+    OFCHECK(cc.setCfgInput(srcFile.getFilename()).good());
+    size_t numInstances = cc.getNumInstances();
+    OFCHECK(numInstances == (numFrames + 7) / 8);
+    OFVector<OFTempFile*> instFiles;
+    OFList<OFFilename> instNames;
+    for (size_t i = 0; i < numInstances; i++)
+    {
+        instFiles.push_back(new OFTempFile(O_RDWR, "", "", ".dcm"));
+        instNames.push_back(instFiles.back()->getFilename());
+        OFCHECK(cc.writeNextInstance(instFiles.back()->getFilename()).good());
+    }
+    OFTempFile tf(O_RDWR, "", "", ".dcm");
+    OFCHECK(cc.writeNextInstance(tf.getFilename()) == FG_EC_ConcatenationComplete);
+
+    // Merge concatenation into single file
+    ConcatenationLoader cl;
+    OFCHECK(cl.scan(instNames).good());
+    OFCHECK(cl.getInfo().size() == 1);
+    OFCHECK(cl.getFailedFiles().empty());
+    OFTempFile mergedFile(O_RDWR, "", "", ".dcm");
+    if (cl.getInfo().size() == 1)
+    {
+        OFCHECK(cl.loadToFile(cl.getInfo().begin()->first, mergedFile.getFilename(), writeXfer).good());
+    }
+
+    // Compare with source
+    DcmFileFormat mergedff;
+    OFCHECK(mergedff.loadFile(mergedFile.getFilename()).good());
+    DcmDataset* merged = mergedff.getDataset();
+    DcmDataset* src    = srcff.getDataset();
+    OFString val1, val2;
+    OFCHECK(merged->findAndGetOFStringArray(DCM_SOPInstanceUID, val1).good());
+    OFCHECK(src->findAndGetOFStringArray(DCM_SOPInstanceUID, val2).good());
+    OFCHECK_EQUAL(val1, val2);
+    OFCHECK(merged->findAndGetOFStringArray(DCM_NumberOfFrames, val1).good());
+    OFCHECK(src->findAndGetOFStringArray(DCM_NumberOfFrames, val2).good());
+    OFCHECK_EQUAL(val1, val2);
+    OFCHECK(!merged->tagExists(DCM_ConcatenationUID));
+    DcmElement* perFrame1 = NULL;
+    DcmElement* perFrame2 = NULL;
+    OFCHECK(merged->findAndGetElement(DCM_PerFrameFunctionalGroupsSequence, perFrame1).good());
+    OFCHECK(src->findAndGetElement(DCM_PerFrameFunctionalGroupsSequence, perFrame2).good());
+    if (perFrame1 && perFrame2)
+        OFCHECK(perFrame1->compare(*perFrame2) == 0);
+    DcmElement* pixData1 = NULL;
+    DcmElement* pixData2 = NULL;
+    OFCHECK(merged->findAndGetElement(DCM_PixelData, pixData1).good());
+    OFCHECK(src->findAndGetElement(DCM_PixelData, pixData2).good());
+    if (pixData1 && pixData2)
+    {
+        OFCHECK_EQUAL(pixData1->getLength(), pixData2->getLength());
+        Uint8* data1 = NULL;
+        Uint8* data2 = NULL;
+        OFCHECK(pixData1->getUint8Array(data1).good());
+        OFCHECK(pixData2->getUint8Array(data2).good());
+        if (data1 && data2 && (pixData1->getLength() == pixData2->getLength()))
+            OFCHECK(memcmp(data1, data2, pixData1->getLength()) == 0);
+    }
+    for (size_t i = 0; i < instFiles.size(); i++)
+        delete instFiles[i];
+}
+
+OFTEST(dcmfg_concatenation_streaming)
+{
+    check_streaming(16, 5, 6, 20);
+    check_streaming(16, 5, 6, 20, EXS_BigEndianExplicit);
+    check_streaming(8, 7, 3, 16, EXS_LittleEndianImplicit);
+}
+
+OFTEST(dcmfg_concatenation_streaming_binary)
+{
+    check_streaming(1, 3, 3, 20);
+}
@@ -0,0 +1,166 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmfg
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Tests for reading per-frame functional groups on demand
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmfg/fgfracon.h"
+#include "dcmtk/dcmfg/fginterface.h"
+#include "dcmtk/dcmfg/fgpixmsr.h"
+#include "dcmtk/ofstd/ofcond.h"
+#include "dcmtk/ofstd/oftest.h"
+
+#define NUM_FRAMES 10
+
+// Create dataset with per-frame Pixel Measures (identical for the first and
+// the second half of the frames) and Frame Content (different for each frame)
+static void create_dataset(DcmItem& dataset)
+{
+    FGInterface fg;
+    for (Uint32 frameNo = 0; frameNo < NUM_FRAMES; frameNo++)
+    {
+        FGPixelMeasures pixMsr;
+        OFCHECK(pixMsr.setPixelSpacing((frameNo < NUM_FRAMES / 2) ? "1\\1" : "2\\2").good());
+        OFCHECK(pixMsr.setSliceThickness("0.5").good());
+        OFCHECK(fg.addPerFrame(frameNo, pixMsr).good());
+        FGFrameContent fracon;
+        OFCHECK(fracon.setStackID("1").good());
+        OFCHECK(fracon.setInStackPositionNumber(frameNo + 1).good());
+        OFCHECK(fg.addPerFrame(frameNo, fracon).good());
+    }
+    OFCHECK(fg.write(dataset).good());
+}
+
+static Uint32 get_position(const FGBase* group)
+{
+    Uint32 pos = 0;
+    OFCHECK(group != NULL);
+    if (group != NULL)
+    {
+        FGFrameContent* fracon = OFconst_cast(FGFrameContent*, OFstatic_cast(const FGFrameContent*, group));
+        OFCHECK(fracon->getInStackPositionNumber(pos).good());
+    }
+    return pos;
+}
+
+static Float64 get_spacing(const FGBase* group)
+{
+    Float64 spacing = 0.0;
+    OFCHECK(group != NULL);
+    if (group != NULL)
+    {
+        FGPixelMeasures* pixMsr = OFconst_cast(FGPixelMeasures*, OFstatic_cast(const FGPixelMeasures*, group));
+        OFCHECK(pixMsr->getPixelSpacing(spacing).good());
+    }
+    return spacing;
+}
+
+OFTEST(dcmfg_fginterface_read_on_demand)
+{
+    DcmDataset dataset;
+    create_dataset(dataset);
+
+    // Reference: read and write all functional groups immediately
+    FGInterface regular;
+    OFCHECK(!regular.getReadOnDemand());
+    OFCHECK(regular.read(dataset).good());
+    DcmDataset expected;
+    OFCHECK(regular.write(expected).good());
+
+    FGInterface onDemand;
+    onDemand.setReadOnDemand(OFTrue);
+    OFCHECK(onDemand.getReadOnDemand());
+    OFCHECK(onDemand.read(dataset).good());
+    OFCHECK_EQUAL(onDemand.getNumberOfFrames(), NUM_FRAMES);
+
+    // Identical groups are shared, different ones are not
+    const FGInterface& constFG = onDemand;
+    const FGBase* first        = constFG.get(0, DcmFGTypes::EFG_PIXELMEASURES);
+    OFCHECK(first != NULL);
+    OFCHECK(first == constFG.get(NUM_FRAMES / 2 - 1, DcmFGTypes::EFG_PIXELMEASURES));
+    OFCHECK(first != constFG.get(NUM_FRAMES / 2, DcmFGTypes::EFG_PIXELMEASURES));
+    OFCHECK_EQUAL(get_spacing(first), 1.0);
+    OFCHECK_EQUAL(get_spacing(constFG.get(NUM_FRAMES - 1, DcmFGTypes::EFG_PIXELMEASURES)), 2.0);
+    for (Uint32 frameNo = 0; frameNo < NUM_FRAMES; frameNo++)
+    {
+        OFCHECK_EQUAL(get_position(constFG.get(frameNo, DcmFGTypes::EFG_FRAMECONTENT)), frameNo + 1);
+    }
+    OFCHECK(constFG.get(0, DcmFGTypes::EFG_FRAMEANATOMY) == NULL);
+    OFCHECK(constFG.get(NUM_FRAMES, DcmFGTypes::EFG_FRAMECONTENT) == NULL);
+    OFCHECK(constFG.get(0, DcmFGTypes::EFG_UNKNOWN) == NULL);
+
+    // Only the non-const version converts a frame read on demand
+    OFCHECK(constFG.getPerFrame(0) == NULL);
+    const FunctionalGroups* perFrame = onDemand.getPerFrame(0);
+    OFCHECK(perFrame != NULL);
+    OFCHECK(perFrame == constFG.getPerFrame(0));
+
+    // Writing results in the same dataset
+    DcmDataset result;
+    OFCHECK(onDemand.write(result).good());
+    OFCHECK(result.compare(expected) == 0);
+}
+
+OFTEST(dcmfg_fginterface_read_on_demand_modify)
+{
+    DcmDataset dataset;
+    create_dataset(dataset);
+
+    // Small cache, so that groups are discarded and parsed again
+    FGInterface onDemand;
+    onDemand.setReadOnDemand(OFTrue, 1);
+    OFCHECK(onDemand.read(dataset).good());
+    const FGInterface& constFG = onDemand;
+    for (Uint32 frameNo = 0; frameNo < NUM_FRAMES; frameNo++)
+    {
+        OFCHECK_EQUAL(get_spacing(constFG.get(frameNo, DcmFGTypes::EFG_PIXELMEASURES)),
+                      (frameNo < NUM_FRAMES / 2) ? 1.0 : 2.0);
+        OFCHECK_EQUAL(get_position(constFG.get(frameNo, DcmFGTypes::EFG_FRAMECONTENT)), frameNo + 1);
+    }
+
+    // Modifying a group of one frame does not affect the other frames
+    FGPixelMeasures* pixMsr = OFstatic_cast(FGPixelMeasures*, onDemand.get(1, DcmFGTypes::EFG_PIXELMEASURES));
+    OFCHECK(pixMsr != NULL);
+    if (pixMsr != NULL)
+    {
+        OFCHECK(pixMsr->setPixelSpacing("3\\3").good());
+    }
+    OFCHECK_EQUAL(get_spacing(constFG.get(1, DcmFGTypes::EFG_PIXELMEASURES)), 3.0);
+    OFCHECK_EQUAL(get_spacing(constFG.get(0, DcmFGTypes::EFG_PIXELMEASURES)), 1.0);
+    OFCHECK_EQUAL(get_spacing(constFG.get(2, DcmFGTypes::EFG_PIXELMEASURES)), 1.0);
+    OFCHECK(onDemand.deletePerFrame(3, DcmFGTypes::EFG_PIXELMEASURES));
+    OFCHECK(constFG.get(3, DcmFGTypes::EFG_PIXELMEASURES) == NULL);
+
+    // Write and read again
+    onDemand.setCheckOnWrite(OFFalse);
+    DcmDataset result;
+    OFCHECK(onDemand.write(result).good());
+    FGInterface regular;
+    OFCHECK(regular.read(result).good());
+    OFCHECK_EQUAL(regular.getNumberOfFrames(), NUM_FRAMES);
+    OFCHECK_EQUAL(get_spacing(regular.get(0, DcmFGTypes::EFG_PIXELMEASURES)), 1.0);
+    OFCHECK_EQUAL(get_spacing(regular.get(1, DcmFGTypes::EFG_PIXELMEASURES)), 3.0);
+    OFCHECK(regular.get(3, DcmFGTypes::EFG_PIXELMEASURES) == NULL);
+    OFCHECK_EQUAL(get_spacing(regular.get(NUM_FRAMES - 1, DcmFGTypes::EFG_PIXELMEASURES)), 2.0);
+    for (Uint32 frameNo = 0; frameNo < NUM_FRAMES; frameNo++)
+    {
+        OFCHECK_EQUAL(get_position(regular.get(frameNo, DcmFGTypes::EFG_FRAMECONTENT)), frameNo + 1);
+    }
+}
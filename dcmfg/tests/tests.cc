@@ -26,6 +26,8 @@
 OFTEST_REGISTER(dcmfg_concatenation_creator);
 OFTEST_REGISTER(dcmfg_concatenation_creator_fail);
 OFTEST_REGISTER(dcmfg_concatenation_loader);
+OFTEST_REGISTER(dcmfg_concatenation_streaming);
+OFTEST_REGISTER(dcmfg_concatenation_streaming_binary);
 
 OFTEST_REGISTER(dcmfg_ct_image_frame_type);
 OFTEST_REGISTER(dcmfg_ct_acquisition_type);
@@ -34,6 +36,8 @@ OFTEST_REGISTER(dcmfg_ct_table_dynamics);
 OFTEST_REGISTER(dcmfg_ct_position);
 OFTEST_REGISTER(dcmfg_derivation_image);
 OFTEST_REGISTER(dcmfg_fgbase_fgunknown);
+OFTEST_REGISTER(dcmfg_fginterface_read_on_demand);
+OFTEST_REGISTER(dcmfg_fginterface_read_on_demand_modify);
 OFTEST_REGISTER(dcmfg_frame_content);
 OFTEST_REGISTER(dcmfg_irradiation_event_identification);
 
@@ -0,0 +1,251 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: DicomFrameCursor (Header)
+ *
+ */
+
+
+#ifndef DICURSOR_H
+#define DICURSOR_H
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/oflist.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"
+#endif
+
+#include "dcmtk/dcmimgle/dcmimage.h"
+
+
+/*------------------------*
+ *  forward declarations  *
+ *------------------------*/
+
+class DiFrameCursorThread;
+
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Class for iterating over the frames of a multi-frame image with limited memory.
+ *  The DICOM file or dataset is opened only once, i.e. the header is parsed and the
+ *  pixel data element is prepared for partial access only once.  The frames are then
+ *  decoded chunk by chunk using DicomImage::processNextFrames(), which also continues
+ *  with the current state of the decoder (e.g. the position of the next fragment of
+ *  encapsulated pixel data).  Each decoded frame is made available as a separate
+ *  single-frame DicomImage, which can be used like any other derived image (e.g. for
+ *  rendering with getOutputData() or scaling with createScaledImage()).
+ *  If the toolkit is compiled with thread support, subsequent frames are decoded in a
+ *  background thread into a ring buffer of limited size while the caller processes the
+ *  current frame.  Otherwise, each frame is decoded when it is requested.
+ *  The memory needed is limited to the number of frames in a chunk, the number of
+ *  frames in the ring buffer and the current frame.
+ *  NB: The DICOM dataset passed to this class must neither be accessed nor modified by
+ *      any other thread while the cursor exists.
+ */
+class DCMTK_DCMIMGLE_EXPORT DicomFrameCursor
+{
+
+ public:
+
+    /** constructor, open a DICOM file
+     *
+     ** @param  filename    the DICOM file
+     *  @param  flags       configuration flags (see diutils.h, CIF_UsePartialAccessToPixelData
+     *                      is set automatically)
+     *  @param  fstart      first frame to be processed (0 = 1st frame)
+     *  @param  fcount      number of frames to be processed (0 = all remaining frames)
+     *  @param  chunkSize   number of frames decoded at once (0 = default, i.e. 4)
+     *  @param  bufferSize  maximum number of decoded frames waiting in the ring buffer
+     *                      (0 = default, i.e. 8)
+     */
+    DicomFrameCursor(const char *filename,
+                     const unsigned long flags = 0,
+                     const unsigned long fstart = 0,
+                     const unsigned long fcount = 0,
+                     const unsigned long chunkSize = 0,
+                     const unsigned long bufferSize = 0);
+
+    /** constructor, use a given DcmObject
+     *
+     ** @param  object      pointer to DICOM data structures (fileformat, dataset or item).
+     *                      (do not delete while referenced, i.e. while this cursor or any
+     *                       frame created by it exists; not deleted within this class unless
+     *                       configuration flag CIF_TakeOverExternalDataset is set)
+     *  @param  xfer        transfer syntax of the 'object'.
+     *                      (could also be EXS_Unknown in case of fileformat or dataset)
+     *  @param  flags       configuration flags (see diutils.h, CIF_UsePartialAccessToPixelData
+     *                      is set automatically)
+     *  @param  fstart      first frame to be processed (0 = 1st frame)
+     *  @param  fcount      number of frames to be processed (0 = all remaining frames)
+     *  @param  chunkSize   number of frames decoded at once (0 = default, i.e. 4)
+     *  @param  bufferSize  maximum number of decoded frames waiting in the ring buffer
+     *                      (0 = default, i.e. 8)
+     */
+    DicomFrameCursor(DcmObject *object,
+                     const E_TransferSyntax xfer,
+                     const unsigned long flags = 0,
+                     const unsigned long fstart = 0,
+                     const unsigned long fcount = 0,
+                     const unsigned long chunkSize = 0,
+                     const unsigned long bufferSize = 0);
+
+    /** destructor.
+     *  Stops the background thread (if any) and deletes all frames not yet fetched as
+     *  well as the current frame.
+     */
+    virtual ~DicomFrameCursor();
+
+    /** get current status information.
+     *  The status refers to the image object used for decoding the frames.
+     *
+     ** @return status code
+     */
+    inline EI_Status getStatus() const
+    {
+        return Status;
+    }
+
+    /** get number of frames to be processed by this cursor
+     *
+     ** @return number of frames (see constructor parameters 'fstart' and 'fcount')
+     */
+    inline unsigned long getFrameCount() const
+    {
+        return FrameCount;
+    }
+
+    /** get index of the first frame processed by this cursor
+     *
+     ** @return index of first frame (0..n-1)
+     */
+    inline unsigned long getFirstFrame() const
+    {
+        return FirstFrame;
+    }
+
+    /** get number of frames stored in the DICOM file/dataset
+     *
+     ** @return number of frames stored in the DICOM file/dataset, 0 in case of error
+     */
+    inline unsigned long getNumberOfFrames() const
+    {
+        return NumberOfFrames;
+    }
+
+    /** get index of the current frame, i.e. the frame returned by the last call of
+     *  getNextFrame()
+     *
+     ** @return index of current frame in the DICOM file/dataset (0..n-1), or the number
+     *    of frames stored in the DICOM file/dataset if there is no current frame
+     */
+    inline unsigned long getCurrentFrameNumber() const
+    {
+        return (Current != NULL) ? FirstFrame + FramesFetched - 1 : NumberOfFrames;
+    }
+
+    /** get current frame, i.e. the frame returned by the last call of getNextFrame()
+     *
+     ** @return pointer to current frame (owned by this cursor), NULL if none
+     */
+    inline DicomImage *getCurrentFrame() const
+    {
+        return Current;
+    }
+
+    /** advance to the next frame.
+     *  The previously current frame is deleted, i.e. all pointers to it or to its output
+     *  data become invalid.  Use DicomImage::createDicomImage() in order to keep a copy.
+     *  If the next frame has not yet been decoded by the background thread, this method
+     *  waits until it is available.
+     *
+     ** @return pointer to single-frame image (owned by this cursor and valid until the
+     *    next call of this method), NULL if there are no more frames or in case of error
+     */
+    DicomImage *getNextFrame();
+
+
+ protected:
+
+    /** initialize the cursor after the image object used for decoding has been created
+     *
+     ** @param  fcount  number of frames to be processed (0 = all remaining frames)
+     */
+    void Init(const unsigned long fcount);
+
+    /** decode the next frame (or chunk of frames if required).
+     *  This method is called either by the background thread or, if no thread is
+     *  running, by getNextFrame().
+     *
+     ** @return pointer to new single-frame image, NULL if there are no more frames or
+     *    in case of error
+     */
+    DicomImage *decodeNextFrame();
+
+
+ private:
+
+    friend class DiFrameCursorThread;
+
+    /// image object used for decoding the frames chunk by chunk
+    DicomImage *Decoder;
+    /// status of the decoding image object
+    EI_Status Status;
+    /// index of the first frame processed by this cursor
+    unsigned long FirstFrame;
+    /// number of frames to be processed by this cursor
+    unsigned long FrameCount;
+    /// number of frames stored in the DICOM file/dataset
+    unsigned long NumberOfFrames;
+    /// number of frames decoded at once
+    unsigned long ChunkSize;
+    /// index of the next frame to be taken from the current chunk of the decoder
+    unsigned long ChunkPosition;
+    /// number of frames decoded so far
+    unsigned long FramesDecoded;
+    /// number of frames fetched by the caller so far
+    unsigned long FramesFetched;
+    /// current frame
+    DicomImage *Current;
+    /// ring buffer of decoded frames not yet fetched
+    OFList<DicomImage *> Frames;
+
+#ifdef WITH_THREADS
+    /// background thread decoding the frames (NULL if none)
+    DiFrameCursorThread *Thread;
+    /// number of free entries in the ring buffer
+    OFSemaphore FreeSlots;
+    /// number of decoded frames in the ring buffer (plus one at the end of decoding)
+    OFSemaphore UsedSlots;
+    /// mutex protecting the ring buffer and the stop flag
+    OFMutex FrameMutex;
+    /// set by the destructor to request the background thread to stop
+    OFBool StopRequested;
+#endif
+
+ // --- declarations to avoid compiler warnings
+
+    DicomFrameCursor(const DicomFrameCursor &);
+    DicomFrameCursor &operator=(const DicomFrameCursor &);
+};
+
+
+#endif
@@ -374,6 +374,12 @@ class DiInputPixelTemplate
         const Uint16 bitsof_T1 = bitsof(T1);
         const Uint16 bitsof_T2 = bitsof(T2);
         const OFBool uncompressed = pixelData->canWriteXfer(EXS_LittleEndianExplicit, EXS_Unknown);
+        /* stored pixel values can be used without any conversion (see case 1a below). The temporary
+         * buffer and the element value are allocated as arrays of 8 bit values, so they can only be
+         * taken over as the input representation if the pixel values are also 8 bit (Uint8 or Sint8).
+         * Otherwise, the buffer would later be deleted through a pointer to a different type.
+         */
+        const OFBool sameLayout = (sizeof(T1) == 1) && (sizeof(T2) == 1) && (bitsof_T1 == bitsAllocated) && (bitsStored == bitsAllocated);
         /* check whether to use partial read */
         if ((document->getFlags() & CIF_UsePartialAccessToPixelData) && (PixelCount > 0) && (bitsAllocated % 8 == 0))
         {
@@ -452,6 +458,22 @@ class DiInputPixelTemplate
             DCMIMGLE_DEBUG("reading uncompressed pixel data completely into memory");
             /* always access complete pixel data */
             lengthBytes = getPixelData(pixelData, pixel);
+#if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
+            /* take over the element value if it is not needed any longer (see DiImage::detachPixelData())
+             * and no conversion is required, i.e. it can be used as the input representation directly
+             */
+            if (sameLayout && (pixel != NULL) && (lengthBytes > 0) &&
+                (document->getFlags() & CIF_MayDetachPixelData) && !(document->getFlags() & CIF_UsePartialAccessToPixelData))
+            {
+                if (pixelData->detachValueField(OFFalse /*copy*/).good())
+                {
+                    DCMIMGLE_DEBUG("detached pixel data from DICOM dataset in order to use it as input representation");
+                    /* also remove all other representations, as DiImage::detachPixelData() would do */
+                    pixelData->putUint16Array(NULL, 0);
+                    deletePixel = OFTrue;
+                }
+            }
+#endif
         }
         if ((pixel != NULL) && (lengthBytes > 0))
         {
@@ -462,6 +484,18 @@ class DiInputPixelTemplate
 //          # old code: Count = ((lengthBytes * 8) + bitsAllocated - 1) / bitsAllocated;
             Count = 8 * length_B1 + (8 * length_B2 + bitsAllocated - 1) / bitsAllocated;
             unsigned long i;
+#if defined(HAVE_STD__NOTHROW) && defined(HAVE_NOTHROW_DELETE)
+            if (deletePixel && sameLayout)
+            {
+                /* the temporary buffer already contains the input representation, so there is no need
+                 * to copy it. Both T1 and T2 are 8 bit types in this case (see 'sameLayout' above).
+                 */
+                DCMIMGLE_DEBUG("convert input pixel data: case 1a (no copy required)");
+                Data = OFreinterpret_cast(T2 *, pixel);
+                deletePixel = OFFalse;
+                pixel = NULL;
+            } else
+#endif
 #ifdef HAVE_STD__NOTHROW
             /* use a non-throwing new here (if available) because the allocated buffer can be huge */
             Data = new (std::nothrow) T2[Count];
@@ -476,7 +510,7 @@ class DiInputPixelTemplate
                 Data = NULL;
             }
 #endif
-            if (Data != NULL)
+            if ((Data != NULL) && (pixel != NULL))
             {
                 DCMIMGLE_TRACE("Input length: " << lengthBytes << " bytes, Pixel count: " << Count
                     << " (" << PixelCount << "), In: " << bitsof_T1 << " bits, Out: " << bitsof_T2
@@ -644,7 +678,8 @@ class DiInputPixelTemplate
                         }
                     }
                 }
-            } else
+            }
+            else if (Data == NULL)
                 DCMIMGLE_DEBUG("cannot allocate memory buffer for 'Data' in DiInputPixelTemplate::convert()");
         } else {
             /* in case of error, reset pixel count variable */
@@ -0,0 +1,290 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: DicomFrameCursor (Source)
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/dcmimgle/dicursor.h"
+
+
+/*------------------*
+ *  default values  *
+ *------------------*/
+
+/// default number of frames decoded at once
+#define DEFAULT_CHUNK_SIZE   4
+/// default maximum number of decoded frames in the ring buffer
+#define DEFAULT_BUFFER_SIZE  8
+
+
+#ifdef WITH_THREADS
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Background thread decoding the frames of a DicomFrameCursor into its ring buffer
+ */
+class DiFrameCursorThread
+  : public OFThread
+{
+
+ public:
+
+    /** constructor
+     *
+     ** @param  cursor  cursor to be served by this thread
+     */
+    DiFrameCursorThread(DicomFrameCursor *cursor)
+      : OFThread(),
+        Cursor(cursor)
+    {
+    }
+
+ protected:
+
+    /** decode frames until all frames are decoded or the cursor requests to stop
+     */
+    virtual void run()
+    {
+        DicomImage *frame;
+        OFBool stop;
+        do {
+            /* wait for a free entry in the ring buffer */
+            Cursor->FreeSlots.wait();
+            Cursor->FrameMutex.lock();
+            stop = Cursor->StopRequested;
+            Cursor->FrameMutex.unlock();
+            if (stop)
+                break;
+            frame = Cursor->decodeNextFrame();
+            if (frame != NULL)
+            {
+                Cursor->FrameMutex.lock();
+                Cursor->Frames.push_back(frame);
+                Cursor->FrameMutex.unlock();
+            }
+            Cursor->UsedSlots.post();
+        } while (frame != NULL);
+    }
+
+ private:
+
+    /// cursor to be served by this thread (not owned)
+    DicomFrameCursor *Cursor;
+};
+
+#endif
+
+
+/*----------------*
+ *  constructors  *
+ *----------------*/
+
+DicomFrameCursor::DicomFrameCursor(const char *filename,
+                                   const unsigned long flags,
+                                   const unsigned long fstart,
+                                   const unsigned long fcount,
+                                   const unsigned long chunkSize,
+                                   const unsigned long bufferSize)
+  : Decoder(NULL),
+    Status(EIS_InvalidDocument),
+    FirstFrame(fstart),
+    FrameCount(0),
+    NumberOfFrames(0),
+    ChunkSize((chunkSize > 0) ? chunkSize : DEFAULT_CHUNK_SIZE),
+    ChunkPosition(0),
+    FramesDecoded(0),
+    FramesFetched(0),
+    Current(NULL),
+    Frames()
+#ifdef WITH_THREADS
+  , Thread(NULL),
+    FreeSlots(OFstatic_cast(unsigned int, (bufferSize > 0) ? bufferSize : DEFAULT_BUFFER_SIZE)),
+    UsedSlots(0),
+    FrameMutex(),
+    StopRequested(OFFalse)
+#endif
+{
+    if (fcount > 0)
+        ChunkSize = (fcount < ChunkSize) ? fcount : ChunkSize;
+    Decoder = new DicomImage(filename, flags | CIF_UsePartialAccessToPixelData, fstart, ChunkSize);
+    Init(fcount);
+}
+
+
+DicomFrameCursor::DicomFrameCursor(DcmObject *object,
+                                   const E_TransferSyntax xfer,
+                                   const unsigned long flags,
+                                   const unsigned long fstart,
+                                   const unsigned long fcount,
+                                   const unsigned long chunkSize,
+                                   const unsigned long bufferSize)
+  : Decoder(NULL),
+    Status(EIS_InvalidDocument),
+    FirstFrame(fstart),
+    FrameCount(0),
+    NumberOfFrames(0),
+    ChunkSize((chunkSize > 0) ? chunkSize : DEFAULT_CHUNK_SIZE),
+    ChunkPosition(0),
+    FramesDecoded(0),
+    FramesFetched(0),
+    Current(NULL),
+    Frames()
+#ifdef WITH_THREADS
+  , Thread(NULL),
+    FreeSlots(OFstatic_cast(unsigned int, (bufferSize > 0) ? bufferSize : DEFAULT_BUFFER_SIZE)),
+    UsedSlots(0),
+    FrameMutex(),
+    StopRequested(OFFalse)
+#endif
+{
+    if (fcount > 0)
+        ChunkSize = (fcount < ChunkSize) ? fcount : ChunkSize;
+    Decoder = new DicomImage(object, xfer, flags | CIF_UsePartialAccessToPixelData, fstart, ChunkSize);
+    Init(fcount);
+}
+
+
+/*--------------*
+ *  destructor  *
+ *--------------*/
+
+DicomFrameCursor::~DicomFrameCursor()
+{
+#ifdef WITH_THREADS
+    if (Thread != NULL)
+    {
+        /* request the background thread to stop and wake it up */
+        FrameMutex.lock();
+        StopRequested = OFTrue;
+        FrameMutex.unlock();
+        FreeSlots.post();
+        Thread->join();
+        delete Thread;
+    }
+#endif
+    OFListIterator(DicomImage *) iter = Frames.begin();
+    while (iter != Frames.end())
+    {
+        delete (*iter);
+        ++iter;
+    }
+    delete Current;
+    delete Decoder;
+}
+
+
+/********************************************************************/
+
+
+void DicomFrameCursor::Init(const unsigned long fcount)
+{
+    if (Decoder != NULL)
+    {
+        Status = Decoder->getStatus();
+        if (Status == EIS_Normal)
+        {
+            NumberOfFrames = Decoder->getNumberOfFrames();
+            if (FirstFrame < NumberOfFrames)
+            {
+                FrameCount = NumberOfFrames - FirstFrame;
+                if ((fcount > 0) && (fcount < FrameCount))
+                    FrameCount = fcount;
+            }
+        }
+    } else
+        Status = EIS_MemoryFailure;
+#ifdef WITH_THREADS
+    if (FrameCount > 0)
+    {
+        Thread = new DiFrameCursorThread(this);
+        if (Thread->start() != 0)
+        {
+            /* decode frames on demand if the thread could not be started */
+            DCMIMGLE_WARN("cannot start background thread for decoding frames, decoding on demand");
+            delete Thread;
+            Thread = NULL;
+        }
+    }
+#endif
+}
+
+
+DicomImage *DicomFrameCursor::decodeNextFrame()
+{
+    if ((Decoder == NULL) || (FramesDecoded >= FrameCount))
+        return NULL;
+    /* all frames of the current chunk processed, continue with the next one */
+    if (ChunkPosition >= Decoder->getFrameCount())
+    {
+        const unsigned long remaining = FrameCount - FramesDecoded;
+        if (!Decoder->processNextFrames((remaining < ChunkSize) ? remaining : ChunkSize))
+        {
+            DCMIMGLE_ERROR("cannot decode frame " << (FirstFrame + FramesDecoded));
+            return NULL;
+        }
+        ChunkPosition = 0;
+    }
+    DicomImage *frame = Decoder->createDicomImage(ChunkPosition, 1);
+    if (frame != NULL)
+    {
+        ++ChunkPosition;
+        ++FramesDecoded;
+    }
+    return frame;
+}
+
+
+DicomImage *DicomFrameCursor::getNextFrame()
+{
+    delete Current;
+    Current = NULL;
+    if (FramesFetched >= FrameCount)
+        return NULL;
+#ifdef WITH_THREADS
+    if (Thread != NULL)
+    {
+        /* wait for the next decoded frame (or the end of stream) */
+        UsedSlots.wait();
+        FrameMutex.lock();
+        if (!Frames.empty())
+        {
+            Current = Frames.front();
+            Frames.pop_front();
+        }
+        FrameMutex.unlock();
+        if (Current != NULL)
+        {
+            FreeSlots.post();
+            ++FramesFetched;
+        } else {
+            /* decoding stopped prematurely, make sure that subsequent calls do not block */
+            UsedSlots.post();
+        }
+        return Current;
+    }
+#endif
+    Current = decodeNextFrame();
+    if (Current != NULL)
+        ++FramesFetched;
+    return Current;
+}
@@ -0,0 +1,195 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for class DicomFrameCursor
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmimgle/dicursor.h"
+
+#define NUM_ROWS    3
+#define NUM_COLUMNS 4
+#define NUM_FRAMES  10
+#define NUM_PIXELS  (NUM_ROWS * NUM_COLUMNS)
+
+
+// create a monochrome multi-frame image with different pixel values in each frame
+static void createImage(DcmDataset &dataset)
+{
+    Uint16 pixels[NUM_FRAMES * NUM_PIXELS];
+    for (size_t i = 0; i < NUM_FRAMES * NUM_PIXELS; i++)
+        pixels[i] = OFstatic_cast(Uint16, (i / NUM_PIXELS) * 100 + (i % NUM_PIXELS));
+    OFCHECK(dataset.putAndInsertUint16(DCM_SamplesPerPixel, 1).good());
+    OFCHECK(dataset.putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2").good());
+    OFCHECK(dataset.putAndInsertUint16(DCM_Rows, NUM_ROWS).good());
+    OFCHECK(dataset.putAndInsertUint16(DCM_Columns, NUM_COLUMNS).good());
+    OFCHECK(dataset.putAndInsertString(DCM_NumberOfFrames, "10").good());
+    OFCHECK(dataset.putAndInsertUint16(DCM_BitsAllocated, 16).good());
+    OFCHECK(dataset.putAndInsertUint16(DCM_BitsStored, 16).good());
+    OFCHECK(dataset.putAndInsertUint16(DCM_HighBit, 15).good());
+    OFCHECK(dataset.putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+    OFCHECK(dataset.putAndInsertUint16Array(DCM_PixelData, pixels, NUM_FRAMES * NUM_PIXELS).good());
+}
+
+
+// create a DICOM file with the multi-frame image
+static void createImageFile(const char *filename)
+{
+    DcmFileFormat fileformat;
+    createImage(*fileformat.getDataset());
+    OFCHECK(fileformat.saveFile(filename, EXS_LittleEndianExplicit).good());
+}
+
+
+// check that the given frame has the same output data as the frame of the reference image
+static void checkFrame(DicomImage *frame, DicomImage &reference, const unsigned long frameNumber)
+{
+    OFCHECK(frame != NULL);
+    if (frame != NULL)
+    {
+        OFCHECK_EQUAL(frame->getStatus(), EIS_Normal);
+        OFCHECK_EQUAL(frame->getFrameCount(), 1);
+        /* use the same VOI window for both images */
+        OFCHECK(frame->setWindow(512, 1024));
+        const unsigned long size = reference.getOutputDataSize(16);
+        OFCHECK_EQUAL(frame->getOutputDataSize(16), size);
+        const Uint8 *expected = OFstatic_cast(const Uint8 *, reference.getOutputData(16, frameNumber));
+        const Uint8 *data = OFstatic_cast(const Uint8 *, frame->getOutputData(16, 0));
+        OFCHECK((expected != NULL) && (data != NULL));
+        if ((expected != NULL) && (data != NULL))
+        {
+            unsigned long i = 0;
+            while ((i < size) && (data[i] == expected[i]))
+                ++i;
+            OFCHECK_EQUAL(i, size);
+        }
+    }
+}
+
+
+OFTEST(dcmimgle_frameCursor_file)
+{
+    OFTempFile tempFile(O_RDWR, "", "tcursor", ".dcm");
+    OFCHECK(tempFile.getStatus().good());
+    createImageFile(tempFile.getFilename());
+    DicomImage reference(tempFile.getFilename());
+    OFCHECK_EQUAL(reference.getStatus(), EIS_Normal);
+    OFCHECK(reference.setWindow(512, 1024));
+
+    // frames 2 to 8 in chunks of 3 frames (the last chunk is incomplete)
+    DicomFrameCursor cursor(tempFile.getFilename(), 0, 2, 7, 3, 2);
+    OFCHECK_EQUAL(cursor.getStatus(), EIS_Normal);
+    OFCHECK_EQUAL(cursor.getNumberOfFrames(), NUM_FRAMES);
+    OFCHECK_EQUAL(cursor.getFirstFrame(), 2);
+    OFCHECK_EQUAL(cursor.getFrameCount(), 7);
+    OFCHECK(cursor.getCurrentFrame() == NULL);
+    for (unsigned long i = 2; i < 9; i++)
+    {
+        DicomImage *frame = cursor.getNextFrame();
+        OFCHECK(frame == cursor.getCurrentFrame());
+        OFCHECK_EQUAL(cursor.getCurrentFrameNumber(), i);
+        checkFrame(frame, reference, i);
+    }
+
+    // no more frames, also not when asking again
+    OFCHECK(cursor.getNextFrame() == NULL);
+    OFCHECK(cursor.getCurrentFrame() == NULL);
+    OFCHECK_EQUAL(cursor.getCurrentFrameNumber(), NUM_FRAMES);
+    OFCHECK(cursor.getNextFrame() == NULL);
+}
+
+
+OFTEST(dcmimgle_frameCursor_dataset)
+{
+    DcmDataset dataset;
+    createImage(dataset);
+    DicomImage reference(&dataset, EXS_LittleEndianExplicit);
+    OFCHECK_EQUAL(reference.getStatus(), EIS_Normal);
+    OFCHECK(reference.setWindow(512, 1024));
+
+    // all remaining frames, chunk size does not divide the number of frames
+    DicomFrameCursor cursor(&dataset, EXS_LittleEndianExplicit, 0, 5, 0, 4);
+    OFCHECK_EQUAL(cursor.getStatus(), EIS_Normal);
+    OFCHECK_EQUAL(cursor.getFrameCount(), NUM_FRAMES - 5);
+    unsigned long count = 0;
+    DicomImage *frame;
+    while ((frame = cursor.getNextFrame()) != NULL)
+        checkFrame(frame, reference, 5 + count++);
+    OFCHECK_EQUAL(count, NUM_FRAMES - 5);
+
+    // first frame behind the last frame
+    DicomFrameCursor empty(&dataset, EXS_LittleEndianExplicit, 0, NUM_FRAMES);
+    OFCHECK_EQUAL(empty.getFrameCount(), 0);
+    OFCHECK(empty.getNextFrame() == NULL);
+}
+
+
+OFTEST(dcmimgle_frameCursor_destroy)
+{
+    DcmDataset dataset;
+    createImage(dataset);
+
+    // destroy cursors while frames are still being decoded or waiting to be fetched
+    for (unsigned long fetch = 0; fetch < 3; fetch++)
+    {
+        DicomFrameCursor *cursor = new DicomFrameCursor(&dataset, EXS_LittleEndianExplicit, 0, 0, 0, 1, 2);
+        OFCHECK_EQUAL(cursor->getStatus(), EIS_Normal);
+        for (unsigned long i = 0; i < fetch; i++)
+            OFCHECK(cursor->getNextFrame() != NULL);
+        delete cursor;
+    }
+
+    // the dataset can still be used afterwards
+    DicomFrameCursor cursor(&dataset, EXS_LittleEndianExplicit);
+    unsigned long count = 0;
+    while (cursor.getNextFrame() != NULL)
+        ++count;
+    OFCHECK_EQUAL(count, NUM_FRAMES);
+}
+
+
+OFTEST(dcmimgle_frameCursor_invalid)
+{
+    // file does not exist
+    DicomFrameCursor missing("no_such_file.dcm");
+    OFCHECK(missing.getStatus() != EIS_Normal);
+    OFCHECK_EQUAL(missing.getFrameCount(), 0);
+    OFCHECK_EQUAL(missing.getNumberOfFrames(), 0);
+    OFCHECK(missing.getNextFrame() == NULL);
+
+    // file is not a DICOM file
+    OFTempFile tempFile(O_RDWR, "", "tcursor", ".dcm");
+    OFCHECK(tempFile.getStatus().good());
+    DicomFrameCursor invalid(tempFile.getFilename());
+    OFCHECK(invalid.getStatus() != EIS_Normal);
+    OFCHECK_EQUAL(invalid.getFrameCount(), 0);
+    OFCHECK(invalid.getNextFrame() == NULL);
+    OFCHECK(invalid.getNextFrame() == NULL);
+
+    // dataset without pixel data
+    DcmDataset dataset;
+    DicomFrameCursor noImage(&dataset, EXS_LittleEndianExplicit);
+    OFCHECK(noImage.getStatus() != EIS_Normal);
+    OFCHECK(noImage.getNextFrame() == NULL);
+}
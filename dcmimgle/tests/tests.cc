@@ -0,0 +1,32 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: main test program
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/ofstd/oftest.h"
+
+OFTEST_REGISTER(dcmimgle_frameCursor_file);
+OFTEST_REGISTER(dcmimgle_frameCursor_dataset);
+OFTEST_REGISTER(dcmimgle_frameCursor_destroy);
+OFTEST_REGISTER(dcmimgle_frameCursor_invalid);
+OFTEST_REGISTER(dcmimgle_inputPixelData_unsigned8);
+OFTEST_REGISTER(dcmimgle_inputPixelData_signed8);
+OFTEST_REGISTER(dcmimgle_inputPixelData_signed16);
+OFTEST_MAIN("dcmimgle")
@@ -0,0 +1,134 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for the conversion of the input pixel data
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmimgle/dcmimage.h"
+
+#define NUM_ROWS    5
+#define NUM_COLUMNS 3
+#define NUM_FRAMES  4
+#define NUM_PIXELS  (NUM_ROWS * NUM_COLUMNS * NUM_FRAMES)
+
+
+// create a DICOM file with a monochrome multi-frame image
+static void createImageFile(const char *filename, const Uint16 bitsAllocated, const Uint16 pixelRep)
+{
+    DcmFileFormat fileformat;
+    DcmDataset *dataset = fileformat.getDataset();
+    OFCHECK(dataset->putAndInsertUint16(DCM_SamplesPerPixel, 1).good());
+    OFCHECK(dataset->putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2").good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_Rows, NUM_ROWS).good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_Columns, NUM_COLUMNS).good());
+    OFCHECK(dataset->putAndInsertString(DCM_NumberOfFrames, "4").good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_BitsAllocated, bitsAllocated).good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_BitsStored, bitsAllocated).good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_HighBit, bitsAllocated - 1).good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_PixelRepresentation, pixelRep).good());
+    if (bitsAllocated == 8)
+    {
+        /* use OB, so that the stored values can be used as the input representation */
+        Uint8 pixels[NUM_PIXELS];
+        for (size_t i = 0; i < NUM_PIXELS; i++)
+            pixels[i] = OFstatic_cast(Uint8, i * 17);
+        OFCHECK(dataset->putAndInsertUint8Array(DCM_PixelData, pixels, NUM_PIXELS).good());
+    } else {
+        Uint16 pixels[NUM_PIXELS];
+        for (size_t i = 0; i < NUM_PIXELS; i++)
+            pixels[i] = OFstatic_cast(Uint16, i * 4111);
+        OFCHECK(dataset->putAndInsertUint16Array(DCM_PixelData, pixels, NUM_PIXELS).good());
+    }
+    OFCHECK(fileformat.saveFile(filename, EXS_LittleEndianExplicit).good());
+}
+
+
+// check that both images have the same output data for all frames
+static void checkSameOutput(DicomImage &image, DicomImage &reference, const int bits)
+{
+    OFCHECK_EQUAL(image.getStatus(), EIS_Normal);
+    OFCHECK_EQUAL(reference.getStatus(), EIS_Normal);
+    OFCHECK_EQUAL(image.getFrameCount(), reference.getFrameCount());
+    const unsigned long size = reference.getOutputDataSize(bits);
+    OFCHECK(size > 0);
+    OFCHECK_EQUAL(image.getOutputDataSize(bits), size);
+    for (unsigned long frame = 0; frame < reference.getFrameCount(); frame++)
+    {
+        const Uint8 *expected = OFstatic_cast(const Uint8 *, reference.getOutputData(bits, frame));
+        const Uint8 *data = OFstatic_cast(const Uint8 *, image.getOutputData(bits, frame));
+        OFCHECK((expected != NULL) && (data != NULL));
+        if ((expected != NULL) && (data != NULL))
+        {
+            unsigned long i = 0;
+            while ((i < size) && (data[i] == expected[i]))
+                ++i;
+            OFCHECK_EQUAL(i, size);
+        }
+    }
+}
+
+
+// compare the images created with and without taking over the stored pixel values
+static void checkInputPixelData(const Uint16 bitsAllocated, const Uint16 pixelRep)
+{
+    OFTempFile tempFile(O_RDWR, "", "tinpxt", ".dcm");
+    OFCHECK(tempFile.getStatus().good());
+    createImageFile(tempFile.getFilename(), bitsAllocated, pixelRep);
+
+    // copy: the dataset is owned by the caller, so the pixel data may not be detached
+    DcmFileFormat fileformat;
+    OFCHECK(fileformat.loadFile(tempFile.getFilename()).good());
+    DicomImage copied(&fileformat, EXS_Unknown);
+    OFCHECK(copied.setNoVoiTransformation());
+    OFCHECK(fileformat.getDataset()->tagExistsWithValue(DCM_PixelData));
+
+    // detach: the element value is used directly if no conversion is required
+    DicomImage detached(tempFile.getFilename());
+    OFCHECK(detached.setNoVoiTransformation());
+    checkSameOutput(detached, copied, bitsAllocated);
+
+    // partial access: the temporary buffer is used directly if no conversion is required
+    DicomImage partial(tempFile.getFilename(), CIF_UsePartialAccessToPixelData);
+    OFCHECK(partial.setNoVoiTransformation());
+    checkSameOutput(partial, copied, bitsAllocated);
+}
+
+
+OFTEST(dcmimgle_inputPixelData_unsigned8)
+{
+    checkInputPixelData(8, 0);
+}
+
+
+OFTEST(dcmimgle_inputPixelData_signed8)
+{
+    checkInputPixelData(8, 1);
+}
+
+
+OFTEST(dcmimgle_inputPixelData_signed16)
+{
+    checkInputPixelData(16, 1);
+}
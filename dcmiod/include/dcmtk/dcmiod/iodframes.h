@@ -0,0 +1,219 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module: dcmiod
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Class for storing the frames of a multi-frame image in place
+ *
+ */
+
+#ifndef IODFRAMES_H
+#define IODFRAMES_H
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmdata/dctagkey.h"
+#include "dcmtk/dcmiod/ioddef.h"
+#include "dcmtk/ofstd/ofcond.h"
+
+class DcmElement;
+class DcmItem;
+
+/** Class that stores all (uncompressed) frames of a multi-frame image
+ *  contiguously within a single pixel data element, i.e.\ Pixel Data (OB/OW),
+ *  Float Pixel Data (OF) or Double Float Pixel Data (OD). Frames are written
+ *  and read in place, so no copy of the pixel data is needed when creating
+ *  the element for writing or when taking it over after reading a file.
+ *  The frame memory is kept in local byte order, i.e.\ 16 bit samples of
+ *  Pixel Data are stored as OW in local byte order and 8 bit samples as OB
+ *  (byte by byte). Pointers to frames become
+ *  invalid whenever the store has to grow, i.e.\ use reserve() beforehand if
+ *  frames should be filled in place one after another.
+ */
+class DCMTK_DCMIOD_EXPORT IODFrameStore
+{
+public:
+    /** Constructor, creates empty store (no pixel data element)
+     */
+    IODFrameStore();
+
+    /** Copy constructor, copies all frames
+     *  @param  rhs The store to copy from
+     */
+    IODFrameStore(const IODFrameStore& rhs);
+
+    /** Assignment operator, copies all frames
+     *  @param  rhs The store to copy from
+     *  @return Reference to this object
+     */
+    IODFrameStore& operator=(const IODFrameStore& rhs);
+
+    /** Destructor, frees memory
+     */
+    ~IODFrameStore();
+
+    /** Initialize store for a given pixel data attribute and frame size.
+     *  All frames currently contained are removed.
+     *  @param  pixelDataTag The pixel data attribute to use, i.e.\ DCM_PixelData,
+     *          DCM_FloatPixelData or DCM_DoubleFloatPixelData
+     *  @param  bytesPerFrame The number of bytes per frame (must not be 0)
+     *  @param  bitsAllocated The number of bits allocated per sample, 8 or 16.
+     *          Only used for DCM_PixelData.
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition init(const DcmTagKey& pixelDataTag, const size_t bytesPerFrame, const Uint16 bitsAllocated = 16);
+
+    /** Check whether store has been initialized, i.e.\ whether the frame size
+     *  is known
+     *  @return OFTrue if store has been initialized, OFFalse otherwise
+     */
+    OFBool isInitialized() const;
+
+    /** Remove all frames and free memory. The store must be initialized again
+     *  before being used.
+     */
+    void clear();
+
+    /** Make sure that memory for the given number of frames is available, so
+     *  that frames can be added without reallocating (and thus invalidating
+     *  pointers to frames already added)
+     *  @param  numFrames The total number of frames to reserve memory for
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition reserve(const size_t numFrames);
+
+    /** Add (zero-initialized) frame at the end of the store
+     *  @param  frame Returns pointer to the memory of the new frame, which
+     *          has getBytesPerFrame() bytes. NULL in case of error.
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition addEmptyFrame(Uint8*& frame);
+
+    /** Add frame at the end of the store by copying the given data
+     *  @param  data The frame data, must have getBytesPerFrame() bytes
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition addFrame(const Uint8* data);
+
+    /** Remove last frame (e.g.\ after an error), memory is not freed
+     */
+    void removeLastFrame();
+
+    /** Get frame
+     *  @param  frameNo The frame number, starting from 0
+     *  @return Pointer to the frame memory, NULL if frame does not exist
+     */
+    Uint8* getFrame(const size_t frameNo) const;
+
+    /** Get number of frames
+     *  @return The number of frames in the store
+     */
+    size_t getNumberOfFrames() const;
+
+    /** Get number of bytes per frame
+     *  @return The number of bytes per frame, 0 if not initialized
+     */
+    size_t getBytesPerFrame() const;
+
+    /** Get number of frames memory is allocated for
+     *  @return The number of frames memory is allocated for
+     */
+    size_t getCapacity() const;
+
+    /** Read frames from the given pixel data element of an item. The store is
+     *  initialized accordingly.
+     *  @param  item The item to read from
+     *  @param  pixelDataTag The pixel data attribute to read
+     *  @param  bytesPerFrame The number of bytes per frame
+     *  @param  numFrames The number of frames expected in the pixel data element
+     *  @param  takeOver If OFTrue, the pixel data element is removed from the
+     *          item and used as frame memory directly, i.e.\ the pixel data is
+     *          not copied. Otherwise, the element is copied.
+     *  @param  bitsAllocated The number of bits allocated per sample, 8 or 16.
+     *          Only used for DCM_PixelData.
+     *  @return EC_Normal if successful, IOD_EC_InvalidPixelData if the element
+     *          does not exist or does not have the expected size, other error
+     *          otherwise
+     */
+    OFCondition read(DcmItem& item,
+                     const DcmTagKey& pixelDataTag,
+                     const size_t bytesPerFrame,
+                     const size_t numFrames,
+                     const OFBool takeOver       = OFFalse,
+                     const Uint16 bitsAllocated = 16);
+
+    /** Write copy of all frames as pixel data element into the given item,
+     *  an existing element is replaced
+     *  @param  item The item to write to
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition write(DcmItem& item);
+
+    /** Temporarily insert pixel data element of the store into the given item
+     *  without copying (e.g.\ for saving a file), an existing element is
+     *  replaced. Memory reserved for frames not added is excluded from the
+     *  element by reducing its length (without copying the frames). The element
+     *  must be given back using removeFrom() before the item is destroyed or
+     *  this store is modified.
+     *  @param  item The item to insert the pixel data element into
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition insertInto(DcmItem& item);
+
+    /** Remove pixel data element inserted by insertInto() from the given item
+     *  @param  item The item to remove the element from
+     */
+    void removeFrom(DcmItem& item);
+
+private:
+    /** Create pixel data element with the given capacity and copy all frames
+     *  into it, replacing the current element
+     *  @param  numFrames The number of frames the new element should hold
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition reallocate(const size_t numFrames);
+
+    /** Update pointer to frame memory (in local byte order) from the element
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition updateData();
+
+    /** Copy all frames from other store, current content must be cleared
+     *  @param  rhs The store to copy from
+     */
+    void copyFrom(const IODFrameStore& rhs);
+
+    /// The pixel data attribute used
+    DcmTagKey m_PixelDataTag;
+
+    /// The number of bits allocated per sample (8 or 16, only for DCM_PixelData)
+    Uint16 m_BitsAllocated;
+
+    /// The pixel data element holding the frames (NULL if no memory allocated)
+    DcmElement* m_Element;
+
+    /// Pointer to the element's value, i.e.\ the first frame
+    Uint8* m_Data;
+
+    /// The number of bytes per frame
+    size_t m_BytesPerFrame;
+
+    /// The number of frames in the store
+    size_t m_NumFrames;
+
+    /// The number of frames memory is allocated for
+    size_t m_Capacity;
+};
+
+#endif // IODFRAMES_H
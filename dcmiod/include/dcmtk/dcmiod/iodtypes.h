@@ -80,6 +80,92 @@ public:
         }
     };
 
+    /** Typed view on the pixels of a single frame. The view does not own
+     *  the pixels but points directly into memory managed elsewhere (e.g.\ by
+     *  IODFrameStore), i.e.\ no pixel data is copied when creating a view.
+     *  The view is only valid as long as the underlying memory is.
+     */
+    template <typename PixelType>
+    class FrameView
+    {
+    public:
+        /// Pixel type
+        typedef PixelType pixel_type;
+
+        /** Default constructor, creates empty view
+         */
+        FrameView()
+            : m_Data(NULL)
+            , m_NumPixels(0)
+        {
+        }
+
+        /** Constructor
+         *  @param  data Pointer to the first pixel of the frame
+         *  @param  numPixels The number of pixels (rows * columns) of the frame
+         */
+        FrameView(PixelType* data, const size_t numPixels)
+            : m_Data(data)
+            , m_NumPixels(numPixels)
+        {
+        }
+
+        /** Get pointer to the first pixel
+         *  @return Pointer to the first pixel, NULL if view is empty
+         */
+        PixelType* data() const
+        {
+            return m_Data;
+        }
+
+        /** Get number of pixels
+         *  @return The number of pixels of the frame
+         */
+        size_t size() const
+        {
+            return m_NumPixels;
+        }
+
+        /** Check whether view is empty, i.e.\ does not refer to any frame
+         *  @return OFTrue if view is empty, OFFalse otherwise
+         */
+        OFBool empty() const
+        {
+            return m_NumPixels == 0;
+        }
+
+        /** Access pixel (without range check)
+         *  @param  i The index of the pixel (starting from 0)
+         *  @return Reference to the pixel
+         */
+        PixelType& operator[](const size_t i) const
+        {
+            return m_Data[i];
+        }
+
+        /** Get pointer to the first pixel
+         *  @return Pointer to the first pixel
+         */
+        PixelType* begin() const
+        {
+            return m_Data;
+        }
+
+        /** Get pointer behind the last pixel
+         *  @return Pointer behind the last pixel
+         */
+        PixelType* end() const
+        {
+            return m_Data + m_NumPixels;
+        }
+
+    private:
+        /// Pointer to the first pixel
+        PixelType* m_Data;
+        /// Number of pixels
+        size_t m_NumPixels;
+    };
+
     /** IOD Information Entities (incomplete list, extended as needed)
      */
     enum IOD_IE
@@ -0,0 +1,462 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module: dcmiod
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Class for storing the frames of a multi-frame image in place
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmiod/iodframes.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/dcmdata/dcitem.h"
+#include "dcmtk/dcmdata/dcpixel.h"
+#include "dcmtk/dcmdata/dcvrod.h"
+#include "dcmtk/dcmdata/dcvrof.h"
+#include "dcmtk/dcmiod/iodtypes.h"
+
+// Maximum number of bytes a pixel data element can hold (even number)
+#define IODFRAMES_MAX_BYTES 4294967294UL
+
+// Pixel data element created by the frame store, the length of its value can
+// be reduced without reallocating (and copying) the value
+template <typename T>
+class IODFrameStoreElement : public T
+{
+public:
+    IODFrameStoreElement(const DcmTag& tag)
+        : T(tag)
+    {
+    }
+
+    void truncate(const Uint32 length)
+    {
+        this->setLengthField(length);
+    }
+};
+
+// Reduce length of value of given element, returns OFFalse if the element has
+// not been created by the frame store
+static OFBool truncatePixelDataElement(DcmElement* elem, const size_t numBytes)
+{
+    const Uint32 length = OFstatic_cast(Uint32, numBytes);
+    IODFrameStoreElement<DcmPixelData>* pd = OFdynamic_cast(IODFrameStoreElement<DcmPixelData>*, elem);
+    if (pd)
+    {
+        pd->truncate(length);
+        return OFTrue;
+    }
+    IODFrameStoreElement<DcmOtherFloat>* of = OFdynamic_cast(IODFrameStoreElement<DcmOtherFloat>*, elem);
+    if (of)
+    {
+        of->truncate(length);
+        return OFTrue;
+    }
+    IODFrameStoreElement<DcmOtherDouble>* od = OFdynamic_cast(IODFrameStoreElement<DcmOtherDouble>*, elem);
+    if (od)
+    {
+        od->truncate(length);
+        return OFTrue;
+    }
+    return OFFalse;
+}
+
+// Create pixel data element for the given attribute with the given number of
+// (zero-initialized) bytes, returns pointer to the element's value
+static OFCondition createPixelDataElement(const DcmTagKey& tag,
+                                          const Uint16 bitsAllocated,
+                                          const size_t numBytes,
+                                          DcmElement*& elem,
+                                          Uint8*& data)
+{
+    OFCondition result;
+    elem = NULL;
+    data = NULL;
+    if (tag == DCM_FloatPixelData)
+    {
+        DcmOtherFloat* of = new IODFrameStoreElement<DcmOtherFloat>(DcmTag(tag, EVR_OF));
+        Float32* f        = NULL;
+        result            = of->createFloat32Array(OFstatic_cast(Uint32, numBytes / sizeof(Float32)), f);
+        data              = OFreinterpret_cast(Uint8*, f);
+        elem              = of;
+    }
+    else if (tag == DCM_DoubleFloatPixelData)
+    {
+        DcmOtherDouble* od = new IODFrameStoreElement<DcmOtherDouble>(DcmTag(tag, EVR_OD));
+        Float64* f         = NULL;
+        result             = od->createFloat64Array(OFstatic_cast(Uint32, numBytes / sizeof(Float64)), f);
+        data               = OFreinterpret_cast(Uint8*, f);
+        elem               = od;
+    }
+    else
+    {
+        DcmPixelData* pd = new IODFrameStoreElement<DcmPixelData>(DcmTag(tag));
+        // 8 bit samples are stored byte by byte, 16 bit samples in local byte order
+        if (bitsAllocated == 8)
+        {
+            pd->setVR(EVR_OB);
+            result = pd->createUint8Array(OFstatic_cast(Uint32, numBytes), data);
+        }
+        else
+        {
+            pd->setVR(EVR_OW);
+            Uint16* words = NULL;
+            result        = pd->createUint16Array(OFstatic_cast(Uint32, numBytes / 2), words);
+            data          = OFreinterpret_cast(Uint8*, words);
+        }
+        elem = pd;
+    }
+    if (result.good() && (data == NULL) && (numBytes > 0))
+        result = EC_MemoryExhausted;
+    if (result.bad())
+    {
+        delete elem;
+        elem = NULL;
+        data = NULL;
+    }
+    return result;
+}
+
+IODFrameStore::IODFrameStore()
+    : m_PixelDataTag(DCM_PixelData)
+    , m_BitsAllocated(16)
+    , m_Element(NULL)
+    , m_Data(NULL)
+    , m_BytesPerFrame(0)
+    , m_NumFrames(0)
+    , m_Capacity(0)
+{
+}
+
+IODFrameStore::IODFrameStore(const IODFrameStore& rhs)
+    : m_PixelDataTag(DCM_PixelData)
+    , m_BitsAllocated(16)
+    , m_Element(NULL)
+    , m_Data(NULL)
+    , m_BytesPerFrame(0)
+    , m_NumFrames(0)
+    , m_Capacity(0)
+{
+    copyFrom(rhs);
+}
+
+IODFrameStore& IODFrameStore::operator=(const IODFrameStore& rhs)
+{
+    if (this != &rhs)
+    {
+        clear();
+        copyFrom(rhs);
+    }
+    return *this;
+}
+
+IODFrameStore::~IODFrameStore()
+{
+    clear();
+}
+
+OFCondition IODFrameStore::init(const DcmTagKey& pixelDataTag, const size_t bytesPerFrame, const Uint16 bitsAllocated)
+{
+    clear();
+    if (bytesPerFrame == 0)
+    {
+        DCMIOD_ERROR("Cannot initialize frame store: Frame size must not be 0");
+        return IOD_EC_InvalidPixelData;
+    }
+    if (((pixelDataTag == DCM_FloatPixelData) && (bytesPerFrame % sizeof(Float32)))
+        || ((pixelDataTag == DCM_DoubleFloatPixelData) && (bytesPerFrame % sizeof(Float64))))
+    {
+        DCMIOD_ERROR("Cannot initialize frame store: Frame size " << bytesPerFrame << " does not fit "
+                                                                  << DcmTag(pixelDataTag).getTagName());
+        return IOD_EC_InvalidPixelData;
+    }
+    if ((pixelDataTag == DCM_PixelData)
+        && (((bitsAllocated != 8) && (bitsAllocated != 16)) || ((bitsAllocated == 16) && (bytesPerFrame % 2))))
+    {
+        DCMIOD_ERROR("Cannot initialize frame store: Frame size " << bytesPerFrame << " does not fit "
+                                                                  << bitsAllocated << " bits allocated");
+        return IOD_EC_InvalidPixelData;
+    }
+    m_PixelDataTag  = pixelDataTag;
+    m_BitsAllocated = bitsAllocated;
+    m_BytesPerFrame = bytesPerFrame;
+    return EC_Normal;
+}
+
+OFBool IODFrameStore::isInitialized() const
+{
+    return m_BytesPerFrame > 0;
+}
+
+void IODFrameStore::clear()
+{
+    delete m_Element;
+    m_Element       = NULL;
+    m_Data          = NULL;
+    m_BitsAllocated = 16;
+    m_BytesPerFrame = 0;
+    m_NumFrames     = 0;
+    m_Capacity      = 0;
+}
+
+OFCondition IODFrameStore::reserve(const size_t numFrames)
+{
+    if (!isInitialized())
+        return EC_IllegalCall;
+    if (numFrames <= m_Capacity)
+        return EC_Normal;
+    return reallocate(numFrames);
+}
+
+OFCondition IODFrameStore::addEmptyFrame(Uint8*& frame)
+{
+    frame = NULL;
+    if (!isInitialized())
+        return EC_IllegalCall;
+    if (m_NumFrames == m_Capacity)
+    {
+        // Grow exponentially, but not beyond what a single element can hold
+        const size_t maxFrames = IODFRAMES_MAX_BYTES / m_BytesPerFrame;
+        size_t newCapacity     = (m_Capacity > 0) ? 2 * m_Capacity : 1;
+        if (newCapacity > maxFrames)
+            newCapacity = maxFrames;
+        if (newCapacity <= m_NumFrames)
+        {
+            DCMIOD_ERROR("Cannot add frame: Pixel data would exceed " << IODFRAMES_MAX_BYTES << " bytes");
+            return EC_TooManyBytesRequested;
+        }
+        OFCondition result = reallocate(newCapacity);
+        if (result.bad())
+            return result;
+    }
+    frame = m_Data + m_NumFrames * m_BytesPerFrame;
+    m_NumFrames++;
+    return EC_Normal;
+}
+
+OFCondition IODFrameStore::addFrame(const Uint8* data)
+{
+    if (data == NULL)
+        return EC_IllegalParameter;
+    Uint8* frame       = NULL;
+    OFCondition result = addEmptyFrame(frame);
+    if (result.good())
+        memcpy(frame, data, m_BytesPerFrame);
+    return result;
+}
+
+void IODFrameStore::removeLastFrame()
+{
+    if (m_NumFrames > 0)
+    {
+        m_NumFrames--;
+        // Keep unused memory zero-initialized for the next frame added
+        memset(m_Data + m_NumFrames * m_BytesPerFrame, 0, m_BytesPerFrame);
+    }
+}
+
+Uint8* IODFrameStore::getFrame(const size_t frameNo) const
+{
+    if (frameNo < m_NumFrames)
+        return m_Data + frameNo * m_BytesPerFrame;
+    return NULL;
+}
+
+size_t IODFrameStore::getNumberOfFrames() const
+{
+    return m_NumFrames;
+}
+
+size_t IODFrameStore::getBytesPerFrame() const
+{
+    return m_BytesPerFrame;
+}
+
+size_t IODFrameStore::getCapacity() const
+{
+    return m_Capacity;
+}
+
+OFCondition IODFrameStore::read(DcmItem& item,
+                                const DcmTagKey& pixelDataTag,
+                                const size_t bytesPerFrame,
+                                const size_t numFrames,
+                                const OFBool takeOver,
+                                const Uint16 bitsAllocated)
+{
+    OFCondition result = init(pixelDataTag, bytesPerFrame, bitsAllocated);
+    if (result.bad())
+        return result;
+    DcmElement* elem = NULL;
+    if (item.findAndGetElement(pixelDataTag, elem).bad() || (elem == NULL))
+    {
+        DCMIOD_ERROR("No " << DcmTag(pixelDataTag).getTagName() << " element found");
+        return IOD_EC_InvalidPixelData;
+    }
+    const size_t numBytes = bytesPerFrame * numFrames;
+    const size_t length   = elem->getLength();
+    if ((numFrames > IODFRAMES_MAX_BYTES / bytesPerFrame)
+        || ((length != numBytes) && !((numBytes % 2) && (length == numBytes + 1))))
+    {
+        DCMIOD_ERROR("Invalid " << DcmTag(pixelDataTag).getTagName() << " length: Expected " << numBytes
+                                << " bytes but element has " << length << " bytes");
+        return IOD_EC_InvalidPixelData;
+    }
+    if (takeOver)
+        m_Element = item.remove(elem);
+    else
+        m_Element = OFstatic_cast(DcmElement*, elem->clone());
+    if (m_Element == NULL)
+        return EC_MemoryExhausted;
+    m_NumFrames = m_Capacity = numFrames;
+    result                   = updateData();
+    if (result.good() && (m_Data == NULL) && (numBytes > 0))
+        result = IOD_EC_InvalidPixelData;
+    if (result.bad())
+        clear();
+    return result;
+}
+
+OFCondition IODFrameStore::write(DcmItem& item)
+{
+    if (m_NumFrames == 0)
+    {
+        DCMIOD_ERROR("Cannot write " << DcmTag(m_PixelDataTag).getTagName() << ": No frames");
+        return IOD_EC_InvalidPixelData;
+    }
+    DcmElement* elem   = NULL;
+    Uint8* data        = NULL;
+    OFCondition result = createPixelDataElement(m_PixelDataTag, m_BitsAllocated, m_NumFrames * m_BytesPerFrame, elem, data);
+    if (result.good())
+    {
+        memcpy(data, m_Data, m_NumFrames * m_BytesPerFrame);
+        result = item.insert(elem, OFTrue /* replace */);
+        if (result.bad())
+            delete elem;
+    }
+    return result;
+}
+
+OFCondition IODFrameStore::insertInto(DcmItem& item)
+{
+    if (m_NumFrames == 0)
+    {
+        DCMIOD_ERROR("Cannot write " << DcmTag(m_PixelDataTag).getTagName() << ": No frames");
+        return IOD_EC_InvalidPixelData;
+    }
+    OFCondition result;
+    // Exclude memory reserved for frames never added. If possible, the value
+    // is not reallocated, since this would temporarily need the memory twice.
+    if (m_Capacity > m_NumFrames)
+    {
+        if (truncatePixelDataElement(m_Element, m_NumFrames * m_BytesPerFrame))
+            m_Capacity = m_NumFrames;
+        else
+            result = reallocate(m_NumFrames);
+    }
+    if (result.good())
+        result = item.insert(m_Element, OFTrue /* replace */);
+    return result;
+}
+
+void IODFrameStore::removeFrom(DcmItem& item)
+{
+    if (m_Element && (item.remove(m_Element) != NULL))
+    {
+        // Writing might have changed the byte order of the value
+        updateData();
+    }
+}
+
+OFCondition IODFrameStore::reallocate(const size_t numFrames)
+{
+    if (numFrames > IODFRAMES_MAX_BYTES / m_BytesPerFrame)
+    {
+        DCMIOD_ERROR("Cannot allocate " << numFrames << " frames: Pixel data would exceed " << IODFRAMES_MAX_BYTES
+                                        << " bytes");
+        return EC_TooManyBytesRequested;
+    }
+    DcmElement* elem   = NULL;
+    Uint8* data        = NULL;
+    OFCondition result = createPixelDataElement(m_PixelDataTag, m_BitsAllocated, numFrames * m_BytesPerFrame, elem, data);
+    if (result.good())
+    {
+        const size_t numCopy = (m_NumFrames < numFrames) ? m_NumFrames : numFrames;
+        if (numCopy > 0)
+            memcpy(data, m_Data, numCopy * m_BytesPerFrame);
+        delete m_Element;
+        m_Element   = elem;
+        m_Data      = data;
+        m_NumFrames = numCopy;
+        m_Capacity  = numFrames;
+    }
+    return result;
+}
+
+void IODFrameStore::copyFrom(const IODFrameStore& rhs)
+{
+    m_PixelDataTag  = rhs.m_PixelDataTag;
+    m_BitsAllocated = rhs.m_BitsAllocated;
+    m_BytesPerFrame = rhs.m_BytesPerFrame;
+    if (rhs.m_NumFrames > 0)
+    {
+        // Only copy the frames, not the memory reserved for further frames.
+        // There is no element yet, so reallocate() copies from the other store.
+        m_NumFrames = rhs.m_NumFrames;
+        m_Data      = rhs.m_Data;
+        if (reallocate(rhs.m_NumFrames).bad())
+        {
+            DCMIOD_ERROR("Cannot copy frames: Memory exhausted");
+            m_Element   = NULL;
+            m_Data      = NULL;
+            m_NumFrames = 0;
+        }
+    }
+}
+
+OFCondition IODFrameStore::updateData()
+{
+    m_Data = NULL;
+    if (m_Element == NULL)
+        return EC_Normal;
+    OFCondition result;
+    if (m_PixelDataTag == DCM_FloatPixelData)
+    {
+        Float32* f = NULL;
+        result     = m_Element->getFloat32Array(f);
+        m_Data     = OFreinterpret_cast(Uint8*, f);
+    }
+    else if (m_PixelDataTag == DCM_DoubleFloatPixelData)
+    {
+        Float64* f = NULL;
+        result     = m_Element->getFloat64Array(f);
+        m_Data     = OFreinterpret_cast(Uint8*, f);
+    }
+    else if (m_BitsAllocated == 8)
+    {
+        // Also works for OW, since the value is then converted to little endian
+        // byte order, i.e. the order of the samples
+        result = m_Element->getUint8Array(m_Data);
+    }
+    else
+    {
+        Uint16* words = NULL;
+        result        = m_Element->getUint16Array(words);
+        m_Data        = OFreinterpret_cast(Uint8*, words);
+    }
+    return result;
+}
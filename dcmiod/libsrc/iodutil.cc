@@ -760,7 +760,23 @@ void DcmIODUtil::alignFrameOnByteBoundary(Uint8* buf, size_t bufLen, Uint8 numBi
         DCMIOD_ERROR("Invalid input data: alignFrameOnByteBoundary() can only shift 0-7 bits");
         return;
     }
-    for (size_t x = 0; x < bufLen - 1; x++)
+    if ((numBits == 0) || (bufLen == 0))
+        return;
+    size_t x = 0;
+    if (gLocalByteOrder == EBO_LittleEndian)
+    {
+        // Shift 8 bytes at once (the first byte in memory being the least
+        // significant one of the word), taking over the lowest bits of the
+        // byte following the word
+        for (; x + 9 <= bufLen; x += 8)
+        {
+            Uint64 word;
+            memcpy(&word, buf + x, 8);
+            word = (word >> numBits) | (OFstatic_cast(Uint64, buf[x + 8]) << (64 - numBits));
+            memcpy(buf + x, &word, 8);
+        }
+    }
+    for (; x < bufLen - 1; x++)
     {
         // Shift current byte
         buf[x] = OFstatic_cast(unsigned char, buf[x]) >> numBits;
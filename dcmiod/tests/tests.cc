@@ -24,5 +24,6 @@
 
 OFTEST_REGISTER(dcmiod_codes);
 OFTEST_REGISTER(dcmiod_tcielabutil);
+OFTEST_REGISTER(dcmiod_frame_store);
 OFTEST_REGISTER(dcmiod_imagepixel);
 OFTEST_MAIN("dcmiod")
@@ -0,0 +1,156 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmiod
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Tests for storing frames in place
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcpixel.h"
+#include "dcmtk/dcmiod/iodframes.h"
+#include "dcmtk/dcmiod/iodtypes.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/oftest.h"
+
+#define NUM_PIXELS 4
+#define NUM_FRAMES 3
+
+// Check that the store contains the expected float frames
+static void checkFloatFrames(const IODFrameStore& store)
+{
+    OFCHECK_EQUAL(store.getNumberOfFrames(), NUM_FRAMES);
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+    {
+        DcmIODTypes::FrameView<Float32> view(OFreinterpret_cast(Float32*, store.getFrame(f)), NUM_PIXELS);
+        OFCHECK(!view.empty());
+        for (size_t p = 0; p < view.size(); p++)
+            OFCHECK_EQUAL(view[p], OFstatic_cast(Float32, f * 10 + p) + 0.5f);
+    }
+    OFCHECK(store.getFrame(NUM_FRAMES) == NULL);
+}
+
+OFTEST(dcmiod_frame_store)
+{
+    // Add frames in place, memory grows as needed
+    IODFrameStore store;
+    OFCHECK(!store.isInitialized());
+    Uint8* frame = NULL;
+    OFCHECK(store.addEmptyFrame(frame).bad());
+    OFCHECK(store.init(DCM_FloatPixelData, NUM_PIXELS * sizeof(Float32)).good());
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+    {
+        OFCHECK(store.addEmptyFrame(frame).good());
+        OFCHECK(frame != NULL);
+        if (frame)
+        {
+            Float32* pixels = OFreinterpret_cast(Float32*, frame);
+            for (size_t p = 0; p < NUM_PIXELS; p++)
+            {
+                OFCHECK_EQUAL(pixels[p], 0.0f);
+                pixels[p] = OFstatic_cast(Float32, f * 10 + p) + 0.5f;
+            }
+        }
+    }
+    OFCHECK(store.getCapacity() >= NUM_FRAMES);
+    checkFloatFrames(store);
+
+    // Write copy, read copy and take over
+    DcmItem item;
+    OFCHECK(store.write(item).good());
+    DcmElement* elem = NULL;
+    OFCHECK(item.findAndGetElement(DCM_FloatPixelData, elem).good());
+    if (elem)
+    {
+        OFCHECK_EQUAL(elem->getLength(), NUM_FRAMES * NUM_PIXELS * sizeof(Float32));
+        OFCHECK(elem->getTag().getEVR() == EVR_OF);
+    }
+    IODFrameStore copy;
+    OFCHECK(copy.read(item, DCM_FloatPixelData, NUM_PIXELS * sizeof(Float32), NUM_FRAMES + 1).bad());
+    OFCHECK(copy.read(item, DCM_FloatPixelData, NUM_PIXELS * sizeof(Float32), NUM_FRAMES).good());
+    checkFloatFrames(copy);
+    OFCHECK(item.tagExists(DCM_FloatPixelData));
+    IODFrameStore takeOver;
+    OFCHECK(takeOver.read(item, DCM_FloatPixelData, NUM_PIXELS * sizeof(Float32), NUM_FRAMES, OFTrue).good());
+    checkFloatFrames(takeOver);
+    OFCHECK(!item.tagExists(DCM_FloatPixelData));
+
+    // Lend element for saving in big endian byte order, frames are unchanged
+    // afterwards
+    OFTempFile tf;
+    DcmFileFormat dcmff;
+    OFCHECK(store.getCapacity() > NUM_FRAMES);
+    IODFrameStore reserved(store);
+    OFCHECK_EQUAL(reserved.getCapacity(), NUM_FRAMES);
+    checkFloatFrames(reserved);
+    OFCHECK(store.insertInto(*dcmff.getDataset()).good());
+    OFCHECK_EQUAL(store.getCapacity(), NUM_FRAMES);
+    OFCHECK(dcmff.getDataset()->findAndGetElement(DCM_FloatPixelData, elem).good());
+    if (elem)
+        OFCHECK_EQUAL(elem->getLength(), NUM_FRAMES * NUM_PIXELS * sizeof(Float32));
+    OFCHECK(dcmff.saveFile(tf.getFilename(), EXS_BigEndianExplicit).good());
+    store.removeFrom(*dcmff.getDataset());
+    OFCHECK(!dcmff.getDataset()->tagExists(DCM_FloatPixelData));
+    checkFloatFrames(store);
+    DcmFileFormat loaded;
+    OFCHECK(loaded.loadFile(tf.getFilename()).good());
+    OFCHECK(copy.read(*loaded.getDataset(), DCM_FloatPixelData, NUM_PIXELS * sizeof(Float32), NUM_FRAMES).good());
+    checkFloatFrames(copy);
+
+    // Odd frame size results in OB Pixel Data
+    IODFrameStore bytes;
+    const Uint8 data[3] = { 1, 2, 3 };
+    OFCHECK(bytes.init(DCM_PixelData, sizeof(data)).bad());
+    OFCHECK(bytes.init(DCM_PixelData, sizeof(data), 8).good());
+    OFCHECK(bytes.addFrame(data).good());
+    OFCHECK(bytes.write(item).good());
+    OFCHECK(item.findAndGetElement(DCM_PixelData, elem).good());
+    if (elem)
+        OFCHECK(elem->getTag().getEVR() == EVR_OB);
+    bytes.removeLastFrame();
+    OFCHECK_EQUAL(bytes.getNumberOfFrames(), 0);
+    OFCHECK(bytes.read(item, DCM_PixelData, sizeof(data), 1, OFFalse, 8).good());
+    OFCHECK(bytes.getFrame(0) != NULL);
+    if (bytes.getFrame(0))
+        OFCHECK(memcmp(bytes.getFrame(0), data, sizeof(data)) == 0);
+
+    // 8 bit samples also result in OB Pixel Data for even frame sizes, and can
+    // be read from OW Pixel Data (independent of the local byte order)
+    const Uint8 samples[4] = { 1, 2, 3, 4 };
+    OFCHECK(bytes.init(DCM_PixelData, sizeof(samples), 8).good());
+    OFCHECK(bytes.addFrame(samples).good());
+    OFCHECK(bytes.write(item).good());
+    OFCHECK(item.findAndGetElement(DCM_PixelData, elem).good());
+    if (elem)
+        OFCHECK(elem->getTag().getEVR() == EVR_OB);
+    DcmFileFormat words;
+    DcmPixelData* pixelData = new DcmPixelData(DCM_PixelData);
+    pixelData->setVR(EVR_OW);
+    OFCHECK(pixelData->putUint8Array(samples, sizeof(samples)).good());
+    OFCHECK(words.getDataset()->insert(pixelData).good());
+    OFCHECK(words.saveFile(tf.getFilename(), EXS_BigEndianExplicit).good());
+    OFCHECK(loaded.loadFile(tf.getFilename()).good());
+    OFCHECK(loaded.getDataset()->findAndGetElement(DCM_PixelData, elem).good());
+    if (elem)
+        OFCHECK(elem->getTag().getEVR() == EVR_OW);
+    OFCHECK(bytes.read(*loaded.getDataset(), DCM_PixelData, sizeof(samples), 1, OFTrue, 8).good());
+    OFCHECK(bytes.getFrame(0) != NULL);
+    if (bytes.getFrame(0))
+        OFCHECK(memcmp(bytes.getFrame(0), samples, sizeof(samples)) == 0);
+}
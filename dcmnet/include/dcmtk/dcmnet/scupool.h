@@ -0,0 +1,352 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Pool of established associations that are kept open and reused
+ *           for repeated operations to the same peer
+ *
+ */
+
+#ifndef SCUPOOL_H
+#define SCUPOOL_H
+
+#include "dcmtk/config/osconfig.h"  /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmnet/scu.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofthread.h"
+
+/** Describes the associations that can be shared by the SCU pool, i.e.\ the
+ *  peer (host name and port), the AE titles and the presentation contexts
+ *  to be negotiated. Two keys are equal if all of these are equal, where the
+ *  order in which the presentation contexts were added does not matter.
+ */
+class DCMTK_DCMNET_EXPORT DcmSCUPoolKey
+{
+public:
+
+  /** Constructor
+   *  @param peerHost    The host name or IP address of the peer
+   *  @param peerPort    The TCP/IP port number of the peer
+   *  @param peerAETitle The AE title of the peer (called AE title)
+   *  @param ourAETitle  The AE title of this application (calling AE title)
+   */
+  DcmSCUPoolKey(const OFString& peerHost,
+                const Uint16 peerPort,
+                const OFString& peerAETitle,
+                const OFString& ourAETitle);
+
+  /** Add presentation context to be negotiated, see
+   *  DcmSCU::addPresentationContext() for details.
+   *  @param abstractSyntax The abstract syntax UID (i.e.\ SOP Class UID)
+   *  @param xferSyntaxes   List of transfer syntax UIDs, must not be empty
+   *  @param role           The role to be negotiated
+   *  @return EC_Normal if the presentation context could be added, error
+   *          code otherwise
+   */
+  OFCondition addPresentationContext(const OFString& abstractSyntax,
+                                     const OFList<OFString>& xferSyntaxes,
+                                     const T_ASC_SC_ROLE role = ASC_SC_ROLE_DEFAULT);
+
+  /** Configure the given SCU with the peer, AE titles and presentation
+   *  contexts of this key. The SCU should not have any presentation contexts
+   *  yet, i.e.\ it should be newly created.
+   *  @param scu The SCU to be configured
+   *  @return EC_Normal if successful, error code otherwise
+   */
+  OFCondition configureSCU(DcmSCU& scu) const;
+
+  /** Get the string that identifies this key, i.e.\ that is equal for all
+   *  keys that describe the same associations.
+   *  @return The string identifying this key
+   */
+  const OFString& getIdentifier() const;
+
+  /** Compare two keys
+   *  @param rhs The key to compare with
+   *  @return OFTrue if the keys describe the same associations, OFFalse otherwise
+   */
+  OFBool operator==(const DcmSCUPoolKey& rhs) const;
+
+  /** Compare two keys
+   *  @param rhs The key to compare with
+   *  @return OFTrue if the keys describe different associations, OFFalse otherwise
+   */
+  OFBool operator!=(const DcmSCUPoolKey& rhs) const;
+
+private:
+
+  /// A presentation context to be negotiated
+  struct PresentationContext
+  {
+    /// Abstract syntax UID
+    OFString abstractSyntax;
+    /// List of transfer syntax UIDs
+    OFList<OFString> xferSyntaxes;
+    /// Role to be negotiated
+    T_ASC_SC_ROLE role;
+  };
+
+  /** Update the identifier after the presentation contexts have been modified
+   */
+  void updateIdentifier();
+
+  /// Host name or IP address of the peer
+  OFString m_peerHost;
+
+  /// TCP/IP port number of the peer
+  Uint16 m_peerPort;
+
+  /// AE title of the peer
+  OFString m_peerAETitle;
+
+  /// AE title of this application
+  OFString m_ourAETitle;
+
+  /// Presentation contexts to be negotiated (in the order of insertion)
+  OFList<PresentationContext> m_presContexts;
+
+  /// Identifier describing all of the above (presentation contexts sorted)
+  OFString m_identifier;
+};
+
+
+/** Pool of associations to one or more peers that are kept open and reused
+ *  for repeated operations, i.e.\ the association negotiation (including TCP
+ *  and TLS connection setup) is only needed once for many operations to the
+ *  same peer. An association is requested from the pool with acquire(), which
+ *  either returns an idle association with the same key (see DcmSCUPoolKey)
+ *  or negotiates a new one. After use, the association is handed back with
+ *  release() and kept open for a configurable time. Idle associations that
+ *  have not been used for some time are checked with C-ECHO before being
+ *  reused (if the Verification SOP Class was negotiated). All methods can be
+ *  called from different threads, while each association is only used by one
+ *  thread at a time, i.e.\ the one that acquired it.
+ *  New SCU objects are created by createSCU() and initialized by initSCU(),
+ *  which can be overwritten, e.g.\ in order to create derived SCU classes,
+ *  change timeouts or enable TLS by calling DcmSCU::useSecureConnection().
+ */
+class DCMTK_DCMNET_EXPORT DcmSCUPool
+{
+public:
+
+  /** Constructor
+   */
+  DcmSCUPool();
+
+  /** Virtual destructor, releases all idle associations. Associations that
+   *  have been acquired and not yet released are not deleted.
+   */
+  virtual ~DcmSCUPool();
+
+  /** Get an association for the given key. If an idle association with the
+   *  same key is available, it is reused. Otherwise, a new association is
+   *  negotiated.
+   *  @param key The key describing the association
+   *  @param scu Returns the SCU with the established association. The SCU
+   *             is still owned by the pool and must be handed back with
+   *             release(). Set to NULL if an error occurred.
+   *  @return EC_Normal if successful, error code otherwise (e.g.\ if the
+   *          association could not be negotiated)
+   */
+  virtual OFCondition acquire(const DcmSCUPoolKey& key,
+                              DcmSCU*& scu);
+
+  /** Hand back an association that has been acquired before. If the
+   *  association is still established and should be kept, it becomes idle
+   *  and can be reused by subsequent calls of acquire(). Otherwise, i.e.\ if
+   *  the maximum number of idle associations for its key is reached or if it
+   *  should not be kept (e.g.\ because an error occurred during the last
+   *  operation), the association is released and the SCU is deleted.
+   *  @param scu  The SCU returned by acquire()
+   *  @param keep If OFTrue, keep the association for being reused (if
+   *              possible), otherwise release it
+   */
+  virtual void release(DcmSCU* scu,
+                       const OFBool keep = OFTrue);
+
+  /** Release all idle associations that have not been used for longer than
+   *  the maximum idle time. This is also done by acquire() and release(), so
+   *  it is only required if the pool is not used for some time.
+   *  @return Number of associations released
+   */
+  virtual size_t closeExpiredAssociations();
+
+  /** Release all idle associations
+   *  @return Number of associations released
+   */
+  virtual size_t closeIdleAssociations();
+
+  /** Set the maximum time an association may be idle before it is released.
+   *  Default is 60 seconds.
+   *  @param seconds The maximum idle time in seconds
+   */
+  void setMaxIdleTime(const Uint32 seconds);
+
+  /** Set the time an association may be idle before its health is checked
+   *  (using C-ECHO) prior to being reused. A value of 0 checks every idle
+   *  association before it is reused. Default is 10 seconds.
+   *  @param seconds The idle time in seconds after which a check is needed
+   */
+  void setHealthCheckInterval(const Uint32 seconds);
+
+  /** Set the maximum number of idle associations that are kept for the same
+   *  key. Default is 4.
+   *  @param maxIdle The maximum number of idle associations per key
+   */
+  void setMaxIdlePerKey(const size_t maxIdle);
+
+  /** Get the maximum time an association may be idle before it is released
+   *  @return The maximum idle time in seconds
+   */
+  Uint32 getMaxIdleTime() const;
+
+  /** Get the time an association may be idle before its health is checked
+   *  @return The idle time in seconds after which a check is needed
+   */
+  Uint32 getHealthCheckInterval() const;
+
+  /** Get the maximum number of idle associations that are kept for the same key
+   *  @return The maximum number of idle associations per key
+   */
+  size_t getMaxIdlePerKey() const;
+
+  /** Get the number of idle associations
+   *  @return The number of idle associations
+   */
+  size_t getNumberOfIdleAssociations() const;
+
+  /** Get the number of associations that have been acquired and not released
+   *  @return The number of associations in use
+   */
+  size_t getNumberOfActiveAssociations() const;
+
+  /** Get the number of associations that have been negotiated by the pool
+   *  @return The number of negotiated associations
+   */
+  unsigned long getNumberOfNegotiatedAssociations() const;
+
+  /** Get the number of times an idle association has been reused by acquire()
+   *  @return The number of reused associations
+   */
+  unsigned long getNumberOfReusedAssociations() const;
+
+protected:
+
+  /** Create and configure a new SCU for the given key. The default
+   *  implementation creates an instance of DcmSCU and configures it with
+   *  DcmSCUPoolKey::configureSCU().
+   *  @param key The key describing the association
+   *  @return The new SCU, NULL if an error occurred
+   */
+  virtual DcmSCU* createSCU(const DcmSCUPoolKey& key);
+
+  /** Initialize the network of the given SCU prior to the association
+   *  negotiation. The default implementation calls DcmSCU::initNetwork().
+   *  @param scu The SCU created by createSCU()
+   *  @return EC_Normal if successful, error code otherwise
+   */
+  virtual OFCondition initSCU(DcmSCU& scu);
+
+  /** Check whether the association of the given idle SCU can still be used.
+   *  The default implementation sends a C-ECHO request if the Verification
+   *  SOP Class has been negotiated, otherwise it only checks whether the
+   *  association is still established.
+   *  @param scu The idle SCU to be checked
+   *  @return OFTrue if the association can be used, OFFalse otherwise
+   */
+  virtual OFBool checkHealth(DcmSCU& scu);
+
+  /** Release the association of the given SCU (if established) and delete it
+   *  @param scu The SCU to be deleted
+   */
+  virtual void closeSCU(DcmSCU* scu);
+
+private:
+
+  /// An idle association
+  struct IdleEntry
+  {
+    /// The SCU with the established association
+    DcmSCU* scu;
+    /// Identifier of the key of the association
+    OFString key;
+    /// Time (see OFTimer::getTime()) when the association became idle
+    double idleSince;
+  };
+
+  /// An association in use
+  struct ActiveEntry
+  {
+    /// The SCU with the established association
+    DcmSCU* scu;
+    /// Identifier of the key of the association
+    OFString key;
+  };
+
+  /** Private undefined copy-constructor. Shall never be called.
+   *  @param src Source object
+   */
+  DcmSCUPool(const DcmSCUPool& src);
+
+  /** Private undefined operator=. Shall never be called.
+   *  @param src Source object
+   *  @return Reference to this
+   */
+  DcmSCUPool& operator=(const DcmSCUPool& src);
+
+  /** Remove all idle associations that have expired from the list of idle
+   *  associations. Must be called with the mutex locked.
+   *  @param now     The current time (see OFTimer::getTime())
+   *  @param expired The SCUs removed are added to this list
+   */
+  void removeExpired(const double now,
+                     OFList<DcmSCU*>& expired);
+
+  /** Close all SCUs in the given list. Must be called with the mutex unlocked.
+   *  @param scus The SCUs to be closed
+   *  @return Number of SCUs closed
+   */
+  size_t closeAll(OFList<DcmSCU*>& scus);
+
+  /// Idle associations, the most recently used ones first
+  OFList<IdleEntry> m_idle;
+
+  /// Associations in use
+  OFList<ActiveEntry> m_active;
+
+  /// Maximum idle time in seconds
+  Uint32 m_maxIdleTime;
+
+  /// Idle time in seconds after which the health is checked
+  Uint32 m_healthCheckInterval;
+
+  /// Maximum number of idle associations per key
+  size_t m_maxIdlePerKey;
+
+  /// Number of associations negotiated
+  unsigned long m_negotiated;
+
+  /// Number of associations reused
+  unsigned long m_reused;
+
+#ifdef WITH_THREADS
+  /// Mutex protecting the lists and counters
+  mutable OFMutex m_mutex;
+#endif
+};
+
+#endif // SCUPOOL_H
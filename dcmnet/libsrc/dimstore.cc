@@ -467,6 +467,9 @@ DIMSE_storeProvider( T_ASC_Association *assoc,
         } else {
           /* if no error occurred, receive data and write it to the file */
           cond = DIMSE_receiveDataSetInFile(assoc, blockMode, timeout, &presIdData, filestream, privCallback, &callbackCtx);
+          /* close file and check whether all data has been written */
+          OFCondition closeCond = filestream->close(cond.bad());
+          if (cond.good()) cond = closeCond;
           delete filestream;
           if (cond != EC_Normal)
           {
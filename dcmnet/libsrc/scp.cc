@@ -1664,6 +1664,10 @@ OFCondition DcmSCP::receiveSTORERequestDataset(T_ASC_PresentationContextID* pres
                                               NULL /*callback*/,
                                               NULL /*callbackData*/);
         }
+        // Close file and check whether all data has been written
+        OFCondition closeCond = filestream->close(cond.bad());
+        if (cond.good())
+            cond = closeCond;
         delete filestream;
         if (cond.good())
         {
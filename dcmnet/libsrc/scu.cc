@@ -1356,6 +1356,10 @@ OFCondition DcmSCU::handleSTORERequestFile(T_ASC_PresentationContextID* presID,
             cond = DIMSE_receiveDataSetInFile(
                 m_assoc, m_blockMode, m_dimseTimeout, presID, filestream, NULL /*callback*/, NULL /*callbackData*/);
         }
+        // Close file and check whether all data has been written
+        OFCondition closeCond = filestream->close(cond.bad());
+        if (cond.good())
+            cond = closeCond;
         delete filestream;
         if (cond != EC_Normal)
         {
@@ -0,0 +1,534 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Pool of established associations that are kept open and reused
+ *           for repeated operations to the same peer
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+#include "dcmtk/dcmnet/scupool.h"
+#include "dcmtk/dcmnet/diutil.h"   /* for dcmnet logger */
+#include "dcmtk/ofstd/oftimer.h"   /* for OFTimer::getTime() */
+
+
+// ---------------------------------------------------------------------------
+// DcmSCUPoolKey
+// ---------------------------------------------------------------------------
+
+DcmSCUPoolKey::DcmSCUPoolKey(const OFString& peerHost,
+                             const Uint16 peerPort,
+                             const OFString& peerAETitle,
+                             const OFString& ourAETitle)
+  : m_peerHost(peerHost)
+  , m_peerPort(peerPort)
+  , m_peerAETitle(peerAETitle)
+  , m_ourAETitle(ourAETitle)
+  , m_presContexts()
+  , m_identifier()
+{
+    updateIdentifier();
+}
+
+
+OFCondition DcmSCUPoolKey::addPresentationContext(const OFString& abstractSyntax,
+                                                  const OFList<OFString>& xferSyntaxes,
+                                                  const T_ASC_SC_ROLE role)
+{
+    if (abstractSyntax.empty() || xferSyntaxes.empty())
+        return EC_IllegalParameter;
+    PresentationContext pc;
+    pc.abstractSyntax = abstractSyntax;
+    pc.xferSyntaxes = xferSyntaxes;
+    pc.role = role;
+    m_presContexts.push_back(pc);
+    updateIdentifier();
+    return EC_Normal;
+}
+
+
+OFCondition DcmSCUPoolKey::configureSCU(DcmSCU& scu) const
+{
+    scu.setPeerHostName(m_peerHost);
+    scu.setPeerPort(m_peerPort);
+    scu.setPeerAETitle(m_peerAETitle);
+    scu.setAETitle(m_ourAETitle);
+    OFCondition cond;
+    OFListConstIterator(PresentationContext) it = m_presContexts.begin();
+    while ((it != m_presContexts.end()) && cond.good())
+    {
+        cond = scu.addPresentationContext((*it).abstractSyntax, (*it).xferSyntaxes, (*it).role);
+        ++it;
+    }
+    return cond;
+}
+
+
+const OFString& DcmSCUPoolKey::getIdentifier() const
+{
+    return m_identifier;
+}
+
+
+OFBool DcmSCUPoolKey::operator==(const DcmSCUPoolKey& rhs) const
+{
+    return m_identifier == rhs.m_identifier;
+}
+
+
+OFBool DcmSCUPoolKey::operator!=(const DcmSCUPoolKey& rhs) const
+{
+    return m_identifier != rhs.m_identifier;
+}
+
+
+void DcmSCUPoolKey::updateIdentifier()
+{
+    // describe each presentation context by a single string and sort these,
+    // so the order in which the presentation contexts were added does not matter
+    OFList<OFString> pcStrings;
+    char buf[16];
+    OFListConstIterator(PresentationContext) it = m_presContexts.begin();
+    while (it != m_presContexts.end())
+    {
+        OFString pcString = (*it).abstractSyntax;
+        OFStandard::snprintf(buf, sizeof(buf), "|%d", OFstatic_cast(int, (*it).role));
+        pcString += buf;
+        OFListConstIterator(OFString) ts = (*it).xferSyntaxes.begin();
+        while (ts != (*it).xferSyntaxes.end())
+        {
+            pcString += '|';
+            pcString += *ts;
+            ++ts;
+        }
+        // insert sorted (the number of presentation contexts is small)
+        OFListIterator(OFString) pos = pcStrings.begin();
+        while ((pos != pcStrings.end()) && (*pos < pcString))
+            ++pos;
+        pcStrings.insert(pos, pcString);
+        ++it;
+    }
+    // UIDs, AE titles and host names never contain a line feed, so it can be
+    // used as a separator
+    OFStandard::snprintf(buf, sizeof(buf), "%u", OFstatic_cast(unsigned int, m_peerPort));
+    m_identifier = m_peerHost;
+    m_identifier += '\n';
+    m_identifier += buf;
+    m_identifier += '\n';
+    m_identifier += m_peerAETitle;
+    m_identifier += '\n';
+    m_identifier += m_ourAETitle;
+    OFListConstIterator(OFString) pc = pcStrings.begin();
+    while (pc != pcStrings.end())
+    {
+        m_identifier += '\n';
+        m_identifier += *pc;
+        ++pc;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// DcmSCUPool
+// ---------------------------------------------------------------------------
+
+DcmSCUPool::DcmSCUPool()
+  : m_idle()
+  , m_active()
+  , m_maxIdleTime(60)
+  , m_healthCheckInterval(10)
+  , m_maxIdlePerKey(4)
+  , m_negotiated(0)
+  , m_reused(0)
+#ifdef WITH_THREADS
+  , m_mutex()
+#endif
+{
+}
+
+
+DcmSCUPool::~DcmSCUPool()
+{
+    if (!m_active.empty())
+        DCMNET_WARN("SCU pool destroyed while " << m_active.size() << " association(s) are still in use");
+    // calls of virtual methods from the destructor are not dispatched to derived classes
+    OFList<DcmSCU*> idle;
+    OFListIterator(IdleEntry) it = m_idle.begin();
+    while (it != m_idle.end())
+    {
+        idle.push_back((*it).scu);
+        ++it;
+    }
+    m_idle.clear();
+    closeAll(idle);
+}
+
+
+OFCondition DcmSCUPool::acquire(const DcmSCUPoolKey& key,
+                                DcmSCU*& scu)
+{
+    scu = NULL;
+    OFList<DcmSCU*> expired;
+    OFBool found = OFTrue;
+    while ((scu == NULL) && found)
+    {
+        // look for an idle association with the same key (most recently used first)
+        found = OFFalse;
+        OFBool check = OFFalse;
+#ifdef WITH_THREADS
+        m_mutex.lock();
+#endif
+        const double now = OFTimer::getTime();
+        removeExpired(now, expired);
+        OFListIterator(IdleEntry) it = m_idle.begin();
+        while ((it != m_idle.end()) && !found)
+        {
+            if ((*it).key == key.getIdentifier())
+            {
+                found = OFTrue;
+                scu = (*it).scu;
+                check = (now - (*it).idleSince) >= m_healthCheckInterval;
+                m_idle.erase(it);
+            }
+            else
+                ++it;
+        }
+#ifdef WITH_THREADS
+        m_mutex.unlock();
+#endif
+        // check the association outside of the lock, since it may take some time
+        if (scu && (!scu->isConnected() || (check && !checkHealth(*scu))))
+        {
+            DCMNET_DEBUG("SCU pool: idle association to " << scu->getPeerAETitle() << " cannot be used anymore, closing it");
+            closeSCU(scu);
+            scu = NULL;
+        }
+    }
+    closeAll(expired);
+
+    OFCondition cond;
+    if (scu)
+    {
+        DCMNET_DEBUG("SCU pool: reusing idle association to " << scu->getPeerAETitle());
+#ifdef WITH_THREADS
+        m_mutex.lock();
+#endif
+        ++m_reused;
+#ifdef WITH_THREADS
+        m_mutex.unlock();
+#endif
+    }
+    else
+    {
+        // negotiate a new association
+        scu = createSCU(key);
+        if (scu == NULL)
+            return EC_MemoryExhausted;
+        cond = initSCU(*scu);
+        if (cond.good())
+            cond = scu->negotiateAssociation();
+        if (cond.bad())
+        {
+            closeSCU(scu);
+            scu = NULL;
+            return cond;
+        }
+        DCMNET_DEBUG("SCU pool: negotiated new association to " << scu->getPeerAETitle());
+#ifdef WITH_THREADS
+        m_mutex.lock();
+#endif
+        ++m_negotiated;
+#ifdef WITH_THREADS
+        m_mutex.unlock();
+#endif
+    }
+
+    ActiveEntry entry;
+    entry.scu = scu;
+    entry.key = key.getIdentifier();
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    m_active.push_back(entry);
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return cond;
+}
+
+
+void DcmSCUPool::release(DcmSCU* scu,
+                         const OFBool keep)
+{
+    if (scu == NULL)
+        return;
+    OFList<DcmSCU*> toBeClosed;
+    OFBool known = OFFalse;
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    const double now = OFTimer::getTime();
+    OFListIterator(ActiveEntry) it = m_active.begin();
+    while ((it != m_active.end()) && !known)
+    {
+        if ((*it).scu == scu)
+        {
+            known = OFTrue;
+            // count the idle associations with the same key
+            size_t count = 0;
+            OFListConstIterator(IdleEntry) idle = m_idle.begin();
+            while (idle != m_idle.end())
+            {
+                if ((*idle).key == (*it).key)
+                    ++count;
+                ++idle;
+            }
+            if (keep && scu->isConnected() && (count < m_maxIdlePerKey))
+            {
+                IdleEntry entry;
+                entry.scu = scu;
+                entry.key = (*it).key;
+                entry.idleSince = now;
+                m_idle.push_front(entry);
+            }
+            else
+                toBeClosed.push_back(scu);
+            m_active.erase(it);
+        }
+        else
+            ++it;
+    }
+    removeExpired(now, toBeClosed);
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    if (!known)
+        DCMNET_WARN("SCU pool: cannot release association that has not been acquired from the pool, ignoring");
+    closeAll(toBeClosed);
+}
+
+
+size_t DcmSCUPool::closeExpiredAssociations()
+{
+    OFList<DcmSCU*> expired;
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    removeExpired(OFTimer::getTime(), expired);
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return closeAll(expired);
+}
+
+
+size_t DcmSCUPool::closeIdleAssociations()
+{
+    OFList<DcmSCU*> idle;
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    OFListIterator(IdleEntry) it = m_idle.begin();
+    while (it != m_idle.end())
+    {
+        idle.push_back((*it).scu);
+        ++it;
+    }
+    m_idle.clear();
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return closeAll(idle);
+}
+
+
+void DcmSCUPool::setMaxIdleTime(const Uint32 seconds)
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    m_maxIdleTime = seconds;
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+}
+
+
+void DcmSCUPool::setHealthCheckInterval(const Uint32 seconds)
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    m_healthCheckInterval = seconds;
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+}
+
+
+void DcmSCUPool::setMaxIdlePerKey(const size_t maxIdle)
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    m_maxIdlePerKey = maxIdle;
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+}
+
+
+Uint32 DcmSCUPool::getMaxIdleTime() const
+{
+    return m_maxIdleTime;
+}
+
+
+Uint32 DcmSCUPool::getHealthCheckInterval() const
+{
+    return m_healthCheckInterval;
+}
+
+
+size_t DcmSCUPool::getMaxIdlePerKey() const
+{
+    return m_maxIdlePerKey;
+}
+
+
+size_t DcmSCUPool::getNumberOfIdleAssociations() const
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    const size_t result = m_idle.size();
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return result;
+}
+
+
+size_t DcmSCUPool::getNumberOfActiveAssociations() const
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    const size_t result = m_active.size();
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return result;
+}
+
+
+unsigned long DcmSCUPool::getNumberOfNegotiatedAssociations() const
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    const unsigned long result = m_negotiated;
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return result;
+}
+
+
+unsigned long DcmSCUPool::getNumberOfReusedAssociations() const
+{
+#ifdef WITH_THREADS
+    m_mutex.lock();
+#endif
+    const unsigned long result = m_reused;
+#ifdef WITH_THREADS
+    m_mutex.unlock();
+#endif
+    return result;
+}
+
+
+DcmSCU* DcmSCUPool::createSCU(const DcmSCUPoolKey& key)
+{
+    DcmSCU* scu = new DcmSCU();
+    if (key.configureSCU(*scu).bad())
+    {
+        delete scu;
+        scu = NULL;
+    }
+    return scu;
+}
+
+
+OFCondition DcmSCUPool::initSCU(DcmSCU& scu)
+{
+    return scu.initNetwork();
+}
+
+
+OFBool DcmSCUPool::checkHealth(DcmSCU& scu)
+{
+    if (!scu.isConnected())
+        return OFFalse;
+    // without Verification SOP Class, there is no way to check the association
+    const T_ASC_PresentationContextID presID = scu.findAnyPresentationContextID(UID_VerificationSOPClass, "");
+    if (presID == 0)
+        return OFTrue;
+    return scu.sendECHORequest(presID).good();
+}
+
+
+void DcmSCUPool::closeSCU(DcmSCU* scu)
+{
+    if (scu)
+    {
+        if (scu->isConnected())
+            scu->releaseAssociation();
+        delete scu;
+    }
+}
+
+
+void DcmSCUPool::removeExpired(const double now,
+                               OFList<DcmSCU*>& expired)
+{
+    OFListIterator(IdleEntry) it = m_idle.begin();
+    while (it != m_idle.end())
+    {
+        if ((now - (*it).idleSince) >= m_maxIdleTime)
+        {
+            expired.push_back((*it).scu);
+            it = m_idle.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+
+size_t DcmSCUPool::closeAll(OFList<DcmSCU*>& scus)
+{
+    const size_t count = scus.size();
+    OFListIterator(DcmSCU*) it = scus.begin();
+    while (it != scus.end())
+    {
+        closeSCU(*it);
+        ++it;
+    }
+    scus.clear();
+    return count;
+}
@@ -0,0 +1,183 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Test DcmSCUPool and DcmSCUPoolKey classes
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmnet/scupool.h"
+#include "dcmtk/dcmnet/scppool.h"
+
+
+/* Test that keys describing the same associations are equal, independent
+ * of the order of the presentation contexts.
+ */
+OFTEST(dcmnet_scu_pool_key)
+{
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+
+    DcmSCUPoolKey key1("localhost", 11119, "PoolTestSCP", "PoolTestSCU");
+    DcmSCUPoolKey key2("localhost", 11119, "PoolTestSCP", "PoolTestSCU");
+    OFCHECK(key1 == key2);
+    OFCHECK(key1.addPresentationContext(UID_VerificationSOPClass, xfers).good());
+    OFCHECK(key1.addPresentationContext(UID_CTImageStorage, xfers).good());
+    OFCHECK(key1 != key2);
+    OFCHECK(key2.addPresentationContext(UID_CTImageStorage, xfers).good());
+    OFCHECK(key2.addPresentationContext(UID_VerificationSOPClass, xfers).good());
+    OFCHECK(key1 == key2);
+    OFCHECK_EQUAL(key1.getIdentifier(), key2.getIdentifier());
+
+    // different role, peer or AE title
+    DcmSCUPoolKey key3("localhost", 11119, "PoolTestSCP", "PoolTestSCU");
+    OFCHECK(key3.addPresentationContext(UID_VerificationSOPClass, xfers).good());
+    OFCHECK(key3.addPresentationContext(UID_CTImageStorage, xfers, ASC_SC_ROLE_SCUSCP).good());
+    OFCHECK(key1 != key3);
+    OFCHECK(DcmSCUPoolKey("localhost", 11120, "PoolTestSCP", "PoolTestSCU") != DcmSCUPoolKey("localhost", 11119, "PoolTestSCP", "PoolTestSCU"));
+    OFCHECK(DcmSCUPoolKey("localhost", 11119, "OtherSCP", "PoolTestSCU") != DcmSCUPoolKey("localhost", 11119, "PoolTestSCP", "PoolTestSCU"));
+
+    // invalid presentation contexts
+    OFCHECK(key3.addPresentationContext("", xfers).bad());
+    OFCHECK(key3.addPresentationContext(UID_VerificationSOPClass, OFList<OFString>()).bad());
+
+    // configure SCU
+    DcmSCU scu;
+    OFCHECK(key1.configureSCU(scu).good());
+    OFCHECK_EQUAL(scu.getPeerHostName(), "localhost");
+    OFCHECK_EQUAL(scu.getPeerPort(), 11119);
+    OFCHECK_EQUAL(scu.getPeerAETitle(), "PoolTestSCP");
+    OFCHECK_EQUAL(scu.getAETitle(), "PoolTestSCU");
+}
+
+
+#ifdef WITH_THREADS
+
+struct TestSCUPoolSCP : DcmSCPPool<>, OFThread
+{
+    OFCondition result;
+protected:
+    void run()
+    {
+        result = listen();
+    }
+};
+
+
+/* Test starts an SCP pool that responds to C-ECHO and uses an SCU pool for
+ * acquiring and releasing associations to it. Checks that idle associations
+ * are reused, that concurrently acquired associations are distinct, that
+ * different keys result in different associations and that expired
+ * associations are released.
+ */
+OFTEST(dcmnet_scu_pool)
+{
+    TestSCUPoolSCP scp;
+    DcmSCPConfig& config = scp.getConfig();
+    config.setAETitle("PoolTestSCP");
+    config.setPort(11119);
+    config.setConnectionBlockingMode(DUL_NOBLOCK);
+    config.setConnectionTimeout(1);
+    scp.setMaxThreads(4);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_VerificationSOPClass, xfers);
+    scp.start();
+
+    // "ensure" the SCP pool is listening before connecting to it
+    OFStandard::sleep(2);
+
+    DcmSCUPoolKey key1("localhost", 11119, "PoolTestSCP", "PoolTestSCU");
+    OFCHECK(key1.addPresentationContext(UID_VerificationSOPClass, xfers).good());
+
+    DcmSCUPool pool;
+    // check every idle association before reusing it
+    pool.setHealthCheckInterval(0);
+
+    // first association is negotiated
+    DcmSCU *scu1 = NULL;
+    OFCHECK(pool.acquire(key1, scu1).good());
+    OFCHECK(scu1 != NULL);
+    if (scu1 == NULL)
+    {
+        scp.stopAfterCurrentAssociations();
+        scp.join();
+        return;
+    }
+    OFCHECK(scu1->sendECHORequest(0).good());
+    OFCHECK_EQUAL(pool.getNumberOfActiveAssociations(), 1);
+    pool.release(scu1);
+    OFCHECK_EQUAL(pool.getNumberOfActiveAssociations(), 0);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 1);
+
+    // same key reuses the idle association (after a successful health check)
+    DcmSCU *scu2 = NULL;
+    OFCHECK(pool.acquire(key1, scu2).good());
+    OFCHECK(scu2 == scu1);
+    OFCHECK_EQUAL(pool.getNumberOfNegotiatedAssociations(), 1);
+    OFCHECK_EQUAL(pool.getNumberOfReusedAssociations(), 1);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 0);
+
+    // association in use is not handed out twice
+    DcmSCU *scu3 = NULL;
+    OFCHECK(pool.acquire(key1, scu3).good());
+    OFCHECK(scu3 != NULL);
+    OFCHECK(scu3 != scu2);
+    OFCHECK_EQUAL(pool.getNumberOfNegotiatedAssociations(), 2);
+    OFCHECK_EQUAL(pool.getNumberOfActiveAssociations(), 2);
+    pool.release(scu2);
+    pool.release(scu3);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 2);
+
+    // different key requires a new association
+    DcmSCUPoolKey key2("localhost", 11119, "PoolTestSCP", "PoolTestSCU");
+    OFList<OFString> implicitOnly;
+    implicitOnly.push_back(UID_LittleEndianImplicitTransferSyntax);
+    OFCHECK(key2.addPresentationContext(UID_VerificationSOPClass, implicitOnly).good());
+    DcmSCU *scu4 = NULL;
+    OFCHECK(pool.acquire(key2, scu4).good());
+    OFCHECK(scu4 != NULL);
+    OFCHECK(scu4 != scu2);
+    OFCHECK(scu4 != scu3);
+    OFCHECK_EQUAL(pool.getNumberOfNegotiatedAssociations(), 3);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 2);
+    // association that should not be kept is released immediately
+    pool.release(scu4, OFFalse);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 2);
+
+    // idle associations expire immediately with a maximum idle time of 0
+    pool.setMaxIdleTime(0);
+    OFCHECK_EQUAL(pool.closeExpiredAssociations(), 2);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 0);
+    DcmSCU *scu5 = NULL;
+    OFCHECK(pool.acquire(key1, scu5).good());
+    OFCHECK_EQUAL(pool.getNumberOfNegotiatedAssociations(), 4);
+    OFCHECK_EQUAL(pool.getNumberOfReusedAssociations(), 1);
+    pool.release(scu5);
+    OFCHECK_EQUAL(pool.getNumberOfIdleAssociations(), 0);
+    OFCHECK_EQUAL(pool.getNumberOfActiveAssociations(), 0);
+
+    scp.stopAfterCurrentAssociations();
+    scp.join();
+    OFCHECK(scp.result.good());
+}
+
+#endif // WITH_THREADS
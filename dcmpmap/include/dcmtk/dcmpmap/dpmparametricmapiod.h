@@ -23,6 +23,7 @@
 #define DPMPARAMETRICMAPIOD_H
 
 #include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmiod/iodframes.h"
 #include "dcmtk/dcmiod/modimagepixelbase.h"
 #include "dcmtk/dcmpmap/dpmparametricmapbase.h"
 #include "dcmtk/dcmpmap/dpmtypes.h"
@@ -55,6 +56,28 @@ public:
                            const size_t numPixels,
                            const OFVector<FGBase*>& perFrameInformation);
 
+      /** Method that adds a (zero-initialized) frame to the Parametric Map and
+       *  returns a view on it, so that the caller can write the pixel data in
+       *  place instead of handing in a buffer that is copied. The view stays
+       *  valid as long as no further frames are added, or, if the number of
+       *  frames has been reserved using reserve(), until the object is written
+       *  or destroyed.
+       *  @param  perFrameInformation The per-frame functional groups applying for
+       *  @param  frame Returns the view on the frame's pixel data (rows * columns
+       *          pixels), empty view in case of error
+       *  @return EC_Normal if adding was successful, error otherwise
+       */
+      OFCondition addFrame(const OFVector<FGBase*>& perFrameInformation,
+                           DcmIODTypes::FrameView<PixelType>& frame);
+
+      /** Reserve memory for the given total number of frames, so that frames
+       *  are added without reallocation, i.e.\ views returned by addFrame()
+       *  stay valid and no memory besides the final pixel data is needed.
+       *  @param  numFrames The total number of frames to reserve memory for
+       *  @return EC_Normal if successful, error otherwise
+       */
+      OFCondition reserve(const size_t numFrames);
+
       /** Type-specific getFrame() method that returns Float32, Uint16, or whatever
        *  is used in this Parametric Map.
        *  @param  frameNumber The frame number to get, starting from 0
@@ -62,6 +85,12 @@ public:
        */
       PixelType* getFrame(const size_t frameNumber);
 
+      /** Get view on the pixel data of a frame. No pixel data is copied.
+       *  @param  frameNumber The frame number to get, starting from 0
+       *  @return View on the frame's pixel data, empty view if frame does not exist
+       */
+      DcmIODTypes::FrameView<PixelType> getFrameView(const size_t frameNumber);
+
     private:
 
       /// Make sure the Parametric Map object (and no one else) can use the constructor below.
@@ -72,6 +101,12 @@ public:
        */
       Frames(DPMParametricMapIOD& map);
 
+      /** Initialize frame store of the Parametric Map (if not done yet) based
+       *  on Rows, Columns and the pixel type
+       *  @return EC_Normal if successful, error otherwise
+       */
+      OFCondition initFrames();
+
       /// Reference to Parametric Map object in order to access its pixel data
       DPMParametricMapIOD& m_Map;
   };
@@ -159,6 +194,15 @@ public:
    */
   static OFvariant<OFCondition,DPMParametricMapIOD*> loadDataset(DcmDataset& dataset);
 
+  /** Save current object to given filename. The pixel data is not copied
+   *  for that purpose.
+   *  @param  filename The file to write to
+   *  @param  writeXfer The transfer syntax to be used
+   *  @return EC_Normal if writing was successful, error otherwise.
+   */
+  virtual OFCondition saveFile(const OFString& filename,
+                               const E_TransferSyntax writeXfer = EXS_LittleEndianExplicit);
+
   /** Read Parametric Map attributes (all those handled by this class)
    *  from given item. Reads attributes from base class DcmIODCommon before.
    *  The current content is deleted even if the reading process fails.
@@ -262,11 +306,21 @@ private:
   // Forward declarations
   template<typename PixelType> class GetPixelDataVisitor;
   struct SetImagePixelModuleVisitor;
-  struct WriteVisitor;
   struct GetFramesVisitor;
   struct ReadVisitor;
   struct ReadFramesVisitor;
 
+  /** Load Parametric Map object from dataset object, see loadDataset()
+   *  @param  dataset The dataset to read from
+   *  @param  takeOverPixelData If OFTrue, the pixel data element is removed
+   *          from the dataset and used by the Parametric Map directly instead
+   *          of being copied
+   *  @return Variant, either the resulting Parametric Map object in case of success,
+   *          an OFCondition error code otherwise
+   */
+  static OFvariant<OFCondition,DPMParametricMapIOD*> loadDataset(DcmDataset& dataset,
+                                                                 const OFBool takeOverPixelData);
+
   /** Initialize new Parametric Map object except directly pixel-related data
    *  @param  modality The modality of this Parametric Map (series level attribute).
    *          A list of Defined Terms can be found in the standard. Very often
@@ -298,8 +352,8 @@ private:
   /// Parametric Map Image Module's Content Identification
   ContentIdentificationMacro m_ContentIdentification;
 
-  /// Binary frame data
-  OFVector<DcmIODTypes::Frame*> m_Frames;
+  /// Binary frame data, stored contiguously in a single pixel data element
+  IODFrameStore m_Frames;
 
 };
 
@@ -23,6 +23,25 @@
 #include "dcmtk/dcmpmap/dpmparametricmapiod.h"
 #include "dcmtk/dcmiod/iodutil.h"
 
+// Get pixel data attribute used for the given pixel type
+template<typename PixelType>
+static DcmTagKey getPixelDataTag()
+{
+  return DCM_PixelData;
+}
+
+template<>
+DcmTagKey getPixelDataTag<Float32>()
+{
+  return DCM_FloatPixelData;
+}
+
+template<>
+DcmTagKey getPixelDataTag<Float64>()
+{
+  return DCM_DoubleFloatPixelData;
+}
+
 // ----------------------------------------------------------------------------
 // Class SetImagePixelModuleVisitor:
 // Class for setting Image Pixel Module attributes based on pixel data type
@@ -92,9 +111,11 @@ struct DPMParametricMapIOD::ReadVisitor
   class DcmElementOf;
 
   ReadVisitor(DcmItem& srcItem,
-              DPMParametricMapIOD& m)
+              DPMParametricMapIOD& m,
+              const OFBool takeOverPixelData = OFFalse)
   : item(srcItem)
   , map(m)
+  , takeOver(takeOverPixelData)
   {
     // Nothing to do
   }
@@ -129,387 +150,33 @@ struct DPMParametricMapIOD::ReadVisitor
     return result;
   }
 
-  template<typename T>
-  OFCondition readSpecific(IODImagePixelModule<T>& p,
+  template<typename ImagePixel>
+  OFCondition readSpecific(ImagePixel& p,
                            const Uint32 numFrames,
                            const size_t numBytesFrame)
   {
     // Avoid compiler warning about unused parameter
     (void)p;
-    unsigned long numTotalWords = 0;
-    const Uint16* pixData = NULL;
-    if (item.findAndGetUint16Array(DCM_PixelData, pixData, &numTotalWords).good())
-    {
-      if (numTotalWords == numBytesFrame * numFrames / 2 /* we compare to num words not num bytes */)
-      {
-        for (Uint32 n = 0; n < numFrames; n++)
-        {
-          DcmIODTypes::Frame* f = new DcmIODTypes::Frame;
-          if (f)
-          {
-            f->length = numBytesFrame;
-            f->pixData = new Uint8[f->length];
-            memcpy(f->pixData, pixData + n*numBytesFrame/2, numBytesFrame);
-            map.m_Frames.push_back(f);
-          }
-          else
-          {
-            return EC_MemoryExhausted;
-          }
-        }
-      }
-      else
-      {
-        DCMPMAP_ERROR("Invalid number of pixels: Expected " << numBytesFrame * numFrames / 2 << " pixels but Pixel Data has " << numTotalWords << " pixels");
-        return DPM_InvalidPixelInfo;
-      }
-    }
-    else
-    {
-      DCMPMAP_ERROR("No Pixel Data element found");
-      return DPM_NoPixelData;
-    }
-    return EC_Normal;
-  }
-
-  OFCondition readSpecific(IODFloatingPointImagePixelModule& p,
-                           const Uint32 numFrames,
-                           const size_t numBytesFrame)
-  {
-    // Avoid compiler warning on unused parameter
-    (void)p;
-    unsigned long numTotalFloats = 0;
-    const Float32* pixData = NULL;
-    if (item.findAndGetFloat32Array(DCM_FloatPixelData, pixData, &numTotalFloats).good())
+    const DcmTagKey tag = getPixelDataTag<OFTypename ImagePixel::value_type>();
+    if (!item.tagExists(tag))
     {
-      if (numTotalFloats == numBytesFrame * numFrames / 4 /* we compare to 32 bit floats not bytes */)
-      {
-        for (Uint32 n=0; n < numFrames; n++)
-        {
-          DcmIODTypes::Frame* f = new DcmIODTypes::Frame;
-          if (f)
-          {
-            f->length = numBytesFrame;
-            f->pixData = new Uint8[f->length];
-            memcpy(f->pixData, pixData + n*numBytesFrame/4, numBytesFrame);
-            map.m_Frames.push_back(f);
-          }
-          else
-          {
-            return EC_MemoryExhausted;
-          }
-        }
-      }
-      else
-      {
-        DCMPMAP_ERROR("Invalid number of pixels: Expected " << numBytesFrame * numFrames / 4 << " pixels but Float Pixel Data has " << numTotalFloats << " pixels");
-        return DPM_InvalidPixelInfo;
-      }
-    }
-    else
-    {
-      DCMPMAP_ERROR("No Float Pixel Data element found");
-      return DPM_NoPixelData;
-    }
-    return EC_Normal;
-  }
-
-  OFCondition readSpecific(IODDoubleFloatingPointImagePixelModule& p,
-                           const Uint32 numFrames,
-                           const size_t numBytesFrame)
-  {
-    // Avoid compiler warning on unused parameter
-    (void)p;
-    unsigned long numTotalFloats = 0;
-    const Float64* pixData = NULL;
-    if (item.findAndGetFloat64Array(DCM_DoubleFloatPixelData, pixData, &numTotalFloats).good())
-    {
-      if (numTotalFloats == numBytesFrame * numFrames / 8 /* we compare to 64 bit floats not bytes */)
-      {
-        for (Uint16 n=0; n < numFrames; n++)
-        {
-          DcmIODTypes::Frame* f = new DcmIODTypes::Frame;
-          if (f)
-          {
-            f->length = numBytesFrame;
-            f->pixData = new Uint8[f->length];
-            memcpy(f->pixData, pixData + n*numBytesFrame/8, numBytesFrame);
-            map.m_Frames.push_back(f);
-          }
-          else
-          {
-            return EC_MemoryExhausted;
-          }
-        }
-      }
-      else
-      {
-        DCMPMAP_ERROR("Invalid number of pixels: Expected " << numBytesFrame * numFrames / 8 << " pixels but Double Float Pixel Data has " << numTotalFloats << " pixels");
-        return DPM_InvalidPixelInfo;
-      }
-    }
-    else
-    {
-      DCMPMAP_ERROR("No Double Float Pixel Data element found");
+      DCMPMAP_ERROR("No " << DcmTag(tag).getTagName() << " element found");
       return DPM_NoPixelData;
     }
+    // Frames are not copied but refer to the pixel data element directly
+    if (map.m_Frames.read(item, tag, numBytesFrame, numFrames, takeOver).bad())
+      return DPM_InvalidPixelInfo;
     return EC_Normal;
   }
 
   // Members, i.e. parameters to operator()
   DcmItem& item;
   DPMParametricMapIOD& map;
+  OFBool takeOver;
 };
 
 
 
-// ----------------------------------------------------------------------------
-// Class WriteVisitor:
-// Class for adding DICOM pixel data bulk element based on type pixel data type
-// ----------------------------------------------------------------------------
-
-// Generic implementation, template specialization is done in inner
-// DcmElementOf class
-struct DPMParametricMapIOD::WriteVisitor
-{
-  // Inner class that implements the specializations for different
-  // pixel data types
-  template<typename T>
-  class DcmElementOf;
-
-  // Constructor, sets parameters the visitor works on in operator()
-  WriteVisitor(DcmItem& i,
-               DPMParametricMapIOD& m)
-  : item(i)
-  , map(m)
-  {
-    // Nothing else to do
-  }
-
-  //
-  OFCondition operator()(OFmonostate)
-  {
-    DCMPMAP_ERROR("Could not write pixel data: Invalid pixel data type, only 16 bit integer as well as 32 and 64 bit float data are handled");
-    return DPM_NoPixelData;
-  }
-
-  template<typename ImagePixel>
-  OFCondition operator()(ImagePixel& pixel)
-  {
-    // Avoid compiler warning about unused parameter "pixel"
-    (void)pixel;
-    // Input data is checked before
-    Uint16 rows = 0;
-    Uint16 cols = 0;
-    map.getRows(rows);
-    map.getColumns(cols);
-    const size_t numFrames = map.m_Frames.size();
-    const size_t numBytesFrame = map.m_Frames[0]->length;
-    const size_t numPixelsFrame = rows * cols;
-    // Creates the correct pixel data element, based on the image pixel module used.
-    // I.e. For integer data, the "Pixel Data" element is used, i.e. the DcmElement type
-    // instantiated by DcmElementOf is of DCMTK type DcmOtherByteOtherWord while for
-    // IODFloatingPointImagePixelModule which has floating point pixel data, DcmFloatingPointSingle
-    // is used.
-    DcmElementOf<ImagePixel> element;
-    // copy all frames into map's frame structure
-    if (OFTypename ImagePixel::value_type* ptr = element.getData(numBytesFrame * numFrames))
-    {
-      for (size_t f = 0; f < numFrames; ++f)
-      {
-        memcpy(ptr, map.m_Frames[f]->pixData, numBytesFrame);
-        ptr += numPixelsFrame;
-      }
-      OFCondition result = element.put(item);
-      // Write generic (i.e. non pixel data-specific attributes)
-      return result.good() ? map.writeGeneric(item) : result;
-    }
-    return EC_MemoryExhausted;
-  }
-
-  // Members, i.e. parameters to operator()
-  DcmItem& item;
-  DPMParametricMapIOD& map;
-};
-
-
-// ----------------------------------------------------------------------------
-// Class WriteVisitor:DcmElementOf<IODImagePixelModule<PixelType> >:
-// Offers creation and insertion for Pixel Data element as used for
-// int-based pixel data. So far, Uint8, Sint8, Uint16 and Sint16 pixel
-// data is supported (relates to OB/OW data type for DICOM Pixel data)
-// ----------------------------------------------------------------------------
-
-template<typename PixelType>
-class DPMParametricMapIOD::WriteVisitor::DcmElementOf<IODImagePixelModule<PixelType> >
-{
-public:
-
-  DcmElementOf()
-  : m_pElement(new DcmOtherByteOtherWord(DCM_PixelData))
-  {
-    // Nothing else to do
-  }
-
-  PixelType* getData(const size_t count);
-
-  OFCondition put(DcmItem& itemPara)
-  {
-    OFCondition result = itemPara.insert(m_pElement.get(), OFTrue);
-    if (result.good())
-      m_pElement.release();
-    return result;
-  }
-
-private:
-
-  OFunique_ptr<DcmOtherByteOtherWord> m_pElement;
-};
-
-
-template<>
-Uint16* DPMParametricMapIOD::WriteVisitor::DcmElementOf<IODImagePixelModule<Uint16> >::getData(const size_t size /* num total pixels */)
-{
-  if (m_pElement)
-  if (m_pElement->setVR(EVR_OW).good())
-  {
-    Uint16* result;
-    if (m_pElement->createUint16Array(OFstatic_cast(Uint32, size/2), result).good())
-      return result;
-  }
-  return OFnullptr;
-}
-
-
-template<>
-Sint16* DPMParametricMapIOD::WriteVisitor::DcmElementOf<IODImagePixelModule<Sint16> >::getData(const size_t size)
-{
-  if (m_pElement)
-  if (m_pElement->setVR(EVR_OW).good())
-  {
-    Uint16* result;
-    if (m_pElement->createUint16Array(OFstatic_cast(Uint32, size/2), result).good())
-      return OFreinterpret_cast(Sint16*, result);
-  }
-  return OFnullptr;
-}
-
-
-// ----------------------------------------------------------------------------
-// Class WriteVisitor:DcmElementOf<IODImagePixelModule<IODFloatingPointImagePixelModule> >:
-// Offers creation and insertion for Pixel Data element as used for
-// 32 bit float-based pixel data as used in Parametric Map IOD
-// ----------------------------------------------------------------------------
-
-template<>
-class DPMParametricMapIOD::WriteVisitor::DcmElementOf<IODFloatingPointImagePixelModule>
-{
-public:
-  DcmElementOf()
-  : m_pElement(new DcmFloatingPointSingleAlloc(DCM_FloatPixelData))
-  {
-
-  }
-
-  Float32* getData(const size_t size)
-  {
-    if (m_pElement)
-    {
-      Float32* result;
-      if (m_pElement->createFloat32Array(size, result).good())
-        return result;
-    }
-    return OFnullptr;
-  }
-
-  OFCondition put(DcmItem& itemPara)
-  {
-    OFCondition result = itemPara.insert(m_pElement.get(), OFTrue);
-    if (result.good())
-      m_pElement.release();
-    return result;
-  }
-
-private:
-
-  struct DcmFloatingPointSingleAlloc : DcmFloatingPointSingle
-  {
-    DcmFloatingPointSingleAlloc(const DcmTagKey& tag)
-    : DcmFloatingPointSingle(tag)
-    {
-
-    }
-
-    OFCondition createFloat32Array(const size_t size,
-                                   Float32*& result)
-    {
-       OFCondition status = createEmptyValue(OFstatic_cast(Uint32, size));
-       result = OFreinterpret_cast(Float32*, getValue());
-       return status;
-    }
-  };
-
-  OFunique_ptr<DcmFloatingPointSingleAlloc> m_pElement;
-};
-
-
-// ----------------------------------------------------------------------------
-// Class WriteVisitor:DcmElementOf<IODImagePixelModule<IODFloatingPointImagePixelModule> >:
-// Offers creation and insertion for Pixel Data element as used for
-// 64 bit float-based pixel data as used in Parametric Map IOD.
-// ----------------------------------------------------------------------------
-
-template<>
-class DPMParametricMapIOD::WriteVisitor::DcmElementOf<IODDoubleFloatingPointImagePixelModule>
-{
-public:
-  DcmElementOf()
-  : m_pElement(new DcmFloatingPointDoubleAlloc(DCM_DoubleFloatPixelData))
-  {
-
-  }
-
-  Float64* getData(const size_t size)
-  {
-    if (m_pElement)
-    {
-      Float64* result;
-      if (m_pElement->createFloat64Array(size, result).good())
-        return result;
-    }
-    return OFnullptr;
-  }
-
-  OFCondition put(DcmItem& itemPara)
-  {
-    OFCondition result = itemPara.insert(m_pElement.get(), OFTrue);
-    if (result.good())
-      m_pElement.release();
-    return result;
-  }
-
-private:
-
-  struct DcmFloatingPointDoubleAlloc : DcmFloatingPointDouble
-  {
-    DcmFloatingPointDoubleAlloc(const DcmTagKey& tag)
-    : DcmFloatingPointDouble(tag)
-    {
-
-    }
-
-    OFCondition createFloat64Array(const size_t size, Float64*& result)
-    {
-       OFCondition status = createEmptyValue(OFstatic_cast(Uint32, size));
-       result = OFreinterpret_cast(Float64*, getValue());
-       return status;
-    }
-  };
-
-  OFunique_ptr<DcmFloatingPointDoubleAlloc> m_pElement;
-};
-
-
 // Helper "class" that returns Frames offering API to the pixel's frame bulk
 // data by offering the dedicated data type, e.g. Float32 instead of the
 // internally stored generic Uint8 array.
@@ -576,6 +243,24 @@ DPMParametricMapIOD::Frames<PixelType>::Frames(DPMParametricMapIOD& map)
 }
 
 
+template<typename PixelType>
+OFCondition DPMParametricMapIOD::Frames<PixelType>::initFrames()
+{
+  if (m_Map.m_Frames.isInitialized())
+    return EC_Normal;
+  Uint16 rows = 0;
+  Uint16 cols = 0;
+  m_Map.getRows(rows);
+  m_Map.getColumns(cols);
+  if (!rows || !cols)
+  {
+    DCMPMAP_ERROR("Rows (" << rows << ") and Columns (" << cols << ") must not be 0");
+    return DPM_InvalidPixelInfo;
+  }
+  return m_Map.m_Frames.init(getPixelDataTag<PixelType>(), OFstatic_cast(size_t,rows) * cols * sizeof(PixelType));
+}
+
+
 template<typename PixelType>
 OFCondition DPMParametricMapIOD::Frames<PixelType>::addFrame(PixelType* data,
                                                              const size_t numPixels,
@@ -586,42 +271,90 @@ OFCondition DPMParametricMapIOD::Frames<PixelType>::addFrame(PixelType* data,
   {
     if (!perFrameInformation.empty())
     {
-      OFunique_ptr<DcmIODTypes::Frame> f(new DcmIODTypes::Frame);
-      if (f)
+      result = initFrames();
+      if (result.good() && (numPixels * sizeof(PixelType) != m_Map.m_Frames.getBytesPerFrame()))
       {
-        f->length = numPixels * sizeof(PixelType);
-        f->pixData = new Uint8[f->length];
-        memcpy(f->pixData, data, f->length);
-        m_Map.m_Frames.push_back(f.release());
-        OFVector<FGBase*>::const_iterator fg = perFrameInformation.begin();
-        while ( result.good() && (fg != perFrameInformation.end()) )
-        {
-          result = m_Map.m_FGInterface.addPerFrame(OFstatic_cast(Uint32, m_Map.m_Frames.size()), **fg);
-          if (result.bad())
-          {
-            DCMPMAP_ERROR("Could not add functional group: " << DcmFGTypes::FGType2OFString((*fg)->getType()));
-            break;
-          }
-          ++fg;
-        }
+        DCMPMAP_ERROR("Cannot add frame: Expected " << m_Map.m_Frames.getBytesPerFrame() / sizeof(PixelType) << " pixels but got " << numPixels);
+        result = DPM_InvalidPixelInfo;
       }
+      DcmIODTypes::FrameView<PixelType> frame;
+      if (result.good())
+        result = addFrame(perFrameInformation, frame);
+      if (result.good())
+        memcpy(frame.data(), data, numPixels * sizeof(PixelType));
     }
   }
-  // Clean up if necessary
-  if (result.bad())
-    m_Map.m_FGInterface.deleteFrame(OFstatic_cast(Uint32, m_Map.m_Frames.size()));
   return result;
 }
 
 
 template<typename PixelType>
-PixelType* DPMParametricMapIOD::Frames<PixelType>::getFrame(const size_t frameNumber)
+OFCondition DPMParametricMapIOD::Frames<PixelType>::addFrame(const OFVector<FGBase*>& perFrameInformation,
+                                                             DcmIODTypes::FrameView<PixelType>& frame)
 {
-  if (frameNumber < m_Map.m_Frames.size())
+  frame = DcmIODTypes::FrameView<PixelType>();
+  if (perFrameInformation.empty())
   {
-    return (PixelType*)(m_Map.m_Frames[frameNumber]->pixData);
+    DCMPMAP_ERROR("Cannot add frame: No per-frame functional groups given");
+    return EC_IllegalParameter;
   }
-  return NULL;
+  OFCondition result = initFrames();
+  Uint8* pixData = NULL;
+  if (result.good())
+    result = m_Map.m_Frames.addEmptyFrame(pixData);
+  if (result.good())
+  {
+    OFVector<FGBase*>::const_iterator fg = perFrameInformation.begin();
+    while ( result.good() && (fg != perFrameInformation.end()) )
+    {
+      result = m_Map.m_FGInterface.addPerFrame(OFstatic_cast(Uint32, m_Map.m_Frames.getNumberOfFrames()), **fg);
+      if (result.bad())
+      {
+        DCMPMAP_ERROR("Could not add functional group: " << DcmFGTypes::FGType2OFString((*fg)->getType()));
+        break;
+      }
+      ++fg;
+    }
+    // Clean up if necessary
+    if (result.bad())
+    {
+      m_Map.m_FGInterface.deleteFrame(OFstatic_cast(Uint32, m_Map.m_Frames.getNumberOfFrames()));
+      m_Map.m_Frames.removeLastFrame();
+    }
+    else
+    {
+      frame = DcmIODTypes::FrameView<PixelType>(OFreinterpret_cast(PixelType*, pixData),
+                                                m_Map.m_Frames.getBytesPerFrame() / sizeof(PixelType));
+    }
+  }
+  return result;
+}
+
+
+template<typename PixelType>
+OFCondition DPMParametricMapIOD::Frames<PixelType>::reserve(const size_t numFrames)
+{
+  OFCondition result = initFrames();
+  if (result.good())
+    result = m_Map.m_Frames.reserve(numFrames);
+  return result;
+}
+
+
+template<typename PixelType>
+PixelType* DPMParametricMapIOD::Frames<PixelType>::getFrame(const size_t frameNumber)
+{
+  return OFreinterpret_cast(PixelType*, m_Map.m_Frames.getFrame(frameNumber));
+}
+
+
+template<typename PixelType>
+DcmIODTypes::FrameView<PixelType> DPMParametricMapIOD::Frames<PixelType>::getFrameView(const size_t frameNumber)
+{
+  PixelType* pixData = getFrame(frameNumber);
+  if (pixData)
+    return DcmIODTypes::FrameView<PixelType>(pixData, m_Map.m_Frames.getBytesPerFrame() / sizeof(PixelType));
+  return DcmIODTypes::FrameView<PixelType>();
 }
 
 
@@ -783,11 +516,42 @@ OFCondition DPMParametricMapIOD::write(DcmItem& dataset)
 {
   if (!check())
     return DPM_InvalidAttributeValue;
-  return OFvisit<OFCondition>(WriteVisitor(dataset,*this),getImagePixel());
+  OFCondition result = m_Frames.write(dataset);
+  // Write generic (i.e. non pixel data-specific attributes)
+  if (result.good())
+    result = writeGeneric(dataset);
+  return result;
+}
+
+
+OFCondition DPMParametricMapIOD::saveFile(const OFString& filename,
+                                          const E_TransferSyntax writeXfer)
+{
+  if (!check())
+    return DPM_InvalidAttributeValue;
+  // Lend pixel data element to the dataset while saving instead of copying it
+  DcmFileFormat dcmff;
+  DcmDataset* dset = dcmff.getDataset();
+  OFCondition result = writeGeneric(*dset);
+  if (result.good())
+    result = m_Frames.insertInto(*dset);
+  if (result.good())
+    result = dcmff.saveFile(filename.c_str(), writeXfer);
+  m_Frames.removeFrom(*dset);
+  if (result.bad())
+    DCMPMAP_ERROR("Cannot save Parametric Map object to file " << filename << ": " << result.text());
+  return result;
 }
 
 
 OFvariant<OFCondition,DPMParametricMapIOD*> DPMParametricMapIOD::loadDataset(DcmDataset& dataset)
+{
+  return loadDataset(dataset, OFFalse /* copy pixel data */);
+}
+
+
+OFvariant<OFCondition,DPMParametricMapIOD*> DPMParametricMapIOD::loadDataset(DcmDataset& dataset,
+                                                                             const OFBool takeOverPixelData)
 {
   OFString sopClass;
   DPMParametricMapIOD *map = NULL;
@@ -839,11 +603,11 @@ OFvariant<OFCondition,DPMParametricMapIOD*> DPMParametricMapIOD::loadDataset(Dcm
       return DPM_InvalidSOPClass;
     }
   }
-  OFCondition result = OFvisit<OFCondition>(ReadVisitor(dataset, *map), map->getImagePixel());
+  OFCondition result = OFvisit<OFCondition>(ReadVisitor(dataset, *map, takeOverPixelData), map->getImagePixel());
   if (result.good())
     return map;
-  else
-    return result;
+  delete map;
+  return result;
 }
 
 
@@ -854,7 +618,8 @@ OFvariant<OFCondition,DPMParametricMapIOD*> DPMParametricMapIOD::loadFile(const
   OFvariant<OFCondition,DPMParametricMapIOD*> result;
   if (cond.good())
   {
-     result = loadDataset( *(dcmff.getDataset()) );
+     // The file format is not used afterwards, so take over its pixel data
+     result = loadDataset( *(dcmff.getDataset()), OFTrue /* take over pixel data */ );
      return result;
   }
   else
@@ -866,8 +631,7 @@ OFvariant<OFCondition,DPMParametricMapIOD*> DPMParametricMapIOD::loadFile(const
 
 DPMParametricMapIOD::~DPMParametricMapIOD()
 {
-  DcmIODUtil::freeContainer(m_Frames);
-  // nothing else to do for now
+  // nothing to do for now
 }
 
 
@@ -886,7 +650,7 @@ OFBool DPMParametricMapIOD::check()
     m_DPMParametricMapImageModule.getContentQualification(val);
     if (DPMTypes::cqValid(DPMTypes::str2Cq(val)))
     {
-      if (!m_Frames.empty())
+      if (m_Frames.getNumberOfFrames() > 0)
       {
         return OFTrue;
       }
@@ -949,7 +713,7 @@ OFCondition DPMParametricMapIOD::readGeneric(DcmItem& dataset)
 OFCondition DPMParametricMapIOD::writeGeneric(DcmItem& dataset)
 {
   getFrameOfReference().ensureFrameOfReferenceUID();
-  m_IODMultiFrameFGModule.setNumberOfFrames(DcmIODUtil::limitMaxFrames(m_Frames.size(), "Maximum number of frames exceeded, will write 2147483647"));
+  m_IODMultiFrameFGModule.setNumberOfFrames(DcmIODUtil::limitMaxFrames(m_Frames.getNumberOfFrames(), "Maximum number of frames exceeded, will write 2147483647"));
   OFCondition result = m_ContentIdentification.write(dataset);
   if (result.good())
   {
@@ -25,6 +25,7 @@
 
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 #include "dcmtk/dcmpstat/dcmpstat.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 class DicomImage;
 class DiDisplayFunction;
@@ -880,6 +881,29 @@ public:
       void *pixelData,
       unsigned long size);
 
+   /** sets the maximum number of rendered frames kept by getPixelData().
+    *  As long as none of the parameters that affect the pixel data (i.e.\ VOI
+    *  transformation, presentation LUT, overlays, bitmap shutter, rotation, flip
+    *  and display transform) is changed, a frame that has been rendered before
+    *  is returned without running the rendering pipeline again. Changing one of
+    *  these parameters only recomputes the affected stages for the next frame
+    *  rendered. Default is 4 frames.
+    *  @param frames maximum number of rendered frames kept, 0 disables the cache
+    */
+    void setRenderCacheSize(size_t frames);
+
+   /** returns the maximum number of rendered frames kept by getPixelData().
+    *  @return maximum number of rendered frames kept, 0 if the cache is disabled
+    */
+    size_t getRenderCacheSize() const { return renderCacheSize; }
+
+   /** marks all rendered frames kept by getPixelData() as outdated.
+    *  This is done automatically when a parameter of the presentation state is
+    *  changed, but it needs to be called when one of the display functions passed
+    *  to the constructor has been modified (e.g.\ the ambient light value).
+    */
+    void invalidateRenderCache();
+
     /** returns the SOP Class UID of the currently attached image.
      *  @return SOP class UID of current image, NULL if absent
      */
@@ -1176,6 +1200,19 @@ private:
    /// private undefined assignment operator
    DVPresentationState& operator=(const DVPresentationState& other);
 
+   /** renders the currently selected frame of the attached image (if needed)
+    *  and returns the 8 bit pixel data. If the frame is kept in the render
+    *  cache and still up to date, it is returned without being rendered again.
+    *  May only be called if an image is attached.
+    *  @param size returns the size of the pixel data in bytes
+    *  @return pointer to the pixel data, NULL if an error occurred
+    */
+   const void *getRenderedFrame(unsigned long &size);
+
+   /** deletes all rendered frames kept by getPixelData()
+    */
+   void clearRenderCache();
+
    /** helper method that activates the given overlay in the given image
     *  @param ovl overlay to activate
     *  @param image image to be rendered
@@ -1301,6 +1338,38 @@ private:
     */
    DiDisplayFunction **displayFunction;
 
+   /** a rendered frame kept by getPixelData()
+    */
+   struct RenderCacheEntry
+   {
+     /// frame number (counted from 1)
+     unsigned long frame;
+     /// rendered pixel data (8 bit)
+     Uint8 *data;
+     /// size of the pixel data in bytes
+     unsigned long size;
+     /// true if the pixel data matches the current rendering parameters
+     OFBool valid;
+     /// value of renderCacheCounter when the frame was last returned
+     unsigned long lastUse;
+   };
+
+   /** rendered frames of the attached image
+    */
+   OFVector<RenderCacheEntry> renderCache;
+
+   /** maximum number of entries in renderCache, 0 if disabled
+    */
+   size_t renderCacheSize;
+
+   /** counter used to find the least recently used entry of renderCache
+    */
+   unsigned long renderCacheCounter;
+
+   /** display function that has been set for currentImage by renderPixelData()
+    */
+   DiDisplayFunction *currentImageDisplayFunction;
+
    /** minimum width of print bitmap (used for implicit scaling)
     */
    unsigned long minimumPrintBitmapWidth;
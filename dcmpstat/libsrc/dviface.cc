@@ -2183,6 +2183,9 @@ OFCondition DVInterface::setAmbientLightValue(double value)
         if ((displayFunction[i] != NULL) && (displayFunction[i]->setAmbientLightValue(value)))
             result = EC_Normal;         // at least one display function has been valid
     }
+    // rendered frames have been created with the old display function
+    if ((result.good()) && (pState != NULL))
+        pState->invalidateRenderCache();
     return result;
 }
 
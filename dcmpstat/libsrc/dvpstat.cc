@@ -85,6 +85,10 @@ DVPresentationState::DVPresentationState(
 , displayTransform(DVPSD_GSDF)
 , imageInverse(OFFalse)
 , displayFunction(dispFunction)
+, renderCache()
+, renderCacheSize(4)
+, renderCacheCounter(0)
+, currentImageDisplayFunction(NULL)
 , minimumPrintBitmapWidth(minPrintBitmapX)
 , minimumPrintBitmapHeight(minPrintBitmapY)
 , maximumPrintBitmapWidth(maxPrintBitmapX)
@@ -137,6 +141,8 @@ void DVPresentationState::detachImage()
   currentImageSOPClassUID=NULL;
   currentImageSOPInstanceUID=NULL;
   currentImageSelectedFrame=0;
+  currentImageDisplayFunction = NULL;
+  clearRenderCache();
 }
 
 
@@ -1476,8 +1482,18 @@ void DVPresentationState::renderPixelData(OFBool display)
 {
   if (currentImage == NULL) return;
   int result=0;
+  /* set if any of the stages below changes the rendered pixel data */
+  OFBool changed = OFFalse;
 
   /* activate Barten transform */
+  DiDisplayFunction *dispFunction = NULL;
+  if (displayFunction && (displayTransform != DVPSD_none) && display)
+    dispFunction = displayFunction[displayTransform];
+  if (dispFunction != currentImageDisplayFunction)
+  {
+    currentImageDisplayFunction = dispFunction;
+    changed = OFTrue;
+  }
   if (displayFunction && (displayTransform != DVPSD_none) && display)
   {
     currentImage->setDisplayFunction(displayFunction[displayTransform]);
@@ -1492,6 +1508,7 @@ void DVPresentationState::renderPixelData(OFBool display)
   if (! currentImageVOIValid)
   {
      currentImageVOIValid = OFTrue;
+     changed = OFTrue;
 
      /* set VOI transformation */
      DVPSSoftcopyVOI *voi = getCurrentSoftcopyVOI();
@@ -1527,6 +1544,7 @@ void DVPresentationState::renderPixelData(OFBool display)
 
   if (! currentImagePLUTValid)
   {
+     changed = OFTrue;
      presentationLUT.activate(currentImage);
      if (previewImage != NULL)
        presentationLUT.activate(previewImage);
@@ -1541,6 +1559,7 @@ void DVPresentationState::renderPixelData(OFBool display)
     if (EC_Normal != shutterPresentationValue.getUint16(bitmapShutterPValue, 0)) bitmapShutterPValue=0;
   }
 
+  if (currentImageOverlaysValid != 2) changed = OFTrue;
   if (currentImageOverlaysValid==1)
   {
     /* overlays are invalid but no external overlays have been added */
@@ -1758,6 +1777,9 @@ void DVPresentationState::renderPixelData(OFBool display)
   currentImageRotation = pstateRotation;
   currentImageFlip = pstateFlip;
 
+  /* rendered frames kept in the cache do not match the new parameters */
+  if (changed || (rot != 0) || flp) invalidateRenderCache();
+
   return;
 }
 
@@ -1830,10 +1852,10 @@ OFCondition DVPresentationState::getPixelData(
 {
    if (currentImage)
    {
-     renderPixelData();
+     unsigned long size = 0;
+     pixelData = getRenderedFrame(size);
      width = currentImage->getWidth();
      height = currentImage->getHeight();
-     pixelData = currentImage->getOutputData(8, currentImageSelectedFrame-1);
    } else {
      pixelData = NULL;
      width = 0;
@@ -1849,13 +1871,91 @@ OFCondition DVPresentationState::getPixelData(
 {
    if (currentImage)
    {
-     renderPixelData();
-     if (currentImage->getOutputData(pixelData, size, 8, currentImageSelectedFrame-1))
+     if (renderCacheSize == 0)
+     {
+       renderPixelData();
+       if (currentImage->getOutputData(pixelData, size, 8, currentImageSelectedFrame-1))
+         return EC_Normal;
+     } else {
+       unsigned long frameSize = 0;
+       const void *data = getRenderedFrame(frameSize);
+       if ((data != NULL) && (pixelData != NULL) && (size >= frameSize))
+       {
+         memcpy(pixelData, data, frameSize);
          return EC_Normal;
+       }
+     }
    }
    return EC_IllegalCall;
 }
 
+void DVPresentationState::setRenderCacheSize(size_t frames)
+{
+  renderCacheSize = frames;
+  if (renderCache.size() > frames)
+  {
+    /* keep it simple, a shrinking cache is not a common case */
+    clearRenderCache();
+  }
+}
+
+void DVPresentationState::invalidateRenderCache()
+{
+  for (OFVector<RenderCacheEntry>::iterator it = renderCache.begin(); it != renderCache.end(); ++it)
+    (*it).valid = OFFalse;
+}
+
+void DVPresentationState::clearRenderCache()
+{
+  for (OFVector<RenderCacheEntry>::iterator it = renderCache.begin(); it != renderCache.end(); ++it)
+    delete[] (*it).data;
+  renderCache.clear();
+}
+
+const void *DVPresentationState::getRenderedFrame(unsigned long &size)
+{
+  /* update the rendering parameters, invalidates the cached frames if needed */
+  renderPixelData();
+  size = currentImage->getOutputDataSize(8);
+  if (renderCacheSize == 0)
+    return currentImage->getOutputData(8, currentImageSelectedFrame-1);
+
+  /* the number of cached frames is small, so a linear search is sufficient */
+  RenderCacheEntry *entry = NULL;
+  for (OFVector<RenderCacheEntry>::iterator it = renderCache.begin(); it != renderCache.end(); ++it)
+  {
+    if ((*it).valid && ((*it).frame == currentImageSelectedFrame) && ((*it).size == size))
+    {
+      (*it).lastUse = ++renderCacheCounter;
+      return (*it).data;
+    }
+    /* prefer an outdated entry, otherwise use the least recently used one */
+    if ((entry == NULL) || (entry->valid && (!(*it).valid || ((*it).lastUse < entry->lastUse))))
+      entry = &(*it);
+  }
+  if ((entry == NULL) || (entry->valid && (renderCache.size() < renderCacheSize)))
+  {
+    RenderCacheEntry newEntry;
+    newEntry.frame = 0;
+    newEntry.data = NULL;
+    newEntry.size = 0;
+    newEntry.valid = OFFalse;
+    newEntry.lastUse = 0;
+    renderCache.push_back(newEntry);
+    entry = &renderCache.back();
+  }
+  if (entry->size != size)
+  {
+    delete[] entry->data;
+    entry->data = new Uint8[size];
+    entry->size = size;
+  }
+  entry->frame = currentImageSelectedFrame;
+  entry->lastUse = ++renderCacheCounter;
+  entry->valid = (currentImage->getOutputData(entry->data, size, 8, currentImageSelectedFrame-1) != 0);
+  return entry->valid ? entry->data : NULL;
+}
+
 OFCondition DVPresentationState::getImageMinMaxPixelRange(double &minValue, double& maxValue)
 {
   OFCondition result = EC_IllegalCall;
@@ -1891,8 +1991,13 @@ OFCondition DVPresentationState::selectImageFrameNumber(unsigned long frame)
   if ((frame > 0) && currentImage && (frame <= currentImage->getFrameCount()))
   {
     if (currentImageSelectedFrame != frame)
-      currentImageVOIValid = OFFalse; // VOI might has changed
-    currentImageSelectedFrame=frame;
+    {
+      DVPSSoftcopyVOI *voi = getCurrentSoftcopyVOI();
+      currentImageSelectedFrame=frame;
+      // VOI only needs to be set again if a different one applies to this frame
+      if (getCurrentSoftcopyVOI() != voi)
+        currentImageVOIValid = OFFalse; // VOI has changed
+    }
     return EC_Normal;
   }
   return EC_IllegalCall;
@@ -59,6 +59,12 @@ END_EXTERN_C
 #include "dcmtk/ofstd/ofgrp.h"
 #include "dcmtk/ofstd/ofpwd.h"
 #include "dcmtk/dcmtls/tlsopt.h"       /* for DcmTLSOptions */
+#include "dcmtk/dcmdata/dcrledrg.h"    /* for DcmRLEDecoderRegistration */
+#include "dcmtk/dcmdata/dcrleerg.h"    /* for DcmRLEEncoderRegistration */
+#include "dcmtk/dcmjpeg/djdecode.h"    /* for DJDecoderRegistration */
+#include "dcmtk/dcmjpeg/djencode.h"    /* for DJEncoderRegistration */
+#include "dcmtk/dcmjpls/djdecode.h"    /* for DJLSDecoderRegistration */
+#include "dcmtk/dcmjpls/djencode.h"    /* for DJLSEncoderRegistration */
 
 #ifdef WITH_SQL_DATABASE
 #include "dcmtk/dcmqrdbx/dcmqrdbq.h"
@@ -265,6 +271,11 @@ main(int argc, char *argv[])
       opt4 += ")";
       cmd.addOption("--max-pdu",                "-pdu", 1, opt4.c_str(),
                                                            "set max receive pdu to n bytes\n(default: use value from configuration file)");
+      cmd.addOption("--transcoding-queue",      "-tq",  1, "[n]umber: integer (default: 2)",
+                                                           "load and convert n C-STORE sub-operations of\nC-MOVE/C-GET in advance (0 = none)");
+      cmd.addOption("--prefetch-files",         "+pf",     "read complete files of C-STORE sub-operations\nwhile loading them in advance");
+      cmd.addOption("--sub-associations",       "-sa",  1, "[n]umber: integer (1..16, default: 1)",
+                                                           "perform C-STORE sub-operations of C-MOVE\nover n parallel associations");
       cmd.addOption("--disable-host-lookup",    "-dhl",    "disable hostname lookup");
       cmd.addOption("--refuse",                            "refuse association");
       cmd.addOption("--reject",                            "reject association if no implement. class UID");
@@ -503,6 +514,9 @@ main(int argc, char *argv[])
       }
 
       if (cmd.findOption("--max-pdu")) app.checkValue(cmd.getValueAndCheckMinMax(overrideMaxPDU, ASC_MINIMUMPDUSIZE, ASC_MAXIMUMPDUSIZE));
+      if (cmd.findOption("--transcoding-queue")) app.checkValue(cmd.getValueAndCheckMinMax(options.transcodingQueueSize_, 0, 64));
+      if (cmd.findOption("--prefetch-files")) options.prefetchSubOperations_ = OFTrue;
+      if (cmd.findOption("--sub-associations")) app.checkValue(cmd.getValueAndCheckMinMax(options.maxMoveSubAssociations_, 1, 16));
       if (cmd.findOption("--disable-host-lookup")) dcmDisableGethostbyaddr.set(OFTrue);
       if (cmd.findOption("--refuse")) options.refuse_ = OFTrue;
       if (cmd.findOption("--reject")) options.rejectWhenNoImplementationClassUID_ = OFTrue;
@@ -857,6 +871,14 @@ main(int argc, char *argv[])
         << DCM_DICT_ENVIRONMENT_VARIABLE);
     }
 
+    /* register codecs for converting C-STORE sub-operations of C-MOVE/C-GET */
+    DJDecoderRegistration::registerCodecs();
+    DJEncoderRegistration::registerCodecs();
+    DJLSDecoderRegistration::registerCodecs();
+    DJLSEncoderRegistration::registerCodecs();
+    DcmRLEDecoderRegistration::registerCodecs();
+    DcmRLEEncoderRegistration::registerCodecs();
+
 #ifndef DISABLE_PORT_PERMISSION_CHECK
 #ifdef HAVE_GETEUID
     /* if port is privileged we must be as well */
@@ -958,5 +980,13 @@ main(int argc, char *argv[])
 
     OFStandard::shutdownNetwork();
 
+    /* deregister codecs */
+    DJDecoderRegistration::cleanup();
+    DJEncoderRegistration::cleanup();
+    DJLSDecoderRegistration::cleanup();
+    DJLSEncoderRegistration::cleanup();
+    DcmRLEDecoderRegistration::cleanup();
+    DcmRLEEncoderRegistration::cleanup();
+
     return 0;
 }
@@ -29,6 +29,9 @@
 class DcmQueryRetrieveDatabaseHandle;
 class DcmQueryRetrieveOptions;
 class DcmQueryRetrieveDatabaseStatus;
+class DcmQueryRetrieveConfig;
+class DcmQueryRetrieveTranscoder;
+class DcmQueryRetrieveSubOperation;
 
 /** this class maintains the context information that is passed to the
  *  callback function called by DIMSE_getProvider.
@@ -44,6 +47,8 @@ public:
      *  @param origmsgid DIMSE message ID
      *  @param prior DIMSE priority
      *  @param origpresid presentation context ID
+     *  @param cfg configuration for the Q/R service, used for looking up the
+     *    transfer syntaxes preferred by the requestor. May be NULL.
      */
     DcmQueryRetrieveGetContext(DcmQueryRetrieveDatabaseHandle& handle,
       const DcmQueryRetrieveOptions& options,
@@ -51,9 +56,11 @@ public:
       T_ASC_Association *origassoc,
       DIC_US origmsgid,
       T_DIMSE_Priority prior,
-      T_ASC_PresentationContextID origpresid)
+      T_ASC_PresentationContextID origpresid,
+      const DcmQueryRetrieveConfig *cfg = NULL)
     : dbHandle(handle)
     , options_(options)
+    , config(cfg)
     , priorStatus(priorstatus)
     , origAssoc(origassoc)
     , assocStarted(OFFalse)
@@ -69,10 +76,15 @@ public:
     , nFailed(0)
     , nWarning(0)
     , getCancelled(OFFalse)
+    , transcoder(NULL)
+    , dbFinished(OFFalse)
     {
       origHostName[0] = '\0';
     }
 
+    /// destructor
+    ~DcmQueryRetrieveGetContext();
+
     /** set the AEtitle under which this application operates
      *  @param ae AEtitle, is copied into this object.
      */
@@ -107,7 +119,7 @@ private:
     DcmQueryRetrieveGetContext& operator=(const DcmQueryRetrieveGetContext& other);
 
     void addFailedUIDInstance(const char *sopInstance);
-    OFCondition performGetSubOp(DIC_UI sopClass, DIC_UI sopInstance, char *fname);
+    OFCondition performGetSubOp(DcmQueryRetrieveSubOperation& subOp);
     void getNextImage(DcmQueryRetrieveDatabaseStatus * dbStatus);
     void buildFailedInstanceList(DcmDataset ** rspIds);
 
@@ -117,6 +129,9 @@ private:
     /// reference to Q/R service options
     const DcmQueryRetrieveOptions& options_;
 
+    /// pointer to Q/R configuration, may be NULL
+    const DcmQueryRetrieveConfig *config;
+
     /// prior DIMSE status
     DIC_US  priorStatus;
 
@@ -163,6 +178,12 @@ private:
     /// true if the get sub-operations have been cancelled
     OFBool getCancelled;
 
+    /// prepares the sub-operations for the association, NULL if none
+    DcmQueryRetrieveTranscoder *transcoder;
+
+    /// true if the database has returned the last sub-operation
+    OFBool dbFinished;
+
 };
 
 #endif
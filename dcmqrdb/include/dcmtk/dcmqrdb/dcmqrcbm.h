@@ -26,11 +26,19 @@
 #include "dcmtk/dcmnet/dimse.h"
 #include "dcmtk/dcmnet/dcasccfg.h"
 #include "dcmtk/dcmqrdb/qrdefine.h"
+#include "dcmtk/ofstd/oflist.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"
+#endif
 
 class DcmQueryRetrieveDatabaseHandle;
 class DcmQueryRetrieveOptions;
 class DcmQueryRetrieveConfig;
 class DcmQueryRetrieveDatabaseStatus;
+class DcmQueryRetrieveTranscoder;
+class DcmQueryRetrieveSubOperation;
+class DcmQueryRetrieveMoveSubAssociation;
 
 /** this class maintains the context information that is passed to the
  *  callback function called by DIMSE_moveProvider.
@@ -75,12 +83,27 @@ public:
     , nCompleted(0)
     , nFailed(0)
     , nWarning(0)
+    , transcoder(NULL)
+    , dbFinished(OFFalse)
+#ifdef WITH_THREADS
+    , parallelSubAssocs()
+    , dispatchQueue()
+    , dispatchCount(0)
+    , completedCount(0)
+    , mutex()
+    , nOutstanding(0)
+    , dispatchFinished(OFFalse)
+    , stopRequested(OFFalse)
+#endif
     {
       origAETitle[0] = '\0';
       origHostName[0] = '\0';
       dstAETitle[0] = '\0';
     }
 
+    /// destructor
+    ~DcmQueryRetrieveMoveContext();
+
     /** callback handler called by the DIMSE_storeProvider callback function.
      *  @param cancelled (in) flag indicating whether a C-CANCEL was received
      *  @param request original move request (in)
@@ -114,9 +137,18 @@ private:
     /// private undefined assignment operator
     DcmQueryRetrieveMoveContext& operator=(const DcmQueryRetrieveMoveContext& other);
 
+    friend class DcmQueryRetrieveMoveSubAssociation;
+
     void addFailedUIDInstance(const char *sopInstance);
-    OFCondition performMoveSubOp(DIC_UI sopClass, DIC_UI sopInstance, char *fname);
+    void countSubOperation(const char *sopInstance, OFBool failed, OFBool warning);
+    OFCondition performMoveSubOp(T_ASC_Association *assoc, DcmQueryRetrieveSubOperation& subOp);
     OFCondition buildSubAssociation(T_DIMSE_C_MoveRQ *request);
+    OFCondition requestSubAssociation(const char *dstHostNamePlusPort, T_ASC_Association **assoc);
+    void releaseSubAssociation(T_ASC_Association **assoc);
+#ifdef WITH_THREADS
+    void moveNextImagesParallel(DcmQueryRetrieveDatabaseStatus * dbStatus);
+    void stopParallelSubAssociations(OFList<OFString>& sopInstances);
+#endif
     OFCondition closeSubAssociation();
     void moveNextImage(DcmQueryRetrieveDatabaseStatus * dbStatus);
     void failAllSubOperations(DcmQueryRetrieveDatabaseStatus * dbStatus);
@@ -183,6 +215,40 @@ private:
     /// number of completed sub-operations that causes warnings
     DIC_US nWarning;
 
+    /// prepares the sub-operations for the sub-association, NULL if none
+    DcmQueryRetrieveTranscoder *transcoder;
+
+    /// true if the database has returned the last sub-operation
+    OFBool dbFinished;
+
+#ifdef WITH_THREADS
+    /** sub-associations (including subAssoc) served by a thread each, if
+     *  more than one sub-association is used. Empty otherwise.
+     */
+    OFList<DcmQueryRetrieveMoveSubAssociation *> parallelSubAssocs;
+
+    /// sub-operations returned by the database, not yet taken by a thread
+    OFList<DcmQueryRetrieveSubOperation *> dispatchQueue;
+
+    /// counts the entries of the dispatch queue (plus one per thread at the end)
+    OFSemaphore dispatchCount;
+
+    /// counts the sub-operations performed by the threads
+    OFSemaphore completedCount;
+
+    /// mutex protecting the dispatch queue, the flags and the sub-operation counters
+    OFMutex mutex;
+
+    /// number of sub-operations dispatched to the threads but not yet reported
+    size_t nOutstanding;
+
+    /// true if all sub-operations have been dispatched to the threads
+    OFBool dispatchFinished;
+
+    /// true if the threads should stop as soon as possible
+    OFBool stopRequested;
+#endif
+
 };
 
 #endif
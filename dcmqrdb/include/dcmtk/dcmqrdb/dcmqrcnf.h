@@ -26,6 +26,8 @@
 
 
 #include "dcmtk/ofstd/ofcmdln.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofstring.h"
 #include "dcmtk/oflog/oflog.h"
 #include "dcmtk/dcmqrdb/qrdefine.h"
 
@@ -191,6 +193,18 @@ struct DCMTK_DCMQRDB_EXPORT DcmQueryRetrieveConfigHostTable
     DcmQueryRetrieveConfigHostEntry   *HostEntries;
 };
 
+/** this class describes the transfer syntaxes preferred for C-STORE
+ *  sub-operations sent to a remote peer or a group of remote peers
+ */
+struct DCMTK_DCMQRDB_EXPORT DcmQueryRetrieveConfigTransferSyntaxEntry
+{
+    /// remote peer AE title or symbolic name defined in the host table
+    OFString Name;
+
+    /// transfer syntax UIDs in order of preference
+    OFList<OFString> TransferSyntaxes;
+};
+
 /** this class describes configuration settings for a Query/Retrieve SCP Service
  */
 class DCMTK_DCMQRDB_EXPORT DcmQueryRetrieveConfig
@@ -207,6 +221,7 @@ public:
   , CNF_Config()
   , CNF_HETable()
   , CNF_VendorTable()
+  , CNF_TransferSyntaxTable()
   {
   }
 
@@ -240,6 +255,16 @@ public:
    */
   int checkForSameVendor(const char *AETitle1, const char *AETitle2) const;
 
+  /*
+   *  get the transfer syntaxes preferred for C-STORE sub-operations
+   *  sent to a peer, either configured for the AETitle itself or for
+   *  a symbolic name in the host table that includes the AETitle
+   *  Input : AETitle
+   *  Output : list of transfer syntax UIDs in order of preference
+   *  Return : number of transfer syntaxes, 0 if none configured
+   */
+  size_t transferSyntaxesForPeer(const char *AETitle, OFList<OFString>& transferSyntaxes) const;
+
   /*
    *  get Storage Area for AETitle
    *  Input : AETitle
@@ -446,6 +471,15 @@ private:
    */
   int readAETable(FILE *cnffp, int *lineno);
 
+  /*
+   *  read TransferSyntaxTable in configuration file
+   *  Input : configuration file pointer, line number
+   *  Output : line number
+   *  Return : 1 - ok
+   *     0 - error
+   */
+  int readTransferSyntaxTable(FILE *cnffp, int *lineno);
+
   /*
    *  separate the peer list from value list
    *  Input : pointer to value list
@@ -523,6 +557,7 @@ private:
   DcmQueryRetrieveConfigConfiguration CNF_Config;   /* configuration file contents */
   DcmQueryRetrieveConfigHostTable CNF_HETable;      /* HostEntries Table */
   DcmQueryRetrieveConfigHostTable CNF_VendorTable;  /* Vendor Table */
+  OFList<DcmQueryRetrieveConfigTransferSyntaxEntry> CNF_TransferSyntaxTable; /* Transfer Syntax Table */
 
 };
 
@@ -87,12 +87,22 @@ public:
   /// maximum PDU size
   OFCmdUnsignedInt  maxPDU_;
 
+  /** maximum number of sub-associations opened in parallel to the move
+   *  destination of a C-MOVE operation (requires thread support)
+   */
+  OFCmdUnsignedInt  maxMoveSubAssociations_;
+
   /// pointer to network structure used for requesting C-STORE sub-associations
   T_ASC_Network *   net_;
 
   /// preferred transfer syntax for incoming associations
   E_TransferSyntax  networkTransferSyntax_;
 
+  /** read C-MOVE/C-GET sub-operations completely into memory in advance,
+   *  i.e. while the previous sub-operations are sent (see transcodingQueueSize_)
+   */
+  OFBool            prefetchSubOperations_;
+
 #ifndef DISABLE_COMPRESSION_EXTENSION
   /// preferred transfer syntax for outgoing associations
   E_TransferSyntax  networkTransferSyntaxOut_;
@@ -139,6 +149,12 @@ public:
   /// support for study root q/r model
   OFBool            supportStudyRoot_;
 
+  /** number of C-STORE sub-operations loaded and converted in advance
+   *  (in a background thread) while C-MOVE/C-GET sub-operations are sent,
+   *  0 for none
+   */
+  OFCmdUnsignedInt  transcodingQueueSize_;
+
   /// write DICOM files with DICOM metaheader
   OFBool            useMetaheader_;
 
@@ -0,0 +1,246 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: class DcmQueryRetrieveTranscoder
+ *
+ */
+
+#ifndef DCMQRTCD_H
+#define DCMQRTCD_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofstring.h"
+#include "dcmtk/ofstd/ofcond.h"
+#include "dcmtk/dcmnet/assoc.h"
+#include "dcmtk/dcmdata/dcxfer.h"
+#include "dcmtk/dcmqrdb/qrdefine.h"
+
+#ifdef WITH_THREADS
+#include "dcmtk/ofstd/ofthread.h"
+#endif
+
+class DcmFileFormat;
+class DcmQueryRetrieveTranscoderThread;
+
+/** this class describes a single C-STORE sub-operation of a C-MOVE or C-GET
+ *  operation, as prepared by class DcmQueryRetrieveTranscoder
+ */
+class DCMTK_DCMQRDB_EXPORT DcmQueryRetrieveSubOperation
+{
+public:
+    /** constructor
+     *  @param sopClass SOP class UID of the instance to be sent
+     *  @param sopInstance SOP instance UID of the instance to be sent
+     *  @param filename name of the file containing the instance
+     */
+    DcmQueryRetrieveSubOperation(const char *sopClass, const char *sopInstance, const char *filename);
+
+    /// destructor, releases the file lock and the loaded object (if any)
+    ~DcmQueryRetrieveSubOperation();
+
+    /// SOP class UID of the instance to be sent
+    OFString sopClass;
+
+    /// SOP instance UID of the instance to be sent
+    OFString sopInstance;
+
+    /// name of the file containing the instance
+    OFString filename;
+
+    /// presentation context selected for sending the instance, 0 if none
+    T_ASC_PresentationContextID presId;
+
+    /// transfer syntax of the file
+    E_TransferSyntax fileXfer;
+
+    /// transfer syntax of the selected presentation context
+    E_TransferSyntax networkXfer;
+
+    /** the loaded and, if required, transcoded instance. Unless requested
+     *  otherwise, large element values that did not need to be transcoded
+     *  are not loaded into memory but read from file when the instance is sent.
+     */
+    DcmFileFormat *fileformat;
+
+    /// result of preparing the sub-operation, the instance can only be sent if good
+    OFCondition status;
+
+#ifdef LOCK_IMAGE_FILES
+    /// file descriptor for the shared lock of the file, -1 if not locked
+    int lockfd;
+#endif
+
+private:
+
+    /// private undefined copy constructor
+    DcmQueryRetrieveSubOperation(const DcmQueryRetrieveSubOperation& other);
+
+    /// private undefined assignment operator
+    DcmQueryRetrieveSubOperation& operator=(const DcmQueryRetrieveSubOperation& other);
+};
+
+
+/** this class prepares the C-STORE sub-operations of a C-MOVE or C-GET
+ *  operation for sending over a given association. For each instance, it
+ *  loads the file, selects the accepted presentation context that best
+ *  matches the transfer syntax preferences of the peer and, if the file is
+ *  not stored in a transfer syntax that can be sent over this context,
+ *  converts the pixel data using the codecs registered with DcmCodecList.
+ *  If the toolkit is compiled with thread support and a queue size greater
+ *  than zero is given, sub-operations are prepared in a background thread
+ *  while the caller sends previously prepared instances, and up to the given
+ *  number of sub-operations are prepared in advance. Otherwise, each
+ *  sub-operation is prepared when it is requested. The order of the
+ *  sub-operations is always maintained.
+ *  Transcoding into a lossy transfer syntax is never performed, since this
+ *  would require a new SOP instance UID. Lossy transfer syntaxes are only
+ *  used for instances that are already stored in this transfer syntax.
+ */
+class DCMTK_DCMQRDB_EXPORT DcmQueryRetrieveTranscoder
+{
+public:
+    /** constructor
+     *  @param assoc association over which the instances will be sent. The
+     *    accepted presentation contexts are copied, i.e. the association is
+     *    not accessed by any other method of this class.
+     *  @param preferredTransferSyntaxes transfer syntax UIDs preferred by the
+     *    peer, in order of preference. May be empty.
+     *  @param queueSize maximum number of sub-operations prepared in advance
+     *    in a background thread, 0 for none
+     *  @param requireSCPRole if true, only presentation contexts for which the
+     *    association requestor has accepted the SCP role are used (C-GET)
+     *  @param loadAllData if true, all element values are read from file when
+     *    a sub-operation is prepared (i.e. in the background thread, if any),
+     *    so that sending the instance does not have to wait for the disk.
+     *    Otherwise, large element values are read while sending.
+     */
+    DcmQueryRetrieveTranscoder(
+      T_ASC_Association *assoc,
+      const OFList<OFString>& preferredTransferSyntaxes,
+      size_t queueSize,
+      OFBool requireSCPRole = OFFalse,
+      OFBool loadAllData = OFFalse);
+
+    /// destructor, stops the background thread and discards pending sub-operations
+    ~DcmQueryRetrieveTranscoder();
+
+    /** add a sub-operation to the end of the queue
+     *  @param sopClass SOP class UID of the instance to be sent
+     *  @param sopInstance SOP instance UID of the instance to be sent
+     *  @param filename name of the file containing the instance
+     */
+    void addSubOperation(const char *sopClass, const char *sopInstance, const char *filename);
+
+    /** remove the first sub-operation from the queue, waiting until it has
+     *  been prepared if necessary
+     *  @return prepared sub-operation, to be deleted by the caller.
+     *    NULL if the queue is empty.
+     */
+    DcmQueryRetrieveSubOperation *nextSubOperation();
+
+    /** get the number of sub-operations in the queue
+     *  @return number of sub-operations added but not yet removed
+     */
+    size_t numberOfPendingSubOperations() const
+    {
+      return pending_;
+    }
+
+    /** check whether further sub-operations should be added to the queue,
+     *  i.e. whether the number of pending sub-operations is below the queue
+     *  size (or the queue is empty if no background thread is used)
+     *  @return OFTrue if further sub-operations should be added
+     */
+    OFBool wantsSubOperations() const
+    {
+      return pending_ < ((queueSize_ > 0) ? queueSize_ : 1);
+    }
+
+    /** remove all sub-operations from the queue
+     *  @param sopInstances SOP instance UIDs of the removed sub-operations
+     *    are appended to this list
+     */
+    void clear(OFList<OFString>& sopInstances);
+
+private:
+
+    friend class DcmQueryRetrieveTranscoderThread;
+
+    /// private undefined copy constructor
+    DcmQueryRetrieveTranscoder(const DcmQueryRetrieveTranscoder& other);
+
+    /// private undefined assignment operator
+    DcmQueryRetrieveTranscoder& operator=(const DcmQueryRetrieveTranscoder& other);
+
+    /** an accepted presentation context of the association
+     */
+    struct PresentationContext
+    {
+      /// presentation context ID
+      T_ASC_PresentationContextID presId;
+      /// abstract syntax (SOP class UID)
+      OFString abstractSyntax;
+      /// accepted transfer syntax
+      E_TransferSyntax xfer;
+      /// rank of the transfer syntax, lower is better
+      size_t rank;
+    };
+
+    /** prepare a sub-operation, i.e. load the file, select the presentation
+     *  context and transcode the pixel data if required
+     *  @param subOp sub-operation to be prepared
+     */
+    void prepare(DcmQueryRetrieveSubOperation& subOp) const;
+
+    /// accepted presentation contexts, sorted by rank of the transfer syntax
+    OFList<PresentationContext> contexts_;
+
+    /// maximum number of sub-operations prepared in advance
+    size_t queueSize_;
+
+    /// if true, all element values are loaded when preparing a sub-operation
+    OFBool loadAllData_;
+
+    /// number of sub-operations added but not yet removed
+    size_t pending_;
+
+    /// sub-operations not yet prepared
+    OFList<DcmQueryRetrieveSubOperation *> waiting_;
+
+#ifdef WITH_THREADS
+    /// sub-operations prepared by the background thread
+    OFList<DcmQueryRetrieveSubOperation *> prepared_;
+
+    /// background thread, NULL if none
+    DcmQueryRetrieveTranscoderThread *thread_;
+
+    /// counts the sub-operations not yet prepared (plus one if stopping)
+    OFSemaphore waitingCount_;
+
+    /// counts the sub-operations prepared by the background thread
+    OFSemaphore preparedCount_;
+
+    /// mutex protecting the lists of sub-operations and the stop flag
+    OFMutex mutex_;
+
+    /// set by the destructor to request the background thread to stop
+    OFBool stop_;
+#endif
+};
+
+#endif
@@ -30,14 +30,9 @@
 #include "dcmtk/dcmdata/dcfilefo.h"
 #include "dcmtk/dcmqrdb/dcmqrdbs.h"
 #include "dcmtk/dcmqrdb/dcmqrdbi.h"
+#include "dcmtk/dcmqrdb/dcmqrtcd.h"
 #include "dcmtk/ofstd/ofstd.h"
 
-BEGIN_EXTERN_C
-#ifdef HAVE_FCNTL_H
-#include <fcntl.h>       /* needed on Solaris for O_RDONLY */
-#endif
-END_EXTERN_C
-
 static void getSubOpProgressCallback(void * /* callbackData */,
     T_DIMSE_StoreProgress *progress,
     T_DIMSE_C_StoreRQ * /*req*/)
@@ -66,6 +61,11 @@ static void getSubOpProgressCallback(void * /* callbackData */,
   }
 }
 
+DcmQueryRetrieveGetContext::~DcmQueryRetrieveGetContext()
+{
+    delete transcoder;
+}
+
 void DcmQueryRetrieveGetContext::callbackHandler(
     /* in */
     OFBool cancelled, T_DIMSE_C_GetRQ *request,
@@ -88,11 +88,27 @@ void DcmQueryRetrieveGetContext::callbackHandler(
                 << DU_cmoveStatusString(dbStatus.status()) << "): "
                 << DimseCondition::dump(temp_str, dbcond));
         }
+
+        if (dbStatus.status() == STATUS_Pending) {
+            /* the requestor acts as storage SCP on the same association */
+            DIC_AE aeTitle;
+            aeTitle[0] = '\0';
+            ASC_getAPTitles(origAssoc->params, aeTitle, sizeof(aeTitle), NULL, 0, NULL, 0);
+            origAETitle = aeTitle;
+            OFList<OFString> transferSyntaxes;
+            if (config != NULL)
+                config->transferSyntaxesForPeer(origAETitle.c_str(), transferSyntaxes);
+            transcoder = new DcmQueryRetrieveTranscoder(origAssoc, transferSyntaxes, options_.transcodingQueueSize_, OFTrue /* requireSCPRole */, options_.prefetchSubOperations_);
+        }
     }
 
     /* only cancel if we have pending status */
     if (cancelled && dbStatus.status() == STATUS_Pending) {
-        dbHandle.cancelMoveRequest(&dbStatus);
+        if (dbFinished) {
+            dbStatus.setStatus(STATUS_GET_Cancel_SubOperationsTerminatedDueToCancelIndication);
+        } else {
+            dbHandle.cancelMoveRequest(&dbStatus);
+        }
     }
 
     if (dbStatus.status() == STATUS_Pending) {
@@ -101,6 +117,15 @@ void DcmQueryRetrieveGetContext::callbackHandler(
 
     if (dbStatus.status() != STATUS_Pending) {
 
+        if (transcoder != NULL) {
+            /* sub-operations already prepared are not performed anymore */
+            OFList<OFString> sopInstances;
+            transcoder->clear(sopInstances);
+            nRemaining = OFstatic_cast(DIC_US, nRemaining + sopInstances.size());
+            delete transcoder;
+            transcoder = NULL;
+        }
+
         /*
          * Need to adjust the final status if any sub-operations failed or
          * had warnings
@@ -133,6 +158,10 @@ void DcmQueryRetrieveGetContext::callbackHandler(
     /* set response status */
     response->DimseStatus = dbStatus.status();
     response->NumberOfRemainingSubOperations = nRemaining;
+    if (transcoder != NULL) {
+        /* sub-operations returned by the database but not yet performed */
+        response->NumberOfRemainingSubOperations = OFstatic_cast(DIC_US, nRemaining + transcoder->numberOfPendingSubOperations());
+    }
     response->NumberOfCompletedSubOperations = nCompleted;
     response->NumberOfFailedSubOperations = nFailed;
     response->NumberOfWarningSubOperations = nWarning;
@@ -163,59 +192,32 @@ void DcmQueryRetrieveGetContext::addFailedUIDInstance(const char *sopInstance)
     }
 }
 
-OFCondition DcmQueryRetrieveGetContext::performGetSubOp(DIC_UI sopClass, DIC_UI sopInstance, char *fname)
+OFCondition DcmQueryRetrieveGetContext::performGetSubOp(DcmQueryRetrieveSubOperation& subOp)
 {
     OFCondition cond = EC_Normal;
     T_DIMSE_C_StoreRQ req;
     T_DIMSE_C_StoreRSP rsp;
     DIC_US msgId;
-    T_ASC_PresentationContextID presId;
     DcmDataset *stDetail = NULL;
+    const char *sopClass = subOp.sopClass.c_str();
+    const char *sopInstance = subOp.sopInstance.c_str();
 
-#ifdef LOCK_IMAGE_FILES
-    /* shared lock image file */
-    int lockfd;
-#ifdef O_BINARY
-    lockfd = open(fname, O_RDONLY | O_BINARY, 0666);
-#else
-    lockfd = open(fname, O_RDONLY , 0666);
-#endif
-    if (lockfd < 0) {
-        /* due to quota system the file could have been deleted */
-        DCMQRDB_ERROR("Get SCP: storeSCU: [file: " << fname << "]: " << OFStandard::getLastSystemErrorCode().message());
+    if (subOp.status.bad()) {
         nFailed++;
         addFailedUIDInstance(sopInstance);
-        return EC_Normal;
-    }
-    dcmtk_flock(lockfd, LOCK_SH);
-#endif
-
-    msgId = origAssoc->nextMsgID++;
-
-    /* which presentation context should be used */
-    presId = ASC_findAcceptedPresentationContextID(origAssoc,
-        sopClass);
-    if (presId == 0) {
-        nFailed++;
-        addFailedUIDInstance(sopInstance);
-        DCMQRDB_ERROR("Get SCP: storeSCU: [file: " << fname << "] No presentation context for: ("
-            << dcmSOPClassUIDToModality(sopClass, "OT") << ") " << sopClass);
-        return DIMSE_NOVALIDPRESENTATIONCONTEXTID;
-    } else {
-        /* make sure that we can send images in this presentation context */
-        T_ASC_PresentationContext pc;
-        ASC_findAcceptedPresentationContext(origAssoc->params, presId, &pc);
-        /* the acceptedRole is the association requestor role */
-        if ((pc.acceptedRole != ASC_SC_ROLE_SCP) && (pc.acceptedRole != ASC_SC_ROLE_SCUSCP)) {
-            /* the role is not appropriate */
-            nFailed++;
-            addFailedUIDInstance(sopInstance);
-            DCMQRDB_ERROR("Get SCP: storeSCU: [file: " << fname << "] No presentation context with requestor SCP role for: ("
+        if (subOp.status == DIMSE_NOVALIDPRESENTATIONCONTEXTID) {
+            /* the transcoder only uses contexts for which the requestor has accepted the SCP role */
+            DCMQRDB_ERROR("Get SCP: storeSCU: [file: " << subOp.filename << "] No presentation context with requestor SCP role for: ("
                 << dcmSOPClassUIDToModality(sopClass, "OT") << ") " << sopClass);
-            return DIMSE_NOVALIDPRESENTATIONCONTEXTID;
+        } else {
+            /* due to quota system the file could have been deleted */
+            DCMQRDB_ERROR("Get SCP: storeSCU: [file: " << subOp.filename << "]: " << subOp.status.text());
         }
+        return subOp.status;
     }
 
+    msgId = origAssoc->nextMsgID++;
+
     req.MessageID = msgId;
     OFStandard::strlcpy(req.AffectedSOPClassUID, sopClass, DIC_UI_LEN + 1);
     OFStandard::strlcpy(req.AffectedSOPInstanceUID, sopInstance, DIC_UI_LEN + 1);
@@ -228,16 +230,11 @@ OFCondition DcmQueryRetrieveGetContext::performGetSubOp(DIC_UI sopClass, DIC_UI
 
     T_DIMSE_DetectedCancelParameters cancelParameters;
 
-    cond = DIMSE_storeUser(origAssoc, presId, &req,
-        fname, NULL, getSubOpProgressCallback, this, options_.blockMode_, options_.dimse_timeout_,
+    /* the file has already been loaded (and converted if needed) by the transcoder */
+    cond = DIMSE_storeUser(origAssoc, subOp.presId, &req,
+        NULL, subOp.fileformat->getDataset(), getSubOpProgressCallback, this, options_.blockMode_, options_.dimse_timeout_,
         &rsp, &stDetail, &cancelParameters);
 
-#ifdef LOCK_IMAGE_FILES
-    /* unlock image file */
-    dcmtk_flock(lockfd, LOCK_UN);
-    close(lockfd);
-#endif
-
     if (cond.good()) {
         if (cancelParameters.cancelEncountered) {
             if (origPresId == cancelParameters.presId &&
@@ -286,27 +283,54 @@ void DcmQueryRetrieveGetContext::getNextImage(DcmQueryRetrieveDatabaseStatus * d
     DIC_UI subImgSOPInstance;   /* sub-operation image SOP Instance */
     char subImgFileName[MAXPATHLEN + 1];    /* sub-operation image file */
 
-    /* clear out strings */
-    memset(subImgFileName, 0, sizeof(subImgFileName));
-    memset(subImgSOPClass, 0, sizeof(subImgSOPClass));
-    memset(subImgSOPInstance, 0, sizeof(subImgSOPInstance));
-
-    /* get DB response */
-    dbcond = dbHandle.nextMoveResponse(
-        subImgSOPClass, sizeof(subImgSOPClass), subImgSOPInstance, sizeof(subImgSOPInstance), subImgFileName, sizeof(subImgFileName), &nRemaining, dbStatus);
-    if (dbcond.bad()) {
-        DCMQRDB_ERROR("getSCP: Database: nextMoveResponse Failed ("
-            << DU_cmoveStatusString(dbStatus->status()) << "):");
+    /* get DB responses until enough sub-operations are being prepared */
+    while (!dbFinished && transcoder->wantsSubOperations()) {
+        /* clear out strings */
+        memset(subImgFileName, 0, sizeof(subImgFileName));
+        memset(subImgSOPClass, 0, sizeof(subImgSOPClass));
+        memset(subImgSOPInstance, 0, sizeof(subImgSOPInstance));
+
+        /* get DB response */
+        dbcond = dbHandle.nextMoveResponse(
+            subImgSOPClass, sizeof(subImgSOPClass), subImgSOPInstance, sizeof(subImgSOPInstance), subImgFileName, sizeof(subImgFileName), &nRemaining, dbStatus);
+        if (dbcond.bad()) {
+            DCMQRDB_ERROR("getSCP: Database: nextMoveResponse Failed ("
+                << DU_cmoveStatusString(dbStatus->status()) << "):");
+        }
+
+        if (dbStatus->status() == STATUS_Pending) {
+            transcoder->addSubOperation(subImgSOPClass, subImgSOPInstance, subImgFileName);
+        } else {
+            dbFinished = OFTrue;
+            if (dbStatus->status() != STATUS_Success) {
+                /* the sub-operations already returned by the database are not performed */
+                OFList<OFString> sopInstances;
+                transcoder->clear(sopInstances);
+                for (OFListIterator(OFString) it = sopInstances.begin(); it != sopInstances.end(); ++it) {
+                    nFailed++;
+                    addFailedUIDInstance((*it).c_str());
+                }
+                return;
+            }
+        }
     }
 
-    if (dbStatus->status() == STATUS_Pending) {
-        /* perform sub-op */
-        cond = performGetSubOp(subImgSOPClass, subImgSOPInstance, subImgFileName);
+    /* perform sub-op */
+    DcmQueryRetrieveSubOperation *subOp = transcoder->nextSubOperation();
+    if (subOp != NULL) {
+        cond = performGetSubOp(*subOp);
+        delete subOp;
 
         if (getCancelled) {
+            if (!dbFinished) {
+                /* release the database */
+                dbHandle.cancelMoveRequest(dbStatus);
+                dbFinished = OFTrue;
+            }
             dbStatus->setStatus(STATUS_GET_Cancel_SubOperationsTerminatedDueToCancelIndication);
             DCMQRDB_INFO("Get SCP: Received C-Cancel RQ");
-       }
+            return;
+        }
 
         if (cond != EC_Normal) {
             OFString temp_str;
@@ -314,6 +338,11 @@ void DcmQueryRetrieveGetContext::getNextImage(DcmQueryRetrieveDatabaseStatus * d
             /* clear condition stack */
         }
     }
+
+    /* the get is complete when the database and the queue are exhausted */
+    if (dbFinished) {
+        dbStatus->setStatus((transcoder->numberOfPendingSubOperations() > 0) ? STATUS_Pending : STATUS_Success);
+    }
 }
 
 void DcmQueryRetrieveGetContext::buildFailedInstanceList(DcmDataset ** rspIds)
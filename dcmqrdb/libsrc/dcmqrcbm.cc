@@ -31,13 +31,10 @@
 #include "dcmtk/dcmdata/dcfilefo.h"
 #include "dcmtk/dcmqrdb/dcmqrdbs.h"
 #include "dcmtk/dcmqrdb/dcmqrdbi.h"
+#include "dcmtk/dcmqrdb/dcmqrtcd.h"
 #include "dcmtk/ofstd/ofstd.h"
-
-BEGIN_EXTERN_C
-#ifdef HAVE_FCNTL_H
-#include <fcntl.h>       /* needed on Solaris for O_RDONLY */
-#endif
-END_EXTERN_C
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofalgo.h"
 
 
 static void moveSubOpProgressCallback(void * /* callbackData */,
@@ -68,6 +65,130 @@ static void moveSubOpProgressCallback(void * /* callbackData */,
   }
 }
 
+DcmQueryRetrieveMoveContext::~DcmQueryRetrieveMoveContext()
+{
+    closeSubAssociation();
+}
+
+#ifdef WITH_THREADS
+
+/** thread performing C-STORE sub-operations of a C-MOVE operation over one
+ *  of several parallel sub-associations. The sub-operations are taken from
+ *  the dispatch queue of the move context, prepared by a transcoder of its
+ *  own (which loads and converts the next instances while the current one
+ *  is sent) and sent over the sub-association of this thread.
+ */
+class DcmQueryRetrieveMoveSubAssociation: public OFThread
+{
+public:
+    /** constructor
+     *  @param context move context served by this thread
+     *  @param assoc sub-association, released by the move context
+     *  @param transferSyntaxes transfer syntaxes preferred by the move destination
+     */
+    DcmQueryRetrieveMoveSubAssociation(
+      DcmQueryRetrieveMoveContext& context,
+      T_ASC_Association *assoc,
+      const OFList<OFString>& transferSyntaxes)
+    : OFThread()
+    , assoc_(assoc)
+    , context_(context)
+    , transcoder_(assoc, transferSyntaxes, context.options_.transcodingQueueSize_, OFFalse, context.options_.prefetchSubOperations_)
+    , unsent_()
+    {
+    }
+
+    /// sub-association of this thread
+    T_ASC_Association *assoc_;
+
+    /** get the SOP instance UIDs of the sub-operations not performed after
+     *  the thread has been stopped
+     *  @param sopInstances list to which the UIDs are appended
+     */
+    void getUnsentSubOperations(OFList<OFString>& sopInstances)
+    {
+        transcoder_.clear(sopInstances);
+        sopInstances.splice(sopInstances.end(), unsent_);
+    }
+
+protected:
+
+    /// perform sub-operations until all have been dispatched or the context requests to stop
+    virtual void run()
+    {
+        DcmQueryRetrieveSubOperation *subOp;
+        OFBool finished = OFFalse;
+        OFBool stop = OFFalse;
+        while (!stop)
+        {
+            /* take sub-operations from the dispatch queue as long as the transcoder wants more,
+             * but only wait for them if there is nothing else to do
+             */
+            while (!finished && transcoder_.wantsSubOperations())
+            {
+                if (transcoder_.numberOfPendingSubOperations() == 0)
+                    context_.dispatchCount.wait();
+                else if (context_.dispatchCount.trywait() != 0)
+                    break;
+                context_.mutex.lock();
+                if (context_.stopRequested)
+                {
+                    context_.mutex.unlock();
+                    return;
+                }
+                if (context_.dispatchQueue.empty())
+                {
+                    /* end of the dispatch queue, leave the token for the other threads */
+                    finished = context_.dispatchFinished;
+                    context_.mutex.unlock();
+                    context_.dispatchCount.post();
+                    break;
+                }
+                subOp = context_.dispatchQueue.front();
+                context_.dispatchQueue.pop_front();
+                context_.mutex.unlock();
+                transcoder_.addSubOperation(subOp->sopClass.c_str(), subOp->sopInstance.c_str(), subOp->filename.c_str());
+                delete subOp;
+            }
+
+            subOp = transcoder_.nextSubOperation();
+            if (subOp == NULL)
+            {
+                if (finished) break;
+                continue;
+            }
+            context_.mutex.lock();
+            stop = context_.stopRequested;
+            context_.mutex.unlock();
+            if (stop)
+                unsent_.push_back(subOp->sopInstance);
+            else
+            {
+                OFCondition cond = context_.performMoveSubOp(assoc_, *subOp);
+                if (cond != EC_Normal) {
+                    OFString temp_str;
+                    DCMQRDB_ERROR("moveSCP: Move Sub-Op Failed: " << DimseCondition::dump(temp_str, cond));
+                }
+                context_.completedCount.post();
+            }
+            delete subOp;
+        }
+    }
+
+private:
+
+    /// move context served by this thread
+    DcmQueryRetrieveMoveContext& context_;
+
+    /// prepares the sub-operations for the sub-association of this thread
+    DcmQueryRetrieveTranscoder transcoder_;
+
+    /// SOP instance UIDs of sub-operations prepared but not sent after a stop request
+    OFList<OFString> unsent_;
+};
+
+#endif
+
 void DcmQueryRetrieveMoveContext::callbackHandler(
     /* in */
     OFBool cancelled, T_DIMSE_C_MoveRQ *request,
@@ -106,7 +227,20 @@ void DcmQueryRetrieveMoveContext::callbackHandler(
 
     /* only cancel if we have pending status */
     if (cancelled && dbStatus.status() == STATUS_Pending) {
-        dbHandle.cancelMoveRequest(&dbStatus);
+        if (dbFinished) {
+            dbStatus.setStatus(STATUS_MOVE_Cancel_SubOperationsTerminatedDueToCancelIndication);
+        } else {
+            dbHandle.cancelMoveRequest(&dbStatus);
+        }
+        /* sub-operations already prepared are not performed anymore */
+        OFList<OFString> sopInstances;
+        if (transcoder != NULL) {
+            transcoder->clear(sopInstances);
+        }
+#ifdef WITH_THREADS
+        stopParallelSubAssociations(sopInstances);
+#endif
+        nRemaining = OFstatic_cast(DIC_US, nRemaining + sopInstances.size());
     }
 
     if (dbStatus.status() == STATUS_Pending) {
@@ -148,9 +282,21 @@ void DcmQueryRetrieveMoveContext::callbackHandler(
     /* set response status */
     response->DimseStatus = dbStatus.status();
     response->NumberOfRemainingSubOperations = nRemaining;
+    if (transcoder != NULL) {
+        /* sub-operations returned by the database but not yet performed */
+        response->NumberOfRemainingSubOperations = OFstatic_cast(DIC_US, nRemaining + transcoder->numberOfPendingSubOperations());
+    }
+#ifdef WITH_THREADS
+    /* the counters are also updated by the threads performing the sub-operations */
+    mutex.lock();
+    response->NumberOfRemainingSubOperations = OFstatic_cast(DIC_US, response->NumberOfRemainingSubOperations + nOutstanding);
+#endif
     response->NumberOfCompletedSubOperations = nCompleted;
     response->NumberOfFailedSubOperations = nFailed;
     response->NumberOfWarningSubOperations = nWarning;
+#ifdef WITH_THREADS
+    mutex.unlock();
+#endif
     *stDetail = dbStatus.extractStatusDetail();
 
     OFString str;
@@ -188,47 +334,49 @@ void DcmQueryRetrieveMoveContext::addFailedUIDInstance(const char *sopInstance)
     }
 }
 
-OFCondition DcmQueryRetrieveMoveContext::performMoveSubOp(DIC_UI sopClass, DIC_UI sopInstance, char *fname)
+void DcmQueryRetrieveMoveContext::countSubOperation(const char *sopInstance, OFBool failed, OFBool warning)
 {
-    OFCondition cond = EC_Normal;
-    T_DIMSE_C_StoreRQ req;
-    T_DIMSE_C_StoreRSP rsp;
-    DIC_US msgId;
-    T_ASC_PresentationContextID presId;
-    DcmDataset *stDetail = NULL;
-
-#ifdef LOCK_IMAGE_FILES
-    /* shared lock image file */
-    int lockfd;
-#ifdef O_BINARY
-    lockfd = open(fname, O_RDONLY | O_BINARY, 0666);
-#else
-    lockfd = open(fname, O_RDONLY , 0666);
+#ifdef WITH_THREADS
+    /* sub-operations may be performed by several threads */
+    mutex.lock();
 #endif
-    if (lockfd < 0) {
-        /* due to quota system the file could have been deleted */
-        DCMQRDB_ERROR("Move SCP: storeSCU: [file: " << fname << "]: "
-            << OFStandard::getLastSystemErrorCode().message());
+    if (failed) {
         nFailed++;
         addFailedUIDInstance(sopInstance);
-        return EC_Normal;
+    } else if (warning) {
+        nWarning++;
+    } else {
+        nCompleted++;
     }
-    dcmtk_flock(lockfd, LOCK_SH);
+#ifdef WITH_THREADS
+    mutex.unlock();
 #endif
+}
 
-    msgId = subAssoc->nextMsgID++;
+OFCondition DcmQueryRetrieveMoveContext::performMoveSubOp(T_ASC_Association *assoc, DcmQueryRetrieveSubOperation& subOp)
+{
+    OFCondition cond = EC_Normal;
+    T_DIMSE_C_StoreRQ req;
+    T_DIMSE_C_StoreRSP rsp;
+    DIC_US msgId;
+    DcmDataset *stDetail = NULL;
+    const char *sopClass = subOp.sopClass.c_str();
+    const char *sopInstance = subOp.sopInstance.c_str();
 
-    /* which presentation context should be used */
-    presId = ASC_findAcceptedPresentationContextID(subAssoc,
-        sopClass);
-    if (presId == 0) {
-        nFailed++;
-        addFailedUIDInstance(sopInstance);
-        DCMQRDB_ERROR("Move SCP: storeSCU: [file: " << fname << "] No presentation context for: ("
-            << dcmSOPClassUIDToModality(sopClass, "OT") << ") " << sopClass);
-        return DIMSE_NOVALIDPRESENTATIONCONTEXTID;
+    if (subOp.status.bad()) {
+        countSubOperation(sopInstance, OFTrue, OFFalse);
+        if (subOp.status == DIMSE_NOVALIDPRESENTATIONCONTEXTID) {
+            DCMQRDB_ERROR("Move SCP: storeSCU: [file: " << subOp.filename << "] No presentation context for: ("
+                << dcmSOPClassUIDToModality(sopClass, "OT") << ") " << sopClass);
+        } else {
+            /* due to quota system the file could have been deleted */
+            DCMQRDB_ERROR("Move SCP: storeSCU: [file: " << subOp.filename << "]: " << subOp.status.text());
+        }
+        return subOp.status;
     }
 
+    msgId = assoc->nextMsgID++;
+
     req.MessageID = msgId;
     OFStandard::strlcpy(req.AffectedSOPClassUID, sopClass, DIC_UI_LEN + 1); // see declaration of DIC_UI in dcmtk/dcmnet/dicom.h
     OFStandard::strlcpy(req.AffectedSOPInstanceUID, sopInstance, DIC_UI_LEN + 1);
@@ -241,38 +389,31 @@ OFCondition DcmQueryRetrieveMoveContext::performMoveSubOp(DIC_UI sopClass, DIC_U
     DCMQRDB_INFO("Store SCU RQ: MsgID " << msgId << ", ("
         << dcmSOPClassUIDToModality(sopClass, "OT") << ")");
 
-    cond = DIMSE_storeUser(subAssoc, presId, &req,
-        fname, NULL, moveSubOpProgressCallback, this,
+    /* the file has already been loaded (and converted if needed) by the transcoder */
+    cond = DIMSE_storeUser(assoc, subOp.presId, &req,
+        NULL, subOp.fileformat->getDataset(), moveSubOpProgressCallback, this,
         options_.blockMode_, options_.dimse_timeout_,
         &rsp, &stDetail);
 
-#ifdef LOCK_IMAGE_FILES
-    /* unlock image file */
-    dcmtk_flock(lockfd, LOCK_UN);
-    close(lockfd);
-#endif
-
     if (cond.good()) {
         DCMQRDB_INFO("Move SCP: Received Store SCU RSP [Status="
             << DU_cstoreStatusString(rsp.DimseStatus) << "]");
         if (rsp.DimseStatus == STATUS_Success) {
             /* everything ok */
-            nCompleted++;
+            countSubOperation(sopInstance, OFFalse, OFFalse);
         } else if (DICOM_WARNING_STATUS(rsp.DimseStatus)) {
             /* a warning status message */
-            nWarning++;
+            countSubOperation(sopInstance, OFFalse, OFTrue);
             DCMQRDB_ERROR("Move SCP: Store Warning: Response Status: " <<
                     DU_cstoreStatusString(rsp.DimseStatus));
         } else {
-            nFailed++;
-            addFailedUIDInstance(sopInstance);
+            countSubOperation(sopInstance, OFTrue, OFFalse);
             /* print a status message */
             DCMQRDB_ERROR("Move SCP: Store Failed: Response Status: " <<
                 DU_cstoreStatusString(rsp.DimseStatus));
         }
     } else {
-        nFailed++;
-        addFailedUIDInstance(sopInstance);
+        countSubOperation(sopInstance, OFTrue, OFFalse);
         OFString temp_str;
         DCMQRDB_ERROR("Move SCP: storeSCU: Store Request Failed: " << DimseCondition::dump(temp_str, cond));
     }
@@ -289,8 +430,6 @@ OFCondition DcmQueryRetrieveMoveContext::buildSubAssociation(T_DIMSE_C_MoveRQ *r
     DIC_NODENAME dstHostName;
     DIC_NODENAME dstHostNamePlusPort;
     int dstPortNumber;
-    T_ASC_Parameters *params = NULL;
-    OFString temp_str;
 
     OFStandard::strlcpy(dstAETitle, request->MoveDestination, DIC_AE_LEN + 1);
 
@@ -311,14 +450,63 @@ OFCondition DcmQueryRetrieveMoveContext::buildSubAssociation(T_DIMSE_C_MoveRQ *r
         request->MoveDestination, dstHostName, DIC_NODENAME_LEN + 1, &dstPortNumber)) {
         return QR_EC_InvalidPeer;
     }
+    OFStandard::snprintf(dstHostNamePlusPort, sizeof(DIC_NODENAME), "%s:%d", dstHostName, dstPortNumber);
+    cond = requestSubAssociation(dstHostNamePlusPort, &subAssoc);
+
     if (cond.good()) {
-        cond = ASC_createAssociationParameters(&params, ASC_DEFAULTMAXPDU, dcmConnectionTimeout.get());
-        if (cond.bad()) {
-            DCMQRDB_ERROR("moveSCP: Cannot create Association-params for sub-ops: " << DimseCondition::dump(temp_str, cond));
+        assocStarted = OFTrue;
+        OFList<OFString> transferSyntaxes;
+        config->transferSyntaxesForPeer(dstAETitle, transferSyntaxes);
+#ifdef WITH_THREADS
+        if (options_.maxMoveSubAssociations_ > 1) {
+            /* request further sub-associations and serve each of them by a separate thread */
+            OFList<T_ASC_Association *> assocs;
+            assocs.push_back(subAssoc);
+            for (OFCmdUnsignedInt i = 1; i < options_.maxMoveSubAssociations_; i++) {
+                T_ASC_Association *assoc = NULL;
+                if (requestSubAssociation(dstHostNamePlusPort, &assoc).bad()) {
+                    /* continue with the sub-associations established so far */
+                    DCMQRDB_WARN("moveSCP: using " << assocs.size() << " parallel Sub-Association(s) only");
+                    break;
+                }
+                assocs.push_back(assoc);
+            }
+            for (OFListIterator(T_ASC_Association *) it = assocs.begin(); it != assocs.end(); ++it) {
+                DcmQueryRetrieveMoveSubAssociation *thread = new DcmQueryRetrieveMoveSubAssociation(*this, *it, transferSyntaxes);
+                if (thread->start() == 0) {
+                    parallelSubAssocs.push_back(thread);
+                } else {
+                    DCMQRDB_WARN("moveSCP: cannot start thread for Sub-Association");
+                    delete thread;
+                    if (*it != subAssoc) releaseSubAssociation(&(*it));
+                }
+            }
+            /* the sub-association of the first thread is released last */
+            if (parallelSubAssocs.empty() || (parallelSubAssocs.front()->assoc_ != subAssoc)) {
+                while (!parallelSubAssocs.empty()) {
+                    OFList<OFString> sopInstances;
+                    stopParallelSubAssociations(sopInstances);
+                }
+            }
         }
+        if (parallelSubAssocs.empty())
+#endif
+        transcoder = new DcmQueryRetrieveTranscoder(subAssoc, transferSyntaxes, options_.transcodingQueueSize_, OFFalse, options_.prefetchSubOperations_);
+    }
+    return cond;
+}
+
+OFCondition DcmQueryRetrieveMoveContext::requestSubAssociation(const char *dstHostNamePlusPort, T_ASC_Association **assoc)
+{
+    OFCondition cond = EC_Normal;
+    T_ASC_Parameters *params = NULL;
+    OFString temp_str;
+
+    cond = ASC_createAssociationParameters(&params, ASC_DEFAULTMAXPDU, dcmConnectionTimeout.get());
+    if (cond.bad()) {
+        DCMQRDB_ERROR("moveSCP: Cannot create Association-params for sub-ops: " << DimseCondition::dump(temp_str, cond));
     }
     if (cond.good()) {
-        OFStandard::snprintf(dstHostNamePlusPort, sizeof(DIC_NODENAME), "%s:%d", dstHostName, dstPortNumber);
         ASC_setPresentationAddresses(params, OFStandard::getHostName().c_str(),
             dstHostNamePlusPort);
         ASC_setAPTitles(params, ourAETitle.c_str(), dstAETitle,NULL);
@@ -336,7 +524,7 @@ OFCondition DcmQueryRetrieveMoveContext::buildSubAssociation(T_DIMSE_C_MoveRQ *r
     if (cond.good()) {
         /* create association */
         DCMQRDB_INFO("Requesting Sub-Association");
-        cond = ASC_requestAssociation(options_.net_, params, &subAssoc);
+        cond = ASC_requestAssociation(options_.net_, params, assoc);
         if (cond.bad()) {
             if (cond == DUL_ASSOCIATIONREJECTED) {
                 T_ASC_RejectParameters rej;
@@ -346,35 +534,48 @@ OFCondition DcmQueryRetrieveMoveContext::buildSubAssociation(T_DIMSE_C_MoveRQ *r
             } else {
                 DCMQRDB_ERROR("moveSCP: Sub-Association Request Failed: " << DimseCondition::dump(temp_str, cond));
             }
+            /* the parameters are owned by the association, if it was created */
+            if (*assoc == NULL) ASC_destroyAssociationParameters(&params);
+            else ASC_destroyAssociation(assoc);
         }
     }
+    return cond;
+}
 
-    if (cond.good()) {
-        assocStarted = OFTrue;
+void DcmQueryRetrieveMoveContext::releaseSubAssociation(T_ASC_Association **assoc)
+{
+    OFCondition cond;
+    OFString temp_str;
+    DCMQRDB_INFO("Releasing Sub-Association");
+    cond = ASC_releaseAssociation(*assoc);
+    if (cond.bad()) {
+        DCMQRDB_ERROR("moveSCP: Sub-Association Release Failed: " << DimseCondition::dump(temp_str, cond));
+    }
+    cond = ASC_dropAssociation(*assoc);
+    if (cond.bad()) {
+        DCMQRDB_ERROR("moveSCP: Sub-Association Drop Failed: " << DimseCondition::dump(temp_str, cond));
+    }
+    cond = ASC_destroyAssociation(assoc);
+    if (cond.bad()) {
+        DCMQRDB_ERROR("moveSCP: Sub-Association Destroy Failed: " << DimseCondition::dump(temp_str, cond));
     }
-    return cond;
 }
 
 OFCondition DcmQueryRetrieveMoveContext::closeSubAssociation()
 {
     OFCondition cond = EC_Normal;
 
+    /* discard the sub-operations not yet performed (if any) */
+    delete transcoder;
+    transcoder = NULL;
+#ifdef WITH_THREADS
+    OFList<OFString> sopInstances;
+    stopParallelSubAssociations(sopInstances);
+#endif
+
     if (subAssoc != NULL) {
         /* release association */
-        OFString temp_str;
-        DCMQRDB_INFO("Releasing Sub-Association");
-        cond = ASC_releaseAssociation(subAssoc);
-        if (cond.bad()) {
-            DCMQRDB_ERROR("moveSCP: Sub-Association Release Failed: " << DimseCondition::dump(temp_str, cond));
-        }
-        cond = ASC_dropAssociation(subAssoc);
-        if (cond.bad()) {
-            DCMQRDB_ERROR("moveSCP: Sub-Association Drop Failed: " << DimseCondition::dump(temp_str, cond));
-        }
-        cond = ASC_destroyAssociation(&subAssoc);
-        if (cond.bad()) {
-            DCMQRDB_ERROR("moveSCP: Sub-Association Destroy Failed: " << DimseCondition::dump(temp_str, cond));
-        }
+        releaseSubAssociation(&subAssoc);
     }
 
     if (assocStarted) {
@@ -392,30 +593,162 @@ void DcmQueryRetrieveMoveContext::moveNextImage(DcmQueryRetrieveDatabaseStatus *
     DIC_UI subImgSOPInstance;   /* sub-operation image SOP Instance */
     char subImgFileName[MAXPATHLEN + 1];    /* sub-operation image file */
 
-    /* clear out strings */
-    memset(subImgFileName, 0, sizeof(subImgFileName));
-    memset(subImgSOPClass, 0, sizeof(subImgSOPClass));
-    memset(subImgSOPInstance,0, sizeof(subImgSOPInstance));
+#ifdef WITH_THREADS
+    if (!parallelSubAssocs.empty()) {
+        moveNextImagesParallel(dbStatus);
+        return;
+    }
+#endif
 
-    /* get DB response */
-    dbcond = dbHandle.nextMoveResponse(
-        subImgSOPClass, sizeof(subImgSOPClass), subImgSOPInstance, sizeof(subImgSOPInstance), subImgFileName, sizeof(subImgFileName), &nRemaining, dbStatus);
-    if (dbcond.bad()) {
-        DCMQRDB_ERROR("moveSCP: Database: nextMoveResponse Failed ("
-                << DU_cmoveStatusString(dbStatus->status()) << "):");
+    /* get DB responses until enough sub-operations are being prepared */
+    while (!dbFinished && transcoder->wantsSubOperations()) {
+        /* clear out strings */
+        memset(subImgFileName, 0, sizeof(subImgFileName));
+        memset(subImgSOPClass, 0, sizeof(subImgSOPClass));
+        memset(subImgSOPInstance,0, sizeof(subImgSOPInstance));
+
+        /* get DB response */
+        dbcond = dbHandle.nextMoveResponse(
+            subImgSOPClass, sizeof(subImgSOPClass), subImgSOPInstance, sizeof(subImgSOPInstance), subImgFileName, sizeof(subImgFileName), &nRemaining, dbStatus);
+        if (dbcond.bad()) {
+            DCMQRDB_ERROR("moveSCP: Database: nextMoveResponse Failed ("
+                    << DU_cmoveStatusString(dbStatus->status()) << "):");
+        }
+
+        if (dbStatus->status() == STATUS_Pending) {
+            transcoder->addSubOperation(subImgSOPClass, subImgSOPInstance, subImgFileName);
+        } else {
+            dbFinished = OFTrue;
+            if (dbStatus->status() != STATUS_Success) {
+                /* the sub-operations already returned by the database are not performed */
+                OFList<OFString> sopInstances;
+                transcoder->clear(sopInstances);
+                for (OFListIterator(OFString) it = sopInstances.begin(); it != sopInstances.end(); ++it) {
+                    nFailed++;
+                    addFailedUIDInstance((*it).c_str());
+                }
+                return;
+            }
+        }
     }
 
-    if (dbStatus->status() == STATUS_Pending) {
-        /* perform sub-op */
-        cond = performMoveSubOp(subImgSOPClass, subImgSOPInstance, subImgFileName);
+    /* perform sub-op */
+    DcmQueryRetrieveSubOperation *subOp = transcoder->nextSubOperation();
+    if (subOp != NULL) {
+        cond = performMoveSubOp(subAssoc, *subOp);
+        delete subOp;
         if (cond != EC_Normal) {
             OFString temp_str;
             DCMQRDB_ERROR("moveSCP: Move Sub-Op Failed: " << DimseCondition::dump(temp_str, cond));
             /* clear condition stack */
         }
     }
+
+    /* the move is complete when the database and the queue are exhausted */
+    if (dbFinished) {
+        dbStatus->setStatus((transcoder->numberOfPendingSubOperations() > 0) ? STATUS_Pending : STATUS_Success);
+    }
+}
+
+#ifdef WITH_THREADS
+
+void DcmQueryRetrieveMoveContext::moveNextImagesParallel(DcmQueryRetrieveDatabaseStatus * dbStatus)
+{
+    OFCondition dbcond = EC_Normal;
+    DIC_UI subImgSOPClass;      /* sub-operation image SOP Class */
+    DIC_UI subImgSOPInstance;   /* sub-operation image SOP Instance */
+    char subImgFileName[MAXPATHLEN + 1];    /* sub-operation image file */
+
+    /* keep every thread busy, including the sub-operations prepared in advance */
+    const size_t maxOutstanding = parallelSubAssocs.size() * (options_.transcodingQueueSize_ + 2);
+
+    /* get DB responses and pass them to the threads */
+    while (!dbFinished && (nOutstanding < maxOutstanding)) {
+        /* clear out strings */
+        memset(subImgFileName, 0, sizeof(subImgFileName));
+        memset(subImgSOPClass, 0, sizeof(subImgSOPClass));
+        memset(subImgSOPInstance,0, sizeof(subImgSOPInstance));
+
+        /* get DB response */
+        dbcond = dbHandle.nextMoveResponse(
+            subImgSOPClass, sizeof(subImgSOPClass), subImgSOPInstance, sizeof(subImgSOPInstance), subImgFileName, sizeof(subImgFileName), &nRemaining, dbStatus);
+        if (dbcond.bad()) {
+            DCMQRDB_ERROR("moveSCP: Database: nextMoveResponse Failed ("
+                    << DU_cmoveStatusString(dbStatus->status()) << "):");
+        }
+
+        if (dbStatus->status() == STATUS_Pending) {
+            mutex.lock();
+            dispatchQueue.push_back(new DcmQueryRetrieveSubOperation(subImgSOPClass, subImgSOPInstance, subImgFileName));
+            nOutstanding++;
+            mutex.unlock();
+            dispatchCount.post();
+        } else {
+            dbFinished = OFTrue;
+            if (dbStatus->status() != STATUS_Success) {
+                /* the sub-operations already returned by the database are not performed */
+                OFList<OFString> sopInstances;
+                stopParallelSubAssociations(sopInstances);
+                for (OFListIterator(OFString) it = sopInstances.begin(); it != sopInstances.end(); ++it) {
+                    countSubOperation((*it).c_str(), OFTrue, OFFalse);
+                }
+                return;
+            }
+            /* wake up all threads waiting for further sub-operations */
+            mutex.lock();
+            dispatchFinished = OFTrue;
+            mutex.unlock();
+            for (size_t i = 0; i < parallelSubAssocs.size(); i++)
+                dispatchCount.post();
+        }
+    }
+
+    /* report the progress after each sub-operation performed by any of the threads */
+    if (nOutstanding > 0) {
+        completedCount.wait();
+        mutex.lock();
+        nOutstanding--;
+        mutex.unlock();
+    }
+
+    /* the move is complete when the database and all threads are finished */
+    if (dbFinished) {
+        dbStatus->setStatus((nOutstanding > 0) ? STATUS_Pending : STATUS_Success);
+    }
+}
+
+void DcmQueryRetrieveMoveContext::stopParallelSubAssociations(OFList<OFString>& sopInstances)
+{
+    if (parallelSubAssocs.empty())
+        return;
+    DcmQueryRetrieveSubOperation *subOp;
+    mutex.lock();
+    stopRequested = OFTrue;
+    while (!dispatchQueue.empty()) {
+        subOp = dispatchQueue.front();
+        dispatchQueue.pop_front();
+        sopInstances.push_back(subOp->sopInstance);
+        delete subOp;
+    }
+    mutex.unlock();
+    OFListIterator(DcmQueryRetrieveMoveSubAssociation *) it;
+    for (it = parallelSubAssocs.begin(); it != parallelSubAssocs.end(); ++it)
+        dispatchCount.post();
+    for (it = parallelSubAssocs.begin(); it != parallelSubAssocs.end(); ++it) {
+        (*it)->join();
+        (*it)->getUnsentSubOperations(sopInstances);
+        /* the first sub-association is released by closeSubAssociation() */
+        if ((*it)->assoc_ != subAssoc) releaseSubAssociation(&(*it)->assoc_);
+        delete *it;
+    }
+    parallelSubAssocs.clear();
+    mutex.lock();
+    nOutstanding = 0;
+    mutex.unlock();
 }
 
+#endif
+
 void DcmQueryRetrieveMoveContext::failAllSubOperations(DcmQueryRetrieveDatabaseStatus * dbStatus)
 {
     OFCondition dbcond = EC_Normal;
@@ -512,7 +845,6 @@ OFBool DcmQueryRetrieveMoveContext::mapMoveDestination(
 
 OFCondition DcmQueryRetrieveMoveContext::addAllStoragePresentationContexts(T_ASC_Parameters *params)
 {
-    // this would be the place to add support for compressed transfer syntaxes
     OFCondition cond = EC_Normal;
 
     int i;
@@ -696,10 +1028,28 @@ OFCondition DcmQueryRetrieveMoveContext::addAllStoragePresentationContexts(T_ASC
     }
 #endif
 
+    /* transfer syntaxes configured for the move destination are proposed first,
+     * followed by the default transfer syntaxes. Instances not stored in the
+     * accepted transfer syntax are converted before they are sent.
+     */
+    OFList<OFString> preferredTransferSyntaxes;
+    OFVector<const char *> proposedTransferSyntaxes;
+    if (config->transferSyntaxesForPeer(dstAETitle, preferredTransferSyntaxes) > 0) {
+        for (i = 0; i < numTransferSyntaxes; i++) {
+            if (OFFind(OFListIterator(OFString), OFString, preferredTransferSyntaxes.begin(), preferredTransferSyntaxes.end(), transferSyntaxes[i]) == preferredTransferSyntaxes.end())
+                preferredTransferSyntaxes.push_back(transferSyntaxes[i]);
+        }
+        for (OFListIterator(OFString) it = preferredTransferSyntaxes.begin(); it != preferredTransferSyntaxes.end(); ++it)
+            proposedTransferSyntaxes.push_back((*it).c_str());
+    } else {
+        for (i = 0; i < numTransferSyntaxes; i++)
+            proposedTransferSyntaxes.push_back(transferSyntaxes[i]);
+    }
+
     for (i = 0; i < numberOfDcmLongSCUStorageSOPClassUIDs && cond.good(); i++) {
         cond = ASC_addPresentationContext(
             params, OFstatic_cast(T_ASC_PresentationContextID, pid), dcmLongSCUStorageSOPClassUIDs[i],
-            transferSyntaxes, numTransferSyntaxes);
+            &proposedTransferSyntaxes[0], OFstatic_cast(int, proposedTransferSyntaxes.size()));
         pid += 2;   /* only odd presentation context id's */
     }
     return cond;
@@ -26,6 +26,7 @@
 #include "dcmtk/ofstd/ofcmdln.h"
 #include "dcmtk/ofstd/ofmap.h"
 #include "dcmtk/ofstd/ofchrenc.h"
+#include "dcmtk/dcmnet/dccfuidh.h"   /* for class DcmUIDHandler */
 
 #include <climits>
 
@@ -288,6 +289,7 @@ void DcmQueryRetrieveConfig::initConfigStruct()
    CNF_Config.noOfAEEntries = 0;
    CNF_HETable.noOfHostEntries = 0;
    CNF_VendorTable.noOfHostEntries = 0;
+   CNF_TransferSyntaxTable.clear();
 }
 
 
@@ -433,6 +435,21 @@ int DcmQueryRetrieveConfig::readConfigLines(FILE *cnffp)
             error = 1;
          }
       }
+      else if (!strcmp("TransferSyntaxTable", mnemonic)) {
+         sscanf(valueptr, "%s", value);
+         if (!strcmp("BEGIN", value)) {
+            if (!readTransferSyntaxTable(cnffp, &lineno))
+               error = 1;
+         }
+         else if (!strcmp("END", value)) {
+            panic("No \"TransferSyntaxTable BEGIN\" before END in configuration file, line %d", lineno);
+            error = 1;
+         }
+         else {
+            panic("Unknown TransferSyntaxTable status \"%s\" in configuration file, line %d", value, lineno);
+            error = 1;
+         }
+      }
       else {
          panic("Unknown mnemonic \"%s\" in configuration file, line %d", mnemonic, lineno);
          error = 1;
@@ -553,6 +570,70 @@ int DcmQueryRetrieveConfig::readVendorTable(FILE *cnffp, int *lineno)
 }
 
 
+int DcmQueryRetrieveConfig::readTransferSyntaxTable(FILE *cnffp, int *lineno)
+{
+   int  error = 0,        /* error flag */
+        end = 0;          /* end flag */
+   char rcline[512],      /* line in configuration file */
+        mnemonic[512],    /* mnemonic in line */
+        value[512],       /* parameter value */
+        *lineptr,         /* pointer to line */
+        *c;               /* current value */
+
+   // read certain lines from configuration file
+   while (fgets(rcline, sizeof(rcline), cnffp)) {
+      (*lineno)++;
+      if (rcline[0] == '#' || rcline[0] == 10 || rcline[0] == 13)
+         continue;        /* comment or blank line */
+
+      value[0] = '\0';
+      if (sscanf(rcline, "%s %s", mnemonic, value) < 1)
+         continue;        /* ignore lines containing only whitespace */
+      if (!strcmp("TransferSyntaxTable", mnemonic)) {
+         if (!strcmp("END", value)) {
+            end = 1;
+            break;
+         }
+         else {
+            panic("Illegal TransferSyntaxTable status \"%s\" in configuration file, line %d", value, *lineno);
+            error = 1;
+            break;
+         }
+      }
+
+      lineptr = rcline;
+      DcmQueryRetrieveConfigTransferSyntaxEntry entry;
+      c = parsevalues(&lineptr);
+      if (c) {
+         entry.Name = c;
+         free(c);
+      }
+      while ((c = parsevalues(&lineptr)) != NULL) {
+         DcmUIDHandler uid(c);
+         if (uid.isValidUID()) {
+            entry.TransferSyntaxes.push_back(uid.c_str());
+         } else {
+            panic("Unknown transfer syntax \"%s\" in configuration file, line %d", c, *lineno);
+            error = 1;
+         }
+         free(c);
+      }
+      if (entry.TransferSyntaxes.empty()) {
+         panic("No transfer syntax for \"%s\" in configuration file, line %d", entry.Name.c_str(), *lineno);
+         error = 1;
+      }
+      else
+         CNF_TransferSyntaxTable.push_back(entry);
+   }
+
+   if (!end) {
+      error = 1;
+      panic("No \"TransferSyntaxTable END\" in configuration file, line %d", *lineno);
+   }
+   return(error ? 0 : 1);
+}
+
+
 int DcmQueryRetrieveConfig::readAETable(FILE *cnffp, int *lineno)
 {
    int  error = 0,          /* error flag */
@@ -1066,6 +1147,33 @@ int DcmQueryRetrieveConfig::peerForAETitle(const char *AETitle, const char **Hos
 }
 
 
+size_t DcmQueryRetrieveConfig::transferSyntaxesForPeer(const char *AETitle, OFList<OFString>& transferSyntaxes) const
+{
+    transferSyntaxes.clear();
+    if (AETitle == NULL) return 0;
+    const DcmQueryRetrieveConfigTransferSyntaxEntry *found = NULL;
+    OFListConstIterator(DcmQueryRetrieveConfigTransferSyntaxEntry) it;
+
+    // an entry for the AE title itself takes precedence over symbolic names
+    for (it = CNF_TransferSyntaxTable.begin(); (found == NULL) && (it != CNF_TransferSyntaxTable.end()); ++it) {
+        if ((*it).Name == AETitle) found = &(*it);
+    }
+    for (it = CNF_TransferSyntaxTable.begin(); (found == NULL) && (it != CNF_TransferSyntaxTable.end()); ++it) {
+        for (int i = 0; (found == NULL) && (i < CNF_HETable.noOfHostEntries); i++) {
+            if ((*it).Name == CNF_HETable.HostEntries[i].SymbolicName) {
+                for (int j = 0; j < CNF_HETable.HostEntries[i].noOfPeers; j++) {
+                    if (strcmp(AETitle, CNF_HETable.HostEntries[i].Peers[j].ApplicationTitle) == 0) {
+                        found = &(*it);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    if (found) transferSyntaxes = found->TransferSyntaxes;
+    return transferSyntaxes.size();
+}
+
 int DcmQueryRetrieveConfig::checkForSameVendor(const char *AETitle1, const char *AETitle2) const
 {
    int  i,
@@ -36,8 +36,10 @@ DcmQueryRetrieveOptions::DcmQueryRetrieveOptions()
 , itempad_(0)
 , maxAssociations_(20)
 , maxPDU_(ASC_DEFAULTMAXPDU)
+, maxMoveSubAssociations_(1)
 , net_(NULL)
 , networkTransferSyntax_(EXS_Unknown)
+, prefetchSubOperations_(OFFalse)
 #ifndef DISABLE_COMPRESSION_EXTENSION
 ,  networkTransferSyntaxOut_(EXS_Unknown)
 #endif
@@ -62,6 +64,7 @@ DcmQueryRetrieveOptions::DcmQueryRetrieveOptions()
 , supportPatientStudyOnly_(OFTrue)
 #endif
 , supportStudyRoot_(OFTrue)
+, transcodingQueueSize_(2)
 , useMetaheader_(OFTrue)
 , keepDBHandleDuringAssociation_(OFTrue)
 , writeTransferSyntax_(EXS_Unknown)
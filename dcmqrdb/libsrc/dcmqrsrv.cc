@@ -31,6 +31,8 @@
 #include "dcmtk/dcmqrdb/dcmqrcbg.h"    /* for class DcmQueryRetrieveGetContext */
 #include "dcmtk/dcmqrdb/dcmqrcbs.h"    /* for class DcmQueryRetrieveStoreContext */
 #include "dcmtk/dcmtls/tlsopt.h"       /* for DcmTLSOptions */
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofalgo.h"
 
 static void findCallback(
   /* in */
@@ -300,7 +302,7 @@ OFCondition DcmQueryRetrieveSCP::getSCP(T_ASC_Association * assoc, T_DIMSE_C_Get
         T_ASC_PresentationContextID presID, DcmQueryRetrieveDatabaseHandle& dbHandle)
 {
     OFCondition cond = EC_Normal;
-    DcmQueryRetrieveGetContext context(dbHandle, options_, STATUS_Pending, assoc, request->MessageID, request->Priority, presID);
+    DcmQueryRetrieveGetContext context(dbHandle, options_, STATUS_Pending, assoc, request->MessageID, request->Priority, presID, config_);
 
     DIC_AE aeTitle;
     aeTitle[0] = '\0';
@@ -862,6 +864,26 @@ OFCondition DcmQueryRetrieveSCP::negotiateAssociation(T_ASC_Association * assoc)
         T_ASC_PresentationContext pc;
         T_ASC_SC_ROLE role;
         int npc = ASC_countPresentationContexts(assoc->params);
+
+        /* for C-GET, the transfer syntaxes configured for the requestor are
+         * preferred, followed by our default transfer syntaxes. Instances not
+         * stored in the accepted transfer syntax are converted before sending.
+         */
+        DIC_AE callingAETitle;
+        ASC_getAPTitles(assoc->params, callingAETitle, sizeof(callingAETitle), NULL, 0, NULL, 0);
+        OFList<OFString> preferredGetSyntaxes;
+        OFVector<const char *> getTransferSyntaxes;
+        if (config_->transferSyntaxesForPeer(callingAETitle, preferredGetSyntaxes) > 0)
+        {
+          for (i = 0; i < numTransferSyntaxes; i++)
+          {
+            if (OFFind(OFListIterator(OFString), OFString, preferredGetSyntaxes.begin(), preferredGetSyntaxes.end(), transferSyntaxes[i]) == preferredGetSyntaxes.end())
+              preferredGetSyntaxes.push_back(transferSyntaxes[i]);
+          }
+          for (OFListIterator(OFString) it = preferredGetSyntaxes.begin(); it != preferredGetSyntaxes.end(); ++it)
+            getTransferSyntaxes.push_back((*it).c_str());
+        }
+
         for (i = 0; i < npc; i++)
         {
           ASC_getPresentationContext(assoc->params, i, &pc);
@@ -873,23 +895,30 @@ OFCondition DcmQueryRetrieveSCP::negotiateAssociation(T_ASC_Association * assoc)
             ** When processing the C-GET operation we can be the SCU of the Storage Service Class.
             */
             role = pc.proposedRole;
+            const char **acceptedSyntaxes = (const char **)transferSyntaxes;
+            int numAcceptedSyntaxes = numTransferSyntaxes;
+            if (!getTransferSyntaxes.empty() && ((role == ASC_SC_ROLE_SCP) || (role == ASC_SC_ROLE_SCUSCP)))
+            {
+              acceptedSyntaxes = &getTransferSyntaxes[0];
+              numAcceptedSyntaxes = OFstatic_cast(int, getTransferSyntaxes.size());
+            }
 
             /*
             ** Accept in the order "least wanted" to "most wanted" transfer
             ** syntax.  Accepting a transfer syntax will override previously
             ** accepted transfer syntaxes.
             */
-            for (int k = numTransferSyntaxes - 1; k >= 0; k--)
+            for (int k = numAcceptedSyntaxes - 1; k >= 0; k--)
             {
               for (int j = 0; j < (int)pc.transferSyntaxCount; j++)
               {
                 /* if the transfer syntax was proposed then we can accept it
                  * appears in our supported list of transfer syntaxes
                  */
-                if (strcmp(pc.proposedTransferSyntaxes[j], transferSyntaxes[k]) == 0)
+                if (strcmp(pc.proposedTransferSyntaxes[j], acceptedSyntaxes[k]) == 0)
                 {
                   cond = ASC_acceptPresentationContext(
-                      assoc->params, pc.presentationContextID, transferSyntaxes[k], role);
+                      assoc->params, pc.presentationContextID, acceptedSyntaxes[k], role);
                   if (cond.bad()) return cond;
                 }
               }
@@ -0,0 +1,393 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: class DcmQueryRetrieveTranscoder
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmqrdb/dcmqrtcd.h"
+
+#include "dcmtk/dcmqrdb/dcmqrcnf.h"   /* for DCMQRDB_DEBUG */
+#include "dcmtk/dcmnet/dimse.h"       /* for DIMSE_NOVALIDPRESENTATIONCONTEXTID */
+#include "dcmtk/dcmnet/diutil.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/dcmdata/dcuid.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+BEGIN_EXTERN_C
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>       /* needed on Solaris for O_RDONLY */
+#endif
+END_EXTERN_C
+
+
+/* ========================================================================= */
+
+#ifdef WITH_THREADS
+
+/** background thread preparing the sub-operations of a DcmQueryRetrieveTranscoder
+ */
+class DcmQueryRetrieveTranscoderThread: public OFThread
+{
+public:
+    /** constructor
+     *  @param transcoder the transcoder served by this thread
+     */
+    DcmQueryRetrieveTranscoderThread(DcmQueryRetrieveTranscoder& transcoder)
+    : OFThread()
+    , transcoder_(transcoder)
+    {
+    }
+
+protected:
+
+    /// prepare sub-operations until the transcoder requests to stop
+    virtual void run()
+    {
+      DcmQueryRetrieveSubOperation *subOp;
+      while (OFTrue)
+      {
+        transcoder_.waitingCount_.wait();
+        transcoder_.mutex_.lock();
+        if (transcoder_.stop_)
+        {
+          transcoder_.mutex_.unlock();
+          break;
+        }
+        // the queue may have been cleared in the meantime
+        if (transcoder_.waiting_.empty())
+        {
+          transcoder_.mutex_.unlock();
+          continue;
+        }
+        subOp = transcoder_.waiting_.front();
+        transcoder_.waiting_.pop_front();
+        transcoder_.mutex_.unlock();
+
+        transcoder_.prepare(*subOp);
+
+        transcoder_.mutex_.lock();
+        transcoder_.prepared_.push_back(subOp);
+        transcoder_.mutex_.unlock();
+        transcoder_.preparedCount_.post();
+      }
+    }
+
+private:
+
+    /// the transcoder served by this thread
+    DcmQueryRetrieveTranscoder& transcoder_;
+};
+
+#endif
+
+
+/* ========================================================================= */
+
+DcmQueryRetrieveSubOperation::DcmQueryRetrieveSubOperation(
+  const char *sopClassUID,
+  const char *sopInstanceUID,
+  const char *fname)
+: sopClass(sopClassUID)
+, sopInstance(sopInstanceUID)
+, filename(fname)
+, presId(0)
+, fileXfer(EXS_Unknown)
+, networkXfer(EXS_Unknown)
+, fileformat(NULL)
+, status(EC_Normal)
+#ifdef LOCK_IMAGE_FILES
+, lockfd(-1)
+#endif
+{
+}
+
+DcmQueryRetrieveSubOperation::~DcmQueryRetrieveSubOperation()
+{
+    delete fileformat;
+#ifdef LOCK_IMAGE_FILES
+    if (lockfd >= 0)
+    {
+        /* unlock image file */
+        dcmtk_flock(lockfd, LOCK_UN);
+        close(lockfd);
+    }
+#endif
+}
+
+
+/* ========================================================================= */
+
+DcmQueryRetrieveTranscoder::DcmQueryRetrieveTranscoder(
+  T_ASC_Association *assoc,
+  const OFList<OFString>& preferredTransferSyntaxes,
+  size_t queueSize,
+  OFBool requireSCPRole,
+  OFBool loadAllData)
+: contexts_()
+, queueSize_(queueSize)
+, loadAllData_(loadAllData)
+, pending_(0)
+, waiting_()
+#ifdef WITH_THREADS
+, prepared_()
+, thread_(NULL)
+, waitingCount_(0)
+, preparedCount_(0)
+, mutex_()
+, stop_(OFFalse)
+#endif
+{
+    /* copy the accepted presentation contexts and rank them according to the
+     * position of their transfer syntax in the list of preferences
+     */
+    if (assoc != NULL)
+    {
+        T_ASC_PresentationContext pc;
+        const int count = ASC_countPresentationContexts(assoc->params);
+        for (int i = 0; i < count; i++)
+        {
+            if (ASC_getPresentationContext(assoc->params, i, &pc).bad() || (pc.resultReason != ASC_P_ACCEPTANCE))
+                continue;
+            /* for C-GET, the association requestor must act as the storage SCP */
+            if (requireSCPRole && (pc.acceptedRole != ASC_SC_ROLE_SCP) && (pc.acceptedRole != ASC_SC_ROLE_SCUSCP))
+                continue;
+            PresentationContext context;
+            context.presId = pc.presentationContextID;
+            context.abstractSyntax = pc.abstractSyntax;
+            context.xfer = DcmXfer(pc.acceptedTransferSyntax).getXfer();
+            context.rank = 0;
+            OFListConstIterator(OFString) it = preferredTransferSyntaxes.begin();
+            while ((it != preferredTransferSyntaxes.end()) && (*it != pc.acceptedTransferSyntax))
+            {
+                ++context.rank;
+                ++it;
+            }
+            /* insert sorted by rank, keeping the order of the association otherwise */
+            OFListIterator(PresentationContext) pos = contexts_.begin();
+            while ((pos != contexts_.end()) && ((*pos).rank <= context.rank))
+                ++pos;
+            contexts_.insert(pos, context);
+        }
+    }
+#ifdef WITH_THREADS
+    if (queueSize_ > 0)
+    {
+        thread_ = new DcmQueryRetrieveTranscoderThread(*this);
+        if (thread_->start() != 0)
+        {
+            DCMQRDB_WARN("cannot start background thread for C-STORE sub-operations, preparing on demand");
+            delete thread_;
+            thread_ = NULL;
+        }
+    }
+#endif
+}
+
+DcmQueryRetrieveTranscoder::~DcmQueryRetrieveTranscoder()
+{
+#ifdef WITH_THREADS
+    if (thread_ != NULL)
+    {
+        mutex_.lock();
+        stop_ = OFTrue;
+        mutex_.unlock();
+        waitingCount_.post();
+        thread_->join();
+        delete thread_;
+    }
+    OFListIterator(DcmQueryRetrieveSubOperation *) pr = prepared_.begin();
+    while (pr != prepared_.end())
+    {
+        delete *pr;
+        ++pr;
+    }
+#endif
+    OFListIterator(DcmQueryRetrieveSubOperation *) it = waiting_.begin();
+    while (it != waiting_.end())
+    {
+        delete *it;
+        ++it;
+    }
+}
+
+void DcmQueryRetrieveTranscoder::addSubOperation(const char *sopClass, const char *sopInstance, const char *filename)
+{
+    DcmQueryRetrieveSubOperation *subOp = new DcmQueryRetrieveSubOperation(sopClass, sopInstance, filename);
+    ++pending_;
+#ifdef WITH_THREADS
+    if (thread_ != NULL)
+    {
+        mutex_.lock();
+        waiting_.push_back(subOp);
+        mutex_.unlock();
+        waitingCount_.post();
+        return;
+    }
+#endif
+    waiting_.push_back(subOp);
+}
+
+DcmQueryRetrieveSubOperation *DcmQueryRetrieveTranscoder::nextSubOperation()
+{
+    if (pending_ == 0)
+        return NULL;
+    DcmQueryRetrieveSubOperation *subOp = NULL;
+#ifdef WITH_THREADS
+    if (thread_ != NULL)
+    {
+        preparedCount_.wait();
+        mutex_.lock();
+        subOp = prepared_.front();
+        prepared_.pop_front();
+        mutex_.unlock();
+        --pending_;
+        return subOp;
+    }
+#endif
+    subOp = waiting_.front();
+    waiting_.pop_front();
+    --pending_;
+    prepare(*subOp);
+    return subOp;
+}
+
+void DcmQueryRetrieveTranscoder::clear(OFList<OFString>& sopInstances)
+{
+    DcmQueryRetrieveSubOperation *subOp;
+    /* discard the sub-operations not yet prepared */
+#ifdef WITH_THREADS
+    mutex_.lock();
+#endif
+    while (!waiting_.empty())
+    {
+        subOp = waiting_.front();
+        waiting_.pop_front();
+        sopInstances.push_back(subOp->sopInstance);
+        delete subOp;
+        --pending_;
+    }
+#ifdef WITH_THREADS
+    mutex_.unlock();
+#endif
+    /* wait for the sub-operations already being prepared */
+    while ((subOp = nextSubOperation()) != NULL)
+    {
+        sopInstances.push_back(subOp->sopInstance);
+        delete subOp;
+    }
+}
+
+/* check whether an instance stored in the given transfer syntax can be sent
+ * in the network transfer syntax without converting the pixel data
+ */
+static OFBool isSameEncoding(const E_TransferSyntax networkXfer, const E_TransferSyntax fileXfer)
+{
+    return (networkXfer == fileXfer) || (!DcmXfer(networkXfer).isEncapsulated() && !DcmXfer(fileXfer).isEncapsulated());
+}
+
+void DcmQueryRetrieveTranscoder::prepare(DcmQueryRetrieveSubOperation& subOp) const
+{
+#ifdef LOCK_IMAGE_FILES
+    /* shared lock image file */
+#ifdef O_BINARY
+    subOp.lockfd = open(subOp.filename.c_str(), O_RDONLY | O_BINARY, 0666);
+#else
+    subOp.lockfd = open(subOp.filename.c_str(), O_RDONLY , 0666);
+#endif
+    if (subOp.lockfd < 0)
+    {
+        /* due to quota system the file could have been deleted */
+        subOp.status = makeOFCondition(OFM_dcmqrdb, 3, OF_error, OFStandard::getLastSystemErrorCode().message().c_str());
+        return;
+    }
+    dcmtk_flock(subOp.lockfd, LOCK_SH);
+#endif
+
+    /* check whether there is a presentation context for the SOP class at all */
+    OFListConstIterator(PresentationContext) it = contexts_.begin();
+    while ((it != contexts_.end()) && ((*it).abstractSyntax != subOp.sopClass))
+        ++it;
+    if (it == contexts_.end())
+    {
+        subOp.status = DIMSE_NOVALIDPRESENTATIONCONTEXTID;
+        return;
+    }
+
+    subOp.fileformat = new DcmFileFormat();
+    subOp.status = subOp.fileformat->loadFile(subOp.filename.c_str());
+    if (subOp.status.bad())
+        return;
+    DcmDataset *dataset = subOp.fileformat->getDataset();
+    subOp.fileXfer = dataset->getOriginalXfer();
+    const DcmXfer fileXfer(subOp.fileXfer);
+
+    /* try the contexts in the order of preference. Among contexts of the same
+     * rank, the ones not requiring any conversion of the pixel data are tried
+     * first, then the ones requiring a (non-lossy) conversion.
+     */
+    OFListConstIterator(PresentationContext) selected = contexts_.end();
+    while ((it != contexts_.end()) && (selected == contexts_.end()))
+    {
+        const size_t rank = (*it).rank;
+        OFListConstIterator(PresentationContext) last = it;
+        while ((last != contexts_.end()) && ((*last).rank == rank))
+            ++last;
+        OFListConstIterator(PresentationContext) candidate;
+        for (candidate = it; (candidate != last) && (selected == contexts_.end()); ++candidate)
+        {
+            if (((*candidate).abstractSyntax == subOp.sopClass) && isSameEncoding((*candidate).xfer, subOp.fileXfer))
+                selected = candidate;
+        }
+        for (candidate = it; (candidate != last) && (selected == contexts_.end()); ++candidate)
+        {
+            if (((*candidate).abstractSyntax != subOp.sopClass) || isSameEncoding((*candidate).xfer, subOp.fileXfer))
+                continue;
+            const DcmXfer networkXfer((*candidate).xfer);
+            if (networkXfer.isLossy())
+            {
+                /* never create lossy compressed images, this would require a new SOP instance UID */
+                DCMQRDB_DEBUG("not converting " << subOp.filename << " from " << fileXfer.getXferName()
+                    << " to lossy transfer syntax " << networkXfer.getXferName());
+                continue;
+            }
+            DCMQRDB_DEBUG("converting " << subOp.filename << " from " << fileXfer.getXferName()
+                << " to " << networkXfer.getXferName());
+            if (dataset->chooseRepresentation((*candidate).xfer, NULL).good() && dataset->canWriteXfer((*candidate).xfer, subOp.fileXfer))
+                selected = candidate;
+            else
+                DCMQRDB_DEBUG("cannot convert " << subOp.filename << " to " << networkXfer.getXferName());
+        }
+        /* continue with the next rank */
+        it = last;
+        while ((it != contexts_.end()) && ((*it).abstractSyntax != subOp.sopClass))
+            ++it;
+    }
+    if (selected != contexts_.end())
+    {
+        subOp.presId = (*selected).presId;
+        subOp.networkXfer = (*selected).xfer;
+        /* read the remaining element values from file (e.g. the pixel data) */
+        subOp.status = loadAllData_ ? subOp.fileformat->loadAllDataIntoMemory() : EC_Normal;
+        return;
+    }
+    /* no suitable presentation context found, conversion not possible */
+    subOp.status = EC_CannotChangeRepresentation;
+}
@@ -0,0 +1,128 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Tests for selecting presentation contexts for C-STORE sub-operations
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmqrdb/dcmqrtcd.h"
+#include "dcmtk/dcmnet/assoc.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcuid.h"
+#include "dcmtk/dcmdata/dcrledrg.h"
+#include "dcmtk/dcmdata/dcrleerg.h"
+
+
+#define SOP_INSTANCE_UID "1.2.276.0.7230010.3.1.4.0.1"
+
+// create a small secondary capture image and save it in the given transfer syntax
+static OFBool createImageFile(const OFFilename& filename, const E_TransferSyntax xfer)
+{
+    DcmFileFormat fileformat;
+    DcmDataset *dataset = fileformat.getDataset();
+    Uint8 pixels[64];
+    for (size_t i = 0; i < sizeof(pixels); i++)
+        pixels[i] = OFstatic_cast(Uint8, i / 4);
+    return dataset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage).good()
+        && dataset->putAndInsertString(DCM_SOPInstanceUID, SOP_INSTANCE_UID).good()
+        && dataset->putAndInsertUint16(DCM_SamplesPerPixel, 1).good()
+        && dataset->putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2").good()
+        && dataset->putAndInsertUint16(DCM_Rows, 8).good()
+        && dataset->putAndInsertUint16(DCM_Columns, 8).good()
+        && dataset->putAndInsertUint16(DCM_BitsAllocated, 8).good()
+        && dataset->putAndInsertUint16(DCM_BitsStored, 8).good()
+        && dataset->putAndInsertUint16(DCM_HighBit, 7).good()
+        && dataset->putAndInsertUint16(DCM_PixelRepresentation, 0).good()
+        && dataset->putAndInsertUint8Array(DCM_PixelData, pixels, sizeof(pixels)).good()
+        && dataset->chooseRepresentation(xfer, NULL).good()
+        && fileformat.saveFile(filename, xfer).good();
+}
+
+// create association parameters with one accepted presentation context per transfer syntax
+static OFBool createAssociation(T_ASC_Association& assoc, const E_TransferSyntax *xfers, const size_t count)
+{
+    memset(&assoc, 0, sizeof(assoc));
+    if (ASC_createAssociationParameters(&assoc.params, ASC_DEFAULTMAXPDU, 30).bad())
+        return OFFalse;
+    for (size_t i = 0; i < count; i++)
+    {
+        const T_ASC_PresentationContextID presId = OFstatic_cast(T_ASC_PresentationContextID, 2 * i + 1);
+        const char *xferUID = DcmXfer(xfers[i]).getXferID();
+        if (ASC_addPresentationContext(assoc.params, presId, UID_SecondaryCaptureImageStorage, &xferUID, 1).bad()
+            || ASC_acceptPresentationContext(assoc.params, presId, xferUID).bad())
+        {
+            return OFFalse;
+        }
+    }
+    return OFTrue;
+}
+
+// prepare the sub-operation for the given file and check the selected transfer syntax
+static void checkSubOperation(T_ASC_Association& assoc,
+                              const OFFilename& filename,
+                              const E_TransferSyntax expectedXfer,
+                              const T_ASC_PresentationContextID expectedPresId)
+{
+    DcmQueryRetrieveTranscoder transcoder(&assoc, OFList<OFString>(), 0 /* no background thread */);
+    transcoder.addSubOperation(UID_SecondaryCaptureImageStorage, SOP_INSTANCE_UID, filename.getCharPointer());
+    DcmQueryRetrieveSubOperation *subOp = transcoder.nextSubOperation();
+    OFCHECK(subOp != NULL);
+    if (subOp != NULL)
+    {
+        OFCHECK_MSG(subOp->status.good(), subOp->status.text());
+        OFCHECK_EQUAL(subOp->networkXfer, expectedXfer);
+        OFCHECK_EQUAL(OFstatic_cast(int, subOp->presId), OFstatic_cast(int, expectedPresId));
+        delete subOp;
+    }
+}
+
+OFTEST(dcmqrdb_transcoder_sameEncoding)
+{
+    OFTempFile tempFile(O_RDWR, "", "dcmqrdb_", ".dcm");
+    OFCHECK(createImageFile(tempFile.getFilename(), EXS_LittleEndianExplicit));
+    /* all contexts have the same rank, the one not requiring a conversion is used */
+    const E_TransferSyntax xfers[] = { EXS_RLELossless, EXS_LittleEndianImplicit };
+    T_ASC_Association assoc;
+    OFCHECK(createAssociation(assoc, xfers, 2));
+    checkSubOperation(assoc, tempFile.getFilename(), EXS_LittleEndianImplicit, 3);
+    ASC_destroyAssociationParameters(&assoc.params);
+}
+
+OFTEST(dcmqrdb_transcoder_sameRank)
+{
+    DcmRLEEncoderRegistration::registerCodecs();
+    DcmRLEDecoderRegistration::registerCodecs();
+    OFTempFile tempFile(O_RDWR, "", "dcmqrdb_", ".dcm");
+    OFCHECK(createImageFile(tempFile.getFilename(), EXS_RLELossless));
+    /* all contexts have the same rank (no preferences): the lossy one is never
+     * used for conversion, converting to JPEG-LS fails (no codec registered),
+     * so the uncompressed one has to be used
+     */
+    const E_TransferSyntax xfers[] = { EXS_JPEGProcess1, EXS_JPEGLSLossless, EXS_LittleEndianExplicit };
+    T_ASC_Association assoc;
+    OFCHECK(createAssociation(assoc, xfers, 3));
+    checkSubOperation(assoc, tempFile.getFilename(), EXS_LittleEndianExplicit, 5);
+    ASC_destroyAssociationParameters(&assoc.params);
+    DcmRLEEncoderRegistration::cleanup();
+    DcmRLEDecoderRegistration::cleanup();
+}
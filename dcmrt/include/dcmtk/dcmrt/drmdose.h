@@ -117,7 +117,8 @@ public:
      */
     virtual OFCondition getUnscaledDose(double &result, unsigned int x, unsigned int y, unsigned int frame = 0) const;
 
-    /** get the dose information for a single frame of the image.
+    /** get the dose information for a single frame of the image. Only the
+     *  pixel data of the requested frame is read.
      *  @param result after this function returns successfully, this will be set
      *                to an array with getDoseImageWidth() * getDoseImageHeight()
      *                entries, one for each pixel in the frame. However, when an
@@ -140,6 +141,38 @@ public:
      */
     virtual OFCondition getDoseImages(OFVector<OFVector<double> > &result) const;
 
+    /** get the number of dose values in the whole image, i.e.\ the number of
+     *  entries needed for the buffer passed to getDoseVolume().
+     *  @return getNumberOfFrames() * getDoseImageHeight() * getDoseImageWidth()
+     *          or 0 if an error occurred.
+     */
+    virtual size_t getDoseVolumeSize() const;
+
+    /** get the dose information for the whole image in a single pass. The dose
+     *  grid scaling and the pixel data are only accessed once, and the dose values
+     *  are stored in a caller-provided contiguous buffer. This is much faster than
+     *  getDose() for each pixel, e.g.\ when computing a DVH.
+     *  @param result pointer to a buffer with at least getDoseVolumeSize() entries.
+     *                After this function returns successfully, the frames are
+     *                stored one after another in this buffer, the pixels of each
+     *                frame row by row (i.e.\ the same order as the pixel data).
+     *  @param count  number of entries in the buffer
+     *  @return status, EC_Normal if successful, an error code otherwise
+     *  @see getDoseType() and getDoseUnits() for the meaning of dose values.
+     */
+    virtual OFCondition getDoseVolume(double *result, size_t count) const;
+
+    /** get the dose information for the whole image in a single pass, see
+     *  getDoseVolume(double *, size_t) for details. The scaling is done in
+     *  double precision and only the resulting dose values are converted to
+     *  single precision, which halves the memory needed.
+     *  @param result pointer to a buffer with at least getDoseVolumeSize() entries
+     *  @param count  number of entries in the buffer
+     *  @return status, EC_Normal if successful, an error code otherwise
+     *  @see getDoseType() and getDoseUnits() for the meaning of dose values.
+     */
+    virtual OFCondition getDoseVolume(float *result, size_t count) const;
+
     /** get the width in pixel of the dose image
      *  @return the width of the dose image
      */
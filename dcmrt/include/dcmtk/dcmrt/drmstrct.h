@@ -37,6 +37,34 @@
 class DCMTK_DCMRT_EXPORT DRTStructureSet : public DRTStructureSetIOD
 {
 public:
+    /** all contours of a region of interest as a structure of arrays, i.e.\ the
+     *  coordinates of all contour points are stored in three contiguous arrays.
+     *  The points of contour i are stored at the indexes ContourOffsets[i] up to
+     *  ContourOffsets[i + 1] - 1 of X, Y and Z.
+     */
+    struct ROIContourPoints
+    {
+        /// x coordinates of all contour points (in mm, patient based coordinate system)
+        OFVector<Float64> X;
+        /// y coordinates of all contour points (in mm, patient based coordinate system)
+        OFVector<Float64> Y;
+        /// z coordinates of all contour points (in mm, patient based coordinate system)
+        OFVector<Float64> Z;
+        /// index of the first point of each contour, followed by the total number of points
+        OFVector<size_t> ContourOffsets;
+        /// contour geometric type of each contour, e.g.\ "CLOSED_PLANAR"
+        OFVector<OFString> ContourGeometricTypes;
+
+        /** remove all contours
+         */
+        void clear();
+
+        /** get number of contours
+         *  @return number of contours
+         */
+        size_t getNumberOfContours() const;
+    };
+
     /** load an object from a file
      *  @param fileName name of the file to load (may contain wide chars if support enabled).
      *    Since there are various constructors for the OFFilename class, a "char *", "OFString"
@@ -91,6 +119,19 @@ public:
      *  @return status, EC_Normal if successful, an error code otherwise
      */
     OFCondition getContoursForROINumber(OFList<DRTROIContourSequence::Item*> result, Sint32 roiNumber);
+
+    /** get the points of all contours for a region of interest in a single pass.
+     *  The contour data of all items of the ROI Contour Sequence referencing the
+     *  given ROI number is converted without creating intermediate objects per
+     *  coordinate, which is much faster than calling getContourData() for each
+     *  coordinate.
+     *  @param result structure for storing the contour points (cleared first)
+     *  @param roiNumber ROI number to look for
+     *  @return status, EC_Normal if successful, an error code otherwise. If the
+     *          number of values of a Contour Data element is not a multiple of 3,
+     *          RT_EC_InvalidValue is returned.
+     */
+    OFCondition getContourPointsForROINumber(ROIContourPoints &result, Sint32 roiNumber);
 };
 
 #endif
@@ -0,0 +1,227 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmrt
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Helper classes for reading sequences of IOD classes on first access
+ *
+ */
+
+
+#ifndef DRTLAZY_H
+#define DRTLAZY_H
+
+#include "dcmtk/config/osconfig.h"   /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmrt/drttypes.h"
+#include "dcmtk/ofstd/ofmem.h"
+
+
+/** Base class of DRTLazyIOD that does not depend on the IOD class. It keeps the
+ *  source dataset and records which sequences have been read from it.
+ */
+class DCMTK_DCMRT_EXPORT DRTLazyReader
+{
+
+  public:
+
+    /** default constructor
+     */
+    DRTLazyReader();
+
+    /** destructor
+     */
+    virtual ~DRTLazyReader();
+
+    /** get the source dataset from which the sequences are read
+     *  @return shared pointer to the source dataset, NULL if none
+     */
+    const OFshared_ptr<DcmItem> &getSource() const;
+
+
+  protected:
+
+    /** set the source dataset and forget about all sequences read before
+     *  @param  dataset  shared pointer to the source dataset
+     */
+    void setSource(const OFshared_ptr<DcmItem> &dataset);
+
+    /** move all sequences from one dataset to another one. The elements are
+     *  removed from the first dataset and inserted into the second one without
+     *  copying them.
+     *  @param  source  dataset from which the sequences are removed
+     *  @param  target  dataset into which the sequences are inserted
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    static OFCondition moveSequences(DcmItem &source, DcmItem &target);
+
+    /** insert copies of all sequences of one dataset into another one. All
+     *  other elements (e.g.\ the pixel data) are not copied.
+     *  @param  source  dataset from which the sequences are copied
+     *  @param  target  dataset into which the copies are inserted
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    static OFCondition copySequences(DcmItem &source, DcmItem &target);
+
+    /** check whether the given sequence has already been read and record it as
+     *  being read if not
+     *  @param  sequence  pointer to the sequence object (member of the IOD class)
+     *  @return OFTrue if the sequence has to be read now, OFFalse otherwise
+     */
+    OFBool markSequenceRead(const void *sequence);
+
+
+  private:
+
+    /// source dataset, shared with the caller
+    OFshared_ptr<DcmItem> Source;
+
+    /// sequence objects that have already been read from the source dataset
+    OFVector<const void *> ReadSequences;
+
+    // --- declarations to avoid compiler warnings
+
+    DRTLazyReader(const DRTLazyReader &);
+    DRTLazyReader &operator=(const DRTLazyReader &);
+};
+
+
+/** Read-only view of an RT IOD (e.g.\ DRTPlanIOD) that reads the sequences of
+ *  the IOD on first access. All attributes that are not sequences are read
+ *  immediately by read(). Each sequence is only read from the source dataset
+ *  when it is accessed through getSequence() for the first time, so opening a
+ *  large plan in order to check a few attributes does not build the complete
+ *  beam, control point and fraction group object trees. Please note that
+ *  mandatory sequences (type 1 or 2) are reported as absent when the IOD is
+ *  read, and that sequences are read on first access without checking their
+ *  type and number of items.
+ *  The source dataset is shared with the caller (or a copy of its sequences is
+ *  created by read()), so it remains valid as long as this object exists. The
+ *  source dataset must not be modified while this object is used. All other
+ *  attributes are read directly from the given dataset, so large values such as
+ *  the pixel data are only copied into the IOD.
+ *  @note As the IOD classes themselves, this class is not thread-safe. Reading
+ *    a sequence on first access modifies this object, so getSequence() is not
+ *    a const method.
+ *  @tparam  IOD  RT IOD class, e.g.\ DRTPlanIOD
+ */
+template<typename IOD>
+class DRTLazyIOD : public DRTLazyReader
+{
+
+  public:
+
+    /** default constructor
+     */
+    DRTLazyIOD()
+      : DRTLazyReader(),
+        Object()
+    {
+    }
+
+    /** destructor
+     */
+    virtual ~DRTLazyIOD()
+    {
+    }
+
+    /** read all attributes that are not sequences from the given dataset.
+     *  The dataset is shared with the caller, sequences are read from it on
+     *  first access. While reading, the sequences are temporarily removed from
+     *  the dataset.
+     *  @param  dataset  shared pointer to the source dataset, must not be NULL
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition read(const OFshared_ptr<DcmItem> &dataset)
+    {
+        Object.clear();
+        setSource(dataset);
+        if (!dataset)
+            return EC_IllegalParameter;
+        return readAttributes(*dataset);
+    }
+
+    /** read all attributes that are not sequences from the given dataset.
+     *  Only the sequences are copied, they are read from the copy on first
+     *  access. All other attributes (e.g.\ the pixel data) are not copied more
+     *  than once, i.e.\ into the IOD.
+     *  @param  dataset  reference to the source dataset
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition read(DcmItem &dataset)
+    {
+        Object.clear();
+        OFshared_ptr<DcmItem> sequences(new DcmItem);
+        setSource(sequences);
+        OFCondition result = copySequences(dataset, *sequences);
+        if (result.good())
+            result = readAttributes(dataset);
+        return result;
+    }
+
+    /** get the IOD with all attributes that are not sequences and all sequences
+     *  that have been accessed with getSequence() so far
+     *  @return reference to the IOD
+     */
+    const IOD &getIOD() const
+    {
+        return Object;
+    }
+
+    /** get a sequence of the IOD, read it from the source dataset on first access.
+     *  Example: getSequence(&DRTPlanIOD::getBeamSequence)
+     *  @param  getter  non-const getter method of the IOD class for the sequence
+     *  @return reference to the sequence
+     */
+    template<typename S>
+    const S &getSequence(S &(IOD::*getter)())
+    {
+        S &sequence = (Object.*getter)();
+        if (markSequenceRead(&sequence) && getSource())
+        {
+            /* errors are reported to the logger by the sequence class */
+            sequence.read(*getSource(), "1-n", "3", "RT object");
+        }
+        return sequence;
+    }
+
+
+  private:
+
+    /** read all attributes that are not sequences directly from the given
+     *  dataset. The sequences are temporarily moved out of the dataset, so
+     *  that they are not read by the IOD, and moved back afterwards.
+     *  @param  dataset  dataset to read from
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition readAttributes(DcmItem &dataset)
+    {
+        DcmItem sequences;
+        OFCondition result = moveSequences(dataset, sequences);
+        if (result.good())
+            result = Object.read(dataset);
+        /* always move the sequences back, even if reading failed */
+        const OFCondition status = moveSequences(sequences, dataset);
+        if (result.good())
+            result = status;
+        return result;
+    }
+
+    /// the IOD
+    IOD Object;
+};
+
+
+#endif
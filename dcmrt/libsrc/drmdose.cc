@@ -44,15 +44,6 @@ public:
         }
     }
 
-    OFCondition getScaledPixels(OFVector<double> &result, double scaling, Uint32 offset, Uint32 length)
-    {
-        if (pixelRep_ == 1) {
-            return getScaledPixelsSigned(result, scaling, offset, length);
-        } else {
-            return getScaledPixelsUnsigned(result, scaling, offset, length);
-        }
-    }
-
 protected:
     // This is supposed to be a template, because getPixelUnsigned has the same
     // code, just a different type. MSC6 doesn't support member function templates.
@@ -72,54 +63,6 @@ protected:
         return result;
     }
 
-    // This is supposed to be a template, because getScaledPixelsUnsigned has the same
-    // code, just a different type. MSC6 doesn't support member function templates.
-    OFCondition getScaledPixelsSigned(OFVector<double> &result, double scaling, Uint32 offset, Uint32 length)
-    {
-        OFCondition cond = EC_Normal;
-        signedT* tmp = new signedT[length];
-        if (!tmp) {
-            cond = EC_MemoryExhausted;
-        } else {
-            // First, get the "raw" pixel data
-            cond = pixelData_.getPartialValue(tmp, OFstatic_cast(Uint32, offset * sizeof(signedT)), OFstatic_cast(Uint32, length * sizeof(signedT)));
-            if (cond.good()) {
-                result.clear();
-                result.reserve(length);
-                // Now convert it to double
-                for (Uint32 i = 0; i < length; i++) {
-                    result.push_back(scaling * tmp[i]);
-                }
-            }
-            delete[] tmp;
-        }
-
-        return cond;
-    }
-
-    OFCondition getScaledPixelsUnsigned(OFVector<double> &result, double scaling, Uint32 offset, Uint32 length)
-    {
-        OFCondition cond = EC_Normal;
-        unsignedT* tmp = new unsignedT[length];
-        if (!tmp) {
-            cond = EC_MemoryExhausted;
-        } else {
-            // First, get the "raw" pixel data
-            cond = pixelData_.getPartialValue(tmp, OFstatic_cast(Uint32, offset * sizeof(unsignedT)), OFstatic_cast(Uint32, length * sizeof(unsignedT)));
-            if (cond.good()) {
-                result.clear();
-                result.reserve(length);
-                // Now convert it to double
-                for (Uint32 i = 0; i < length; i++) {
-                    result.push_back(scaling * tmp[i]);
-                }
-            }
-            delete[] tmp;
-        }
-
-        return cond;
-    }
-
 private:
     DcmPixelData &pixelData_;
     Uint16 pixelRep_;
@@ -214,6 +157,114 @@ static OFCondition getImageParameters(const DRTDose& dose, Uint32& frames, Uint1
     return cond;
 }
 
+/* Get everything needed for converting a range of dose values, i.e. the image
+ * parameters and the dose grid scaling. Only 16 and 32 bit images are accepted.
+ */
+static OFCondition getDoseParameters(const DRTDose& dose, Uint32& frames, size_t& frameSize, Uint16& bitsAllocated, Uint16& pixelRep, double& scaling)
+{
+    Uint16 rows, columns;
+    OFCondition cond = getImageParameters(dose, frames, rows, columns, bitsAllocated, pixelRep);
+    if (cond.good())
+        cond = dose.getDoseGridScaling(scaling);
+    if (cond.good() && bitsAllocated != 16 && bitsAllocated != 32)
+    {
+        /* RT Dose Images may only have 16 or 32 bits stored */
+        DCMRT_ERROR("Invalid value for BitsAllocated (" << bitsAllocated << "), only 16 and 32 allowed");
+        cond = RT_EC_InvalidValue;
+    }
+    if (cond.good())
+        frameSize = OFstatic_cast(size_t, rows) * columns;
+    return cond;
+}
+
+/* Like getDoseParameters(), but additionally get a pointer to the complete
+ * pixel data (in local byte order). This loads all frames into memory, so it
+ * should only be used when all of them are needed anyway. The pixel data is
+ * checked to contain all frames.
+ */
+static OFCondition getDoseValues(const DRTDose& dose, const void*& pixels, Uint32& frames, size_t& frameSize, Uint16& bitsAllocated, Uint16& pixelRep, double& scaling)
+{
+    OFCondition cond = getDoseParameters(dose, frames, frameSize, bitsAllocated, pixelRep, scaling);
+    if (cond.bad())
+        return cond;
+
+    /* We cast away the const so that we get a nicer API where stuff can be const */
+    DcmPixelData& pixelData = OFconst_cast(DcmPixelData&, dose.getPixelData());
+    Uint16* words = NULL;
+    cond = pixelData.getUint16Array(words);
+    if (cond.good() && (words == NULL || pixelData.getLength() / (bitsAllocated / 8) < frameSize * frames))
+    {
+        DCMRT_ERROR("Pixel data does not contain " << frames << " frames of " << frameSize << " pixels");
+        cond = RT_EC_InvalidValue;
+    }
+    if (cond.good())
+        pixels = words;
+    return cond;
+}
+
+/* Convert a range of dose values. This is a simple loop without any function
+ * calls, so that it can be vectorized by the compiler. The scaling is always
+ * done in double precision, only the result is narrowed to resultT.
+ */
+template<typename sourceT, typename resultT>
+static void scaleDoseValues(const sourceT* source, resultT* result, size_t count, double scaling)
+{
+    for (size_t i = 0; i < count; i++)
+        result[i] = OFstatic_cast(resultT, scaling * source[i]);
+}
+
+template<typename resultT>
+static void scaleDoseValues(const void* pixels, Uint16 bitsAllocated, Uint16 pixelRep, size_t offset, size_t count, resultT* result, double scaling)
+{
+    if (bitsAllocated == 16) {
+        if (pixelRep == 1)
+            scaleDoseValues(OFstatic_cast(const Sint16*, pixels) + offset, result, count, scaling);
+        else
+            scaleDoseValues(OFstatic_cast(const Uint16*, pixels) + offset, result, count, scaling);
+    } else {
+        if (pixelRep == 1)
+            scaleDoseValues(OFstatic_cast(const Sint32*, pixels) + offset, result, count, scaling);
+        else
+            scaleDoseValues(OFstatic_cast(const Uint32*, pixels) + offset, result, count, scaling);
+    }
+}
+
+/* Read and convert a range of dose values without loading the complete pixel
+ * data into memory. Only the requested values are read into a temporary buffer.
+ */
+template<typename sourceT>
+static OFCondition getScaledPartialDoseValues(const DRTDose& dose, size_t offset, size_t count, double* result, double scaling)
+{
+    OFVector<sourceT> tmp(count);
+    /* We cast away the const so that we get a nicer API where stuff can be const */
+    DcmPixelData& pixelData = OFconst_cast(DcmPixelData&, dose.getPixelData());
+    OFCondition cond = pixelData.getPartialValue(&tmp[0], OFstatic_cast(Uint32, offset * sizeof(sourceT)), OFstatic_cast(Uint32, count * sizeof(sourceT)));
+    if (cond.good())
+        scaleDoseValues(&tmp[0], result, count, scaling);
+    return cond;
+}
+
+template<typename resultT>
+static OFCondition getDoseVolume(const DRTDose& dose, resultT* result, size_t count)
+{
+    const void* pixels = NULL;
+    Uint32 frames;
+    size_t frameSize;
+    Uint16 bitsAllocated, pixelRep;
+    double doseGridScaling = 0.0;
+    OFCondition cond = getDoseValues(dose, pixels, frames, frameSize, bitsAllocated, pixelRep, doseGridScaling);
+    if (cond.bad())
+        return cond;
+
+    const size_t length = frameSize * frames;
+    if (result == NULL || count < length)
+        return EC_IllegalParameter;
+
+    DCMRT_TRACE("Getting dose volume with " << frames << " frames (length=" << length << ")");
+    scaleDoseValues(pixels, bitsAllocated, pixelRep, 0, length, result, doseGridScaling);
+    return EC_Normal;
+}
+
 OFCondition DRTDose::getUnscaledDose(double &result, unsigned int x, unsigned int y, unsigned int frame) const
 {
     Uint32 frames;
@@ -248,66 +299,85 @@ OFCondition DRTDose::getUnscaledDose(double &result, unsigned int x, unsigned in
 OFCondition DRTDose::getDoseImage(OFVector<double> &result, unsigned int frame) const
 {
     Uint32 frames;
-    Uint32 offset, length;
-    Uint16 rows, columns, bitsAllocated, pixelRep;
+    size_t length;
+    Uint16 bitsAllocated, pixelRep;
     double doseGridScaling = 0.0;
-    OFCondition cond = EC_Normal;
 
     result.clear();
 
-    cond = getImageParameters(*this, frames, rows, columns, bitsAllocated, pixelRep);
-    if (cond.good())
-        cond = getDoseGridScaling(doseGridScaling);
+    OFCondition cond = getDoseParameters(*this, frames, length, bitsAllocated, pixelRep, doseGridScaling);
     if (cond.bad())
         return cond;
 
     if (frame >= frames)
         return EC_IllegalParameter;
 
-    length = columns * rows;
-    offset = frame * length;
+    const size_t offset = frame * length;
     DCMRT_TRACE("Getting dose image for frame " << frame << " (offset=" << offset << ", length=" << length << ")");
 
-    if (bitsAllocated == 16) {
-        DCMRT_TRACE("Dose image uses 16 bit per pixel");
-        PixelDataAccess<Sint16, Uint16> pixel(getPixelData(), pixelRep);
-        cond = pixel.getScaledPixels(result, doseGridScaling, offset, length);
-    } else if (bitsAllocated == 32) {
-        DCMRT_TRACE("Dose image uses 32 bit per pixel");
-        PixelDataAccess<Sint32, Uint32> pixel(getPixelData(), pixelRep);
-        cond = pixel.getScaledPixels(result, doseGridScaling, offset, length);
-    } else {
-        /* RT Dose Images may only have 16 or 32 bits stored */
-        DCMRT_ERROR("Invalid value for BitsAllocated (" << bitsAllocated << "), only 16 and 32 allowed");
-        cond = RT_EC_InvalidValue;
+    if (length > 0) {
+        result.resize(length);
+        /* Only read the requested frame, the other frames might not be loaded yet */
+        if (bitsAllocated == 16) {
+            if (pixelRep == 1)
+                cond = getScaledPartialDoseValues<Sint16>(*this, offset, length, &result[0], doseGridScaling);
+            else
+                cond = getScaledPartialDoseValues<Uint16>(*this, offset, length, &result[0], doseGridScaling);
+        } else {
+            if (pixelRep == 1)
+                cond = getScaledPartialDoseValues<Sint32>(*this, offset, length, &result[0], doseGridScaling);
+            else
+                cond = getScaledPartialDoseValues<Uint32>(*this, offset, length, &result[0], doseGridScaling);
+        }
+        if (cond.bad())
+            result.clear();
     }
-
     return cond;
 }
 
 OFCondition DRTDose::getDoseImages(OFVector<OFVector<double> > &result) const
 {
-    Sint32 frames, i;
-    OFCondition cond = getNumberOfFrames(frames);
+    const void* pixels = NULL;
+    Uint32 frames;
+    size_t length;
+    Uint16 bitsAllocated, pixelRep;
+    double doseGridScaling = 0.0;
 
-    if (cond.good() && frames < 0)
-    {
-        DCMRT_ERROR("Invalid value for NumberOfFrames (" << frames << "), must be positive");
-        cond = EC_IllegalParameter;
-    }
-    if (cond.good())
-        result.resize(frames);
+    result.clear();
+
+    /* All frames are needed, so access the complete pixel data at once */
+    OFCondition cond = getDoseValues(*this, pixels, frames, length, bitsAllocated, pixelRep, doseGridScaling);
+    if (cond.bad())
+        return cond;
 
-    for (i = 0; i < frames; i++)
+    result.resize(frames);
+    for (Uint32 i = 0; i < frames; i++)
     {
-        if (cond.good())
-            cond = getDoseImage(result[i], i);
+        if (length > 0) {
+            result[i].resize(length);
+            scaleDoseValues(pixels, bitsAllocated, pixelRep, i * length, length, &result[i][0], doseGridScaling);
+        }
     }
+    return EC_Normal;
+}
 
-    if (cond.bad())
-        result.clear();
+size_t DRTDose::getDoseVolumeSize() const
+{
+    Uint32 frames;
+    Uint16 rows, columns, bitsAllocated, pixelRep;
+    if (getImageParameters(*this, frames, rows, columns, bitsAllocated, pixelRep).bad())
+        return 0;
+    return OFstatic_cast(size_t, frames) * rows * columns;
+}
 
-    return cond;
+OFCondition DRTDose::getDoseVolume(double *result, size_t count) const
+{
+    return ::getDoseVolume(*this, result, count);
+}
+
+OFCondition DRTDose::getDoseVolume(float *result, size_t count) const
+{
+    return ::getDoseVolume(*this, result, count);
 }
 
 Uint16 DRTDose::getDoseImageWidth() const
@@ -120,3 +120,65 @@ OFCondition DRTStructureSet::getContoursForROINumber(OFList<DRTROIContourSequenc
 
     return EC_Normal;
 }
+
+void DRTStructureSet::ROIContourPoints::clear()
+{
+    X.clear();
+    Y.clear();
+    Z.clear();
+    ContourOffsets.clear();
+    ContourGeometricTypes.clear();
+}
+
+size_t DRTStructureSet::ROIContourPoints::getNumberOfContours() const
+{
+    return ContourGeometricTypes.size();
+}
+
+OFCondition DRTStructureSet::getContourPointsForROINumber(ROIContourPoints &result, Sint32 roiNumber)
+{
+    DRTROIContourSequence& seq = getROIContourSequence();
+    OFCondition cond = seq.gotoFirstItem();
+    OFVector<Float64> contourData;
+    OFString geometricType;
+
+    // Go through all items in the sequence...
+    result.clear();
+    result.ContourOffsets.push_back(0);
+    while (cond.good()) {
+        Sint32 number;
+        DRTROIContourSequence::Item& item = seq.getCurrentItem();
+        cond = item.getReferencedROINumber(number);
+        if (cond.bad())
+            return cond;
+        // ...looking for items with the wanted roiNumber
+        if (number == roiNumber) {
+            DRTContourSequence& contourSeq = item.getContourSequence();
+            OFCondition contourCond = contourSeq.gotoFirstItem();
+            // ...and append the points of all their contours
+            while (contourCond.good()) {
+                DRTContourSequence::Item& contour = contourSeq.getCurrentItem();
+                cond = contour.getContourData(contourData);
+                if (cond.bad())
+                    return cond;
+                const size_t numValues = contourData.size();
+                if (numValues % 3 != 0) {
+                    DCMRT_ERROR("Invalid number of values in ContourData (" << numValues << "), must be a multiple of 3");
+                    return RT_EC_InvalidValue;
+                }
+                for (size_t i = 0; i < numValues; i += 3) {
+                    result.X.push_back(contourData[i]);
+                    result.Y.push_back(contourData[i + 1]);
+                    result.Z.push_back(contourData[i + 2]);
+                }
+                contour.getContourGeometricType(geometricType);
+                result.ContourGeometricTypes.push_back(geometricType);
+                result.ContourOffsets.push_back(result.X.size());
+                contourCond = contourSeq.gotoNextItem();
+            }
+        }
+        cond = seq.gotoNextItem();
+    }
+
+    return EC_Normal;
+}
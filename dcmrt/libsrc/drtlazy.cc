@@ -0,0 +1,98 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmrt
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Helper classes for reading sequences of IOD classes on first access
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"     /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmrt/drtlazy.h"
+
+
+DRTLazyReader::DRTLazyReader()
+  : Source(),
+    ReadSequences()
+{
+}
+
+
+DRTLazyReader::~DRTLazyReader()
+{
+}
+
+
+const OFshared_ptr<DcmItem> &DRTLazyReader::getSource() const
+{
+    return Source;
+}
+
+
+void DRTLazyReader::setSource(const OFshared_ptr<DcmItem> &dataset)
+{
+    Source = dataset;
+    ReadSequences.clear();
+}
+
+
+OFCondition DRTLazyReader::moveSequences(DcmItem &source, DcmItem &target)
+{
+    OFCondition status = EC_Normal;
+    unsigned long i = 0;
+    while ((i < source.card()) && status.good())
+    {
+        DcmElement *element = source.getElement(i);
+        if ((element != NULL) && (element->ident() == EVR_SQ))
+        {
+            /* the element is only moved, not copied */
+            source.remove(i);
+            status = target.insert(element);
+            if (status.bad())
+                delete element;
+        } else
+            i++;
+    }
+    return status;
+}
+
+
+OFCondition DRTLazyReader::copySequences(DcmItem &source, DcmItem &target)
+{
+    OFCondition status = EC_Normal;
+    const unsigned long count = source.card();
+    for (unsigned long i = 0; (i < count) && status.good(); i++)
+    {
+        DcmElement *element = source.getElement(i);
+        if ((element != NULL) && (element->ident() == EVR_SQ))
+            status = target.insert(OFstatic_cast(DcmElement *, element->clone()));
+    }
+    return status;
+}
+
+
+OFBool DRTLazyReader::markSequenceRead(const void *sequence)
+{
+    /* the number of sequences per IOD is limited, so a linear search is sufficient */
+    for (OFVector<const void *>::const_iterator it = ReadSequences.begin(); it != ReadSequences.end(); ++it)
+    {
+        if (*it == sequence)
+            return OFFalse;
+    }
+    ReadSequences.push_back(sequence);
+    return OFTrue;
+}
@@ -0,0 +1,167 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmrt
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for the bulk dose and contour access
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmrt/drmdose.h"
+#include "dcmtk/dcmrt/drmstrct.h"
+
+
+OFTEST(dcmrt_doseVolume)
+{
+    const Uint16 rows = 3;
+    const Uint16 columns = 4;
+    const size_t numPixels = 2 * rows * columns;
+    Uint16 pixels[numPixels];
+    for (size_t i = 0; i < numPixels; i++)
+        pixels[i] = OFstatic_cast(Uint16, i * 100);
+
+    DRTDose dose;
+    OFCHECK(dose.setRows(rows).good());
+    OFCHECK(dose.setColumns(columns).good());
+    OFCHECK(dose.setNumberOfFrames("2").good());
+    OFCHECK(dose.setBitsAllocated(16).good());
+    OFCHECK(dose.setBitsStored(16).good());
+    OFCHECK(dose.setHighBit(15).good());
+    OFCHECK(dose.setPixelRepresentation(0).good());
+    OFCHECK(dose.setDoseGridScaling("0.5").good());
+    OFCHECK(dose.getPixelData().putUint16Array(pixels, numPixels).good());
+    OFCHECK_EQUAL(dose.getDoseVolumeSize(), numPixels);
+
+    // same values as with the per-pixel and per-frame access
+    double doubleVolume[numPixels];
+    float floatVolume[numPixels];
+    OFCHECK(dose.getDoseVolume(doubleVolume, numPixels).good());
+    OFCHECK(dose.getDoseVolume(floatVolume, numPixels).good());
+    OFVector<OFVector<double> > images;
+    OFCHECK(dose.getDoseImages(images).good());
+    OFCHECK_EQUAL(images.size(), 2);
+    for (size_t i = 0; i < numPixels; i++)
+    {
+        const unsigned int frame = OFstatic_cast(unsigned int, i / (rows * columns));
+        const unsigned int pixel = OFstatic_cast(unsigned int, i % (rows * columns));
+        OFCHECK_EQUAL(doubleVolume[i], i * 50.0);
+        OFCHECK_EQUAL(floatVolume[i], i * 50.0f);
+        OFCHECK_EQUAL(dose.getDose(pixel % columns, pixel / columns, frame), doubleVolume[i]);
+        if (images.size() == 2)
+            OFCHECK_EQUAL(images[frame][pixel], doubleVolume[i]);
+    }
+
+    // single frame only reads the pixel data of that frame
+    OFVector<double> image;
+    OFCHECK(dose.getDoseImage(image, 1).good());
+    OFCHECK_EQUAL(image.size(), rows * columns);
+    for (size_t i = 0; i < image.size() && images.size() == 2; i++)
+        OFCHECK_EQUAL(image[i], images[1][i]);
+    OFCHECK(dose.getDoseImage(image, 2).bad());
+    OFCHECK(image.empty());
+
+    // buffer too small
+    OFCHECK(dose.getDoseVolume(doubleVolume, numPixels - 1).bad());
+
+    // single precision results are scaled in double precision
+    for (size_t i = 0; i < numPixels; i++)
+        pixels[i] = OFstatic_cast(Uint16, i * 2731);
+    double scaling = 0.0;
+    OFCHECK(dose.setDoseGridScaling("0.123456789").good());
+    OFCHECK(dose.getDoseGridScaling(scaling).good());
+    OFCHECK(dose.getPixelData().putUint16Array(pixels, numPixels).good());
+    OFCHECK(dose.getDoseVolume(floatVolume, numPixels).good());
+    for (size_t i = 0; i < numPixels; i++)
+        OFCHECK_EQUAL(floatVolume[i], OFstatic_cast(float, scaling * pixels[i]));
+    OFCHECK(dose.setDoseGridScaling("0.5").good());
+
+    // signed pixel data
+    pixels[0] = OFstatic_cast(Uint16, -10);
+    OFCHECK(dose.setPixelRepresentation(1).good());
+    OFCHECK(dose.getPixelData().putUint16Array(pixels, numPixels).good());
+    OFCHECK(dose.getDoseVolume(doubleVolume, numPixels).good());
+    OFCHECK_EQUAL(doubleVolume[0], -5.0);
+
+    // not enough pixel data for all frames
+    OFCHECK(dose.getPixelData().putUint16Array(pixels, numPixels - 1).good());
+    OFCHECK(dose.getDoseVolume(doubleVolume, numPixels).bad());
+}
+
+
+// add contour with given type and data to ROI contour item
+static void addContour(DRTROIContourSequence::Item &roiContour, const char *type, const char *data, const OFBool check = OFTrue)
+{
+    DRTContourSequence::Item *contour = NULL;
+    OFCHECK(roiContour.getContourSequence().addItem(contour).good());
+    if (contour != NULL)
+    {
+        OFCHECK(contour->setContourGeometricType(type).good());
+        OFCHECK(contour->setContourData(data, check).good());
+    }
+}
+
+
+OFTEST(dcmrt_contourPoints)
+{
+    DRTStructureSet structureSet;
+    DRTROIContourSequence &roiContourSequence = structureSet.getROIContourSequence();
+    DRTROIContourSequence::Item *item = NULL;
+    OFCHECK(roiContourSequence.addItem(item).good());
+    if (item != NULL)
+    {
+        OFCHECK(item->setReferencedROINumber("1").good());
+        addContour(*item, "CLOSED_PLANAR", "1\\2\\3\\4\\5\\6\\7\\8\\9");
+        addContour(*item, "POINT", "-1.5\\-2.5\\-3.5");
+    }
+    OFCHECK(roiContourSequence.addItem(item).good());
+    if (item != NULL)
+    {
+        OFCHECK(item->setReferencedROINumber("2").good());
+        addContour(*item, "POINT", "100\\200\\300");
+    }
+
+    DRTStructureSet::ROIContourPoints points;
+    OFCHECK(structureSet.getContourPointsForROINumber(points, 1).good());
+    OFCHECK_EQUAL(points.getNumberOfContours(), 2);
+    OFCHECK_EQUAL(points.X.size(), 4);
+    OFCHECK_EQUAL(points.ContourOffsets.size(), 3);
+    if ((points.X.size() == 4) && (points.ContourOffsets.size() == 3))
+    {
+        OFCHECK_EQUAL(points.ContourOffsets[0], 0);
+        OFCHECK_EQUAL(points.ContourOffsets[1], 3);
+        OFCHECK_EQUAL(points.ContourOffsets[2], 4);
+        OFCHECK_EQUAL(points.X[1], 4);
+        OFCHECK_EQUAL(points.Y[1], 5);
+        OFCHECK_EQUAL(points.Z[1], 6);
+        OFCHECK_EQUAL(points.X[3], -1.5);
+        OFCHECK_EQUAL(points.Y[3], -2.5);
+        OFCHECK_EQUAL(points.Z[3], -3.5);
+        OFCHECK_EQUAL(points.ContourGeometricTypes[0], "CLOSED_PLANAR");
+        OFCHECK_EQUAL(points.ContourGeometricTypes[1], "POINT");
+    }
+
+    // ROI without contours
+    OFCHECK(structureSet.getContourPointsForROINumber(points, 3).good());
+    OFCHECK_EQUAL(points.getNumberOfContours(), 0);
+    OFCHECK(points.X.empty());
+
+    // invalid number of coordinates
+    if (item != NULL)
+        addContour(*item, "OPEN_PLANAR", "1\\2\\3\\4", OFFalse /*check*/);
+    OFCHECK(structureSet.getContourPointsForROINumber(points, 2).bad());
+}
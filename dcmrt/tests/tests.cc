@@ -25,4 +25,8 @@
 
 OFTEST_REGISTER(dcmrt_search);
 OFTEST_REGISTER(dcmrt_contour);
+OFTEST_REGISTER(dcmrt_doseVolume);
+OFTEST_REGISTER(dcmrt_contourPoints);
+OFTEST_REGISTER(dcmrt_lazyReading);
+OFTEST_REGISTER(dcmrt_lazyReadingPixelData);
 OFTEST_MAIN("dcmrt")
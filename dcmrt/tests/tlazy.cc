@@ -0,0 +1,167 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmrt
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for reading sequences of IOD classes on first access
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmrt/drtplan.h"
+#include "dcmtk/dcmrt/drtdose.h"
+#include "dcmtk/dcmrt/drtlazy.h"
+
+
+// add beam with given number and name (and all type 1 attributes)
+static void addBeam(DcmDataset &dataset, const char *number, const char *name)
+{
+    DcmItem *item = NULL;
+    OFCHECK(dataset.findOrCreateSequenceItem(DCM_BeamSequence, item, -2).good());
+    if (item != NULL)
+    {
+        OFCHECK(item->putAndInsertString(DCM_BeamNumber, number).good());
+        OFCHECK(item->putAndInsertString(DCM_BeamName, name).good());
+        OFCHECK(item->putAndInsertString(DCM_BeamType, "STATIC").good());
+        OFCHECK(item->putAndInsertString(DCM_NumberOfWedges, "0").good());
+        OFCHECK(item->putAndInsertString(DCM_NumberOfCompensators, "0").good());
+        OFCHECK(item->putAndInsertString(DCM_NumberOfBoli, "0").good());
+        OFCHECK(item->putAndInsertString(DCM_NumberOfBlocks, "0").good());
+        OFCHECK(item->putAndInsertString(DCM_NumberOfControlPoints, "2").good());
+        DcmItem *controlPoint = NULL;
+        for (int i = 0; i < 2; i++)
+        {
+            OFCHECK(item->findOrCreateSequenceItem(DCM_ControlPointSequence, controlPoint, i).good());
+            if (controlPoint != NULL)
+                OFCHECK(controlPoint->putAndInsertString(DCM_ControlPointIndex, (i == 0) ? "0" : "1").good());
+        }
+    }
+}
+
+
+// create RT Plan dataset with two beams
+static void createPlan(DcmDataset &dataset)
+{
+    OFCHECK(dataset.putAndInsertString(DCM_SOPClassUID, UID_RTPlanStorage).good());
+    OFCHECK(dataset.putAndInsertString(DCM_SOPInstanceUID, "1.2.3.4.5").good());
+    OFCHECK(dataset.putAndInsertString(DCM_StudyInstanceUID, "1.2.3.4").good());
+    OFCHECK(dataset.putAndInsertString(DCM_SeriesInstanceUID, "1.2.3.4.1").good());
+    OFCHECK(dataset.putAndInsertString(DCM_Modality, "RTPLAN").good());
+    OFCHECK(dataset.putAndInsertString(DCM_RTPlanLabel, "LAZY").good());
+    OFCHECK(dataset.putAndInsertString(DCM_RTPlanGeometry, "PATIENT").good());
+    addBeam(dataset, "1", "FIRST");
+    addBeam(dataset, "2", "SECOND");
+}
+
+
+OFTEST(dcmrt_lazyReading)
+{
+    DcmDataset *dataset = new DcmDataset;
+    createPlan(*dataset);
+    OFshared_ptr<DcmItem> source(dataset);
+
+    // attributes are available immediately, sequences on first access
+    DRTLazyIOD<DRTPlanIOD> plan;
+    OFString value;
+    OFCHECK(plan.read(source).good());
+    OFCHECK(plan.getIOD().getRTPlanLabel(value).good());
+    OFCHECK_EQUAL(value, "LAZY");
+    OFCHECK_EQUAL(plan.getIOD().getBeamSequence().getNumberOfItems(), 0);
+    OFCHECK_EQUAL(plan.getSequence(&DRTPlanIOD::getBeamSequence).getNumberOfItems(), 2);
+    OFCHECK(plan.getSequence(&DRTPlanIOD::getBeamSequence).getItem(1).getBeamName(value).good());
+    OFCHECK_EQUAL(value, "SECOND");
+    OFCHECK_EQUAL(plan.getIOD().getBeamSequence().getNumberOfItems(), 2);
+
+    // the source dataset is kept as long as it is needed
+    source.reset();
+    OFCHECK(plan.getSource());
+    OFCHECK_EQUAL(plan.getSequence(&DRTPlanIOD::getFractionGroupSequence).getNumberOfItems(), 0);
+
+    // the result is the same as after reading all sequences immediately
+    DcmDataset original;
+    createPlan(original);
+    DRTLazyIOD<DRTPlanIOD> copy;
+    DRTPlanIOD eager;
+    OFCHECK(copy.read(original).good());
+    OFCHECK(eager.read(original).good());
+    DRTBeamSequence lazyBeams(copy.getSequence(&DRTPlanIOD::getBeamSequence));
+    OFCHECK_EQUAL(lazyBeams.getNumberOfItems(), eager.getBeamSequence().getNumberOfItems());
+    DcmDataset lazyResult;
+    DcmDataset result;
+    OFCHECK(lazyBeams.write(lazyResult, "1-n", "1C", "RTBeamsModule").good());
+    OFCHECK(eager.getBeamSequence().write(result, "1-n", "1C", "RTBeamsModule").good());
+    OFCHECK_EQUAL(lazyResult.compare(result), 0);
+}
+
+
+OFTEST(dcmrt_lazyReadingPixelData)
+{
+    const size_t numPixels = 2 * 3 * 4;
+    Uint16 pixels[numPixels];
+    for (size_t i = 0; i < numPixels; i++)
+        pixels[i] = OFstatic_cast(Uint16, i);
+
+    // create RT Dose dataset with pixel data and a referenced plan
+    DcmDataset *dataset = new DcmDataset;
+    OFshared_ptr<DcmItem> source(dataset);
+    OFCHECK(dataset->putAndInsertString(DCM_SOPClassUID, UID_RTDoseStorage).good());
+    OFCHECK(dataset->putAndInsertString(DCM_SOPInstanceUID, "1.2.3.4.6").good());
+    OFCHECK(dataset->putAndInsertString(DCM_Modality, "RTDOSE").good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_Rows, 3).good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_Columns, 4).good());
+    OFCHECK(dataset->putAndInsertString(DCM_NumberOfFrames, "2").good());
+    OFCHECK(dataset->putAndInsertUint16(DCM_BitsAllocated, 16).good());
+    OFCHECK(dataset->putAndInsertString(DCM_DoseGridScaling, "0.5").good());
+    OFCHECK(dataset->putAndInsertUint16Array(DCM_PixelData, pixels, numPixels).good());
+    DcmItem *item = NULL;
+    OFCHECK(dataset->findOrCreateSequenceItem(DCM_ReferencedRTPlanSequence, item).good());
+    if (item != NULL)
+    {
+        OFCHECK(item->putAndInsertString(DCM_ReferencedSOPClassUID, UID_RTPlanStorage).good());
+        OFCHECK(item->putAndInsertString(DCM_ReferencedSOPInstanceUID, "1.2.3.4.5").good());
+    }
+    DcmDataset original(*dataset);
+    DcmElement *pixelData = NULL;
+    OFCHECK(dataset->findAndGetElement(DCM_PixelData, pixelData).good());
+
+    // the pixel data is read directly from the shared dataset
+    DRTLazyIOD<DRTDoseIOD> dose;
+    OFCHECK(dose.read(source).good());
+    OFCHECK_EQUAL(dose.getIOD().getPixelData().compare(*pixelData), 0);
+    OFCHECK_EQUAL(dose.getIOD().getReferencedRTPlanSequence().getNumberOfItems(), 0);
+    OFCHECK_EQUAL(dose.getSequence(&DRTDoseIOD::getReferencedRTPlanSequence).getNumberOfItems(), 1);
+
+    // the shared dataset is unchanged, its elements have not been replaced
+    DcmElement *element = NULL;
+    OFCHECK(dataset->findAndGetElement(DCM_PixelData, element).good());
+    OFCHECK(element == pixelData);
+    OFCHECK_EQUAL(dataset->compare(original), 0);
+
+    // only the sequences are copied when reading from a dataset reference
+    DRTLazyIOD<DRTDoseIOD> copy;
+    OFCHECK(copy.read(original).good());
+    OFCHECK(copy.getSource());
+    if (copy.getSource())
+    {
+        OFCHECK(!copy.getSource()->tagExists(DCM_PixelData));
+        OFCHECK(copy.getSource()->tagExists(DCM_ReferencedRTPlanSequence));
+    }
+    OFCHECK_EQUAL(copy.getIOD().getPixelData().compare(*pixelData), 0);
+    OFCHECK_EQUAL(copy.getSequence(&DRTDoseIOD::getReferencedRTPlanSequence).getNumberOfItems(), 1);
+    OFCHECK(original.tagExists(DCM_ReferencedRTPlanSequence));
+    OFCHECK_EQUAL(dataset->compare(original), 0);
+}
@@ -65,9 +65,13 @@ public:
      *  @param  filename The file to read from
      *  @param  segmentation  The resulting segmentation object. NULL if dataset
      *          could not be read successfully.
+     *  @param  sparseFrames If OFTrue, the frames of a binary segmentation are
+     *          held in sparse form (see setSparseFrames()). Ignored for
+     *          fractional segmentations.
      *  @return EC_Normal if reading was successful, error otherwise
      */
-    static OFCondition loadFile(const OFString& filename, DcmSegmentation*& segmentation);
+    static OFCondition
+    loadFile(const OFString& filename, DcmSegmentation*& segmentation, const OFBool sparseFrames = OFFalse);
 
     /** Static method to load a Segmentation object from a dataset object.
      *  The memory of the resulting Segmentation object has to be freed by the
@@ -75,9 +79,13 @@ public:
      *  @param  dataset The dataset to read from
      *  @param  segmentation  The resulting segmentation object. NULL if dataset
      *          could not be read successfully.
+     *  @param  sparseFrames If OFTrue, the frames of a binary segmentation are
+     *          held in sparse form (see setSparseFrames()). Ignored for
+     *          fractional segmentations.
      *  @return EC_Normal if reading was successful, error otherwise
      */
-    static OFCondition loadDataset(DcmDataset& dataset, DcmSegmentation*& segmentation);
+    static OFCondition
+    loadDataset(DcmDataset& dataset, DcmSegmentation*& segmentation, const OFBool sparseFrames = OFFalse);
 
     /** Static method to load a concatenation of a DICOM Segmentation instance
      *  into a DcmSegmentation object.
@@ -147,6 +155,40 @@ public:
      */
     virtual OFBool getCheckDimensionsOnWrite();
 
+    /** If enabled, the frames of a binary segmentation are held in memory in
+     *  sparse form, i.e.\ as runs of set pixels (see DcmSegTypes::BinaryRuns),
+     *  instead of one bit per pixel. This considerably reduces memory
+     *  consumption for segmentations where most frames only cover a small
+     *  part of the image. When writing, the runs are packed directly into
+     *  the Pixel Data. Frames already added are converted accordingly.<br>
+     *  Per default, sparse frames are disabled.
+     *  @param  sparse If OFTrue, frames are held in sparse form, otherwise
+     *          in packed form
+     *  @return EC_Normal if successful, EC_IllegalCall if sparse form is
+     *          requested for a fractional segmentation, error otherwise
+     */
+    virtual OFCondition setSparseFrames(const OFBool sparse);
+
+    /** Returns whether the frames of this segmentation are held in sparse form
+     *  @return OFTrue if frames are held in sparse form, OFFalse otherwise
+     */
+    virtual OFBool getSparseFrames();
+
+    /** If enabled, addFrame() silently ignores frames with no pixel set, i.e.\
+     *  neither the frame nor its per-frame functional groups are added, and
+     *  the following frames are numbered as if the frame had never been
+     *  provided. This permits adding all slices of a volume for every segment
+     *  without creating frames for those slices the segment does not cover.
+     *  Per default, skipping empty frames is disabled.
+     *  @param  skip If OFTrue, empty frames are skipped, otherwise they are added
+     */
+    virtual void setSkipEmptyFrames(const OFBool skip);
+
+    /** Returns whether addFrame() skips frames with no pixel set
+     *  @return OFTrue if empty frames are skipped, OFFalse otherwise
+     */
+    virtual OFBool getSkipEmptyFrames();
+
     // -------------------- creation ---------------------
 
     /** Factory method to create a binary segmentation object from the minimal
@@ -304,12 +346,25 @@ public:
      */
     virtual SOPInstanceReferenceMacro& getReferencedPPS();
 
-    /** Get (const) frame data of a specific frame
+    /** Get (const) frame data of a specific frame. If frames are held in
+     *  sparse form (see setSparseFrames()), the frame is packed on request
+     *  and the returned data is only valid until the next call of this method
+     *  or until the frames of this object are modified. Use getFrameRuns() in
+     *  order to access the sparse form directly.
      *  @param  frameNo The number of the frame to get (starting with 0)
      *  @return The frame requested or NULL if not existing
      */
     virtual const DcmIODTypes::Frame* getFrame(const size_t& frameNo);
 
+    /** Get a frame of a binary segmentation as runs of set pixels. This works
+     *  no matter whether frames are held in sparse form or not.
+     *  @param  frameNo The number of the frame to get (starting with 0)
+     *  @param  runs Replaced by the runs of set pixels of the frame
+     *  @return EC_Normal if successful, EC_IllegalCall if this is not a binary
+     *          segmentation, EC_IllegalParameter if frame does not exist
+     */
+    virtual OFCondition getFrameRuns(const size_t& frameNo, DcmSegTypes::BinaryRuns& runs);
+
     /** Get the frame numbers that belong to a specific segment number
      *  @param  segmentNumber The segment to search frames for
      *  @param  frameNumbers  The frame numbers belonging to that segment
@@ -349,6 +404,25 @@ public:
     virtual OFCondition
     addFrame(Uint8* pixData, const Uint16 segmentNumber, const OFVector<FGBase*>& perFrameInformation);
 
+    /** Add frame to binary segmentation object, provided in sparse form, i.e.\
+     *  as runs of set pixels. This avoids creating a full frame in memory
+     *  for segments only covering a small part of the image.
+     *  @param  runs The runs of set pixels of the frame. The runs must be
+     *          sorted, must not overlap and must be within the frame
+     *          (see DcmSegUtils::checkBinaryRuns()).
+     *  @param  segmentNumber The logical segment number (>=1) this frame refers to.
+     *          The segment identified by the segmentNumber must already exist.
+     *  @param  perFrameInformation The functional groups that identify this frame (i.e.
+     *          which are planned to be not common for all other frames). The
+     *          functional groups are copied, so ownership of each group stays
+     *          with the caller no matter what the method returns.
+     *  @return EC_Normal if adding was successful, EC_IllegalCall if this
+     *          is not a binary segmentation, error otherwise
+     */
+    virtual OFCondition addFrame(const DcmSegTypes::BinaryRuns& runs,
+                                 const Uint16 segmentNumber,
+                                 const OFVector<FGBase*>& perFrameInformation);
+
     /** Return reference to content content identification of this segmentation object
      *  @return Reference to content identification data
      */
@@ -606,9 +680,21 @@ private:
     /// Multi-frame Dimension Module
     IODMultiframeDimensionModule m_DimensionModule;
 
-    /// Binary frame data
+    /// Frame data (empty if frames are held in sparse form)
     OFVector<DcmIODTypes::Frame*> m_Frames;
 
+    /// Binary frame data in sparse form (empty if frames are held in packed form)
+    OFVector<DcmSegTypes::BinaryRuns*> m_FrameRuns;
+
+    /// If enabled, binary frames are held in sparse form
+    OFBool m_SparseFrames;
+
+    /// If enabled, frames with no pixel set are not added
+    OFBool m_SkipEmptyFrames;
+
+    /// Packed frame last returned by getFrame() for frames held in sparse form
+    DcmIODTypes::Frame* m_PackedFrame;
+
     /* Image level information */
 
     /// Image Type: (CS, VM 2-n, Type 1), in Segmentations fixed to "DERIVED\PRIMARY"
@@ -640,6 +726,45 @@ private:
      */
     void clearData();
 
+    /** Get the number of frames held in memory, no matter whether in packed
+     *  or in sparse form
+     *  @return The number of frames
+     */
+    size_t getNumberOfStoredFrames() const;
+
+    /** Check the parameters of a frame to be added, and whether it should be
+     *  skipped since it is empty (see setSkipEmptyFrames())
+     *  @param  segmentNumber The logical segment number of the frame
+     *  @param  isEmpty OFTrue if no pixel of the frame is set
+     *  @param  skip Set to OFTrue if the frame should not be added
+     *  @return EC_Normal if the frame can be added (or skipped), error otherwise
+     */
+    OFCondition checkNewFrame(const Uint16 segmentNumber, const OFBool isEmpty, OFBool& skip);
+
+    /** Add the per-frame functional groups of a new frame, including the
+     *  Segmentation functional group
+     *  @param  frameNo The number of the new frame (starting with 0)
+     *  @param  segmentNumber The logical segment number of the frame
+     *  @param  perFrameInformation The functional groups to be added
+     *  @return EC_Normal if successful, error otherwise
+     */
+    OFCondition
+    addPerFrameGroups(const Uint32 frameNo, const Uint16 segmentNumber, const OFVector<FGBase*>& perFrameInformation);
+
+    /** Remove the per-frame functional groups of a frame that could not be
+     *  added, including the Segmentation functional group
+     *  @param  frameNo The number of the frame (starting with 0)
+     *  @param  perFrameInformation The functional groups to be removed
+     */
+    void removePerFrameGroups(const Uint32 frameNo, const OFVector<FGBase*>& perFrameInformation);
+
+    /** Create a packed frame from its sparse form
+     *  @param  runs The runs of set pixels
+     *  @param  numPixels The number of pixels of the frame
+     *  @return The packed frame, NULL if memory is exhausted
+     */
+    static DcmIODTypes::Frame* packFrameRuns(const DcmSegTypes::BinaryRuns& runs, const size_t numPixels);
+
     /** Check the length of the pixel data
      *  @param  pixelData The Pixel Data element
      *  @param  rows Number of rows
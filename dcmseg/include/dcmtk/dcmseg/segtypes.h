@@ -128,6 +128,25 @@ public:
         SFT_OCCUPANCY
     };
 
+    /** Run of consecutive set pixels within a binary segmentation frame.
+     *  Pixels are counted from 0, row by row, i.e.\ a run may span more than
+     *  one row.
+     */
+    struct BinaryRun
+    {
+        /// Index of the first pixel of the run
+        Uint32 start;
+        /// Number of pixels in the run (greater than 0)
+        Uint32 length;
+    };
+
+    /** Sparse representation of a binary segmentation frame as a list of runs
+     *  of set pixels, sorted by their start and not overlapping each other.
+     *  All pixels not covered by any run are not set, i.e.\ an empty frame
+     *  does not contain any run.
+     */
+    typedef OFVector<BinaryRun> BinaryRuns;
+
     // -- helper functions --
 
     /** Return string representation of algorithm type
@@ -42,6 +42,37 @@ public:
      */
     static DcmIODTypes::Frame* packBinaryFrame(const Uint8* pixelData, const Uint16 rows, const Uint16 columns);
 
+    /** Pack all frames of a binary segmentation, provided "unpacked" and one
+     *  after another in a single buffer, at once. Each resulting frame starts
+     *  at a byte boundary, i.e.\ the frames are the same as those produced by
+     *  calling packBinaryFrame() for each frame.
+     *  @param  pixelData Pixel data of all frames in unpacked format
+     *  @param  numFrames The number of frames in pixelData
+     *  @param  rows Number of rows of each frame
+     *  @param  columns The number of columns of each frame
+     *  @param  results The resulting frames are appended to this vector. The
+     *          caller is responsible for deleting them.
+     *  @return EC_Normal if successful, error otherwise
+     */
+    static OFCondition packBinaryFrames(const Uint8* pixelData,
+                                        const size_t numFrames,
+                                        const Uint16 rows,
+                                        const Uint16 columns,
+                                        OFVector<DcmIODTypes::Frame*>& results);
+
+    /** Pack the given pixels, provided "unpacked" with one byte per pixel
+     *  (0 = not set, any other value = set), into the 1 bit per pixel format
+     *  used by DICOM. Eight pixels are packed at once. Since DICOM concatenates
+     *  all binary frames without any gaps in between, this can also be used to
+     *  create the Pixel Data of all frames of a segmentation at once.
+     *  @param  pixelData Pixel data in unpacked format (numPixels bytes)
+     *  @param  numPixels The number of pixels to pack
+     *  @param  result Buffer for the packed pixels, must provide
+     *          getBytesForBinaryFrame(numPixels) bytes. Unused bits of the
+     *          last byte are set to 0.
+     */
+    static void packBinaryPixels(const Uint8* pixelData, const size_t numPixels, Uint8* result);
+
     /** Compute the number of bytes required for a binary pixel data frame,
      *  given the number of pixels
      *  @param  numPixels The total number of pixels
@@ -60,6 +91,85 @@ public:
      */
     static DcmIODTypes::Frame* unpackBinaryFrame(const DcmIODTypes::Frame* frame, Uint16 rows, Uint16 cols);
 
+    /** Unpack all binary segmentation frames at once into a single buffer,
+     *  where every resulting byte represents a single pixel being either
+     *  0 (not set) or 1 (set), and the frames follow one after another.
+     *  @param  frames The frames in packed format, each starting at a byte boundary
+     *  @param  rows The rows of each frame
+     *  @param  cols The cols of each frame
+     *  @param  result Buffer for the unpacked frames, must provide
+     *          frames.size() * rows * cols bytes
+     *  @return EC_Normal if successful, error otherwise
+     */
+    static OFCondition
+    unpackBinaryFrames(const OFVector<DcmIODTypes::Frame*>& frames, const Uint16 rows, const Uint16 cols, Uint8* result);
+
+    /** Unpack the given pixels from the 1 bit per pixel format used by DICOM
+     *  into one byte per pixel, being either 0 (not set) or 1 (set). Eight
+     *  pixels are unpacked at once.
+     *  @param  packed Pixel data in packed format (getBytesForBinaryFrame(numPixels) bytes)
+     *  @param  numPixels The number of pixels to unpack
+     *  @param  result Buffer for the unpacked pixels, must provide numPixels bytes
+     */
+    static void unpackBinaryPixels(const Uint8* packed, const size_t numPixels, Uint8* result);
+
+    /** Check whether any pixel of the given frame, provided "unpacked" with
+     *  one byte per pixel, is set (i.e.\ not 0). Eight pixels are checked at
+     *  once.
+     *  @param  pixelData Pixel data in unpacked format (numPixels bytes)
+     *  @param  numPixels The number of pixels to check
+     *  @return OFTrue if at least one pixel is set, OFFalse otherwise
+     */
+    static OFBool hasSetPixels(const Uint8* pixelData, const size_t numPixels);
+
+    /** Encode the given pixels, provided "unpacked" with one byte per pixel
+     *  (0 = not set, any other value = set), as runs of set pixels. Stretches
+     *  of unset (and set) pixels are skipped eight pixels at a time.
+     *  @param  pixelData Pixel data in unpacked format (numPixels bytes)
+     *  @param  numPixels The number of pixels to encode, must fit into 32 bits
+     *  @param  runs Replaced by the runs of set pixels
+     */
+    static void encodeBinaryRuns(const Uint8* pixelData, const size_t numPixels, DcmSegTypes::BinaryRuns& runs);
+
+    /** Encode the given pixels, provided in the 1 bit per pixel format used by
+     *  DICOM, as runs of set pixels. Since the pixels may start at any bit
+     *  position, the frames of a segmentation can be encoded directly from
+     *  its Pixel Data. Bytes (and words of 8 bytes) with all pixels being
+     *  unset (or set) are skipped at once.
+     *  @param  packed Pixel data in packed format
+     *  @param  firstBit Position of the first pixel within packed, counted
+     *          in bits from the start of the buffer
+     *  @param  numPixels The number of pixels to encode, must fit into 32 bits
+     *  @param  runs Replaced by the runs of set pixels
+     */
+    static void encodePackedBinaryRuns(const Uint8* packed,
+                                       const size_t firstBit,
+                                       const size_t numPixels,
+                                       DcmSegTypes::BinaryRuns& runs);
+
+    /** Set the pixels covered by the given runs in a buffer using the 1 bit
+     *  per pixel format used by DICOM, i.e.\ convert the sparse form of a
+     *  frame directly into packed pixels. All bytes fully covered by a run
+     *  are filled at once. Since the frame may start at any bit position,
+     *  this can be used to write a frame directly into the Pixel Data of a
+     *  segmentation.
+     *  @param  runs The runs of set pixels, see checkBinaryRuns()
+     *  @param  packed Buffer for the packed pixels. Bits not covered by any
+     *          run are not modified, i.e.\ the buffer should be zeroed before.
+     *  @param  firstBit Position of the first pixel of the frame within packed,
+     *          counted in bits from the start of the buffer
+     */
+    static void packBinaryRuns(const DcmSegTypes::BinaryRuns& runs, Uint8* packed, const size_t firstBit);
+
+    /** Check whether the given runs describe a valid frame, i.e.\ that each
+     *  run contains at least one pixel, that the runs are sorted by their
+     *  start and do not overlap, and that all runs are within the frame.
+     *  @param  runs The runs to check
+     *  @param  numPixels The number of pixels of the frame
+     *  @return OFTrue if runs are valid, OFFalse otherwise
+     */
+    static OFBool checkBinaryRuns(const DcmSegTypes::BinaryRuns& runs, const size_t numPixels);
+
     /** Aligns 1 bit per pixel frame data to make the frame start at a
      *  specific bit position within the first byte. This is used in the context
      *  that dcmseg holds the frames in memory aligned to exact byte positions,
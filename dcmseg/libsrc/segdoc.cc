@@ -42,6 +42,10 @@ DcmSegmentation::DcmSegmentation()
     , m_FG(DcmSegmentation::IODImage::getData(), DcmSegmentation::IODImage::getRules())
     , m_DimensionModule(DcmSegmentation::IODImage::getData(), DcmSegmentation::IODImage::getRules())
     , m_Frames()
+    , m_FrameRuns()
+    , m_SparseFrames(OFFalse)
+    , m_SkipEmptyFrames(OFFalse)
+    , m_PackedFrame(NULL)
     , m_ImageType("DERIVED\\PRIMARY")
     , m_ContentIdentificationMacro()
     , m_SegmentationType(DcmSegTypes::ST_BINARY)
@@ -95,7 +99,8 @@ DcmSegmentation::~DcmSegmentation()
 }
 
 // static method for loading segmentation objects
-OFCondition DcmSegmentation::loadFile(const OFString& filename, DcmSegmentation*& segmentation)
+OFCondition
+DcmSegmentation::loadFile(const OFString& filename, DcmSegmentation*& segmentation, const OFBool sparseFrames)
 {
     DcmFileFormat dcmff;
     DcmDataset* dataset = NULL;
@@ -103,11 +108,12 @@ OFCondition DcmSegmentation::loadFile(const OFString& filename, DcmSegmentation*
     if (result.bad())
         return result;
 
-    return loadDataset(*dataset, segmentation);
+    return loadDataset(*dataset, segmentation, sparseFrames);
 }
 
 // static method for loading segmentation objects
-OFCondition DcmSegmentation::loadDataset(DcmDataset& dataset, DcmSegmentation*& segmentation)
+OFCondition
+DcmSegmentation::loadDataset(DcmDataset& dataset, DcmSegmentation*& segmentation, const OFBool sparseFrames)
 {
     segmentation       = NULL;
     OFCondition result = DcmSegmentation::decompress(dataset);
@@ -120,7 +126,9 @@ OFCondition DcmSegmentation::loadDataset(DcmDataset& dataset, DcmSegmentation*&
         return EC_MemoryExhausted;
     }
 
-    result = temp->read(dataset);
+    // readFrames() decides whether sparse form is applicable
+    temp->m_SparseFrames = sparseFrames;
+    result               = temp->read(dataset);
     if (result.good())
     {
         segmentation = temp;
@@ -326,6 +334,77 @@ OFBool DcmSegmentation::getCheckDimensionsOnWrite()
     return m_DimensionModule.getCheckOnWrite();
 }
 
+OFCondition DcmSegmentation::setSparseFrames(const OFBool sparse)
+{
+    if (sparse == m_SparseFrames)
+        return EC_Normal;
+    if (sparse && (m_SegmentationType != DcmSegTypes::ST_BINARY))
+    {
+        DCMSEG_ERROR("Sparse frames are only supported for binary segmentations");
+        return EC_IllegalCall;
+    }
+
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    if ((getNumberOfStoredFrames() > 0) && (getImagePixel().getRows(rows).bad() || getImagePixel().getColumns(cols).bad()))
+    {
+        DCMSEG_ERROR("Cannot convert frames since rows and/or columns are unknown");
+        return IOD_EC_InvalidDimensions;
+    }
+    const size_t numPixels = OFstatic_cast(size_t, rows) * cols;
+
+    // Convert existing frames, keep original ones until conversion succeeded
+    if (sparse)
+    {
+        OFVector<DcmSegTypes::BinaryRuns*> frameRuns;
+        frameRuns.reserve(m_Frames.size());
+        for (size_t count = 0; count < m_Frames.size(); count++)
+        {
+            DcmSegTypes::BinaryRuns* runs = new DcmSegTypes::BinaryRuns();
+            DcmSegUtils::encodePackedBinaryRuns(m_Frames[count]->pixData, 0, numPixels, *runs);
+            frameRuns.push_back(runs);
+        }
+        DcmIODUtil::freeContainer(m_Frames);
+        m_FrameRuns = frameRuns;
+    }
+    else
+    {
+        OFVector<DcmIODTypes::Frame*> frames;
+        frames.reserve(m_FrameRuns.size());
+        for (size_t count = 0; count < m_FrameRuns.size(); count++)
+        {
+            DcmIODTypes::Frame* frame = packFrameRuns(*m_FrameRuns[count], numPixels);
+            if (!frame)
+            {
+                DcmIODUtil::freeContainer(frames);
+                return EC_MemoryExhausted;
+            }
+            frames.push_back(frame);
+        }
+        DcmIODUtil::freeContainer(m_FrameRuns);
+        m_Frames = frames;
+        delete m_PackedFrame;
+        m_PackedFrame = NULL;
+    }
+    m_SparseFrames = sparse;
+    return EC_Normal;
+}
+
+OFBool DcmSegmentation::getSparseFrames()
+{
+    return m_SparseFrames;
+}
+
+void DcmSegmentation::setSkipEmptyFrames(const OFBool skip)
+{
+    m_SkipEmptyFrames = skip;
+}
+
+OFBool DcmSegmentation::getSkipEmptyFrames()
+{
+    return m_SkipEmptyFrames;
+}
+
 OFCondition DcmSegmentation::writeWithSeparatePixelData(DcmItem& dataset, Uint8*& pixData, size_t& pixDataLength)
 {
     // FGInterface::write() will know whether it has to check FG structure
@@ -386,7 +465,7 @@ OFCondition DcmSegmentation::writeWithSeparatePixelData(DcmItem& dataset, Uint8*
     if (result.good())
     {
         Uint32 numFrames = DcmIODUtil::limitMaxFrames(
-            m_Frames.size(), "More than 2147483647 frames provided, will only write 2147483647");
+            getNumberOfStoredFrames(), "More than 2147483647 frames provided, will only write 2147483647");
         Uint16 rows, cols;
         rows = cols = 0;
         getImagePixel().getRows(rows);
@@ -463,7 +542,7 @@ OFCondition DcmSegmentation::addSegment(DcmSegment* seg, Uint16& segmentNumber)
 
 OFCondition DcmSegmentation::addFrame(Uint8* pixData)
 {
-    if (m_Frames.size() >= DCM_SEG_MAX_FRAMES)
+    if (getNumberOfStoredFrames() >= DCM_SEG_MAX_FRAMES)
         return SG_EC_MaxFramesReached;
 
     OFCondition result;
@@ -472,7 +551,14 @@ OFCondition DcmSegmentation::addFrame(Uint8* pixData)
     if (getImagePixel().getRows(rows).good() && getImagePixel().getColumns(cols).good())
     {
         DcmIODTypes::Frame* frame = NULL;
-        if (m_SegmentationType == DcmSegTypes::ST_BINARY)
+        if (m_SparseFrames)
+        {
+            DcmSegTypes::BinaryRuns* runs = new DcmSegTypes::BinaryRuns();
+            DcmSegUtils::encodeBinaryRuns(pixData, OFstatic_cast(size_t, rows) * cols, *runs);
+            m_FrameRuns.push_back(runs);
+            return EC_Normal;
+        }
+        else if (m_SegmentationType == DcmSegTypes::ST_BINARY)
         {
             frame = DcmSegUtils::packBinaryFrame(pixData, rows, cols);
             if (!frame)
@@ -520,12 +606,50 @@ SOPInstanceReferenceMacro& DcmSegmentation::getReferencedPPS()
 
 const DcmIODTypes::Frame* DcmSegmentation::getFrame(const size_t& frameNo)
 {
-    if (frameNo > m_Frames.size() - 1)
+    if (frameNo >= getNumberOfStoredFrames())
     {
         return NULL;
     }
+    if (!m_SparseFrames)
+    {
+        return m_Frames[frameNo];
+    }
 
-    return m_Frames[frameNo];
+    // Pack frame on request, replacing the one packed before
+    delete m_PackedFrame;
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    getImagePixel().getRows(rows);
+    getImagePixel().getColumns(cols);
+    m_PackedFrame = packFrameRuns(*m_FrameRuns[frameNo], OFstatic_cast(size_t, rows) * cols);
+    return m_PackedFrame;
+}
+
+OFCondition DcmSegmentation::getFrameRuns(const size_t& frameNo, DcmSegTypes::BinaryRuns& runs)
+{
+    if (m_SegmentationType != DcmSegTypes::ST_BINARY)
+    {
+        DCMSEG_ERROR("Frames can only be provided as runs for binary segmentations");
+        return EC_IllegalCall;
+    }
+    if (frameNo >= getNumberOfStoredFrames())
+    {
+        DCMSEG_ERROR("Cannot get runs of frame #" << frameNo << ": Frame does not exist");
+        return EC_IllegalParameter;
+    }
+    if (m_SparseFrames)
+    {
+        runs = *m_FrameRuns[frameNo];
+    }
+    else
+    {
+        Uint16 rows = 0;
+        Uint16 cols = 0;
+        getImagePixel().getRows(rows);
+        getImagePixel().getColumns(cols);
+        DcmSegUtils::encodePackedBinaryRuns(m_Frames[frameNo]->pixData, 0, OFstatic_cast(size_t, rows) * cols, runs);
+    }
+    return EC_Normal;
 }
 
 void DcmSegmentation::getFramesForSegment(const size_t& segmentNumber, OFVector<size_t>& frameNumbers)
@@ -559,75 +683,95 @@ OFCondition DcmSegmentation::addForAllFrames(const FGBase& group)
 OFCondition
 DcmSegmentation::addFrame(Uint8* pixData, const Uint16 segmentNumber, const OFVector<FGBase*>& perFrameInformation)
 {
-    if (m_Frames.size() >= DCM_SEG_MAX_FRAMES)
-        return SG_EC_MaxFramesReached;
-
-    Uint32 frameNo = OFstatic_cast(Uint32, m_Frames.size()); // will be the index of the frame (counted from 0)
-    OFCondition result;
-
-    // Check input parameters
     if (pixData == NULL)
     {
         DCMSEG_ERROR("No pixel data provided or zero length");
-        result = EC_IllegalParameter;
+        return EC_IllegalParameter;
     }
-    if (segmentNumber > m_Segments.size())
+
+    // Only look at the pixels if empty frames should be skipped at all
+    OFBool isEmpty = OFFalse;
+    Uint16 rows    = 0;
+    Uint16 cols    = 0;
+    if (m_SkipEmptyFrames && getImagePixel().getRows(rows).good() && getImagePixel().getColumns(cols).good())
     {
-        DCMSEG_ERROR("Cannot add frame: Segment with given number " << segmentNumber << " does not exist");
-        result = SG_EC_NoSuchSegment;
+        isEmpty = !DcmSegUtils::hasSetPixels(pixData, OFstatic_cast(size_t, rows) * cols);
     }
-    if (result.bad())
+    OFBool skip        = OFFalse;
+    OFCondition result = checkNewFrame(segmentNumber, isEmpty, skip);
+    if (result.bad() || skip)
         return result;
 
-    OFVector<FGBase*>::const_iterator it = perFrameInformation.begin();
-    while (it != perFrameInformation.end())
+    Uint32 frameNo = OFstatic_cast(Uint32, getNumberOfStoredFrames()); // will be the index of the frame (counted from 0)
+    result         = addPerFrameGroups(frameNo, segmentNumber, perFrameInformation);
+
+    // Insert pixel data
+    if (result.good())
     {
-        result = (*it)->check();
-        if (result.bad())
-        {
-            DCMSEG_ERROR("Could not add new frame since functional group of type: "
-                         << (*it)->getType() << " is invalid: " << result.text());
-            break;
-        }
-        result = m_FGInterface.addPerFrame(frameNo, *(*it));
-        if (result.bad())
-        {
-            DCMSEG_ERROR("Could not add new frame since functional group of type " << (*it)->getType() << ": "
-                                                                                   << result.text());
-            break;
-        }
-        it++;
+        result = addFrame(pixData);
     }
 
-    // Now also add Segmentation Functional Group
+    // Cleanup any per-frame groups that might have been inserted and return
+    if (result.bad())
+    {
+        removePerFrameGroups(frameNo, perFrameInformation);
+    }
+
+    return result;
+}
+
+OFCondition DcmSegmentation::addFrame(const DcmSegTypes::BinaryRuns& runs,
+                                      const Uint16 segmentNumber,
+                                      const OFVector<FGBase*>& perFrameInformation)
+{
+    if (m_SegmentationType != DcmSegTypes::ST_BINARY)
+    {
+        DCMSEG_ERROR("Frames can only be added as runs to binary segmentations");
+        return EC_IllegalCall;
+    }
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    if (getImagePixel().getRows(rows).bad() || getImagePixel().getColumns(cols).bad())
+    {
+        DCMSEG_ERROR("Cannot add frame since rows and/or columns are unknown");
+        return IOD_EC_CannotInsertFrame;
+    }
+    const size_t numPixels = OFstatic_cast(size_t, rows) * cols;
+    if (!DcmSegUtils::checkBinaryRuns(runs, numPixels))
+    {
+        DCMSEG_ERROR("Cannot add frame: Runs are not sorted, overlap or exceed the frame");
+        return EC_IllegalParameter;
+    }
+
+    OFBool skip        = OFFalse;
+    OFCondition result = checkNewFrame(segmentNumber, runs.empty(), skip);
+    if (result.bad() || skip)
+        return result;
+
+    Uint32 frameNo = OFstatic_cast(Uint32, getNumberOfStoredFrames()); // will be the index of the frame (counted from 0)
+    result         = addPerFrameGroups(frameNo, segmentNumber, perFrameInformation);
+
+    // Insert pixel data, either as is or packed
     if (result.good())
     {
-        FGSegmentation seg;
-        result = seg.setReferencedSegmentNumber(segmentNumber);
-        if (result.good())
+        if (m_SparseFrames)
         {
-            result = m_FGInterface.addPerFrame(frameNo, seg);
+            m_FrameRuns.push_back(new DcmSegTypes::BinaryRuns(runs));
         }
         else
         {
-            DCMSEG_ERROR("Could not add new frame, invalid segment number " << segmentNumber << ": " << result.text());
+            DcmIODTypes::Frame* frame = packFrameRuns(runs, numPixels);
+            if (frame)
+                m_Frames.push_back(frame);
+            else
+                result = EC_MemoryExhausted;
         }
     }
 
-    // Insert pixel data
-    if (result.good())
-    {
-        result = addFrame(pixData);
-    }
-
     // Cleanup any per-frame groups that might have been inserted and return
     if (result.bad())
     {
-        for (OFVector<FGBase*>::const_iterator it2 = perFrameInformation.begin(); it2 != perFrameInformation.end();
-             it2++)
-        {
-            m_FGInterface.deletePerFrame(frameNo, (*it2)->getType());
-        }
+        removePerFrameGroups(frameNo, perFrameInformation);
     }
 
     return result;
@@ -848,7 +992,23 @@ OFCondition DcmSegmentation::readFrames(DcmItem& dataset)
 
     /* Read all frames into dedicated data structure */
     size_t pixelsPerFrame = OFstatic_cast(size_t, rows) * cols;
-    if (m_SegmentationType == DcmSegTypes::ST_BINARY)
+    if (m_SparseFrames && (m_SegmentationType != DcmSegTypes::ST_BINARY))
+    {
+        DCMSEG_DEBUG("Sparse frames are only supported for binary segmentations, reading frames as is");
+        m_SparseFrames = OFFalse;
+    }
+    if (m_SparseFrames)
+    {
+        // Encode runs directly from the concatenated frames
+        m_FrameRuns.reserve(numberOfFrames);
+        for (size_t count = 0; count < numberOfFrames; count++)
+        {
+            DcmSegTypes::BinaryRuns* runs = new DcmSegTypes::BinaryRuns();
+            DcmSegUtils::encodePackedBinaryRuns(pixels, count * pixelsPerFrame, pixelsPerFrame, *runs);
+            m_FrameRuns.push_back(runs);
+        }
+    }
+    else if (m_SegmentationType == DcmSegTypes::ST_BINARY)
     {
         result = DcmIODUtil::extractBinaryFrames(pixels, numberOfFrames, pixelsPerFrame, m_Frames);
         if (result.bad())
@@ -1031,7 +1191,7 @@ OFCondition DcmSegmentation::writeConcatenation(ConcatenationCreator& cc)
 OFCondition DcmSegmentation::writeMultiFrameFunctionalGroupsModule(DcmItem& dataset)
 {
     Uint32 numFrames = DcmIODUtil::limitMaxFrames(
-        m_Frames.size(), "More than 2147483647 frames provided, limiting Number of Frames to 2147483647");
+        getNumberOfStoredFrames(), "More than 2147483647 frames provided, limiting Number of Frames to 2147483647");
     m_FG.setNumberOfFrames(numFrames);
     OFCondition result = m_FG.write(dataset);
     if (result.good())
@@ -1064,7 +1224,19 @@ OFCondition DcmSegmentation::writeBinaryFrames(Uint8* pixData, Uint16 rows, Uint
     memset(pixData, 0, pixDataLength);
 
     // Fill Pixel Data Element
-    concatFrames(m_Frames, pixData, rows * cols);
+    if (m_SparseFrames)
+    {
+        // Set the bits of each run directly, no need to pack and align frames
+        const size_t bitsPerFrame = OFstatic_cast(size_t, rows) * cols;
+        for (size_t f = 0; (f < m_FrameRuns.size()) && ((f + 1) * bitsPerFrame <= pixDataLength * 8); f++)
+        {
+            DcmSegUtils::packBinaryRuns(*m_FrameRuns[f], pixData, f * bitsPerFrame);
+        }
+    }
+    else
+    {
+        concatFrames(m_Frames, pixData, rows * cols);
+    }
     return EC_Normal;
 }
 
@@ -1161,12 +1333,107 @@ void DcmSegmentation::clearData()
     m_FG.clearData();
     m_FGInterface.clear();
     DcmIODUtil::freeContainer(m_Frames);
+    DcmIODUtil::freeContainer(m_FrameRuns);
+    delete m_PackedFrame;
+    m_PackedFrame = NULL;
     DcmIODUtil::freeContainer(m_Segments);
     m_MaximumFractionalValue.clear();
     m_SegmentationFractionalType = DcmSegTypes::SFT_UNKNOWN;
     m_SegmentationType           = DcmSegTypes::ST_UNKNOWN;
 }
 
+size_t DcmSegmentation::getNumberOfStoredFrames() const
+{
+    return m_Frames.size() + m_FrameRuns.size();
+}
+
+OFCondition DcmSegmentation::checkNewFrame(const Uint16 segmentNumber, const OFBool isEmpty, OFBool& skip)
+{
+    skip = OFFalse;
+    if (getNumberOfStoredFrames() >= DCM_SEG_MAX_FRAMES)
+        return SG_EC_MaxFramesReached;
+    if (segmentNumber > m_Segments.size())
+    {
+        DCMSEG_ERROR("Cannot add frame: Segment with given number " << segmentNumber << " does not exist");
+        return SG_EC_NoSuchSegment;
+    }
+    if (isEmpty && m_SkipEmptyFrames)
+    {
+        DCMSEG_DEBUG("Skipping empty frame for segment #" << segmentNumber);
+        skip = OFTrue;
+    }
+    return EC_Normal;
+}
+
+OFCondition DcmSegmentation::addPerFrameGroups(const Uint32 frameNo,
+                                               const Uint16 segmentNumber,
+                                               const OFVector<FGBase*>& perFrameInformation)
+{
+    OFCondition result;
+    OFVector<FGBase*>::const_iterator it = perFrameInformation.begin();
+    while (it != perFrameInformation.end())
+    {
+        result = (*it)->check();
+        if (result.bad())
+        {
+            DCMSEG_ERROR("Could not add new frame since functional group of type: "
+                         << (*it)->getType() << " is invalid: " << result.text());
+            break;
+        }
+        result = m_FGInterface.addPerFrame(frameNo, *(*it));
+        if (result.bad())
+        {
+            DCMSEG_ERROR("Could not add new frame since functional group of type " << (*it)->getType() << ": "
+                                                                                   << result.text());
+            break;
+        }
+        it++;
+    }
+
+    // Now also add Segmentation Functional Group
+    if (result.good())
+    {
+        FGSegmentation seg;
+        result = seg.setReferencedSegmentNumber(segmentNumber);
+        if (result.good())
+        {
+            result = m_FGInterface.addPerFrame(frameNo, seg);
+        }
+        else
+        {
+            DCMSEG_ERROR("Could not add new frame, invalid segment number " << segmentNumber << ": " << result.text());
+        }
+    }
+    return result;
+}
+
+void DcmSegmentation::removePerFrameGroups(const Uint32 frameNo, const OFVector<FGBase*>& perFrameInformation)
+{
+    for (OFVector<FGBase*>::const_iterator it = perFrameInformation.begin(); it != perFrameInformation.end(); it++)
+    {
+        m_FGInterface.deletePerFrame(frameNo, (*it)->getType());
+    }
+    m_FGInterface.deletePerFrame(frameNo, DcmFGTypes::EFG_SEGMENTATION);
+}
+
+DcmIODTypes::Frame* DcmSegmentation::packFrameRuns(const DcmSegTypes::BinaryRuns& runs, const size_t numPixels)
+{
+    DcmIODTypes::Frame* frame = new DcmIODTypes::Frame();
+    if (frame)
+    {
+        frame->length  = DcmSegUtils::getBytesForBinaryFrame(numPixels);
+        frame->pixData = new Uint8[frame->length];
+        if (!frame->pixData)
+        {
+            delete frame;
+            return NULL;
+        }
+        memset(frame->pixData, 0, frame->length);
+        DcmSegUtils::packBinaryRuns(runs, frame->pixData, 0);
+    }
+    return frame;
+}
+
 OFBool DcmSegmentation::checkPixDataLength(DcmElement* pixelData,
                                            const Uint16 rows,
                                            const Uint16 cols,
@@ -1313,7 +1580,7 @@ IODImagePixelModule<Uint8>& DcmSegmentation::getImagePixel()
 
 OFBool DcmSegmentation::check(const OFBool checkFGStructure)
 {
-    if (m_Frames.size() == 0)
+    if (getNumberOfStoredFrames() == 0)
     {
         DCMSEG_ERROR("No frame data available");
         return OFFalse;
@@ -1328,7 +1595,7 @@ OFBool DcmSegmentation::check(const OFBool checkFGStructure)
         DCMSEG_ERROR("Too many segments defined");
         return OFFalse;
     }
-    if (m_Segments.size() > m_Frames.size())
+    if (m_Segments.size() > getNumberOfStoredFrames())
     {
         DCMSEG_ERROR("More segments than frames defined");
         return OFFalse;
@@ -1454,22 +1721,22 @@ void DcmSegmentation::concatFrames(OFVector<DcmIODTypes::Frame*> frames, Uint8*
         // previous frame that are overwritten by the shifting operation.
         if (freeBits > 0)
         {
+            const Uint8 lastByte = (*frame)->pixData[(*frame)->length - 1];
             DcmSegUtils::alignFrameOnBitPosition(writePos, (*frame)->length, 8 - freeBits);
             writePos[0] |= firstByte;
+            // If the shifted frame occupies one more byte than the frame itself,
+            // the bits shifted out of the last byte go into that byte
+            if ((8 - freeBits) + bitsPerFrame > (*frame)->length * 8)
+            {
+                writePos[(*frame)->length] = OFstatic_cast(Uint8, lastByte >> freeBits);
+            }
         }
         // Compute free bits left over from this frame in the previous byte written
         freeBits = (8 - (((f + 1) * bitsPerFrame) % 8)) % 8;
-        // If we have free bits, the previous byte written to will be the first byte
+        // If we have free bits, the last byte written to will be the first byte
         // we write to for the next frame. Otherwise start with a fresh destination
         // byte.
-        if (freeBits > 0)
-        {
-            writePos = writePos + (*frame)->length - 1;
-        }
-        else
-        {
-            writePos = writePos + (*frame)->length;
-        }
+        writePos = pixData + ((f + 1) * bitsPerFrame) / 8;
         // Next frame
         frame++;
     }
@@ -1477,6 +1744,6 @@ void DcmSegmentation::concatFrames(OFVector<DcmIODTypes::Frame*> frames, Uint8*
     // last byte. Fill them with zeros (though not required by the standard).
     if (freeBits > 0)
     {
-        *writePos = (OFstatic_cast(unsigned char, *writePos) >> freeBits) << freeBits;
+        *writePos = OFstatic_cast(unsigned char, (*writePos << freeBits)) >> freeBits;
     }
 }
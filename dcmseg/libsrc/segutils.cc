@@ -25,6 +25,57 @@
 #include "dcmtk/dcmseg/segdef.h"
 #include "dcmtk/dcmseg/segutils.h"
 
+// The word-parallel code paths below process 8 bytes of a buffer at once as a
+// single 64 bit word. Since the first byte in memory must be the least
+// significant byte of that word, they are only used on little endian machines.
+
+// Build 64 bit constant from two 32 bit halves
+#define DCMSEG_WORD(high, low) ((OFstatic_cast(Uint64, high) << 32) | OFstatic_cast(Uint64, low))
+
+// Lowest bit of each byte
+static const Uint64 WORD_LOW_BITS = DCMSEG_WORD(0x01010101UL, 0x01010101UL);
+
+// Multiplier moving the lowest bit of byte i into bit 56 + i
+static const Uint64 WORD_GATHER = DCMSEG_WORD(0x01020408UL, 0x10204080UL);
+
+// Mask selecting bit i of byte i
+static const Uint64 WORD_SELECT = DCMSEG_WORD(0x80402010UL, 0x08040201UL);
+
+// Added to each byte in order to set its highest bit if any other bit is set
+static const Uint64 WORD_SATURATE = DCMSEG_WORD(0x7F7F7F7FUL, 0x7F7F7F7FUL);
+
+// Highest bit of each byte
+static const Uint64 WORD_HIGH_BITS = DCMSEG_WORD(0x80808080UL, 0x80808080UL);
+
+// All bits set
+static const Uint64 WORD_ALL_BITS = DCMSEG_WORD(0xFFFFFFFFUL, 0xFFFFFFFFUL);
+
+static inline Uint64 loadWord(const Uint8* buf)
+{
+    Uint64 word;
+    memcpy(&word, buf, 8);
+    return word;
+}
+
+static inline void storeWord(Uint8* buf, const Uint64 word)
+{
+    memcpy(buf, &word, 8);
+}
+
+// Check whether none of the bytes of the word is 0 (independent of byte order)
+static inline OFBool hasNoZeroByte(const Uint64 word)
+{
+    return ((word - WORD_LOW_BITS) & ~word & WORD_HIGH_BITS) == 0;
+}
+
+static inline void addRun(DcmSegTypes::BinaryRuns& runs, const size_t start, const size_t end)
+{
+    DcmSegTypes::BinaryRun run;
+    run.start  = OFstatic_cast(Uint32, start);
+    run.length = OFstatic_cast(Uint32, end - start);
+    runs.push_back(run);
+}
+
 DcmIODTypes::Frame* DcmSegUtils::packBinaryFrame(const Uint8* pixelData, const Uint16 rows, const Uint16 columns)
 {
     // Sanity checking
@@ -52,17 +103,72 @@ DcmIODTypes::Frame* DcmSegUtils::packBinaryFrame(const Uint8* pixelData, const U
         delete frame;
         return NULL;
     }
-    memset(frame->pixData, 0, frame->length);
+    packBinaryPixels(pixelData, numPixels, frame->pixData);
+    return frame;
+}
 
-    size_t bytePos = 0;
-    for (size_t count = 0; count < numPixels; count++)
+OFCondition DcmSegUtils::packBinaryFrames(const Uint8* pixelData,
+                                          const size_t numFrames,
+                                          const Uint16 rows,
+                                          const Uint16 columns,
+                                          OFVector<DcmIODTypes::Frame*>& results)
+{
+    const size_t numPixels = OFstatic_cast(size_t, rows) * columns;
+    if ((numPixels == 0) || !pixelData)
     {
-        // Compute byte position
-        bytePos = count / 8;
-        frame->pixData[bytePos]
-            |= (pixelData[count] != 0) /* value to set */ << (count % 8 /* bit position (0-7) within byte */);
+        DCMSEG_ERROR("Unable to pack binary segmentation frames: No pixel data provided");
+        return EC_IllegalParameter;
+    }
+    results.reserve(results.size() + numFrames);
+    for (size_t f = 0; f < numFrames; f++)
+    {
+        DcmIODTypes::Frame* frame = packBinaryFrame(pixelData + f * numPixels, rows, columns);
+        if (!frame)
+            return EC_MemoryExhausted;
+        results.push_back(frame);
+    }
+    return EC_Normal;
+}
+
+void DcmSegUtils::packBinaryPixels(const Uint8* pixelData, const size_t numPixels, Uint8* result)
+{
+    const size_t numFullBytes = numPixels / 8;
+    size_t bytePos            = 0;
+    if (gLocalByteOrder == EBO_LittleEndian)
+    {
+        for (; bytePos < numFullBytes; bytePos++)
+        {
+            // Reduce each byte to its lowest bit being set if any bit is set,
+            // and collect these bits into a single byte ("movemask").
+            // Bits shifted in from the next byte never reach the lowest bit.
+            Uint64 word = loadWord(pixelData + bytePos * 8);
+            word |= word >> 4;
+            word |= word >> 2;
+            word |= word >> 1;
+            word &= WORD_LOW_BITS;
+            result[bytePos] = OFstatic_cast(Uint8, (word * WORD_GATHER) >> 56);
+        }
+    }
+    else
+    {
+        for (; bytePos < numFullBytes; bytePos++)
+        {
+            const Uint8* pixels = pixelData + bytePos * 8;
+            Uint8 value         = 0;
+            for (Uint8 bit = 0; bit < 8; bit++)
+                value |= OFstatic_cast(Uint8, (pixels[bit] != 0) << bit);
+            result[bytePos] = value;
+        }
+    }
+    // Pack remaining pixels into last byte, leaving unused bits 0
+    if (numPixels % 8 != 0)
+    {
+        const Uint8* pixels = pixelData + numFullBytes * 8;
+        Uint8 value         = 0;
+        for (size_t bit = 0; bit < numPixels % 8; bit++)
+            value |= OFstatic_cast(Uint8, (pixels[bit] != 0) << bit);
+        result[numFullBytes] = value;
     }
-    return frame;
 }
 
 DcmIODTypes::Frame* DcmSegUtils::unpackBinaryFrame(const DcmIODTypes::Frame* frame, Uint16 rows, Uint16 cols)
@@ -92,26 +198,183 @@ DcmIODTypes::Frame* DcmSegUtils::unpackBinaryFrame(const DcmIODTypes::Frame* fra
         DCMSEG_ERROR("Cannot unpack binary frame, memory exhausted");
         return NULL;
     }
-    memset(result->pixData, 0, result->length);
 
     // Transform and copy from packed frame to unpacked result frame
-    size_t bytePos = 0;
-    for (size_t count = 0; count < numBits; count++)
-    {
-        // Compute byte position
-        bytePos = count / 8;
-        // Bit position (0-7) within byte
-        Uint8 bitpos = (count % 8);
-        if ((frame->pixData[bytePos] & (1 << bitpos) /* check whether bit at bitpos is set*/))
+    unpackBinaryPixels(frame->pixData, numBits, result->pixData);
+    return result;
+}
+
+OFCondition DcmSegUtils::unpackBinaryFrames(const OFVector<DcmIODTypes::Frame*>& frames,
+                                            const Uint16 rows,
+                                            const Uint16 cols,
+                                            Uint8* result)
+{
+    const size_t numPixels = OFstatic_cast(size_t, rows) * cols;
+    if ((numPixels == 0) || !result)
+    {
+        DCMSEG_ERROR("Cannot unpack binary frames, invalid input data");
+        return EC_IllegalParameter;
+    }
+    const size_t numBytes = getBytesForBinaryFrame(numPixels);
+    for (size_t f = 0; f < frames.size(); f++)
+    {
+        if (!frames[f] || !frames[f]->pixData || (frames[f]->length < numBytes))
         {
-            result->pixData[count] = 1;
+            DCMSEG_ERROR("Cannot unpack binary frame #" << f + 1 << ", invalid input data");
+            return EC_IllegalParameter;
+        }
+        unpackBinaryPixels(frames[f]->pixData, numPixels, result + f * numPixels);
+    }
+    return EC_Normal;
+}
+
+void DcmSegUtils::unpackBinaryPixels(const Uint8* packed, const size_t numPixels, Uint8* result)
+{
+    const size_t numFullBytes = numPixels / 8;
+    size_t bytePos            = 0;
+    if (gLocalByteOrder == EBO_LittleEndian)
+    {
+        for (; bytePos < numFullBytes; bytePos++)
+        {
+            // Copy the packed byte into each byte of the word, select bit i in
+            // byte i, and turn each non-zero byte into 1 (no carries between bytes)
+            Uint64 word = (OFstatic_cast(Uint64, packed[bytePos]) * WORD_LOW_BITS) & WORD_SELECT;
+            word        = ((word + WORD_SATURATE) >> 7) & WORD_LOW_BITS;
+            storeWord(result + bytePos * 8, word);
+        }
+    }
+    else
+    {
+        for (; bytePos < numFullBytes; bytePos++)
+        {
+            Uint8* pixels     = result + bytePos * 8;
+            const Uint8 value = packed[bytePos];
+            for (Uint8 bit = 0; bit < 8; bit++)
+                pixels[bit] = OFstatic_cast(Uint8, (value >> bit) & 1);
+        }
+    }
+    // Unpack remaining pixels from last byte
+    for (size_t bit = 0; bit < numPixels % 8; bit++)
+        result[numFullBytes * 8 + bit] = OFstatic_cast(Uint8, (packed[numFullBytes] >> bit) & 1);
+}
+
+OFBool DcmSegUtils::hasSetPixels(const Uint8* pixelData, const size_t numPixels)
+{
+    size_t pos = 0;
+    for (; pos + 8 <= numPixels; pos += 8)
+    {
+        if (loadWord(pixelData + pos) != 0)
+            return OFTrue;
+    }
+    for (; pos < numPixels; pos++)
+    {
+        if (pixelData[pos] != 0)
+            return OFTrue;
+    }
+    return OFFalse;
+}
+
+void DcmSegUtils::encodeBinaryRuns(const Uint8* pixelData, const size_t numPixels, DcmSegTypes::BinaryRuns& runs)
+{
+    runs.clear();
+    size_t pos = 0;
+    while (pos < numPixels)
+    {
+        // Skip unset pixels
+        while ((pos + 8 <= numPixels) && (loadWord(pixelData + pos) == 0))
+            pos += 8;
+        while ((pos < numPixels) && (pixelData[pos] == 0))
+            pos++;
+        if (pos == numPixels)
+            break;
+        // Collect set pixels
+        const size_t start = pos;
+        while ((pos + 8 <= numPixels) && hasNoZeroByte(loadWord(pixelData + pos)))
+            pos += 8;
+        while ((pos < numPixels) && (pixelData[pos] != 0))
+            pos++;
+        addRun(runs, start, pos);
+    }
+}
+
+void DcmSegUtils::encodePackedBinaryRuns(const Uint8* packed,
+                                         const size_t firstBit,
+                                         const size_t numPixels,
+                                         DcmSegTypes::BinaryRuns& runs)
+{
+    runs.clear();
+    size_t pos = 0;
+    while (pos < numPixels)
+    {
+        // Skip unset pixels, whole words or bytes at once if aligned
+        while (pos < numPixels)
+        {
+            const size_t bit = firstBit + pos;
+            if ((bit % 8 == 0) && (pos + 64 <= numPixels) && (loadWord(packed + bit / 8) == 0))
+                pos += 64;
+            else if ((bit % 8 == 0) && (pos + 8 <= numPixels) && (packed[bit / 8] == 0))
+                pos += 8;
+            else if (((packed[bit / 8] >> (bit % 8)) & 1) == 0)
+                pos++;
+            else
+                break;
+        }
+        if (pos == numPixels)
+            break;
+        // Collect set pixels
+        const size_t start = pos;
+        while (pos < numPixels)
+        {
+            const size_t bit = firstBit + pos;
+            if ((bit % 8 == 0) && (pos + 64 <= numPixels) && (loadWord(packed + bit / 8) == WORD_ALL_BITS))
+                pos += 64;
+            else if ((bit % 8 == 0) && (pos + 8 <= numPixels) && (packed[bit / 8] == 0xFF))
+                pos += 8;
+            else if (((packed[bit / 8] >> (bit % 8)) & 1) != 0)
+                pos++;
+            else
+                break;
+        }
+        addRun(runs, start, pos);
+    }
+}
+
+void DcmSegUtils::packBinaryRuns(const DcmSegTypes::BinaryRuns& runs, Uint8* packed, const size_t firstBit)
+{
+    for (DcmSegTypes::BinaryRuns::const_iterator run = runs.begin(); run != runs.end(); run++)
+    {
+        if (run->length == 0)
+            continue;
+        const size_t first    = firstBit + run->start;
+        const size_t last     = first + run->length - 1;
+        const Uint8 firstMask = OFstatic_cast(Uint8, 0xFF << (first % 8));
+        const Uint8 lastMask  = OFstatic_cast(Uint8, 0xFF >> (7 - last % 8));
+        if (first / 8 == last / 8)
+        {
+            packed[first / 8] |= firstMask & lastMask;
         }
         else
         {
-            result->pixData[count] = 0;
+            packed[first / 8] |= firstMask;
+            memset(packed + first / 8 + 1, 0xFF, last / 8 - first / 8 - 1);
+            packed[last / 8] |= lastMask;
         }
     }
-    return result;
+}
+
+OFBool DcmSegUtils::checkBinaryRuns(const DcmSegTypes::BinaryRuns& runs, const size_t numPixels)
+{
+    size_t end = 0;
+    for (DcmSegTypes::BinaryRuns::const_iterator run = runs.begin(); run != runs.end(); run++)
+    {
+        if ((run->length == 0) || (run->start < end) || (run->start > numPixels)
+            || (run->length > numPixels - run->start))
+        {
+            return OFFalse;
+        }
+        end = OFstatic_cast(size_t, run->start) + run->length;
+    }
+    return OFTrue;
 }
 
 size_t DcmSegUtils::getBytesForBinaryFrame(const size_t& numPixels)
@@ -133,8 +396,22 @@ void DcmSegUtils::alignFrameOnBitPosition(Uint8* buf, const size_t bufLen, const
         DCMSEG_ERROR("Invalid input data: alignFrameOnBitPosition() can only shift 0-7 bits");
         return;
     }
+    if (numBits == 0)
+        return;
     Uint8 carryOver = 0;
-    for (size_t x = 0; x < bufLen; x++)
+    size_t x        = 0;
+    if (gLocalByteOrder == EBO_LittleEndian)
+    {
+        // Shift 8 bytes at once, the bits shifted out of the word's highest
+        // byte are carried over into the next word
+        for (; x + 8 <= bufLen; x += 8)
+        {
+            const Uint64 current = loadWord(buf + x);
+            storeWord(buf + x, (current << numBits) | carryOver);
+            carryOver = OFstatic_cast(Uint8, current >> (64 - numBits));
+        }
+    }
+    for (; x < bufLen; x++)
     {
         // Store current byte since we need to restore its first bits later
         Uint8 current = buf[x];
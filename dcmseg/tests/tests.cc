@@ -25,7 +25,11 @@
 
 OFTEST_REGISTER(dcmseg_bigdim);
 OFTEST_REGISTER(dcmseg_utils);
+OFTEST_REGISTER(dcmseg_utils_pack);
+OFTEST_REGISTER(dcmseg_utils_align);
+OFTEST_REGISTER(dcmseg_utils_runs);
 OFTEST_REGISTER(dcmseg_roundtrip);
+OFTEST_REGISTER(dcmseg_sparse_frames);
 OFTEST_REGISTER(dcmseg_concat_binary);
 
 OFTEST_MAIN("dcmseg")
@@ -0,0 +1,319 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmseg
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Tests for sparse (run-length) binary segmentation frames
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmfg/fgfracon.h"
+#include "dcmtk/dcmfg/fgpixmsr.h"
+#include "dcmtk/dcmfg/fgplanor.h"
+#include "dcmtk/dcmfg/fgplanpo.h"
+#include "dcmtk/dcmseg/segdoc.h"
+#include "dcmtk/dcmseg/segment.h"
+#include "dcmtk/dcmseg/segutils.h"
+#include "dcmtk/ofstd/oftest.h"
+
+// Frames with 7x11 pixels, i.e. frames do not end on byte boundary and
+// long enough to contain whole words of set and unset pixels
+static const Uint16 NUM_ROWS   = 7;
+static const Uint16 NUM_COLS   = 11;
+static const size_t NUM_PIXELS = NUM_ROWS * NUM_COLS;
+static const size_t NUM_FRAMES = 6;
+
+// Pixels of frame f: frames 1 and 4 are empty, the others contain
+// single pixels, short runs and long runs
+static Uint8 pixel(const size_t f, const size_t i)
+{
+    if ((f == 1) || (f == 4))
+        return 0;
+    if (f == 5)
+        return (i > 3) ? 1 : 0;
+    return OFstatic_cast(Uint8, ((i % 13 == f) || ((i > 20 + f) && (i < 50 + 2 * f))) ? i + 1 : 0);
+}
+
+// Reference implementation for the runs of set pixels
+static DcmSegTypes::BinaryRuns referenceRuns(const Uint8* pixels, const size_t numPixels)
+{
+    DcmSegTypes::BinaryRuns runs;
+    for (size_t i = 0; i < numPixels; i++)
+    {
+        if ((pixels[i] != 0) && ((i == 0) || (pixels[i - 1] == 0)))
+        {
+            DcmSegTypes::BinaryRun run;
+            run.start  = OFstatic_cast(Uint32, i);
+            run.length = 0;
+            runs.push_back(run);
+        }
+        if (pixels[i] != 0)
+            runs.back().length++;
+    }
+    return runs;
+}
+
+static OFBool sameRuns(const DcmSegTypes::BinaryRuns& a, const DcmSegTypes::BinaryRuns& b)
+{
+    if (a.size() != b.size())
+        return OFFalse;
+    for (size_t r = 0; r < a.size(); r++)
+    {
+        if ((a[r].start != b[r].start) || (a[r].length != b[r].length))
+            return OFFalse;
+    }
+    return OFTrue;
+}
+
+OFTEST(dcmseg_utils_runs)
+{
+    // Unpacked test data, including whole words of set pixels
+    const size_t numPixels = 150;
+    Uint8 pixels[numPixels];
+    for (size_t i = 0; i < numPixels; i++)
+        pixels[i] = OFstatic_cast(Uint8, ((i % 11 == 3) || ((i > 30) && (i < 105)) || (i > 140)) ? i : 0);
+    const DcmSegTypes::BinaryRuns expected = referenceRuns(pixels, numPixels);
+    OFCHECK(DcmSegUtils::checkBinaryRuns(expected, numPixels));
+    OFCHECK(DcmSegUtils::hasSetPixels(pixels, numPixels));
+    OFCHECK(!DcmSegUtils::hasSetPixels(pixels, 3));
+
+    DcmSegTypes::BinaryRuns runs;
+    DcmSegUtils::encodeBinaryRuns(pixels, numPixels, runs);
+    OFCHECK(sameRuns(runs, expected));
+
+    // Pack runs at every bit position and compare against packed pixels,
+    // then encode runs from packed pixels again
+    Uint8 packed[24];
+    Uint8 reference[24];
+    for (size_t firstBit = 0; firstBit < 8; firstBit++)
+    {
+        memset(packed, 0, sizeof(packed));
+        memset(reference, 0, sizeof(reference));
+        DcmSegUtils::packBinaryRuns(expected, packed, firstBit);
+        for (size_t i = 0; i < numPixels; i++)
+        {
+            if (pixels[i] != 0)
+                reference[(firstBit + i) / 8] |= OFstatic_cast(Uint8, 1 << ((firstBit + i) % 8));
+        }
+        OFCHECK(memcmp(packed, reference, sizeof(packed)) == 0);
+        DcmSegUtils::encodePackedBinaryRuns(packed, firstBit, numPixels, runs);
+        OFCHECK(sameRuns(runs, expected));
+    }
+
+    // Empty frame
+    memset(pixels, 0, sizeof(pixels));
+    OFCHECK(!DcmSegUtils::hasSetPixels(pixels, numPixels));
+    DcmSegUtils::encodeBinaryRuns(pixels, numPixels, runs);
+    OFCHECK(runs.empty());
+
+    // Invalid runs
+    DcmSegTypes::BinaryRun run;
+    run.start  = 10;
+    run.length = 5;
+    runs.clear();
+    runs.push_back(run);
+    OFCHECK(DcmSegUtils::checkBinaryRuns(runs, 15));
+    OFCHECK(!DcmSegUtils::checkBinaryRuns(runs, 14));
+    run.start = 12;
+    runs.push_back(run);
+    OFCHECK(!DcmSegUtils::checkBinaryRuns(runs, 100));
+    runs.back().start  = 15;
+    runs.back().length = 0;
+    OFCHECK(!DcmSegUtils::checkBinaryRuns(runs, 100));
+}
+
+static DcmSegmentation* create(const OFBool sparse)
+{
+    IODGeneralEquipmentModule::EquipmentInfo eq("Open Connections", "OC CT", "4711", "0.1");
+    ContentIdentificationMacro ci("1", "LABEL", "DESCRIPTION", "Doe^John");
+    DcmSegmentation* seg = NULL;
+    OFCHECK(DcmSegmentation::createBinarySegmentation(seg, NUM_ROWS, NUM_COLS, eq, ci).good());
+    OFCHECK(seg != OFnullptr);
+    if (!seg)
+        return NULL;
+    OFCHECK(seg->getPatient().setPatientID("007").good());
+    OFCHECK(seg->getSeries().setSeriesNumber("1").good());
+    OFCHECK(seg->getFrameOfReference().setFrameOfReferenceUID("2.25.30853397773651184949181049330553108086").good());
+    OFCHECK(seg->getStudy().setStudyInstanceUID("1.2.276.0.7230010.3.1.2.8323329.14863.1565940357.864811").good());
+    OFCHECK(seg->getSeries().setSeriesInstanceUID("1.2.276.0.7230010.3.1.3.8323329.14863.1565940357.864812").good());
+    OFCHECK(seg->getSOPCommon().setSOPInstanceUID("1.2.276.0.7230010.3.1.4.8323329.14863.1565940357.864813").good());
+    OFCHECK(seg->getGeneralImage().setContentDate("20190927").good());
+    OFCHECK(seg->getGeneralImage().setContentTime("153857").good());
+    seg->setCheckFGOnWrite(OFFalse);
+    seg->setCheckDimensionsOnWrite(OFFalse);
+
+    FGPixelMeasures meas;
+    OFCHECK(meas.setPixelSpacing("0.1\\0.1").good());
+    OFCHECK(meas.setSliceThickness("1.0").good());
+    FGPlanePosPatient planpo;
+    OFCHECK(planpo.setImagePositionPatient("0.0", "0.0", "0.0").good());
+    FGPlaneOrientationPatient planor;
+    OFCHECK(planor.setImageOrientationPatient("1.0", "0.0", "0.0", "0.0", "1.0", "0.0").good());
+    OFCHECK(seg->addForAllFrames(meas).good());
+    OFCHECK(seg->addForAllFrames(planpo).good());
+    OFCHECK(seg->addForAllFrames(planor).good());
+
+    IODMultiframeDimensionModule& dims = seg->getDimensions();
+    OFCHECK(dims.addDimensionIndex(
+                    DCM_InStackPositionNumber, "2.25.30855560781715986879861690673941231222", DCM_FrameContentSequence, "STACK_DIM")
+                .good());
+    IODMultiframeDimensionModule::DimensionOrganizationItem* org
+        = new IODMultiframeDimensionModule::DimensionOrganizationItem;
+    org->setDimensionOrganizationUID("2.25.30855560781715986879861690673941231222");
+    dims.getDimensionOrganizationSequence().push_back(org);
+
+    DcmSegment* segment = NULL;
+    CodeSequenceMacro category("85756007", "SCT", "Tissue");
+    CodeSequenceMacro propType("51114001", "SCT", "Artery");
+    OFCHECK(DcmSegment::create(segment, "SEGLABEL", category, propType, DcmSegTypes::SAT_AUTOMATIC, "OC_DUMMY").good());
+    Uint16 segmentNumber = 0;
+    OFCHECK(seg->addSegment(segment, segmentNumber).good());
+    OFCHECK(segmentNumber == 1);
+    OFCHECK(seg->setSparseFrames(sparse).good());
+    return seg;
+}
+
+static OFCondition addFrame(DcmSegmentation* seg, const size_t f)
+{
+    Uint8 pixels[NUM_PIXELS];
+    for (size_t i = 0; i < NUM_PIXELS; i++)
+        pixels[i] = pixel(f, i);
+    FGFrameContent fracon;
+    OFCHECK(fracon.setStackID("1").good());
+    OFCHECK(fracon.setInStackPositionNumber(OFstatic_cast(Uint32, f + 1)).good());
+    OFVector<FGBase*> groups;
+    groups.push_back(&fracon);
+    return seg->addFrame(pixels, 1, groups);
+}
+
+static Uint32 getInStackPosition(DcmSegmentation* seg, const size_t frameNo)
+{
+    Uint32 pos             = 0;
+    FGFrameContent* fracon = OFstatic_cast(
+        FGFrameContent*, seg->getFunctionalGroups().get(OFstatic_cast(Uint32, frameNo), DcmFGTypes::EFG_FRAMECONTENT));
+    OFCHECK(fracon != NULL);
+    if (fracon)
+        OFCHECK(fracon->getInStackPositionNumber(pos).good());
+    return pos;
+}
+
+OFTEST(dcmseg_sparse_frames)
+{
+    // Make sure data dictionary is loaded
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        OFCHECK_FAIL("no data dictionary loaded, check environment variable: " DCM_DICT_ENVIRONMENT_VARIABLE);
+        return;
+    }
+
+    // Reference: all frames in packed form, empty frames are not added at all
+    DcmSegmentation* dense = create(OFFalse);
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+    {
+        if ((f != 1) && (f != 4))
+            OFCHECK(addFrame(dense, f).good());
+    }
+
+    // Sparse form, empty frames skipped automatically
+    DcmSegmentation* sparse = create(OFTrue);
+    OFCHECK(sparse->getSparseFrames());
+    sparse->setSkipEmptyFrames(OFTrue);
+    OFCHECK(sparse->getSkipEmptyFrames());
+    for (size_t f = 0; f < NUM_FRAMES; f++)
+        OFCHECK(addFrame(sparse, f).good());
+    OFCHECK_EQUAL(sparse->getNumberOfFrames(), NUM_FRAMES - 2);
+    OFCHECK_EQUAL(getInStackPosition(sparse, 0), 1);
+    OFCHECK_EQUAL(getInStackPosition(sparse, 1), 3);
+    OFCHECK_EQUAL(getInStackPosition(sparse, 3), 6);
+    OFVector<size_t> frameNumbers;
+    sparse->getFramesForSegment(1, frameNumbers);
+    OFCHECK_EQUAL(frameNumbers.size(), NUM_FRAMES - 2);
+
+    // Frames are identical, no matter how they are held in memory
+    for (size_t frameNo = 0; frameNo < NUM_FRAMES - 2; frameNo++)
+    {
+        DcmSegTypes::BinaryRuns denseRuns;
+        DcmSegTypes::BinaryRuns sparseRuns;
+        OFCHECK(dense->getFrameRuns(frameNo, denseRuns).good());
+        OFCHECK(sparse->getFrameRuns(frameNo, sparseRuns).good());
+        OFCHECK(sameRuns(denseRuns, sparseRuns));
+        const DcmIODTypes::Frame* denseFrame  = dense->getFrame(frameNo);
+        const DcmIODTypes::Frame* sparseFrame = sparse->getFrame(frameNo);
+        OFCHECK(denseFrame && sparseFrame);
+        if (denseFrame && sparseFrame)
+        {
+            OFCHECK_EQUAL(denseFrame->length, sparseFrame->length);
+            OFCHECK(memcmp(denseFrame->pixData, sparseFrame->pixData, denseFrame->length) == 0);
+        }
+    }
+    OFCHECK(sparse->getFrame(NUM_FRAMES - 2) == NULL);
+
+    // Written datasets are identical
+    DcmDataset denseDataset;
+    DcmDataset sparseDataset;
+    OFCHECK(dense->writeDataset(denseDataset).good());
+    OFCHECK(sparse->writeDataset(sparseDataset).good());
+    OFCHECK(denseDataset.compare(sparseDataset) == 0);
+
+    // Add frame as runs and convert frames between both forms
+    DcmSegTypes::BinaryRuns runs;
+    OFCHECK(sparse->getFrameRuns(2, runs).good());
+    FGFrameContent fracon;
+    OFCHECK(fracon.setStackID("1").good());
+    OFCHECK(fracon.setInStackPositionNumber(7).good());
+    OFVector<FGBase*> groups;
+    groups.push_back(&fracon);
+    OFCHECK(sparse->addFrame(runs, 1, groups).good());
+    OFCHECK(dense->addFrame(runs, 1, groups).good());
+    OFCHECK(sparse->addFrame(DcmSegTypes::BinaryRuns(), 1, groups).good());
+    OFCHECK_EQUAL(sparse->getNumberOfFrames(), NUM_FRAMES - 1);
+    OFCHECK(dense->setSparseFrames(OFTrue).good());
+    OFCHECK(sparse->setSparseFrames(OFFalse).good());
+    denseDataset.clear();
+    sparseDataset.clear();
+    OFCHECK(dense->writeDataset(denseDataset).good());
+    OFCHECK(sparse->writeDataset(sparseDataset).good());
+    OFCHECK(denseDataset.compare(sparseDataset) == 0);
+
+    // Invalid runs are rejected without adding any functional group
+    runs.back().length = OFstatic_cast(Uint32, NUM_PIXELS);
+    OFCHECK(sparse->addFrame(runs, 1, groups).bad());
+    OFCHECK(sparse->getFunctionalGroups().get(OFstatic_cast(Uint32, NUM_FRAMES - 1), DcmFGTypes::EFG_FRAMECONTENT)
+            == NULL);
+    delete dense;
+    delete sparse;
+
+    // Read frames into sparse form and write them again
+    DcmSegmentation* loaded = NULL;
+    OFCHECK(DcmSegmentation::loadDataset(denseDataset, loaded, OFTrue).good());
+    OFCHECK(loaded != OFnullptr);
+    if (loaded)
+    {
+        OFCHECK(loaded->getSparseFrames());
+        OFCHECK(loaded->getFrameRuns(NUM_FRAMES - 2, runs).good());
+        Uint8 pixels[NUM_PIXELS];
+        for (size_t i = 0; i < NUM_PIXELS; i++)
+            pixels[i] = pixel(3, i);
+        OFCHECK(sameRuns(runs, referenceRuns(pixels, NUM_PIXELS)));
+        loaded->setCheckFGOnWrite(OFFalse);
+        loaded->setCheckDimensionsOnWrite(OFFalse);
+        DcmDataset loadedDataset;
+        OFCHECK(loaded->writeDataset(loadedDataset).good());
+        OFCHECK(loadedDataset.compare(denseDataset) == 0);
+        delete loaded;
+    }
+}
@@ -70,3 +70,96 @@ OFTEST(dcmseg_utils)
     OFCHECK(buf[2] == 31);  // 00011111
     OFCHECK(buf[3] == 0);
 }
+
+// Reference implementation shifting bit by bit, see alignFrameOnBitPosition()
+static void alignOnBitPositionRef(Uint8* buf, const size_t length, const Uint8 numBits)
+{
+    Uint8 carryOver = 0;
+    for (size_t x = 0; x < length; x++)
+    {
+        Uint8 current = buf[x];
+        buf[x]        = OFstatic_cast(Uint8, (current << numBits) | carryOver);
+        carryOver     = OFstatic_cast(Uint8, current >> (8 - numBits));
+    }
+}
+
+// Reference implementation shifting bit by bit, see alignFrameOnByteBoundary()
+static void alignOnByteBoundaryRef(Uint8* buf, const size_t length, const Uint8 numBits)
+{
+    for (size_t x = 0; x < length - 1; x++)
+        buf[x] = OFstatic_cast(Uint8, (buf[x] >> numBits) | (buf[x + 1] << (8 - numBits)));
+    buf[length - 1] = OFstatic_cast(Uint8, buf[length - 1] >> numBits);
+}
+
+OFTEST(dcmseg_utils_pack)
+{
+    // 3 frames with 7x5 pixels, i.e. frames do not end on byte boundary
+    const Uint16 rows      = 7;
+    const Uint16 cols      = 5;
+    const size_t numPixels = rows * cols;
+    const size_t numFrames = 3;
+    Uint8 pixels[numFrames * numPixels];
+    for (size_t i = 0; i < numFrames * numPixels; i++)
+        pixels[i] = OFstatic_cast(Uint8, (i % 3 == 0) || (i % 7 == 1) ? i : 0);
+
+    // Pack whole buffer and compare against bitwise packing
+    const size_t numBytes = DcmSegUtils::getBytesForBinaryFrame(numFrames * numPixels);
+    Uint8 packed[14];
+    OFCHECK(numBytes == sizeof(packed));
+    DcmSegUtils::packBinaryPixels(pixels, numFrames * numPixels, packed);
+    for (size_t i = 0; i < numFrames * numPixels; i++)
+        OFCHECK(((packed[i / 8] >> (i % 8)) & 1) == (pixels[i] != 0));
+    OFCHECK((packed[numBytes - 1] >> ((numFrames * numPixels) % 8)) == 0);
+
+    // Unpack again
+    Uint8 unpacked[numFrames * numPixels];
+    DcmSegUtils::unpackBinaryPixels(packed, numFrames * numPixels, unpacked);
+    for (size_t i = 0; i < numFrames * numPixels; i++)
+        OFCHECK(unpacked[i] == (pixels[i] != 0));
+
+    // Pack and unpack all frames at once
+    OFVector<DcmIODTypes::Frame*> frames;
+    OFCHECK(DcmSegUtils::packBinaryFrames(pixels, numFrames, rows, cols, frames).good());
+    OFCHECK(frames.size() == numFrames);
+    for (size_t f = 0; f < frames.size(); f++)
+    {
+        DcmIODTypes::Frame* frame = DcmSegUtils::packBinaryFrame(pixels + f * numPixels, rows, cols);
+        OFCHECK(frame != NULL);
+        if (frame)
+        {
+            OFCHECK(frame->length == frames[f]->length);
+            OFCHECK(memcmp(frame->pixData, frames[f]->pixData, frame->length) == 0);
+            delete frame;
+        }
+    }
+    memset(unpacked, 0xff, sizeof(unpacked));
+    OFCHECK(DcmSegUtils::unpackBinaryFrames(frames, rows, cols, unpacked).good());
+    for (size_t i = 0; i < numFrames * numPixels; i++)
+        OFCHECK(unpacked[i] == (pixels[i] != 0));
+    DcmIODUtil::freeContainer(frames);
+}
+
+OFTEST(dcmseg_utils_align)
+{
+    // Compare with bitwise reference implementation, for buffers processed
+    // partly or completely word by word
+    Uint8 buf[37];
+    Uint8 ref[37];
+    for (size_t length = 1; length <= sizeof(buf); length += 4)
+    {
+        for (Uint8 numBits = 0; numBits < 8; numBits++)
+        {
+            for (size_t i = 0; i < length; i++)
+                buf[i] = ref[i] = OFstatic_cast(Uint8, i * 73 + 41);
+            DcmSegUtils::alignFrameOnBitPosition(buf, length, numBits);
+            alignOnBitPositionRef(ref, length, numBits);
+            OFCHECK(memcmp(buf, ref, length) == 0);
+
+            for (size_t i = 0; i < length; i++)
+                buf[i] = ref[i] = OFstatic_cast(Uint8, i * 73 + 41);
+            DcmSegUtils::alignFrameOnByteBoundary(buf, length, numBits);
+            alignOnByteBoundaryRef(ref, length, numBits);
+            OFCHECK(memcmp(buf, ref, length) == 0);
+        }
+    }
+}
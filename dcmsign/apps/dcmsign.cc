@@ -60,6 +60,12 @@ static char rcsid[] = "$dcmtk: " OFFIS_CONSOLE_APPLICATION " v"
 BEGIN_EXTERN_C
 #include <openssl/x509.h>
 #include <openssl/evp.h> /* for OPENSSL_NO_EC */
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>   /* required for sys/stat.h */
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>    /* for stat */
+#endif
 END_EXTERN_C
 
 
@@ -79,6 +85,23 @@ enum DcmSignOperation
 #define SHORTCOL 4
 #define LONGCOL 21
 
+/* check whether the output file is provably not the same file as the input file,
+ * i.e. it does not exist yet or it is located on another device or has another
+ * file serial number. Different paths may refer to the same file (e.g. links).
+ */
+static OFBool isDifferentFile(const char *ifname, const char *ofname)
+{
+  struct stat istat;
+  struct stat ostat;
+  if (stat(ofname, &ostat) != 0)
+    return OFTrue;       // output file does not exist yet
+  if (stat(ifname, &istat) != 0)
+    return OFFalse;      // cannot be proven
+  /* file serial numbers are not available on all systems (e.g. always 0) */
+  return (istat.st_dev != ostat.st_dev) || (istat.st_ino != ostat.st_ino);
+}
+
+
 int main(int argc, char *argv[])
 {
   DcmSignature::initializeLibrary(); // initialize dcmsign
@@ -785,9 +808,22 @@ int main(int argc, char *argv[])
       goto cleanup;
     }
   }
-  // need to load all data into memory before signing the document,
-  // otherwise the pixel data would be empty for compressed images
-  fileformat.loadAllDataIntoMemory();
+  // Large attribute values (such as pixel data) are not loaded into memory
+  // here. The MAC computation reads them from the input file in large chunks,
+  // and so does saveFile() when the output file is created. We only need to
+  // load all data into memory if the input file might be overwritten.
+  // Also, we need to load all data into memory for compressed images,
+  // otherwise the pixel data would be empty.
+  if (DcmXfer(dataset->getOriginalXfer()).isEncapsulated())
+  {
+    DCMSIGN_DEBUG("input file uses encapsulated transfer syntax, loading all data into memory");
+    fileformat.loadAllDataIntoMemory();
+  }
+  else if (opt_ofname && !isDifferentFile(opt_ifname, opt_ofname))
+  {
+    DCMSIGN_DEBUG("output file might be identical to input file, loading all data into memory");
+    fileformat.loadAllDataIntoMemory();
+  }
   // select transfer syntax in which digital signatures are created
   opt_signatureXfer = dataset->getOriginalXfer();
   // use Little Endian Explicit for uncompressed files
@@ -16,7 +16,7 @@
  *  Author: Marco Eichelberg
  *
  *  Purpose:
- *    classes: SiMACConstructor
+ *    classes: SiMACConsumer, SiMACOutputStream, SiMACConstructor
  *
  */
 
@@ -28,7 +28,7 @@
 #ifdef WITH_OPENSSL
 
 #include "dcmtk/dcmsign/sitypes.h"
-#include "dcmtk/dcmdata/dcostrmb.h"  /* for DcmOutputBufferStream */
+#include "dcmtk/dcmdata/dcostrma.h"  /* for DcmOutputStream */
 #include "dcmtk/dcmdata/dcxfer.h"    /* for E_TransferSyntax */
 #include "dcmtk/dcmdata/dcdeftag.h"
 
@@ -37,6 +37,150 @@ class DcmItem;
 class DcmElement;
 class DcmAttributeTag;
 
+/** consumer class that feeds all data written to it directly into a MAC.
+ *  Small blocks (such as tag and length fields) are collected in an internal
+ *  buffer, while large blocks (such as attribute values read from file in
+ *  large chunks) are passed to the MAC without being copied. The consumer never
+ *  causes I/O suspension, i.e. avail() always reports enough space for the
+ *  next element.
+ *  @remark this class is only available if DCMTK is compiled with
+ *  OpenSSL support enabled.
+ */
+class DCMTK_DCMSIGN_EXPORT SiMACConsumer: public DcmConsumer
+{
+public:
+
+  /** constructor
+   *  @param blockSize size of the internal buffer for small blocks, in bytes
+   */
+  SiMACConsumer(offile_off_t blockSize);
+
+  /// destructor
+  virtual ~SiMACConsumer();
+
+  /** sets the MAC into which all data is fed. Pending data in the internal
+   *  buffer should be flushed before the MAC is changed.
+   *  @param mac pointer to MAC, may be NULL
+   */
+  void setMAC(SiMAC *mac);
+
+  /** dump all data that is fed into the MAC algorithm into the given file,
+   *  which must be opened and closed by caller.
+   *  @param f pointer to file already opened for writing; may be NULL.
+   */
+  void setDumpFile(FILE *f);
+
+  /** returns the status of the consumer. Unless the status is good,
+   *  the consumer will not permit any operation.
+   *  @return status, true if good
+   */
+  virtual OFBool good() const;
+
+  /** returns the status of the consumer as an OFCondition object.
+   *  Unless the status is good, the consumer will not permit any operation.
+   *  @return status, EC_Normal if good
+   */
+  virtual OFCondition status() const;
+
+  /** returns true if the consumer is flushed, i.e. has no more data
+   *  pending in it's internal state that needs to be fed into the MAC.
+   *  @return true if consumer is flushed, false otherwise
+   */
+  virtual OFBool isFlushed() const;
+
+  /** returns the minimum number of bytes that can be written with the
+   *  next call to write(). Since all data is fed into the MAC immediately
+   *  or buffered, this is always a large number.
+   *  @return minimum of space available in consumer
+   */
+  virtual offile_off_t avail() const;
+
+  /** processes the given input block. Unless an error occurs,
+   *  all data is always consumed.
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen length of memory block
+   *  @return number of bytes actually processed.
+   */
+  virtual offile_off_t write(const void *buf, offile_off_t buflen);
+
+  /** feeds the content of the internal buffer into the MAC.
+   */
+  virtual void flush();
+
+private:
+
+  /// private undefined copy constructor
+  SiMACConsumer(const SiMACConsumer& arg);
+
+  /// private undefined copy assignment operator
+  SiMACConsumer& operator=(const SiMACConsumer& arg);
+
+  /** feeds the given block into the MAC and into the dump file, if any
+   *  @param buf pointer to memory block
+   *  @param buflen length of memory block
+   */
+  void digest(const unsigned char *buf, offile_off_t buflen);
+
+  /// the MAC into which data is fed, may be NULL
+  SiMAC *mac_;
+
+  /// if nonzero, the data fed to the MAC is also stored in this file
+  FILE *dumpFile_;
+
+  /// buffer for small blocks
+  unsigned char *buffer_;
+
+  /// size of the buffer, in bytes
+  offile_off_t bufSize_;
+
+  /// number of bytes filled in buffer
+  offile_off_t filled_;
+
+  /// status
+  OFCondition status_;
+};
+
+
+/** output stream that feeds all data written to it into a MAC.
+ *  @remark this class is only available if DCMTK is compiled with
+ *  OpenSSL support enabled.
+ */
+class DCMTK_DCMSIGN_EXPORT SiMACOutputStream: public DcmOutputStream
+{
+public:
+
+  /** constructor
+   *  @param blockSize size of the internal buffer for small blocks, in bytes
+   */
+  SiMACOutputStream(offile_off_t blockSize);
+
+  /// destructor
+  virtual ~SiMACOutputStream();
+
+  /** sets the MAC into which all data is fed.
+   *  @param mac pointer to MAC, may be NULL
+   */
+  void setMAC(SiMAC *mac);
+
+  /** dump all data that is fed into the MAC algorithm into the given file,
+   *  which must be opened and closed by caller.
+   *  @param f pointer to file already opened for writing; may be NULL.
+   */
+  void setDumpFile(FILE *f);
+
+private:
+
+  /// private undefined copy constructor
+  SiMACOutputStream(const SiMACOutputStream& arg);
+
+  /// private undefined copy assignment operator
+  SiMACOutputStream& operator=(const SiMACOutputStream& arg);
+
+  /// the final consumer of the filter chain
+  SiMACConsumer consumer_;
+};
+
+
 /** a class that allows to feed selected parts of a DICOM dataset into the MAC generation code
  *  @remark this class is only available if DCMTK is compiled with
  *  OpenSSL support enabled.
@@ -148,6 +292,9 @@ private:
 
   /** feeds a DcmElement into the MAC data stream if is signable.
    *  If the element is a sequence, all signable elements from all items are added.
+   *  Attribute values that have not been loaded into memory are read from file
+   *  in chunks of up to SiMACConstructor_ChunkSize bytes and fed into the
+   *  MAC directly, without loading the complete value.
    *  @param element pointer to element, must not be NULL
    *  @param mac MAC to use
    *  @param oxfer transfer syntax in which data is encoded
@@ -165,16 +312,8 @@ private:
    */
   static OFBool inTagList(const DcmElement *element, DcmAttributeTag *tagList);
 
-  /// the buffer to which data is written
-  unsigned char *buf;
-
-  /// the internal buffer stream
-  DcmOutputBufferStream stream;
-
-  /** if nonzero, the data fed to the MAC algorithm
-   *  is also stored in this file.
-   */
-  FILE *dumpFile;
+  /// the output stream feeding the MAC (and the dump file, if any)
+  SiMACOutputStream stream;
 };
 
 
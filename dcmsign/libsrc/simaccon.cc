@@ -33,56 +33,168 @@
 // block size used for the memory buffer
 #define SiMACConstructor_BlockSize 16384
 
+// maximum chunk size used when reading attribute values from file
+#define SiMACConstructor_ChunkSize 4194304
 
-SiMACConstructor::SiMACConstructor()
-: buf(new unsigned char[SiMACConstructor_BlockSize])
-, stream(buf, SiMACConstructor_BlockSize)
-, dumpFile(NULL)
+
+SiMACConsumer::SiMACConsumer(offile_off_t blockSize)
+: DcmConsumer()
+, mac_(NULL)
+, dumpFile_(NULL)
+, buffer_(new unsigned char[OFstatic_cast(size_t, blockSize)])
+, bufSize_(blockSize)
+, filled_(0)
+, status_(EC_Normal)
 {
 }
 
+SiMACConsumer::~SiMACConsumer()
+{
+  delete[] buffer_;
+}
 
-SiMACConstructor::~SiMACConstructor()
+void SiMACConsumer::setMAC(SiMAC *mac)
 {
-  delete[] buf;
+  mac_ = mac;
 }
 
-void SiMACConstructor::setDumpFile(FILE *f)
+void SiMACConsumer::setDumpFile(FILE *f)
 {
-  dumpFile = f;
+  dumpFile_ = f;
 }
 
+OFBool SiMACConsumer::good() const
+{
+  return status_.good();
+}
 
-OFCondition SiMACConstructor::flushBuffer(SiMAC& mac)
+OFCondition SiMACConsumer::status() const
 {
-  OFCondition result = EC_Normal;
-  void *bufptr = NULL;
-  offile_off_t bufLen = 0;
-  stream.flushBuffer(bufptr, bufLen);
-  if (bufLen > 0)
+  return status_;
+}
+
+OFBool SiMACConsumer::isFlushed() const
+{
+  return (filled_ == 0);
+}
+
+offile_off_t SiMACConsumer::avail() const
+{
+  // we never suspend, all data is either buffered or fed into the MAC
+  return OFstatic_cast(offile_off_t, 0x7FFFFFFF);
+}
+
+offile_off_t SiMACConsumer::write(const void *buf, offile_off_t buflen)
+{
+  if (buf == NULL || buflen == 0 || status_.bad()) return 0;
+  const unsigned char *data = OFstatic_cast(const unsigned char *, buf);
+  if (filled_ + buflen <= bufSize_)
   {
-    if (dumpFile)
+    // small block, collect in buffer
+    memcpy(buffer_ + filled_, data, OFstatic_cast(size_t, buflen));
+    filled_ += buflen;
+  }
+  else
+  {
+    // large block, feed pending data and the block itself into the MAC
+    flush();
+    digest(data, buflen);
+  }
+  return status_.good() ? buflen : 0;
+}
+
+void SiMACConsumer::flush()
+{
+  if (filled_ > 0)
+  {
+    digest(buffer_, filled_);
+    filled_ = 0;
+  }
+}
+
+void SiMACConsumer::digest(const unsigned char *buf, offile_off_t buflen)
+{
+  if (status_.bad()) return;
+  if (mac_ == NULL)
+  {
+    status_ = EC_IllegalCall;
+    return;
+  }
+  if (dumpFile_)
+  {
+    if (fwrite(buf, 1, OFstatic_cast(size_t, buflen), dumpFile_) != OFstatic_cast(size_t, buflen))
     {
-      if (fwrite(bufptr, 1, OFstatic_cast(size_t, bufLen), dumpFile) != OFstatic_cast(size_t, bufLen))
-      {
-        // We are apparently unable to write the byte stream to a dump file.
-        // This does not prevent us, however, from creating a valid digital signature.
-        // Therefore, issue a warning but continue.
-        DCMSIGN_WARN("Write error while dumping byte stream to file");
-      }
+      // We are apparently unable to write the byte stream to a dump file.
+      // This does not prevent us, however, from creating a valid digital signature.
+      // Therefore, issue a warning but continue.
+      DCMSIGN_WARN("Write error while dumping byte stream to file");
     }
-    result = mac.digest((unsigned char *)bufptr, (unsigned long)bufLen);
   }
-  return result;
+  status_ = mac_->digest(buf, OFstatic_cast(unsigned long, buflen));
+}
+
+/* ======================================================================= */
+
+SiMACOutputStream::SiMACOutputStream(offile_off_t blockSize)
+: DcmOutputStream(&consumer_) // safe because DcmOutputStream only stores pointer
+, consumer_(blockSize)
+{
+}
+
+SiMACOutputStream::~SiMACOutputStream()
+{
+}
+
+void SiMACOutputStream::setMAC(SiMAC *mac)
+{
+  consumer_.setMAC(mac);
+}
+
+void SiMACOutputStream::setDumpFile(FILE *f)
+{
+  consumer_.setDumpFile(f);
+}
+
+/* ======================================================================= */
+
+SiMACConstructor::SiMACConstructor()
+: stream(SiMACConstructor_BlockSize)
+{
+}
+
+
+SiMACConstructor::~SiMACConstructor()
+{
+}
+
+void SiMACConstructor::setDumpFile(FILE *f)
+{
+  stream.setDumpFile(f);
+}
+
+
+OFCondition SiMACConstructor::flushBuffer(SiMAC& mac)
+{
+  stream.setMAC(&mac);
+  stream.flush();
+  return stream.status();
 }
 
 
 OFCondition SiMACConstructor::encodeElement(DcmElement *element, SiMAC& mac, E_TransferSyntax oxfer)
 {
   if (element == NULL) return EC_IllegalCall;
-  DcmWriteCache wcache;
+
+  // values that reside in file are read through the write cache. Use large
+  // chunks for large values, which are then fed into the MAC without copying.
+  Uint32 chunkSize = SiMACConstructor_ChunkSize;
+  if (element->isLeaf() && (element->getLength() < chunkSize)) chunkSize = element->getLength();
+  if (chunkSize < DcmWriteCacheBufsize) chunkSize = DcmWriteCacheBufsize;
+  DcmWriteCache wcache(chunkSize);
+
   OFCondition result = EC_Normal;
   OFBool last = OFFalse;
+  stream.setMAC(&mac);
   element->transferInit();
   while (!last)
   {
@@ -100,13 +212,7 @@ OFCondition SiMACConstructor::encodeElement(DcmElement *element, SiMAC& mac, E_T
 
 OFCondition SiMACConstructor::flush(SiMAC& mac)
 {
-  OFCondition result = EC_Normal;
-  while (! stream.isFlushed() && result.good())
-  {
-    stream.flush();
-    result = flushBuffer(mac);
-  }
-  return result;
+  return flushBuffer(mac);
 }
 
 
@@ -0,0 +1,260 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module: dcmsign
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: Benchmark for signing and verifying large DICOM objects
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#ifdef WITH_OPENSSL
+
+#include "dcmtk/ofstd/ofconapp.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/offile.h"
+#include "dcmtk/ofstd/oftimer.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmsign/dcsignat.h"
+#include "dcmtk/dcmsign/simdmac.h"
+#include "dcmtk/dcmsign/sinullpr.h"
+#include "dcmtk/dcmsign/siprivat.h"
+#include "dcmtk/dcmsign/sicert.h"
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+BEGIN_EXTERN_C
+#include <openssl/x509.h>
+END_EXTERN_C
+
+#define OFFIS_CONSOLE_APPLICATION "sibench"
+
+static OFLogger sibenchLogger = OFLog::getLogger("dcmtk.tests." OFFIS_CONSOLE_APPLICATION);
+
+static char rcsid[] = "$dcmtk: " OFFIS_CONSOLE_APPLICATION " v"
+  OFFIS_DCMTK_VERSION " " OFFIS_DCMTK_RELEASEDATE " $";
+
+#define SHORTCOL 3
+#define LONGCOL 14
+
+// dimensions of the generated frames
+#define FRAME_ROWS 512
+#define FRAME_COLUMNS 512
+#define FRAME_SIZE (FRAME_ROWS * FRAME_COLUMNS * 2)
+
+/* print the peak resident set size of this process, if available */
+static void printPeakMemory()
+{
+#if defined(HAVE_SYS_RESOURCE_H) && defined(HAVE_GETRUSAGE)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    // ru_maxrss is given in kilobytes on Linux and in bytes on macOS
+#ifdef __APPLE__
+    OFLOG_INFO(sibenchLogger, "  peak resident set size: " << usage.ru_maxrss / (1024 * 1024) << " MB");
+#else
+    OFLOG_INFO(sibenchLogger, "  peak resident set size: " << usage.ru_maxrss / 1024 << " MB");
+#endif
+  }
+#endif
+}
+
+/* print the throughput of an operation on the given number of bytes */
+static void printThroughput(const char *operation, double seconds, Uint32 numBytes)
+{
+  const double megabytes = OFstatic_cast(double, numBytes) / (1024.0 * 1024.0);
+  OFLOG_INFO(sibenchLogger, operation << ": " << seconds << " s"
+    << ((seconds > 0) ? ", " : "")
+    << ((seconds > 0) ? megabytes / seconds : 0.0)
+    << ((seconds > 0) ? " MB/s" : ""));
+  printPeakMemory();
+}
+
+/* write a multi-frame test image with the given number of frames.
+ * The dataset is saved without pixel data, and the pixel data element
+ * is then appended in chunks, so that no full copy is held in memory.
+ */
+static OFCondition createTestFile(const char *filename, Uint32 numberOfFrames)
+{
+  char uid[100];
+  DcmFileFormat fileformat;
+  DcmDataset *dataset = fileformat.getDataset();
+  dataset->putAndInsertString(DCM_SOPClassUID, UID_MultiframeGrayscaleWordSecondaryCaptureImageStorage);
+  dataset->putAndInsertString(DCM_SOPInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+  dataset->putAndInsertString(DCM_StudyInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_STUDY_UID_ROOT));
+  dataset->putAndInsertString(DCM_SeriesInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_SERIES_UID_ROOT));
+  dataset->putAndInsertString(DCM_Modality, "OT");
+  dataset->putAndInsertString(DCM_PatientName, "Benchmark^Signature");
+  dataset->putAndInsertUint16(DCM_SamplesPerPixel, 1);
+  dataset->putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2");
+  OFOStringStream str;
+  str << numberOfFrames << OFStringStream_ends;
+  OFSTRINGSTREAM_GETSTR(str, frames)
+  dataset->putAndInsertString(DCM_NumberOfFrames, frames);
+  OFSTRINGSTREAM_FREESTR(frames)
+  dataset->putAndInsertUint16(DCM_Rows, FRAME_ROWS);
+  dataset->putAndInsertUint16(DCM_Columns, FRAME_COLUMNS);
+  dataset->putAndInsertUint16(DCM_BitsAllocated, 16);
+  dataset->putAndInsertUint16(DCM_BitsStored, 16);
+  dataset->putAndInsertUint16(DCM_HighBit, 15);
+  dataset->putAndInsertUint16(DCM_PixelRepresentation, 0);
+  OFCondition result = fileformat.saveFile(filename, EXS_LittleEndianExplicit);
+  if (result.bad()) return result;
+
+  OFFile file;
+  if (!file.fopen(filename, "ab")) return EC_InvalidStream;
+
+  // tag (7FE0,0010), VR "OW", two reserved bytes and 32-bit length, little endian
+  const Uint32 length = numberOfFrames * FRAME_SIZE;
+  const unsigned char header[12] = {
+    0xE0, 0x7F, 0x10, 0x00, 'O', 'W', 0x00, 0x00,
+    OFstatic_cast(unsigned char, length & 0xFF),
+    OFstatic_cast(unsigned char, (length >> 8) & 0xFF),
+    OFstatic_cast(unsigned char, (length >> 16) & 0xFF),
+    OFstatic_cast(unsigned char, (length >> 24) & 0xFF)
+  };
+  if (file.fwrite(header, 1, sizeof(header)) != sizeof(header)) result = EC_InvalidStream;
+
+  Uint8 *frame = new Uint8[FRAME_SIZE];
+  for (Uint32 i = 0; (i < numberOfFrames) && result.good(); ++i)
+  {
+    for (size_t j = 0; j < FRAME_SIZE; ++j)
+      frame[j] = OFstatic_cast(Uint8, (i + j) & 0xFF);
+    if (file.fwrite(frame, 1, FRAME_SIZE) != FRAME_SIZE) result = EC_InvalidStream;
+  }
+  delete[] frame;
+  if (file.fclose() != 0) result = EC_InvalidStream;
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  const char *opt_keyfile = NULL;
+  const char *opt_certfile = NULL;
+  const char *opt_passwd = NULL;
+  const char *opt_filename = "sibench.dcm";
+  OFCmdUnsignedInt opt_size = 1024;
+  OFBool opt_loadAll = OFFalse;
+  OFBool opt_keepFile = OFFalse;
+
+  DcmSignature::initializeLibrary();
+  OFConsoleApplication app(OFFIS_CONSOLE_APPLICATION, "Benchmark signing and verifying large DICOM objects", rcsid);
+  OFCommandLine cmd;
+  cmd.setOptionColumns(LONGCOL, SHORTCOL);
+  cmd.setParamColumn(LONGCOL + SHORTCOL + 4);
+  cmd.addParam("keyfile", "private key file (PEM format)");
+  cmd.addParam("certfile", "certificate file (PEM format)");
+
+  cmd.addGroup("options:");
+  cmd.addOption("--help",       "-h",    "print this help text and exit", OFCommandLine::AF_Exclusive);
+  OFLog::addOptions(cmd);
+  cmd.addOption("--size",       "-s", 1, "[m]egabytes: integer (1..4095, default: 1024)",
+                                         "size of the pixel data to be signed");
+  cmd.addOption("--file",       "-f", 1, "[f]ilename: string (default: sibench.dcm)",
+                                         "name of the temporary test file");
+  cmd.addOption("--password",   "-p", 1, "[p]assword: string",
+                                         "password for the private key");
+  cmd.addOption("--load-all",   "+m",    "load all data into memory before signing");
+  cmd.addOption("--keep-file",  "+k",    "do not delete the test file at the end");
+
+  prepareCmdLineArgs(argc, argv, OFFIS_CONSOLE_APPLICATION);
+  if (app.parseCommandLine(cmd, argc, argv))
+  {
+    cmd.getParam(1, opt_keyfile);
+    cmd.getParam(2, opt_certfile);
+    if (cmd.findOption("--size")) app.checkValue(cmd.getValueAndCheckMinMax(opt_size, 1, 4095));
+    if (cmd.findOption("--file")) app.checkValue(cmd.getValue(opt_filename));
+    if (cmd.findOption("--password")) app.checkValue(cmd.getValue(opt_passwd));
+    if (cmd.findOption("--load-all")) opt_loadAll = OFTrue;
+    if (cmd.findOption("--keep-file")) opt_keepFile = OFTrue;
+    OFLog::configureFromCommandLine(cmd, app, OFLogger::INFO_LOG_LEVEL);
+  }
+
+  SiPrivateKey key;
+  SiCertificate cert;
+  if (opt_passwd) key.setPrivateKeyPasswd(opt_passwd);
+  OFCondition result = key.loadPrivateKey(opt_keyfile, X509_FILETYPE_PEM);
+  if (result.bad())
+  {
+    OFLOG_FATAL(sibenchLogger, result.text() << ": while loading private key file '" << opt_keyfile << "'");
+    return 1;
+  }
+  result = cert.loadCertificate(opt_certfile, X509_FILETYPE_PEM);
+  if (result.bad())
+  {
+    OFLOG_FATAL(sibenchLogger, result.text() << ": while loading certificate file '" << opt_certfile << "'");
+    return 1;
+  }
+
+  const Uint32 numberOfFrames = OFstatic_cast(Uint32, (opt_size * 1024 * 1024) / FRAME_SIZE);
+  const Uint32 numBytes = numberOfFrames * FRAME_SIZE;
+  OFLOG_INFO(sibenchLogger, "creating test file '" << opt_filename << "' with " << numberOfFrames
+    << " frames (" << numBytes / (1024 * 1024) << " MB pixel data)");
+  result = createTestFile(opt_filename, numberOfFrames);
+  if (result.bad())
+  {
+    OFLOG_FATAL(sibenchLogger, result.text() << ": while creating test file '" << opt_filename << "'");
+    return 1;
+  }
+
+  OFTimer timer;
+  DcmFileFormat fileformat;
+  result = fileformat.loadFile(opt_filename, EXS_Unknown, EGL_noChange, DCM_MaxReadLength);
+  if (result.good() && opt_loadAll) result = fileformat.loadAllDataIntoMemory();
+  if (result.good()) printThroughput("load", timer.getDiff(), opt_loadAll ? numBytes : 0);
+
+  DcmSignature signer;
+  if (result.good())
+  {
+    SiMDMAC mac(EMT_SHA256);
+    SiNullProfile profile;
+    signer.attach(fileformat.getDataset());
+    timer.reset();
+    result = signer.createSignature(key, cert, mac, profile, EXS_LittleEndianExplicit);
+    if (result.good()) printThroughput("sign", timer.getDiff(), numBytes);
+  }
+
+  if (result.good())
+  {
+    timer.reset();
+    result = signer.selectSignature(0);
+    if (result.good()) result = signer.verifyCurrent();
+    if (result.good()) printThroughput("verify", timer.getDiff(), numBytes);
+  }
+  signer.detach();
+
+  if (result.bad())
+  {
+    OFLOG_FATAL(sibenchLogger, result.text());
+  }
+  if (!opt_keepFile) OFStandard::deleteFile(opt_filename);
+  DcmSignature::cleanupLibrary();
+  return result.good() ? 0 : 1;
+}
+
+#else /* WITH_OPENSSL */
+
+#include "dcmtk/ofstd/ofconsol.h"
+
+int main(int, char *[])
+{
+  CERR << "sibench: this program requires DCMTK to be compiled with OpenSSL support." << OFendl;
+  return 1;
+}
+
+#endif /* WITH_OPENSSL */
@@ -105,6 +105,11 @@ int main(int argc, char *argv[])
     cmd.addGroup("input options:");
       cmd.addSubGroup("encoding:");
         cmd.addOption("--template-envelope",   "+Ee",    "template element encloses content items");
+#ifdef LIBXML_READER_ENABLED
+      cmd.addSubGroup("parsing:");
+        cmd.addOption("--read-tree",           "+Rt",    "build complete XML tree in memory (default)");
+        cmd.addOption("--read-streamed",       "+Rs",    "read content items one after the other\n(less memory for large documents)");
+#endif
 
     cmd.addGroup("processing options:");
       cmd.addSubGroup("validation:");
@@ -184,6 +189,14 @@ int main(int argc, char *argv[])
         /* input options */
         if (cmd.findOption("--template-envelope"))
             opt_readFlags |= DSRTypes::XF_templateElementEnclosesItems;
+#ifdef LIBXML_READER_ENABLED
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--read-tree"))
+            opt_readFlags &= ~DSRTypes::XF_useStreamingParser;
+        if (cmd.findOption("--read-streamed"))
+            opt_readFlags |= DSRTypes::XF_useStreamingParser;
+        cmd.endOptionBlock();
+#endif
 
         /* processing options */
 #ifdef LIBXML_SCHEMAS_ENABLED
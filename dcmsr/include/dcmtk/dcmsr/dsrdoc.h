@@ -171,7 +171,9 @@ class DCMTK_DCMSR_EXPORT DSRDocument
     /** read SR document from XML file.
      *  The format (Schema) of the XML document is expected to conform to the output format
      *  of the writeXML() method.  In addition, the document can be validated against an XML
-     *  Schema by setting the flag DSRTypes::XF_validateSchema.
+     *  Schema by setting the flag DSRTypes::XF_validateSchema.  For large documents, the flag
+     *  DSRTypes::XF_useStreamingParser allows for reading the content items one after the
+     *  other instead of building the complete XML tree in memory.
      *  Digital signatures in the XML document are not yet supported.
      *  Please note that the current document is also deleted if the parsing process fails.
      ** @param  filename  name of the file from which the XML document is read ("-" for stdin)
@@ -33,6 +33,8 @@
 #include "dcmtk/dcmsr/dsrcitem.h"
 
 #include "dcmtk/ofstd/ofmem.h"
+#include "dcmtk/ofstd/ofmap.h"
+#include "dcmtk/ofstd/oflist.h"
 
 
 /*------------------------*
@@ -277,6 +279,11 @@ class DCMTK_DCMSR_EXPORT DSRDocumentSubTree
     /** set internal cursor to a named node.
      *  If more than one node exists with the given concept name, the first one will
      *  be selected.  Use gotoNextNamedNode() in order to go to the next matching node.
+     *  If the node index is enabled (see enableNodeIndex()) and the search starts from
+     *  the root node, the content item is looked up in an index of concept names instead
+     *  of iterating over the tree.  This index is updated when nodes are added or removed
+     *  and when a content item is accessed with getCurrentContentItem(), so changing the
+     *  concept name this way is also taken into account.
      ** @param  conceptName    concept name of the node to be searched for
      *  @param  startFromRoot  flag indicating whether to start from the root node or
      *                         the current one
@@ -809,8 +816,57 @@ class DCMTK_DCMSR_EXPORT DSRDocumentSubTree
 
   private:
 
+    /** set internal cursor to a named node using the node index (if enabled).
+     *  The index of concept names is created when needed.
+     ** @param  conceptName    concept name of the node to be searched for
+     *  @param  searchIntoSub  flag indicating whether to search into sub-trees or on the
+     *                         top-level only
+     ** @return ID of the new current node if found in the index, 0 otherwise
+     */
+    size_t gotoIndexedNamedNode(const DSRCodedEntryValue &conceptName,
+                                const OFBool searchIntoSub);
+
+    /** check whether the index of concept names exists and has to be kept up to date.
+     *  If the node index has been disabled in the meantime, the index of concept names
+     *  is cleared.
+     ** @return OFTrue if the index of concept names has to be updated, OFFalse otherwise
+     */
+    OFBool checkConceptNameIndex();
+
+    /** clear the index of concept names, i.e.\ create it again when needed
+     */
+    void clearConceptNameIndex();
+
+    /** add the given node (incl.\ all child nodes and following siblings) to the list of
+     *  nodes that still have to be added to the index of concept names
+     ** @param  node  pointer to the node to be added
+     */
+    void addToConceptNameIndex(DSRDocumentTreeNode *node);
+
+    /** remove the given node (incl.\ all child nodes but not its siblings) from the
+     *  index of concept names
+     ** @param  node  pointer to the node to be removed
+     */
+    void removeFromConceptNameIndex(DSRDocumentTreeNode *node);
+
+    /** add all pending nodes (see addToConceptNameIndex()) and the node referenced by
+     *  the current content item to the index of concept names.  The latter is required
+     *  since its concept name might have been changed using getCurrentContentItem().
+     ** @param  nodeIndex  node index of this tree, used to determine the document order
+     */
+    void updateConceptNameIndex(const DSRTreeNodeIndex<DSRDocumentTreeNode> &nodeIndex);
+
     /// current content item.  Introduced to avoid the external use of pointers.
     DSRContentItem CurrentContentItem;
+
+    /// ID of the node referenced by the current content item (0 if none)
+    size_t CurrentContentItemNodeID;
+
+    /// mapping from concept name to the IDs of all nodes using it (in document order)
+    OFMap<OFString, OFList<size_t> > ConceptNameIndex;
+
+    /// IDs of the nodes that still have to be added to the index of concept names
+    OFList<size_t> PendingConceptNameNodes;
 };
 
 
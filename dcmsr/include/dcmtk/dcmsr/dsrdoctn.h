@@ -49,6 +49,7 @@ class DCMTK_DCMSR_EXPORT DSRDocumentTreeNode
     // allow direct access to protected methods
     friend class DSRTree<DSRDocumentTreeNode>;
     friend class DSRTreeNodeCursor<DSRDocumentTreeNode>;
+    friend class DSRTreeNodeIndex<DSRDocumentTreeNode>;
     // also for the derived cursor classes
     friend class DSRDocumentTreeNodeCursor;
     friend class DSRIncludedTemplateNodeCursor;
@@ -548,6 +549,42 @@ class DCMTK_DCMSR_EXPORT DSRDocumentTreeNode
                                        const E_ValueType valueType,
                                        const DSRIODConstraintChecker *constraintChecker = NULL);
 
+    /** read child content items of a streamed XML document (one after the other)
+     ** @param  doc           document containing the XML file content (streamed)
+     *  @param  cursor        cursor pointing to the node of this content item
+     *  @param  documentType  type of the document to be read (used for debug output only)
+     *  @param  flags         flag used to customize the reading process (see DSRTypes::XF_xxx)
+     ** @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition readXMLStreamedChildNodes(const DSRXMLDocument &doc,
+                                          const DSRXMLCursor &cursor,
+                                          const E_DocumentType documentType,
+                                          const size_t flags);
+
+    /** create a new child node for the given XML node, append it to the current one and let
+     *  it read its content.  XML nodes with an invalid value type are silently ignored.
+     ** @param  doc                 document containing the XML file content
+     *  @param  cursor              cursor pointing to the XML node of the child content item
+     *  @param  node                reference to the pointer to the previous child node (NULL
+     *                              for the first one), updated by this method
+     *  @param  documentType        type of the document to be read (used for debug output only)
+     *  @param  flags               flag used to customize the reading process (see
+     *                              DSRTypes::XF_xxx)
+     *  @param  templateIdentifier  template identifier (only used with
+     *                              DSRTypes::XF_templateElementEnclosesItems)
+     *  @param  mappingResource     mapping resource that defines the template (see above)
+     *  @param  mappingResourceUID  uniquely identifies the mapping resource (see above)
+     ** @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition readXMLChildNode(const DSRXMLDocument &doc,
+                                 const DSRXMLCursor &cursor,
+                                 DSRDocumentTreeNode *&node,
+                                 const E_DocumentType documentType,
+                                 const size_t flags,
+                                 const OFString &templateIdentifier,
+                                 const OFString &mappingResource,
+                                 const OFString &mappingResourceUID);
+
     /** read content item (value) from dataset.
      *  This method does nothing for this base class, but derived classes overwrite it to read
      *  the contents according to their value type.
@@ -122,9 +122,12 @@ class DCMTK_DCMSR_EXPORT DSRDocumentTree
     virtual OFCondition write(DcmItem &dataset,
                               DcmStack *markedItems = NULL);
 
-    /** read XML document tree
+    /** read XML document tree.
+     *  If the XML document is streamed (see DSRXMLDocument::isStreamed()), the content items
+     *  are read one after the other, i.e. without the complete XML tree being in memory.
      ** @param  doc     document containing the XML file content
-     *  @param  cursor  cursor pointing to the starting node
+     *  @param  cursor  cursor pointing to the starting node, i.e.\ the first child of the
+     *                  "content" element (or the "content" element itself if streamed)
      *  @param  flags   flag used to customize the reading process (see DSRTypes::XF_xxx)
      ** @return status, EC_Normal if successful, an error code otherwise
      */
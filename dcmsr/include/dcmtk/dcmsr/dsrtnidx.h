@@ -0,0 +1,382 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module: dcmsr
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose:
+ *    classes: DSRTreeNodeIndex
+ *
+ */
+
+
+#ifndef DSRTNIDX_H
+#define DSRTNIDX_H
+
+#include "dcmtk/config/osconfig.h"   /* make sure OS specific configuration is included first */
+
+#include "dcmtk/dcmsr/dsrtypes.h"
+#include "dcmtk/dcmsr/dsrposcn.h"
+
+#include "dcmtk/ofstd/ofvector.h"
+
+
+/*-----------------------*
+ *  forward declaration  *
+ *-----------------------*/
+
+class DSRTreeNode;
+
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Class implementing an index for the nodes of a tree.
+ *  The index maps the node ID and the position string of each node to the node itself
+ *  (see DSRTreeNodeCursor::getPosition() for the format of the position string).  It
+ *  allows for finding a particular node without iterating over the tree, which is
+ *  important for large trees where the same search is performed many times, e.g. when
+ *  resolving by-reference relationships.  Internally, hash tables are used, so the time
+ *  needed for finding a node does not depend on the size of the tree.  Please note that
+ *  the index is not updated automatically, i.e. it has to be cleared or rebuilt whenever
+ *  the tree is modified.
+ ** @tparam  T  template type used for the tree node pointers
+ */
+template<typename T = DSRTreeNode>
+class DSRTreeNodeIndex
+{
+
+  public:
+
+    /** Structure storing the details on an indexed tree node
+     */
+    struct Entry
+    {
+        /** default constructor
+         */
+        Entry()
+          : Node(NULL),
+            ParentID(0),
+            Position(),
+            PositionString()
+        {
+        }
+
+        /// pointer to the tree node
+        T *Node;
+        /// ID of the parent node, 0 for nodes on the top-level
+        size_t ParentID;
+        /// position of the tree node (as determined by the cursor used for building)
+        DSRPositionCounter Position;
+        /// position string of the tree node (cached value of 'Position')
+        OFString PositionString;
+    };
+
+    /** default constructor
+     */
+    DSRTreeNodeIndex();
+
+    /** clear all member variables, i.e.\ remove all nodes from the index
+     */
+    void clear();
+
+    /** check whether the index is empty
+     ** @return OFTrue if index is empty, OFFalse otherwise
+     */
+    inline OFBool isEmpty() const;
+
+    /** get number of nodes in the index
+     ** @return number of indexed nodes
+     */
+    inline size_t size() const;
+
+    /** build the index from the given cursor.
+     *  The index is cleared first, then all nodes reachable by iterating the given cursor
+     *  (including all sub-trees) are added.  The position strings are determined by the
+     *  position counter of the cursor, so the flags of this counter are taken into account.
+     ** @tparam  T_Cursor  template type used for the cursor iterating the tree
+     ** @param   cursor    cursor pointing to the first node to be indexed (usually the root)
+     ** @return number of indexed nodes
+     */
+    template<typename T_Cursor>
+    size_t build(T_Cursor cursor);
+
+    /** add a single node to the index.
+     *  This method can be used to keep the index up to date if a node is added to the tree
+     *  without changing the position of any other node, e.g. as the last child of a node.
+     *  Please note that pointers to index entries become invalid when adding a node.
+     ** @param  node      pointer to the tree node to be added (should not yet be indexed)
+     *  @param  parentID  ID of the parent node, 0 for nodes on the top-level
+     *  @param  position  position of the node
+     */
+    void addNode(T *node,
+                 const size_t parentID,
+                 const DSRPositionCounter &position);
+
+    /** find node with given ID
+     ** @param  nodeID  ID of the node to be searched for
+     ** @return pointer to index entry if found, NULL otherwise
+     */
+    const Entry *findNode(const size_t nodeID) const;
+
+    /** find node with given position string.
+     *  If more than one node has the same position (e.g. with included templates not being
+     *  counted), the first one in document order is returned.
+     ** @param  position  position string of the node to be searched for.  The format is
+     *                    e.g. "1.2.3" for the third child of the second child of the first
+     *                    node (see DSRTreeNodeCursor::getPosition()).
+     ** @return pointer to index entry if found, NULL otherwise
+     */
+    const Entry *findNode(const OFString &position) const;
+
+
+  protected:
+
+    /** compute hash value of the given position string
+     ** @param  position  position string
+     ** @return hash value
+     */
+    static size_t hashPosition(const OFString &position);
+
+    /** resize the hash tables and add all entries again
+     ** @param  tableSize  new number of slots in each hash table (power of 2)
+     */
+    void rehash(const size_t tableSize);
+
+    /** add an entry to the hash tables
+     ** @param  index  index of the entry to be added
+     */
+    void hashEntry(const size_t index);
+
+
+  private:
+
+    /// all index entries (in the order of insertion)
+    OFVector<Entry> Entries;
+    /// hash table for node IDs (index of first entry in each slot plus 1, 0 if empty)
+    OFVector<size_t> NodeIDTable;
+    /// hash table for position strings (index of first entry in each slot plus 1, 0 if empty)
+    OFVector<size_t> PositionTable;
+    /// next entry in the same slot of the node ID hash table (index plus 1, 0 if none)
+    OFVector<size_t> NextByNodeID;
+    /// next entry in the same slot of the position hash table (index plus 1, 0 if none)
+    OFVector<size_t> NextByPosition;
+};
+
+
+/*------------------*
+ *  implementation  *
+ *------------------*/
+
+template<typename T>
+DSRTreeNodeIndex<T>::DSRTreeNodeIndex()
+  : Entries(),
+    NodeIDTable(),
+    PositionTable(),
+    NextByNodeID(),
+    NextByPosition()
+{
+}
+
+
+template<typename T>
+void DSRTreeNodeIndex<T>::clear()
+{
+    Entries.clear();
+    NodeIDTable.clear();
+    PositionTable.clear();
+    NextByNodeID.clear();
+    NextByPosition.clear();
+}
+
+
+template<typename T>
+OFBool DSRTreeNodeIndex<T>::isEmpty() const
+{
+    return Entries.empty();
+}
+
+
+template<typename T>
+size_t DSRTreeNodeIndex<T>::size() const
+{
+    return Entries.size();
+}
+
+
+template<typename T>
+template<typename T_Cursor>
+size_t DSRTreeNodeIndex<T>::build(T_Cursor cursor)
+{
+    clear();
+    if (cursor.isValid())
+    {
+        /* iterate over all nodes (same order as a "deep search") */
+        do {
+            const T *parentNode = cursor.getParentNode();
+            addNode(cursor.getNode(), (parentNode != NULL) ? parentNode->getIdent() : 0, cursor.getPositionCounter());
+        } while (cursor.iterate());
+    }
+    return Entries.size();
+}
+
+
+template<typename T>
+void DSRTreeNodeIndex<T>::addNode(T *node,
+                                  const size_t parentID,
+                                  const DSRPositionCounter &position)
+{
+    if (node != NULL)
+    {
+        Entry entry;
+        entry.Node = node;
+        entry.ParentID = parentID;
+        entry.Position = position;
+        position.getString(entry.PositionString);
+        Entries.push_back(entry);
+        NextByNodeID.push_back(0);
+        NextByPosition.push_back(0);
+        /* keep the load factor of the hash tables below 1 */
+        if (Entries.size() > NodeIDTable.size())
+            rehash((NodeIDTable.size() > 0) ? 2 * NodeIDTable.size() : 64);
+        else
+            hashEntry(Entries.size() - 1);
+    }
+}
+
+
+template<typename T>
+const typename DSRTreeNodeIndex<T>::Entry *DSRTreeNodeIndex<T>::findNode(const size_t nodeID) const
+{
+    const Entry *entry = NULL;
+    if (!NodeIDTable.empty())
+    {
+        size_t index = NodeIDTable[nodeID & (NodeIDTable.size() - 1)];
+        while ((index > 0) && (entry == NULL))
+        {
+            if (Entries[index - 1].Node->getIdent() == nodeID)
+                entry = &Entries[index - 1];
+            else
+                index = NextByNodeID[index - 1];
+        }
+    }
+    return entry;
+}
+
+
+template<typename T>
+const typename DSRTreeNodeIndex<T>::Entry *DSRTreeNodeIndex<T>::findNode(const OFString &position) const
+{
+    const Entry *entry = NULL;
+    if (!position.empty() && !PositionTable.empty())
+    {
+        OFString positionString;
+        size_t posStart = 0;
+        size_t posEnd = 0;
+        size_t number = 0;
+        char buffer[32];
+        /* normalize the given string (same interpretation as DSRTreeNodeCursor::gotoNode) */
+        do {
+            posEnd = position.find('.', posStart);
+            if (posEnd == OFString_npos)
+                number = DSRTypes::stringToNumber(position.substr(posStart).c_str());
+            else {
+                number = DSRTypes::stringToNumber(position.substr(posStart, posEnd - posStart).c_str());
+                posStart = posEnd + 1;
+            }
+            if (number > 0)
+            {
+                if (!positionString.empty())
+                    positionString += '.';
+                positionString += DSRTypes::numberToString(number, buffer);
+            }
+        } while ((number > 0) && (posEnd != OFString_npos));
+        /* all segments need to be valid numbers */
+        if (number > 0)
+        {
+            size_t index = PositionTable[hashPosition(positionString) & (PositionTable.size() - 1)];
+            while ((index > 0) && (entry == NULL))
+            {
+                if (Entries[index - 1].PositionString == positionString)
+                    entry = &Entries[index - 1];
+                else
+                    index = NextByPosition[index - 1];
+            }
+        }
+    }
+    return entry;
+}
+
+
+// protected methods
+
+template<typename T>
+size_t DSRTreeNodeIndex<T>::hashPosition(const OFString &position)
+{
+    /* FNV-1a hash function */
+    size_t hash = 2166136261U;
+    const size_t length = position.length();
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= OFstatic_cast(unsigned char, position[i]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+
+template<typename T>
+void DSRTreeNodeIndex<T>::rehash(const size_t tableSize)
+{
+    NodeIDTable.clear();
+    NodeIDTable.resize(tableSize, 0);
+    PositionTable.clear();
+    PositionTable.resize(tableSize, 0);
+    /* add all entries again (in the order of insertion) */
+    const size_t count = Entries.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        NextByNodeID[i] = 0;
+        NextByPosition[i] = 0;
+        hashEntry(i);
+    }
+}
+
+
+template<typename T>
+void DSRTreeNodeIndex<T>::hashEntry(const size_t index)
+{
+    const Entry &entry = Entries[index];
+    /* node IDs are unique, so just add to the front of the slot */
+    size_t &nodeIDSlot = NodeIDTable[entry.Node->getIdent() & (NodeIDTable.size() - 1)];
+    NextByNodeID[index] = nodeIDSlot;
+    nodeIDSlot = index + 1;
+    /* the first node with a particular position string wins, i.e. add to the end */
+    size_t *positionSlot = &PositionTable[hashPosition(entry.PositionString) & (PositionTable.size() - 1)];
+    OFBool found = OFFalse;
+    while ((*positionSlot > 0) && !found)
+    {
+        /* position string already indexed? */
+        if (Entries[*positionSlot - 1].PositionString == entry.PositionString)
+            found = OFTrue;
+        else
+            positionSlot = &NextByPosition[*positionSlot - 1];
+    }
+    if (!found)
+        *positionSlot = index + 1;
+}
+
+
+#endif
@@ -28,8 +28,10 @@
 
 #include "dcmtk/dcmsr/dsrtypes.h"
 #include "dcmtk/dcmsr/dsrtncsr.h"
+#include "dcmtk/dcmsr/dsrtnidx.h"
 
 #include "dcmtk/ofstd/ofutil.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 
 /*-----------------------*
@@ -240,12 +242,35 @@ template<typename T = DSRTreeNode> class DSRTree
      */
     inline size_t getNextNodeID() const;
 
+    /** enable or disable the node index of this tree.
+     *  The node index maps the ID and the position string of each node to the node itself,
+     *  so gotoNode() can find a node without iterating over the tree when starting from the
+     *  root node.  The index is created when needed and kept up to date when nodes are added,
+     *  replaced or removed.  It is disabled by default since it requires additional memory.
+     ** @param  enable  enable node index if OFTrue, disable it otherwise
+     */
+    void enableNodeIndex(const OFBool enable = OFTrue);
+
+    /** check whether the node index of this tree is enabled
+     ** @return OFTrue if node index is enabled, OFFalse otherwise
+     */
+    inline OFBool isNodeIndexEnabled() const;
+
+    /** invalidate the node index of this tree (if enabled).
+     *  The index is recreated automatically the next time it is needed.  Usually, there is
+     *  no need to call this method since the index is invalidated or updated automatically
+     *  whenever the tree is modified.
+     */
+    virtual void invalidateNodeIndex();
+
     /** set internal cursor to root node
      ** @return ID of root node if successful, 0 otherwise
      */
     inline size_t gotoRoot();
 
-    /** set internal cursor to specified node
+    /** set internal cursor to specified node.
+     *  If the node index is enabled and the search starts from the root node, the node is
+     *  looked up in the index instead of iterating over the tree.
      ** @param  searchID       ID of the node to set the cursor to
      *  @param  startFromRoot  flag indicating whether to start from the root node
      *                         or the current one
@@ -254,7 +279,9 @@ template<typename T = DSRTreeNode> class DSRTree
     size_t gotoNode(const size_t searchID,
                     const OFBool startFromRoot = OFTrue);
 
-    /** set internal cursor to specified node
+    /** set internal cursor to specified node.
+     *  If the node index is enabled and the search starts from the root node, the node is
+     *  looked up in the index instead of walking through the tree.
      ** @param  reference      position string of the node to set the cursor to.
      *                         (the format is e.g. "1.2.3" for the third child of the
      *                         second child of the first node - see DSRTreeNodeCursor).
@@ -377,11 +404,31 @@ template<typename T = DSRTreeNode> class DSRTree
      */
     virtual void deleteTreeFromRootNode(T *rootNode);
 
+    /** get node index of this tree.
+     *  If the index is enabled but has not been created yet (or has been invalidated), it
+     *  is created from the current tree.
+     ** @return pointer to node index, NULL if disabled
+     */
+    const DSRTreeNodeIndex<T> *getNodeIndex();
+
+    /** set internal cursor to the node described by the given index entry.
+     *  The stack of parent nodes and the position counter are restored from the index, i.e.
+     *  the cursor is in the same state as after iterating from the root node to this node.
+     ** @param  entry  entry of the node index (see getNodeIndex())
+     ** @return ID of the new current node if successful, 0 otherwise
+     */
+    size_t gotoIndexedNode(const typename DSRTreeNodeIndex<T>::Entry &entry);
+
 
   private:
 
     /// pointer to the root tree node
     T *RootNode;
+
+    /// flag indicating whether the node index is enabled
+    OFBool NodeIndexEnabled;
+    /// index of all tree nodes (empty if disabled or not yet created)
+    DSRTreeNodeIndex<T> NodeIndex;
 };
 
 
@@ -392,7 +439,9 @@ template<typename T = DSRTreeNode> class DSRTree
 template<typename T>
 DSRTree<T>::DSRTree()
   : DSRTreeNodeCursor<T>(),
-    RootNode(NULL)
+    RootNode(NULL),
+    NodeIndexEnabled(OFFalse),
+    NodeIndex()
 {
 }
 
@@ -400,7 +449,9 @@ DSRTree<T>::DSRTree()
 template<typename T>
 DSRTree<T>::DSRTree(const DSRTree<T> &tree)
   : DSRTreeNodeCursor<T>(),
-    RootNode(NULL)
+    RootNode(NULL),
+    NodeIndexEnabled(tree.NodeIndexEnabled),
+    NodeIndex()
 {
     if (!tree.isEmpty())
     {
@@ -458,7 +509,9 @@ DSRTree<T>::DSRTree(const DSRTree<T> &tree)
 template<typename T>
 DSRTree<T>::DSRTree(T *rootNode)
   : DSRTreeNodeCursor<T>(),
-    RootNode(rootNode)
+    RootNode(rootNode),
+    NodeIndexEnabled(OFFalse),
+    NodeIndex()
 {
     /* initialize the cursor */
     gotoRoot();
@@ -469,7 +522,9 @@ template<typename T>
 DSRTree<T>::DSRTree(const DSRTreeNodeCursor<T> &startCursor,
                     size_t stopAfterNodeID)
   : DSRTreeNodeCursor<T>(),
-    RootNode(NULL)
+    RootNode(NULL),
+    NodeIndexEnabled(OFFalse),
+    NodeIndex()
 {
     T *nodeCursor = startCursor.getNode();
     /* since we start from a particular node, we need to check it first */
@@ -617,6 +672,29 @@ size_t DSRTree<T>::getNextNodeID() const
 }
 
 
+template<typename T>
+void DSRTree<T>::enableNodeIndex(const OFBool enable)
+{
+    NodeIndexEnabled = enable;
+    /* the index is created when needed */
+    NodeIndex.clear();
+}
+
+
+template<typename T>
+OFBool DSRTree<T>::isNodeIndexEnabled() const
+{
+    return NodeIndexEnabled;
+}
+
+
+template<typename T>
+void DSRTree<T>::invalidateNodeIndex()
+{
+    NodeIndex.clear();
+}
+
+
 template<typename T>
 size_t DSRTree<T>::gotoRoot()
 {
@@ -631,10 +709,21 @@ size_t DSRTree<T>::gotoNode(const size_t searchID,
     size_t nodeID = 0;
     if (searchID > 0)
     {
-        if (startFromRoot)
-            gotoRoot();
-        /* call the real function */
-        nodeID = DSRTreeNodeCursor<T>::gotoNode(searchID);
+        /* use the node index (if enabled) */
+        const DSRTreeNodeIndex<T> *nodeIndex = startFromRoot ? getNodeIndex() : NULL;
+        if (nodeIndex != NULL)
+        {
+            const typename DSRTreeNodeIndex<T>::Entry *entry = nodeIndex->findNode(searchID);
+            if (entry != NULL)
+                nodeID = gotoIndexedNode(*entry);
+        }
+        if (nodeID == 0)
+        {
+            if (startFromRoot)
+                gotoRoot();
+            /* call the real function */
+            nodeID = DSRTreeNodeCursor<T>::gotoNode(searchID);
+        }
     }
     return nodeID;
 }
@@ -647,10 +736,21 @@ size_t DSRTree<T>::gotoNode(const OFString &reference,
     size_t nodeID = 0;
     if (!reference.empty())
     {
-        if (startFromRoot)
-            gotoRoot();
-        /* call the real function */
-        nodeID = DSRTreeNodeCursor<T>::gotoNode(reference);
+        /* use the node index (if enabled) */
+        const DSRTreeNodeIndex<T> *nodeIndex = startFromRoot ? getNodeIndex() : NULL;
+        if (nodeIndex != NULL)
+        {
+            const typename DSRTreeNodeIndex<T>::Entry *entry = nodeIndex->findNode(reference);
+            if (entry != NULL)
+                nodeID = gotoIndexedNode(*entry);
+        }
+        if (nodeID == 0)
+        {
+            if (startFromRoot)
+                gotoRoot();
+            /* call the real function */
+            nodeID = DSRTreeNodeCursor<T>::gotoNode(reference);
+        }
     }
     return nodeID;
 }
@@ -770,6 +870,15 @@ size_t DSRTree<T>::addNode(T *node,
             this->Position.initialize();
         }
         nodeID = this->NodeCursor->getIdent();
+        /* update node index (if already created) */
+        if (!NodeIndex.isEmpty())
+        {
+            /* a single node added as the last sibling does not change other positions */
+            if ((node->Next == NULL) && (node->Down == NULL))
+                NodeIndex.addNode(node, this->NodeCursorStack.empty() ? 0 : this->NodeCursorStack.top()->getIdent(), this->Position);
+            else
+                invalidateNodeIndex();
+        }
     }
     return nodeID;
 }
@@ -816,6 +925,7 @@ size_t DSRTree<T>::replaceNode(T *node)
                 this->RootNode = node;
             /* free memory of old (now replaced) node */
             deleteTreeFromRootNode(this->NodeCursor);
+            invalidateNodeIndex();
             /* set cursor to new node */
             this->NodeCursor = node;
             nodeID = node->getIdent();
@@ -883,6 +993,7 @@ T *DSRTree<T>::extractNode()
         /* remove references to former siblings */
         cursor->Prev = NULL;
         cursor->Next = NULL;
+        invalidateNodeIndex();
     }
     return cursor;
 }
@@ -894,6 +1005,7 @@ T *DSRTree<T>::getAndRemoveRootNode()
     T *root = RootNode;
     /* "forget" reference to root node */
     RootNode = NULL;
+    invalidateNodeIndex();
     return root;
 }
 
@@ -966,6 +1078,10 @@ void DSRTree<T>::swap(DSRTree<T> &tree)
     DSRTreeNodeCursor<T>::swap(tree);
     /* swap pointer to the root tree node */
     OFswap(RootNode, tree.RootNode);
+    /* the node index of both trees is created again when needed */
+    OFswap(NodeIndexEnabled, tree.NodeIndexEnabled);
+    invalidateNodeIndex();
+    tree.invalidateNodeIndex();
 }
 
 
@@ -985,4 +1101,55 @@ void DSRTree<T>::deleteTreeFromRootNode(T *rootNode)
 }
 
 
+template<typename T>
+const DSRTreeNodeIndex<T> *DSRTree<T>::getNodeIndex()
+{
+    const DSRTreeNodeIndex<T> *nodeIndex = NULL;
+    if (NodeIndexEnabled && (RootNode != NULL))
+    {
+        /* create index from all nodes of the tree (if needed) */
+        if (NodeIndex.isEmpty())
+            NodeIndex.build(DSRTreeNodeCursor<T>(RootNode));
+        nodeIndex = &NodeIndex;
+    }
+    return nodeIndex;
+}
+
+
+template<typename T>
+size_t DSRTree<T>::gotoIndexedNode(const typename DSRTreeNodeIndex<T>::Entry &entry)
+{
+    size_t nodeID = 0;
+    if (entry.Node != NULL)
+    {
+        OFVector<T *> parentNodes;
+        size_t parentID = entry.ParentID;
+        /* collect all parent nodes (from bottom to top) */
+        while (parentID > 0)
+        {
+            const typename DSRTreeNodeIndex<T>::Entry *parentEntry = NodeIndex.findNode(parentID);
+            if (parentEntry == NULL)
+                break;
+            parentNodes.push_back(parentEntry->Node);
+            parentID = parentEntry->ParentID;
+        }
+        /* should never happen, but ... */
+        if (parentID == 0)
+        {
+            this->clearNodeCursorStack();
+            /* the root-most parent node is at the bottom of the stack */
+            while (!parentNodes.empty())
+            {
+                this->NodeCursorStack.push(parentNodes.back());
+                parentNodes.pop_back();
+            }
+            this->NodeCursor = entry.Node;
+            this->Position = entry.Position;
+            nodeID = entry.Node->getIdent();
+        }
+    }
+    return nodeID;
+}
+
+
 #endif
@@ -399,6 +399,9 @@ class DCMTK_DCMSR_EXPORT DSRTypes
     /// read: accept empty Study/Series/SOP Instance UID attribute values (must be filled later)
     static const size_t XF_acceptEmptyStudySeriesInstanceUID;
 
+    /// read: use streaming (pull) parser, i.e. read content items one after the other instead of building the complete XML tree in memory
+    static const size_t XF_useStreamingParser;
+
     /// shortcut: combines all XF_xxxAsAttribute write flags (see above)
     static const size_t XF_encodeEverythingAsAttribute;
     //@}
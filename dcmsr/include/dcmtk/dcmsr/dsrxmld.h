@@ -84,7 +84,10 @@ class DCMTK_DCMSR_EXPORT DSRXMLDocument
 
     /** read XML document from file.
      *  In order to enable the optional Schema validation the flag DSRTypes::XF_validateSchema
-     *  has to be set.
+     *  has to be set.  If the flag DSRTypes::XF_useStreamingParser is set, the file is read
+     *  with a pull parser: only the document header (i.e. everything before the content
+     *  items) is read by this method, the content items are read one after the other using
+     *  getNextStreamedNode() and finishStreaming() has to be called at the end.
      ** @param  filename  name of the file from which the XML document is read
      *                    ("-" for stdin)
      *  @param  flags     optional flag used to customize the reading process
@@ -94,6 +97,38 @@ class DCMTK_DCMSR_EXPORT DSRXMLDocument
     OFCondition read(const OFString &filename,
                      const size_t flags = 0);
 
+    /** check whether the XML document is read with the streaming parser, i.e.\ whether the
+     *  content items have to be retrieved using getNextStreamedNode()
+     ** @return OFTrue if document is streamed (and not yet finished), OFFalse otherwise
+     */
+    OFBool isStreamed() const;
+
+    /** get next content item (or enclosing "template" element) below a particular node of a
+     *  streamed XML document.  The node returned contains the attributes and the other child
+     *  elements read so far, i.e. those preceding its first child content item.  The child
+     *  content items have to be retrieved by further calls of this method.  After the last
+     *  one, the node also contains the remaining child elements (e.g. the "value" element)
+     *  and can be accessed like any other node of the document.  Nodes have to be requested
+     *  in document order, i.e. requesting the next node below a parent skips the remainder
+     *  of all nodes returned below it.  The previous node returned for the same parent is
+     *  released, so the memory required is proportional to the depth of the content tree
+     *  and not to its size.
+     ** @param  parent  cursor pointing to the parent node, i.e.\ the "content" element or a
+     *                  node previously returned by this method
+     *  @param  cursor  reference to cursor object in which the next node is stored (invalid
+     *                  if there are no further nodes below 'parent')
+     ** @return OFTrue if a further node has been found, OFFalse otherwise
+     */
+    OFBool getNextStreamedNode(const DSRXMLCursor &parent,
+                               DSRXMLCursor &cursor) const;
+
+    /** finish reading of a streamed XML document.  The remainder of the document is parsed
+     *  (without being stored) in order to check its well-formedness and, if requested, its
+     *  validity.
+     ** @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition finishStreaming();
+
 
   // --- character encoding ---
 
@@ -289,6 +324,16 @@ class DCMTK_DCMSR_EXPORT DSRXMLDocument
     void printMissingAttributeError(const DSRXMLCursor &cursor,
                                     const char *name) const;
 
+    /** read XML document from file using the streaming parser (see read() for details)
+     ** @param  filename  name of the file from which the XML document is read
+     *                    ("-" for stdin)
+     *  @param  flags     optional flag used to customize the reading process
+     *                    (see DSRTypes::XF_xxx)
+     ** @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition readStreamed(const OFString &filename,
+                             const size_t flags);
+
   // --- static function ---
 
     /** get the full path (incl.\ all predecessors) to the current node
@@ -304,10 +349,15 @@ class DCMTK_DCMSR_EXPORT DSRXMLDocument
 
   private:
 
+    /// internal state of the streaming parser (defined in the implementation file)
+    struct StreamState;
+
     /// pointer to the internal representation of the XML document (libxml)
     xmlDocPtr Document;
     /// pointer to the currently selected character encoding handler (libxml)
     xmlCharEncodingHandlerPtr EncodingHandler;
+    /// pointer to the state of the streaming parser (NULL if the document is not streamed)
+    StreamState *Stream;
 
 // --- declaration copy constructor and assignment operator
 
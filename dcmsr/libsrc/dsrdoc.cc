@@ -827,6 +827,9 @@ OFCondition DSRDocument::readXML(const OFString &filename,
                 }
             }
         }
+        /* check the remainder of a streamed document (if applicable) */
+        if (result.good() && doc.isStreamed())
+            result = doc.finishStreaming();
     }
     return result;
 }
@@ -1207,8 +1210,8 @@ OFCondition DSRDocument::readXMLDocumentData(const DSRXMLDocument &doc,
                 /* Content Time */
                 DSRTimeTreeNode::getValueFromXMLNodeContent(doc, doc.getNamedChildNode(cursor, "time"), tmpString);
                 ContentTime.putOFStringArray(tmpString);
-                /* proceed with document tree */
-                result = DocumentTree.readXML(doc, cursor.getChild(), flags);
+                /* proceed with document tree (content items are streamed from this element) */
+                result = DocumentTree.readXML(doc, doc.isStreamed() ? cursor : cursor.getChild(), flags);
             } else
                 doc.printUnexpectedNodeWarning(cursor);
             /* print node error message (if any) */
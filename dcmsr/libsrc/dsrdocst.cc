@@ -33,10 +33,55 @@
 #include "dcmtk/dcmdata/dcvrdt.h"
 
 
+/* get key used for the index of concept names (same criteria as comparison operator) */
+static OFString getConceptNameKey(const DSRCodedEntryValue &conceptName)
+{
+    OFString key(conceptName.getCodeValue());
+    key += '\\';
+    key += conceptName.getCodingSchemeDesignator();
+    key += '\\';
+    key += conceptName.getCodingSchemeVersion();
+    return key;
+}
+
+
+/* compare two position strings in document order, e.g. "1.2" < "1.2.1" < "1.10" */
+static int comparePositionStrings(const OFString &position1,
+                                  const OFString &position2)
+{
+    const char *pos1 = position1.c_str();
+    const char *pos2 = position2.c_str();
+    while ((*pos1 != '\0') && (*pos2 != '\0'))
+    {
+        size_t number1 = 0;
+        size_t number2 = 0;
+        while ((*pos1 >= '0') && (*pos1 <= '9'))
+            number1 = number1 * 10 + OFstatic_cast(size_t, *pos1++ - '0');
+        while ((*pos2 >= '0') && (*pos2 <= '9'))
+            number2 = number2 * 10 + OFstatic_cast(size_t, *pos2++ - '0');
+        if (number1 != number2)
+            return (number1 < number2) ? -1 : 1;
+        if (*pos1 == '.')
+            ++pos1;
+        if (*pos2 == '.')
+            ++pos2;
+    }
+    /* a parent node precedes its child nodes */
+    if (*pos1 != '\0')
+        return 1;
+    if (*pos2 != '\0')
+        return -1;
+    return 0;
+}
+
+
 DSRDocumentSubTree::DSRDocumentSubTree()
   : DSRTree<DSRDocumentTreeNode>(),
     ConstraintChecker(NULL),
-    CurrentContentItem()
+    CurrentContentItem(),
+    CurrentContentItemNodeID(0),
+    ConceptNameIndex(),
+    PendingConceptNameNodes()
 {
     /* by default, there is no IOD constraint checker */
 }
@@ -45,7 +90,10 @@ DSRDocumentSubTree::DSRDocumentSubTree()
 DSRDocumentSubTree::DSRDocumentSubTree(const DSRDocumentSubTree &tree)
   : DSRTree<DSRDocumentTreeNode>(tree),
     ConstraintChecker(NULL),
-    CurrentContentItem()
+    CurrentContentItem(),
+    CurrentContentItemNodeID(0),
+    ConceptNameIndex(),
+    PendingConceptNameNodes()
 {
     /* the real work is done in the base class DSRTree,
      * so just update the by-reference relationships (if any) */
@@ -56,7 +104,10 @@ DSRDocumentSubTree::DSRDocumentSubTree(const DSRDocumentSubTree &tree)
 DSRDocumentSubTree::DSRDocumentSubTree(DSRDocumentTreeNode *rootNode)
   : DSRTree<DSRDocumentTreeNode>(rootNode),
     ConstraintChecker(NULL),
-    CurrentContentItem()
+    CurrentContentItem(),
+    CurrentContentItemNodeID(0),
+    ConceptNameIndex(),
+    PendingConceptNameNodes()
 {
     /* the real work is done in the base class DSRTree */
 }
@@ -66,7 +117,10 @@ DSRDocumentSubTree::DSRDocumentSubTree(const DSRDocumentTreeNodeCursor &startCur
                                        size_t stopAfterNodeID)
   : DSRTree<DSRDocumentTreeNode>(startCursor, stopAfterNodeID),
     ConstraintChecker(NULL),
-    CurrentContentItem()
+    CurrentContentItem(),
+    CurrentContentItemNodeID(0),
+    ConceptNameIndex(),
+    PendingConceptNameNodes()
 {
     /* the real work is done in the base class DSRTree */
 }
@@ -95,6 +149,7 @@ DSRDocumentSubTree *DSRDocumentSubTree::clone() const
 void DSRDocumentSubTree::clear()
 {
     DSRTree<DSRDocumentTreeNode>::clear();
+    clearConceptNameIndex();
 }
 
 
@@ -274,6 +329,15 @@ OFCondition DSRDocumentSubTree::writeXML(STD_NAMESPACE ostream &stream,
 DSRContentItem &DSRDocumentSubTree::getCurrentContentItem()
 {
     CurrentContentItem.setTreeNode(getNode());
+    /* the concept name of this content item might be changed by the caller */
+    const size_t nodeID = getNodeID();
+    if (nodeID != CurrentContentItemNodeID)
+    {
+        /* so check the previous one again (if needed) */
+        if ((CurrentContentItemNodeID > 0) && checkConceptNameIndex())
+            PendingConceptNameNodes.push_back(CurrentContentItemNodeID);
+        CurrentContentItemNodeID = nodeID;
+    }
     return CurrentContentItem;
 }
 
@@ -387,21 +451,165 @@ size_t DSRDocumentSubTree::gotoNamedNode(const DSRCodedEntryValue &conceptName,
     size_t nodeID = 0;
     if (conceptName.isValid())
     {
+        /* use the node index (if enabled) */
         if (startFromRoot)
-            gotoRoot();
-        const DSRDocumentTreeNode *node;
-        /* iterate over all nodes */
-        do {
-            node = getNode();
-            /* and check for the desired concept name */
-            if ((node != NULL) && (node->getConceptName() == conceptName))
-                nodeID = node->getNodeID();
-        } while ((nodeID == 0) && iterate(searchIntoSub));
+            nodeID = gotoIndexedNamedNode(conceptName, searchIntoSub);
+        if (nodeID == 0)
+        {
+            if (startFromRoot)
+                gotoRoot();
+            const DSRDocumentTreeNode *node;
+            /* iterate over all nodes */
+            do {
+                node = getNode();
+                /* and check for the desired concept name */
+                if ((node != NULL) && (node->getConceptName() == conceptName))
+                    nodeID = node->getNodeID();
+            } while ((nodeID == 0) && iterate(searchIntoSub));
+        }
     }
     return nodeID;
 }
 
 
+size_t DSRDocumentSubTree::gotoIndexedNamedNode(const DSRCodedEntryValue &conceptName,
+                                                const OFBool searchIntoSub)
+{
+    size_t nodeID = 0;
+    const DSRTreeNodeIndex<DSRDocumentTreeNode> *nodeIndex = getNodeIndex();
+    if (nodeIndex != NULL)
+    {
+        /* create index of concept names (if needed) */
+        if (ConceptNameIndex.empty())
+        {
+            PendingConceptNameNodes.clear();
+            DSRDocumentTreeNodeCursor cursor(getRoot());
+            if (cursor.isValid())
+            {
+                /* iterate over all nodes (also the ones without concept name) */
+                do {
+                    ConceptNameIndex[getConceptNameKey(cursor.getNode()->getConceptName())].push_back(cursor.getNodeID());
+                } while (cursor.iterate());
+            }
+        } else {
+            /* otherwise, add new and modified nodes */
+            updateConceptNameIndex(*nodeIndex);
+        }
+        OFMap<OFString, OFList<size_t> >::iterator iter = ConceptNameIndex.find(getConceptNameKey(conceptName));
+        if (iter != ConceptNameIndex.end())
+        {
+            /* the node IDs are stored in document order */
+            OFListIterator(size_t) nodeIter = iter->second.begin();
+            const OFListIterator(size_t) last = iter->second.end();
+            while ((nodeIter != last) && (nodeID == 0))
+            {
+                const DSRTreeNodeIndex<DSRDocumentTreeNode>::Entry *entry = nodeIndex->findNode(*nodeIter);
+                /* remove nodes that do not exist any longer or have another concept name */
+                if ((entry == NULL) || !(entry->Node->getConceptName() == conceptName))
+                    nodeIter = iter->second.erase(nodeIter);
+                else {
+                    if (searchIntoSub || (entry->ParentID == 0))
+                        nodeID = gotoIndexedNode(*entry);
+                    ++nodeIter;
+                }
+            }
+        }
+    }
+    return nodeID;
+}
+
+
+OFBool DSRDocumentSubTree::checkConceptNameIndex()
+{
+    OFBool result = OFFalse;
+    if (!ConceptNameIndex.empty())
+    {
+        /* the index of concept names can only be used with the node index */
+        if (isNodeIndexEnabled())
+            result = OFTrue;
+        else
+            clearConceptNameIndex();
+    }
+    return result;
+}
+
+
+void DSRDocumentSubTree::clearConceptNameIndex()
+{
+    ConceptNameIndex.clear();
+    PendingConceptNameNodes.clear();
+}
+
+
+void DSRDocumentSubTree::addToConceptNameIndex(DSRDocumentTreeNode *node)
+{
+    DSRDocumentTreeNodeCursor cursor(node);
+    if (cursor.isValid())
+    {
+        /* the nodes are added to the index when needed (see updateConceptNameIndex()) */
+        do {
+            PendingConceptNameNodes.push_back(cursor.getNodeID());
+        } while (cursor.iterate());
+    }
+}
+
+
+void DSRDocumentSubTree::removeFromConceptNameIndex(DSRDocumentTreeNode *node)
+{
+    DSRDocumentTreeNodeCursor cursor(node);
+    if (cursor.isValid())
+    {
+        /* iterate over the given node and its child nodes (but not its siblings) */
+        do {
+            OFMap<OFString, OFList<size_t> >::iterator iter = ConceptNameIndex.find(getConceptNameKey(cursor.getNode()->getConceptName()));
+            if (iter != ConceptNameIndex.end())
+                iter->second.remove(cursor.getNodeID());
+        } while (cursor.iterate() && (cursor.getLevel() > 1));
+    }
+}
+
+
+void DSRDocumentSubTree::updateConceptNameIndex(const DSRTreeNodeIndex<DSRDocumentTreeNode> &nodeIndex)
+{
+    /* the current content item might have been modified */
+    if (CurrentContentItemNodeID > 0)
+        PendingConceptNameNodes.push_back(CurrentContentItemNodeID);
+    while (!PendingConceptNameNodes.empty())
+    {
+        const size_t nodeID = PendingConceptNameNodes.front();
+        PendingConceptNameNodes.pop_front();
+        /* the node might have been removed in the meantime */
+        const DSRTreeNodeIndex<DSRDocumentTreeNode>::Entry *entry = nodeIndex.findNode(nodeID);
+        if (entry != NULL)
+        {
+            OFList<size_t> &nodeList = ConceptNameIndex[getConceptNameKey(entry->Node->getConceptName())];
+            /* search backwards for the position in document order (usually at the end) */
+            OFListIterator(size_t) iter = nodeList.end();
+            OFBool found = OFFalse;
+            OFBool stop = OFFalse;
+            while ((iter != nodeList.begin()) && !found && !stop)
+            {
+                OFListIterator(size_t) prev = iter;
+                --prev;
+                if (*prev == nodeID)
+                    found = OFTrue;
+                else {
+                    /* ignore nodes that do not exist any longer */
+                    const DSRTreeNodeIndex<DSRDocumentTreeNode>::Entry *prevEntry = nodeIndex.findNode(*prev);
+                    if ((prevEntry != NULL) && (comparePositionStrings(prevEntry->PositionString, entry->PositionString) < 0))
+                        stop = OFTrue;
+                    else
+                        iter = prev;
+                }
+            }
+            /* add node (if not already in the list) */
+            if (!found)
+                nodeList.insert(iter, nodeID);
+        }
+    }
+}
+
+
 size_t DSRDocumentSubTree::gotoNamedChildNode(const DSRCodedEntryValue &conceptName)
 {
     /* first, goto child node */
@@ -636,17 +844,31 @@ size_t DSRDocumentSubTree::addByReferenceRelationship(const E_RelationshipType r
         DSRDocumentTreeNodeCursor cursor(getRoot());
         if (cursor.isValid())
         {
-            /* goto specified target node (might be improved later on) */
-            if (cursor.gotoNode(referencedNodeID) > 0)
+            const DSRDocumentTreeNode *targetNode = NULL;
+            OFString targetString;
+            /* goto specified target node (use the node index if enabled) */
+            const DSRTreeNodeIndex<DSRDocumentTreeNode> *nodeIndex = getNodeIndex();
+            if (nodeIndex != NULL)
+            {
+                const DSRTreeNodeIndex<DSRDocumentTreeNode>::Entry *entry = nodeIndex->findNode(referencedNodeID);
+                if (entry != NULL)
+                {
+                    targetNode = entry->Node;
+                    entry->Position.getString(targetString);
+                }
+            }
+            else if (cursor.gotoNode(referencedNodeID) > 0)
+            {
+                targetNode = cursor.getNode();
+                cursor.getPosition(targetString);
+            }
+            if (targetNode != NULL)
             {
                 OFString sourceString;
-                OFString targetString;
                 getPosition(sourceString);
-                cursor.getPosition(targetString);
                 /* check whether target node is an ancestor of source node (prevent loops) */
                 if (validByReferenceRelationship(sourceString, targetString))
                 {
-                    const DSRDocumentTreeNode *targetNode = cursor.getNode();
                     const E_ValueType targetValueType = targetNode->getValueType();
                     /* check whether relationship is valid/allowed */
                     if (canAddByReferenceRelationship(relationshipType, targetValueType))
@@ -958,7 +1180,11 @@ void DSRDocumentSubTree::swap(DSRDocumentSubTree &tree)
     DSRTree<DSRDocumentTreeNode>::swap(tree);
     /* swap other members */
     CurrentContentItem.swap(tree.CurrentContentItem);
+    OFswap(CurrentContentItemNodeID, tree.CurrentContentItemNodeID);
     OFswap(ConstraintChecker, tree.ConstraintChecker);
+    /* the index of concept names of both trees is created again when needed */
+    clearConceptNameIndex();
+    tree.clearConceptNameIndex();
 }
 
 
@@ -972,6 +1198,9 @@ DSRDocumentTreeNode *DSRDocumentSubTree::getNode() const
 size_t DSRDocumentSubTree::addNode(DSRDocumentTreeNode *node,
                                    const E_AddMode addMode)
 {
+    /* the new nodes are not yet linked to the tree, so only they are iterated */
+    if ((node != NULL) && (OFstatic_cast(DSRTreeNode *, node)->getPrev() == NULL) && checkConceptNameIndex())
+        addToConceptNameIndex(node);
     /* might add further checks later on */
     return DSRTree<DSRDocumentTreeNode>::addNode(node, addMode);
 }
@@ -979,6 +1208,13 @@ size_t DSRDocumentSubTree::addNode(DSRDocumentTreeNode *node,
 
 size_t DSRDocumentSubTree::replaceNode(DSRDocumentTreeNode *node)
 {
+    DSRDocumentTreeNode *oldNode = getNode();
+    /* same conditions as in the base class, the old node is deleted afterwards */
+    if ((node != NULL) && (OFstatic_cast(DSRTreeNode *, node)->getPrev() == NULL) && (oldNode != NULL) && checkConceptNameIndex())
+    {
+        removeFromConceptNameIndex(oldNode);
+        addToConceptNameIndex(node);
+    }
     /* might add further checks later on */
     return DSRTree<DSRDocumentTreeNode>::replaceNode(node);
 }
@@ -987,12 +1223,18 @@ size_t DSRDocumentSubTree::replaceNode(DSRDocumentTreeNode *node)
 DSRDocumentTreeNode *DSRDocumentSubTree::extractNode()
 {
     /* might add further checks later on */
-    return DSRTree<DSRDocumentTreeNode>::extractNode();
+    DSRDocumentTreeNode *node = DSRTree<DSRDocumentTreeNode>::extractNode();
+    /* the extracted node has no siblings, so only this subtree is removed */
+    if ((node != NULL) && checkConceptNameIndex())
+        removeFromConceptNameIndex(node);
+    return node;
 }
 
 
 DSRDocumentTreeNode *DSRDocumentSubTree::getAndRemoveRootNode()
 {
+    /* the tree is empty afterwards */
+    clearConceptNameIndex();
     /* might add further checks later on */
     return DSRTree<DSRDocumentTreeNode>::getAndRemoveRootNode();
 }
@@ -1123,6 +1365,8 @@ OFCondition DSRDocumentSubTree::checkByReferenceRelationships(const size_t mode,
                 resetReferenceTargetFlag();
             /* pass flags to reference cursor (see below) */
             const DSRPositionCounter posCounter(flags);
+            /* index of all nodes, created when the first by-reference relationship is found */
+            DSRTreeNodeIndex<DSRDocumentTreeNode> refIndex;
             /* start at the root of the document tree */
             T_Cursor cursor(getRoot());
             if (cursor.isValid())
@@ -1139,24 +1383,27 @@ OFCondition DSRDocumentSubTree::checkByReferenceRelationships(const size_t mode,
                         DSRByReferenceTreeNode *byRefNode = OFstatic_cast(DSRByReferenceTreeNode *, cursor.getNode());
                         if (flags & RF_showCurrentlyProcessedItem)
                             DCMSR_INFO("Updating by-reference relationship in content item " << nodePosString);
-                        /* start searching from root node, be careful with large trees! (tbd: might be improved later on) */
-                        T_Cursor refCursor(getRoot(), &posCounter);
+                        /* avoid searching from root node for each reference, i.e. use an index */
+                        if (refIndex.isEmpty())
+                            refIndex.build(T_Cursor(getRoot(), &posCounter));
+                        const DSRTreeNodeIndex<DSRDocumentTreeNode>::Entry *refEntry = NULL;
                         if (mode & CM_updateNodeID)
                         {
                             /* update node ID (based on position string) */
-                            refNodeID = refCursor.gotoNode(byRefNode->getReferencedContentItem());
-                            const DSRDocumentTreeNode *targetNode = (refNodeID > 0) ? refCursor.getNode() : NULL;
-                            const E_ValueType targetValueType = (targetNode != NULL) ? targetNode->getValueType() : VT_invalid;
+                            refEntry = refIndex.findNode(byRefNode->getReferencedContentItem());
+                            refNodeID = (refEntry != NULL) ? refEntry->Node->getNodeID() : 0;
+                            const E_ValueType targetValueType = (refEntry != NULL) ? refEntry->Node->getValueType() : VT_invalid;
                             byRefNode->updateReference(refNodeID, targetValueType);
                         } else {
                             /* node ID is expected to be valid */
-                            refNodeID = refCursor.gotoNode(byRefNode->getReferencedNodeID());
+                            refEntry = refIndex.findNode(byRefNode->getReferencedNodeID());
+                            refNodeID = (refEntry != NULL) ? refEntry->Node->getNodeID() : 0;
                             if (mode & CM_updatePositionString)
                             {
                                 OFString refPosString;
                                 /* update position string */
                                 if (refNodeID > 0)
-                                    refCursor.getPosition(refPosString);
+                                    refEntry->Position.getString(refPosString);
                                 byRefNode->updateReference(refPosString);
                             } else if (refNodeID == 0)
                                 byRefNode->invalidateReference();
@@ -1170,9 +1417,9 @@ OFCondition DSRDocumentSubTree::checkByReferenceRelationships(const size_t mode,
                                 /* check whether target node is an ancestor of source node (prevent loops) */
                                 if (refContentItem.empty() || validByReferenceRelationship(nodePosString, refContentItem))
                                 {
-                                    /* refCursor should now point to the reference target (refNodeID > 0) */
+                                    /* refEntry should now point to the reference target (refNodeID > 0) */
                                     const DSRDocumentTreeNode *parentNode = cursor.getParentNode();
-                                    DSRDocumentTreeNode *targetNode = refCursor.getNode();
+                                    DSRDocumentTreeNode *targetNode = refEntry->Node;
                                     if ((parentNode != NULL) && (targetNode != NULL))
                                     {
                                         /* specify that this content item is target of an by-reference relationship */
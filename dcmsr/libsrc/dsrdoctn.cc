@@ -220,6 +220,12 @@ OFCondition DSRDocumentTreeNode::readXML(const DSRXMLDocument &doc,
         OFString templateIdentifier;
         /* important: NULL indicates first child node */
         DSRDocumentTreeNode *node = NULL;
+        /* child content items of a streamed document are read first, since the remaining
+           elements of this content item (e.g. its value) might follow them */
+        if (doc.isStreamed())
+            result = readXMLStreamedChildNodes(doc, cursor, documentType, flags);
+        else
+            result = EC_Normal;
         /* read "id" attribute (optional) and compare with expected value */
         if (!doc.getStringFromAttribute(cursor, idAttr, "id", OFFalse /*encoding*/, OFFalse /*required*/).empty() &&
             (stringToNumber(idAttr.c_str()) != getNodeID()))
@@ -263,56 +269,119 @@ OFCondition DSRDocumentTreeNode::readXML(const DSRXMLDocument &doc,
             DSRDateTimeTreeNode::getValueFromXMLNodeContent(doc, doc.getNamedChildNode(childCursor, "datetime", OFFalse /*required*/), ObservationDateTime);
         }
         /* read node content (depends on value type) */
-        result = readXMLContentItem(doc, cursor, flags);
-        /* goto first child node */
-        cursor.gotoChild();
-        /* iterate over all child content items */
-        while (cursor.valid() && result.good())
+        if (result.good())
+            result = readXMLContentItem(doc, cursor, flags);
+        if (!doc.isStreamed())
         {
-            /* template identification information expected "outside" content item */
-            if (flags & XF_templateElementEnclosesItems)
+            /* goto first child node */
+            cursor.gotoChild();
+            /* iterate over all child content items */
+            while (cursor.valid() && result.good())
             {
-                /* check for optional template identification */
-                if (doc.matchNode(cursor, "template"))
+                /* template identification information expected "outside" content item */
+                if (flags & XF_templateElementEnclosesItems)
                 {
-                    doc.getStringFromAttribute(cursor, mappingResource, "resource");
-                    doc.getStringFromAttribute(cursor, mappingResourceUID, "uid", OFFalse /*encoding*/, OFFalse /*required*/);
-                    doc.getStringFromAttribute(cursor, templateIdentifier, "tid");
-                    /* goto first child of the "template" element */
-                    cursor.gotoChild();
-                }
-            }
-            /* get SR value type from current XML node, also supports "by-reference" detection */
-            E_ValueType valueType = doc.getValueTypeFromNode(cursor);
-            /* invalid types are silently ignored */
-            if (valueType != VT_invalid)
-            {
-                /* get SR relationship type */
-                E_RelationshipType relationshipType = doc.getRelationshipTypeFromNode(cursor);
-                /* create new node (by-value or by-reference), do not check constraints */
-                result = createAndAppendNewNode(node, relationshipType, valueType);
-                if (result.good())
-                {
-                    if ((flags & XF_templateElementEnclosesItems) && (valueType != VT_byReference))
+                    /* check for optional template identification */
+                    if (doc.matchNode(cursor, "template"))
                     {
-                        /* set template identification (if any) */
-                        if (node->setTemplateIdentification(templateIdentifier, mappingResource, mappingResourceUID).bad())
-                            DCMSR_WARN("Content item has invalid/incomplete template identification");
+                        doc.getStringFromAttribute(cursor, mappingResource, "resource");
+                        doc.getStringFromAttribute(cursor, mappingResourceUID, "uid", OFFalse /*encoding*/, OFFalse /*required*/);
+                        doc.getStringFromAttribute(cursor, templateIdentifier, "tid");
+                        /* goto first child of the "template" element */
+                        cursor.gotoChild();
                     }
-                    /* proceed with reading child nodes */
-                    result = node->readXML(doc, cursor, documentType, flags);
-                    /* print node error message (if any) */
-                    doc.printGeneralNodeError(cursor, result);
-                } else {
-                    /* create new node failed */
-                    DCMSR_ERROR("Cannot add \"" << relationshipTypeToReadableName(relationshipType) << " "
-                        << valueTypeToDefinedTerm(valueType /*target item*/) << "\" to "
-                        << valueTypeToDefinedTerm(ValueType /*source item*/) << " in "
-                        << documentTypeToReadableName(documentType));
                 }
+                /* create and read child node (if any) */
+                result = readXMLChildNode(doc, cursor, node, documentType, flags, templateIdentifier, mappingResource, mappingResourceUID);
+                /* proceed with next node */
+                cursor.gotoNext();
+            }
+        }
+    }
+    return result;
+}
+
+
+OFCondition DSRDocumentTreeNode::readXMLStreamedChildNodes(const DSRXMLDocument &doc,
+                                                           const DSRXMLCursor &cursor,
+                                                           const E_DocumentType documentType,
+                                                           const size_t flags)
+{
+    OFCondition result = EC_Normal;
+    OFString mappingResource;
+    OFString mappingResourceUID;
+    OFString templateIdentifier;
+    /* important: NULL indicates first child node */
+    DSRDocumentTreeNode *node = NULL;
+    DSRXMLCursor parentCursor = cursor;
+    DSRXMLCursor childCursor;
+    OFBool insideTemplate = OFFalse;
+    /* iterate over all child content items (in document order) */
+    while (result.good())
+    {
+        if (!doc.getNextStreamedNode(parentCursor, childCursor))
+        {
+            /* continue after the end of an enclosing "template" element */
+            if (!insideTemplate)
+                break;
+            parentCursor = cursor;
+            insideTemplate = OFFalse;
+        }
+        /* template identification information expected "outside" content item */
+        else if ((flags & XF_templateElementEnclosesItems) && !insideTemplate && doc.matchNode(childCursor, "template"))
+        {
+            doc.getStringFromAttribute(childCursor, mappingResource, "resource");
+            doc.getStringFromAttribute(childCursor, mappingResourceUID, "uid", OFFalse /*encoding*/, OFFalse /*required*/);
+            doc.getStringFromAttribute(childCursor, templateIdentifier, "tid");
+            /* proceed with the content items enclosed by the "template" element */
+            parentCursor = childCursor;
+            insideTemplate = OFTrue;
+        } else {
+            /* create and read child node (if any) */
+            result = readXMLChildNode(doc, childCursor, node, documentType, flags, templateIdentifier, mappingResource, mappingResourceUID);
+        }
+    }
+    return result;
+}
+
+
+OFCondition DSRDocumentTreeNode::readXMLChildNode(const DSRXMLDocument &doc,
+                                                  const DSRXMLCursor &cursor,
+                                                  DSRDocumentTreeNode *&node,
+                                                  const E_DocumentType documentType,
+                                                  const size_t flags,
+                                                  const OFString &templateIdentifier,
+                                                  const OFString &mappingResource,
+                                                  const OFString &mappingResourceUID)
+{
+    OFCondition result = EC_Normal;
+    /* get SR value type from current XML node, also supports "by-reference" detection */
+    E_ValueType valueType = doc.getValueTypeFromNode(cursor);
+    /* invalid types are silently ignored */
+    if (valueType != VT_invalid)
+    {
+        /* get SR relationship type */
+        E_RelationshipType relationshipType = doc.getRelationshipTypeFromNode(cursor);
+        /* create new node (by-value or by-reference), do not check constraints */
+        result = createAndAppendNewNode(node, relationshipType, valueType);
+        if (result.good())
+        {
+            if ((flags & XF_templateElementEnclosesItems) && (valueType != VT_byReference))
+            {
+                /* set template identification (if any) */
+                if (node->setTemplateIdentification(templateIdentifier, mappingResource, mappingResourceUID).bad())
+                    DCMSR_WARN("Content item has invalid/incomplete template identification");
             }
-            /* proceed with next node */
-            cursor.gotoNext();
+            /* proceed with reading child nodes */
+            result = node->readXML(doc, cursor, documentType, flags);
+            /* print node error message (if any) */
+            doc.printGeneralNodeError(cursor, result);
+        } else {
+            /* create new node failed */
+            DCMSR_ERROR("Cannot add \"" << relationshipTypeToReadableName(relationshipType) << " "
+                << valueTypeToDefinedTerm(valueType /*target item*/) << "\" to "
+                << valueTypeToDefinedTerm(ValueType /*source item*/) << " in "
+                << documentTypeToReadableName(documentType));
         }
     }
     return result;
@@ -185,30 +185,52 @@ OFCondition DSRDocumentTree::readXML(const DSRXMLDocument &doc,
         DCMSR_WARN("Check for relationship content constraints not yet supported");
     else if (ConstraintChecker->isTemplateSupportRequired())
         DCMSR_WARN("Check for template constraints not yet supported");
-    /* we assume that 'cursor' points to the "content" element */
+    /* we assume that 'cursor' points to the first child of the "content" element
+       (or to the "content" element itself in case of a streamed document) */
     if (cursor.valid())
     {
         OFString mappingResource;
         OFString mappingResourceUID;
         OFString templateIdentifier;
-        /* template identification information expected "outside" content item */
-        if (flags & XF_templateElementEnclosesItems)
+        E_ValueType valueType = VT_invalid;
+        if (doc.isStreamed())
         {
-            /* check for optional root template identification */
-            const DSRXMLCursor childCursor = doc.getNamedNode(cursor, "template", OFFalse /*required*/);
-            if (childCursor.valid())
+            DSRXMLCursor parentCursor = cursor;
+            /* get first content item (or enclosing template element) */
+            OFBool found = doc.getNextStreamedNode(parentCursor, cursor);
+            /* template identification information expected "outside" content item */
+            if (found && (flags & XF_templateElementEnclosesItems) && doc.matchNode(cursor, "template"))
             {
-                doc.getStringFromAttribute(childCursor, mappingResource, "resource");
-                doc.getStringFromAttribute(childCursor, mappingResourceUID, "uid", OFFalse /*encoding*/, OFFalse /*required*/);
-                doc.getStringFromAttribute(childCursor, templateIdentifier, "tid");
-                /* get first child of the "template" element */
-                cursor = childCursor.getChild();
+                doc.getStringFromAttribute(cursor, mappingResource, "resource");
+                doc.getStringFromAttribute(cursor, mappingResourceUID, "uid", OFFalse /*encoding*/, OFFalse /*required*/);
+                doc.getStringFromAttribute(cursor, templateIdentifier, "tid");
+                /* get first content item of the "template" element */
+                parentCursor = cursor;
+                found = doc.getNextStreamedNode(parentCursor, cursor);
             }
+            /* proceed to first valid container (if any) */
+            while (found && ((valueType = doc.getValueTypeFromNode(cursor)) != VT_Container))
+                found = doc.getNextStreamedNode(parentCursor, cursor);
+        } else {
+            /* template identification information expected "outside" content item */
+            if (flags & XF_templateElementEnclosesItems)
+            {
+                /* check for optional root template identification */
+                const DSRXMLCursor childCursor = doc.getNamedNode(cursor, "template", OFFalse /*required*/);
+                if (childCursor.valid())
+                {
+                    doc.getStringFromAttribute(childCursor, mappingResource, "resource");
+                    doc.getStringFromAttribute(childCursor, mappingResourceUID, "uid", OFFalse /*encoding*/, OFFalse /*required*/);
+                    doc.getStringFromAttribute(childCursor, templateIdentifier, "tid");
+                    /* get first child of the "template" element */
+                    cursor = childCursor.getChild();
+                }
+            }
+            valueType = doc.getValueTypeFromNode(cursor);
+            /* proceed to first valid container (if any) */
+            while (cursor.getNext().valid() && (valueType != VT_Container))
+                valueType = doc.getValueTypeFromNode(cursor.gotoNext());
         }
-        E_ValueType valueType = doc.getValueTypeFromNode(cursor);
-        /* proceed to first valid container (if any) */
-        while (cursor.getNext().valid() && (valueType != VT_Container))
-            valueType = doc.getValueTypeFromNode(cursor.gotoNext());
         /* root node should always be a container */
         if (valueType == VT_Container)
         {
@@ -130,6 +130,7 @@ const size_t DSRTypes::XF_validateSchema                    = 1 << 9;
 const size_t DSRTypes::XF_templateElementEnclosesItems      = 1 << 10;
 const size_t DSRTypes::XF_addCommentsForIncludedTemplate    = 1 << 11;
 const size_t DSRTypes::XF_acceptEmptyStudySeriesInstanceUID = 1 << 12;
+const size_t DSRTypes::XF_useStreamingParser                = 1 << 13;
 /* shortcuts */
 const size_t DSRTypes::XF_encodeEverythingAsAttribute       = DSRTypes::XF_codeComponentsAsAttribute |
                                                               DSRTypes::XF_relationshipTypeAsAttribute |
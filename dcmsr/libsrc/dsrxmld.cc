@@ -24,6 +24,7 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 #include "dcmtk/dcmsr/dsrxmld.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 #ifdef WITH_LIBXML
 #include <libxml/xmlversion.h>
@@ -32,6 +33,10 @@
 #include <libxml/xmlschemas.h>
 #endif /* LIBXML_SCHEMAS_ENABLED */
 
+#ifdef LIBXML_READER_ENABLED
+#include <libxml/xmlreader.h>
+#endif /* LIBXML_READER_ENABLED */
+
 // This function is also used in xml2dcm, try to stay in sync!
 #if defined(HAVE_VSNPRINTF) && defined(HAVE_PROTOTYPE_VSNPRINTF)
 extern "C" void errorFunction(void * ctx, const char *msg, ...)
@@ -104,9 +109,204 @@ extern "C" void errorFunction(void * /* ctx */, const char *msg, ...)
 /* ------------------------ */
 
 
+#if defined(WITH_LIBXML) && defined(LIBXML_READER_ENABLED)
+
+/* internal state of the streaming parser.
+ * Only the currently "open" content items (from the "content" element down to the item
+ * being read) are kept in memory.  Each of them is a copy of the original element with all
+ * attributes and all child elements that are no content items, as far as they have been
+ * read so far.  Of the child content items, only the last one is kept.
+ */
+struct DSRXMLDocument::StreamState
+{
+    /* level of a streamed element, determines which child elements are streamed */
+    enum E_Level
+    {
+        L_report,
+        L_document,
+        L_content,
+        L_item
+    };
+
+    /* position of the reader with respect to the innermost open element */
+    enum E_Position
+    {
+        /// reader is at the start of the next streamed child element
+        P_pending,
+        /// reader is at the end of the last streamed child element
+        P_afterChild,
+        /// reader is at the end of the element, i.e. there are no further child elements
+        P_closed
+    };
+
+    StreamState(const size_t flags)
+      : Reader(NULL),
+        Flags(flags),
+        ErrorString(),
+        Path(),
+        LastChild(),
+        ContentDepth(0),
+        Position(P_closed),
+        Failed(OFFalse)
+    {
+    }
+
+    ~StreamState()
+    {
+        xmlFreeTextReader(Reader);
+    }
+
+    /* check whether given child element of a particular level is streamed */
+    OFBool isStreamedElement(const E_Level level,
+                             const xmlChar *name) const
+    {
+        const char *tagName = OFreinterpret_cast(const char *, name);
+        OFBool result = OFFalse;
+        if (tagName != NULL)
+        {
+            switch (level)
+            {
+                case L_report:
+                    result = (strcmp(tagName, "document") == 0);
+                    break;
+                case L_document:
+                    result = (strcmp(tagName, "content") == 0);
+                    break;
+                case L_content:
+                    /* content date and time precede the root content item */
+                    result = (strcmp(tagName, "date") != 0) && (strcmp(tagName, "time") != 0);
+                    break;
+                case L_item:
+                    /* same rule as used for the child nodes of a content item in the XML tree */
+                    result = (strcmp(tagName, "item") == 0) ||
+                             ((Flags & XF_templateElementEnclosesItems) && (strcmp(tagName, "template") == 0)) ||
+                             (DSRTypes::xmlTagNameToValueType(tagName) != VT_invalid);
+                    break;
+            }
+        }
+        return result;
+    }
+
+    /* read child nodes of the element at the given depth until the next streamed child
+     * element or the end of the element is reached, other child elements are copied to
+     * the given node (if requested).  The reader is expected to be positioned behind the
+     * start of the element or behind one of its child elements.
+     */
+    OFBool scanChildren(xmlNodePtr node,
+                        const int depth,
+                        const E_Level level,
+                        const OFBool copy)
+    {
+        int status = 1;
+        while (status == 1)
+        {
+            const int nodeDepth = xmlTextReaderDepth(Reader);
+            /* end of the element reached? */
+            if (nodeDepth <= depth)
+                return OFFalse;
+            if ((xmlTextReaderNodeType(Reader) == XML_READER_TYPE_ELEMENT) && (nodeDepth == depth + 1))
+            {
+                if (isStreamedElement(level, xmlTextReaderConstLocalName(Reader)))
+                    return OFTrue;
+                if (copy)
+                {
+                    /* build the XML tree of this child element and copy it */
+                    xmlNodePtr current = xmlTextReaderExpand(Reader);
+                    if (current == NULL)
+                    {
+                        status = -1;
+                        break;
+                    }
+                    xmlAddChild(node, xmlDocCopyNode(current, node->doc, 1 /*recursive*/));
+                }
+                /* skip the subtree of this child element */
+                status = xmlTextReaderNext(Reader);
+            } else
+                status = xmlTextReaderRead(Reader);
+        }
+        if (status < 0)
+            Failed = OFTrue;
+        return OFFalse;
+    }
+
+    /* create copy of the current element (without child nodes) and add it to the given
+     * parent node, then read the child elements preceding the first streamed one
+     */
+    xmlNodePtr openElement(xmlNodePtr parent,
+                           const E_Level level,
+                           OFBool &pending)
+    {
+        xmlNodePtr node = xmlDocCopyNode(xmlTextReaderCurrentNode(Reader), parent->doc, 2 /*attributes*/);
+        if (node != NULL)
+        {
+            xmlAddChild(parent, node);
+            pending = OFFalse;
+            if (!xmlTextReaderIsEmptyElement(Reader))
+            {
+                const int depth = xmlTextReaderDepth(Reader);
+                if (xmlTextReaderRead(Reader) == 1)
+                    pending = scanChildren(node, depth, level, OFTrue /*copy*/);
+                else
+                    Failed = OFTrue;
+            }
+        } else
+            Failed = OFTrue;
+        return node;
+    }
+
+    /* close the innermost open element, i.e. skip the remainder of its content */
+    void closeElement()
+    {
+        if (Position != P_closed)
+        {
+            const int depth = ContentDepth + OFstatic_cast(int, Path.size()) - 1;
+            int status = 1;
+            while ((status == 1) && !((xmlTextReaderDepth(Reader) == depth) &&
+                   (xmlTextReaderNodeType(Reader) == XML_READER_TYPE_END_ELEMENT)))
+            {
+                status = xmlTextReaderNext(Reader);
+            }
+            if (status != 1)
+                Failed = OFTrue;
+        }
+        Path.pop_back();
+        LastChild.pop_back();
+        Position = P_afterChild;
+    }
+
+    /// pointer to the XML text reader (libxml)
+    xmlTextReaderPtr Reader;
+    /// flags used to customize the reading process
+    const size_t Flags;
+    /// buffer used by the error function
+    OFString ErrorString;
+    /// currently open elements, starting with the "content" element
+    OFVector<xmlNodePtr> Path;
+    /// last streamed child element returned for each of the open elements
+    OFVector<xmlNodePtr> LastChild;
+    /// depth of the "content" element
+    int ContentDepth;
+    /// position of the reader with respect to the innermost open element
+    E_Position Position;
+    /// flag indicating whether reading failed
+    OFBool Failed;
+
+  private:
+
+    StreamState(const StreamState &);
+    StreamState &operator=(const StreamState &);
+};
+
+#endif /* WITH_LIBXML && LIBXML_READER_ENABLED */
+
+
+/* ------------------------ */
+
+
 DSRXMLDocument::DSRXMLDocument()
   : Document(NULL),
-    EncodingHandler(NULL)
+    EncodingHandler(NULL),
+    Stream(NULL)
 {
 }
 
@@ -119,6 +319,15 @@ DSRXMLDocument::~DSRXMLDocument()
 
 void DSRXMLDocument::clear()
 {
+#if defined(WITH_LIBXML) && defined(LIBXML_READER_ENABLED)
+    if (Stream != NULL)
+    {
+        /* reset to default function (used the stream's buffer as context) */
+        xmlSetGenericErrorFunc(NULL, NULL);
+        delete Stream;
+        Stream = NULL;
+    }
+#endif
 #ifdef WITH_LIBXML
     /* free allocated memory */
     xmlFreeDoc(Document);
@@ -139,6 +348,9 @@ OFBool DSRXMLDocument::valid() const
 OFCondition DSRXMLDocument::read(const OFString &filename,
                                  const size_t flags)
 {
+    /* use pull parser if requested */
+    if (flags & XF_useStreamingParser)
+        return readStreamed(filename, flags);
     OFCondition result = SR_EC_InvalidDocument;
     /* temporary buffer needed for errorFunction - more detailed explanation there */
     OFString tmpErrorString;
@@ -231,6 +443,205 @@ OFCondition DSRXMLDocument::read(const OFString &,
 #endif
 
 
+#if defined(WITH_LIBXML) && defined(LIBXML_READER_ENABLED)
+OFCondition DSRXMLDocument::readStreamed(const OFString &filename,
+                                         const size_t flags)
+{
+    OFCondition result = SR_EC_InvalidDocument;
+    /* first remove any possibly existing document from memory */
+    clear();
+    /* do not substitute entities (other than the standard ones) */
+    xmlSubstituteEntitiesDefault(0);
+    /* enable libxml warnings and error messages (for the whole time of streaming) */
+    xmlGetWarningsDefaultValue = 1;
+    Stream = new StreamState(flags);
+    xmlSetGenericErrorFunc(&Stream->ErrorString, errorFunction);
+
+    xmlGenericError(xmlGenericErrorContext, "--- libxml streaming ----\n");
+    /* create pull parser for the given file */
+    Stream->Reader = xmlReaderForFile(filename.c_str(), NULL /*encoding*/, 0 /*options*/);
+    if (Stream->Reader != NULL)
+    {
+        OFBool isValid = OFTrue;
+        /* validate Schema (while reading) */
+        if (flags & XF_validateSchema)
+        {
+#ifdef LIBXML_SCHEMAS_ENABLED
+            isValid = (xmlTextReaderSchemaValidate(Stream->Reader, DCMSR_XML_XSD_FILE) == 0);
+            if (!isValid)
+                xmlGenericError(xmlGenericErrorContext, "error: failed to compile schema \"%s\"\n", DCMSR_XML_XSD_FILE);
+#else /* LIBXML_SCHEMAS_ENABLED */
+            xmlGenericError(xmlGenericErrorContext, "no support for XML Schema\n");
+#endif
+        }
+        /* go to the root element */
+        int status = xmlTextReaderRead(Stream->Reader);
+        while ((status == 1) && (xmlTextReaderNodeType(Stream->Reader) != XML_READER_TYPE_ELEMENT))
+            status = xmlTextReaderRead(Stream->Reader);
+        if ((status == 1) && isValid)
+        {
+            xmlNodePtr current = xmlTextReaderCurrentNode(Stream->Reader);
+            /* check namespace declaration (if required) */
+            if (!(flags & XF_useDcmsrNamespace) ||
+                (xmlSearchNsByHref(current->doc, current, OFreinterpret_cast(const xmlChar *, DCMSR_XML_NAMESPACE_URI)) != NULL))
+            {
+                /* create document with a copy of the root element (without child nodes) */
+                Document = xmlNewDoc(OFreinterpret_cast(const xmlChar *, "1.0"));
+                xmlNodePtr root = xmlDocCopyNode(current, Document, 2 /*attributes*/);
+                xmlDocSetRootElement(Document, root);
+                OFBool pending = OFFalse;
+                /* read document header up to the "content" element (incl. date and time) */
+                if (!xmlTextReaderIsEmptyElement(Stream->Reader) && (xmlTextReaderRead(Stream->Reader) == 1))
+                    pending = Stream->scanChildren(root, 0 /*depth*/, StreamState::L_report, OFTrue /*copy*/);
+                if (pending)
+                {
+                    xmlNodePtr document = Stream->openElement(root, StreamState::L_document, pending);
+                    if (pending)
+                    {
+                        Stream->ContentDepth = xmlTextReaderDepth(Stream->Reader);
+                        xmlNodePtr content = Stream->openElement(document, StreamState::L_content, pending);
+                        /* content items are read on request */
+                        Stream->Path.push_back(content);
+                        Stream->LastChild.push_back(NULL);
+                        Stream->Position = pending ? StreamState::P_pending : StreamState::P_closed;
+                    }
+                }
+                if (!Stream->Failed)
+                    result = EC_Normal;
+                else
+                    DCMSR_ERROR("Could not parse document");
+            } else
+                DCMSR_ERROR("Document has wrong type, dcmsr namespace not found");
+        } else {
+            if (status < 0)
+                DCMSR_ERROR("Could not parse document");
+            else if (isValid)
+                DCMSR_ERROR("Document is empty");
+            else
+                DCMSR_ERROR("Document does not validate");
+        }
+    } else
+        DCMSR_ERROR("Could not open document");
+    /* free all memory in case of error */
+    if (result.bad())
+        clear();
+    return result;
+}
+#else /* WITH_LIBXML && LIBXML_READER_ENABLED */
+OFCondition DSRXMLDocument::readStreamed(const OFString &,
+                                         const size_t)
+{
+    DCMSR_ERROR("No support for streaming XML documents");
+    return EC_IllegalCall;
+}
+#endif
+
+
+OFBool DSRXMLDocument::isStreamed() const
+{
+    return (Stream != NULL);
+}
+
+
+#if defined(WITH_LIBXML) && defined(LIBXML_READER_ENABLED)
+OFBool DSRXMLDocument::getNextStreamedNode(const DSRXMLCursor &parent,
+                                           DSRXMLCursor &cursor) const
+{
+    cursor.Node = NULL;
+    if ((Stream != NULL) && (parent.Node != NULL))
+    {
+        /* find parent node in the list of open elements (search from the innermost) */
+        size_t level = Stream->Path.size();
+        while ((level > 0) && (Stream->Path[level - 1] != parent.Node))
+            --level;
+        if (level > 0)
+        {
+            /* skip the remainder of all elements below the parent */
+            while (Stream->Path.size() > level)
+                Stream->closeElement();
+            const StreamState::E_Level childLevel = (level == 1) ? StreamState::L_content : StreamState::L_item;
+            /* proceed to the next child element (if any) */
+            if ((Stream->Position == StreamState::P_afterChild) && !Stream->Failed)
+            {
+                const int depth = Stream->ContentDepth + OFstatic_cast(int, level) - 1;
+                if (xmlTextReaderRead(Stream->Reader) == 1)
+                {
+                    Stream->Position = Stream->scanChildren(parent.Node, depth, childLevel, OFTrue /*copy*/)
+                        ? StreamState::P_pending : StreamState::P_closed;
+                } else
+                    Stream->Failed = OFTrue;
+            }
+            if ((Stream->Position == StreamState::P_pending) && !Stream->Failed)
+            {
+                /* release the previous child element */
+                xmlNodePtr &lastChild = Stream->LastChild[level - 1];
+                if (lastChild != NULL)
+                {
+                    xmlUnlinkNode(lastChild);
+                    xmlFreeNode(lastChild);
+                }
+                OFBool pending = OFFalse;
+                lastChild = Stream->openElement(parent.Node, StreamState::L_item, pending);
+                if (!Stream->Failed)
+                {
+                    Stream->Path.push_back(lastChild);
+                    Stream->LastChild.push_back(NULL);
+                    Stream->Position = pending ? StreamState::P_pending : StreamState::P_closed;
+                    cursor.Node = lastChild;
+                } else
+                    lastChild = NULL;
+            }
+        }
+    }
+    return cursor.valid();
+}
+#else /* WITH_LIBXML && LIBXML_READER_ENABLED */
+OFBool DSRXMLDocument::getNextStreamedNode(const DSRXMLCursor &,
+                                           DSRXMLCursor &cursor) const
+{
+    cursor = DSRXMLCursor();
+    return OFFalse;
+}
+#endif
+
+
+#if defined(WITH_LIBXML) && defined(LIBXML_READER_ENABLED)
+OFCondition DSRXMLDocument::finishStreaming()
+{
+    OFCondition result = EC_IllegalCall;
+    if (Stream != NULL)
+    {
+        /* parse the remainder of the document */
+        int status = Stream->Failed ? -1 : 1;
+        while (status == 1)
+            status = xmlTextReaderNext(Stream->Reader);
+        xmlGenericError(xmlGenericErrorContext, "-------------------------\n");
+        if (status < 0)
+        {
+            DCMSR_ERROR("Could not parse document");
+            result = SR_EC_InvalidDocument;
+        }
+        else if ((Stream->Flags & XF_validateSchema) && (xmlTextReaderIsValid(Stream->Reader) != 1))
+        {
+            DCMSR_ERROR("Document does not validate");
+            result = SR_EC_InvalidDocument;
+        } else
+            result = EC_Normal;
+        /* reset to default function (used the stream's buffer as context) */
+        xmlSetGenericErrorFunc(NULL, NULL);
+        delete Stream;
+        Stream = NULL;
+    }
+    return result;
+}
+#else /* WITH_LIBXML && LIBXML_READER_ENABLED */
+OFCondition DSRXMLDocument::finishStreaming()
+{
+    return EC_IllegalCall;
+}
+#endif
+
+
 OFBool DSRXMLDocument::encodingHandlerValid() const
 {
     return (EncodingHandler != NULL);
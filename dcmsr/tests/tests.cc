@@ -42,6 +42,7 @@ OFTEST_REGISTER(dcmsr_cloneSubTree_2);
 OFTEST_REGISTER(dcmsr_extractSubTree);
 OFTEST_REGISTER(dcmsr_gotoParentUntilRoot);
 OFTEST_REGISTER(dcmsr_gotoAnnotatedTreeNode);
+OFTEST_REGISTER(dcmsr_gotoIndexedTreeNode);
 OFTEST_REGISTER(dcmsr_addContentItem_1);
 OFTEST_REGISTER(dcmsr_addContentItem_2);
 OFTEST_REGISTER(dcmsr_addContentItem_3);
@@ -51,6 +52,7 @@ OFTEST_REGISTER(dcmsr_compareNodes);
 OFTEST_REGISTER(dcmsr_gotoNodeByValue);
 OFTEST_REGISTER(dcmsr_gotoMatchingNode);
 OFTEST_REGISTER(dcmsr_gotoNamedNode);
+OFTEST_REGISTER(dcmsr_gotoIndexedNamedNode);
 OFTEST_REGISTER(dcmsr_gotoNamedChildNode);
 OFTEST_REGISTER(dcmsr_gotoNamedNodeInSubTree);
 OFTEST_REGISTER(dcmsr_gotoAnnotatedNode);
@@ -70,6 +72,9 @@ OFTEST_REGISTER(dcmsr_setSpecificCharacterSet);
 OFTEST_REGISTER(dcmsr_changeDocumentType_1);
 OFTEST_REGISTER(dcmsr_changeDocumentType_2);
 OFTEST_REGISTER(dcmsr_setDocumentTree);
+#ifdef WITH_LIBXML
+OFTEST_REGISTER(dcmsr_readXMLStreamed);
+#endif // WITH_LIBXML
 OFTEST_REGISTER(dcmsr_rootTemplate);
 OFTEST_REGISTER(dcmsr_subTemplate_1);
 OFTEST_REGISTER(dcmsr_subTemplate_2);
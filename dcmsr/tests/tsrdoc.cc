@@ -26,6 +26,8 @@
 #include "dcmtk/ofstd/oftest.h"
 
 #include "dcmtk/dcmsr/dsrdoc.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/ofstream.h"
 
 
 OFTEST(dcmsr_setAndGetPatientData)
@@ -153,3 +155,75 @@ OFTEST(dcmsr_setDocumentTree)
     OFCHECK_EQUAL(newTree.countNodes(), 3);
     OFCHECK_EQUAL(doc.getDocumentType(), DSRTypes::DT_EnhancedSR);
 }
+
+
+#ifdef WITH_LIBXML
+
+/* write given document to XML file and read it again (with the given flags) */
+static void writeAndReadXML(DSRDocument &doc,
+                            const size_t writeFlags,
+                            const size_t readFlags,
+                            OFString &xmlOutput)
+{
+    OFTempFile tf(O_RDWR, "", "", ".xml");
+    STD_NAMESPACE ofstream xmlFile(tf.getFilename());
+    OFCHECK(doc.writeXML(xmlFile, writeFlags).good());
+    xmlFile.close();
+    DSRDocument readDoc;
+    OFCHECK(readDoc.readXML(tf.getFilename(), readFlags).good());
+    /* write document read from file again (for comparison) */
+    OFOStringStream stream;
+    OFCHECK(readDoc.writeXML(stream, writeFlags).good());
+    OFSTRINGSTREAM_GETOFSTRING(stream, tmpString)
+    xmlOutput = tmpString;
+}
+
+
+OFTEST(dcmsr_readXMLStreamed)
+{
+    /* create an SR document with a nested content tree */
+    DSRDocument doc(DSRTypes::DT_ComprehensiveSR);
+    OFCHECK(doc.setPatientName("Doe^Jane").good());
+    DSRDocumentTree &tree = doc.getTree();
+    OFCHECK(tree.addContentItem(DSRTypes::RT_isRoot, DSRTypes::VT_Container, DSRCodedEntryValue("126000", "DCM", "Imaging Measurement Report")).good());
+    OFCHECK(tree.getCurrentContentItem().setTemplateIdentification("1500", "DCMR").good());
+    for (size_t i = 0; i < 20; ++i)
+    {
+        OFCHECK(tree.addContentItem(DSRTypes::RT_contains, DSRTypes::VT_Container, (i == 0) ? DSRTypes::AM_belowCurrent : DSRTypes::AM_afterCurrent) > 0);
+        OFCHECK(tree.getCurrentContentItem().setConceptName(DSRCodedEntryValue("125007", "DCM", "Measurement Group")).good());
+        OFCHECK(tree.addChildContentItem(DSRTypes::RT_hasObsContext, DSRTypes::VT_Text, DSRCodedEntryValue("112039", "DCM", "Tracking Identifier")).good());
+        OFCHECK(tree.getCurrentContentItem().setStringValue("lesion").good());
+        OFCHECK(tree.addContentItem(DSRTypes::RT_contains, DSRTypes::VT_Num, DSRCodedEntryValue("121206", "DCM", "Distance")).good());
+        OFCHECK(tree.getCurrentContentItem().setNumericValue(DSRNumericMeasurementValue("1.5", DSRCodedEntryValue("mm", "UCUM", "millimeter"))).good());
+        OFCHECK(tree.addChildContentItem(DSRTypes::RT_hasConceptMod, DSRTypes::VT_Code, DSRCodedEntryValue("121401", "DCM", "Derivation")).good());
+        OFCHECK(tree.getCurrentContentItem().setCodeValue(DSRCodedEntryValue("R-00317", "SRT", "Mean")).good());
+        OFCHECK(tree.goUp() > 0);
+        OFCHECK(tree.goUp() > 0);
+    }
+    OFCHECK_EQUAL(tree.countNodes(), 81);
+    /* compare the results of both parsers */
+    const size_t writeFlags = DSRTypes::XF_writeTemplateIdentification;
+    OFString domOutput;
+    OFString streamOutput;
+    writeAndReadXML(doc, writeFlags, 0 /*readFlags*/, domOutput);
+    writeAndReadXML(doc, writeFlags, DSRTypes::XF_useStreamingParser, streamOutput);
+    OFCHECK(!streamOutput.empty());
+    OFCHECK_EQUAL(streamOutput, domOutput);
+    /* same with everything encoded as attributes and enclosing template elements */
+    const size_t attrFlags = DSRTypes::XF_writeTemplateIdentification | DSRTypes::XF_encodeEverythingAsAttribute | DSRTypes::XF_templateElementEnclosesItems;
+    OFOStringStream stream;
+    OFCHECK(doc.writeXML(stream, attrFlags).good());
+    OFSTRINGSTREAM_GETOFSTRING(stream, expected)
+    writeAndReadXML(doc, attrFlags, DSRTypes::XF_useStreamingParser | DSRTypes::XF_templateElementEnclosesItems, streamOutput);
+    OFCHECK_EQUAL(streamOutput, expected);
+    /* the streaming parser also detects syntax errors behind the content tree */
+    OFTempFile tf(O_RDWR, "", "", ".xml");
+    STD_NAMESPACE ofstream xmlFile(tf.getFilename());
+    OFCHECK(doc.writeXML(xmlFile).good());
+    xmlFile << "<report>" << OFendl;
+    xmlFile.close();
+    DSRDocument readDoc;
+    OFCHECK(readDoc.readXML(tf.getFilename(), DSRTypes::XF_useStreamingParser).bad());
+}
+
+#endif /* WITH_LIBXML */
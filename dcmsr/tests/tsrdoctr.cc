@@ -322,6 +322,78 @@ OFTEST(dcmsr_gotoNamedNode)
 }
 
 
+OFTEST(dcmsr_gotoIndexedNamedNode)
+{
+    /* first, create a new SR document with node index */
+    DSRDocument doc(DSRTypes::DT_ComprehensiveSR);
+    DSRDocumentTree &tree = doc.getTree();
+    tree.enableNodeIndex();
+    /* then add some content items */
+    OFCHECK(tree.addContentItem(DSRTypes::RT_isRoot, DSRTypes::VT_Container, DSRCodedEntryValue("121111", "DCM", "Summary")).good());
+    OFCHECK(tree.addChildContentItem(DSRTypes::RT_contains, DSRTypes::VT_Num, DSRCodedEntryValue("121206", "DCM", "Distance")).good());
+    const size_t nodeID1 = tree.getNodeID();
+    OFCHECK(tree.addChildContentItem(DSRTypes::RT_hasConceptMod, DSRTypes::VT_Code, DSRCodedEntryValue("1234", "99_PRV", "NOS")).good());
+    const size_t nodeID2 = tree.getNodeID();
+    OFCHECK(tree.goUp() > 0);
+    OFCHECK(tree.addContentItem(DSRTypes::RT_contains, DSRTypes::VT_Text, DSRCodedEntryValue("1234", "99_PRV", "NOS")).good());
+    const size_t nodeID3 = tree.getNodeID();
+    /* check the "search by name" function (using the index) */
+    OFString position;
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("1234", "99_PRV", "NOS")), nodeID2);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.1.1");
+    OFCHECK_EQUAL(tree.goUp(), nodeID1);
+    OFCHECK_EQUAL(tree.gotoNextNamedNode(DSRCodedEntryValue("1234", "99_PRV", "NOS")), nodeID2);
+    OFCHECK_EQUAL(tree.gotoNextNamedNode(DSRCodedEntryValue("1234", "99_PRV", "NOS")), nodeID3);
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121206", "DCM", "Distance")), nodeID1);
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121206", "DCM", "Distance"), OFTrue /*startFromRoot*/, OFFalse /*searchIntoSub*/), 0);
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), 0);
+    /* add a by-reference relationship (using the index) */
+    OFCHECK_EQUAL(tree.gotoNode(nodeID3), nodeID3);
+    const size_t refSource = tree.addByReferenceRelationship(DSRTypes::RT_inferredFrom, nodeID1);
+    OFCHECK(refSource > 0);
+    OFCHECK_EQUAL(tree.getNodeID(), nodeID3);
+    OFCHECK(tree.updateByReferenceRelationships().good());
+    OFCHECK_EQUAL(tree.gotoNode(refSource), refSource);
+    OFCHECK_EQUAL(tree.getCurrentContentItem().getReferencedNodeID(), nodeID1);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.2.1");
+    /* change a concept name, which is detected by the index */
+    OFCHECK_EQUAL(tree.gotoNode(nodeID1), nodeID1);
+    OFCHECK(tree.getCurrentContentItem().setConceptName(DSRCodedEntryValue("121207", "DCM", "Height")).good());
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), nodeID1);
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121206", "DCM", "Distance")), 0);
+    /* also when the current content item is modified after the search */
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), nodeID1);
+    DSRContentItem &contentItem = tree.getCurrentContentItem();
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), nodeID1);
+    OFCHECK(contentItem.setConceptName(DSRCodedEntryValue("121206", "DCM", "Distance")).good());
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121206", "DCM", "Distance")), nodeID1);
+    OFCHECK(contentItem.setConceptName(DSRCodedEntryValue("121207", "DCM", "Height")).good());
+    /* add a node with the same concept name before an indexed one */
+    OFCHECK_EQUAL(tree.gotoNode(nodeID2), nodeID2);
+    const size_t nodeID4 = tree.addContentItem(DSRTypes::RT_hasConceptMod, DSRTypes::VT_Code, DSRTypes::AM_beforeCurrent);
+    OFCHECK(nodeID4 > 0);
+    OFCHECK(tree.getCurrentContentItem().setConceptName(DSRCodedEntryValue("121207", "DCM", "Height")).good());
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), nodeID1);
+    OFCHECK_EQUAL(tree.gotoNextNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), nodeID4);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.1.1");
+    /* remove this node again */
+    OFCHECK(tree.removeCurrentContentItem() > 0);
+    OFCHECK_EQUAL(tree.gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), nodeID1);
+    OFCHECK_EQUAL(tree.gotoNextNamedNode(DSRCodedEntryValue("121207", "DCM", "Height")), 0);
+    /* the copy resolves the by-reference relationship (based on the position string) */
+    DSRDocumentTree *treeCopy = tree.clone();
+    OFCHECK(treeCopy != NULL);
+    if (treeCopy != NULL)
+    {
+        const size_t targetID = treeCopy->gotoNamedNode(DSRCodedEntryValue("121207", "DCM", "Height"));
+        OFCHECK(targetID > 0);
+        OFCHECK(treeCopy->gotoNode("1.2.1") > 0);
+        OFCHECK_EQUAL(treeCopy->getCurrentContentItem().getReferencedNodeID(), targetID);
+        delete treeCopy;
+    }
+}
+
+
 OFTEST(dcmsr_gotoNamedChildNode)
 {
     /* first, create a new SR document */
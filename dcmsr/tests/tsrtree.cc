@@ -604,3 +604,59 @@ OFTEST(dcmsr_gotoAnnotatedTreeNode)
     OFCHECK_EQUAL(tree.gotoNode(DSRTreeNodeAnnotation("root")), 0 /* not found */);
     OFCHECK_EQUAL(tree.gotoNode(DSRTreeNodeAnnotation("third child")), 0 /* not found */);
 }
+
+
+OFTEST(dcmsr_gotoIndexedTreeNode)
+{
+    DSRTree<> tree;
+    const size_t nodeID = tree.getNextNodeID();
+    tree.enableNodeIndex();
+    OFCHECK(tree.isNodeIndexEnabled());
+    /* first, create a simple tree of 6 nodes */
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode()), nodeID + 0);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_belowCurrent), nodeID + 1);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_afterCurrent), nodeID + 2);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_afterCurrent), nodeID + 3);
+    OFCHECK_EQUAL(tree.gotoPrevious(), nodeID + 2);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_belowCurrent), nodeID + 4);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_afterCurrent), nodeID + 5);
+    /* search by ID and by position, the cursor is the same as without index */
+    OFString position;
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 5), nodeID + 5);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.2.2");
+    OFCHECK_EQUAL(tree.getLevel(), 3);
+    OFCHECK_EQUAL(tree.gotoPrevious(), nodeID + 4);
+    OFCHECK_EQUAL(tree.goUp(), nodeID + 2);
+    OFCHECK_EQUAL(tree.gotoNode("1.3"), nodeID + 3);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.3");
+    OFCHECK_EQUAL(tree.goUp(), nodeID + 0);
+    OFCHECK_EQUAL(tree.gotoNode("1.02.1"), nodeID + 4);
+    OFCHECK_EQUAL(tree.gotoNode("1.4"), 0 /* not found */);
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 6), 0 /* not found */);
+    /* add nodes, which updates or invalidates the index */
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 3), nodeID + 3);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_belowCurrent), nodeID + 6);
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 1), nodeID + 1);
+    OFCHECK_EQUAL(tree.addNode(new DSRTreeNode(), DSRTypes::AM_beforeCurrent), nodeID + 7);
+    OFCHECK_EQUAL(tree.gotoNode("1.4.1"), nodeID + 6);
+    OFCHECK_EQUAL(tree.getLevel(), 3);
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 1), nodeID + 1);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.2");
+    OFCHECK_EQUAL(tree.gotoNode("1.1"), nodeID + 7);
+    /* remove a node and search again */
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 2), nodeID + 2);
+    OFCHECK_EQUAL(tree.removeNode(), nodeID + 3);
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 4), 0 /* not found */);
+    OFCHECK_EQUAL(tree.gotoNode(nodeID + 6), nodeID + 6);
+    OFCHECK_EQUAL(tree.getPosition(position), "1.3.1");
+    OFCHECK_EQUAL(tree.countNodes(), 5);
+    /* the copy also uses an index */
+    DSRTree<> tree2(tree);
+    OFCHECK(tree2.isNodeIndexEnabled());
+    OFCHECK(tree2.gotoNode("1.3.1") > 0);
+    OFCHECK_EQUAL(tree2.getLevel(), 3);
+    /* finally, disable the index */
+    tree.enableNodeIndex(OFFalse);
+    OFCHECK(!tree.isNodeIndexEnabled());
+    OFCHECK_EQUAL(tree.gotoNode("1.3.1"), nodeID + 6);
+}
@@ -30,6 +30,8 @@
 #include "dcmtk/oflog/oflog.h"
 #include "dcmtk/dcmtls/tlsdefin.h"
 #include "dcmtk/dcmtls/tlsciphr.h"    /* for DcmTLSCiphersuiteHandler */
+#include "dcmtk/ofstd/ofmap.h"        /* for OFMap */
+#include "dcmtk/ofstd/ofthread.h"     /* for OFMutex */
 
 #ifdef WITH_OPENSSL
 
@@ -40,6 +42,12 @@ typedef struct ssl_ctx_st SSL_CTX;
 struct x509_st;
 typedef struct x509_st X509;
 
+struct ssl_st;
+typedef struct ssl_st SSL;
+
+struct ssl_session_st;
+typedef struct ssl_session_st SSL_SESSION;
+
 extern DCMTK_DCMTLS_EXPORT OFLogger DCM_dcmtlsLogger;
 
 #define DCMTLS_TRACE(msg) OFLOG_TRACE(DCM_dcmtlsLogger, msg)
@@ -358,6 +366,57 @@ public:
    */
   const char *getServerSNI() const;
 
+  /** enables or disables the resumption of TLS sessions, which replaces the
+   *  full handshake (including the public key operations) by an abbreviated
+   *  handshake when a client connects again to the same server.
+   *  When acting as a server, the TLS sessions are kept in the session cache of
+   *  the OpenSSL context. When acting as a client, the last session negotiated
+   *  with each peer (identified by IP address, port number and SNI server name)
+   *  is stored and offered for the next connection to the same peer. This
+   *  requires that the same DcmTLSTransportLayer object is used for all
+   *  associations, e.g. with DcmSCU::useSecureConnection().
+   *  By default, session resumption is disabled.
+   *  @param enable OFTrue to enable session resumption, OFFalse to disable it
+   *  @param timeout lifetime of a TLS session in seconds, 0 to use the default
+   *    of the OpenSSL library (300 seconds)
+   */
+  void setSessionResumption(OFBool enable, long timeout = 0);
+
+  /** checks whether the resumption of TLS sessions is enabled
+   *  @return OFTrue if session resumption is enabled, OFFalse otherwise
+   */
+  OFBool getSessionResumption() const { return sessionResumption; }
+
+  /** enables or disables TLS session tickets (RFC 5077). With session tickets,
+   *  the server does not need to keep the state of a TLS session in its cache,
+   *  instead the encrypted state is sent to the client. If disabled, TLS 1.3
+   *  sessions are also kept in the server-side session cache.
+   *  By default, session tickets are enabled (default of the OpenSSL library).
+   *  @param enable OFTrue to enable session tickets, OFFalse to disable them
+   */
+  void setSessionTickets(OFBool enable);
+
+  /** removes all client-side TLS sessions stored for being resumed, i.e.\ the
+   *  next connection to each peer will use a full handshake.
+   */
+  void clearSessionCache();
+
+  /** returns the number of successful TLS handshakes that resumed a previous
+   *  TLS session (both as a client and as a server).
+   *  @return number of resumed handshakes
+   */
+  unsigned long getNumberOfResumedHandshakes() const;
+
+  /** returns the number of successful TLS handshakes that did not resume a
+   *  previous TLS session (both as a client and as a server).
+   *  @return number of full handshakes
+   */
+  unsigned long getNumberOfFullHandshakes() const;
+
+  /** resets the counters for resumed and full TLS handshakes to zero
+   */
+  void resetHandshakeCounters();
+
   /** adds the contents of a file to the seed for the cryptographic
    *  pseudo-random number generator. The file should contain real
    *  random entropy data gathered from keystrokes, system events,
@@ -511,6 +570,9 @@ public:
 
 private:
 
+  /// DcmTLSConnection reports completed handshakes and sessions to be resumed
+  friend class DcmTLSConnection;
+
   /// private undefined copy constructor
   DcmTLSTransportLayer(const DcmTLSTransportLayer&);
 
@@ -523,6 +585,33 @@ private:
    */
   static int lookupOpenSSLCertificateFormat(DcmKeyFileFormat fileType);
 
+  /** determine the key under which the client-side TLS session for the peer
+   *  of the given connection is stored
+   *  @param connection TLS connection, the socket must be connected
+   *  @param key the key is returned in this parameter
+   *  @return OFTrue if successful, OFFalse if the peer address is unknown
+   */
+  OFBool getSessionKey(SSL *connection, OFString& key) const;
+
+  /** offer the TLS session stored for the peer of the given connection (if
+   *  any) for being resumed. Called before the client-side handshake.
+   *  @param connection new TLS connection
+   */
+  void prepareSessionResumption(SSL *connection);
+
+  /** update the handshake counters after a successful handshake
+   *  @param connection TLS connection
+   */
+  void handshakeCompleted(SSL *connection);
+
+  /** store the TLS session of the given client-side connection for being
+   *  resumed by the next connection to the same peer. Called before the
+   *  connection is closed, since TLS 1.3 session tickets are only received
+   *  after the handshake.
+   *  @param connection TLS connection
+   */
+  void storeSession(SSL *connection);
+
   /// OpenSSL context data, needed only once per application
   SSL_CTX *transportLayerContext;
 
@@ -553,6 +642,23 @@ private:
   /// DSA certificates.
   OFBool certificateTypeIsDSA;
 
+  /// flag indicating whether TLS session resumption is enabled
+  OFBool sessionResumption;
+
+  /// client-side TLS sessions to be resumed, one per peer
+  OFMap<OFString, SSL_SESSION *> clientSessions;
+
+  /// number of successful handshakes that resumed a TLS session
+  unsigned long resumedHandshakes;
+
+  /// number of successful handshakes that did not resume a TLS session
+  unsigned long fullHandshakes;
+
+#ifdef WITH_THREADS
+  /// mutex protecting the client-side sessions and the handshake counters
+  mutable OFMutex sessionMutex;
+#endif
+
 };
 
 #endif /* WITH_OPENSSL */
@@ -151,6 +151,26 @@ public:
    */
   virtual void setDHParam(const OFString& dhParam);
 
+  /** Enable or disable the resumption of TLS sessions. If enabled, the TLS
+   *  transport layer is kept after closing an association, so the next
+   *  association to the same peer can resume the TLS session, i.e.\ use an
+   *  abbreviated handshake. The TLS parameters are then only applied by the
+   *  first call of initNetwork(). Default is that session resumption is disabled.
+   *  @param enabled OFTrue to enable session resumption, OFFalse to disable it
+   */
+  virtual void setSessionResumption(const OFBool enabled);
+
+  /** Returns OFTrue if the resumption of TLS sessions is enabled
+   *  @return OFTrue if session resumption is enabled, OFFalse otherwise
+   */
+  virtual OFBool getSessionResumption() const;
+
+  /** Get the TLS transport layer, e.g.\ for querying the number of resumed
+   *  and full TLS handshakes
+   *  @return the TLS transport layer, NULL if not (or no longer) available
+   */
+  virtual const DcmTLSTransportLayer *getTLSTransportLayer() const;
+
   /** Returns OFTrue if authentication is enabled
    *  @param privKeyFile   The file containing the private key used
    *  @param certFile      The file containing the certificate used
@@ -244,6 +264,9 @@ private:
   /// only validated if present
   DcmCertificateVerification m_certVerification;
 
+  /// If enabled, TLS sessions are resumed and the TLS layer is kept between associations
+  OFBool m_sessionResumption;
+
 };
 
 #endif // WITH_OPENSSL
@@ -49,6 +49,7 @@ END_EXTERN_C
 #include "dcmtk/dcmtls/tlstrans.h"
 #include "dcmtk/dcmnet/dicom.h"
 #include "dcmtk/ofstd/ofrand.h"
+#include "dcmtk/ofstd/ofsockad.h"
 
 #ifdef HAVE_OPENSSL_PROTOTYPE_SSL_CTX_GET0_PARAM
 #define DCMTK_SSL_CTX_get0_param SSL_CTX_get0_param
@@ -369,6 +370,13 @@ DcmTLSTransportLayer::DcmTLSTransportLayer()
 , clientSNI(NULL)
 , serverSNI(NULL)
 , certificateTypeIsDSA(OFFalse)
+, sessionResumption(OFFalse)
+, clientSessions()
+, resumedHandshakes(0)
+, fullHandshakes(0)
+#ifdef WITH_THREADS
+, sessionMutex()
+#endif
 {
 }
 
@@ -385,6 +393,13 @@ DcmTLSTransportLayer::DcmTLSTransportLayer(T_ASC_NetworkRole networkRole, const
 , clientSNI(NULL)
 , serverSNI(NULL)
 , certificateTypeIsDSA(OFFalse)
+, sessionResumption(OFFalse)
+, clientSessions()
+, resumedHandshakes(0)
+, fullHandshakes(0)
+#ifdef WITH_THREADS
+, sessionMutex()
+#endif
 {
    if (initOpenSSL) initializeOpenSSL();
    if (randFile) seedPRNG(randFile);
@@ -456,7 +471,8 @@ DcmTLSTransportLayer::DcmTLSTransportLayer(T_ASC_NetworkRole networkRole, const
        DCMTLS_ERROR("unable to set TLS session ID context.");
      }
 
-     // disable session caching (and, thus, session re-use)
+     // disable session caching (and, thus, session re-use) unless
+     // enabled by a call to setSessionResumption()
      SSL_CTX_set_session_cache_mode(transportLayerContext, SSL_SESS_CACHE_OFF);
 
      // create Elliptic Curve DH parameters
@@ -572,7 +588,16 @@ DcmTLSTransportLayer::DcmTLSTransportLayer(OFrvalue_ref(DcmTLSTransportLayer) rh
 , transportLayerContext(rhs.transportLayerContext)
 , canWriteRandseed(OFmove(OFrvalue_access(rhs).canWriteRandseed))
 , privateKeyPasswd(OFmove(OFrvalue_access(rhs).privateKeyPasswd))
+, sessionResumption(OFrvalue_access(rhs).sessionResumption)
+, clientSessions()
+, resumedHandshakes(OFrvalue_access(rhs).resumedHandshakes)
+, fullHandshakes(OFrvalue_access(rhs).fullHandshakes)
+#ifdef WITH_THREADS
+, sessionMutex()
+#endif
 {
+  // the stored sessions belong to the OpenSSL context, so they are moved as well
+  clientSessions.swap(OFrvalue_access(rhs).clientSessions);
   OFrvalue_access(rhs).transportLayerContext = NULL;
 }
 
@@ -586,6 +611,10 @@ DcmTLSTransportLayer& DcmTLSTransportLayer::operator=(OFrvalue_ref(DcmTLSTranspo
     transportLayerContext = rhs.transportLayerContext;
     canWriteRandseed = OFmove(OFrvalue_access(rhs).canWriteRandseed);
     privateKeyPasswd = OFmove(OFrvalue_access(rhs).privateKeyPasswd);
+    sessionResumption = OFrvalue_access(rhs).sessionResumption;
+    clientSessions.swap(OFrvalue_access(rhs).clientSessions);
+    resumedHandshakes = OFrvalue_access(rhs).resumedHandshakes;
+    fullHandshakes = OFrvalue_access(rhs).fullHandshakes;
     OFrvalue_access(rhs).transportLayerContext = NULL;
   }
   return *this;
@@ -595,10 +624,14 @@ void DcmTLSTransportLayer::clear()
 {
   if (transportLayerContext)
   {
+    clearSessionCache();
     SSL_CTX_free(transportLayerContext);
     transportLayerContext = NULL;
     canWriteRandseed = OFFalse;
     privateKeyPasswd.clear();
+    sessionResumption = OFFalse;
+    resumedHandshakes = 0;
+    fullHandshakes = 0;
   }
 }
 
@@ -716,6 +749,179 @@ void DcmTLSTransportLayer::setPrivateKeyPasswdFromConsole()
   return;
 }
 
+void DcmTLSTransportLayer::setSessionResumption(OFBool enable, long timeout)
+{
+  sessionResumption = enable;
+  if (transportLayerContext)
+  {
+    long mode = SSL_SESS_CACHE_OFF;
+    if (enable)
+    {
+      if (role != NET_REQUESTOR) mode |= SSL_SESS_CACHE_SERVER;
+      // client-side sessions are stored per peer by this class, see storeSession()
+      if (role == NET_REQUESTOR) mode |= SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE;
+      if (timeout > 0) SSL_CTX_set_timeout(transportLayerContext, timeout);
+    }
+    SSL_CTX_set_session_cache_mode(transportLayerContext, mode);
+  }
+  if (!enable) clearSessionCache();
+}
+
+void DcmTLSTransportLayer::setSessionTickets(OFBool enable)
+{
+  if (transportLayerContext)
+  {
+    if (enable) SSL_CTX_clear_options(transportLayerContext, SSL_OP_NO_TICKET);
+    else SSL_CTX_set_options(transportLayerContext, SSL_OP_NO_TICKET);
+  }
+}
+
+void DcmTLSTransportLayer::clearSessionCache()
+{
+#ifdef WITH_THREADS
+  sessionMutex.lock();
+#endif
+  OFMap<OFString, SSL_SESSION *>::iterator it = clientSessions.begin();
+  while (it != clientSessions.end())
+  {
+    SSL_SESSION_free((*it).second);
+    ++it;
+  }
+  clientSessions.clear();
+#ifdef WITH_THREADS
+  sessionMutex.unlock();
+#endif
+}
+
+unsigned long DcmTLSTransportLayer::getNumberOfResumedHandshakes() const
+{
+#ifdef WITH_THREADS
+  sessionMutex.lock();
+#endif
+  unsigned long result = resumedHandshakes;
+#ifdef WITH_THREADS
+  sessionMutex.unlock();
+#endif
+  return result;
+}
+
+unsigned long DcmTLSTransportLayer::getNumberOfFullHandshakes() const
+{
+#ifdef WITH_THREADS
+  sessionMutex.lock();
+#endif
+  unsigned long result = fullHandshakes;
+#ifdef WITH_THREADS
+  sessionMutex.unlock();
+#endif
+  return result;
+}
+
+void DcmTLSTransportLayer::resetHandshakeCounters()
+{
+#ifdef WITH_THREADS
+  sessionMutex.lock();
+#endif
+  resumedHandshakes = 0;
+  fullHandshakes = 0;
+#ifdef WITH_THREADS
+  sessionMutex.unlock();
+#endif
+}
+
+OFBool DcmTLSTransportLayer::getSessionKey(SSL *connection, OFString& key) const
+{
+  OFSockAddr peer;
+  socklen_t len = sizeof(struct sockaddr_storage);
+  if (getpeername(OFstatic_cast(DcmNativeSocketType, SSL_get_fd(connection)), peer.getSockaddr(), &len) != 0) return OFFalse;
+
+  // the key consists of the binary IP address and port number of the peer,
+  // followed by the SNI server name requested from the peer (if any)
+  if (peer.getFamily() == AF_INET)
+  {
+    const struct sockaddr_in *si = peer.getSockaddr_in_const();
+    key.assign(OFreinterpret_cast(const char *, &si->sin_addr), sizeof(si->sin_addr));
+    key.append(OFreinterpret_cast(const char *, &si->sin_port), sizeof(si->sin_port));
+  }
+  else if (peer.getFamily() == AF_INET6)
+  {
+    const struct sockaddr_in6 *si6 = peer.getSockaddr_in6_const();
+    key.assign(OFreinterpret_cast(const char *, &si6->sin6_addr), sizeof(si6->sin6_addr));
+    key.append(OFreinterpret_cast(const char *, &si6->sin6_port), sizeof(si6->sin6_port));
+  }
+  else return OFFalse;
+  if (clientSNI) key.append(clientSNI);
+  return OFTrue;
+}
+
+void DcmTLSTransportLayer::prepareSessionResumption(SSL *connection)
+{
+  OFString key;
+  if (sessionResumption && getSessionKey(connection, key))
+  {
+#ifdef WITH_THREADS
+    sessionMutex.lock();
+#endif
+    OFMap<OFString, SSL_SESSION *>::iterator it = clientSessions.find(key);
+    if (it != clientSessions.end())
+    {
+      // SSL_set_session() increments the reference count of the session
+      if (SSL_set_session(connection, (*it).second))
+        DCMTLS_DEBUG("Offering previous TLS session for resumption");
+    }
+#ifdef WITH_THREADS
+    sessionMutex.unlock();
+#endif
+  }
+}
+
+void DcmTLSTransportLayer::handshakeCompleted(SSL *connection)
+{
+  OFBool reused = SSL_session_reused(connection) ? OFTrue : OFFalse;
+  DCMTLS_DEBUG("TLS handshake completed, " << (reused ? "resumed previous session" : "full handshake"));
+#ifdef WITH_THREADS
+  sessionMutex.lock();
+#endif
+  if (reused) ++resumedHandshakes; else ++fullHandshakes;
+#ifdef WITH_THREADS
+  sessionMutex.unlock();
+#endif
+}
+
+void DcmTLSTransportLayer::storeSession(SSL *connection)
+{
+  OFString key;
+  if (sessionResumption && !SSL_is_server(connection) && SSL_is_init_finished(connection) && getSessionKey(connection, key))
+  {
+    SSL_SESSION *session = SSL_get1_session(connection);
+#ifdef HAVE_OPENSSL_PROTOTYPE_SSL_SESSION_IS_RESUMABLE
+    // with TLS 1.3, a session is only resumable after a session ticket has been received
+    if (session && !SSL_SESSION_is_resumable(session))
+    {
+      SSL_SESSION_free(session);
+      session = NULL;
+    }
+#endif
+    if (session)
+    {
+#ifdef WITH_THREADS
+      sessionMutex.lock();
+#endif
+      // replace the previous session for this peer (if any)
+      OFMap<OFString, SSL_SESSION *>::iterator it = clientSessions.find(key);
+      if (it != clientSessions.end())
+      {
+        SSL_SESSION_free((*it).second);
+        (*it).second = session;
+      }
+      else clientSessions.insert(OFMake_pair(key, session));
+#ifdef WITH_THREADS
+      sessionMutex.unlock();
+#endif
+    }
+  }
+}
+
 void DcmTLSTransportLayer::setCertificateVerification(DcmCertificateVerification verificationType)
 {
   if (transportLayerContext)
@@ -1098,6 +1304,9 @@ DcmTransportConnection *DcmTLSTransportLayer::createConnection(DcmNativeSocketTy
         // for use by the certificate verification callback
         SSL_set_ex_data(newConnection, contextStoreIndex, this);
 
+        // offer a previous TLS session to the server (if enabled)
+        if (role == NET_REQUESTOR) prepareSessionResumption(newConnection);
+
         return new DcmTLSConnection(openSocket, newConnection);
       }
     }
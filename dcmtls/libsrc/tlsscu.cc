@@ -44,7 +44,8 @@ DcmTLSSCU::DcmTLSSCU() :
   m_passwd(NULL),
   m_readSeedFile(""),
   m_writeSeedFile(""),
-  m_certVerification(DCV_requireCertificate)
+  m_certVerification(DCV_requireCertificate),
+  m_sessionResumption(OFFalse)
 {
 }
 
@@ -63,7 +64,8 @@ DcmTLSSCU::DcmTLSSCU(const OFString& peerHost,
   m_passwd(NULL),
   m_readSeedFile(""),
   m_writeSeedFile(""),
-  m_certVerification(DCV_requireCertificate)
+  m_certVerification(DCV_requireCertificate),
+  m_sessionResumption(OFFalse)
 {
   setPeerHostName(peerHost);
   setPeerAETitle(peerAETitle);
@@ -73,6 +75,11 @@ DcmTLSSCU::DcmTLSSCU(const OFString& peerHost,
 
 DcmTLSSCU::~DcmTLSSCU()
 {
+  // close the association (if any) while the TLS layer is still available
+  if (isConnected())
+    DcmTLSSCU::closeAssociation(DCMSCU_ABORT_ASSOCIATION);
+  delete m_tLayer;
+  m_tLayer = NULL;
   if (m_passwd)
   {
     delete[] m_passwd;
@@ -85,6 +92,15 @@ OFCondition DcmTLSSCU::initNetwork()
 {
   OFCondition cond;
 
+  /* Reuse the TLS layer of the previous association (with session resumption enabled) */
+  if (m_tLayer != NULL)
+  {
+    cond = DcmSCU::initNetwork();
+    if (cond.good())
+      cond = useSecureConnection(m_tLayer);
+    return cond;
+  }
+
   /* First, create TLS layer */
   m_tLayer = new DcmTLSTransportLayer(NET_REQUESTOR, m_readSeedFile.c_str(), OFTrue /* initialize OpenSSL */);
   if (m_tLayer == NULL)
@@ -92,6 +108,7 @@ OFCondition DcmTLSSCU::initNetwork()
     DCMTLS_ERROR("Unable to create TLS transport layer for SCP, maybe problem with seed file?");
     return EC_IllegalCall; // TODO: need to find better error code
   }
+  m_tLayer->setSessionResumption(m_sessionResumption);
 
   /* Add trusted certificates from files and directories
    */
@@ -176,7 +193,9 @@ OFCondition DcmTLSSCU::negotiateAssociation()
   OFCondition cond = DcmSCU::negotiateAssociation();
   if (cond.bad())
   {
-    // if something goes wrong, delete TLS structures
+    // if something goes wrong, close the connection (if any) before deleting TLS structures
+    if (isConnected())
+      DcmSCU::closeAssociation(DCMSCU_ABORT_ASSOCIATION);
     delete m_tLayer;
     m_tLayer = NULL;
   }
@@ -201,8 +220,12 @@ void DcmTLSSCU::closeAssociation(const DcmCloseAssociationType closeType)
       DCMNET_WARN("Cannot write random seed, ignoring");
     }
   }
-  delete m_tLayer;
-  m_tLayer = NULL;
+  // keep the TLS layer (and, thus, the TLS sessions) for the next association
+  if (!m_sessionResumption)
+  {
+    delete m_tLayer;
+    m_tLayer = NULL;
+  }
 }
 
 
@@ -338,6 +361,26 @@ OFString DcmTLSSCU::getWriteSeedFile() const
 }
 
 
+void DcmTLSSCU::setSessionResumption(const OFBool enabled)
+{
+  m_sessionResumption = enabled;
+  if (m_tLayer)
+    m_tLayer->setSessionResumption(enabled);
+}
+
+
+OFBool DcmTLSSCU::getSessionResumption() const
+{
+  return m_sessionResumption;
+}
+
+
+const DcmTLSTransportLayer *DcmTLSSCU::getTLSTransportLayer() const
+{
+  return m_tLayer;
+}
+
+
 void DcmTLSSCU::setDHParam(const OFString& dhParam)
 {
   if (!m_tLayer->setTempDHParameters(dhParam.c_str()))
@@ -137,7 +137,12 @@ OFCondition DcmTLSConnection::serverSideHandshake()
   // if the certificate verification has failed, the certificate is already
   // unavailable at this point. We know that something has gone wrong, but
   // OpenSSL does not tell us who tried to connect.
-  if (result == SSL_ERROR_NONE) logTLSConnection();
+  if (result == SSL_ERROR_NONE)
+  {
+    logTLSConnection();
+    DcmTLSTransportLayer *tlayer = OFreinterpret_cast(DcmTLSTransportLayer *, SSL_get_ex_data(tlsConnection, DcmTLSTransportLayer::contextStoreIndex));
+    if (tlayer) tlayer->handshakeCompleted(tlsConnection);
+  }
 
   return convertSSLError(result);
 }
@@ -147,7 +152,12 @@ OFCondition DcmTLSConnection::clientSideHandshake()
   DCMTLS_TRACE("Starting TLS client handshake");
   if (tlsConnection == NULL) return DCMTLS_EC_NoTLSTransportConnectionPresent;
   int result = SSL_get_error(tlsConnection, SSL_connect(tlsConnection));
-  if (result == SSL_ERROR_NONE) logTLSConnection();
+  if (result == SSL_ERROR_NONE)
+  {
+    logTLSConnection();
+    DcmTLSTransportLayer *tlayer = OFreinterpret_cast(DcmTLSTransportLayer *, SSL_get_ex_data(tlsConnection, DcmTLSTransportLayer::contextStoreIndex));
+    if (tlayer) tlayer->handshakeCompleted(tlsConnection);
+  }
 
   return convertSSLError(result);
 }
@@ -185,7 +195,18 @@ void DcmTLSConnection::close()
     // execute SSL_shutdown(), which sends the TLS close_notify alert to the peer,
     // unless we are the parent process after a fork() operation and this connection
     // will be handled by the client.
-    if (! isParentProcessMode()) SSL_shutdown(tlsConnection);
+    if (! isParentProcessMode())
+    {
+      // keep the TLS session for being resumed by the next connection to the
+      // same peer (if enabled). This is done here and not after the handshake
+      // because TLS 1.3 session tickets are sent after the handshake.
+      if (! SSL_is_server(tlsConnection))
+      {
+        DcmTLSTransportLayer *tlayer = OFreinterpret_cast(DcmTLSTransportLayer *, SSL_get_ex_data(tlsConnection, DcmTLSTransportLayer::contextStoreIndex));
+        if (tlayer) tlayer->storeSession(tlsConnection);
+      }
+      SSL_shutdown(tlsConnection);
+    }
     SSL_free(tlsConnection);
     tlsConnection = NULL;
   }
@@ -483,6 +483,126 @@ OFTEST_FLAGS(dcmtls_scp_pool_tls, EF_None)
     pool.join();
 }
 
+
+// Helper function for dcmtls_session_resumption: negotiate and release one association.
+// If given, the SCP is told to stop after this association.
+static void run_association(DcmSCU& scu, DcmTLSTransportLayer& tlsLayer, TestSCP *lastAssocSCP = NULL)
+{
+    OFCHECK(scu.initNetwork().good());
+    OFCHECK(scu.useSecureConnection(&tlsLayer).good());
+    OFCHECK(scu.negotiateAssociation().good());
+    if (lastAssocSCP)
+    {
+        lastAssocSCP->m_set_stop_after_assoc = OFTrue;
+        lastAssocSCP->m_set_stop_after_timeout = OFTrue;
+    }
+    if (scu.isConnected())
+        OFCHECK(scu.releaseAssociation().good());
+}
+
+
+// Test case that checks resumption of TLS sessions on client and server side
+OFTEST_FLAGS(dcmtls_session_resumption, EF_None)
+{
+    /// Write key and cert files
+    write_temp_key_cert_files();
+
+    /// Init logs
+    initLogs();
+
+    /// Init scp tls layer with session cache
+    OFCondition result;
+    DcmTLSTransportLayer scpTlsLayer(NET_ACCEPTOR, NULL, OFTrue);
+    scpTlsLayer.setPrivateKeyPasswd(PRIVATE_KEY_PWD);
+    result = scpTlsLayer.setPrivateKeyFile(PRIVATE_KEY_FILENAME, DCF_Filetype_PEM);
+    OFCHECK(result.good());
+    result = scpTlsLayer.setCertificateFile(PUBLIC_SELFSIGNED_CERT_FILENAME, DCF_Filetype_PEM, TSP_Profile_BCP_195_RFC_8996);
+    OFCHECK(result.good());
+    OFCHECK(scpTlsLayer.checkPrivateKeyMatchesCertificate());
+    scpTlsLayer.setCertificateVerification(DCV_ignoreCertificate);
+    OFCHECK(!scpTlsLayer.getSessionResumption());
+    scpTlsLayer.setSessionResumption(OFTrue, 60);
+    OFCHECK(scpTlsLayer.getSessionResumption());
+
+    /// Init and run Scp server with tls
+    OFRandom rnd;
+    TestSCP scp;
+    DcmSCPConfig& config = scp.getConfig();
+    config.setAETitle("ACCEPTOR");
+    config.setACSETimeout(30);
+    config.setConnectionTimeout(1);
+    config.setMaxReceivePDULength(16856);
+    config.setHostLookupEnabled(false);
+    config.setConnectionBlockingMode(DUL_NOBLOCK);
+    config.setRespondWithCalledAETitle("REQUESTOR");
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    OFCHECK(config.addPresentationContext(UID_VerificationSOPClass, xfers, ASC_SC_ROLE_SCP).good());
+    config.setTransportLayer(&scpTlsLayer);
+
+    // Ensure server is up and listening
+    int i = 0;
+    Uint16 port_number = 0;
+    OFMutex memory_barrier;
+    do
+    {
+      // generate a random port number between 61440 (0xF000) and 65535
+      port_number = 0xF000 + (rnd.getRND16() & 0xFFF);
+      config.setPort(port_number);
+      scp.start();
+      force_sleep(2); // wait 2 seconds for the SCP process to start
+      memory_barrier.lock();
+      memory_barrier.unlock();
+    }
+    while ((i++ < 5) && (! scp.m_is_running)); // try up to 5 port numbers before giving up
+
+    if (! scp.m_is_running) BAILOUT("Start of the SCP thread failed: " << scp.m_listen_result.text());
+
+    /// Init scu tls layer, which is used for all associations
+    DcmTLSTransportLayer scuTlsLayer(NET_REQUESTOR, NULL, OFFalse);
+    scuTlsLayer.setCertificateVerification(DCV_ignoreCertificate);
+    scuTlsLayer.setSessionResumption(OFTrue);
+
+    // Configure SCU
+    DcmSCU scu;
+    scu.setMaxReceivePDULength(16856);
+    scu.setDIMSEBlockingMode(DIMSE_NONBLOCKING);
+    scu.setDIMSETimeout(300);
+    scu.setACSETimeout(30);
+    scu.setPeerAETitle("ACCEPTOR");
+    scu.setAETitle("REQUESTOR");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(port_number);
+    OFCHECK(scu.addPresentationContext(UID_VerificationSOPClass, xfers, ASC_SC_ROLE_SCU).good());
+
+    // The first association needs a full handshake, the second one resumes the session
+    run_association(scu, scuTlsLayer);
+    run_association(scu, scuTlsLayer);
+    OFCHECK_EQUAL(scuTlsLayer.getNumberOfFullHandshakes(), 1);
+    OFCHECK_EQUAL(scuTlsLayer.getNumberOfResumedHandshakes(), 1);
+    OFCHECK_EQUAL(scpTlsLayer.getNumberOfFullHandshakes(), 1);
+    OFCHECK_EQUAL(scpTlsLayer.getNumberOfResumedHandshakes(), 1);
+
+    // Without session tickets, the session is resumed from the server-side cache
+    scpTlsLayer.setSessionTickets(OFFalse);
+    scuTlsLayer.clearSessionCache();
+    run_association(scu, scuTlsLayer);
+    run_association(scu, scuTlsLayer);
+    OFCHECK_EQUAL(scuTlsLayer.getNumberOfFullHandshakes(), 2);
+    OFCHECK_EQUAL(scuTlsLayer.getNumberOfResumedHandshakes(), 2);
+
+    // Without session resumption on client side, all handshakes are full handshakes
+    scuTlsLayer.setSessionResumption(OFFalse);
+    scuTlsLayer.resetHandshakeCounters();
+    run_association(scu, scuTlsLayer);
+    run_association(scu, scuTlsLayer, &scp);
+    OFCHECK_EQUAL(scuTlsLayer.getNumberOfFullHandshakes(), 2);
+    OFCHECK_EQUAL(scuTlsLayer.getNumberOfResumedHandshakes(), 0);
+    scp.join();
+    OFCHECK_EQUAL(scpTlsLayer.getNumberOfFullHandshakes(), 4);
+    OFCHECK_EQUAL(scpTlsLayer.getNumberOfResumedHandshakes(), 2);
+}
+
 #endif // WITH_OPENSSL
 
 #endif // WITH_THREADS
@@ -498,6 +618,10 @@ OFTEST(dcmtls_scp_pool_tls)
 {
 }
 
+OFTEST(dcmtls_session_resumption)
+{
+}
+
 // This dummy function creates a dependency on libdcmnet that is required when compiling
 // on NetBSD with libwrap support enabled and OpenSSL support disabled. Otherwise there
 // would be a linker error complaining about unresolved symbols allow_severity and deny_severity.
@@ -35,6 +35,7 @@ class TrcTracksStatistic;
 class TrcTrackSetStatistic;
 class TrcTrack;
 class TrcMeasurement;
+class TrcTractographyResults;
 
 /** Class representing a Track Set within the Tractography Results IOD. A Track
  *  Set is a set of tracks (really), and might define a measurements and
@@ -50,6 +51,9 @@ public:
   /// Allow read/write functions in DcmIODUtil to access class internals
   friend class DcmIODUtil;
 
+  /// Allow Tractography Results to stream point data when saving to file
+  friend class TrcTractographyResults;
+
   /** Create TrcTrackSet object by proving required data
    *  @param  trackSetLabel Label for the Track Set (256 chars max, VR=LO)
    *  @param  trackSetDescription Description for the Track Set (2^32-2 bytes
@@ -107,11 +111,38 @@ public:
   virtual OFCondition read(DcmItem& source,
                            const OFBool clearOldData = OFTrue);
 
-  /** Get Tracks of this Track Set
+  /** Get Tracks of this Track Set. Tracks that have been added using
+   *  importTracks() or that have been read from a dataset are held in a
+   *  single contiguous buffer. On the first call of this method, a TrcTrack
+   *  object is created for each of them, which requires memory for every
+   *  single track. For large Track Sets use getTrackData() or exportTracks()
+   *  instead.
    *  @return Reference to Tracks of this Track Set
    */
   virtual const OFVector<TrcTrack*>& getTracks();
 
+  /** Get point data of a single Track without creating TrcTrack objects
+   *  @param  trackIndex The index of the Track (starting from 0)
+   *  @param  data Returns pointer to the point data (x,y,z coordinate for
+   *          each point). NULL if Track does not exist.
+   *  @return The number of points in data, 0 if Track does not exist
+   */
+  virtual size_t getTrackData(const size_t trackIndex,
+                              const Float32*& data);
+
+  /** Get color mode of a single Track without creating TrcTrack objects
+   *  @param  trackIndex The index of the Track (starting from 0)
+   *  @return The color mode, CM_ERROR if color information is invalid or
+   *          Track does not exist
+   */
+  virtual TrcTypes::E_TrackColorMode getTrackColorMode(const size_t trackIndex);
+
+  /** Check data of all Tracks
+   *  @param  quiet If OFTrue, errors are not reported to the logger
+   *  @return EC_Normal if all Tracks are valid, error otherwise
+   */
+  virtual OFCondition checkTracks(const OFBool quiet = OFFalse);
+
   /** Write attributes from this class into given item
    *  @param  destination The item to write to
    *  @result EC_Normal if writing was successful, error otherwise
@@ -267,6 +298,63 @@ public:
                                const size_t numColors,
                                TrcTrack*& result);
 
+  /** Add many tracks at once to Track Set. The point data of all tracks is
+   *  taken from a single contiguous buffer and copied into a single buffer
+   *  within this Track Set, i.e.\ no TrcTrack object is created per track.
+   *  This is the preferred way of adding large numbers of tracks, ideally
+   *  with a single call for all tracks since the buffer is grown on each call.
+   *  @param  pointData Array of points of all tracks (x,y,z coordinate for
+   *          each point), tracks following each other
+   *  @param  trackOffsets Array with numTracks + 1 entries. Entry i contains
+   *          the index of the first point of track i in pointData (i.e.\
+   *          number of coordinates divided by 3), the last entry contains the
+   *          index behind the last point of the last track. Every track must
+   *          contain at least one point, and its point data must not exceed
+   *          4 GB (i.e.\ the maximum length of a DICOM element value).
+   *  @param  numTracks Number of tracks to add
+   *  @param  recommendedCIELabColors Recommended display color(s) as CIELab
+   *          values, i.e. L,a,b component(s). There are 3 modes:
+   *          1) One color per track: numColors equals numTracks.
+   *          2) No color (NULL): Color is not defined on a per-track basis but
+   *          must be defined on Track Set level
+   *          3) One color per point: numColors equals the total number of
+   *          points.
+   *  @param  numColors Number of colors defined in recommendedCIELabColors
+   *  @return EC_Normal if successful, EC_TooManyBytesRequested if a track is
+   *          too large, error otherwise
+   */
+  virtual OFCondition importTracks(const Float32* pointData,
+                                   const size_t* trackOffsets,
+                                   const size_t numTracks,
+                                   const Uint16* recommendedCIELabColors,
+                                   const size_t numColors);
+
+  /** Export point data of all tracks into a single contiguous buffer,
+   *  without creating TrcTrack objects
+   *  @param  pointData Returns the points of all tracks (x,y,z coordinate
+   *          for each point), tracks following each other
+   *  @param  trackOffsets Returns number of tracks + 1 entries. Entry i
+   *          contains the index of the first point of track i in pointData,
+   *          the last entry contains the total number of points.
+   *  @return EC_Normal if successful, error otherwise
+   */
+  virtual OFCondition exportTracks(OFVector<Float32>& pointData,
+                                   OFVector<size_t>& trackOffsets);
+
+  /** Export colors of all tracks into a single contiguous buffer, without
+   *  creating TrcTrack objects
+   *  @param  colors Returns the CIELab colors (L,a,b components), either one
+   *          per track or one per point, or no color at all (see mode)
+   *  @param  mode Returns CM_TRACK, CM_POINTS or CM_TRACKSET (no colors).
+   *          If tracks are colored per track as well as per point, the
+   *          track colors are repeated for every point and CM_POINTS is
+   *          returned.
+   *  @return EC_Normal if successful, TRC_EC_InvalidColorInformation if
+   *          only some tracks are colored or color information is invalid
+   */
+  virtual OFCondition exportTrackColors(OFVector<Uint16>& colors,
+                                        TrcTypes::E_TrackColorMode& mode);
+
   /** Add measurement for this Track Set
    *  @param  measurementCode The type of measurement. DICOM prescribes a code
    *          from  CID 7263 "Diffusion Tractography Measurement Types"
@@ -435,6 +523,27 @@ protected:
   OFCondition writeTracks(OFCondition& result,
                           DcmItem& destination);
 
+  /** Reads Tracks from Track Sequence into the contiguous point buffer.
+   *  This is only possible if all Tracks use the same color mode.
+   *  @param  sequence The Track Sequence to read from
+   *  @return OFTrue if Tracks could be read, OFFalse otherwise (i.e.\ if
+   *          they have to be read as individual TrcTrack objects)
+   */
+  OFBool readTrackData(DcmSequenceOfItems& sequence);
+
+  /** Write Tracks held in the contiguous point buffer (as well as those held
+   *  as TrcTrack objects) into a newly created Track Sequence
+   *  @param  destination The destination item to write to
+   *  @return EC_Normal if writing was successful, error otherwise
+   */
+  OFCondition writeTrackData(DcmItem& destination);
+
+  /** Create TrcTrack objects for all Tracks held in the contiguous point
+   *  buffer and clear the buffer afterwards
+   *  @return EC_Normal if successful, error otherwise
+   */
+  OFCondition createTrackObjects();
+
   /** Check whether measurements have data for all tracks
    *  @return EC_Normal measurement data is complete, TRC_EC_MeasurementDataMissing
    *          otherwise
@@ -443,9 +552,30 @@ protected:
 
 private:
 
-  /// Data for all tracks (i.e. content of Track Sequence)
+  /// Data for tracks added or read as objects (i.e. content of Track
+  /// Sequence). Tracks held in the contiguous point buffer follow these.
   OFVector<TrcTrack*> m_Tracks;
 
+  /// Points of all tracks not held as TrcTrack objects (x,y,z coordinate for
+  /// each point)
+  OFVector<Float32> m_PointData;
+
+  /// Index of first point of each track in m_PointData, plus total number of
+  /// points as last entry. Empty if there are no such tracks.
+  OFVector<size_t> m_TrackOffsets;
+
+  /// Colors of tracks in m_PointData (L,a,b components), see m_TrackColorMode
+  OFVector<Uint16> m_TrackColors;
+
+  /// Color mode of tracks in m_PointData, i.e.\ CM_TRACK (one color per
+  /// track), CM_POINTS (one color per point) or CM_TRACKSET (no color)
+  TrcTypes::E_TrackColorMode m_TrackColorMode;
+
+  /// If OFTrue, point data is not copied when writing the Track Sequence
+  /// but referenced, so that it can be streamed to file. Only used while
+  /// TrcTractographyResults::saveFile() is running.
+  OFBool m_ReferencePointData;
+
   /// Anatomy code for this Track Set
   CodeWithModifiers m_Anatomy;
 
@@ -157,7 +157,8 @@ public:
   static OFCondition loadDataset(DcmDataset& dataset,
                                  TrcTractographyResults*& tractography);
 
-  /** Save current object to given filename
+  /** Save current object to given filename. The point data of the tracks
+   *  is not copied into the dataset but streamed to file.
    *  @param  filename The file to write to
    *  @param  writeXfer The transfer syntax to be used
    *  @return EC_Normal if writing was successful, error otherwise.
@@ -297,6 +298,13 @@ private:
    */
   void clearData();
 
+  /** Enable or disable referencing point data of all Track Sets when
+   *  writing (instead of copying it), see TrcTrackSet::writeTrackData()
+   *  @param  reference If OFTrue, point data is referenced when writing.
+   *          If OFFalse, references created before are removed.
+   */
+  void setReferencePointData(const OFBool reference);
+
   /** Check whether Tractography Results object is ready for writing
    *  @return OFTrue, if object can be written, OFFalse otherwise
    */
@@ -203,16 +203,9 @@ OFCondition TrcTractographyResultsModule::check(const OFBool quiet)
           DCMTRACT_ERROR("Track Set does not contain any tracks");
           return TRC_EC_NoSuchTrack;
         }
-        else
+        else if ( (*it)->checkTracks(quiet).bad() )
         {
-          OFVector<TrcTrack*> tracks = (*it)->getTracks();
-          OFVector<TrcTrack*>::iterator t = tracks.begin();
-          while (t != tracks.end())
-          {
-            if ( (*t)->check(quiet).bad() )
-              return TRC_EC_InvalidTrackData;
-            t++;
-          }
+          return TRC_EC_InvalidTrackData;
         }
         it++;
       }
@@ -233,14 +226,13 @@ OFCondition TrcTractographyResultsModule::checkColoring()
   while (ts != m_TrackSets.end())
   {
     // Collect statistics how much are colored
-    OFVector<TrcTrack*>::const_iterator track = (*ts)->getTracks().begin();
-    OFVector<TrcTrack*>::const_iterator last = (*ts)->getTracks().end();
+    const size_t numTracks = (*ts)->getNumberOfTracks();
     size_t numPerTrack = 0;
     size_t numPerPoint = 0;
     size_t trackCount = 1;
-    while ( track != last)
+    while (trackCount <= numTracks)
     {
-      TrcTypes::E_TrackColorMode cmode = (*track)->getRecommendedDisplayCIELabMode();
+      TrcTypes::E_TrackColorMode cmode = (*ts)->getTrackColorMode(trackCount - 1);
       switch (cmode)
       {
         case TrcTypes::CM_ERROR:
@@ -259,12 +251,10 @@ OFCondition TrcTractographyResultsModule::checkColoring()
           DCMTRACT_ERROR("Internal color definition checking problem in Track Set #" << tsCount << "/" << m_TrackSets.size() << " Track #" << trackCount << "/" << (*ts)->getNumberOfTracks());
           return EC_Normal;
       }
-      track++;
       trackCount++;
     }
 
     // Do we have tracks at all? Otherwise report error
-    size_t numTracks = (*ts)->getNumberOfTracks();
     if (numTracks == 0)
     {
       DCMTRACT_ERROR("No tracks in Track Set");
@@ -21,6 +21,7 @@
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/ofstd/ofutil.h"
 #include "dcmtk/dcmdata/dcuid.h"
+#include "dcmtk/dcmdata/dcistrmb.h"
 #include "dcmtk/dcmiod/iodutil.h"
 #include "dcmtk/dcmtract/trctrackset.h"
 #include "dcmtk/dcmtract/trctrack.h"
@@ -28,10 +29,19 @@
 #include "dcmtk/dcmtract/trcstatistic.h"
 #include "dcmtk/dcmtract/trctypes.h"
 
+// Maximum number of points of a single track, since the Point Coordinates Data
+// value cannot exceed 4 GB (0xFFFFFFFF means undefined length)
+#define TRC_MAX_POINTS_PER_TRACK (0xFFFFFFFEUL / (3 * sizeof(Float32)))
+
 // default constructor (protected, instance creation via create() function)
 TrcTrackSet::TrcTrackSet()
 : IODComponent(),
   m_Tracks(),
+  m_PointData(),
+  m_TrackOffsets(),
+  m_TrackColors(),
+  m_TrackColorMode(TrcTypes::CM_TRACKSET),
+  m_ReferencePointData(OFFalse),
   m_Anatomy("3", "1"),
   m_Measurements(),
   m_TrackStatistics(),
@@ -126,7 +136,7 @@ OFCondition TrcTrackSet::read(DcmItem& source,
   readTrackStatistics(source);
   readTrackSetStatistics(source);
   OFCondition result = readTracks(source);
-  DCMTRACT_DEBUG("Found " << m_Tracks.size() << " Tracks in Track Set");
+  DCMTRACT_DEBUG("Found " << getNumberOfTracks() << " Tracks in Track Set");
   if (result.good())
   {
     readMeasurements(source);
@@ -151,20 +161,72 @@ OFCondition TrcTrackSet::write(DcmItem& destination)
   writeMeasurements(result, getData());
   writeTracks(result, getData());
   if (result.good()) result = IODComponent::write(destination);
+  // Do not keep references to point data, they become invalid when tracks
+  // are added
+  if (m_ReferencePointData)
+    getData().findAndDeleteElement(DCM_TrackSequence);
   return result;
 }
 
 
 const OFVector<TrcTrack *>& TrcTrackSet::getTracks()
 {
+  if (createTrackObjects().bad())
+  {
+    DCMTRACT_ERROR("Could not create Track objects, only returning " << m_Tracks.size() << " of " << getNumberOfTracks() << " Tracks");
+  }
   return m_Tracks;
 }
 
 
+size_t TrcTrackSet::getTrackData(const size_t trackIndex,
+                                 const Float32*& data)
+{
+  data = NULL;
+  if (trackIndex < m_Tracks.size())
+    return m_Tracks[trackIndex]->getTrackData(data);
+
+  const size_t bufferIndex = trackIndex - m_Tracks.size();
+  if (bufferIndex + 1 >= m_TrackOffsets.size())
+    return 0;
+
+  data = &m_PointData[m_TrackOffsets[bufferIndex] * 3];
+  return m_TrackOffsets[bufferIndex + 1] - m_TrackOffsets[bufferIndex];
+}
+
+
+TrcTypes::E_TrackColorMode TrcTrackSet::getTrackColorMode(const size_t trackIndex)
+{
+  if (trackIndex < m_Tracks.size())
+    return m_Tracks[trackIndex]->getRecommendedDisplayCIELabMode();
+  if (trackIndex < getNumberOfTracks())
+    return m_TrackColorMode;
+  return TrcTypes::CM_ERROR;
+}
+
+
+OFCondition TrcTrackSet::checkTracks(const OFBool quiet)
+{
+  // Tracks in point buffer have been checked when being added or read
+  OFVector<TrcTrack*>::iterator it = m_Tracks.begin();
+  while (it != m_Tracks.end())
+  {
+    if ( (*it)->check(quiet).bad() )
+      return TRC_EC_InvalidTrackData;
+    it++;
+  }
+  return EC_Normal;
+}
+
+
 void TrcTrackSet::clearData()
 {
   m_Anatomy.clearData();
   DcmIODUtil::freeContainer(m_Tracks);
+  m_PointData.clear();
+  m_TrackOffsets.clear();
+  m_TrackColors.clear();
+  m_TrackColorMode = TrcTypes::CM_TRACKSET;
   DcmIODUtil::freeContainer(m_Measurements);
   DcmIODUtil::freeContainer(m_TrackStatistics);
   DcmIODUtil::freeContainer(m_TrackSetStatistics);
@@ -339,7 +401,9 @@ const OFVector< TrcTracksStatistic* >& TrcTrackSet::getTrackStatistics()
 
 size_t TrcTrackSet::getNumberOfTracks()
 {
-  return m_Tracks.size();
+  if (m_TrackOffsets.empty())
+    return m_Tracks.size();
+  return m_Tracks.size() + m_TrackOffsets.size() - 1;
 }
 
 
@@ -410,7 +474,10 @@ OFCondition TrcTrackSet::addTrack(const Float32* pointData,
                                   const size_t numColors,
                                   TrcTrack*& result)
 {
-  OFCondition cond = TrcTrack::create(pointData, numPoints, recommendedCIELabColors, numColors, result);
+  // Keep order of tracks added in bulk before
+  OFCondition cond = createTrackObjects();
+  if (cond.good())
+    cond = TrcTrack::create(pointData, numPoints, recommendedCIELabColors, numColors, result);
   if (cond.good())
   {
     m_Tracks.push_back(result);
@@ -419,6 +486,188 @@ OFCondition TrcTrackSet::addTrack(const Float32* pointData,
 }
 
 
+OFCondition TrcTrackSet::importTracks(const Float32* pointData,
+                                      const size_t* trackOffsets,
+                                      const size_t numTracks,
+                                      const Uint16* recommendedCIELabColors,
+                                      const size_t numColors)
+{
+  if (!pointData || !trackOffsets || (numTracks == 0))
+    return EC_IllegalParameter;
+
+  // Check that every track has at least one point and can be written, i.e.
+  // reject tracks that are too large before copying any point data
+  for (size_t t = 0; t < numTracks; t++)
+  {
+    if (trackOffsets[t + 1] <= trackOffsets[t])
+    {
+      DCMTRACT_ERROR("Cannot import tracks: Track #" << t << " does not contain any points");
+      return TRC_EC_InvalidPointCoordinatesData;
+    }
+    if (trackOffsets[t + 1] - trackOffsets[t] > TRC_MAX_POINTS_PER_TRACK)
+    {
+      DCMTRACT_ERROR("Cannot import tracks: Track #" << t << " has too many points (" << trackOffsets[t + 1] - trackOffsets[t] << ")");
+      return EC_TooManyBytesRequested;
+    }
+  }
+  const size_t numPoints = trackOffsets[numTracks] - trackOffsets[0];
+
+  // Find out color mode
+  TrcTypes::E_TrackColorMode colorMode;
+  if ( (numColors == 0) && (recommendedCIELabColors == NULL) )
+    colorMode = TrcTypes::CM_TRACKSET;
+  else if ( (recommendedCIELabColors != NULL) && (numColors == numTracks) )
+    colorMode = TrcTypes::CM_TRACK;
+  else if ( (recommendedCIELabColors != NULL) && (numColors == numPoints) )
+    colorMode = TrcTypes::CM_POINTS;
+  else
+  {
+    DCMTRACT_ERROR("Cannot import tracks: Number of colors (" << numColors << ") must be 0, number of tracks or number of points");
+    return TRC_EC_InvalidColorInformation;
+  }
+
+  // The point buffer can only hold tracks using the same color mode, so
+  // tracks already in there have to be converted to objects otherwise
+  OFCondition result;
+  if (!m_TrackOffsets.empty() && (m_TrackColorMode != colorMode))
+  {
+    result = createTrackObjects();
+    if (result.bad())
+      return result;
+  }
+  if (m_TrackOffsets.empty())
+  {
+    m_TrackOffsets.push_back(0);
+    m_TrackColorMode = colorMode;
+  }
+
+  const size_t oldNumPoints = m_TrackOffsets.back();
+  m_PointData.resize(m_PointData.size() + numPoints * 3);
+  memcpy(&m_PointData[oldNumPoints * 3], pointData + trackOffsets[0] * 3, numPoints * 3 * sizeof(Float32));
+  m_TrackOffsets.reserve(m_TrackOffsets.size() + numTracks);
+  for (size_t t = 1; t <= numTracks; t++)
+  {
+    m_TrackOffsets.push_back(oldNumPoints + trackOffsets[t] - trackOffsets[0]);
+  }
+  if (colorMode != TrcTypes::CM_TRACKSET)
+  {
+    const size_t oldNumColors = m_TrackColors.size();
+    m_TrackColors.resize(oldNumColors + numColors * 3);
+    memcpy(&m_TrackColors[oldNumColors], recommendedCIELabColors, numColors * 3 * sizeof(Uint16));
+  }
+  return result;
+}
+
+
+OFCondition TrcTrackSet::exportTracks(OFVector<Float32>& pointData,
+                                      OFVector<size_t>& trackOffsets)
+{
+  const size_t numTracks = getNumberOfTracks();
+  trackOffsets.clear();
+  trackOffsets.reserve(numTracks + 1);
+  trackOffsets.push_back(0);
+  size_t numPoints = 0;
+  for (size_t t = 0; t < numTracks; t++)
+  {
+    const Float32* data = NULL;
+    numPoints += getTrackData(t, data);
+    trackOffsets.push_back(numPoints);
+  }
+
+  pointData.clear();
+  pointData.resize(numPoints * 3);
+  size_t pos = 0;
+  for (size_t t = 0; t < m_Tracks.size(); t++)
+  {
+    const Float32* data = NULL;
+    const size_t count = m_Tracks[t]->getTrackData(data);
+    if (count > 0)
+      memcpy(&pointData[pos], data, count * 3 * sizeof(Float32));
+    pos += count * 3;
+  }
+  if (!m_PointData.empty())
+    memcpy(&pointData[pos], &m_PointData[0], m_PointData.size() * sizeof(Float32));
+  return EC_Normal;
+}
+
+
+OFCondition TrcTrackSet::exportTrackColors(OFVector<Uint16>& colors,
+                                           TrcTypes::E_TrackColorMode& mode)
+{
+  colors.clear();
+  mode = TrcTypes::CM_TRACKSET;
+
+  // Collect color modes of all tracks
+  const size_t numTracks = getNumberOfTracks();
+  size_t numPerTrack = 0;
+  size_t numPerPoint = 0;
+  size_t numPoints = 0;
+  for (size_t t = 0; t < numTracks; t++)
+  {
+    const Float32* data = NULL;
+    numPoints += getTrackData(t, data);
+    switch (getTrackColorMode(t))
+    {
+      case TrcTypes::CM_TRACK: numPerTrack++; break;
+      case TrcTypes::CM_POINTS: numPerPoint++; break;
+      case TrcTypes::CM_TRACKSET: break;
+      default:
+        DCMTRACT_ERROR("Invalid color information in Track #" << t);
+        return TRC_EC_InvalidColorInformation;
+    }
+  }
+  if (numPerTrack + numPerPoint == 0)
+    return EC_Normal;
+  if (numPerTrack + numPerPoint != numTracks)
+  {
+    DCMTRACT_ERROR("Some but not all tracks provide color information");
+    return TRC_EC_InvalidColorInformation;
+  }
+
+  mode = (numPerPoint == 0) ? TrcTypes::CM_TRACK : TrcTypes::CM_POINTS;
+  colors.reserve((mode == TrcTypes::CM_TRACK) ? numTracks * 3 : numPoints * 3);
+  for (size_t t = 0; t < numTracks; t++)
+  {
+    const Float32* data = NULL;
+    const size_t count = getTrackData(t, data);
+    const Uint16* trackColors = NULL;
+    Uint16 lab[3];
+    size_t numTrackColors = 0;
+    if (t < m_Tracks.size())
+    {
+      if (m_Tracks[t]->getRecommendedDisplayCIELabMode() == TrcTypes::CM_TRACK)
+      {
+        m_Tracks[t]->getRecommendedDisplayCIELabValue(lab[0], lab[1], lab[2]);
+        trackColors = lab;
+        numTrackColors = 1;
+      }
+      else
+      {
+        numTrackColors = m_Tracks[t]->getRecommendedDisplayCIELabValueList(trackColors);
+      }
+    }
+    else if (m_TrackColorMode == TrcTypes::CM_TRACK)
+    {
+      trackColors = &m_TrackColors[(t - m_Tracks.size()) * 3];
+      numTrackColors = 1;
+    }
+    else
+    {
+      trackColors = &m_TrackColors[m_TrackOffsets[t - m_Tracks.size()] * 3];
+      numTrackColors = count;
+    }
+    // Repeat track color for every point if required
+    const size_t numRepeats = ( (mode == TrcTypes::CM_POINTS) && (numTrackColors == 1) ) ? count : 1;
+    for (size_t r = 0; r < numRepeats; r++)
+    {
+      for (size_t c = 0; c < numTrackColors * 3; c++)
+        colors.push_back(trackColors[c]);
+    }
+  }
+  return EC_Normal;
+}
+
+
 OFCondition TrcTrackSet::addMeasurement(const CodeSequenceMacro& measurementCode,
                                         const CodeSequenceMacro& measurementUnitCodes,
                                         TrcMeasurement*& measurement)
@@ -443,9 +692,9 @@ OFCondition TrcTrackSet::addTrackStatistics(const CodeSequenceMacro& typeCode,
   if (!statistic)
     return EC_MemoryExhausted;
 
-  if (numValues != m_Tracks.size())
+  if (numValues != getNumberOfTracks())
   {
-    DCMTRACT_ERROR("There must be as many track statistic values as number of tracks (" << m_Tracks.size() << ")");
+    DCMTRACT_ERROR("There must be as many track statistic values as number of tracks (" << getNumberOfTracks() << ")");
     return TRC_EC_InvalidStatisticData;
   }
   OFCondition result = statistic->set(typeCode, typeModifierCode, unitsCode, values, numValues);
@@ -546,10 +795,253 @@ OFCondition TrcTrackSet::setRecommendedLineThickness(const Float32& value,
 
 OFCondition TrcTrackSet::readTracks(DcmItem& source)
 {
+  // Read point data of all tracks into a single buffer if possible
+  DcmSequenceOfItems* seq = NULL;
+  if (source.findAndGetSequence(DCM_TrackSequence, seq).good() && seq && readTrackData(*seq))
+    return EC_Normal;
   return DcmIODUtil::readSubSequence(source, DCM_TrackSequence, m_Tracks, getRules()->getByTag(DCM_TrackSequence));
 }
 
 
+OFBool TrcTrackSet::readTrackData(DcmSequenceOfItems& sequence)
+{
+  const unsigned long numTracks = sequence.card();
+  if (numTracks == 0)
+    return OFFalse;
+
+  // First pass: Determine size of point data and color mode of all tracks
+  // without loading any values
+  OFVector<size_t> offsets;
+  offsets.reserve(numTracks + 1);
+  offsets.push_back(0);
+  TrcTypes::E_TrackColorMode colorMode = TrcTypes::CM_UNKNOWN;
+  DcmObject* obj = sequence.nextInContainer(NULL);
+  while (obj)
+  {
+    DcmItem* item = OFstatic_cast(DcmItem*, obj);
+    DcmElement* points = NULL;
+    if (item->findAndGetElement(DCM_PointCoordinatesData, points).bad())
+      return OFFalse;
+    // Cut off incomplete points at the end (like TrcTrack does)
+    const size_t numPoints = points->getLength() / sizeof(Float32) / 3;
+    if (numPoints == 0)
+      return OFFalse;
+    DcmElement* color = NULL;
+    TrcTypes::E_TrackColorMode trackColorMode = TrcTypes::CM_TRACKSET;
+    if (item->findAndGetElement(DCM_RecommendedDisplayCIELabValue, color).good())
+    {
+      trackColorMode = (color->getLength() == 3 * sizeof(Uint16)) ? TrcTypes::CM_TRACK : TrcTypes::CM_ERROR;
+    }
+    else if (item->findAndGetElement(DCM_RecommendedDisplayCIELabValueList, color).good())
+    {
+      trackColorMode = (color->getLength() / sizeof(Uint16) / 3 == numPoints) ? TrcTypes::CM_POINTS : TrcTypes::CM_ERROR;
+    }
+    if ( (trackColorMode == TrcTypes::CM_ERROR) || ( (colorMode != TrcTypes::CM_UNKNOWN) && (colorMode != trackColorMode) ) )
+      return OFFalse;
+    colorMode = trackColorMode;
+    offsets.push_back(offsets.back() + numPoints);
+    obj = sequence.nextInContainer(obj);
+  }
+
+  // Second pass: Copy values, and release values that have been loaded from
+  // file only for copying them
+  const size_t numPoints = offsets.back();
+  m_PointData.resize(numPoints * 3);
+  if (colorMode == TrcTypes::CM_TRACK)
+    m_TrackColors.resize(numTracks * 3);
+  else if (colorMode == TrcTypes::CM_POINTS)
+    m_TrackColors.resize(numPoints * 3);
+  size_t track = 0;
+  OFBool ok = OFTrue;
+  obj = sequence.nextInContainer(NULL);
+  while (obj && ok)
+  {
+    DcmItem* item = OFstatic_cast(DcmItem*, obj);
+    const size_t numPoints = offsets[track + 1] - offsets[track];
+    DcmElement* elem = NULL;
+    Float32* points = NULL;
+    ok = item->findAndGetElement(DCM_PointCoordinatesData, elem).good() && elem->getFloat32Array(points).good() && points;
+    if (ok)
+    {
+      if (elem->getLength() != numPoints * 3 * sizeof(Float32))
+        DCMTRACT_WARN("Wrong number of values in track (" << elem->getLength() / sizeof(Float32) << "), cutting off " << elem->getLength() / sizeof(Float32) % 3 << " coordinates at the end");
+      memcpy(&m_PointData[offsets[track] * 3], points, numPoints * 3 * sizeof(Float32));
+      elem->compact();
+    }
+    if (ok && (colorMode != TrcTypes::CM_TRACKSET))
+    {
+      Uint16* colors = NULL;
+      if (colorMode == TrcTypes::CM_TRACK)
+      {
+        ok = item->findAndGetElement(DCM_RecommendedDisplayCIELabValue, elem).good() && elem->getUint16Array(colors).good() && colors;
+        if (ok)
+          memcpy(&m_TrackColors[track * 3], colors, 3 * sizeof(Uint16));
+      }
+      else
+      {
+        ok = item->findAndGetElement(DCM_RecommendedDisplayCIELabValueList, elem).good() && elem->getUint16Array(colors).good() && colors;
+        if (ok)
+          memcpy(&m_TrackColors[offsets[track] * 3], colors, numPoints * 3 * sizeof(Uint16));
+      }
+      if (ok)
+        elem->compact();
+    }
+    track++;
+    obj = sequence.nextInContainer(obj);
+  }
+
+  if (!ok)
+  {
+    m_PointData.clear();
+    m_TrackColors.clear();
+    return OFFalse;
+  }
+  m_TrackOffsets = offsets;
+  m_TrackColorMode = colorMode;
+  return OFTrue;
+}
+
+
+OFCondition TrcTrackSet::writeTrackData(DcmItem& destination)
+{
+  destination.findAndDeleteElement(DCM_TrackSequence);
+  DcmSequenceOfItems* seq = new DcmSequenceOfItems(DCM_TrackSequence);
+  OFCondition result = destination.insert(seq);
+  if (result.bad())
+  {
+    delete seq;
+    return result;
+  }
+
+  // Tracks held as objects come first
+  OFVector<TrcTrack*>::iterator it = m_Tracks.begin();
+  while ( result.good() && (it != m_Tracks.end()) )
+  {
+    DcmItem* item = new DcmItem();
+    result = (*it)->write(*item);
+    if (result.good())
+      result = seq->append(item);
+    if (result.bad())
+      delete item;
+    it++;
+  }
+
+  // Afterwards, those held in the point buffer. Items are appended directly
+  // since finding the last item of a sequence takes linear time.
+  const size_t numTracks = (m_TrackOffsets.empty()) ? 0 : m_TrackOffsets.size() - 1;
+  for (size_t t = 0; result.good() && (t < numTracks); t++)
+  {
+    const size_t numPoints = m_TrackOffsets[t + 1] - m_TrackOffsets[t];
+    if (numPoints > TRC_MAX_POINTS_PER_TRACK)
+    {
+      DCMTRACT_ERROR("Track #" << t + 1 << " has too many points (" << numPoints << ")");
+      result = EC_TooManyBytesRequested;
+      break;
+    }
+    DcmItem* item = new DcmItem();
+    DcmElement* elem = DcmItem::newDicomElement(DCM_PointCoordinatesData);
+    if (!elem)
+    {
+      delete item;
+      result = EC_MemoryExhausted;
+      break;
+    }
+    // A track without points results in an empty value
+    if (numPoints > 0)
+    {
+      const Float32* points = &m_PointData[m_TrackOffsets[t] * 3];
+      if (m_ReferencePointData)
+      {
+        // Reference point data so that it is written block by block directly
+        // from the buffer (see TrcTractographyResults::saveFile())
+        const Uint32 numBytes = OFstatic_cast(Uint32, numPoints * 3 * sizeof(Float32));
+        result = elem->createValueFromTempFile(new DcmInputBufferStreamFactory(points, numBytes), numBytes, gLocalByteOrder);
+      }
+      else
+      {
+        result = elem->putFloat32Array(points, OFstatic_cast(unsigned long, numPoints * 3));
+      }
+    }
+    if (result.good())
+      result = item->insert(elem);
+    else
+      delete elem;
+    if (result.good())
+    {
+      if (m_TrackColorMode == TrcTypes::CM_TRACK)
+        result = item->putAndInsertUint16Array(DCM_RecommendedDisplayCIELabValue, &m_TrackColors[t * 3], 3);
+      else if ((m_TrackColorMode == TrcTypes::CM_POINTS) && (numPoints > 0))
+        result = item->putAndInsertUint16Array(DCM_RecommendedDisplayCIELabValueList, &m_TrackColors[m_TrackOffsets[t] * 3], OFstatic_cast(unsigned long, numPoints * 3));
+      else if (m_TrackColorMode == TrcTypes::CM_POINTS)
+        result = item->insertEmptyElement(DCM_RecommendedDisplayCIELabValueList);
+    }
+    if (result.good())
+      result = seq->append(item);
+    if (result.bad())
+      delete item;
+  }
+
+  if (result.bad())
+  {
+    DCMTRACT_ERROR("Could not write Track Sequence: " << result.text());
+    destination.findAndDeleteElement(DCM_TrackSequence);
+    return result;
+  }
+  IODRule* rule = getRules()->getByTag(DCM_TrackSequence);
+  DcmIODUtil::checkSubSequence(result, destination, DCM_TrackSequence, rule->getVM(), rule->getType(), rule->getModule(), dcmtk::log4cplus::ERROR_LOG_LEVEL);
+  if (result.bad())
+    destination.findAndDeleteElement(DCM_TrackSequence);
+  return result;
+}
+
+
+OFCondition TrcTrackSet::createTrackObjects()
+{
+  OFCondition result;
+  const size_t numTracks = (m_TrackOffsets.empty()) ? 0 : m_TrackOffsets.size() - 1;
+  if (numTracks == 0)
+    return result;
+
+  const size_t numObjects = m_Tracks.size();
+  m_Tracks.reserve(numObjects + numTracks);
+  for (size_t t = 0; result.good() && (t < numTracks); t++)
+  {
+    const size_t numPoints = m_TrackOffsets[t + 1] - m_TrackOffsets[t];
+    const Uint16* colors = NULL;
+    size_t numColors = 0;
+    if (m_TrackColorMode == TrcTypes::CM_TRACK)
+    {
+      colors = &m_TrackColors[t * 3];
+      numColors = 1;
+    }
+    else if (m_TrackColorMode == TrcTypes::CM_POINTS)
+    {
+      colors = &m_TrackColors[m_TrackOffsets[t] * 3];
+      numColors = numPoints;
+    }
+    TrcTrack* track = NULL;
+    result = TrcTrack::create(&m_PointData[m_TrackOffsets[t] * 3], numPoints, colors, numColors, track);
+    if (result.good())
+      m_Tracks.push_back(track);
+  }
+  if (result.bad())
+  {
+    // Remove objects created so far so that the order of tracks stays intact
+    while (m_Tracks.size() > numObjects)
+    {
+      delete m_Tracks.back();
+      m_Tracks.pop_back();
+    }
+    return result;
+  }
+  m_PointData.clear();
+  m_TrackOffsets.clear();
+  m_TrackColors.clear();
+  m_TrackColorMode = TrcTypes::CM_TRACKSET;
+  return result;
+}
+
+
 OFCondition TrcTrackSet::readMeasurements(DcmItem& source)
 {
   DcmIODUtil::readSubSequence(source, DCM_MeasurementsSequence, m_Measurements, getRules()->getByTag(DCM_MeasurementsSequence));
@@ -597,7 +1089,7 @@ OFCondition TrcTrackSet::setLaterality(const TrcTypes::E_TrackSetLaterality valu
 
 OFCondition TrcTrackSet::checkMeasurements()
 {
-  size_t numTracks = m_Tracks.size();
+  size_t numTracks = getNumberOfTracks();
   for (size_t i = 0; i < m_Measurements.size(); i++)
   {
     TrcMeasurement *m = m_Measurements[i];
@@ -638,7 +1130,10 @@ OFCondition TrcTrackSet::writeTracks(OFCondition& result,
 {
   if (result.good())
   {
-    DcmIODUtil::writeSubSequence(result, DCM_TrackSequence, m_Tracks, destination, getRules()->getByTag(DCM_TrackSequence));
+    if (m_TrackOffsets.empty())
+      DcmIODUtil::writeSubSequence(result, DCM_TrackSequence, m_Tracks, destination, getRules()->getByTag(DCM_TrackSequence));
+    else
+      result = writeTrackData(destination);
   }
   return result;
 }
@@ -267,12 +267,16 @@ OFCondition TrcTractographyResults::saveFile(
     DCMTRACT_ERROR("Cannot write transfer syntax: " << ts.getXferName() << " (can only write uncompressed)");
     return EC_CannotChangeRepresentation;
   }
+  // Point data of the tracks is referenced instead of being copied into the
+  // dataset, so that it is streamed to file
+  setReferencePointData(OFTrue);
   DcmFileFormat dcmff;
   OFCondition result = write( *(dcmff.getDataset()) );
   if (result.good())
   {
     result = dcmff.saveFile(filename.c_str(), writeXfer);
   }
+  setReferencePointData(OFFalse);
   if (result.bad())
   {
     DCMTRACT_ERROR("Cannot save tractography results object to file " << filename << ": " << result.text());
@@ -328,6 +332,21 @@ IODReferences& TrcTractographyResults::getReferencedInstances()
 
 // -- private helpers --
 
+void TrcTractographyResults::setReferencePointData(const OFBool reference)
+{
+  OFVector<TrcTrackSet*>::iterator it = getTrackSets().begin();
+  while (it != getTrackSets().end())
+  {
+    (*it)->m_ReferencePointData = reference;
+    it++;
+  }
+  // Do not keep references to point data, they become invalid when tracks
+  // are added
+  if (!reference)
+    m_TractographyResultsModule.getData().findAndDeleteElement(DCM_TrackSetSequence);
+}
+
+
 void TrcTractographyResults::clearData()
 {
   DcmIODCommon::clearData();
@@ -0,0 +1,251 @@
+/*
+ *
+ *  Copyright (C) 2026, DCMTK contributors
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation are maintained by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmtract
+ *
+ *  Author:  DCMTK contributors
+ *
+ *  Purpose: test program for tracks held in a contiguous buffer of TrcTrackSet
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcuid.h"
+#include "dcmtk/dcmtract/trctractographyresults.h"
+#include "dcmtk/dcmtract/trctrackset.h"
+#include "dcmtk/dcmtract/trctrack.h"
+
+#define NUM_TRACKS 3
+#define NUM_POINTS 10
+
+
+// create a Tractography Results object with all mandatory information
+static TrcTractographyResults *createResults()
+{
+    ContentIdentificationMacro id("1", "TRACKS", "Test of contiguous tracks", "DCMTK");
+    IODEnhGeneralEquipmentModule::EquipmentInfo equipment("DCMTK", "dcmtract tests", "1", OFFIS_DCMTK_VERSION_STRING);
+    IODReferences refs;
+    refs.add(new IODImageReference("PAT_ID", "1.2.3", "1.2.3.4", "1.2.3.4.5", UID_MRImageStorage));
+    TrcTractographyResults *trc = NULL;
+    OFCHECK(TrcTractographyResults::create(id, "20260101", "120000", equipment, refs, trc).good());
+    if (trc != NULL)
+    {
+        OFCHECK(trc->getFrameOfReference().setFrameOfReferenceUID("1.2.3.6").good());
+        OFCHECK(trc->getPatient().setPatientID("PAT_ID").good());
+    }
+    return trc;
+}
+
+
+// add a track set to the given Tractography Results object
+static TrcTrackSet *addTrackSet(TrcTractographyResults &trc, const char *label)
+{
+    CodeWithModifiers anatomy("3");
+    OFCHECK(anatomy.set("T-A0095", "SRT", "White matter of brain and spinal cord").good());
+    CodeSequenceMacro diffusionModel("113231", "DCM", "Single Tensor");
+    AlgorithmIdentificationMacro algorithmId;
+    OFCHECK(algorithmId.getAlgorithmFamilyCode().set("113211", "DCM", "Deterministic").good());
+    OFCHECK(algorithmId.setAlgorithmName("TEST").good());
+    OFCHECK(algorithmId.setAlgorithmVersion("1.0").good());
+    TrcTrackSet *set = NULL;
+    OFCHECK(trc.addTrackSet(label, "Test", anatomy, diffusionModel, algorithmId, set).good());
+    return set;
+}
+
+
+// check that the track set contains the given tracks and colors
+static void checkTracks(TrcTrackSet &set,
+                        const Float32 *points,
+                        const size_t *offsets,
+                        const Uint16 *colors,
+                        const size_t numColors,
+                        const TrcTypes::E_TrackColorMode colorMode)
+{
+    OFCHECK_EQUAL(set.getNumberOfTracks(), NUM_TRACKS);
+    OFVector<Float32> exportedPoints;
+    OFVector<size_t> exportedOffsets;
+    OFCHECK(set.exportTracks(exportedPoints, exportedOffsets).good());
+    OFCHECK_EQUAL(exportedOffsets.size(), NUM_TRACKS + 1);
+    OFCHECK_EQUAL(exportedPoints.size(), NUM_POINTS * 3);
+    if ((exportedOffsets.size() == NUM_TRACKS + 1) && (exportedPoints.size() == NUM_POINTS * 3))
+    {
+        for (size_t t = 0; t <= NUM_TRACKS; t++)
+            OFCHECK_EQUAL(exportedOffsets[t], offsets[t]);
+        for (size_t i = 0; i < NUM_POINTS * 3; i++)
+            OFCHECK_EQUAL(exportedPoints[i], points[i]);
+    }
+    for (size_t t = 0; t < NUM_TRACKS; t++)
+    {
+        const Float32 *data = NULL;
+        OFCHECK_EQUAL(set.getTrackData(t, data), offsets[t + 1] - offsets[t]);
+        OFCHECK(data != NULL);
+        if (data != NULL)
+            OFCHECK_EQUAL(data[0], points[offsets[t] * 3]);
+    }
+    OFVector<Uint16> exportedColors;
+    TrcTypes::E_TrackColorMode mode = TrcTypes::CM_UNKNOWN;
+    OFCHECK(set.exportTrackColors(exportedColors, mode).good());
+    OFCHECK_EQUAL(mode, colorMode);
+    OFCHECK_EQUAL(exportedColors.size(), numColors * 3);
+    for (size_t i = 0; (i < numColors * 3) && (i < exportedColors.size()); i++)
+        OFCHECK_EQUAL(exportedColors[i], colors[i]);
+}
+
+
+OFTEST(dcmtract_trackSet_contiguousTracks)
+{
+    Float32 points[NUM_POINTS * 3];
+    for (size_t i = 0; i < NUM_POINTS * 3; i++)
+        points[i] = OFstatic_cast(Float32, i) * 0.5f;
+    const size_t offsets[NUM_TRACKS + 1] = { 0, 2, 7, NUM_POINTS };
+    Uint16 trackColors[NUM_TRACKS * 3];
+    for (size_t i = 0; i < NUM_TRACKS * 3; i++)
+        trackColors[i] = OFstatic_cast(Uint16, 1000 * i);
+    Uint16 pointColors[NUM_POINTS * 3];
+    for (size_t i = 0; i < NUM_POINTS * 3; i++)
+        pointColors[i] = OFstatic_cast(Uint16, 100 * i);
+
+    // one track set with a color per track and one with a color per point
+    TrcTractographyResults *trc = createResults();
+    OFCHECK(trc != NULL);
+    if (trc == NULL)
+        return;
+    TrcTrackSet *perTrack = addTrackSet(*trc, "PER_TRACK");
+    TrcTrackSet *perPoint = addTrackSet(*trc, "PER_POINT");
+    OFCHECK((perTrack != NULL) && (perPoint != NULL));
+    if ((perTrack != NULL) && (perPoint != NULL))
+    {
+        OFCHECK(perTrack->importTracks(points, offsets, NUM_TRACKS, trackColors, NUM_TRACKS).good());
+        OFCHECK(perPoint->importTracks(points, offsets, NUM_TRACKS, pointColors, NUM_POINTS).good());
+        checkTracks(*perTrack, points, offsets, trackColors, NUM_TRACKS, TrcTypes::CM_TRACK);
+        checkTracks(*perPoint, points, offsets, pointColors, NUM_POINTS, TrcTypes::CM_POINTS);
+    }
+
+    // the point data is streamed to file and still available afterwards
+    OFTempFile tempFile(O_RDWR, "", "ttrackset", ".dcm");
+    OFCHECK(tempFile.getStatus().good());
+    OFCHECK(trc->saveFile(tempFile.getFilename()).good());
+    if ((perTrack != NULL) && (perPoint != NULL))
+    {
+        checkTracks(*perTrack, points, offsets, trackColors, NUM_TRACKS, TrcTypes::CM_TRACK);
+        checkTracks(*perPoint, points, offsets, pointColors, NUM_POINTS, TrcTypes::CM_POINTS);
+    }
+    delete trc;
+
+    // read the file into the contiguous buffer again
+    trc = NULL;
+    OFCHECK(TrcTractographyResults::loadFile(tempFile.getFilename(), trc).good());
+    OFCHECK(trc != NULL);
+    if (trc != NULL)
+    {
+        OFCHECK_EQUAL(trc->getNumberOfTrackSets(), 2);
+        if (trc->getNumberOfTrackSets() == 2)
+        {
+            checkTracks(*trc->getTrackSets()[0], points, offsets, trackColors, NUM_TRACKS, TrcTypes::CM_TRACK);
+            checkTracks(*trc->getTrackSets()[1], points, offsets, pointColors, NUM_POINTS, TrcTypes::CM_POINTS);
+        }
+        delete trc;
+    }
+}
+
+
+OFTEST(dcmtract_trackSet_emptyTrack)
+{
+    Float32 points[NUM_POINTS * 3];
+    for (size_t i = 0; i < NUM_POINTS * 3; i++)
+        points[i] = OFstatic_cast(Float32, i);
+    const size_t offsets[NUM_TRACKS + 1] = { 0, 5, 5, NUM_POINTS };
+    const Uint16 colors[NUM_TRACKS * 3] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    // tracks without points cannot be imported
+    TrcTractographyResults *trc = createResults();
+    OFCHECK(trc != NULL);
+    if (trc == NULL)
+        return;
+    TrcTrackSet *set = addTrackSet(*trc, "EMPTY");
+    OFCHECK(set != NULL);
+    if (set != NULL)
+    {
+        OFCHECK(set->importTracks(points, offsets, NUM_TRACKS, colors, NUM_TRACKS) == TRC_EC_InvalidPointCoordinatesData);
+        OFCHECK_EQUAL(set->getNumberOfTracks(), 0);
+        const size_t validOffsets[NUM_TRACKS + 1] = { 0, 5, 6, NUM_POINTS };
+        OFCHECK(set->importTracks(points, validOffsets, NUM_TRACKS, colors, NUM_TRACKS).good());
+    }
+
+    // a dataset with an empty track can be read, the tracks are read as
+    // TrcTrack objects instead of into the contiguous buffer
+    DcmDataset dataset;
+    OFCHECK(trc->writeDataset(dataset).good());
+    delete trc;
+    DcmItem *track = NULL;
+    OFCHECK(dataset.findAndGetSequenceItem(DCM_TrackSetSequence, track, 0).good());
+    if (track != NULL)
+        OFCHECK(track->findAndGetSequenceItem(DCM_TrackSequence, track, 1).good());
+    if (track != NULL)
+        OFCHECK(track->putAndInsertFloat32Array(DCM_PointCoordinatesData, NULL, 0).good());
+    trc = NULL;
+    OFCHECK(TrcTractographyResults::loadDataset(dataset, trc).good());
+    OFCHECK(trc != NULL);
+    if (trc != NULL)
+    {
+        OFCHECK_EQUAL(trc->getNumberOfTrackSets(), 1);
+        if (trc->getNumberOfTrackSets() == 1)
+        {
+            set = trc->getTrackSets()[0];
+            const Float32 *data = NULL;
+            OFCHECK_EQUAL(set->getNumberOfTracks(), NUM_TRACKS);
+            OFCHECK_EQUAL(set->getTrackData(0, data), 5);
+            OFCHECK_EQUAL(set->getTrackData(1, data), 0);
+            OFCHECK_EQUAL(set->getTrackData(2, data), NUM_POINTS - 6);
+        }
+        // Point Coordinates Data is type 1, so the empty track is not written
+        DcmDataset result;
+        OFCHECK(trc->writeDataset(result).bad());
+        delete trc;
+    }
+}
+
+
+OFTEST(dcmtract_trackSet_tooLarge)
+{
+    // more than 4 GB of point data for a single track is rejected before
+    // any point data is accessed, so a small buffer is sufficient here
+    Float32 points[3] = { 0, 0, 0 };
+    const size_t maxPoints = 0xFFFFFFFEUL / (3 * sizeof(Float32));
+    TrcTractographyResults *trc = createResults();
+    OFCHECK(trc != NULL);
+    if (trc == NULL)
+        return;
+    TrcTrackSet *set = addTrackSet(*trc, "LARGE");
+    OFCHECK(set != NULL);
+    if (set != NULL)
+    {
+        const size_t offsets[2] = { 0, maxPoints + 1 };
+        OFCHECK(set->importTracks(points, offsets, 1, NULL, 0) == EC_TooManyBytesRequested);
+        OFCHECK_EQUAL(set->getNumberOfTracks(), 0);
+        // the same for the last of several tracks, none of them is imported
+        const size_t moreOffsets[3] = { 0, 1, maxPoints + 2 };
+        OFCHECK(set->importTracks(points, moreOffsets, 2, NULL, 0) == EC_TooManyBytesRequested);
+        OFCHECK_EQUAL(set->getNumberOfTracks(), 0);
+        // a small track can still be imported
+        const size_t smallOffsets[2] = { 0, 1 };
+        OFCHECK(set->importTracks(points, smallOffsets, 1, NULL, 0).good());
+        OFCHECK_EQUAL(set->getNumberOfTracks(), 1);
+    }
+    delete trc;
+}
@@ -41,6 +41,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CITRUS_ICONV_STD_SSE2
+#endif
+
 #include "citrus_bcs.h"
 #include "citrus_types.h"
 #include "citrus_module.h"
@@ -347,6 +352,162 @@ do_conv(const struct _citrus_iconv_std_shared *is,
 }
 /* ---------------------------------------------------------------------- */
 
+/*
+ * bulk conversion support.
+ *
+ * For the stateless "NONE" (single-byte) and "UTF8" encodings, most input
+ * (DICOM person names, descriptions etc.) consists of 7-bit ASCII or of
+ * single-byte characters that map onto a fixed output sequence. The
+ * conversion of these bytes is computed once per shared handle by running
+ * the regular state machine on every possible input byte, and the result is
+ * kept in a 256 entry table. Runs of such bytes are then copied or widened
+ * in blocks, and only the remaining characters go through the per-character
+ * function pointer dispatch.
+ */
+static int
+is_fast_encoding(const char *encname)
+{
+
+    return (encname != NULL &&
+        (strcmp(encname, "NONE") == 0 || strcmp(encname, "UTF8") == 0));
+}
+
+static int
+is_initial_state(struct _citrus_iconv_std_encoding *se)
+{
+    int state;
+
+    if (se->se_ps == NULL)
+        return (1);
+    if (get_state_desc_gen(se, &state))
+        return (0);
+    return (state == _CITRUS_STDENC_SDGEN_INITIAL);
+}
+
+static void
+init_fast_table(struct _citrus_iconv_std_shared *is)
+{
+    struct _citrus_iconv_std_encoding src, dst;
+    _citrus_csid_t csid;
+    _citrus_index_t idx;
+    char *ps;
+    char inbuf[1], outbuf[4];
+    char *tmpin;
+    size_t szpssrc, szpsdst, szrin, szrout;
+    unsigned int c, last;
+
+    szpssrc = _citrus_stdenc_get_state_size(is->is_src_encoding);
+    szpsdst = _citrus_stdenc_get_state_size(is->is_dst_encoding);
+    ps = malloc(szpssrc + szpsdst + 1);
+    if (ps == NULL)
+        return;
+
+    /* multi-byte source encodings only qualify for 7-bit input */
+    last = (_citrus_stdenc_get_mb_cur_max(is->is_src_encoding) == 1) ?
+        0xFF : 0x7F;
+    for (c = 0; c <= last; c++) {
+        if (init_encoding(&src, is->is_src_encoding,
+            szpssrc ? ps : NULL, NULL) > 0 ||
+            init_encoding(&dst, is->is_dst_encoding,
+            szpsdst ? ps + szpssrc : NULL, NULL) > 0)
+            break;
+        inbuf[0] = (char)c;
+        tmpin = inbuf;
+        szrin = szrout = 0;
+        if (mbtocsx(&src, &csid, &idx, &tmpin, 1, &szrin, NULL) ||
+            szrin == (size_t)-2 || tmpin != inbuf + 1 ||
+            !is_initial_state(&src))
+            continue;
+        if (do_conv(is, &csid, &idx))
+            continue;
+        if (cstombx(&dst, outbuf, sizeof(outbuf), csid, idx, &szrout,
+            NULL) || szrout == 0 || szrout > sizeof(outbuf) ||
+            !is_initial_state(&dst))
+            continue;
+        memcpy(is->is_fast_out[c], outbuf, szrout);
+        is->is_fast_len[c] = (unsigned char)szrout;
+        is->is_fast = 1;
+    }
+    free(ps);
+
+    /* check whether 7-bit ASCII is converted to itself */
+    is->is_fast_ascii = is->is_fast;
+    for (c = 0; c < 0x80 && is->is_fast_ascii; c++)
+        if (is->is_fast_len[c] != 1 || is->is_fast_out[c][0] != (char)c)
+            is->is_fast_ascii = 0;
+}
+
+/* return the length of the leading run of 7-bit ASCII bytes in s */
+static size_t
+ascii_span(const unsigned char *s, size_t n)
+{
+    size_t i = 0;
+    uint32_t w;
+
+#ifdef CITRUS_ICONV_STD_SSE2
+    for (; i + 16 <= n; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i))))
+            break;
+    }
+#endif
+    for (; i + 4 <= n; i += 4) {
+        memcpy(&w, s + i, sizeof(w));
+        if (w & 0x80808080U)
+            break;
+    }
+    while (i < n && s[i] < 0x80)
+        i++;
+
+    return (i);
+}
+
+/*
+ * convert the leading run of input bytes that are covered by the bulk
+ * conversion table, as far as the output buffer permits.
+ * returns the number of input bytes consumed.
+ */
+static size_t
+fast_conv(const struct _citrus_iconv_std_shared *is,
+    char **in, size_t *inbytes, char **out, size_t *outbytes)
+{
+    const unsigned char *s = (const unsigned char *)*in;
+    const unsigned char *send = s + *inbytes;
+    char *d = *out;
+    size_t avail = *outbytes;
+    size_t n, len;
+
+    while (s < send) {
+        if (is->is_fast_ascii && *s < 0x80) {
+            n = (size_t)(send - s);
+            n = ascii_span(s, n < avail ? n : avail);
+            if (n == 0)
+                break;
+            memcpy(d, s, n);
+            s += n;
+            d += n;
+            avail -= n;
+            continue;
+        }
+        len = is->is_fast_len[*s];
+        if (len == 0 || len > avail)
+            break;
+        memcpy(d, is->is_fast_out[*s], len);
+        s++;
+        d += len;
+        avail -= len;
+    }
+
+    n = (size_t)((const char *)s - *in);
+    *in += n;
+    *inbytes -= n;
+    *out = d;
+    *outbytes = avail;
+
+    return (n);
+}
+
+/* ---------------------------------------------------------------------- */
+
 static int
 /*ARGSUSED*/
 _citrus_iconv_std_iconv_init_shared(struct _citrus_iconv_shared *ci,
@@ -383,6 +544,13 @@ _citrus_iconv_std_iconv_init_shared(struct _citrus_iconv_shared *ci,
     if (ret)
         goto err5;
 
+    memset(is->is_fast_len, 0, sizeof(is->is_fast_len));
+    is->is_fast = 0;
+    is->is_fast_ascii = 0;
+    if (is_fast_encoding(esdbsrc.db_encname) &&
+        is_fast_encoding(esdbdst.db_encname))
+        init_fast_table(is);
+
     _citrus_esdb_close(&esdbsrc);
     _citrus_esdb_close(&esdbdst);
     ci->ci_closure = is;
@@ -472,7 +640,7 @@ _citrus_iconv_std_iconv_convert(struct _citrus_iconv * cv,
     _citrus_index_t idx;
     char *tmpin;
     size_t inval, in_mb_cur_min, szrin, szrout;
-    int ret, state = 0;
+    int fast, ret, state = 0;
 
     inval = 0;
     if (in == NULL || *in == NULL) {
@@ -504,6 +672,8 @@ _citrus_iconv_std_iconv_convert(struct _citrus_iconv * cv,
     }
 
     in_mb_cur_min = _citrus_stdenc_get_mb_cur_min(is->is_src_encoding);
+    fast = is->is_fast && (cv->cv_shared->ci_hooks == NULL ||
+        cv->cv_shared->ci_hooks->uc_hook == NULL);
 
     /* normal case */
     for (;;) {
@@ -514,6 +684,14 @@ _citrus_iconv_std_iconv_convert(struct _citrus_iconv * cv,
                 break;
         }
 
+        /* convert runs of table-driven characters in bulk */
+        if (fast && *inbytes > 0 &&
+            is->is_fast_len[(unsigned char)**in] != 0 &&
+            is_initial_state(&sc->sc_src_encoding) &&
+            is_initial_state(&sc->sc_dst_encoding) &&
+            fast_conv(is, in, inbytes, out, outbytes) > 0)
+            continue;
+
         /* save the encoding states for the error recovery */
         save_encoding_state(&sc->sc_src_encoding);
         save_encoding_state(&sc->sc_dst_encoding);
@@ -77,6 +77,16 @@ struct _citrus_iconv_std_shared {
     struct _citrus_iconv_std_src_list    is_srcs;
     _citrus_wc_t                 is_invalid;
     int                  is_use_invalid;
+    /*
+     * bulk conversion table for stateless single-byte and UTF-8
+     * conversions: is_fast_len[c] is the length of the output sequence
+     * for the input byte c (stored in is_fast_out[c]), or 0 if c must be
+     * converted by the generic state machine.
+     */
+    int                  is_fast;
+    int                  is_fast_ascii;
+    unsigned char            is_fast_len[256];
+    char                 is_fast_out[256][4];
 };
 
 /*
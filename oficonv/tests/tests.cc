@@ -108,5 +108,6 @@ OFTEST_REGISTER(oficonv_open_into);
 OFTEST_REGISTER(oficonv__iconv);
 OFTEST_REGISTER(oflocale_charset);
 OFTEST_REGISTER(oficonvctl);
+OFTEST_REGISTER(oficonv_bulk_conversion);
 
 OFTEST_MAIN("oficonv")
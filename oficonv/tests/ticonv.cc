@@ -648,3 +648,79 @@ OFTEST(oficonvctl)
     OFiconv_close(id3);
   }
 }
+
+
+// This test exercises the bulk conversion of long ASCII runs mixed with
+// non-ASCII characters, including conversions with a small output buffer
+// that force the conversion to stop in the middle of a run.
+OFTEST(oficonv_bulk_conversion)
+{
+  iconv_t invalid_id = OFreinterpret_cast(iconv_t, -1);
+  iconv_t id;
+
+  // create a Latin-1 string with ASCII runs of various lengths and the expected UTF-8 output
+  OFString latin1;
+  OFString utf8;
+  for (size_t i = 0; i < 64; ++i)
+  {
+    for (size_t j = 0; j < i; ++j)
+    {
+      char c = OFstatic_cast(char, 0x20 + (i + j) % 0x5f);
+      latin1 += c;
+      utf8 += c;
+    }
+    unsigned char c = OFstatic_cast(unsigned char, 0x80 + i * 2);
+    latin1 += OFstatic_cast(char, c);
+    utf8 += OFstatic_cast(char, 0xc0 | (c >> 6));
+    utf8 += OFstatic_cast(char, 0x80 | (c & 0x3f));
+  }
+
+  OFCHECK(invalid_id != (id = OFiconv_open("UTF-8", "ISO-8859-1")));
+  if (id != invalid_id)
+  {
+    // convert in one call
+    OFString result(utf8.size(), '\0');
+    char *src_ptr = OFconst_cast(char *, latin1.c_str());
+    size_t src_len = latin1.size();
+    char *dst_ptr = &result[0];
+    size_t dst_len = result.size();
+    OFCHECK(0 == OFiconv(id, &src_ptr, &src_len, &dst_ptr, &dst_len));
+    OFCHECK(src_len == 0);
+    OFCHECK(dst_len == 0);
+    OFCHECK(result == utf8);
+
+    // convert again with an output buffer of only 7 bytes at a time
+    result.clear();
+    src_ptr = OFconst_cast(char *, latin1.c_str());
+    src_len = latin1.size();
+    char output[7];
+    size_t ret;
+    do
+    {
+      dst_ptr = output;
+      dst_len = sizeof(output);
+      ret = OFiconv(id, &src_ptr, &src_len, &dst_ptr, &dst_len);
+      result.append(output, sizeof(output) - dst_len);
+    } while ((ret == OFstatic_cast(size_t, -1)) && (dst_len < sizeof(output)));
+    OFCHECK(ret == 0);
+    OFCHECK(src_len == 0);
+    OFCHECK(result == utf8);
+    OFiconv_close(id);
+  }
+
+  // and back from UTF-8 to Latin-1
+  OFCHECK(invalid_id != (id = OFiconv_open("ISO-8859-1", "UTF-8")));
+  if (id != invalid_id)
+  {
+    OFString result(latin1.size(), '\0');
+    char *src_ptr = OFconst_cast(char *, utf8.c_str());
+    size_t src_len = utf8.size();
+    char *dst_ptr = &result[0];
+    size_t dst_len = result.size();
+    OFCHECK(0 == OFiconv(id, &src_ptr, &src_len, &dst_ptr, &dst_len));
+    OFCHECK(src_len == 0);
+    OFCHECK(dst_len == 0);
+    OFCHECK(result == latin1);
+    OFiconv_close(id);
+  }
+}
@@ -797,6 +797,25 @@ class DCMTK_OFSTD_EXPORT OFStandard
      static double atof(const char *s,
                         OFBool *success = NULL);
 
+     /** converts a floating-point number from an ASCII decimal representation
+      *  to internal double-precision format, see atof() for details.
+      *  Unlike atof(), the input does not need to be NUL-terminated, so this
+      *  function can be used to convert a single value of a multi-valued string
+      *  (e.g. a Decimal String) in place, i.e.\ without copying it. The input may
+      *  be followed by white space or NUL characters. Typical values are converted
+      *  without creating any temporary objects and with correct rounding.
+      *  @param s pointer to the first character of the ASCII representation
+      *  @param len number of characters to be considered
+      *  @param success pointer to return status code, may be NULL.
+      *    if present, a status code is stored in the variable pointed to by this
+      *    parameter.  The status is OFTrue if a conversion could be performed
+      *    and OFFalse if the string does not have the expected format.
+      *  @return floating-point equivalent of string
+      */
+     static double atofn(const char *s,
+                         size_t len,
+                         OFBool *success = NULL);
+
      /** formats a floating-point number into an ASCII string.
       *  This function works similar to sprintf(), except that this
       *  implementation is not affected by a locale setting.
@@ -852,6 +871,24 @@ class DCMTK_OFSTD_EXPORT OFStandard
 
      //@}
 
+     /** formats a floating-point number into the shortest ASCII string that is
+      *  converted back to the same value by atof(). Precisions of 15, 16 and 17
+      *  significant digits (6 to 9 for single precision) are tried in this order,
+      *  using ftoa() with %g conversion format. Unlike ftoa() with a fixed
+      *  precision of 17 (or 9) digits, values like 0.1 are formatted as "0.1"
+      *  instead of "0.10000000000000001". No memory is allocated.
+      *  @param target pointer to target string buffer
+      *  @param targetSize size of target string buffer, should be at least 32
+      *  @param value double value to be formatted
+      *  @param singlePrecision if OFTrue, the value is a single-precision
+      *    floating-point number (float) and only needs to be converted back
+      *    to the same float value
+      */
+     static void ftoaShortest(char *target,
+                              size_t targetSize,
+                              double value,
+                              OFBool singlePrecision = OFFalse);
+
     /** makes the current process sleep until seconds seconds have
      *  elapsed or a signal arrives which is not ignored
      *  @param seconds number of seconds to sleep
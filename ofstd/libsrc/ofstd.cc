@@ -114,6 +114,7 @@ END_EXTERN_C
 #include "dcmtk/ofstd/oftimer.h"
 
 
+#include <cfloat>        /* for FLT_EVAL_METHOD */
 #include <cmath>
 #include <cstring>       /* for memset() */
 #include <sstream>
@@ -1920,6 +1921,119 @@ size_t OFStandard::decodeBase64(const OFString &data,
     return count;
 }
 
+/* Powers of ten that are exactly representable as a double value.
+ * Used by atof_fastPath() below.
+ */
+static const double atof_exactPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Convert the given character range to a double value without creating any
+ * temporary objects, if this can be done with a single correctly rounded
+ * floating-point operation ("fast path" described by W. D. Clinger): this is
+ * the case if the decimal significand does not exceed 2^53 and the absolute
+ * value of the decimal exponent is not larger than 22, which covers nearly all
+ * numbers found in DICOM data sets (e.g. values of Decimal Strings). The input
+ * may only be followed by white space or NUL characters. For all other input
+ * (e.g. more significant digits, larger exponents, "NaN" or "Inf", trailing
+ * characters or syntax errors), OFFalse is returned and the caller has to use
+ * the general implementation, which always produces the same result.
+ */
+static OFBool atof_fastPath(const char *s, const char *end, double &result)
+{
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    const char *p = s;
+    // skip leading white space
+    while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r') || (*p == '\f') || (*p == '\v'))) ++p;
+    // check for sign
+    OFBool negative = OFFalse;
+    if ((p < end) && ((*p == '+') || (*p == '-')))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+    // collect the significant digits of the integer and fractional part
+    Uint64 significand = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    OFBool hasDigits = OFFalse;
+    OFBool fraction = OFFalse;
+    while (p < end)
+    {
+        if ((*p >= '0') && (*p <= '9'))
+        {
+            hasDigits = OFTrue;
+            if ((significand > 0) || (*p != '0'))
+            {
+                // more digits than fit into 64 bits are left to the general implementation
+                if (++numDigits > 19) return OFFalse;
+                significand = significand * 10 + OFstatic_cast(Uint64, *p - '0');
+                if (fraction) --exponent;
+            }
+            else if (fraction)
+            {
+                // leading zero of the fractional part
+                --exponent;
+            }
+        }
+        else if ((*p == '.') && !fraction)
+            fraction = OFTrue;
+        else
+            break;
+        ++p;
+    }
+    if (!hasDigits) return OFFalse;
+    // check for exponent
+    if ((p < end) && ((*p == 'e') || (*p == 'E')))
+    {
+        ++p;
+        OFBool negativeExponent = OFFalse;
+        if ((p < end) && ((*p == '+') || (*p == '-')))
+        {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        if ((p == end) || (*p < '0') || (*p > '9')) return OFFalse;
+        int value = 0;
+        while ((p < end) && (*p >= '0') && (*p <= '9'))
+        {
+            // larger exponents are left to the general implementation anyway
+            if (value < 1000) value = value * 10 + (*p - '0');
+            ++p;
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    // only white space or NUL characters may follow
+    while (p < end)
+    {
+        if ((*p != ' ') && (*p != '\0') && (*p != '\t') && (*p != '\n') && (*p != '\r') && (*p != '\f') && (*p != '\v')) return OFFalse;
+        ++p;
+    }
+    if (significand == 0)
+    {
+        result = negative ? -0.0 : 0.0;
+        return OFTrue;
+    }
+    // both operands of the multiplication or division have to be exact
+    if ((significand > (OFstatic_cast(Uint64, 1) << 53)) || (exponent < -22) || (exponent > 22)) return OFFalse;
+    double d = OFstatic_cast(double, significand);
+    if (exponent < 0)
+        d /= atof_exactPowersOf10[-exponent];
+    else
+        d *= atof_exactPowersOf10[exponent];
+    result = negative ? -d : d;
+    return OFTrue;
+#else
+    // intermediate results with extended precision could be rounded twice
+    (void) s;
+    (void) end;
+    (void) result;
+    return OFFalse;
+#endif
+}
+
 #ifndef ENABLE_OLD_OFSTD_ATOF_IMPLEMENTATION
 
 double OFStandard::atof(const char *s, OFBool *success)
@@ -1928,6 +2042,13 @@ double OFStandard::atof(const char *s, OFBool *success)
   if (success) *success = OFFalse;
   if (s)
   {
+    // try the fast path first, which does not need any temporary objects
+    if (atof_fastPath(s, s + strlen(s), d))
+    {
+        if (success) *success = OFTrue;
+        return d;
+    }
+
     // convert input to a string object
     STD_NAMESPACE string ss(s);
 
@@ -1999,6 +2120,15 @@ static const double atof_powersOf10[] =
 double OFStandard::atof(const char *s, OFBool *success)
 {
     if (success) *success = OFFalse;
+    if (s)
+    {
+        double d = 0.0;
+        if (atof_fastPath(s, s + strlen(s), d))
+        {
+            if (success) *success = OFTrue;
+            return d;
+        }
+    }
     const char *p = s;
     char c;
     int sign = 0;
@@ -2188,6 +2318,30 @@ double OFStandard::atof(const char *s, OFBool *success)
 
 #endif /* ENABLE_OLD_OFSTD_ATOF_IMPLEMENTATION */
 
+double OFStandard::atofn(const char *s, size_t len, OFBool *success)
+{
+    double d = 0.0;
+    if (success) *success = OFFalse;
+    if (s)
+    {
+        if (atof_fastPath(s, s + len, d))
+        {
+            if (success) *success = OFTrue;
+        } else {
+            // the general implementation expects a NUL-terminated string
+            char buf[64];
+            if (len < sizeof(buf))
+            {
+                memcpy(buf, s, len);
+                buf[len] = '\0';
+                d = atof(buf, success);
+            } else
+                d = atof(OFString(s, len).c_str(), success);
+        }
+    }
+    return d;
+}
+
 /* 11-bit exponent (VAX G floating point) is 308 decimal digits */
 #define FTOA_MAXEXP          308
 /* 128 bit fraction takes up 39 decimal digits; max reasonable precision */
@@ -2280,26 +2434,18 @@ void OFStandard::ftoa(
 /** internal helper class that maintains a string buffer
  *  to which characters can be written. If the string buffer
  *  gets full, additional characters are discarded.
- *  The string buffer does not guarantee zero termination.
+ *  The last character of the buffer is always zero, so the buffer
+ *  is zero-terminated even if it is full. The buffer is part of the
+ *  object, so no memory is allocated.
  */
 class FTOAStringBuffer
 {
 public:
-  /** constructor
-   *  @param theSize desired size of string buffer, in bytes
-   */
-  FTOAStringBuffer(unsigned long theSize)
-  : buf_(NULL)
-  , offset_(0)
-  , size_(theSize)
+  /// constructor
+  FTOAStringBuffer()
+  : offset_(0)
   {
-    if (size_ > 0) buf_ = new char[size_];
-  }
-
-  /// destructor
-  ~FTOAStringBuffer()
-  {
-    delete[] buf_;
+    buf_[sizeof(buf_) - 1] = 0;
   }
 
   /** add one character to string buffer. Never overwrites
@@ -2308,7 +2454,7 @@ public:
    */
   inline void put(unsigned char c)
   {
-    if (buf_ && (offset_ < size_)) buf_[offset_++] = c;
+    if (offset_ < sizeof(buf_) - 1) buf_[offset_++] = c;
   }
 
   // return pointer to string buffer
@@ -2318,14 +2464,11 @@ public:
   }
 
 private:
-  /// pointer to string buffer
-  char *buf_;
+  /// string buffer (including final zero byte)
+  char buf_[FTOA_BUFSIZE+2];
 
   /// current offset within buffer
-  unsigned long offset_;
-
-  /// size of buffer
-  unsigned long size_;
+  size_t offset_;
 
   /// private undefined copy constructor
   FTOAStringBuffer(const FTOAStringBuffer &old);
@@ -2673,7 +2816,7 @@ void OFStandard::ftoa(
   char sign = '\0';   /* sign prefix (' ', '+', '-', or \0) */
   int n;
   unsigned char fmtch = 'G';
-  FTOAStringBuffer sb(FTOA_BUFSIZE+1);
+  FTOAStringBuffer sb;
 
   // determine format character
   if (flags & FTOA_FORMAT_UPPERCASE)
@@ -2761,13 +2904,39 @@ void OFStandard::ftoa(
   sb.put(0);
 
   /* copy result from char buffer to output array */
-  const char *c = sb.getBuffer();
-  if (c) OFStandard::strlcpy(dst, c, siz); else *dst = 0;
+  OFStandard::strlcpy(dst, sb.getBuffer(), siz);
 }
 
 #endif /* DISABLE_OFSTD_FTOA */
 
 
+void OFStandard::ftoaShortest(
+  char *target,
+  size_t targetSize,
+  double value,
+  OFBool singlePrecision)
+{
+  if (target == NULL || targetSize == 0) return;
+  const int minPrecision = singlePrecision ? 6 : 15;
+  const int maxPrecision = singlePrecision ? 9 : 17;
+  /* NaN and infinity are never converted back to the same value */
+  if (OFMath::isnan(value) || OFMath::isinf(value))
+  {
+    OFStandard::ftoa(target, targetSize, value, 0, 0, maxPrecision);
+    return;
+  }
+  for (int precision = minPrecision; precision < maxPrecision; ++precision)
+  {
+    OFStandard::ftoa(target, targetSize, value, 0, 0, precision);
+    const double result = OFStandard::atof(target);
+    if (singlePrecision ? (OFstatic_cast(float, result) == OFstatic_cast(float, value)) : (result == value))
+      return;
+  }
+  /* the maximum precision always results in the same value */
+  OFStandard::ftoa(target, targetSize, value, 0, 0, maxPrecision);
+}
+
+
 unsigned int OFStandard::my_sleep(unsigned int seconds)
 {
 #ifdef HAVE_WINDOWS_H
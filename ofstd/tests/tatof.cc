@@ -28,6 +28,7 @@
 #include "dcmtk/ofstd/oftest.h"
 
 #include <cmath>
+#include <cstring>
 
 struct ValuePair
 {
@@ -123,3 +124,48 @@ OFTEST(ofstd_atof)
     }
   }
 }
+
+OFTEST(ofstd_atofn)
+{
+  OFBool r1 = OFFalse;
+  OFBool r2 = OFFalse;
+  double d1, d2;
+  const size_t numVp = sizeof(vp)/sizeof(ValuePair);
+
+  // same results as atof() for NUL-terminated strings
+  for (size_t i=0; i<numVp; i++)
+  {
+    d1 = OFStandard::atof(vp[i].s, &r1);
+    d2 = OFStandard::atofn(vp[i].s, strlen(vp[i].s), &r2);
+    OFCHECK_EQUAL(r1, r2);
+    if (r1 && r2 && (d1 == d1) /* not NaN */)
+      OFCHECK_EQUAL(d1, d2);
+  }
+
+  // values within a longer string are converted in place
+  const char *str = "1.5\\-0.25\\  3.0E2 \\0.1\\12345678901234567890\\abc";
+  OFCHECK_EQUAL(OFStandard::atofn(str, 3, &r1), 1.5);
+  OFCHECK(r1);
+  OFCHECK_EQUAL(OFStandard::atofn(str + 4, 5, &r1), -0.25);
+  OFCHECK(r1);
+  OFCHECK_EQUAL(OFStandard::atofn(str + 10, 8, &r1), 300.0);
+  OFCHECK(r1);
+  OFCHECK_EQUAL(OFStandard::atofn(str + 19, 3, &r1), 0.1);
+  OFCHECK(r1);
+  OFCHECK_EQUAL(OFStandard::atofn(str + 23, 20, &r1), 12345678901234567890.0);
+  OFCHECK(r1);
+  OFStandard::atofn(str + 44, 3, &r1);
+  OFCHECK(!r1);
+  OFStandard::atofn(str, 0, &r1);
+  OFCHECK(!r1);
+
+  // trailing NUL characters are ignored
+  OFCHECK_EQUAL(OFStandard::atofn("-4.99\0\0", 7, &r1), -4.99);
+  OFCHECK(r1);
+
+  // correctly rounded results (also for values that cannot be converted exactly)
+  OFCHECK_EQUAL(OFStandard::atofn("0.3", 3), 0.3);
+  OFCHECK_EQUAL(OFStandard::atofn("123.456", 7), 123.456);
+  OFCHECK_EQUAL(OFStandard::atofn("9007199254740993", 16), 9007199254740992.0);
+  OFCHECK_EQUAL(OFStandard::atofn("2.2250738585072014E-308", 23), 2.2250738585072014E-308);
+}
@@ -63,10 +63,12 @@ OFTEST_REGISTER(ofstd_OFUUID_1);
 OFTEST_REGISTER(ofstd_OFUUID_2);
 OFTEST_REGISTER(ofstd_OFVector);
 OFTEST_REGISTER(ofstd_atof);
+OFTEST_REGISTER(ofstd_atofn);
 OFTEST_REGISTER(ofstd_base64_1);
 OFTEST_REGISTER(ofstd_base64_2);
 OFTEST_REGISTER(ofstd_base64_3);
 OFTEST_REGISTER(ofstd_ftoa);
+OFTEST_REGISTER(ofstd_ftoaShortest);
 OFTEST_REGISTER(ofstd_markup_1);
 OFTEST_REGISTER(ofstd_markup_2);
 OFTEST_REGISTER(ofstd_markup_3);
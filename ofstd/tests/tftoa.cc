@@ -150,3 +150,29 @@ OFTEST(ofstd_ftoa)
     OFCHECK_EQUAL(s, buf);
   }
 }
+
+OFTEST(ofstd_ftoaShortest)
+{
+  char buf[32];
+  OFStandard::ftoaShortest(buf, sizeof(buf), 0.1);
+  OFCHECK_EQUAL(OFString("0.1"), buf);
+  OFStandard::ftoaShortest(buf, sizeof(buf), 12345.6789);
+  OFCHECK_EQUAL(OFString("12345.6789"), buf);
+  OFStandard::ftoaShortest(buf, sizeof(buf), -2.5e-300);
+  OFCHECK_EQUAL(OFString("-2.5e-300"), buf);
+  OFStandard::ftoaShortest(buf, sizeof(buf), 0.0);
+  OFCHECK_EQUAL(OFString("0"), buf);
+  // needs 16 and 17 significant digits, respectively
+  OFStandard::ftoaShortest(buf, sizeof(buf), 0.1 + 0.2);
+  OFCHECK_EQUAL(OFString("0.30000000000000004"), buf);
+  OFCHECK_EQUAL(OFStandard::atof(buf), 0.1 + 0.2);
+  OFStandard::ftoaShortest(buf, sizeof(buf), 1.0 / 3.0);
+  OFCHECK_EQUAL(OFStandard::atof(buf), 1.0 / 3.0);
+  // single precision: 0.1f is 0.100000001490116... as a double
+  OFStandard::ftoaShortest(buf, sizeof(buf), 0.1f, OFTrue);
+  OFCHECK_EQUAL(OFString("0.1"), buf);
+  OFStandard::ftoaShortest(buf, sizeof(buf), 16777217.0f, OFTrue);
+  OFCHECK_EQUAL(OFString("16777216"), buf);
+  OFStandard::ftoaShortest(buf, sizeof(buf), 1.0f / 3.0f, OFTrue);
+  OFCHECK_EQUAL(OFstatic_cast(float, OFStandard::atof(buf)), 1.0f / 3.0f);
+}